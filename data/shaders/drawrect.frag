@@ -4,6 +4,7 @@ const int MASK_REMAP_COUNT          = 3;
 const int FLAG_NO_TEXTURE           = (1 << 2);
 const int FLAG_MASK                 = (1 << 3);
 const int FLAG_CROSS_HATCH          = (1 << 4);
+const int FLAG_PATTERN              = (1 << 5);
 
 uniform usampler2DArray uTexture;
 uniform usampler2D      uPaletteTex;
@@ -76,6 +77,17 @@ void main()
         }
     }
 
+    if ((fFlags & FLAG_PATTERN) != 0)
+    {
+        int packedSpacing = int(fPalettes.x);
+        ivec2 spacing = ivec2(packedSpacing & 0xFF, packedSpacing >> 8);
+        ivec2 offset = ivec2(fPosition) - ivec2(fPalettes.yz);
+        if ((offset.x % spacing.x) != 0 || (offset.y % spacing.y) != 0)
+        {
+            discard;
+        }
+    }
+
     if ((fFlags & FLAG_MASK) != 0)
     {
         uint mask = texture(uTexture, fTexMask).r;
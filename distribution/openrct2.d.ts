@@ -15,7 +15,7 @@
 //   /// <reference path="/path/to/openrct2.d.ts" />
 //
 
-export type PluginType = "local" | "remote";
+export type PluginType = "local" | "remote" | "worker";
 
 declare global {
     /**
@@ -48,6 +48,11 @@ declare global {
      * Plugin writers should check if ui is available using `typeof ui !== 'undefined'`.
      */
     var ui: Ui;
+    /**
+     * The only API available to worker plugins, which run on their own thread.
+     * None of the other globals are available to them.
+     */
+    var worker: Worker;
 
     /**
      * Registers the plugin. This may only be called once.
@@ -174,6 +179,14 @@ declare global {
          */
         sharedStorage: Configuration;
 
+        /**
+         * Storage the server shares with all the clients. Only the server can change it,
+         * the keys that changed during a tick are sent to the clients at the end of the tick
+         * and clients that join receive all of it with the map. Values are stored as JSON,
+         * setting a key to undefined removes it.
+         */
+        replicatedStorage: ReplicatedStorage;
+
         /**
          * Render the current state of the map and save to disc.
          * Useful for server administration and timelapse creation.
@@ -248,8 +261,8 @@ declare global {
          */
         subscribe(hook: HookType, callback: Function): IDisposable;
 
-        subscribe(hook: "action.query", callback: (e: GameActionEventArgs) => void): IDisposable;
-        subscribe(hook: "action.execute", callback: (e: GameActionEventArgs) => void): IDisposable;
+        subscribe(hook: "action.query", callback: (e: GameActionEventArgs) => void, filter?: HookFilter): IDisposable;
+        subscribe(hook: "action.execute", callback: (e: GameActionEventArgs) => void, filter?: HookFilter): IDisposable;
         subscribe(hook: "interval.tick", callback: () => void): IDisposable;
         subscribe(hook: "interval.day", callback: () => void): IDisposable;
         subscribe(hook: "network.chat", callback: (e: NetworkChatEventArgs) => void): IDisposable;
@@ -257,8 +270,9 @@ declare global {
         subscribe(hook: "network.join", callback: (e: NetworkEventArgs) => void): IDisposable;
         subscribe(hook: "network.leave", callback: (e: NetworkEventArgs) => void): IDisposable;
         subscribe(hook: "ride.ratings.calculate", callback: (e: RideRatingsCalculateArgs) => void): IDisposable;
-        subscribe(hook: "action.location", callback: (e: ActionLocationArgs) => void): IDisposable;
+        subscribe(hook: "action.location", callback: (e: ActionLocationArgs) => void, filter?: HookFilter): IDisposable;
         subscribe(hook: "guest.generation", callback: (id: number) => void): IDisposable;
+        subscribe(hook: "map.change", callback: (e: MapChangeEventArgs) => void): IDisposable;
 
         /**
          * Registers a function to be called every so often in realtime, specified by the given delay.
@@ -297,6 +311,15 @@ declare global {
         has(key: string): boolean;
     }
 
+    interface ReplicatedStorage {
+        keys(): string[];
+        get<T>(key: string): T | undefined;
+        get<T>(key: string, defaultValue: T): T;
+        set<T>(key: string, value: T): void;
+        has(key: string): boolean;
+        remove(key: string): void;
+    }
+
     interface CaptureOptions {
         /**
          * A relative filename from the screenshot directory to save the capture as.
@@ -357,7 +380,7 @@ declare global {
     type HookType =
         "interval.tick" | "interval.day" |
         "network.chat" | "network.action" | "network.join" | "network.leave" |
-        "ride.ratings.calculate" | "action.location";
+        "ride.ratings.calculate" | "action.location" | "map.change";
 
     type ExpenditureType =
         "ride_construction" |
@@ -454,6 +477,22 @@ declare global {
         "waterraise" |
         "watersetheight";
 
+    /**
+     * Restricts the events an action hook is called for, the callback is only called for
+     * events that match every list given.
+     */
+    interface HookFilter {
+        /**
+         * The names or types of the actions, custom actions are matched by their id.
+         */
+        actions?: (string | number)[];
+
+        /**
+         * The ids of the players that executed the action.
+         */
+        players?: number[];
+    }
+
     interface GameActionEventArgs {
         readonly player: number;
         readonly type: number;
@@ -507,6 +546,22 @@ declare global {
         result: boolean;
     }
 
+    /**
+     * The tiles that had elements inserted or removed, or were changed by a game action, during the
+     * last tick. Sent once at the end of each tick that changed any tile.
+     */
+    interface MapChangeEventArgs {
+        /**
+         * True when the whole map was replaced, such as when a park is loaded, tiles is then empty.
+         */
+        readonly all: boolean;
+
+        /**
+         * The tile coordinates of the changed tiles, each tile only once.
+         */
+        readonly tiles: { x: number, y: number }[];
+    }
+
     /**
      * APIs for the in-game date.
      */
@@ -552,9 +607,88 @@ declare global {
 
         getRide(id: number): Ride;
         getTile(x: number, y: number): Tile;
+        /**
+         * Gets the entity with the given id. The same object is returned for an entity every time,
+         * entity objects are sealed so no properties can be added to them.
+         */
         getEntity(id: number): Entity;
         getAllEntities(type: EntityType): Entity[];
         getAllEntities(type: "peep"): Peep[];
+
+        /**
+         * Removes the entities with the given ids, much faster than calling remove on each of them.
+         * Vehicles and peeps that are on a ride cannot be removed, nothing is removed if any of the ids is one of them.
+         * Ids of entities that do not exist are skipped.
+         * @param ids The ids of the entities to remove.
+         */
+        removeEntities(ids: number[]): void;
+
+        /**
+         * Gets the state of all the guests in the park as typed arrays, with one element per guest.
+         * This is much faster than reading the same properties from each guest returned by getAllEntities.
+         */
+        getGuestData(): GuestData;
+
+        /**
+         * Gets the base height of the surface of each tile in a rectangle of the map, row by row.
+         * Tiles outside of the map have a height of 0.
+         * @param x The x coordinate of the first tile.
+         * @param y The y coordinate of the first tile.
+         * @param width The number of tiles in each row.
+         * @param height The number of rows.
+         */
+        getSurfaceHeights(x: number, y: number, width: number, height: number): Uint8Array;
+    }
+
+    interface Worker {
+        /**
+         * Subscribes to the snapshots of the park, which are sent about once a second. A snapshot is
+         * skipped when the worker is still handling the previous one.
+         */
+        onSnapshot(callback: (snapshot: WorkerSnapshot) => void): void;
+
+        /**
+         * Executes a custom action on the game thread. The action has to be registered by another
+         * plugin using context.registerAction.
+         * @param action The name of the action.
+         * @param args The arguments passed to the action, they are serialised to JSON.
+         */
+        postAction(action: string, args: object): void;
+
+        /**
+         * Logs a message to the console from the game thread.
+         */
+        log(message: any): void;
+    }
+
+    interface WorkerSnapshot {
+        readonly tick: number;
+        readonly monthsElapsed: number;
+        readonly park: {
+            readonly cash: number;
+            readonly value: number;
+            readonly companyValue: number;
+            readonly rating: number;
+        };
+        readonly guests: GuestData;
+    }
+
+    /**
+     * The state of all the guests in the park, element i of each array belongs to the same guest.
+     */
+    interface GuestData {
+        readonly count: number;
+        readonly id: Uint16Array;
+        readonly x: Int32Array;
+        readonly y: Int32Array;
+        readonly z: Int32Array;
+        readonly happiness: Uint8Array;
+        readonly energy: Uint8Array;
+        readonly nausea: Uint8Array;
+        readonly hunger: Uint8Array;
+        readonly thirst: Uint8Array;
+        readonly toilet: Uint8Array;
+        readonly cash: Int32Array;
     }
 
     type TileElementType =
@@ -1445,6 +1579,10 @@ declare global {
         readonly currentPlayer: Player;
         defaultGroup: number;
         readonly stats: NetworkStats;
+        /**
+         * Detailed traffic counters per connection and network command.
+         */
+        readonly telemetry: NetworkTelemetry;
 
         getServerInfo(): ServerInfo;
         addGroup(): void;
@@ -1495,6 +1633,55 @@ declare global {
         bytesSent: number[];
     }
 
+    interface NetworkCommandStats {
+        packetsReceived: number;
+        bytesReceived: number;
+        packetsSent: number;
+        bytesSent: number;
+        /**
+         * Time spent handling the received packets in microseconds.
+         */
+        processTimeUs: number;
+    }
+
+    interface NetworkConnectionStats {
+        bytesReceived: number;
+        bytesSent: number;
+        /**
+         * Counters per network command, commands that were never sent or received are left out.
+         */
+        commands: { [command: string]: NetworkCommandStats };
+        /**
+         * Number of pings in each bucket of NetworkTelemetry.pingHistogramBounds.
+         */
+        pingHistogram: number[];
+        /**
+         * Ping and player list updates dropped for a newer one while the send queue was full.
+         */
+        packetsCoalesced: number;
+    }
+
+    interface NetworkConnectionTelemetry extends NetworkConnectionStats {
+        player?: number;
+        name?: string;
+        ping?: number;
+        queuedPackets: number;
+        queuedBytes: number;
+    }
+
+    interface NetworkTelemetry {
+        total: NetworkConnectionStats;
+        /**
+         * Upper bounds of the ping histogram buckets in milliseconds, the last bucket has no upper bound.
+         */
+        pingHistogramBounds: number[];
+        /**
+         * Clients disconnected by the server because they could not keep up with the game.
+         */
+        slowClientsDisconnected: number;
+        connections: NetworkConnectionTelemetry[];
+    }
+
     type PermissionType =
         "chat" |
         "terraform" |
@@ -1667,6 +1854,33 @@ declare global {
 
         postMessage(message: string): void;
         postMessage(message: ParkMessageDesc): void;
+
+        /**
+         * Gets the daily samples of a park statistic taken between the given ticks, oldest first.
+         * The history is kept in saved games but is not synchronised with network clients.
+         * @param metric The statistic to get.
+         * @param firstTick The earliest tick to include, defaults to the start of the history.
+         * @param lastTick The latest tick to include, defaults to the end of the history.
+         */
+        getHistory(metric: ParkHistoryMetric, firstTick?: number, lastTick?: number): ParkHistorySample[];
+
+        /**
+         * Gets the daily samples of a ride's income per hour taken between the given ticks, oldest first.
+         * @param rideId The ride to get the income of.
+         * @param firstTick The earliest tick to include, defaults to the start of the history.
+         * @param lastTick The latest tick to include, defaults to the end of the history.
+         */
+        getRideIncomeHistory(rideId: number, firstTick?: number, lastTick?: number): ParkHistorySample[];
+    }
+
+    type ParkHistoryMetric = "cash" | "guests" | "rating" | "value";
+
+    interface ParkHistorySample {
+        /**
+         * The game tick the sample was taken on.
+         */
+        tick: number;
+        value: number;
     }
 
     type ScenarioObjectiveType =
@@ -323,15 +323,8 @@ public:
             }
 
             case INTENT_ACTION_REFRESH_RIDE_LIST:
-            {
-                auto window = window_find_by_class(WC_RIDE_LIST);
-                if (window != nullptr)
-                {
-                    window_ride_list_refresh_list(window);
-                }
-
+                window_ride_list_request_refresh();
                 break;
-            }
 
             case INTENT_ACTION_UPDATE_MAZE_CONSTRUCTION:
                 window_maze_construction_update_pressed_widgets();
@@ -436,7 +429,7 @@ public:
                 gToolbarDirtyFlags |= BTM_TB_DIRTY_FLAG_PEEP_COUNT;
                 window_invalidate_by_class(WC_GUEST_LIST);
                 window_invalidate_by_class(WC_PARK_INFORMATION);
-                window_guest_list_refresh_list();
+                window_guest_list_update_list();
                 break;
 
             case INTENT_ACTION_UPDATE_PARK_RATING:
@@ -477,6 +470,16 @@ public:
                 TrackPlaceRestoreProvisional();
                 break;
 
+            case INTENT_ACTION_MAP_TILES_CHANGED:
+            {
+                auto changes = static_cast<const TileChanges*>(intent.GetPointerExtra(INTENT_EXTRA_TILE_CHANGES));
+                if (changes != nullptr)
+                {
+                    window_map_tiles_changed(*changes);
+                }
+                break;
+            }
+
             case INTENT_ACTION_SET_MAP_TOOLTIP:
             {
                 auto ft = static_cast<Formatter*>(intent.GetPointerExtra(INTENT_EXTRA_FORMATTER));
@@ -25,6 +25,10 @@
 #include <speex/speex_resampler.h>
 #include <vector>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#    include <emmintrin.h>
+#endif
+
 namespace OpenRCT2::Audio
 {
     class AudioMixerImpl final : public IAudioMixer
@@ -48,6 +52,8 @@ namespace OpenRCT2::Audio
         std::vector<uint8_t> _convertBuffer;
         std::vector<uint8_t> _effectBuffer;
 
+        MixerStatistics _statistics;
+
     public:
         AudioMixerImpl()
         {
@@ -192,6 +198,21 @@ namespace OpenRCT2::Audio
             return _musicSources[id];
         }
 
+        MixerStatistics GetStatistics() override
+        {
+            Lock();
+            auto statistics = _statistics;
+            Unlock();
+            return statistics;
+        }
+
+        void ResetStatistics() override
+        {
+            Lock();
+            _statistics = {};
+            Unlock();
+        }
+
     private:
         void LoadAllSounds()
         {
@@ -209,6 +230,7 @@ namespace OpenRCT2::Audio
 
         void GetNextAudioChunk(uint8_t* dst, size_t length)
         {
+            auto startTime = SDL_GetPerformanceCounter();
             UpdateAdjustedSound();
 
             // Zero the output buffer
@@ -235,6 +257,29 @@ namespace OpenRCT2::Audio
                     it++;
                 }
             }
+
+            auto frequency = SDL_GetPerformanceFrequency();
+            auto microseconds = (SDL_GetPerformanceCounter() - startTime) * 1000000 / frequency;
+            UpdateStatistics(microseconds, length);
+        }
+
+        void UpdateStatistics(uint64_t microseconds, size_t length)
+        {
+            auto bufferMicroseconds = static_cast<uint64_t>(length / _format.GetByteRate()) * 1000000 / _format.freq;
+            _statistics.Callbacks++;
+            _statistics.BufferMicroseconds = bufferMicroseconds;
+            _statistics.MaxMicroseconds = std::max(_statistics.MaxMicroseconds, microseconds);
+            if (microseconds > bufferMicroseconds)
+            {
+                _statistics.Overruns++;
+            }
+
+            size_t bucket = 0;
+            while (bucket < MIXER_HISTOGRAM_BUCKETS - 1 && microseconds >= (64ULL << bucket))
+            {
+                bucket++;
+            }
+            _statistics.Histogram[bucket]++;
         }
 
         void UpdateAdjustedSound()
@@ -322,14 +367,23 @@ namespace OpenRCT2::Audio
                 buffer = _effectBuffer.data();
             }
 
-            // Apply panning and volume
-            ApplyPan(channel, buffer, bufferLen, byteRate);
-            int32_t mixVolume = ApplyVolume(channel, buffer, bufferLen);
-
-            // Finally mix on to destination buffer
             size_t dstLength = std::min(length, bufferLen);
-            SDL_MixAudioFormat(
-                data, static_cast<const uint8_t*>(buffer), _format.format, static_cast<uint32_t>(dstLength), mixVolume);
+            if (_format.format == AUDIO_S16SYS && _format.channels == 2)
+            {
+                MixS16Stereo(
+                    channel, reinterpret_cast<int16_t*>(data), static_cast<const int16_t*>(buffer),
+                    static_cast<int32_t>(dstLength / byteRate));
+            }
+            else
+            {
+                // Apply panning and volume
+                ApplyPan(channel, buffer, bufferLen, byteRate);
+                int32_t mixVolume = ApplyVolume(channel, buffer, bufferLen);
+
+                // Finally mix on to destination buffer
+                SDL_MixAudioFormat(
+                    data, static_cast<const uint8_t*>(buffer), _format.format, static_cast<uint32_t>(dstLength), mixVolume);
+            }
 
             channel->UpdateOldVolume();
         }
@@ -378,7 +432,65 @@ namespace OpenRCT2::Audio
             }
         }
 
-        int32_t ApplyVolume(const IAudioChannel* channel, void* buffer, size_t len)
+        /**
+         * Mixes the channel onto the output in a single pass, the pan and volume are faded together from the
+         * previous to the current values across the buffer. Saturates the same way as SDL_MixAudioFormat.
+         */
+        void MixS16Stereo(const IAudioChannel* channel, int16_t* dst, const int16_t* src, int32_t numFrames)
+        {
+            float volumeAdjust = GetVolumeAdjust(channel);
+            float startGain = channel->GetOldVolume() * volumeAdjust / MIXER_VOLUME_MAX;
+            float endGain = channel->IsStopping() ? 0.0f : channel->GetVolume() * volumeAdjust / MIXER_VOLUME_MAX;
+            float startL = startGain;
+            float startR = startGain;
+            float endL = endGain;
+            float endR = endGain;
+            if (channel->GetPan() != 0.5f)
+            {
+                startL *= channel->GetOldVolumeL();
+                startR *= channel->GetOldVolumeR();
+                endL *= channel->GetVolumeL();
+                endR *= channel->GetVolumeR();
+            }
+            if (numFrames <= 0 || (startL == 0.0f && startR == 0.0f && endL == 0.0f && endR == 0.0f))
+            {
+                return;
+            }
+
+            const float stepL = (endL - startL) / numFrames;
+            const float stepR = (endR - startR) / numFrames;
+            int32_t i = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+            // Four frames at a time, with the gains of the first two and the last two frames
+            __m128 gainLo = _mm_setr_ps(startL, startR, startL + stepL, startR + stepR);
+            __m128 gainHi = _mm_setr_ps(startL + 2 * stepL, startR + 2 * stepR, startL + 3 * stepL, startR + 3 * stepR);
+            const __m128 gainStep = _mm_setr_ps(4 * stepL, 4 * stepR, 4 * stepL, 4 * stepR);
+            for (; i + 4 <= numFrames; i += 4)
+            {
+                const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+                const __m128i samplesLo = _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+                const __m128i samplesHi = _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+                const __m128i scaledLo = _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(samplesLo), gainLo));
+                const __m128i scaledHi = _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(samplesHi), gainHi));
+                const __m128i scaled = _mm_packs_epi32(scaledLo, scaledHi);
+
+                __m128i* out = reinterpret_cast<__m128i*>(dst + i * 2);
+                _mm_storeu_si128(out, _mm_adds_epi16(_mm_loadu_si128(out), scaled));
+
+                gainLo = _mm_add_ps(gainLo, gainStep);
+                gainHi = _mm_add_ps(gainHi, gainStep);
+            }
+#endif
+            for (; i < numFrames; i++)
+            {
+                auto left = dst[i * 2 + 0] + static_cast<int32_t>(src[i * 2 + 0] * (startL + i * stepL));
+                auto right = dst[i * 2 + 1] + static_cast<int32_t>(src[i * 2 + 1] * (startR + i * stepR));
+                dst[i * 2 + 0] = static_cast<int16_t>(std::clamp<int32_t>(left, INT16_MIN, INT16_MAX));
+                dst[i * 2 + 1] = static_cast<int16_t>(std::clamp<int32_t>(right, INT16_MIN, INT16_MAX));
+            }
+        }
+
+        float GetVolumeAdjust(const IAudioChannel* channel) const
         {
             float volumeAdjust = _volume;
             volumeAdjust *= gConfigSound.master_sound_enabled ? (static_cast<float>(gConfigSound.master_volume) / 100.0f)
@@ -400,7 +512,12 @@ namespace OpenRCT2::Audio
                     volumeAdjust *= _adjustMusicVolume;
                     break;
             }
+            return volumeAdjust;
+        }
 
+        int32_t ApplyVolume(const IAudioChannel* channel, void* buffer, size_t len)
+        {
+            float volumeAdjust = GetVolumeAdjust(channel);
             int32_t startVolume = channel->GetOldVolume() * volumeAdjust;
             int32_t endVolume = channel->GetVolume() * volumeAdjust;
             if (channel->IsStopping())
@@ -12,14 +12,206 @@
 
 #include <SDL.h>
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
 #include <openrct2/audio/AudioSource.h>
 #include <openrct2/common.h>
+#include <thread>
+#include <vector>
 
 namespace OpenRCT2::Audio
 {
+    // About 1.5 seconds of 44.1 kHz 16-bit stereo
+    static constexpr size_t STREAM_BUFFER_SIZE = 256 * 1024;
+    static constexpr size_t STREAM_CHUNK_SIZE = 32 * 1024;
+
+    /**
+     * The read-ahead buffer of a streamed file. It is filled by the streamer thread and read by the audio
+     * callback, which only ever copies from memory. The file data wraps around to the start at the end so
+     * looping music continues without a gap.
+     */
+    struct StreamBuffer
+    {
+        SDL_RWops* RW{};
+        uint64_t DataBegin{};
+        uint64_t DataLength{};
+        uint8_t Silence{};
+
+        std::mutex Mutex;
+        std::vector<uint8_t> Ring = std::vector<uint8_t>(STREAM_BUFFER_SIZE);
+        size_t RingStart{};
+        size_t RingLength{};
+        // Offset in the data of the first byte in the ring
+        uint64_t Offset{};
+        // Incremented whenever the ring is emptied, so data read for an old position is thrown away
+        uint32_t Generation{};
+        bool Closed{};
+
+        ~StreamBuffer()
+        {
+            if (RW != nullptr)
+            {
+                SDL_RWclose(RW);
+            }
+        }
+
+        size_t ReadFile(void* dst, uint64_t offset, size_t len)
+        {
+            int64_t dataOffset = DataBegin + offset;
+            if (SDL_RWtell(RW) != dataOffset && SDL_RWseek(RW, dataOffset, RW_SEEK_SET) == -1)
+            {
+                return 0;
+            }
+            return SDL_RWread(RW, dst, 1, len);
+        }
+
+        void Write(const uint8_t* src, size_t len)
+        {
+            while (len > 0)
+            {
+                auto end = (RingStart + RingLength) % Ring.size();
+                auto count = std::min(len, Ring.size() - end);
+                std::memcpy(Ring.data() + end, src, count);
+                RingLength += count;
+                src += count;
+                len -= count;
+            }
+        }
+
+        void Consume(uint8_t* dst, size_t len)
+        {
+            while (len > 0)
+            {
+                auto count = std::min(len, Ring.size() - RingStart);
+                std::memcpy(dst, Ring.data() + RingStart, count);
+                RingStart = (RingStart + count) % Ring.size();
+                RingLength -= count;
+                dst += count;
+                len -= count;
+            }
+        }
+
+        /**
+         * Reads the next chunk of the file into the ring, returns false if the ring is full. The file is read
+         * without holding the lock so the audio callback is never held up by disk I/O.
+         */
+        bool Fill()
+        {
+            uint64_t fillOffset;
+            uint32_t generation;
+            size_t length;
+            {
+                std::lock_guard<std::mutex> lock(Mutex);
+                if (Closed || Ring.size() - RingLength < STREAM_CHUNK_SIZE)
+                    return false;
+
+                fillOffset = (Offset + RingLength) % DataLength;
+                generation = Generation;
+                length = static_cast<size_t>(std::min<uint64_t>(STREAM_CHUNK_SIZE, DataLength - fillOffset));
+            }
+
+            uint8_t chunk[STREAM_CHUNK_SIZE];
+            auto bytesRead = ReadFile(chunk, fillOffset, length);
+            if (bytesRead == 0)
+                return false;
+
+            std::lock_guard<std::mutex> lock(Mutex);
+            if (Generation == generation)
+            {
+                Write(chunk, bytesRead);
+            }
+            return true;
+        }
+    };
+
     /**
-     * An audio source where raw PCM data is streamed directly from
-     * a file.
+     * Fills the buffers of all the streamed files on a thread of its own.
+     */
+    class AudioStreamer
+    {
+    private:
+        std::thread _thread;
+        std::mutex _mutex;
+        std::condition_variable _wake;
+        std::vector<std::shared_ptr<StreamBuffer>> _streams;
+        bool _stopRequested{};
+
+    public:
+        AudioStreamer()
+        {
+            _thread = std::thread([this]() { Run(); });
+        }
+
+        ~AudioStreamer()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stopRequested = true;
+            }
+            _wake.notify_one();
+            _thread.join();
+        }
+
+        void Add(std::shared_ptr<StreamBuffer> stream)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _streams.push_back(std::move(stream));
+            }
+            _wake.notify_one();
+        }
+
+        void Wake()
+        {
+            _wake.notify_one();
+        }
+
+    private:
+        void Run()
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (!_stopRequested)
+            {
+                // Closed streams are released here, closing a file can block as well
+                _streams.erase(
+                    std::remove_if(
+                        _streams.begin(), _streams.end(),
+                        [](const std::shared_ptr<StreamBuffer>& stream) {
+                            std::lock_guard<std::mutex> streamLock(stream->Mutex);
+                            return stream->Closed;
+                        }),
+                    _streams.end());
+
+                auto streams = _streams;
+                lock.unlock();
+                bool filled = false;
+                for (const auto& stream : streams)
+                {
+                    filled |= stream->Fill();
+                }
+                streams.clear();
+                lock.lock();
+
+                if (!filled)
+                {
+                    _wake.wait_for(lock, std::chrono::milliseconds(20));
+                }
+            }
+        }
+    };
+
+    static AudioStreamer& GetStreamer()
+    {
+        static AudioStreamer streamer;
+        return streamer;
+    }
+
+    /**
+     * An audio source where raw PCM data is streamed from a file. The file is read ahead on the streamer
+     * thread, a read that misses the buffer plays silence rather than waiting for the disk.
      */
     class FileAudioSource final : public ISDLAudioSource
     {
@@ -28,6 +220,7 @@ namespace OpenRCT2::Audio
         SDL_RWops* _rw = nullptr;
         uint64_t _dataBegin = 0;
         uint64_t _dataLength = 0;
+        std::shared_ptr<StreamBuffer> _stream;
 
     public:
         ~FileAudioSource() override
@@ -47,23 +240,46 @@ namespace OpenRCT2::Audio
 
         size_t Read(void* dst, uint64_t offset, size_t len) override
         {
-            size_t bytesRead = 0;
-            int64_t currentPosition = SDL_RWtell(_rw);
-            if (currentPosition != -1)
+            if (_stream == nullptr || offset >= _dataLength)
             {
-                size_t bytesToRead = static_cast<size_t>(std::min<uint64_t>(len, _dataLength - offset));
-                int64_t dataOffset = _dataBegin + offset;
-                if (currentPosition != dataOffset)
+                return 0;
+            }
+
+            auto& stream = *_stream;
+            auto bytesToRead = static_cast<size_t>(std::min<uint64_t>(len, _dataLength - offset));
+            size_t available;
+            size_t buffered;
+            {
+                std::lock_guard<std::mutex> lock(stream.Mutex);
+                if (stream.Offset != offset)
+                {
+                    stream.Generation++;
+                    stream.RingStart = 0;
+                    stream.RingLength = 0;
+                    stream.Offset = offset;
+                }
+
+                available = std::min(bytesToRead, stream.RingLength);
+                stream.Consume(static_cast<uint8_t*>(dst), available);
+                if (available < bytesToRead)
                 {
-                    int64_t newPosition = SDL_RWseek(_rw, dataOffset, SEEK_SET);
-                    if (newPosition == -1)
-                    {
-                        return 0;
-                    }
+                    // Skip over what has not been read in time to keep the music at the right position
+                    stream.Generation++;
+                    stream.RingStart = 0;
+                    stream.RingLength = 0;
                 }
-                bytesRead = SDL_RWread(_rw, dst, 1, bytesToRead);
+                stream.Offset = (offset + bytesToRead) % _dataLength;
+                buffered = stream.RingLength;
             }
-            return bytesRead;
+            if (available < bytesToRead)
+            {
+                std::memset(static_cast<uint8_t*>(dst) + available, stream.Silence, bytesToRead - available);
+            }
+            if (available < bytesToRead || buffered < STREAM_BUFFER_SIZE / 2)
+            {
+                GetStreamer().Wake();
+            }
+            return bytesToRead;
         }
 
         bool LoadWAV(SDL_RWops* rw)
@@ -140,6 +356,23 @@ namespace OpenRCT2::Audio
 
             _dataLength = dataChunkSize;
             _dataBegin = SDL_RWtell(rw);
+            if (_dataLength == 0)
+            {
+                log_verbose("Empty DATA chunk");
+                return false;
+            }
+
+            // From here the file is only read from the streamer thread, which also closes it
+            _stream = std::make_shared<StreamBuffer>();
+            _stream->RW = _rw;
+            _stream->DataBegin = _dataBegin;
+            _stream->DataLength = _dataLength;
+            _stream->Silence = _format.format == AUDIO_U8 ? 0x80 : 0;
+            _rw = nullptr;
+
+            // Music nearly always starts from the beginning, so have that ready before it starts playing
+            _stream->Fill();
+            GetStreamer().Add(_stream);
             return true;
         }
 
@@ -171,6 +404,12 @@ namespace OpenRCT2::Audio
 
         void Unload()
         {
+            if (_stream != nullptr)
+            {
+                std::lock_guard<std::mutex> lock(_stream->Mutex);
+                _stream->Closed = true;
+            }
+            _stream = nullptr;
             if (_rw != nullptr)
             {
                 SDL_RWclose(_rw);
@@ -10,10 +10,14 @@
 #include "DrawingEngineFactory.hpp"
 
 #include <SDL.h>
+#include <algorithm>
+#include <bitset>
 #include <cmath>
+#include <cstring>
 #include <openrct2/Game.h>
 #include <openrct2/common.h>
 #include <openrct2/config/Config.h>
+#include <openrct2/drawing/Drawing.h>
 #include <openrct2/drawing/IDrawingEngine.h>
 #include <openrct2/drawing/LightFX.h>
 #include <openrct2/drawing/X8DrawingEngine.h>
@@ -50,6 +54,13 @@ private:
 
     std::vector<uint32_t> _dirtyVisualsTime;
 
+    // The screen as it was last uploaded to _screenTexture and the palette entries each of its blocks uses, so only
+    // the parts that changed since are uploaded again
+    std::vector<uint8_t> _uploadedBits;
+    std::vector<std::bitset<256>> _uploadedBlockColours;
+    std::bitset<256> _changedColours;
+    bool _uploadedBitsValid = false;
+
     bool smoothNN = false;
 
 public:
@@ -153,6 +164,7 @@ public:
         _screenTextureFormat = SDL_AllocFormat(format);
 
         ConfigureBits(width, height, width);
+        _uploadedBitsValid = false;
     }
 
     void SetPalette(const GamePalette& palette) override
@@ -161,7 +173,12 @@ public:
         {
             for (int32_t i = 0; i < 256; i++)
             {
-                _paletteHWMapped[i] = SDL_MapRGB(_screenTextureFormat, palette[i].Red, palette[i].Green, palette[i].Blue);
+                auto colour = SDL_MapRGB(_screenTextureFormat, palette[i].Red, palette[i].Green, palette[i].Blue);
+                if (_paletteHWMapped[i] != colour)
+                {
+                    _paletteHWMapped[i] = colour;
+                    _changedColours.set(i);
+                }
             }
 
 #ifdef __ENABLE_LIGHTFX__
@@ -217,12 +234,20 @@ private:
                 lightfx_render_to_texture(pixels, pitch, _bits, _width, _height, _paletteHWMapped, _lightPaletteHWMapped);
                 SDL_UnlockTexture(_screenTexture);
             }
+            _uploadedBitsValid = false;
         }
         else
 #endif
         {
-            CopyBitsToTexture(
-                _screenTexture, _bits, static_cast<int32_t>(_width), static_cast<int32_t>(_height), _paletteHWMapped);
+            if (_screenTextureFormat != nullptr && _screenTextureFormat->BytesPerPixel == 4)
+            {
+                CopyChangedBitsToTexture();
+            }
+            else
+            {
+                CopyBitsToTexture(
+                    _screenTexture, _bits, static_cast<int32_t>(_width), static_cast<int32_t>(_height), _paletteHWMapped);
+            }
         }
         if (smoothNN)
         {
@@ -256,6 +281,108 @@ private:
         }
     }
 
+    /**
+     * Compares the screen with what was uploaded last, one dirty grid block at a time, and only expands and uploads the
+     * blocks that changed or use a palette entry that changed. The dirty grid itself has been cleared by now and does
+     * not cover everything that draws straight to the screen (scrolled viewports, weather, the console), so the
+     * comparison is what finds them. Every block row is uploaded as one rectangle from its first to its last such block.
+     */
+    void CopyChangedBitsToTexture()
+    {
+        const uint32_t blockWidth = _dirtyGrid.BlockWidth;
+        const uint32_t blockHeight = _dirtyGrid.BlockHeight;
+        const uint32_t blockColumns = (_width + blockWidth - 1) / blockWidth;
+        const uint32_t blockRows = (_height + blockHeight - 1) / blockHeight;
+        const bool uploadAll = !_uploadedBitsValid || _uploadedBits.size() != static_cast<size_t>(_width) * _height;
+        if (uploadAll)
+        {
+            _uploadedBits.assign(static_cast<size_t>(_width) * _height, 0);
+            _uploadedBlockColours.assign(static_cast<size_t>(blockColumns) * blockRows, {});
+        }
+
+        _uploadedBitsValid = true;
+        for (uint32_t blockY = 0; blockY < blockRows; blockY++)
+        {
+            const uint32_t top = blockY * blockHeight;
+            const uint32_t bottom = std::min(_height, top + blockHeight);
+            uint32_t left = _width;
+            uint32_t right = 0;
+            for (uint32_t blockX = 0; blockX < blockColumns; blockX++)
+            {
+                const uint32_t blockLeft = blockX * blockWidth;
+                const uint32_t blockRight = std::min(_width, blockLeft + blockWidth);
+                auto& colours = _uploadedBlockColours[blockY * blockColumns + blockX];
+                if (UpdateUploadedBlock(blockLeft, top, blockRight, bottom, colours, uploadAll)
+                    || (colours & _changedColours).any())
+                {
+                    left = std::min(left, blockLeft);
+                    right = blockRight;
+                }
+            }
+
+            if (left < right)
+            {
+                SDL_Rect rect = { static_cast<int32_t>(left), static_cast<int32_t>(top), static_cast<int32_t>(right - left),
+                                  static_cast<int32_t>(bottom - top) };
+                _uploadedBitsValid &= CopyRectToTexture(rect);
+            }
+        }
+        _changedColours.reset();
+    }
+
+    /**
+     * Copies the block into _uploadedBits if it differs, or always when forced, and works out which palette entries it
+     * uses again.
+     */
+    bool UpdateUploadedBlock(
+        uint32_t left, uint32_t top, uint32_t right, uint32_t bottom, std::bitset<256>& colours, bool force)
+    {
+        const uint32_t width = right - left;
+        if (!force)
+        {
+            uint32_t y = top;
+            while (y < bottom && std::memcmp(_bits + y * _pitch + left, &_uploadedBits[y * _width + left], width) == 0)
+            {
+                y++;
+            }
+            if (y == bottom)
+            {
+                return false;
+            }
+        }
+
+        colours.reset();
+        for (uint32_t y = top; y < bottom; y++)
+        {
+            const uint8_t* row = _bits + y * _pitch + left;
+            std::memcpy(&_uploadedBits[y * _width + left], row, width);
+            for (uint32_t x = 0; x < width; x++)
+            {
+                colours.set(row[x]);
+            }
+        }
+        return true;
+    }
+
+    bool CopyRectToTexture(const SDL_Rect& rect)
+    {
+        void* pixels;
+        int32_t pitch;
+        if (SDL_LockTexture(_screenTexture, &rect, &pixels, &pitch) != 0)
+        {
+            return false;
+        }
+
+        const uint8_t* src = _bits + rect.y * _pitch + rect.x;
+        for (int32_t y = 0; y < rect.h; y++)
+        {
+            auto* dst = reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(pixels) + y * pitch);
+            palette_expand_row_fn(dst, src + y * _pitch, _paletteHWMapped, rect.w);
+        }
+        SDL_UnlockTexture(_screenTexture);
+        return true;
+    }
+
     void CopyBitsToTexture(SDL_Texture* texture, uint8_t* src, int32_t width, int32_t height, const uint32_t* palette)
     {
         void* pixels;
@@ -117,6 +117,8 @@ struct DrawRectCommand
         FLAG_NO_TEXTURE = (1U << 2U),
         FLAG_MASK = (1U << 3U),
         FLAG_CROSS_HATCH = (1U << 4U),
+        // Only every n-th pixel, palettes holds the packed spacing and the origin instead
+        FLAG_PATTERN = (1U << 5U),
     };
 };
 
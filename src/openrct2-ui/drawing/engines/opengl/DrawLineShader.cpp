@@ -103,7 +103,8 @@ void DrawLineShader::DrawInstances(const LineCommandBatch& instances)
     glBindVertexArray(_vao);
 
     glBindBuffer(GL_ARRAY_BUFFER, _vboInstances);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(DrawLineCommand) * instances.size(), instances.data(), GL_STREAM_DRAW);
+    OpenGLAPI::StreamBufferData(
+        GL_ARRAY_BUFFER, _instanceBufferSize, sizeof(DrawLineCommand) * instances.size(), instances.data());
 
     glDrawArraysInstanced(GL_LINES, 0, 2, static_cast<GLsizei>(instances.size()));
 }
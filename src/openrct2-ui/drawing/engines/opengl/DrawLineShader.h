@@ -29,6 +29,8 @@ private:
     GLuint _vboInstances;
     GLuint _vao;
 
+    GLsizeiptr _instanceBufferSize = 0;
+
 public:
     DrawLineShader();
     ~DrawLineShader() override;
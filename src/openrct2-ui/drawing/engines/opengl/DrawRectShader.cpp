@@ -163,7 +163,8 @@ void DrawRectShader::SetInstances(const RectCommandBatch& instances)
     glBindVertexArray(_vao);
 
     glBindBuffer(GL_ARRAY_BUFFER, _vboInstances);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(DrawRectCommand) * instances.size(), instances.data(), GL_STREAM_DRAW);
+    OpenGLAPI::StreamBufferData(
+        GL_ARRAY_BUFFER, _instanceBufferSize, sizeof(DrawRectCommand) * instances.size(), instances.data());
 
     _instanceCount = static_cast<GLsizei>(instances.size());
 }
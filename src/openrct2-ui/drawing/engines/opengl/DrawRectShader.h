@@ -44,6 +44,7 @@ private:
     GLuint _vao;
 
     GLsizei _instanceCount = 0;
+    GLsizeiptr _instanceBufferSize = 0;
 
 public:
     DrawRectShader();
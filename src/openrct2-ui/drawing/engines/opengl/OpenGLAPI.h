@@ -127,6 +127,12 @@ namespace OpenGLAPI
 {
     bool Initialise();
     void SetTexture(uint16_t index, GLenum type, GLuint texture);
+
+    /**
+     * Uploads data that is rewritten every frame to the buffer bound to target. The buffer keeps the size of the largest
+     * upload so far in capacity and its storage is orphaned, so the driver never waits for draws from the last frame.
+     */
+    void StreamBufferData(GLenum target, GLsizeiptr& capacity, GLsizeiptr size, const void* data);
 } // namespace OpenGLAPI
 
 namespace OpenGLState
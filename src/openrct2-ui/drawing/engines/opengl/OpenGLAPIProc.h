@@ -45,6 +45,7 @@ OPENGL_PROC(PFNGLBINDFRAMEBUFFERPROC, glBindFramebuffer)
 OPENGL_PROC(PFNGLBINDVERTEXARRAYPROC, glBindVertexArray)
 OPENGL_PROC(PFNGLBLITFRAMEBUFFERPROC, glBlitFramebuffer)
 OPENGL_PROC(PFNGLBUFFERDATAPROC, glBufferData)
+OPENGL_PROC(PFNGLBUFFERSUBDATAPROC, glBufferSubData)
 OPENGL_PROC(PFNGLCLEARBUFFERFVPROC, glClearBufferfv)
 OPENGL_PROC(PFNGLCLEARBUFFERUIVPROC, glClearBufferuiv)
 OPENGL_PROC(PFNGLCOMPILESHADERPROC, glCompileShader)
@@ -29,6 +29,7 @@
 #    include <openrct2/config/Config.h>
 #    include <openrct2/core/Console.hpp>
 #    include <openrct2/drawing/Drawing.h>
+#    include <openrct2/drawing/FrameStatistics.h>
 #    include <openrct2/drawing/IDrawingContext.h>
 #    include <openrct2/drawing/IDrawingEngine.h>
 #    include <openrct2/drawing/LightFX.h>
@@ -104,6 +105,9 @@ public:
     void Clear(uint8_t paletteIndex) override;
     void FillRect(uint32_t colour, int32_t x, int32_t y, int32_t w, int32_t h) override;
     void FilterRect(FilterPaletteID palette, int32_t left, int32_t top, int32_t right, int32_t bottom) override;
+    void FillRectPattern(
+        uint8_t colour, int32_t left, int32_t top, int32_t right, int32_t bottom, const ScreenCoordsXY& spacing,
+        const ScreenCoordsXY& origin);
     void DrawLine(uint32_t colour, const ScreenLine& line) override;
     void DrawSprite(uint32_t image, int32_t x, int32_t y, uint32_t tertiaryColour) override;
     void DrawSpriteRawMasked(int32_t x, int32_t y, uint32_t maskImage, uint32_t colourImage) override;
@@ -141,37 +145,18 @@ public:
         auto patternXSpace = *pattern++;
         auto patternYSpace = *pattern++;
 
-        uint8_t patternStartXOffset = xStart % patternXSpace;
-        uint8_t patternStartYOffset = yStart % patternYSpace;
-
-        const auto* dpi = _drawingContext->GetDPI();
-
-        uint32_t pixelOffset = (dpi->pitch + dpi->width) * y + x;
-        uint8_t patternYPos = patternStartYOffset % patternYSpace;
-
-        for (; height != 0; height--)
+        // One instance per pattern row rather than a line per drop, the shader keeps every patternXSpace-th pixel of
+        // every patternYSpace-th row that falls on the same screen row and column as the pattern
+        for (int32_t patternYPos = 0; patternYPos < patternYSpace; patternYPos++)
         {
             auto patternX = pattern[patternYPos * 2];
             if (patternX != 0xFF)
             {
-                uint32_t finalPixelOffset = width + pixelOffset;
-
-                uint32_t xPixelOffset = pixelOffset;
-                xPixelOffset += (static_cast<uint8_t>(patternX - patternStartXOffset)) % patternXSpace;
-
                 auto patternPixel = pattern[patternYPos * 2 + 1];
-                for (; xPixelOffset < finalPixelOffset; xPixelOffset += patternXSpace)
-                {
-                    int32_t pixelX = xPixelOffset % dpi->width;
-                    int32_t pixelY = (xPixelOffset / dpi->width) % dpi->height;
-
-                    _drawingContext->DrawLine(patternPixel, { { pixelX, pixelY }, { pixelX + 1, pixelY + 1 } });
-                }
+                ScreenCoordsXY origin = { x + patternX - xStart, y + patternYPos - yStart };
+                _drawingContext->FillRectPattern(
+                    patternPixel, x, y, x + width - 1, y + height - 1, { patternXSpace, patternYSpace }, origin);
             }
-
-            pixelOffset += dpi->pitch + dpi->width;
-            patternYPos++;
-            patternYPos %= patternYSpace;
         }
     }
 };
@@ -334,6 +319,7 @@ public:
 
     void PaintWindows() override
     {
+        FrameTimingScope timingScope(FrameTiming::Windows);
         window_update_all_viewports();
         window_draw_all(&_bitsDPI, 0, 0, _width, _height);
     }
@@ -598,6 +584,33 @@ void OpenGLDrawingContext::FilterRect(FilterPaletteID palette, int32_t left, int
     command.depth = _drawCount++;
 }
 
+void OpenGLDrawingContext::FillRectPattern(
+    uint8_t colour, int32_t left, int32_t top, int32_t right, int32_t bottom, const ScreenCoordsXY& spacing,
+    const ScreenCoordsXY& origin)
+{
+    left += _offsetX;
+    top += _offsetY;
+    right += _offsetX;
+    bottom += _offsetY;
+
+    // The shader has no well defined remainder of a negative number, so move the origin into the first period
+    int32_t originX = ((origin.x + _offsetX) % spacing.x + spacing.x) % spacing.x;
+    int32_t originY = ((origin.y + _offsetY) % spacing.y + spacing.y) % spacing.y;
+
+    DrawRectCommand& command = _commandBuffers.rects.allocate();
+
+    command.clip = { _clipLeft, _clipTop, _clipRight, _clipBottom };
+    command.texColourAtlas = 0;
+    command.texColourBounds = { 0.0f, 0.0f, 0.0f, 0.0f };
+    command.texMaskAtlas = 0;
+    command.texMaskBounds = { 0.0f, 0.0f, 0.0f, 0.0f };
+    command.palettes = { spacing.x | (spacing.y << 8), originX, originY };
+    command.colour = colour;
+    command.bounds = { left, top, right + 1, bottom + 1 };
+    command.flags = DrawRectCommand::FLAG_NO_TEXTURE | DrawRectCommand::FLAG_PATTERN;
+    command.depth = _drawCount++;
+}
+
 void OpenGLDrawingContext::DrawLine(uint32_t colour, const ScreenLine& line)
 {
     DrawLineCommand& command = _commandBuffers.lines.allocate();
@@ -12,7 +12,9 @@
 #    include "TextureCache.h"
 
 #    include <algorithm>
+#    include <openrct2/core/MemoryUsage.h>
 #    include <openrct2/drawing/Drawing.h>
+#    include <openrct2/drawing/FrameStatistics.h>
 #    include <openrct2/util/Util.h>
 #    include <openrct2/world/Location.hpp>
 #    include <stdexcept>
@@ -23,13 +25,34 @@ constexpr uint32_t UNUSED_INDEX = 0xFFFFFFFF;
 TextureCache::TextureCache()
 {
     std::fill(_indexMap.begin(), _indexMap.end(), UNUSED_INDEX);
+    MemoryUsageSetReporter(MemoryUsageCategory::TextureCache, [this]() { return GetMemoryUsage(); });
 }
 
 TextureCache::~TextureCache()
 {
+    MemoryUsageSetReporter(MemoryUsageCategory::TextureCache, nullptr);
     FreeTextures();
 }
 
+/**
+ * The size of the textures as uploaded, the driver may keep more than this, plus what the cache keeps on the CPU.
+ */
+size_t TextureCache::GetMemoryUsage()
+{
+    shared_lock lock(_mutex);
+
+    size_t result = sizeof(TextureCache);
+    if (_initialized)
+    {
+        result += static_cast<size_t>(_atlasesTextureDimensions) * _atlasesTextureDimensions * _atlasesTextureCapacity;
+        // The palette texture, 256 by 256 at one byte per pixel
+        result += 256 * 256;
+    }
+    result += _atlases.capacity() * sizeof(Atlas) + _textureCache.capacity() * sizeof(AtlasTextureInfo);
+    result += _glyphTextureMap.size() * (sizeof(GlyphId) + sizeof(AtlasTextureInfo));
+    return result;
+}
+
 void TextureCache::InvalidateImage(uint32_t image)
 {
     unique_lock lock(_mutex);
@@ -247,6 +270,7 @@ AtlasTextureInfo TextureCache::LoadImageTexture(uint32_t image)
     glTexSubImage3D(
         GL_TEXTURE_2D_ARRAY, 0, cacheInfo.bounds.x, cacheInfo.bounds.y, cacheInfo.index, dpi.width, dpi.height, 1,
         GL_RED_INTEGER, GL_UNSIGNED_BYTE, dpi.bits);
+    FrameStatisticsAddTextureUpload();
 
     DeleteDPI(dpi);
 
@@ -264,6 +288,7 @@ AtlasTextureInfo TextureCache::LoadGlyphTexture(uint32_t image, const PaletteMap
     glTexSubImage3D(
         GL_TEXTURE_2D_ARRAY, 0, cacheInfo.bounds.x, cacheInfo.bounds.y, cacheInfo.index, dpi.width, dpi.height, 1,
         GL_RED_INTEGER, GL_UNSIGNED_BYTE, dpi.bits);
+    FrameStatisticsAddTextureUpload();
 
     DeleteDPI(dpi);
 
@@ -224,6 +224,7 @@ public:
 
     GLuint GetAtlasesTexture();
     GLuint GetPaletteTexture();
+    size_t GetMemoryUsage();
     static GLint PaletteToY(FilterPaletteID palette);
 
 private:
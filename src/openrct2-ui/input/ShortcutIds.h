@@ -115,4 +115,5 @@ namespace OpenRCT2::Ui::ShortcutId
     constexpr std::string_view DebugToggleConsole = "debug.console";
     constexpr std::string_view DebugTogglePaintDebugWindow = "debug.toggle_paint_debug_window";
     constexpr std::string_view DebugAdvanceTick = "debug.advance_tick";
+    constexpr std::string_view DebugToggleFrameStatistics = "debug.toggle_frame_statistics";
 } // namespace OpenRCT2::Ui::ShortcutId
@@ -25,6 +25,7 @@
 #include <openrct2/actions/SetCheatAction.h>
 #include <openrct2/audio/audio.h>
 #include <openrct2/config/Config.h>
+#include <openrct2/drawing/FrameStatistics.h>
 #include <openrct2/interface/Chat.h>
 #include <openrct2/interface/Screenshot.h>
 #include <openrct2/localisation/Localisation.h>
@@ -880,5 +881,8 @@ void ShortcutManager::RegisterDefaultShortcuts()
             }
         }
     });
+    RegisterShortcut(ShortcutId::DebugToggleFrameStatistics, STR_SHORTCUT_DEBUG_FRAME_STATISTICS_TOGGLE, []() {
+        FrameStatisticsSetEnabled(!FrameStatisticsIsEnabled());
+    });
     // clang-format on
 }
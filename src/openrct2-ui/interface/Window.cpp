@@ -251,6 +251,7 @@ rct_window* WindowCreate(
     // Setup window
     w->classification = cls;
     w->flags = flags;
+    window_register(w);
 
     // Play sounds and flash the window
     if (!(flags & (WF_STICK_TO_BACK | WF_STICK_TO_FRONT)))
@@ -671,7 +672,7 @@ static void WindowInvalidatePressedImageButton(rct_window* w)
             continue;
 
         if (WidgetIsPressed(w, widgetIndex) || WidgetIsActiveTool(w, widgetIndex))
-            gfx_set_dirty_blocks({ w->windowPos, w->windowPos + ScreenCoordsXY{ w->width, w->height } });
+            w->Invalidate();
     }
 }
 
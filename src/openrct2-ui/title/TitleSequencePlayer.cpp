@@ -12,6 +12,7 @@
 #include "../interface/Window.h"
 
 #include <algorithm>
+#include <future>
 #include <memory>
 #include <openrct2/Context.h>
 #include <openrct2/Game.h>
@@ -19,6 +20,7 @@
 #include <openrct2/OpenRCT2.h>
 #include <openrct2/ParkImporter.h>
 #include <openrct2/common.h>
+#include <openrct2/core/ChunkFile.h>
 #include <openrct2/core/Console.hpp>
 #include <openrct2/core/Guard.hpp>
 #include <openrct2/core/Path.hpp>
@@ -27,6 +29,8 @@
 #include <openrct2/interface/Window.h>
 #include <openrct2/management/NewsItem.h>
 #include <openrct2/object/ObjectManager.h>
+#include <openrct2/rct12/SawyerChunkReader.h>
+#include <openrct2/scenario/Scenario.h>
 #include <openrct2/scenario/ScenarioRepository.h>
 #include <openrct2/scenario/ScenarioSources.h>
 #include <openrct2/title/TitleScreen.h>
@@ -42,6 +46,49 @@
 
 using namespace OpenRCT2;
 
+/**
+ * A park of the title sequence read and decoded ahead of its load command.
+ */
+struct TitleSequencePreloadedPark
+{
+    std::unique_ptr<TitleSequenceParkHandle> Handle;
+    // Not set when the park could only be decoded on the main thread
+    std::unique_ptr<IParkImporter> Importer;
+    std::unique_ptr<ParkLoadResult> Result;
+};
+
+/**
+ * Classic saves can contain packed objects which the importer adds to the object repository while loading, that is only
+ * safe to do on the main thread.
+ */
+static bool TitleSequenceParkHasPackedObjects(IStream& stream, const std::string& hintPath)
+{
+    if (ParkImporter::ExtensionIsRCT1(Path::GetExtension(hintPath)) || ChunkFile::IsChunkFile(&stream))
+    {
+        return false;
+    }
+
+    auto position = stream.GetPosition();
+    rct_s6_header header{};
+    SawyerChunkReader(&stream).ReadChunk(&header, sizeof(header));
+    stream.SetPosition(position);
+    return header.num_packed_objects != 0;
+}
+
+static TitleSequencePreloadedPark TitleSequencePreloadPark(const TitleSequence& sequence, size_t saveIndex)
+{
+    TitleSequencePreloadedPark park;
+    park.Handle = TitleSequenceGetParkHandle(sequence, saveIndex);
+    if (park.Handle != nullptr && !TitleSequenceParkHasPackedObjects(*park.Handle->Stream, park.Handle->HintPath))
+    {
+        const auto& hintPath = park.Handle->HintPath;
+        park.Importer = ParkImporter::Create(hintPath);
+        park.Result = std::make_unique<ParkLoadResult>(
+            park.Importer->LoadFromStream(park.Handle->Stream.get(), ParkImporter::ExtensionIsScenario(hintPath)));
+    }
+    return park;
+}
+
 class TitleSequencePlayer final : public ITitleSequencePlayer
 {
 private:
@@ -51,6 +98,10 @@ private:
     int32_t _position = 0;
     int32_t _waitCounter = 0;
 
+    // The park of the next load command is decoded on a worker while the current one plays
+    std::future<TitleSequencePreloadedPark> _preload;
+    int32_t _preloadPosition = -1;
+
     int32_t _lastScreenWidth = 0;
     int32_t _lastScreenHeight = 0;
     CoordsXY _viewCentreLocation = {};
@@ -73,6 +124,7 @@ public:
 
     void Eject() override
     {
+        CancelPreload();
         _sequence = nullptr;
     }
 
@@ -282,12 +334,19 @@ private:
             {
                 bool loadSuccess = false;
                 uint8_t saveIndex = command.SaveIndex;
-                auto parkHandle = TitleSequenceGetParkHandle(*_sequence, saveIndex);
-                if (parkHandle != nullptr)
+                if (!LoadPreloadedPark(loadSuccess))
                 {
-                    loadSuccess = LoadParkFromStream(parkHandle->Stream.get(), parkHandle->HintPath);
+                    auto parkHandle = TitleSequenceGetParkHandle(*_sequence, saveIndex);
+                    if (parkHandle != nullptr)
+                    {
+                        loadSuccess = LoadParkFromStream(parkHandle->Stream.get(), parkHandle->HintPath);
+                    }
                 }
-                if (!loadSuccess)
+                if (loadSuccess)
+                {
+                    PreloadNextPark();
+                }
+                else
                 {
                     if (_sequence->Saves.size() > saveIndex)
                     {
@@ -306,7 +365,11 @@ private:
                 {
                     loadSuccess = LoadParkFromFile(scenario->path);
                 }
-                if (!loadSuccess)
+                if (loadSuccess)
+                {
+                    PreloadNextPark();
+                }
+                else
                 {
                     Console::Error::WriteLine("Failed to load: \"%s\" for the title sequence.", command.Scenario);
                     return false;
@@ -317,6 +380,104 @@ private:
         return true;
     }
 
+    /**
+     * Starts decoding the park of the next load command, if it loads a park of the sequence.
+     */
+    void PreloadNextPark()
+    {
+        CancelPreload();
+        if (gPreviewingTitleSequenceInGame)
+        {
+            return;
+        }
+
+        // Follow the commands the way Update does until the next load
+        auto numCommands = static_cast<int32_t>(_sequence->Commands.size());
+        auto position = _position;
+        for (int32_t i = 0; i < numCommands; i++)
+        {
+            const auto& command = _sequence->Commands[position];
+            if (command.Type == TitleScript::End)
+            {
+                return;
+            }
+            position = command.Type == TitleScript::Restart ? 0 : (position + 1) % numCommands;
+
+            const auto& nextCommand = _sequence->Commands[position];
+            if (TitleSequenceIsLoadCommand(nextCommand))
+            {
+                if (nextCommand.Type == TitleScript::Load)
+                {
+                    auto saveIndex = static_cast<size_t>(nextCommand.SaveIndex);
+                    _preloadPosition = position;
+                    _preload = std::async(std::launch::async, TitleSequencePreloadPark, *_sequence, saveIndex);
+                }
+                return;
+            }
+        }
+    }
+
+    void CancelPreload()
+    {
+        // Waits for the worker if it is still decoding
+        _preload = {};
+        _preloadPosition = -1;
+    }
+
+    /**
+     * Loads the park decoded ahead of the current load command, returns false if there is none so it has to be loaded
+     * the usual way.
+     */
+    bool LoadPreloadedPark(bool& success)
+    {
+        if (!_preload.valid() || _preloadPosition != _position || gPreviewingTitleSequenceInGame)
+        {
+            CancelPreload();
+            return false;
+        }
+
+        _preloadPosition = -1;
+        TitleSequencePreloadedPark park;
+        try
+        {
+            park = _preload.get();
+        }
+        catch (const std::exception&)
+        {
+            Console::Error::WriteLine("Unable to load park for the title sequence.");
+            success = false;
+            return true;
+        }
+
+        if (park.Handle == nullptr)
+        {
+            success = false;
+            return true;
+        }
+        if (park.Importer == nullptr)
+        {
+            success = LoadParkFromStream(park.Handle->Stream.get(), park.Handle->HintPath);
+            return true;
+        }
+
+        log_verbose("TitleSequencePlayer::LoadPreloadedPark(%s)", park.Handle->HintPath.c_str());
+        success = false;
+        try
+        {
+            auto& objectManager = GetContext()->GetObjectManager();
+            objectManager.LoadObjects(park.Result->RequiredObjects.data(), park.Result->RequiredObjects.size());
+
+            park.Importer->Import();
+            PrepareParkForPlayback();
+            success = true;
+        }
+        catch (const std::exception&)
+        {
+            Console::Error::WriteLine("Unable to load park: %s", park.Handle->HintPath.c_str());
+        }
+        return true;
+    }
+
     void SetViewZoom(const uint32_t& zoom)
     {
         rct_window* w = window_get_main();
@@ -135,6 +135,13 @@ static uint32_t _footpathConstructionNextArrowPulse = 0;
 static uint8_t _lastUpdatedCameraRotation = UINT8_MAX;
 static bool _footpathErrorOccured;
 
+// Placing a ghost runs the whole placement action, so a path that could not be placed is not attempted again until
+// the cursor moves to another tile or the path changes
+static bool _provisionalPathFailed;
+static CoordsXYZ _failedProvisionalPathPosition;
+static int32_t _failedProvisionalPathSlope;
+static int32_t _failedProvisionalPathType;
+
 /** rct2: 0x0098D8B4 */
 static constexpr const uint8_t DefaultPathSlope[] = {
     0,
@@ -732,8 +739,6 @@ static void window_footpath_set_provisional_path_at_point(const ScreenCoordsXY&
         gMapSelectPositionA = info.Loc;
         gMapSelectPositionB = info.Loc;
 
-        footpath_provisional_update();
-
         // Set provisional path
         int32_t slope = 0;
         switch (info.SpriteType)
@@ -771,7 +776,20 @@ static void window_footpath_set_provisional_path_at_point(const ScreenCoordsXY&
         }
         int32_t pathType = (gFootpathSelectedType << 7) + (gFootpathSelectedId & 0xFF);
 
-        _window_footpath_cost = footpath_provisional_set(pathType, { info.Loc, z }, slope);
+        CoordsXYZ pathPosition{ info.Loc, z };
+        if (_provisionalPathFailed && pathPosition == _failedProvisionalPathPosition && slope == _failedProvisionalPathSlope
+            && pathType == _failedProvisionalPathType)
+        {
+            return;
+        }
+
+        footpath_provisional_update();
+
+        _window_footpath_cost = footpath_provisional_set(pathType, pathPosition, slope);
+        _provisionalPathFailed = _window_footpath_cost == MONEY32_UNDEFINED;
+        _failedProvisionalPathPosition = pathPosition;
+        _failedProvisionalPathSlope = slope;
+        _failedProvisionalPathType = pathType;
         window_invalidate_by_class(WC_FOOTPATH);
     }
 }
@@ -22,6 +22,7 @@
 #include <openrct2/util/Util.h>
 #include <openrct2/world/Park.h>
 #include <openrct2/world/Sprite.h>
+#include <unordered_map>
 #include <vector>
 
 static constexpr const rct_string_id WINDOW_TITLE = STR_GUESTS;
@@ -97,16 +98,29 @@ private:
             return firstStrId;
         }
 
-        bool operator==(const FilterArguments& other)
+        bool operator==(const FilterArguments& other) const
         {
             return std::memcmp(args, other.args, sizeof(args)) == 0;
         }
-        bool operator!=(const FilterArguments& other)
+        bool operator!=(const FilterArguments& other) const
         {
             return !(*this == other);
         }
     };
 
+    struct FilterArgumentsHash
+    {
+        size_t operator()(const FilterArguments& arguments) const
+        {
+            size_t hash = 2166136261U;
+            for (auto b : arguments.args)
+            {
+                hash = (hash ^ b) * 16777619U;
+            }
+            return hash;
+        }
+    };
+
     struct GuestGroup
     {
         size_t NumGuests{};
@@ -119,7 +133,9 @@ private:
         using CompareFunc = bool (*)(const GuestItem&, const GuestItem&);
 
         uint16_t Id;
-        char Name[256];
+        // The guest number, so a new guest that reuses the sprite of one that left is not mistaken for it
+        uint32_t PeepId;
+        std::string Name;
     };
 
     static constexpr const uint8_t SUMMARISED_GUEST_ROW_HEIGHT = SCROLLABLE_ROW_HEIGHT + 11;
@@ -144,6 +160,9 @@ private:
 
     std::vector<GuestItem> _guestList;
     std::optional<size_t> _highlightedIndex;
+    // Set by the game, handled on the next update so a burst of changes in one tick is dealt with once
+    bool _listRefreshRequired{};
+    bool _listUpdateRequired{};
 
     uint32_t _tabAnimationIndex{};
 
@@ -259,6 +278,15 @@ public:
 
     void OnUpdate() override
     {
+        if (_listRefreshRequired)
+        {
+            RefreshList();
+        }
+        else if (_listUpdateRequired)
+        {
+            UpdateList();
+        }
+
         if (_lastFindGroupsWait != 0)
         {
             _lastFindGroupsWait--;
@@ -548,20 +576,15 @@ public:
         {
             case TabId::Individual:
             {
-                auto i = screenCoords.y / SCROLLABLE_ROW_HEIGHT;
-                i += static_cast<int32_t>(_selectedPage * GUESTS_PER_PAGE);
-                for (const auto& guestItem : _guestList)
+                auto i = static_cast<size_t>(screenCoords.y / SCROLLABLE_ROW_HEIGHT);
+                i += _selectedPage * GUESTS_PER_PAGE;
+                if (i < _guestList.size())
                 {
-                    if (i == 0)
+                    auto guest = GetEntity<Guest>(_guestList[i].Id);
+                    if (guest != nullptr)
                     {
-                        auto guest = GetEntity<Guest>(guestItem.Id);
-                        if (guest != nullptr)
-                        {
-                            window_guest_open(guest);
-                        }
-                        break;
+                        window_guest_open(guest);
                     }
-                    i--;
                 }
                 break;
             }
@@ -601,6 +624,9 @@ public:
 
     void RefreshList()
     {
+        _listRefreshRequired = false;
+        _listUpdateRequired = false;
+
         // Only the individual tab uses the GuestList so no point calculating it
         if (_selectedTab != TabId::Individual)
         {
@@ -612,31 +638,117 @@ public:
 
             for (auto peep : EntityList<Guest>())
             {
-                sprite_set_flashing(peep, false);
-                if (peep->OutsideOfPark)
-                    continue;
-                if (_selectedFilter)
+                if (IsGuestListed(*peep))
                 {
-                    if (!IsPeepInFilter(*peep))
-                        continue;
-                    sprite_set_flashing(peep, true);
+                    _guestList.push_back(CreateGuestItem(*peep));
                 }
-                if (!GuestShouldBeVisible(*peep))
-                    continue;
-
-                auto& item = _guestList.emplace_back();
-                item.Id = peep->sprite_index;
-
-                Formatter ft;
-                peep->FormatNameTo(ft);
-                format_string(item.Name, sizeof(item.Name), STR_STRINGID, ft.Data());
             }
 
             std::sort(_guestList.begin(), _guestList.end(), GetGuestCompareFunc());
         }
     }
 
+    void RequestRefresh()
+    {
+        _listRefreshRequired = true;
+    }
+
+    void RequestUpdate()
+    {
+        _listUpdateRequired = true;
+    }
+
 private:
+    /**
+     * Brings the list up to date after guests have entered or left the park. Only the names of guests new
+     * to the list are formatted, they are sorted on their own and merged into the list that is already sorted.
+     * Guests that are already listed keep their place, names only change on a full refresh.
+     */
+    void UpdateList()
+    {
+        _listUpdateRequired = false;
+        if (_selectedTab != TabId::Individual)
+            return;
+
+        enum : uint8_t
+        {
+            NotListed,
+            Listed,
+            StillListed,
+        };
+        std::vector<uint8_t> state(MAX_ENTITIES, NotListed);
+        for (const auto& item : _guestList)
+        {
+            state[item.Id] = Listed;
+        }
+
+        std::vector<GuestItem> added;
+        for (auto peep : EntityList<Guest>())
+        {
+            if (!IsGuestListed(*peep))
+                continue;
+
+            if (state[peep->sprite_index] == Listed)
+            {
+                state[peep->sprite_index] = StillListed;
+            }
+            else
+            {
+                added.push_back(CreateGuestItem(*peep));
+            }
+        }
+
+        _guestList.erase(
+            std::remove_if(
+                _guestList.begin(), _guestList.end(),
+                [&state](const GuestItem& item) {
+                    auto peep = GetEntity<Guest>(item.Id);
+                    return state[item.Id] != StillListed || peep == nullptr || peep->Id != item.PeepId;
+                }),
+            _guestList.end());
+
+        if (!added.empty())
+        {
+            auto compareFunc = GetGuestCompareFunc();
+            std::sort(added.begin(), added.end(), compareFunc);
+            auto listedCount = _guestList.size();
+            _guestList.insert(_guestList.end(), std::make_move_iterator(added.begin()), std::make_move_iterator(added.end()));
+            std::inplace_merge(_guestList.begin(), _guestList.begin() + listedCount, _guestList.end(), compareFunc);
+        }
+        Invalidate();
+    }
+
+    /**
+     * Whether the guest is shown in the list, guests that match the filter are made to flash on the map.
+     */
+    bool IsGuestListed(Guest& peep)
+    {
+        sprite_set_flashing(&peep, false);
+        if (peep.OutsideOfPark)
+            return false;
+        if (_selectedFilter)
+        {
+            if (!IsPeepInFilter(peep))
+                return false;
+            sprite_set_flashing(&peep, true);
+        }
+        return GuestShouldBeVisible(peep);
+    }
+
+    static GuestItem CreateGuestItem(const Guest& peep)
+    {
+        GuestItem item;
+        item.Id = peep.sprite_index;
+        item.PeepId = peep.Id;
+
+        char name[256]{};
+        Formatter ft;
+        peep.FormatNameTo(ft);
+        format_string(name, sizeof(name), STR_STRINGID, ft.Data());
+        item.Name = name;
+        return item;
+    }
+
     void DrawTabImages(rct_drawpixelinfo& dpi)
     {
         // Tab 1 image
@@ -656,13 +768,17 @@ private:
 
     void DrawScrollIndividual(rct_drawpixelinfo& dpi)
     {
-        size_t index = 0;
-        auto y = static_cast<int32_t>(_selectedPage) * -GUEST_PAGE_HEIGHT;
-        for (const auto& guestItem : _guestList)
+        // Only the rows in view are drawn, start at the first one
+        auto pageTop = static_cast<int32_t>(_selectedPage) * -GUEST_PAGE_HEIGHT;
+        auto firstRow = std::max(0, (dpi.y - pageTop - 1) / SCROLLABLE_ROW_HEIGHT - 1);
+        auto index = static_cast<size_t>(firstRow);
+        auto y = pageTop + firstRow * SCROLLABLE_ROW_HEIGHT;
+        for (; index < _guestList.size() && y < dpi.y + dpi.height; index++, y += SCROLLABLE_ROW_HEIGHT)
         {
+            const auto& guestItem = _guestList[index];
+
             // Check if y is beyond the scroll control
-            if (y + SCROLLABLE_ROW_HEIGHT + 1 >= -0x7FFF && y + SCROLLABLE_ROW_HEIGHT + 1 > dpi.y && y < 0x7FFF
-                && y < dpi.y + dpi.height)
+            if (y + SCROLLABLE_ROW_HEIGHT + 1 >= -0x7FFF && y + SCROLLABLE_ROW_HEIGHT + 1 > dpi.y && y < 0x7FFF)
             {
                 // Highlight backcolour and text colour (format)
                 rct_string_id format = STR_BLACK_STRING;
@@ -716,8 +832,6 @@ private:
                         break;
                 }
             }
-            y += SCROLLABLE_ROW_HEIGHT;
-            index++;
         }
     }
 
@@ -819,17 +933,17 @@ private:
         return true;
     }
 
-    GuestGroup& FindOrAddGroup(FilterArguments&& arguments)
+    GuestGroup& FindOrAddGroup(
+        std::unordered_map<FilterArguments, size_t, FilterArgumentsHash>& groupIndices, FilterArguments&& arguments)
     {
-        auto foundGroup = std::find_if(
-            std::begin(_groups), std::end(_groups), [&arguments](GuestGroup& group) { return group.Arguments == arguments; });
-        if (foundGroup != std::end(_groups))
+        auto [it, added] = groupIndices.emplace(arguments, _groups.size());
+        if (added)
         {
-            return *foundGroup;
+            auto& newGroup = _groups.emplace_back();
+            newGroup.Arguments = arguments;
+            return newGroup;
         }
-        auto& newGroup = _groups.emplace_back();
-        newGroup.Arguments = arguments;
-        return newGroup;
+        return _groups[it->second];
     }
 
     void RefreshGroups()
@@ -839,12 +953,14 @@ private:
         _lastFindGroupsWait = 320;
         _groups.clear();
 
+        // Looking the groups up by their arguments keeps this linear in the number of guests
+        std::unordered_map<FilterArguments, size_t, FilterArgumentsHash> groupIndices;
         for (auto peep : EntityList<Guest>())
         {
             if (peep->OutsideOfPark)
                 continue;
 
-            auto& group = FindOrAddGroup(GetArgumentsFromPeep(*peep, _selectedView));
+            auto& group = FindOrAddGroup(groupIndices, GetArgumentsFromPeep(*peep, _selectedView));
             if (group.NumGuests < std::size(group.Faces))
             {
                 group.Faces[group.NumGuests] = get_peep_face_sprite_small(peep) - SPR_PEEP_SMALL_FACE_VERY_VERY_UNHAPPY;
@@ -938,14 +1054,14 @@ private:
             // Compare name
             if constexpr (!TRealNames)
             {
-                if (peepA->Name == nullptr && peepB->Name == nullptr)
+                if (peepA->Name == OpenRCT2::StringPool::Null && peepB->Name == OpenRCT2::StringPool::Null)
                 {
                     // Simple ID comparison for when both peeps use a number or a generated name
                     return peepA->Id < peepB->Id;
                 }
             }
         }
-        return strlogicalcmp(a.Name, b.Name) < 0;
+        return strlogicalcmp(a.Name.c_str(), b.Name.c_str()) < 0;
     }
 
     static GuestItem::CompareFunc GetGuestCompareFunc()
@@ -982,6 +1098,15 @@ void window_guest_list_refresh_list()
     auto* w = window_find_by_class(WC_GUEST_LIST);
     if (w != nullptr)
     {
-        static_cast<GuestListWindow*>(w)->RefreshList();
+        static_cast<GuestListWindow*>(w)->RequestRefresh();
+    }
+}
+
+void window_guest_list_update_list()
+{
+    auto* w = window_find_by_class(WC_GUEST_LIST);
+    if (w != nullptr)
+    {
+        static_cast<GuestListWindow*>(w)->RequestUpdate();
     }
 }
@@ -9,6 +9,7 @@
 
 #include <algorithm>
 #include <ctime>
+#include <future>
 #include <iterator>
 #include <memory>
 #include <openrct2-ui/interface/Widget.h>
@@ -18,23 +19,27 @@
 #include <openrct2/FileClassifier.h>
 #include <openrct2/Game.h>
 #include <openrct2/GameState.h>
+#include <openrct2/ParkMetadata.h>
 #include <openrct2/config/Config.h>
 #include <openrct2/core/FileScanner.h>
 #include <openrct2/core/Guard.hpp>
 #include <openrct2/core/Path.hpp>
 #include <openrct2/core/String.hpp>
+#include <openrct2/drawing/NewDrawing.h>
 #include <openrct2/localisation/Localisation.h>
 #include <openrct2/platform/Platform2.h>
 #include <openrct2/platform/platform.h>
 #include <openrct2/rct2/T6Exporter.h>
 #include <openrct2/ride/TrackDesign.h>
 #include <openrct2/scenario/Scenario.h>
+#include <openrct2/sprites.h>
 #include <openrct2/title/TitleScreen.h>
 #include <openrct2/ui/UiContext.h>
 #include <openrct2/util/Util.h>
 #include <openrct2/windows/Intent.h>
 #include <openrct2/world/Park.h>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #pragma region Widgets
@@ -43,6 +48,11 @@ static constexpr const rct_string_id WINDOW_TITLE = STR_NONE;
 static constexpr const int32_t WW = 350;
 static constexpr const int32_t WH = 400;
 
+// The park previews are drawn at twice their size in a panel to the right of the list
+static constexpr const int32_t PREVIEW_SCALE = 2;
+static constexpr const int32_t PREVIEW_IMAGE_SIZE = ParkMetadata::PREVIEW_SIZE * PREVIEW_SCALE;
+static constexpr const int32_t PREVIEW_PANEL_WIDTH = PREVIEW_IMAGE_SIZE + 8;
+
 // clang-format off
 enum
 {
@@ -81,6 +91,7 @@ static rct_widget window_loadsave_widgets[] =
 #pragma region Events
 
 static void window_loadsave_close(rct_window *w);
+static void window_loadsave_update(rct_window *w);
 static void window_loadsave_mouseup(rct_window *w, rct_widgetindex widgetIndex);
 static void window_loadsave_resize(rct_window *w);
 static void window_loadsave_scrollgetsize(rct_window *w, int32_t scrollIndex, int32_t *width, int32_t *height);
@@ -95,6 +106,7 @@ static void window_loadsave_scrollpaint(rct_window *w, rct_drawpixelinfo *dpi, i
 static rct_window_event_list window_loadsave_events([](auto& events)
 {
     events.close = &window_loadsave_close;
+    events.update = &window_loadsave_update;
     events.mouse_up = &window_loadsave_mouseup;
     events.resize = &window_loadsave_resize;
     events.get_scroll_size = &window_loadsave_scrollgetsize;
@@ -137,6 +149,11 @@ static char _extension[256];
 static std::string _defaultPath;
 static int32_t _type;
 
+// Metadata of the parks in the listed directory by file name, read in the background
+static std::unordered_map<std::string, ParkMetadata> _metadata;
+static std::future<std::unordered_map<std::string, ParkMetadata>> _metadataFuture;
+static std::vector<uint8_t> _previewImage;
+
 static int32_t maxDateWidth = 0;
 static int32_t maxTimeWidth = 0;
 
@@ -146,6 +163,17 @@ static void window_loadsave_sort_list();
 
 static rct_window* window_overwrite_prompt_open(const char* name, const char* path);
 
+static bool window_loadsave_has_preview()
+{
+    auto type = _type & 0x0E;
+    return type == LOADSAVETYPE_GAME || type == LOADSAVETYPE_LANDSCAPE;
+}
+
+static int32_t window_loadsave_get_preview_width()
+{
+    return window_loadsave_has_preview() ? PREVIEW_PANEL_WIDTH : 0;
+}
+
 static utf8* getLastDirectoryByType(int32_t type)
 {
     switch (type & 0x0E)
@@ -201,7 +229,7 @@ static const char* getFilterPatternByType(const int32_t type, const bool isSave)
     switch (type & 0x0E)
     {
         case LOADSAVETYPE_GAME:
-            return isSave ? "*.sv6" : "*.sv6;*.sc6;*.sc4;*.sv4;*.sv7;*.sea;";
+            return isSave ? "*.sv6" : "*.sv6;*.sc6;*.sc4;*.sv4;*.sv7;*.sea;*.park;";
 
         case LOADSAVETYPE_LANDSCAPE:
             return isSave ? "*.sc6" : "*.sc6;*.sv6;*.sc4;*.sv4;*.sv7;*.sea;";
@@ -263,14 +291,15 @@ rct_window* window_loadsave_open(
     rct_window* w = window_bring_to_front_by_class(WC_LOADSAVE);
     if (w == nullptr)
     {
-        w = WindowCreateCentred(WW, WH, &window_loadsave_events, WC_LOADSAVE, WF_STICK_TO_FRONT | WF_RESIZABLE);
+        const int32_t width = WW + window_loadsave_get_preview_width();
+        w = WindowCreateCentred(width, WH, &window_loadsave_events, WC_LOADSAVE, WF_STICK_TO_FRONT | WF_RESIZABLE);
         w->widgets = window_loadsave_widgets;
         w->enabled_widgets = (1 << WIDX_CLOSE) | (1 << WIDX_UP) | (1 << WIDX_NEW_FOLDER) | (1 << WIDX_NEW_FILE)
             | (1 << WIDX_SORT_NAME) | (1 << WIDX_SORT_DATE) | (1 << WIDX_BROWSE) | (1 << WIDX_DEFAULT);
 
-        w->min_width = WW;
+        w->min_width = width;
         w->min_height = WH / 2;
-        w->max_width = WW * 2;
+        w->max_width = width * 2;
         w->max_height = WH * 2;
 
         if (!hasFilePicker)
@@ -323,9 +352,21 @@ rct_window* window_loadsave_open(
 static void window_loadsave_close(rct_window* w)
 {
     _listItems.clear();
+    _metadataFuture = {};
+    _metadata.clear();
+    _previewImage = {};
     window_close_by_class(WC_LOADSAVE_OVERWRITE_PROMPT);
 }
 
+static void window_loadsave_update(rct_window* w)
+{
+    if (_metadataFuture.valid() && _metadataFuture.wait_for(std::chrono::seconds::zero()) == std::future_status::ready)
+    {
+        _metadata = _metadataFuture.get();
+        w->Invalidate();
+    }
+}
+
 static void window_loadsave_resize(rct_window* w)
 {
     if (w->width < w->min_width)
@@ -672,20 +713,81 @@ static void window_loadsave_invalidate(rct_window* w)
     window_loadsave_widgets[WIDX_RESIZE].right = w->width - 1;
     window_loadsave_widgets[WIDX_RESIZE].bottom = w->height - 1;
 
+    const int32_t listRight = w->width - 4 - window_loadsave_get_preview_width();
     rct_widget* date_widget = &window_loadsave_widgets[WIDX_SORT_DATE];
-    date_widget->right = w->width - 5;
+    date_widget->right = listRight - 1;
     date_widget->left = date_widget->right - (maxDateWidth + maxTimeWidth + (4 * DATE_TIME_GAP) + (SCROLLBAR_WIDTH + 1));
 
     window_loadsave_widgets[WIDX_SORT_NAME].left = 4;
     window_loadsave_widgets[WIDX_SORT_NAME].right = window_loadsave_widgets[WIDX_SORT_DATE].left - 1;
 
-    window_loadsave_widgets[WIDX_SCROLL].right = w->width - 4;
+    window_loadsave_widgets[WIDX_SCROLL].right = listRight;
     window_loadsave_widgets[WIDX_SCROLL].bottom = w->height - 30;
 
     window_loadsave_widgets[WIDX_BROWSE].top = w->height - 24;
     window_loadsave_widgets[WIDX_BROWSE].bottom = w->height - 6;
 }
 
+static void window_loadsave_draw_preview(rct_window* w, rct_drawpixelinfo* dpi)
+{
+    if (!window_loadsave_has_preview() || w->selected_list_item < 0
+        || w->selected_list_item >= static_cast<int32_t>(_listItems.size()))
+        return;
+
+    const auto& item = _listItems[w->selected_list_item];
+    if (item.type != TYPE_FILE)
+        return;
+
+    auto it = _metadata.find(Path::GetFileName(item.path));
+    if (it == _metadata.end())
+        return;
+
+    const auto& metadata = it->second;
+    auto screenCoords = w->windowPos
+        + ScreenCoordsXY{ window_loadsave_widgets[WIDX_SCROLL].right + 5, window_loadsave_widgets[WIDX_SORT_NAME].top };
+    if (metadata.Preview.size() == ParkMetadata::PREVIEW_SIZE * ParkMetadata::PREVIEW_SIZE)
+    {
+        _previewImage.resize(PREVIEW_IMAGE_SIZE * PREVIEW_IMAGE_SIZE);
+        for (int32_t y = 0; y < PREVIEW_IMAGE_SIZE; y++)
+        {
+            const auto* src = metadata.Preview.data() + (y / PREVIEW_SCALE) * ParkMetadata::PREVIEW_SIZE;
+            for (int32_t x = 0; x < PREVIEW_IMAGE_SIZE; x++)
+            {
+                _previewImage[y * PREVIEW_IMAGE_SIZE + x] = src[x / PREVIEW_SCALE];
+            }
+        }
+
+        rct_g1_element g1temp = {};
+        g1temp.offset = _previewImage.data();
+        g1temp.width = PREVIEW_IMAGE_SIZE;
+        g1temp.height = PREVIEW_IMAGE_SIZE;
+        gfx_set_g1_element(SPR_TEMP, &g1temp);
+        drawing_engine_invalidate_image(SPR_TEMP);
+        gfx_draw_sprite(dpi, ImageId(SPR_TEMP), screenCoords);
+        screenCoords.y += PREVIEW_IMAGE_SIZE + 4;
+    }
+
+    auto ft = Formatter();
+    ft.Add<rct_string_id>(STR_STRING);
+    ft.Add<const char*>(metadata.Name.c_str());
+    DrawTextEllipsised(dpi, screenCoords, PREVIEW_IMAGE_SIZE, STR_BLACK_STRING, ft);
+    screenCoords.y += LIST_ROW_HEIGHT;
+
+    ft = Formatter();
+    ft.Add<uint16_t>(metadata.MonthsElapsed);
+    DrawTextBasic(dpi, screenCoords, STR_WINDOW_OBJECTIVE_VALUE_DATE, ft);
+    screenCoords.y += LIST_ROW_HEIGHT;
+
+    ft = Formatter();
+    ft.Add<uint32_t>(metadata.NumGuests);
+    DrawTextBasic(dpi, screenCoords, STR_GUESTS_IN_PARK_LABEL, ft);
+    screenCoords.y += LIST_ROW_HEIGHT;
+
+    ft = Formatter();
+    ft.Add<money32>(metadata.Cash);
+    DrawTextBasic(dpi, screenCoords, metadata.Cash >= 0 ? STR_CASH_LABEL : STR_CASH_NEGATIVE_LABEL, ft);
+}
+
 static void window_loadsave_paint(rct_window* w, rct_drawpixelinfo* dpi)
 {
     WindowDrawWidgets(w, dpi);
@@ -730,6 +832,8 @@ static void window_loadsave_paint(rct_window* w, rct_drawpixelinfo* dpi)
     DrawTextBasic(
         dpi, w->windowPos + ScreenCoordsXY{ sort_date_widget.left + 5, sort_date_widget.top + 1 }, STR_DATE, &id,
         { COLOUR_GREY });
+
+    window_loadsave_draw_preview(w, dpi);
 }
 
 static void window_loadsave_scrollpaint(rct_window* w, rct_drawpixelinfo* dpi, int32_t scrollIndex)
@@ -948,6 +1052,17 @@ static void window_loadsave_populate_list(rct_window* w, int32_t includeNewItem,
         window_loadsave_sort_list();
     }
 
+    // The metadata shows up in the update event once it has been read
+    _metadata.clear();
+    _metadataFuture = {};
+    if (window_loadsave_has_preview() && !_listItems.empty())
+    {
+        _metadataFuture = std::async(
+            std::launch::async, [cache = park_metadata_cache_get(), directory = std::string(absoluteDirectory)] {
+                return cache.ReadDirectory(directory);
+            });
+    }
+
     w->Invalidate();
 }
 
@@ -33,6 +33,7 @@
 #include <openrct2/world/Scenery.h>
 #include <openrct2/world/Sprite.h>
 #include <openrct2/world/Surface.h>
+#include <openrct2/world/TileChanges.h>
 #include <vector>
 
 static constexpr uint16_t MapColour2(uint8_t colourA, uint8_t colourB)
@@ -182,6 +183,8 @@ static uint8_t _activeTool;
 
 /** rct2: 0x00F1AD6C */
 static uint32_t _currentLine;
+// Lines still to be drawn at the fast rate, until the image has been drawn once after it was cleared
+static uint32_t _fastRefreshLines;
 
 /** rct2: 0x00F1AD68 */
 static std::vector<uint8_t> _mapImageData;
@@ -206,6 +209,7 @@ static void window_map_set_peep_spawn_tool_down(const ScreenCoordsXY& screenCoor
 static void map_window_increase_map_size();
 static void map_window_decrease_map_size();
 static void map_window_set_pixels(rct_window* w);
+static void map_window_set_pixel(rct_window* w, int32_t line, int32_t index);
 
 static CoordsXY map_window_screen_to_map(ScreenCoordsXY screenCoords);
 
@@ -223,6 +227,7 @@ rct_window* window_map_open()
     {
         w->selected_tab = 0;
         w->list_information_type = 0;
+        _fastRefreshLines = MAXIMUM_MAP_SIZE_TECHNICAL;
         return w;
     }
 
@@ -254,6 +259,7 @@ rct_window* window_map_open()
     window_map_init_map();
     gWindowSceneryRotation = 0;
     window_map_centre_on_view_point();
+    TileChangesSetConsumer(TileChangesConsumer::MapWindow, true);
 
     // Reset land rights tool size
     _landRightsToolSize = 1;
@@ -276,12 +282,57 @@ void window_map_reset()
     window_map_centre_on_view_point();
 }
 
+/**
+ * Redraws the tiles changed in the last tick straight away, everything else is picked up by the slow sweep
+ * over the whole map.
+ */
+void window_map_tiles_changed(const TileChanges& changes)
+{
+    auto w = window_find_by_class(WC_MAP);
+    if (w == nullptr || w->map.rotation != get_current_rotation())
+        return;
+
+    if (changes.All)
+    {
+        _fastRefreshLines = MAXIMUM_MAP_SIZE_TECHNICAL;
+        return;
+    }
+
+    for (const auto& tilePos : changes.Tiles)
+    {
+        // The line and the index on that line, the inverse of map_window_get_line_tile
+        int32_t line = 0;
+        int32_t index = 0;
+        switch (get_current_rotation())
+        {
+            case 0:
+                line = tilePos.x;
+                index = tilePos.y;
+                break;
+            case 1:
+                line = tilePos.y;
+                index = MAXIMUM_MAP_SIZE_TECHNICAL - 1 - tilePos.x;
+                break;
+            case 2:
+                line = MAXIMUM_MAP_SIZE_TECHNICAL - 1 - tilePos.x;
+                index = MAXIMUM_MAP_SIZE_TECHNICAL - 1 - tilePos.y;
+                break;
+            case 3:
+                line = MAXIMUM_MAP_SIZE_TECHNICAL - 1 - tilePos.y;
+                index = tilePos.x;
+                break;
+        }
+        map_window_set_pixel(w, line, index);
+    }
+}
+
 /**
  *
  *  rct2: 0x0068D0F1
  */
 static void window_map_close(rct_window* w)
 {
+    TileChangesSetConsumer(TileChangesConsumer::MapWindow, false);
     _mapImageData.clear();
     _mapImageData.shrink_to_fit();
     if ((input_test_flag(INPUT_FLAG_TOOL_ACTIVE)) && gCurrentToolWidget.window_classification == w->classification
@@ -386,6 +437,7 @@ static void window_map_mouseup(rct_window* w, rct_widgetindex widgetIndex)
 
                 w->selected_tab = widgetIndex;
                 w->list_information_type = 0;
+                _fastRefreshLines = MAXIMUM_MAP_SIZE_TECHNICAL;
             }
     }
 }
@@ -445,7 +497,15 @@ static void window_map_update(rct_window* w)
         window_map_centre_on_view_point();
     }
 
-    for (int32_t i = 0; i < 16; i++)
+    // Changed tiles are drawn as they change, so once the image is complete the sweep only has to catch what
+    // changed without a game action
+    int32_t numLines = 2;
+    if (_fastRefreshLines > 0)
+    {
+        numLines = 16;
+        _fastRefreshLines -= std::min<uint32_t>(_fastRefreshLines, numLines);
+    }
+    for (int32_t i = 0; i < numLines; i++)
         map_window_set_pixels(w);
 
     w->Invalidate();
@@ -905,6 +965,7 @@ static void window_map_init_map()
 {
     std::fill(_mapImageData.begin(), _mapImageData.end(), PALETTE_INDEX_10);
     _currentLine = 0;
+    _fastRefreshLines = MAXIMUM_MAP_SIZE_TECHNICAL;
 }
 
 /**
@@ -1048,12 +1109,15 @@ static MapCoordsXY window_map_transform_to_map_coords(CoordsXY c)
     return { -x + y + MAXIMUM_MAP_SIZE_TECHNICAL - 8, x + y - 8 };
 }
 
-static void DrawMapPeepPixel(Peep* peep, const uint8_t flashColour, rct_drawpixelinfo* dpi)
+static void DrawMapPeepPixel(Peep* peep, const uint8_t flashColour, rct_drawpixelinfo* dpi, std::vector<bool>& drawnTiles)
 {
     if (peep->x == LOCATION_NULL)
         return;
 
     MapCoordsXY c = window_map_transform_to_map_coords({ peep->x, peep->y });
+    if (c.x < dpi->x - 1 || c.y < dpi->y || c.x >= dpi->x + dpi->width || c.y >= dpi->y + dpi->height)
+        return;
+
     auto leftTop = ScreenCoordsXY{ c.x, c.y };
     auto rightBottom = leftTop;
     uint8_t colour = DefaultPeepMapColour;
@@ -1066,6 +1130,18 @@ static void DrawMapPeepPixel(Peep* peep, const uint8_t flashColour, rct_drawpixe
             leftTop.x--;
         }
     }
+    else
+    {
+        auto tilePos = TileCoordsXY(CoordsXY{ peep->x, peep->y });
+        if (tilePos.x < 0 || tilePos.y < 0 || tilePos.x >= MAXIMUM_MAP_SIZE_TECHNICAL
+            || tilePos.y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+            return;
+
+        auto tileIndex = tilePos.y * MAXIMUM_MAP_SIZE_TECHNICAL + tilePos.x;
+        if (drawnTiles[tileIndex])
+            return;
+        drawnTiles[tileIndex] = true;
+    }
 
     gfx_fill_rect(dpi, { leftTop, rightBottom }, colour);
 }
@@ -1100,15 +1176,17 @@ static uint8_t MapGetStaffFlashColour()
  */
 static void window_map_paint_peep_overlay(rct_drawpixelinfo* dpi)
 {
+    // Crowds of guests on the same tile share one pixel, it only has to be filled once
+    std::vector<bool> drawnTiles(MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL);
     auto flashColour = MapGetGuestFlashColour();
     for (auto guest : EntityList<Guest>())
     {
-        DrawMapPeepPixel(guest, flashColour, dpi);
+        DrawMapPeepPixel(guest, flashColour, dpi, drawnTiles);
     }
     flashColour = MapGetStaffFlashColour();
     for (auto staff : EntityList<Staff>())
     {
-        DrawMapPeepPixel(staff, flashColour, dpi);
+        DrawMapPeepPixel(staff, flashColour, dpi, drawnTiles);
     }
 }
 
@@ -1539,64 +1617,54 @@ static uint16_t map_window_get_pixel_colour_ride(const CoordsXY& c)
     return colourB;
 }
 
-static void map_window_set_pixels(rct_window* w)
+/**
+ * The image is drawn one line at a time, each rotation walks the tiles in a different order. Returns the
+ * position of the tile at index on the given line.
+ */
+static CoordsXY map_window_get_line_tile(int32_t line, int32_t index)
 {
-    uint16_t colour = 0;
-    int32_t x = 0, y = 0, dx = 0, dy = 0;
-
-    int32_t pos = (_currentLine * (MAP_WINDOW_MAP_SIZE - 1)) + MAXIMUM_MAP_SIZE_TECHNICAL - 1;
-    auto destinationPosition = ScreenCoordsXY{ pos % MAP_WINDOW_MAP_SIZE, pos / MAP_WINDOW_MAP_SIZE };
-    auto destination = _mapImageData.data() + (destinationPosition.y * MAP_WINDOW_MAP_SIZE) + destinationPosition.x;
     switch (get_current_rotation())
     {
         case 0:
-            x = _currentLine * COORDS_XY_STEP;
-            y = 0;
-            dx = 0;
-            dy = COORDS_XY_STEP;
-            break;
+        default:
+            return { line * COORDS_XY_STEP, index * COORDS_XY_STEP };
         case 1:
-            x = MAXIMUM_TILE_START_XY;
-            y = _currentLine * COORDS_XY_STEP;
-            dx = -COORDS_XY_STEP;
-            dy = 0;
-            break;
+            return { MAXIMUM_TILE_START_XY - index * COORDS_XY_STEP, line * COORDS_XY_STEP };
         case 2:
-            x = MAXIMUM_MAP_SIZE_BIG - ((_currentLine + 1) * COORDS_XY_STEP);
-            y = MAXIMUM_TILE_START_XY;
-            dx = 0;
-            dy = -COORDS_XY_STEP;
-            break;
+            return { MAXIMUM_MAP_SIZE_BIG - ((line + 1) * COORDS_XY_STEP), MAXIMUM_TILE_START_XY - index * COORDS_XY_STEP };
         case 3:
-            x = 0;
-            y = MAXIMUM_MAP_SIZE_BIG - ((_currentLine + 1) * COORDS_XY_STEP);
-            dx = COORDS_XY_STEP;
-            dy = 0;
+            return { index * COORDS_XY_STEP, MAXIMUM_MAP_SIZE_BIG - ((line + 1) * COORDS_XY_STEP) };
+    }
+}
+
+static void map_window_set_pixel(rct_window* w, int32_t line, int32_t index)
+{
+    auto c = map_window_get_line_tile(line, index);
+    if (c.x <= 0 || c.y <= 0 || c.x >= gMapSizeUnits || c.y >= gMapSizeUnits)
+        return;
+
+    uint16_t colour = 0;
+    switch (w->selected_tab)
+    {
+        case PAGE_PEEPS:
+            colour = map_window_get_pixel_colour_peep(c);
+            break;
+        case PAGE_RIDES:
+            colour = map_window_get_pixel_colour_ride(c);
             break;
     }
 
+    int32_t pos = (line * (MAP_WINDOW_MAP_SIZE - 1)) + MAXIMUM_MAP_SIZE_TECHNICAL - 1 + index * (MAP_WINDOW_MAP_SIZE + 1);
+    auto destination = _mapImageData.data() + pos;
+    destination[0] = (colour >> 8) & 0xFF;
+    destination[1] = colour;
+}
+
+static void map_window_set_pixels(rct_window* w)
+{
     for (int32_t i = 0; i < MAXIMUM_MAP_SIZE_TECHNICAL; i++)
     {
-        if (x > 0 && y > 0 && x < gMapSizeUnits && y < gMapSizeUnits)
-        {
-            switch (w->selected_tab)
-            {
-                case PAGE_PEEPS:
-                    colour = map_window_get_pixel_colour_peep({ x, y });
-                    break;
-                case PAGE_RIDES:
-                    colour = map_window_get_pixel_colour_ride({ x, y });
-                    break;
-            }
-            destination[0] = (colour >> 8) & 0xFF;
-            destination[1] = colour;
-        }
-        x += dx;
-        y += dy;
-
-        destinationPosition.x++;
-        destinationPosition.y++;
-        destination = _mapImageData.data() + (destinationPosition.y * MAP_WINDOW_MAP_SIZE) + destinationPosition.x;
+        map_window_set_pixel(w, _currentLine, i);
     }
     _currentLine++;
     if (_currentLine >= MAXIMUM_MAP_SIZE_TECHNICAL)
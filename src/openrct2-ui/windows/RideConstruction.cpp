@@ -35,6 +35,7 @@
 #include <openrct2/world/Entrance.h>
 #include <openrct2/world/Footpath.h>
 #include <openrct2/world/Park.h>
+#include <vector>
 
 static constexpr const rct_string_id WINDOW_TITLE = STR_RIDE_CONSTRUCTION_WINDOW_TITLE;
 static constexpr const int32_t WH = 394;
@@ -436,6 +437,22 @@ static int32_t _trackPlaceCtrlZ;
 static bool _trackPlaceShiftState;
 static ScreenCoordsXY _trackPlaceShiftStart;
 static int32_t _trackPlaceShiftZ;
+
+struct TrackGhostAttempt
+{
+    ride_id_t RideIndex;
+    int32_t TrackType;
+    int32_t TrackDirection;
+    int32_t LiftHillAndAlternativeState;
+
+    bool operator==(const TrackGhostAttempt& rhs) const
+    {
+        return RideIndex == rhs.RideIndex && TrackType == rhs.TrackType && TrackDirection == rhs.TrackDirection
+            && LiftHillAndAlternativeState == rhs.LiftHillAndAlternativeState;
+    }
+};
+static TrackGhostAttempt _previousTrackPieceAttempt;
+static bool _previousTrackPieceFailed;
 static int32_t _trackPlaceZ;
 static money32 _trackPlaceCost;
 static bool _autoOpeningShop;
@@ -469,6 +486,10 @@ static void ride_construction_tooldown_entrance_exit(const ScreenCoordsXY& scree
 
 static track_type_t _currentPossibleRideConfigurations[32];
 
+// The track types whose piece is in _enabledTrackTypesPieces, gathered again when the enabled pieces change
+static std::vector<track_type_t> _enabledTrackTypes;
+static uint64_t _enabledTrackTypesPieces;
+
 static constexpr const rct_string_id RideConstructionSeatAngleRotationStrings[] = {
     STR_RIDE_CONSTRUCTION_SEAT_ROTATION_ANGLE_NEG_180, STR_RIDE_CONSTRUCTION_SEAT_ROTATION_ANGLE_NEG_135,
     STR_RIDE_CONSTRUCTION_SEAT_ROTATION_ANGLE_NEG_90,  STR_RIDE_CONSTRUCTION_SEAT_ROTATION_ANGLE_NEG_45,
@@ -2689,28 +2710,30 @@ static void window_ride_construction_update_map_selection()
  */
 static void window_ride_construction_update_possible_ride_configurations()
 {
-    int32_t trackType;
-
     auto ride = get_ride(_currentRideIndex);
     if (ride == nullptr)
         return;
 
     _currentlyShowingBrakeOrBoosterSpeed = false;
 
-    int32_t currentPossibleRideConfigurationIndex = 0;
-    _numCurrentPossibleSpecialTrackPieces = 0;
-    for (trackType = 0; trackType < TrackElemType::Count; trackType++)
+    if (_enabledTrackTypesPieces != _enabledRidePieces)
     {
-        int32_t trackTypeCategory = TrackDefinitions[trackType].type;
-
-        if (trackTypeCategory == TRACK_NONE)
-            continue;
-
-        if (!is_track_enabled(trackTypeCategory))
+        _enabledTrackTypes.clear();
+        for (track_type_t trackType = 0; trackType < TrackElemType::Count; trackType++)
         {
-            continue;
+            int32_t trackTypeCategory = TrackDefinitions[trackType].type;
+            if (trackTypeCategory != TRACK_NONE && is_track_enabled(trackTypeCategory))
+            {
+                _enabledTrackTypes.push_back(trackType);
+            }
         }
+        _enabledTrackTypesPieces = _enabledRidePieces;
+    }
 
+    int32_t currentPossibleRideConfigurationIndex = 0;
+    _numCurrentPossibleSpecialTrackPieces = 0;
+    for (auto trackType : _enabledTrackTypes)
+    {
         int32_t slope, bank;
         if (_rideConstructionState == RIDE_CONSTRUCTION_STATE_FRONT || _rideConstructionState == RIDE_CONSTRUCTION_STATE_PLACE)
         {
@@ -3490,7 +3513,17 @@ void ride_construction_toolupdate_construct(const ScreenCoordsXY& screenCoords)
         return;
     }
 
+    // Each attempt runs the whole placement action at every height up to the maximum, so a piece that could not be
+    // placed is not attempted again until the cursor moves to another tile or the piece changes
+    TrackGhostAttempt attempt{ rideIndex, trackType, trackDirection, liftHillAndAlternativeState };
+    if (_previousTrackPieceFailed && _currentTrackBegin == _previousTrackPiece && attempt == _previousTrackPieceAttempt)
+    {
+        map_invalidate_map_selection_tiles();
+        return;
+    }
+
     _previousTrackPiece = _currentTrackBegin;
+    _previousTrackPieceAttempt = attempt;
     // search for appropriate z value for ghost, up to max ride height
     int numAttempts = (z <= MAX_TRACK_HEIGHT ? ((MAX_TRACK_HEIGHT - z) / COORDS_Z_STEP + 1) : 2);
 
@@ -3513,6 +3546,7 @@ void ride_construction_toolupdate_construct(const ScreenCoordsXY& screenCoords)
 
             _currentTrackBegin.z += 16;
         }
+        _previousTrackPieceFailed = _currentTrackPrice == MONEY32_UNDEFINED;
 
         auto intent = Intent(INTENT_ACTION_UPDATE_MAZE_CONSTRUCTION);
         context_broadcast_intent(&intent);
@@ -3538,6 +3572,7 @@ void ride_construction_toolupdate_construct(const ScreenCoordsXY& screenCoords)
 
         _currentTrackBegin.z += 16;
     }
+    _previousTrackPieceFailed = _currentTrackPrice == MONEY32_UNDEFINED;
 
     if (_autoRotatingShop && _rideConstructionState == RIDE_CONSTRUCTION_STATE_PLACE
         && ride->GetRideTypeDescriptor().HasFlag(RIDE_TYPE_FLAG_IS_SHOP))
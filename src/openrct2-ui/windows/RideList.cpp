@@ -9,6 +9,7 @@
 
 #include "../interface/Theme.h"
 
+#include <algorithm>
 #include <iterator>
 #include <openrct2-ui/interface/Dropdown.h>
 #include <openrct2-ui/interface/Widget.h>
@@ -23,7 +24,10 @@
 #include <openrct2/sprites.h>
 #include <openrct2/util/Util.h>
 #include <openrct2/windows/Intent.h>
+#include <openrct2/world/Map.h>
 #include <openrct2/world/Park.h>
+#include <string>
+#include <vector>
 
 static constexpr const rct_string_id WINDOW_TITLE = STR_NONE;
 static constexpr const int32_t WH = 240;
@@ -73,6 +77,11 @@ static rct_widget window_ride_list_widgets[] = {
 };
 
 static bool _quickDemolishMode = false;
+static bool _listRefreshPending = false;
+
+// Found when the list is refreshed, for the lights of the open and close all buttons
+static bool _allRidesClosed = true;
+static bool _allRidesOpen = false;
 
 static void window_ride_list_mouseup(rct_window *w, rct_widgetindex widgetIndex);
 static void window_ride_list_resize(rct_window *w);
@@ -397,6 +406,8 @@ static void window_ride_list_update(rct_window* w)
 {
     w->frame_no = (w->frame_no + 1) % 64;
     widget_invalidate(w, WIDX_TAB_1 + w->page);
+    if (_listRefreshPending)
+        window_ride_list_refresh_list(w);
     if (_window_ride_list_information_type != INFORMATION_TYPE_STATUS)
         w->Invalidate();
 }
@@ -518,23 +529,9 @@ static void window_ride_list_invalidate(rct_window* w)
         w->widgets[WIDX_CLOSE_LIGHT].type = WindowWidgetType::ImgBtn;
         w->widgets[WIDX_OPEN_LIGHT].type = WindowWidgetType::ImgBtn;
 
-        const auto& rideManager = GetRideManager();
-        auto allClosed = true;
-        auto allOpen = false;
-        if (w->no_list_items > 0 && std::size(rideManager) != 0)
-        {
-            auto c = static_cast<RideClassification>(w->page);
-            allClosed = std::none_of(rideManager.begin(), rideManager.end(), [c](const Ride& ride) {
-                return ride.GetClassification() == c && ride.status == RIDE_STATUS_OPEN;
-            });
-            allOpen = std::none_of(rideManager.begin(), rideManager.end(), [c](const Ride& ride) {
-                return ride.GetClassification() == c && ride.status != RIDE_STATUS_OPEN;
-            });
-        }
-
-        w->widgets[WIDX_CLOSE_LIGHT].image = SPR_G2_RCT1_CLOSE_BUTTON_0 + (allClosed ? 1 : 0) * 2
+        w->widgets[WIDX_CLOSE_LIGHT].image = SPR_G2_RCT1_CLOSE_BUTTON_0 + (_allRidesClosed ? 1 : 0) * 2
             + WidgetIsPressed(w, WIDX_CLOSE_LIGHT);
-        w->widgets[WIDX_OPEN_LIGHT].image = SPR_G2_RCT1_OPEN_BUTTON_0 + (allOpen ? 1 : 0) * 2
+        w->widgets[WIDX_OPEN_LIGHT].image = SPR_G2_RCT1_OPEN_BUTTON_0 + (_allRidesOpen ? 1 : 0) * 2
             + WidgetIsPressed(w, WIDX_OPEN_LIGHT);
         w->widgets[WIDX_QUICK_DEMOLISH].top = w->widgets[WIDX_OPEN_LIGHT].bottom + 3;
     }
@@ -575,9 +572,12 @@ static void window_ride_list_scrollpaint(rct_window* w, rct_drawpixelinfo* dpi,
     gfx_fill_rect(
         dpi, { dpiCoords, dpiCoords + ScreenCoordsXY{ dpi->width, dpi->height } }, ColourMapA[w->colours[1]].mid_light);
 
-    auto y = 0;
-    for (auto i = 0; i < w->no_list_items; i++)
+    // Only the rows in view are drawn
+    auto firstRow = std::max(0, dpi->y / SCROLLABLE_ROW_HEIGHT);
+    auto lastRow = std::min<int32_t>(w->no_list_items, (dpi->y + dpi->height) / SCROLLABLE_ROW_HEIGHT + 1);
+    for (auto i = firstRow; i < lastRow; i++)
     {
+        auto y = i * SCROLLABLE_ROW_HEIGHT;
         rct_string_id format = (_quickDemolishMode ? STR_RED_STRINGID : STR_BLACK_STRING);
         if (i == w->selected_list_item)
         {
@@ -747,7 +747,6 @@ static void window_ride_list_scrollpaint(rct_window* w, rct_drawpixelinfo* dpi,
             ft.Add<rct_string_id>(formatSecondary);
         }
         DrawTextEllipsised(dpi, { 160, y - 1 }, 157, format, ft);
-        y += SCROLLABLE_ROW_HEIGHT;
     }
 }
 
@@ -781,238 +780,153 @@ static void window_ride_list_draw_tab_images(rct_drawpixelinfo* dpi, rct_window*
         dpi, ImageId(sprite_idx), w->windowPos + ScreenCoordsXY{ w->widgets[WIDX_TAB_3].left, w->widgets[WIDX_TAB_3].top });
 }
 
+/**
+ * The value the list is sorted by, largest first.
+ */
+static int64_t window_ride_list_get_sort_value(const Ride& ride, int32_t informationType)
+{
+    switch (informationType)
+    {
+        case INFORMATION_TYPE_POPULARITY:
+            return ride.popularity;
+        case INFORMATION_TYPE_SATISFACTION:
+            return ride.satisfaction;
+        case INFORMATION_TYPE_PROFIT:
+            return ride.profit;
+        case INFORMATION_TYPE_TOTAL_CUSTOMERS:
+            return ride.total_customers;
+        case INFORMATION_TYPE_TOTAL_PROFIT:
+            return ride.total_profit;
+        case INFORMATION_TYPE_CUSTOMERS:
+            return ride_customers_per_hour(&ride);
+        case INFORMATION_TYPE_AGE:
+            return ride.build_date;
+        case INFORMATION_TYPE_INCOME:
+            return ride.income_per_hour;
+        case INFORMATION_TYPE_RUNNING_COST:
+            return ride.upkeep_cost;
+        case INFORMATION_TYPE_QUEUE_LENGTH:
+            return ride.GetTotalQueueLength();
+        case INFORMATION_TYPE_QUEUE_TIME:
+            return ride.GetMaxQueueTime();
+        case INFORMATION_TYPE_RELIABILITY:
+            return ride.reliability_percentage;
+        case INFORMATION_TYPE_DOWN_TIME:
+            return ride.downtime;
+        case INFORMATION_TYPE_GUESTS_FAVOURITE:
+            return ride.guests_favourite;
+    }
+    return 0;
+}
+
+/**
+ * Finds every ride with track on the map in one pass, rather than one pass for each closed ride.
+ */
+static std::vector<bool> window_ride_list_get_rides_with_track()
+{
+    std::vector<bool> result(MAX_RIDES);
+    tile_element_iterator it;
+    tile_element_iterator_begin(&it);
+    while (tile_element_iterator_next(&it))
+    {
+        if (it.element->GetType() != TILE_ELEMENT_TYPE_TRACK || it.element->IsGhost())
+            continue;
+
+        auto rideIndex = it.element->AsTrack()->GetRideIndex();
+        if (rideIndex < result.size())
+        {
+            result[rideIndex] = true;
+        }
+    }
+    return result;
+}
+
 /**
  *
  *  rct2: 0x006B39A8
  */
 void window_ride_list_refresh_list(rct_window* w)
 {
-    int32_t list_index = 0;
-    for (auto& ridec : GetRideManager())
+    struct ListItem
+    {
+        ride_id_t Id;
+        int64_t SortValue;
+        std::string Name;
+    };
+
+    _listRefreshPending = false;
+
+    auto classification = static_cast<RideClassification>(w->page);
+    auto sortByName = w->list_information_type == INFORMATION_TYPE_STATUS;
+    std::vector<bool> ridesWithTrack;
+    std::vector<ListItem> items;
+    auto anyOpen = false;
+    auto anyNotOpen = false;
+    for (auto& ride : GetRideManager())
     {
-        auto ride = &ridec;
-        if (ride->GetClassification() != static_cast<RideClassification>(w->page)
-            || (ride->status == RIDE_STATUS_CLOSED && !ride_has_any_track_elements(ride)))
+        if (ride.GetClassification() != classification)
             continue;
 
-        if (ride->window_invalidate_flags & RIDE_INVALIDATE_RIDE_LIST)
-        {
-            ride->window_invalidate_flags &= ~RIDE_INVALIDATE_RIDE_LIST;
-        }
+        if (ride.status == RIDE_STATUS_OPEN)
+            anyOpen = true;
+        else
+            anyNotOpen = true;
 
-        w->list_item_positions[list_index] = ride->id;
-        int32_t current_list_position = list_index;
-        switch (w->list_information_type)
+        if (ride.status == RIDE_STATUS_CLOSED)
         {
-            case INFORMATION_TYPE_STATUS:
+            if (ridesWithTrack.empty())
             {
-                auto strA = ride->GetName();
-                while (--current_list_position >= 0)
-                {
-                    auto otherRide = get_ride(w->list_item_positions[current_list_position]);
-                    if (otherRide != nullptr)
-                    {
-                        auto strB = otherRide->GetName();
-                        if (strlogicalcmp(strA.c_str(), strB.c_str()) >= 0)
-                            break;
-
-                        window_bubble_list_item(w, current_list_position);
-                    }
-                }
-                break;
+                ridesWithTrack = window_ride_list_get_rides_with_track();
             }
-            case INFORMATION_TYPE_POPULARITY:
-                while (--current_list_position >= 0)
-                {
-                    auto otherRide = get_ride(w->list_item_positions[current_list_position]);
-                    if (otherRide != nullptr)
-                    {
-                        if (ride->popularity * 4 <= otherRide->popularity * 4)
-                            break;
-
-                        window_bubble_list_item(w, current_list_position);
-                    }
-                }
-                break;
-            case INFORMATION_TYPE_SATISFACTION:
-                while (--current_list_position >= 0)
-                {
-                    auto otherRide = get_ride(w->list_item_positions[current_list_position]);
-                    if (otherRide != nullptr)
-                    {
-                        if (ride->satisfaction * 5 <= otherRide->satisfaction * 5)
-                            break;
-
-                        window_bubble_list_item(w, current_list_position);
-                    }
-                }
-                break;
-            case INFORMATION_TYPE_PROFIT:
-                while (--current_list_position >= 0)
-                {
-                    auto otherRide = get_ride(w->list_item_positions[current_list_position]);
-                    if (otherRide != nullptr)
-                    {
-                        if (ride->profit <= otherRide->profit)
-                            break;
-
-                        window_bubble_list_item(w, current_list_position);
-                    }
-                }
-                break;
-            case INFORMATION_TYPE_TOTAL_CUSTOMERS:
-                while (--current_list_position >= 0)
-                {
-                    auto otherRide = get_ride(w->list_item_positions[current_list_position]);
-                    if (otherRide != nullptr)
-                    {
-                        if (ride->total_customers <= otherRide->total_customers)
-                            break;
-
-                        window_bubble_list_item(w, current_list_position);
-                    }
-                }
-                break;
-            case INFORMATION_TYPE_TOTAL_PROFIT:
-                while (--current_list_position >= 0)
-                {
-                    auto otherRide = get_ride(w->list_item_positions[current_list_position]);
-                    if (otherRide != nullptr)
-                    {
-                        if (ride->total_profit <= otherRide->total_profit)
-                            break;
-
-                        window_bubble_list_item(w, current_list_position);
-                    }
-                }
-                break;
-            case INFORMATION_TYPE_CUSTOMERS:
-                while (--current_list_position >= 0)
-                {
-                    auto otherRide = get_ride(w->list_item_positions[current_list_position]);
-                    if (otherRide != nullptr)
-                    {
-                        if (ride_customers_per_hour(ride) <= ride_customers_per_hour(otherRide))
-                            break;
-
-                        window_bubble_list_item(w, current_list_position);
-                    }
-                }
-                break;
-            case INFORMATION_TYPE_AGE:
-                while (--current_list_position >= 0)
-                {
-                    auto otherRide = get_ride(w->list_item_positions[current_list_position]);
-                    if (otherRide != nullptr)
-                    {
-                        if (ride->build_date <= otherRide->build_date)
-                            break;
-
-                        window_bubble_list_item(w, current_list_position);
-                    }
-                }
-                break;
-            case INFORMATION_TYPE_INCOME:
-                while (--current_list_position >= 0)
-                {
-                    auto otherRide = get_ride(w->list_item_positions[current_list_position]);
-                    if (otherRide != nullptr)
-                    {
-                        if (ride->income_per_hour <= otherRide->income_per_hour)
-                            break;
-
-                        window_bubble_list_item(w, current_list_position);
-                    }
-                }
-                break;
-            case INFORMATION_TYPE_RUNNING_COST:
-                while (--current_list_position >= 0)
-                {
-                    auto otherRide = get_ride(w->list_item_positions[current_list_position]);
-                    if (otherRide != nullptr)
-                    {
-                        if (ride->upkeep_cost <= otherRide->upkeep_cost)
-                            break;
-
-                        window_bubble_list_item(w, current_list_position);
-                    }
-                }
-                break;
-            case INFORMATION_TYPE_QUEUE_LENGTH:
-                while (--current_list_position >= 0)
-                {
-                    auto otherRide = get_ride(w->list_item_positions[current_list_position]);
-                    if (otherRide != nullptr)
-                    {
-                        if (ride->GetTotalQueueLength() <= otherRide->GetTotalQueueLength())
-                            break;
-
-                        window_bubble_list_item(w, current_list_position);
-                    }
-                }
-                break;
-            case INFORMATION_TYPE_QUEUE_TIME:
-                while (--current_list_position >= 0)
-                {
-                    auto otherRide = get_ride(w->list_item_positions[current_list_position]);
-                    if (otherRide != nullptr)
-                    {
-                        if (ride->GetMaxQueueTime() <= otherRide->GetMaxQueueTime())
-                            break;
-
-                        window_bubble_list_item(w, current_list_position);
-                    }
-                }
-                break;
-            case INFORMATION_TYPE_RELIABILITY:
-                while (--current_list_position >= 0)
-                {
-                    auto otherRide = get_ride(w->list_item_positions[current_list_position]);
-                    if (otherRide != nullptr)
-                    {
-                        if (ride->reliability_percentage <= otherRide->reliability_percentage)
-                            break;
-
-                        window_bubble_list_item(w, current_list_position);
-                    }
-                }
-                break;
-            case INFORMATION_TYPE_DOWN_TIME:
-                while (--current_list_position >= 0)
-                {
-                    auto otherRide = get_ride(w->list_item_positions[current_list_position]);
-                    if (otherRide != nullptr)
-                    {
-                        if (ride->downtime <= otherRide->downtime)
-                            break;
-
-                        window_bubble_list_item(w, current_list_position);
-                    }
-                }
-                break;
-            case INFORMATION_TYPE_GUESTS_FAVOURITE:
-                while (--current_list_position >= 0)
-                {
-                    auto otherRide = get_ride(w->list_item_positions[current_list_position]);
-                    if (otherRide != nullptr)
-                    {
-                        if (ride->guests_favourite <= otherRide->guests_favourite)
-                            break;
-
-                        window_bubble_list_item(w, current_list_position);
-                    }
-                }
-                break;
+            if (ride.id >= ridesWithTrack.size() || !ridesWithTrack[ride.id])
+                continue;
         }
 
-        list_index++;
+        ride.window_invalidate_flags &= ~RIDE_INVALIDATE_RIDE_LIST;
+
+        auto& item = items.emplace_back();
+        item.Id = ride.id;
+        if (sortByName)
+            item.Name = ride.GetName();
+        else
+            item.SortValue = window_ride_list_get_sort_value(ride, w->list_information_type);
+    }
+
+    // Both sorts keep rides that compare equal in index order
+    if (sortByName)
+    {
+        std::stable_sort(items.begin(), items.end(), [](const ListItem& a, const ListItem& b) {
+            return strlogicalcmp(a.Name.c_str(), b.Name.c_str()) < 0;
+        });
+    }
+    else
+    {
+        std::stable_sort(
+            items.begin(), items.end(), [](const ListItem& a, const ListItem& b) { return a.SortValue > b.SortValue; });
+    }
+
+    size_t listIndex = 0;
+    for (; listIndex < items.size() && listIndex < std::size(w->list_item_positions); listIndex++)
+    {
+        w->list_item_positions[listIndex] = static_cast<uint8_t>(items[listIndex].Id);
     }
 
-    w->no_list_items = list_index;
+    _allRidesClosed = items.empty() || !anyOpen;
+    _allRidesOpen = !items.empty() && !anyNotOpen;
+
+    w->no_list_items = static_cast<uint16_t>(listIndex);
     w->selected_list_item = -1;
     w->Invalidate();
 }
 
+/**
+ * Refreshes the list on the next update, so rides changed by several actions in one tick only refresh it once.
+ */
+void window_ride_list_request_refresh()
+{
+    _listRefreshPending = true;
+}
+
 static void window_ride_list_close_all(rct_window* w)
 {
     for (auto& ride : GetRideManager())
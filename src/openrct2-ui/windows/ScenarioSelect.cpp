@@ -11,6 +11,7 @@
 
 #include <openrct2-ui/interface/Widget.h>
 #include <openrct2-ui/windows/Window.h>
+#include <openrct2/Context.h>
 #include <openrct2/audio/audio.h>
 #include <openrct2/config/Config.h>
 #include <openrct2/drawing/Drawing.h>
@@ -101,6 +102,7 @@ static constexpr const rct_string_id ScenarioOriginStringIds[] = {
 static void window_scenarioselect_init_tabs(rct_window *w);
 
 static void window_scenarioselect_close(rct_window *w);
+static void window_scenarioselect_update(rct_window *w);
 static void window_scenarioselect_mouseup(rct_window *w, rct_widgetindex widgetIndex);
 static void window_scenarioselect_mousedown(rct_window *w, rct_widgetindex widgetIndex, rct_widget* widget);
 static void window_scenarioselect_scrollgetsize(rct_window *w, int32_t scrollIndex, int32_t *width, int32_t *height);
@@ -118,6 +120,7 @@ static bool ScenarioSelectUseSmallFont()
 static rct_window_event_list window_scenarioselect_events([](auto& events)
 {
     events.close = &window_scenarioselect_close;
+    events.update = &window_scenarioselect_update;
     events.mouse_up = &window_scenarioselect_mouseup;
     events.mouse_down = &window_scenarioselect_mousedown;
     events.get_scroll_size = &window_scenarioselect_scrollgetsize;
@@ -139,6 +142,7 @@ static std::function<void(std::string_view)> _callback;
 static bool _showLockedInformation = false;
 static bool _titleEditor = false;
 static bool _disableLocking{};
+static bool _waitingForScan{};
 
 rct_window* window_scenarioselect_open(scenarioselect_callback callback, bool titleEditor)
 {
@@ -169,8 +173,12 @@ rct_window* window_scenarioselect_open(std::function<void(std::string_view)> cal
     _callback = callback;
     _disableLocking = disableLocking;
 
-    // Load scenario list
-    scenario_repository_scan();
+    // Load scenario list, unless the initial scan is still running in which case the list is filled in once it is done
+    _waitingForScan = OpenRCT2::GetContext()->GetScenarioRepository()->IsScanning();
+    if (!_waitingForScan)
+    {
+        scenario_repository_scan();
+    }
 
     // Shrink the window if we're showing scenarios by difficulty level.
     if (gConfigGeneral.scenario_select_mode == SCENARIO_SELECT_MODE_DIFFICULTY && !_titleEditor)
@@ -185,8 +193,11 @@ rct_window* window_scenarioselect_open(std::function<void(std::string_view)> cal
     window->enabled_widgets = (1 << WIDX_CLOSE) | (1 << WIDX_TAB1) | (1 << WIDX_TAB2) | (1 << WIDX_TAB3) | (1 << WIDX_TAB4)
         | (1 << WIDX_TAB5) | (1 << WIDX_TAB6) | (1 << WIDX_TAB7) | (1 << WIDX_TAB8);
 
-    window_scenarioselect_init_tabs(window);
-    initialise_list_items(window);
+    if (!_waitingForScan)
+    {
+        window_scenarioselect_init_tabs(window);
+        initialise_list_items(window);
+    }
 
     WindowInitScrollWidgets(window);
     window->viewport_focus_coordinates.var_480 = -1;
@@ -259,6 +270,18 @@ static void window_scenarioselect_close(rct_window* w)
     _listItems.shrink_to_fit();
 }
 
+static void window_scenarioselect_update(rct_window* w)
+{
+    if (_waitingForScan && !OpenRCT2::GetContext()->GetScenarioRepository()->IsScanning())
+    {
+        _waitingForScan = false;
+        scenario_repository_scan();
+        window_scenarioselect_init_tabs(w);
+        initialise_list_items(w);
+        w->Invalidate();
+    }
+}
+
 static void window_scenarioselect_mouseup(rct_window* w, rct_widgetindex widgetIndex)
 {
     if (widgetIndex == WIDX_CLOSE)
@@ -26,7 +26,6 @@
 #    include <openrct2/platform/platform.h>
 #    include <openrct2/sprites.h>
 #    include <openrct2/util/Util.h>
-#    include <tuple>
 
 #    define WWIDTH_MIN 500
 #    define WHEIGHT_MIN 300
@@ -36,7 +35,9 @@
 
 static char _playerName[32 + 1];
 static ServerList _serverList;
-static std::future<std::tuple<std::vector<ServerListEntry>, rct_string_id>> _fetchFuture;
+// The LAN and the master server are queried at the same time, the servers are added as soon as either replies
+static std::future<std::vector<ServerListEntry>> _localFetchFuture;
+static std::future<std::vector<ServerListEntry>> _onlineFetchFuture;
 static uint32_t _numPlayersOnline = 0;
 static rct_string_id _statusText = STR_SERVER_LIST_CONNECTING;
 
@@ -157,8 +158,9 @@ rct_window* window_server_list_open()
 
 static void window_server_list_close(rct_window* w)
 {
+    // A fetch still in progress carries on, so closing the window does not wait for the LAN query. Its servers are
+    // added once the window is opened again.
     _serverList = {};
-    _fetchFuture = {};
 }
 
 static void window_server_list_mouseup(rct_window* w, rct_widgetindex widgetIndex)
@@ -551,7 +553,7 @@ static void join_server(std::string address)
 
 static void server_list_fetch_servers_begin()
 {
-    if (_fetchFuture.valid())
+    if (_localFetchFuture.valid() || _onlineFetchFuture.valid())
     {
         // A fetch is already in progress
         return;
@@ -559,72 +561,63 @@ static void server_list_fetch_servers_begin()
 
     _serverList.Clear();
     _serverList.ReadAndAddFavourites();
+    // Show the servers from last time until the master server replies
+    _serverList.AddRange(_serverList.ReadCachedOnlineServerList());
+    _numPlayersOnline = _serverList.GetTotalPlayerCount();
     _statusText = STR_SERVER_LIST_CONNECTING;
 
-    _fetchFuture = std::async(std::launch::async, [] {
-        // Spin off background fetches
-        auto lanF = _serverList.FetchLocalServerListAsync();
-        auto wanF = _serverList.FetchOnlineServerListAsync();
+    _localFetchFuture = _serverList.FetchLocalServerListAsync();
+    _onlineFetchFuture = _serverList.FetchOnlineServerListAsync();
+    if (!_onlineFetchFuture.valid())
+    {
+        // Built without HTTP, there is no master server to wait for
+        _statusText = STR_X_PLAYERS_ONLINE;
+    }
+}
+
+static bool server_list_fetch_is_ready(const std::future<std::vector<ServerListEntry>>& future)
+{
+    return future.valid() && future.wait_for(std::chrono::seconds::zero()) == std::future_status::ready;
+}
 
-        // Merge or deal with errors
-        std::vector<ServerListEntry> allEntries;
+static void server_list_fetch_servers_check(rct_window* w)
+{
+    if (server_list_fetch_is_ready(_localFetchFuture))
+    {
         try
         {
-            auto entries = lanF.get();
-            allEntries.insert(allEntries.end(), entries.begin(), entries.end());
+            _serverList.AddRange(_localFetchFuture.get());
+            _numPlayersOnline = _serverList.GetTotalPlayerCount();
         }
-        catch (...)
+        catch (const std::exception& e)
         {
+            log_warning("Unable to query LAN servers: %s", e.what());
         }
+        _localFetchFuture = {};
+        w->Invalidate();
+    }
 
-        auto status = STR_NONE;
+    if (server_list_fetch_is_ready(_onlineFetchFuture))
+    {
         try
         {
-            auto entries = wanF.get();
-            allEntries.insert(allEntries.end(), entries.begin(), entries.end());
+            auto entries = _onlineFetchFuture.get();
+            _serverList.RemoveOnlineServers();
+            _serverList.AddRange(entries);
+            _numPlayersOnline = _serverList.GetTotalPlayerCount();
+            _statusText = STR_X_PLAYERS_ONLINE;
         }
         catch (const MasterServerException& e)
         {
-            status = e.StatusText;
+            _statusText = e.StatusText;
         }
-        catch (...)
+        catch (const std::exception& e)
         {
-            status = STR_SERVER_LIST_NO_CONNECTION;
-        }
-        return std::make_tuple(allEntries, status);
-    });
-}
-
-static void server_list_fetch_servers_check(rct_window* w)
-{
-    if (_fetchFuture.valid())
-    {
-        auto status = _fetchFuture.wait_for(std::chrono::seconds::zero());
-        if (status == std::future_status::ready)
-        {
-            try
-            {
-                auto [entries, statusText] = _fetchFuture.get();
-                _serverList.AddRange(entries);
-                _numPlayersOnline = _serverList.GetTotalPlayerCount();
-                _statusText = STR_X_PLAYERS_ONLINE;
-                if (statusText != STR_NONE)
-                {
-                    _statusText = statusText;
-                }
-            }
-            catch (const MasterServerException& e)
-            {
-                _statusText = e.StatusText;
-            }
-            catch (const std::exception& e)
-            {
-                _statusText = STR_SERVER_LIST_NO_CONNECTION;
-                log_warning("Unable to connect to master server: %s", e.what());
-            }
-            _fetchFuture = {};
-            w->Invalidate();
+            _statusText = STR_SERVER_LIST_NO_CONNECTION;
+            log_warning("Unable to connect to master server: %s", e.what());
         }
+        _onlineFetchFuture = {};
+        w->Invalidate();
     }
 }
 
@@ -798,9 +798,7 @@ static void window_title_command_editor_paint(rct_window* w, rct_drawpixelinfo*
             spriteString = STR_TITLE_COMMAND_EDITOR_FOLLOW_NO_SPRITE;
         }
 
-        gfx_set_dirty_blocks(
-            { { w->windowPos + ScreenCoordsXY{ w->widgets[WIDX_VIEWPORT].left, w->widgets[WIDX_VIEWPORT].top } },
-              { w->windowPos + ScreenCoordsXY{ w->widgets[WIDX_VIEWPORT].right, w->widgets[WIDX_VIEWPORT].bottom } } });
+        widget_invalidate(w, WIDX_VIEWPORT);
         DrawTextEllipsised(
             dpi, { w->windowPos.x + w->widgets[WIDX_VIEWPORT].left + 2, w->windowPos.y + w->widgets[WIDX_VIEWPORT].top + 1 },
             w->widgets[WIDX_VIEWPORT].width() - 2, spriteString, ft, { colour });
@@ -14,6 +14,7 @@
 #include <algorithm>
 #include <iterator>
 #include <limits>
+#include <optional>
 #include <openrct2-ui/interface/Dropdown.h>
 #include <openrct2-ui/interface/LandTool.h>
 #include <openrct2-ui/interface/Viewport.h>
@@ -314,6 +315,24 @@ static bool _landToolBlocked;
 static uint8_t _unkF64F0E;
 static int16_t _unkF64F0A;
 
+struct SceneryGhostAttempt
+{
+    ScenerySelection Selection;
+    CoordsXYZ Loc;
+    // The quadrant, edge or direction, whichever the type of scenery is placed with
+    uint8_t Variant;
+
+    bool operator==(const SceneryGhostAttempt& rhs) const
+    {
+        return Selection.SceneryType == rhs.Selection.SceneryType && Selection.EntryIndex == rhs.Selection.EntryIndex
+            && Loc == rhs.Loc && Variant == rhs.Variant;
+    }
+};
+
+// Each attempt to place a ghost runs the whole placement action, so a ghost that could not be placed is not
+// attempted again until the cursor moves to another tile or the placement changes
+static std::optional<SceneryGhostAttempt> _failedSceneryGhost;
+
 /**
  * Creates the main game top toolbar window.
  *  rct2: 0x0066B485 (part of 0x0066B3E8)
@@ -2593,6 +2612,19 @@ static money32 try_place_ghost_banner(CoordsXYZD loc, ObjectEntryIndex entryInde
  *
  *  rct2: 0x006E287B
  */
+static bool scenery_ghost_has_failed(const SceneryGhostAttempt& attempt)
+{
+    return _failedSceneryGhost.has_value() && *_failedSceneryGhost == attempt;
+}
+
+static void scenery_ghost_set_result(const SceneryGhostAttempt& attempt, money32 cost)
+{
+    if (cost == MONEY32_UNDEFINED)
+        _failedSceneryGhost = attempt;
+    else
+        _failedSceneryGhost.reset();
+}
+
 static void top_toolbar_tool_update_scenery(const ScreenCoordsXY& screenPos)
 {
     map_invalidate_selection_rect();
@@ -2677,6 +2709,11 @@ static void top_toolbar_tool_update_scenery(const ScreenCoordsXY& screenPos)
                 return;
             }
 
+            SceneryGhostAttempt attempt{ selection, { mapTile, gSceneryPlaceZ },
+                                         static_cast<uint8_t>(quadrant | (rotation << 2)) };
+            if (scenery_ghost_has_failed(attempt))
+                return;
+
             scenery_remove_ghost_tool_placement();
 
             _unkF64F0E = quadrant;
@@ -2699,6 +2736,7 @@ static void top_toolbar_tool_update_scenery(const ScreenCoordsXY& screenPos)
                 gSceneryPlaceZ += 8;
             }
 
+            scenery_ghost_set_result(attempt, cost);
             gSceneryPlaceCost = cost;
             break;
         }
@@ -2730,10 +2768,15 @@ static void top_toolbar_tool_update_scenery(const ScreenCoordsXY& screenPos)
                 return;
             }
 
+            SceneryGhostAttempt attempt{ selection, { mapTile, z }, 0 };
+            if (scenery_ghost_has_failed(attempt))
+                return;
+
             scenery_remove_ghost_tool_placement();
 
             cost = try_place_ghost_path_addition({ mapTile, z }, selection.EntryIndex);
 
+            scenery_ghost_set_result(attempt, cost);
             gSceneryPlaceCost = cost;
             break;
         }
@@ -2766,6 +2809,10 @@ static void top_toolbar_tool_update_scenery(const ScreenCoordsXY& screenPos)
                 return;
             }
 
+            SceneryGhostAttempt attempt{ selection, { mapTile, gSceneryPlaceZ }, edge };
+            if (scenery_ghost_has_failed(attempt))
+                return;
+
             scenery_remove_ghost_tool_placement();
 
             gSceneryGhostWallRotation = edge;
@@ -2789,6 +2836,7 @@ static void top_toolbar_tool_update_scenery(const ScreenCoordsXY& screenPos)
                 gSceneryPlaceZ += 8;
             }
 
+            scenery_ghost_set_result(attempt, cost);
             gSceneryPlaceCost = cost;
             break;
         }
@@ -2831,6 +2879,10 @@ static void top_toolbar_tool_update_scenery(const ScreenCoordsXY& screenPos)
                 return;
             }
 
+            SceneryGhostAttempt attempt{ selection, { mapTile, gSceneryPlaceZ }, direction };
+            if (scenery_ghost_has_failed(attempt))
+                return;
+
             scenery_remove_ghost_tool_placement();
 
             gSceneryPlaceObject.SceneryType = SCENERY_TYPE_LARGE;
@@ -2855,6 +2907,7 @@ static void top_toolbar_tool_update_scenery(const ScreenCoordsXY& screenPos)
                 gSceneryPlaceZ += COORDS_Z_STEP;
             }
 
+            scenery_ghost_set_result(attempt, cost);
             gSceneryPlaceCost = cost;
             break;
         }
@@ -2888,10 +2941,15 @@ static void top_toolbar_tool_update_scenery(const ScreenCoordsXY& screenPos)
                 return;
             }
 
+            SceneryGhostAttempt attempt{ selection, { mapTile, z }, direction };
+            if (scenery_ghost_has_failed(attempt))
+                return;
+
             scenery_remove_ghost_tool_placement();
 
             cost = try_place_ghost_banner({ mapTile, z, direction }, selection.EntryIndex);
 
+            scenery_ghost_set_result(attempt, cost);
             gSceneryPlaceCost = cost;
             break;
         }
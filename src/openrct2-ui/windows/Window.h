@@ -18,6 +18,7 @@
 using loadsave_callback = void (*)(int32_t result, const utf8* path);
 using scenarioselect_callback = void (*)(const utf8* path);
 struct Peep;
+struct TileChanges;
 struct TileElement;
 struct Vehicle;
 enum class GuestListFilterType : int32_t;
@@ -96,6 +97,7 @@ rct_window* window_new_campaign_open(int16_t campaignType);
 
 rct_window* window_install_track_open(const utf8* path);
 void window_guest_list_refresh_list();
+void window_guest_list_update_list();
 rct_window* window_guest_list_open();
 rct_window* window_guest_list_open_with_filter(GuestListFilterType type, int32_t index);
 rct_window* window_staff_fire_prompt_open(Peep* peep);
@@ -118,6 +120,7 @@ void TrackPlaceRestoreProvisional();
 
 rct_window* window_map_open();
 void window_map_reset();
+void window_map_tiles_changed(const TileChanges& changes);
 
 rct_window* window_research_open();
 void window_research_development_page_paint(rct_window* w, rct_drawpixelinfo* dpi, rct_widgetindex baseWidgetIndex);
@@ -130,6 +133,7 @@ void window_new_ride_focus(RideSelection rideItem);
 
 rct_window* window_ride_list_open();
 void window_ride_list_refresh_list(rct_window* w);
+void window_ride_list_request_refresh();
 
 rct_window* window_ride_main_open(Ride* ride);
 rct_window* window_ride_open_track(TileElement* tileElement);
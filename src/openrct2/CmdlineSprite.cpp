@@ -14,6 +14,7 @@
 #include "core/FileStream.h"
 #include "core/Imaging.h"
 #include "core/Json.hpp"
+#include "core/TaskScheduler.h"
 #include "drawing/Drawing.h"
 #include "drawing/ImageImporter.h"
 #include "object/ObjectLimits.h"
@@ -22,14 +23,19 @@
 #include "platform/platform.h"
 #include "util/Util.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstring>
 #include <optional>
+#include <string>
+#include <vector>
 
 #ifdef _WIN32
 #    include "core/String.hpp"
 #endif
 
+using namespace OpenRCT2;
 using namespace OpenRCT2::Drawing;
 
 class SpriteFile
@@ -38,6 +44,7 @@ public:
     rct_g1_header Header{};
     std::vector<rct_g1_element> Entries;
     std::vector<uint8_t> Data;
+    void Reserve(size_t numEntries, size_t dataSize);
     void AddImage(ImageImporter::ImportResult& image);
     bool Save(const utf8* path);
     static std::optional<SpriteFile> Open(const utf8* path);
@@ -89,6 +96,13 @@ void SpriteFile::MakeEntriesRelative()
     isAbsolute = false;
 }
 
+void SpriteFile::Reserve(size_t numEntries, size_t dataSize)
+{
+    ScopedRelativeSpriteFile scopedRelative(*this);
+    Entries.reserve(numEntries);
+    Data.reserve(dataSize);
+}
+
 void SpriteFile::AddImage(ImageImporter::ImportResult& image)
 {
     Header.num_entries++;
@@ -158,9 +172,12 @@ bool SpriteFile::Save(const utf8* path)
         {
             ScopedRelativeSpriteFile scopedRelative(*this);
 
+            // The entries are written in one go rather than one small write each
+            std::vector<rct_g1_element_32bit> entries;
+            entries.reserve(Entries.size());
             for (const auto& entry : Entries)
             {
-                rct_g1_element_32bit entry32bit{};
+                auto& entry32bit = entries.emplace_back();
 
                 entry32bit.offset = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(const_cast<uint8_t*>(entry.offset)));
                 entry32bit.width = entry.width;
@@ -169,9 +186,8 @@ bool SpriteFile::Save(const utf8* path)
                 entry32bit.y_offset = entry.y_offset;
                 entry32bit.flags = entry.flags;
                 entry32bit.zoomed_offset = entry.zoomed_offset;
-
-                stream.Write(&entry32bit, sizeof(entry32bit));
             }
+            stream.Write(entries.data(), entries.size() * sizeof(rct_g1_element_32bit));
             stream.Write(Data.data(), Header.total_size);
         }
         return true;
@@ -596,8 +612,17 @@ int32_t cmdline_for_sprite(const char** argv, int32_t argc)
         spriteFile.Header.total_size = 0;
 
         fprintf(stdout, "Building: %s\n", spriteFilePath);
+        auto startTime = std::chrono::steady_clock::now();
 
-        json_t sprite_description;
+        struct SpriteDescription
+        {
+            std::string ImagePath;
+            int16_t XOffset;
+            int16_t YOffset;
+            bool KeepPalette;
+            bool ForceBmp;
+        };
+        std::vector<SpriteDescription> descriptions;
 
         // Note: jsonSprite is deliberately left non-const: json_t behaviour changes when const
         for (auto& [jsonKey, jsonSprite] : jsonSprites.items())
@@ -623,20 +648,39 @@ int32_t cmdline_for_sprite(const char** argv, int32_t argc)
             bool forceBmp = !jsonSprite["palette"].is_null() && Json::GetBoolean(jsonSprite["forceBmp"]);
 
             auto imagePath = platform_get_absolute_path(strPath.c_str(), directoryPath);
+            descriptions.push_back({ imagePath, Json::GetNumber<int16_t>(x_offset), Json::GetNumber<int16_t>(y_offset),
+                                     keep_palette, forceBmp });
+        }
+
+        // The images are imported and compressed in parallel, then added in the order of the description file so the
+        // output does not depend on the number of threads.
+        std::vector<std::optional<ImageImporter::ImportResult>> importResults(descriptions.size());
+        TaskScheduler::Get().ParallelFor(descriptions.size(), 1, [&](size_t i) {
+            const auto& description = descriptions[i];
+            importResults[i] = SpriteImageImport(
+                description.ImagePath.c_str(), description.XOffset, description.YOffset, description.KeepPalette,
+                description.ForceBmp, gSpriteMode);
+        });
 
-            auto importResult = SpriteImageImport(
-                imagePath.c_str(), Json::GetNumber<int16_t>(x_offset), Json::GetNumber<int16_t>(y_offset), keep_palette,
-                forceBmp, gSpriteMode);
-            if (importResult == std::nullopt)
+        size_t dataSize = 0;
+        for (size_t i = 0; i < descriptions.size(); i++)
+        {
+            if (importResults[i] == std::nullopt)
             {
-                fprintf(stderr, "Could not import image file: %s\nCanceling\n", imagePath.c_str());
+                fprintf(stderr, "Could not import image file: %s\nCanceling\n", descriptions[i].ImagePath.c_str());
                 return -1;
             }
+            dataSize += importResults[i]->Buffer.size();
+        }
 
-            spriteFile.AddImage(importResult.value());
+        spriteFile.Reserve(descriptions.size(), dataSize);
+        for (size_t i = 0; i < descriptions.size(); i++)
+        {
+            spriteFile.AddImage(importResults[i].value());
+            importResults[i].reset();
 
             if (!silent)
-                fprintf(stdout, "Added: %s\n", imagePath.c_str());
+                fprintf(stdout, "Added: %s\n", descriptions[i].ImagePath.c_str());
         }
 
         if (!spriteFile.Save(spriteFilePath))
@@ -647,7 +691,10 @@ int32_t cmdline_for_sprite(const char** argv, int32_t argc)
 
         free(directoryPath);
 
-        fprintf(stdout, "Finished\n");
+        std::chrono::duration<double> duration = std::chrono::steady_clock::now() - startTime;
+        fprintf(
+            stdout, "Finished: %zu images, %.1f MiB in %.2f s (%.0f images/s)\n", descriptions.size(),
+            dataSize / (1024.0 * 1024.0), duration.count(), descriptions.size() / std::max(duration.count(), 0.001));
         return 1;
     }
     else
@@ -28,6 +28,7 @@
 #include "audio/AudioContext.h"
 #include "audio/audio.h"
 #include "config/Config.h"
+#include "core/AsyncLog.h"
 #include "core/Console.hpp"
 #include "core/File.h"
 #include "core/FileScanner.h"
@@ -36,6 +37,7 @@
 #include "core/Http.h"
 #include "core/MemoryStream.h"
 #include "core/Path.hpp"
+#include "core/Profiling.h"
 #include "core/String.hpp"
 #include "drawing/IDrawingEngine.h"
 #include "drawing/LightFX.h"
@@ -68,10 +70,12 @@
 
 #include <algorithm>
 #include <cmath>
+#include <chrono>
 #include <exception>
 #include <future>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <string>
 
 using namespace OpenRCT2;
@@ -84,6 +88,33 @@ using namespace OpenRCT2::Ui;
 
 namespace OpenRCT2
 {
+    /**
+     * Measures the phases of Context::Initialise, the durations are logged with --verbose.
+     */
+    class StartupTimer
+    {
+    private:
+        using Clock = std::chrono::high_resolution_clock;
+
+        Clock::time_point const _startTime = Clock::now();
+        Clock::time_point _phaseStartTime = _startTime;
+
+    public:
+        void EndPhase(const char* name)
+        {
+            auto now = Clock::now();
+            auto duration = std::chrono::duration<double, std::milli>(now - _phaseStartTime);
+            log_verbose("Startup: %s took %.1f ms", name, duration.count());
+            _phaseStartTime = now;
+        }
+
+        void Report() const
+        {
+            auto duration = std::chrono::duration<double, std::milli>(Clock::now() - _startTime);
+            log_verbose("Startup: Initialised in %.1f ms", duration.count());
+        }
+    };
+
     class Context final : public IContext
     {
     private:
@@ -128,6 +159,10 @@ namespace OpenRCT2
         // false.
         bool _finished = false;
 
+        // With --fast-start these are done the first time the repository is asked for.
+        std::once_flag _objectRepositoryLoaded;
+        std::once_flag _trackDesignsScanned;
+
         std::future<void> _versionCheckFuture;
         NewVersionInfo _newVersionInfo;
         bool _hasNewVersionInfo = false;
@@ -162,6 +197,12 @@ namespace OpenRCT2
             // NOTE: We must shutdown all systems here before Instance is set back to null.
             //       If objects use GetContext() in their destructor things won't go well.
 
+            // Flush a capture that was set to run until exit.
+            Profiling::StopCapture();
+
+            // Let an autosave that is still being written finish.
+            game_autosave_wait();
+
             GameActions::ClearQueue();
             network_close();
             window_close_all();
@@ -179,6 +220,9 @@ namespace OpenRCT2
             Audio::Close();
             config_release();
 
+            // Write out what is still queued while the console can still be reached through the context.
+            AsyncLog::Stop();
+
             Instance = nullptr;
         }
 
@@ -216,16 +260,21 @@ namespace OpenRCT2
 
         IObjectManager& GetObjectManager() override
         {
+            EnsureObjectRepositoryLoaded();
             return *_objectManager;
         }
 
         IObjectRepository& GetObjectRepository() override
         {
+            EnsureObjectRepositoryLoaded();
             return *_objectRepository;
         }
 
         ITrackDesignRepository* GetTrackDesignRepository() override
         {
+            std::call_once(_trackDesignsScanned, [this]() {
+                _trackDesignRepository->Scan(_localisationService->GetCurrentLanguage());
+            });
             return _trackDesignRepository.get();
         }
 
@@ -345,7 +394,9 @@ namespace OpenRCT2
             }
             _initialised = true;
 
+            StartupTimer startupTimer;
             crash_init();
+            AsyncLog::Start();
 
             if (gConfigGeneral.last_run_version != nullptr && String::Equals(gConfigGeneral.last_run_version, OPENRCT2_VERSION))
             {
@@ -377,6 +428,7 @@ namespace OpenRCT2
                     return false;
                 }
             }
+            startupTimer.EndPhase("Language");
 
             // TODO add configuration option to allow multiple instances
             // if (!gOpenRCT2Headless && !platform_lock_single_instance()) {
@@ -440,18 +492,30 @@ namespace OpenRCT2
 
             EnsureUserContentDirectoriesExist();
 
-            // TODO Ideally we want to delay this until we show the title so that we can
-            //      still open the game window and draw a progress screen for the creation
-            //      of the object cache.
-            _objectRepository->LoadOrConstruct(_localisationService->GetCurrentLanguage());
+            startupTimer.EndPhase("Platform");
 
-            // TODO Like objects, this can take a while if there are a lot of track designs
-            //      its also really something really we might want to do in the background
-            //      as its not required until the player wants to place a new ride.
-            _trackDesignRepository->Scan(_localisationService->GetCurrentLanguage());
-
-            _scenarioRepository->Scan(_localisationService->GetCurrentLanguage());
-            TitleSequenceManager::Scan();
+            if (!gOpenRCT2FastStart)
+            {
+                // The repositories can share the listings of directories they both scan
+                Path::DirectoryListingCache directoryListingCache;
+
+                // TODO Ideally we want to delay this until we show the title so that we can
+                //      still open the game window and draw a progress screen for the creation
+                //      of the object cache.
+                EnsureObjectRepositoryLoaded();
+                startupTimer.EndPhase("Object repository");
+
+                // TODO Like objects, this can take a while if there are a lot of track designs
+                //      its also really something really we might want to do in the background
+                //      as its not required until the player wants to place a new ride.
+                GetTrackDesignRepository();
+                startupTimer.EndPhase("Track design repository");
+
+                // Scenarios are not needed until the scenario select window is opened, which waits for them if needed.
+                _scenarioRepository->ScanAsync(_localisationService->GetCurrentLanguage());
+                TitleSequenceManager::Scan();
+                startupTimer.EndPhase("Title sequences");
+            }
 
             if (!gOpenRCT2Headless)
             {
@@ -459,6 +523,7 @@ namespace OpenRCT2
                 PopulateDevices();
                 InitRideSoundsAndInfo();
                 gGameSoundsOff = !gConfigSound.master_sound_enabled;
+                startupTimer.EndPhase("Audio");
             }
 
             network_set_env(_env);
@@ -474,6 +539,7 @@ namespace OpenRCT2
 #ifdef __ENABLE_LIGHTFX__
                 lightfx_init();
 #endif
+                startupTimer.EndPhase("Graphics");
             }
 
             gScenarioTicks = 0;
@@ -485,10 +551,19 @@ namespace OpenRCT2
 
             _titleScreen = std::make_unique<TitleScreen>(*_gameState);
             _uiContext->Initialise();
+            startupTimer.EndPhase("Game state");
+            startupTimer.Report();
 
             return true;
         }
 
+        void EnsureObjectRepositoryLoaded()
+        {
+            std::call_once(_objectRepositoryLoaded, [this]() {
+                _objectRepository->LoadOrConstruct(_localisationService->GetCurrentLanguage());
+            });
+        }
+
         void InitialiseDrawingEngine() final override
         {
             assert(_drawingEngine == nullptr);
@@ -616,7 +691,7 @@ namespace OpenRCT2
                 else
                 {
                     // Save is an S6 (RCT2 format)
-                    parkImporter = ParkImporter::CreateS6(*_objectRepository);
+                    parkImporter = ParkImporter::CreateS6(GetObjectRepository());
                 }
 
                 auto result = parkImporter->LoadFromStream(stream, info.Type == FILE_TYPE::SCENARIO, false, path.c_str());
@@ -625,7 +700,7 @@ namespace OpenRCT2
                 // so reload the title screen if that happens.
                 loadTitleScreenFirstOnFail = true;
 
-                _objectManager->LoadObjects(result.RequiredObjects.data(), result.RequiredObjects.size());
+                GetObjectManager().LoadObjects(result.RequiredObjects.data(), result.RequiredObjects.size());
                 parkImporter->Import();
                 gScenarioSavePath = path;
                 gCurrentLoadedPath = path;
@@ -994,7 +1069,12 @@ namespace OpenRCT2
 
             if (_accumulator < GAME_UPDATE_TIME_MS)
             {
-                platform_sleep(GAME_UPDATE_TIME_MS - _accumulator - 1);
+                // A headless server wakes up as soon as a client sends something instead of sleeping through it.
+                const auto timeout = static_cast<uint32_t>(std::max(GAME_UPDATE_TIME_MS - _accumulator - 1, 0.0f));
+                if (!gOpenRCT2Headless || !network_wait_for_events(timeout))
+                {
+                    platform_sleep(timeout);
+                }
                 return;
             }
 
@@ -1415,6 +1495,10 @@ rct_window* context_open_intent(Intent* intent)
 
 void context_broadcast_intent(Intent* intent)
 {
+    // Intents only refresh windows
+    if (gOpenRCT2NoPresentation)
+        return;
+
     auto windowManager = GetContext()->GetUiContext()->GetWindowManager();
     windowManager->BroadcastIntent(*intent);
 }
@@ -9,11 +9,15 @@
 
 #include "Diagnostic.h"
 
+#include "core/AsyncLog.h"
 #include "core/Console.hpp"
 #include "core/String.hpp"
 
+#include <atomic>
+#include <chrono>
 #include <cstdarg>
 #include <cstdio>
+#include <iterator>
 
 #ifdef __ANDROID__
 #    include <android/log.h>
@@ -74,19 +78,60 @@ static constexpr const char* _level_strings[] = {
     "FATAL", "ERROR", "WARNING", "VERBOSE", "INFO",
 };
 
-static void diagnostic_print(DiagnosticLevel level, const std::string& prefix, const std::string& msg)
+// While logging asynchronously, each place that logs is held to this many messages a second, except for fatal ones.
+// The places are told apart by their format string, sharing a counter when two of them land in the same slot.
+static constexpr uint32_t LOG_RATE_LIMIT_PER_SECOND = 100;
+
+struct LogRateLimit
+{
+    std::atomic<uint32_t> Second;
+    std::atomic<uint32_t> Count;
+};
+
+static LogRateLimit _log_rate_limits[512];
+
+static bool diagnostic_check_rate_limit(DiagnosticLevel level, const char* format, uint32_t& suppressed)
+{
+    suppressed = 0;
+    if (level == DiagnosticLevel::Fatal || !AsyncLog::IsRunning())
+        return true;
+
+    auto& limit = _log_rate_limits[(reinterpret_cast<uintptr_t>(format) >> 3) % std::size(_log_rate_limits)];
+    auto now = static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    auto second = limit.Second.load(std::memory_order_relaxed);
+    if (second != now && limit.Second.compare_exchange_strong(second, now, std::memory_order_relaxed))
+    {
+        auto count = limit.Count.exchange(0, std::memory_order_relaxed);
+        suppressed = count > LOG_RATE_LIMIT_PER_SECOND ? count - LOG_RATE_LIMIT_PER_SECOND : 0;
+    }
+    return limit.Count.fetch_add(1, std::memory_order_relaxed) < LOG_RATE_LIMIT_PER_SECOND;
+}
+
+static void diagnostic_print(DiagnosticLevel level, const std::string& prefix, std::string msg, uint32_t suppressed)
 {
+    if (suppressed > 0)
+    {
+        msg += String::StdFormat(" (%u more like this were left out)", suppressed);
+    }
+
     auto stream = diagnostic_get_stream(level);
-    if (stream == stdout)
-        Console::WriteLine("%s%s", prefix.c_str(), msg.c_str());
-    else
+    if (level == DiagnosticLevel::Fatal)
+    {
+        // The process may not last long enough for the writer thread to get to it
+        AsyncLog::Flush();
         Console::Error::WriteLine("%s%s", prefix.c_str(), msg.c_str());
+        return;
+    }
+    AsyncLog::WriteLine(stream == stdout ? AsyncLog::Target::StdOut : AsyncLog::Target::StdErr, prefix + msg);
 }
 
 void diagnostic_log(DiagnosticLevel diagnosticLevel, const char* format, ...)
 {
     va_list args;
-    if (_log_levels[static_cast<uint8_t>(diagnosticLevel)])
+    uint32_t suppressed;
+    if (_log_levels[static_cast<uint8_t>(diagnosticLevel)]
+        && diagnostic_check_rate_limit(diagnosticLevel, format, suppressed))
     {
         // Level
         auto prefix = String::StdFormat("%s: ", _level_strings[static_cast<uint8_t>(diagnosticLevel)]);
@@ -96,7 +141,7 @@ void diagnostic_log(DiagnosticLevel diagnosticLevel, const char* format, ...)
         auto msg = String::StdFormat_VA(format, args);
         va_end(args);
 
-        diagnostic_print(diagnosticLevel, prefix, msg);
+        diagnostic_print(diagnosticLevel, prefix, std::move(msg), suppressed);
     }
 }
 
@@ -104,7 +149,9 @@ void diagnostic_log_with_location(
     DiagnosticLevel diagnosticLevel, const char* file, const char* function, int32_t line, const char* format, ...)
 {
     va_list args;
-    if (_log_levels[static_cast<uint8_t>(diagnosticLevel)])
+    uint32_t suppressed;
+    if (_log_levels[static_cast<uint8_t>(diagnosticLevel)]
+        && diagnostic_check_rate_limit(diagnosticLevel, format, suppressed))
     {
         // Level and source code information
         std::string prefix;
@@ -123,7 +170,7 @@ void diagnostic_log_with_location(
         auto msg = String::StdFormat_VA(format, args);
         va_end(args);
 
-        diagnostic_print(diagnosticLevel, prefix, msg);
+        diagnostic_print(diagnosticLevel, prefix, std::move(msg), suppressed);
     }
 }
 
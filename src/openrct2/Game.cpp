@@ -22,6 +22,7 @@
 #include "actions/LoadOrQuitAction.h"
 #include "audio/audio.h"
 #include "config/Config.h"
+#include "core/ChunkFile.h"
 #include "core/Console.hpp"
 #include "core/FileScanner.h"
 #include "core/Path.hpp"
@@ -41,6 +42,7 @@
 #include "peep/Staff.h"
 #include "platform/Platform2.h"
 #include "rct1/RCT1.h"
+#include "rct2/S6Exporter.h"
 #include "ride/Ride.h"
 #include "ride/RideRatings.h"
 #include "ride/Station.h"
@@ -65,10 +67,12 @@
 #include "world/Scenery.h"
 #include "world/Sprite.h"
 #include "world/Surface.h"
+#include "world/TileChanges.h"
 #include "world/Water.h"
 
 #include <algorithm>
 #include <cstdio>
+#include <future>
 #include <iterator>
 #include <memory>
 
@@ -78,6 +82,7 @@ int32_t gGameSpeed = 1;
 bool gDoSingleUpdate = false;
 float gDayNightCycle = 0;
 bool gInUpdateCode = false;
+bool gInTickBatch = false;
 bool gInMapInitCode = false;
 std::string gCurrentLoadedPath;
 
@@ -548,6 +553,7 @@ void game_load_init()
     reset_sprite_spatial_index();
     reset_all_sprite_quadrant_placements();
     scenery_set_default_placement_configuration();
+    TileChangesMarkAll();
 
     auto intent = Intent(INTENT_ACTION_REFRESH_NEW_RIDES);
     context_broadcast_intent(&intent);
@@ -657,20 +663,11 @@ void save_game_as()
     delete intent;
 }
 
-static void limit_autosave_count(const size_t numberOfFilesToKeep, bool processLandscapeFolder)
+static void limit_autosave_count(const size_t numberOfFilesToKeep, const std::string& folderDirectory, const char* fileFilter)
 {
     size_t autosavesCount = 0;
     size_t numAutosavesToDelete = 0;
 
-    auto environment = GetContext()->GetPlatformEnvironment();
-    auto folderDirectory = environment->GetDirectoryPath(DIRBASE::USER, DIRID::SAVE);
-    char const* fileFilter = "autosave_*.sv6";
-    if (processLandscapeFolder)
-    {
-        folderDirectory = environment->GetDirectoryPath(DIRBASE::USER, DIRID::LANDSCAPE);
-        fileFilter = "autosave_*.sc6";
-    }
-
     utf8 filter[MAX_PATH];
     safe_strcpy(filter, folderDirectory.c_str(), sizeof(filter));
     safe_strcat_path(filter, "autosave", sizeof(filter));
@@ -722,6 +719,10 @@ static void limit_autosave_count(const size_t numberOfFilesToKeep, bool processL
     }
 }
 
+static std::future<void> _autosaveTask;
+// Chunks of the last park file autosave, only used by the autosave task
+static ChunkFileCache _autosaveChunkCache;
+
 void game_autosave()
 {
     const char* subDirectory = "save";
@@ -733,6 +734,10 @@ void game_autosave()
         fileExtension = ".sc6";
         saveFlags |= 2;
     }
+    else if (gConfigGeneral.autosave_park_files)
+    {
+        fileExtension = ".park";
+    }
 
     // Retrieve current time
     auto currentDate = Platform::GetDateLocal();
@@ -743,8 +748,15 @@ void game_autosave()
         timeName, sizeof(timeName), "autosave_%04u-%02u-%02u_%02u-%02u-%02u%s", currentDate.year, currentDate.month,
         currentDate.day, currentTime.hour, currentTime.minute, currentTime.second, fileExtension);
 
-    int32_t autosavesToKeep = gConfigGeneral.autosave_amount;
-    limit_autosave_count(autosavesToKeep - 1, (gScreenFlags & SCREEN_FLAGS_EDITOR));
+    auto environment = GetContext()->GetPlatformEnvironment();
+    auto folderDirectory = environment->GetDirectoryPath(DIRBASE::USER, DIRID::SAVE);
+    const char* fileFilter = gConfigGeneral.autosave_park_files ? "autosave_*.park" : "autosave_*.sv6";
+    if (gScreenFlags & SCREEN_FLAGS_EDITOR)
+    {
+        folderDirectory = environment->GetDirectoryPath(DIRBASE::USER, DIRID::LANDSCAPE);
+        fileFilter = "autosave_*.sc6";
+    }
+    size_t autosavesToKeep = gConfigGeneral.autosave_amount;
 
     utf8 path[MAX_PATH];
     utf8 backupPath[MAX_PATH];
@@ -757,13 +769,37 @@ void game_autosave()
     safe_strcat(backupPath, fileExtension, sizeof(backupPath));
     safe_strcat(backupPath, ".bak", sizeof(backupPath));
 
-    if (Platform::FileExists(path))
+    // Only copy the park on the game thread, encoding and writing it happens in the background.
+    game_autosave_wait();
+    auto s6exporter = scenario_export(saveFlags);
+    if (s6exporter == nullptr)
     {
-        platform_file_copy(path, backupPath, true);
+        Console::Error::WriteLine("Could not autosave the scenario. Is the save folder writeable?");
+        return;
     }
 
-    if (!scenario_save(path, saveFlags))
-        Console::Error::WriteLine("Could not autosave the scenario. Is the save folder writeable?");
+    _autosaveTask = std::async(
+        std::launch::async,
+        [s6exporter = std::move(s6exporter), folderDirectory, fileFilter, autosavesToKeep, path = std::string(path),
+         backupPath = std::string(backupPath), saveFlags]() {
+            limit_autosave_count(autosavesToKeep - 1, folderDirectory, fileFilter);
+
+            if (Platform::FileExists(path))
+            {
+                platform_file_copy(path.c_str(), backupPath.c_str(), true);
+            }
+
+            if (!scenario_write(*s6exporter, path.c_str(), saveFlags, &_autosaveChunkCache))
+                Console::Error::WriteLine("Could not autosave the scenario. Is the save folder writeable?");
+        });
+}
+
+void game_autosave_wait()
+{
+    if (_autosaveTask.valid())
+    {
+        _autosaveTask.wait();
+    }
 }
 
 static void game_load_or_quit_no_save_prompt_callback(int32_t result, const utf8* path)
@@ -145,6 +145,8 @@ extern int32_t gGameSpeed;
 extern bool gDoSingleUpdate;
 extern float gDayNightCycle;
 extern bool gInUpdateCode;
+// Set while the ticks of a fast-forward batch run, they leave the sounds and redrawing for the end of the batch.
+extern bool gInTickBatch;
 extern bool gInMapInitCode;
 extern std::string gCurrentLoadedPath;
 
@@ -172,6 +174,7 @@ void save_game_as();
 void save_game_cmd(const utf8* name = nullptr);
 void save_game_with_name(const utf8* name);
 void game_autosave();
+void game_autosave_wait();
 void game_convert_strings_to_utf8();
 void game_convert_strings_to_rct2(rct_s6_data* s6);
 void utf8_to_rct2_self(char* buffer, size_t length);
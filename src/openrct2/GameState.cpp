@@ -19,10 +19,14 @@
 #include "ReplayManager.h"
 #include "actions/GameAction.h"
 #include "config/Config.h"
+#include "core/MemoryUsage.h"
+#include "core/Profiling.h"
+#include "interface/MapTiles.h"
 #include "interface/Screenshot.h"
 #include "localisation/Date.h"
 #include "localisation/Localisation.h"
 #include "management/NewsItem.h"
+#include "network/ServerMetrics.h"
 #include "network/network.h"
 #include "peep/Staff.h"
 #include "platform/Platform2.h"
@@ -33,10 +37,12 @@
 #include "ui/UiContext.h"
 #include "windows/Intent.h"
 #include "world/Climate.h"
+#include "world/Map.h"
 #include "world/MapAnimation.h"
 #include "world/Park.h"
 #include "world/Scenery.h"
 #include "world/Sprite.h"
+#include "world/TileChanges.h"
 
 #include <algorithm>
 #include <chrono>
@@ -47,6 +53,9 @@ using namespace OpenRCT2::Scripting;
 GameState::GameState()
 {
     _park = std::make_unique<Park>();
+
+    MemoryUsageSetReporter(MemoryUsageCategory::TileElements, map_get_memory_usage);
+    MemoryUsageSetReporter(MemoryUsageCategory::Entities, sprite_get_memory_usage);
 }
 
 /**
@@ -114,7 +123,13 @@ void GameState::Update()
 
     network_update();
 
-    if (network_get_mode() == NETWORK_MODE_CLIENT && network_get_status() == NETWORK_STATUS_CONNECTED
+    if (network_is_resuming())
+    {
+        // The park is held where the connection was lost until the server has sent what was missed since.
+        numUpdates = 0;
+    }
+    else if (
+        network_get_mode() == NETWORK_MODE_CLIENT && network_get_status() == NETWORK_STATUS_CONNECTED
         && network_get_authstatus() == NetworkAuth::Ok)
     {
         numUpdates = std::clamp<uint32_t>(network_get_server_tick() - gCurrentTicks, 0, 10);
@@ -159,13 +174,30 @@ void GameState::Update()
             network_process_pending();
 
             GameActions::ProcessQueue();
+            News::FlushPendingItems();
         }
     }
 
+    // When the game is sped up and the ticks are expensive, stop once a frame's worth of time has been spent so
+    // the screen keeps being drawn, the game then runs as fast as it can instead of at the selected speed.
+    // Clients have to keep up with the server so they always run every tick.
+    bool pace = gConfigGeneral.frame_pacing && !gOpenRCT2Headless && network_get_mode() != NETWORK_MODE_CLIENT;
+    auto updateStart = std::chrono::steady_clock::now();
+
+    // Fast-forwarding in single player runs the ticks as one batch, the sounds and the redrawing of the entities and
+    // map animations only happen once at the end instead of after every tick.
+    gInTickBatch = numUpdates > 1 && network_get_mode() == NETWORK_MODE_NONE;
+    bool batched = gInTickBatch;
+
     // Update the game one or more times
     for (uint32_t i = 0; i < numUpdates; i++)
     {
-        UpdateLogic();
+        UpdateLogic(ServerMetricsBeginTick());
+        ServerMetricsEndTick();
+        if (pace && std::chrono::steady_clock::now() - updateStart >= std::chrono::milliseconds(GAME_UPDATE_TIME_MS))
+        {
+            break;
+        }
         if (gGameSpeed == 1)
         {
             if (input_get_state() == InputState::Reset || input_get_state() == InputState::Normal)
@@ -183,6 +215,18 @@ void GameState::Update()
         }
     }
 
+    ServerMetricsUpdate();
+
+    gInTickBatch = false;
+    if (batched && !gOpenRCT2NoPresentation)
+    {
+        vehicle_sounds_update();
+        peep_update_crowd_noise();
+        climate_update_sound();
+        map_animation_invalidate_presentation();
+        gfx_invalidate_screen();
+    }
+
     if (!gOpenRCT2Headless)
     {
         input_set_flag(INPUT_FLAG_VIEWPORT_SCROLLING, false);
@@ -228,21 +272,84 @@ void GameState::Update()
     gInUpdateCode = false;
 }
 
+const char* OpenRCT2::GetLogicTimePartName(LogicTimePart part)
+{
+    switch (part)
+    {
+        case LogicTimePart::NetworkUpdate:
+            return "NetworkUpdate";
+        case LogicTimePart::Date:
+            return "Date";
+        case LogicTimePart::Scenario:
+            return "Scenario";
+        case LogicTimePart::Climate:
+            return "Climate";
+        case LogicTimePart::MapTiles:
+            return "MapTiles";
+        case LogicTimePart::MapStashProvisionalElements:
+            return "MapStashProvisionalElements";
+        case LogicTimePart::MapPathWideFlags:
+            return "MapPathWideFlags";
+        case LogicTimePart::Peep:
+            return "Peep";
+        case LogicTimePart::MapRestoreProvisionalElements:
+            return "MapRestoreProvisionalElements";
+        case LogicTimePart::Vehicle:
+            return "Vehicle";
+        case LogicTimePart::Misc:
+            return "Misc";
+        case LogicTimePart::Ride:
+            return "Ride";
+        case LogicTimePart::Park:
+            return "Park";
+        case LogicTimePart::Research:
+            return "Research";
+        case LogicTimePart::RideRatings:
+            return "RideRatings";
+        case LogicTimePart::RideMeasurments:
+            return "RideMeasurements";
+        case LogicTimePart::News:
+            return "News";
+        case LogicTimePart::MapAnimation:
+            return "MapAnimation";
+        case LogicTimePart::Sounds:
+            return "Sounds";
+        case LogicTimePart::GameActions:
+            return "GameActions";
+        case LogicTimePart::NetworkFlush:
+            return "NetworkFlush";
+        case LogicTimePart::Scripts:
+            return "Scripts";
+    }
+    return "Unknown";
+}
+
 void GameState::UpdateLogic(LogicTimings* timings)
 {
+    PROFILE_SCOPE("GameState::UpdateLogic");
+
     auto start_time = std::chrono::high_resolution_clock::now();
+    auto part_begin = Profiling::IsCapturing() ? Profiling::GetTimestamp() : 0;
 
-    auto report_time = [timings, start_time](LogicTimePart part) {
+    auto report_time = [timings, start_time, &part_begin](LogicTimePart part) {
         if (timings != nullptr)
         {
             timings->TimingInfo[part][timings->CurrentIdx] = std::chrono::high_resolution_clock::now() - start_time;
         }
+        if (Profiling::IsCapturing())
+        {
+            auto part_end = Profiling::GetTimestamp();
+            Profiling::RecordZone(GetLogicTimePartName(part), part_begin, part_end);
+            part_begin = part_end;
+        }
     };
 
     gScreenAge++;
     if (gScreenAge == 0)
         gScreenAge--;
 
+    scenario_rand_begin_tick();
+
     GetContext()->GetReplayManager()->Update();
 
     network_update();
@@ -329,13 +436,20 @@ void GameState::UpdateLogic(LogicTimings* timings)
     News::UpdateCurrentItem();
     report_time(LogicTimePart::News);
 
+    // Also counts down the on-ride photo timeouts, so this runs even without presentation.
     map_animation_invalidate_all();
     report_time(LogicTimePart::MapAnimation);
-    vehicle_sounds_update();
-    peep_update_crowd_noise();
-    climate_update_sound();
+    if (!gOpenRCT2NoPresentation && !gInTickBatch)
+    {
+        vehicle_sounds_update();
+        peep_update_crowd_noise();
+        climate_update_sound();
+    }
     report_time(LogicTimePart::Sounds);
-    editor_open_windows_for_current_step();
+    if (!gOpenRCT2NoPresentation)
+    {
+        editor_open_windows_for_current_step();
+    }
 
     // Update windows
     // window_dispatch_update_all();
@@ -347,6 +461,7 @@ void GameState::UpdateLogic(LogicTimings* timings)
     }
 
     GameActions::ProcessQueue();
+    News::FlushPendingItems();
     report_time(LogicTimePart::GameActions);
 
     network_process_pending();
@@ -365,6 +480,28 @@ void GameState::UpdateLogic(LogicTimings* timings)
     {
         hookEngine.Call(HOOK_TYPE::INTERVAL_DAY, true);
     }
+#endif
+
+    auto tileChanges = TileChangesTake();
+    if (!tileChanges.IsEmpty() && TileChangesIsConsumerEnabled(TileChangesConsumer::Console))
+    {
+        WriteTileChanges(tileChanges);
+    }
+    if (!tileChanges.IsEmpty() && TileChangesIsConsumerEnabled(TileChangesConsumer::MapWindow))
+    {
+        auto intent = Intent(INTENT_ACTION_MAP_TILES_CHANGED);
+        intent.putExtra(INTENT_EXTRA_TILE_CHANGES, &tileChanges);
+        context_broadcast_intent(&intent);
+    }
+    if (MapTilesIsEnabled())
+    {
+        MapTilesAddChanges(tileChanges);
+        MapTilesUpdate();
+    }
+
+#ifdef ENABLE_SCRIPTING
+    GetContext()->GetScriptEngine().RunMapChangeHooks(tileChanges);
+    hookEngine.UpdateBudgets();
     report_time(LogicTimePart::Scripts);
 #endif
 
@@ -372,6 +509,32 @@ void GameState::UpdateLogic(LogicTimings* timings)
     {
         timings->CurrentIdx = (timings->CurrentIdx + 1) % LOGIC_UPDATE_MEASUREMENTS_COUNT;
     }
+
+    Profiling::OnTickEnd();
+}
+
+/**
+ * Writes the tiles changed this tick as one line to stdout, for tools that mirror the map:
+ * "tile_changes <tick> all" when the whole map was replaced, otherwise "tile_changes <tick> x,y x,y ...".
+ */
+void GameState::WriteTileChanges(const TileChanges& changes)
+{
+    auto line = "tile_changes " + std::to_string(gCurrentTicks);
+    if (changes.All)
+    {
+        line += " all";
+    }
+    else
+    {
+        for (const auto& tilePos : changes.Tiles)
+        {
+            line += ' ';
+            line += std::to_string(tilePos.x);
+            line += ',';
+            line += std::to_string(tilePos.y);
+        }
+    }
+    GetContext()->WriteLine(line);
 }
 
 void GameState::CreateStateSnapshot()
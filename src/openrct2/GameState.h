@@ -16,6 +16,8 @@
 #include <memory>
 #include <unordered_map>
 
+struct TileChanges;
+
 namespace OpenRCT2
 {
     class Park;
@@ -47,6 +49,8 @@ namespace OpenRCT2
         Scripts,
     };
 
+    const char* GetLogicTimePartName(LogicTimePart part);
+
     // ~6.5s at 40Hz
     constexpr size_t LOGIC_UPDATE_MEASUREMENTS_COUNT = 256;
 
@@ -88,5 +92,6 @@ namespace OpenRCT2
 
     private:
         void CreateStateSnapshot();
+        void WriteTileChanges(const TileChanges& changes);
     };
 } // namespace OpenRCT2
@@ -17,23 +17,165 @@
 static constexpr size_t MaximumGameStateSnapshots = 32;
 static constexpr uint32_t InvalidTick = 0xFFFFFFFF;
 
+// Every this many captures the entities are stored in full rather than as changes since the previous capture,
+// which bounds the amount of deltas to apply to restore a snapshot.
+static constexpr uint32_t SnapshotKeyframeInterval = 8;
+
+// Unchanged bytes between two changed ones are still stored if there are fewer than this, a new run costs 4 bytes.
+static constexpr size_t SnapshotDeltaMinGap = 4;
+
+using SpriteImage = std::vector<rct_sprite>;
+
+/*
+ * The entities of a snapshot are stored as the XOR of every changed entity against its state in the base snapshot,
+ * as runs of changed bytes. Keyframes have no base and store the XOR against an empty entity.
+ */
 struct GameStateSnapshot_t
 {
     GameStateSnapshot_t& operator=(GameStateSnapshot_t&& mv) noexcept
     {
         tick = mv.tick;
-        storedSprites = std::move(mv.storedSprites);
+        srand0 = mv.srand0;
+        base = mv.base;
+        entityDeltas = std::move(mv.entityDeltas);
         return *this;
     }
 
     uint32_t tick = InvalidTick;
     uint32_t srand0 = 0;
 
-    OpenRCT2::MemoryStream storedSprites;
+    // The snapshot the deltas apply to, nullptr for keyframes.
+    const GameStateSnapshot_t* base = nullptr;
+    std::vector<uint8_t> entityDeltas;
+
     OpenRCT2::MemoryStream parkParameters;
 
+    static const rct_sprite& GetEmptySprite()
+    {
+        static const rct_sprite emptySprite = []() {
+            rct_sprite sprite;
+            sprite.misc.Type = EntityType::Null;
+            return sprite;
+        }();
+        return emptySprite;
+    }
+
+    static SpriteImage CreateEmptyImage()
+    {
+        return SpriteImage(MAX_ENTITIES, GetEmptySprite());
+    }
+
+    /*
+     * Appends the changes from prev to cur for a single entity, returns false if there are none.
+     */
+    bool AppendEntityDelta(uint32_t index, const rct_sprite& prev, const rct_sprite& cur)
+    {
+        const auto* a = reinterpret_cast<const uint8_t*>(&prev);
+        const auto* b = reinterpret_cast<const uint8_t*>(&cur);
+        if (std::memcmp(a, b, sizeof(rct_sprite)) == 0)
+            return false;
+
+        const size_t headerPos = entityDeltas.size();
+        WriteValue<uint16_t>(static_cast<uint16_t>(index));
+        WriteValue<uint16_t>(0);
+
+        uint16_t numRuns = 0;
+        size_t pos = 0;
+        while (pos < sizeof(rct_sprite))
+        {
+            while (pos < sizeof(rct_sprite) && a[pos] == b[pos])
+                pos++;
+            if (pos == sizeof(rct_sprite))
+                break;
+
+            const size_t start = pos;
+            size_t end = pos;
+            size_t gap = 0;
+            for (; pos < sizeof(rct_sprite) && gap < SnapshotDeltaMinGap; pos++)
+            {
+                if (a[pos] != b[pos])
+                {
+                    end = pos + 1;
+                    gap = 0;
+                }
+                else
+                {
+                    gap++;
+                }
+            }
+
+            WriteValue<uint16_t>(static_cast<uint16_t>(start));
+            WriteValue<uint16_t>(static_cast<uint16_t>(end - start));
+            for (size_t i = start; i < end; i++)
+            {
+                entityDeltas.push_back(a[i] ^ b[i]);
+            }
+            numRuns++;
+        }
+
+        std::memcpy(&entityDeltas[headerPos + sizeof(uint16_t)], &numRuns, sizeof(numRuns));
+        return true;
+    }
+
+    /*
+     * Stores the whole image as a keyframe.
+     */
+    void EncodeKeyframe(const SpriteImage& image)
+    {
+        base = nullptr;
+        entityDeltas.clear();
+        const auto& emptySprite = GetEmptySprite();
+        for (size_t i = 0; i < image.size(); i++)
+        {
+            AppendEntityDelta(static_cast<uint32_t>(i), emptySprite, image[i]);
+        }
+        entityDeltas.shrink_to_fit();
+    }
+
+    void ApplyDeltas(SpriteImage& image) const
+    {
+        size_t pos = 0;
+        while (pos < entityDeltas.size())
+        {
+            const auto index = ReadValue<uint16_t>(pos);
+            const auto numRuns = ReadValue<uint16_t>(pos);
+            auto* dst = reinterpret_cast<uint8_t*>(&image[index]);
+            for (uint16_t run = 0; run < numRuns; run++)
+            {
+                const auto offset = ReadValue<uint16_t>(pos);
+                const auto length = ReadValue<uint16_t>(pos);
+                for (uint16_t i = 0; i < length; i++)
+                {
+                    dst[offset + i] ^= entityDeltas[pos + i];
+                }
+                pos += length;
+            }
+        }
+    }
+
+    /*
+     * Restores the entities of the snapshot by applying the deltas from its keyframe onwards.
+     */
+    SpriteImage Decode() const
+    {
+        std::vector<const GameStateSnapshot_t*> chain;
+        for (auto* snapshot = this; snapshot != nullptr; snapshot = snapshot->base)
+        {
+            chain.push_back(snapshot);
+        }
+
+        auto image = CreateEmptyImage();
+        for (auto it = chain.rbegin(); it != chain.rend(); it++)
+        {
+            (*it)->ApplyDeltas(image);
+        }
+        return image;
+    }
+
     // Must pass a function that can access the sprite.
-    void SerialiseSprites(std::function<rct_sprite*(const size_t)> getEntity, const size_t numSprites, bool saving)
+    static void SerialiseSprites(
+        OpenRCT2::MemoryStream& storedSprites, std::function<rct_sprite*(const size_t)> getEntity, const size_t numSprites,
+        bool saving)
     {
         const bool loading = !saving;
 
@@ -115,6 +257,21 @@ struct GameStateSnapshot_t
             }
         }
     }
+
+private:
+    template<typename T> void WriteValue(T value)
+    {
+        const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+        entityDeltas.insert(entityDeltas.end(), bytes, bytes + sizeof(T));
+    }
+
+    template<typename T> T ReadValue(size_t& pos) const
+    {
+        T value;
+        std::memcpy(&value, &entityDeltas[pos], sizeof(T));
+        pos += sizeof(T);
+        return value;
+    }
 };
 
 struct GameStateSnapshots final : public IGameStateSnapshots
@@ -122,10 +279,16 @@ struct GameStateSnapshots final : public IGameStateSnapshots
     virtual void Reset() override final
     {
         _snapshots.clear();
+        _lastCaptured = nullptr;
     }
 
     virtual GameStateSnapshot_t& CreateSnapshot() override final
     {
+        if (_snapshots.size() == _snapshots.capacity())
+        {
+            OnEvictSnapshot(*_snapshots.front());
+        }
+
         auto snapshot = std::make_unique<GameStateSnapshot_t>();
         _snapshots.push_back(std::move(snapshot));
 
@@ -140,10 +303,44 @@ struct GameStateSnapshots final : public IGameStateSnapshots
 
     virtual void Capture(GameStateSnapshot_t& snapshot) override final
     {
-        snapshot.SerialiseSprites(
-            [](const size_t index) { return reinterpret_cast<rct_sprite*>(GetEntity(index)); }, MAX_ENTITIES, true);
+        if (_lastCaptured == nullptr || _capturesSinceKeyframe + 1 >= SnapshotKeyframeInterval)
+        {
+            _lastImage = GameStateSnapshot_t::CreateEmptyImage();
+            snapshot.base = nullptr;
+            _capturesSinceKeyframe = 0;
+        }
+        else
+        {
+            snapshot.base = _lastCaptured;
+            _capturesSinceKeyframe++;
+        }
+
+        // Only the entities that changed since the last capture are visited twice, the image is kept up to date in place.
+        snapshot.entityDeltas.clear();
+        const auto& emptySprite = GameStateSnapshot_t::GetEmptySprite();
+        rct_sprite entitySprite;
+        for (size_t i = 0; i < MAX_ENTITIES; i++)
+        {
+            const auto* entity = GetEntity(i);
+            const bool isNull = entity == nullptr || entity->Type == EntityType::Null;
+            auto& prev = _lastImage[i];
+            if (isNull && prev.misc.Type == EntityType::Null)
+                continue;
 
-        // log_info("Snapshot size: %u bytes", static_cast<uint32_t>(snapshot.storedSprites.GetLength()));
+            if (!isNull)
+            {
+                CopyEntityToSprite(*entity, entitySprite);
+            }
+            const auto& cur = isNull ? emptySprite : entitySprite;
+            if (snapshot.AppendEntityDelta(static_cast<uint32_t>(i), prev, cur))
+            {
+                prev = cur;
+            }
+        }
+        snapshot.entityDeltas.shrink_to_fit();
+        _lastCaptured = &snapshot;
+
+        // log_info("Snapshot size: %u bytes", static_cast<uint32_t>(snapshot.entityDeltas.size()));
     }
 
     virtual const GameStateSnapshot_t* GetLinkedSnapshot(uint32_t tick) const override final
@@ -158,25 +355,33 @@ struct GameStateSnapshots final : public IGameStateSnapshots
 
     virtual void SerialiseSnapshot(GameStateSnapshot_t& snapshot, DataSerialiser& ds) const override final
     {
+        // The stream format is the full list of entities, as older versions and replays expect.
+        OpenRCT2::MemoryStream storedSprites;
+        SpriteImage image;
+        if (ds.IsSaving())
+        {
+            image = snapshot.Decode();
+            GameStateSnapshot_t::SerialiseSprites(
+                storedSprites, [&image](const size_t index) { return &image[index]; }, MAX_ENTITIES, true);
+        }
+
         ds << snapshot.tick;
         ds << snapshot.srand0;
-        ds << snapshot.storedSprites;
+        ds << storedSprites;
         ds << snapshot.parkParameters;
-    }
-
-    std::vector<rct_sprite> BuildSpriteList(GameStateSnapshot_t& snapshot) const
-    {
-        std::vector<rct_sprite> spriteList;
-        spriteList.resize(MAX_ENTITIES);
 
-        for (auto& sprite : spriteList)
+        if (ds.IsLoading())
         {
-            // By default they don't exist.
-            sprite.misc.Type = EntityType::Null;
+            image = BuildSpriteList(storedSprites);
+            snapshot.EncodeKeyframe(image);
         }
+    }
 
-        snapshot.SerialiseSprites([&spriteList](const size_t index) { return &spriteList[index]; }, MAX_ENTITIES, false);
-
+    SpriteImage BuildSpriteList(OpenRCT2::MemoryStream& storedSprites) const
+    {
+        auto spriteList = GameStateSnapshot_t::CreateEmptyImage();
+        GameStateSnapshot_t::SerialiseSprites(
+            storedSprites, [&spriteList](const size_t index) { return &spriteList[index]; }, MAX_ENTITIES, false);
         return spriteList;
     }
 
@@ -531,8 +736,8 @@ struct GameStateSnapshots final : public IGameStateSnapshots
         res.srand0Left = base.srand0;
         res.srand0Right = cmp.srand0;
 
-        std::vector<rct_sprite> spritesBase = BuildSpriteList(const_cast<GameStateSnapshot_t&>(base));
-        std::vector<rct_sprite> spritesCmp = BuildSpriteList(const_cast<GameStateSnapshot_t&>(cmp));
+        SpriteImage spritesBase = base.Decode();
+        SpriteImage spritesCmp = cmp.Decode();
 
         for (uint32_t i = 0; i < static_cast<uint32_t>(spritesBase.size()); i++)
         {
@@ -682,7 +887,31 @@ struct GameStateSnapshots final : public IGameStateSnapshots
     }
 
 private:
+    /*
+     * The oldest snapshot is about to be removed from the buffer, snapshots that have it as base become keyframes.
+     */
+    void OnEvictSnapshot(const GameStateSnapshot_t& evicted)
+    {
+        for (size_t i = 1; i < _snapshots.size(); i++)
+        {
+            auto& snapshot = *_snapshots[i];
+            if (snapshot.base == &evicted)
+            {
+                snapshot.EncodeKeyframe(snapshot.Decode());
+            }
+        }
+        if (_lastCaptured == &evicted)
+        {
+            _lastCaptured = nullptr;
+        }
+    }
+
     CircularBuffer<std::unique_ptr<GameStateSnapshot_t>, MaximumGameStateSnapshots> _snapshots;
+
+    // Entities as of the last capture, the base for the deltas of the next one.
+    const GameStateSnapshot_t* _lastCaptured = nullptr;
+    SpriteImage _lastImage;
+    uint32_t _capturesSinceKeyframe = 0;
 };
 
 std::unique_ptr<IGameStateSnapshots> CreateGameStateSnapshots()
@@ -20,6 +20,8 @@ utf8 gSilentRecordingName[MAX_PATH] = { 0 };
 
 bool gOpenRCT2Headless = false;
 bool gOpenRCT2NoGraphics = false;
+bool gOpenRCT2FastStart = false;
+bool gOpenRCT2NoPresentation = false;
 
 bool gOpenRCT2ShowChangelog;
 bool gOpenRCT2SilentBreakpad;
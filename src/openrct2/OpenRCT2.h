@@ -45,6 +45,11 @@ extern utf8 gCustomRCT2DataPath[MAX_PATH];
 extern utf8 gCustomPassword[MAX_PATH];
 extern bool gOpenRCT2Headless;
 extern bool gOpenRCT2NoGraphics;
+// Repositories and title sequences are loaded on first use instead of during Context::Initialise.
+extern bool gOpenRCT2FastStart;
+// Skips the work that only affects what is seen or heard, so replays can be verified and headless servers tick as
+// fast as possible.
+extern bool gOpenRCT2NoPresentation;
 extern bool gOpenRCT2ShowChangelog;
 extern bool gOpenRCT2SilentBreakpad;
 extern utf8 gSilentRecordingName[MAX_PATH];
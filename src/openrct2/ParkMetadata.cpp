@@ -0,0 +1,316 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "ParkMetadata.h"
+
+#include "Context.h"
+#include "GameState.h"
+#include "PlatformEnvironment.h"
+#include "core/Console.hpp"
+#include "core/DataSerialiser.h"
+#include "core/File.h"
+#include "core/FileScanner.h"
+#include "core/MemoryStream.h"
+#include "core/Path.hpp"
+#include "interface/Colour.h"
+#include "localisation/Date.h"
+#include "management/Finance.h"
+#include "peep/Peep.h"
+#include "platform/platform.h"
+#include "world/Map.h"
+#include "world/Park.h"
+#include "world/Surface.h"
+
+#include <cstdio>
+#include <iterator>
+#include <memory>
+#include <mutex>
+
+using namespace OpenRCT2;
+
+static constexpr uint32_t CACHE_MAGIC = 0x43444D50; // PMDC
+static constexpr uint32_t CACHE_VERSION = 1;
+
+// Same colours as the map window
+static constexpr uint8_t WaterColour = PALETTE_INDEX_195;
+static constexpr uint8_t UnownedColour = PALETTE_INDEX_10;
+static constexpr uint8_t TerrainColours[] = {
+    PALETTE_INDEX_73,  // TERRAIN_GRASS
+    PALETTE_INDEX_40,  // TERRAIN_SAND
+    PALETTE_INDEX_108, // TERRAIN_DIRT
+    PALETTE_INDEX_12,  // TERRAIN_ROCK
+    PALETTE_INDEX_62,  // TERRAIN_MARTIAN
+    PALETTE_INDEX_10,  // TERRAIN_CHECKERBOARD
+    PALETTE_INDEX_73,  // TERRAIN_GRASS_CLUMPS
+    PALETTE_INDEX_141, // TERRAIN_ICE
+    PALETTE_INDEX_172, // TERRAIN_GRID_RED
+    PALETTE_INDEX_54,  // TERRAIN_GRID_YELLOW
+    PALETTE_INDEX_162, // TERRAIN_GRID_BLUE
+    PALETTE_INDEX_102, // TERRAIN_GRID_GREEN
+    PALETTE_INDEX_111, // TERRAIN_SAND_DARK
+    PALETTE_INDEX_222, // TERRAIN_SAND_LIGHT
+};
+
+// Held while a cache file is read or rewritten, autosaves update the cache from their own thread
+static std::mutex _cacheMutex;
+
+struct FileRecord
+{
+    uint64_t Size = 0;
+    uint64_t LastModified = 0;
+};
+
+struct CacheEntry
+{
+    std::string FileName;
+    uint64_t Size = 0;
+    uint64_t LastModified = 0;
+    ParkMetadata Metadata;
+};
+
+static uint8_t GetPreviewColour(const CoordsXY& coords, bool alternate)
+{
+    const auto* surfaceElement = map_get_surface_element_at(coords);
+    if (surfaceElement == nullptr)
+        return PALETTE_INDEX_10;
+
+    uint8_t colour = WaterColour;
+    if (surfaceElement->GetWaterHeight() == 0)
+    {
+        auto surfaceStyle = surfaceElement->GetSurfaceStyle();
+        colour = surfaceStyle < std::size(TerrainColours) ? TerrainColours[surfaceStyle] : TerrainColours[0];
+    }
+
+    // Land the park does not own is drawn with a checkerboard, like the map window
+    if (alternate && !(surfaceElement->GetOwnership() & OWNERSHIP_OWNED))
+        colour = UnownedColour;
+
+    // Elements are roughly in height order, so the last one is what is seen from above
+    const auto* tileElement = reinterpret_cast<const TileElement*>(surfaceElement);
+    while (!(tileElement++)->IsLastForTile())
+    {
+        if (tileElement->IsGhost())
+            continue;
+
+        switch (tileElement->GetType())
+        {
+            case TILE_ELEMENT_TYPE_PATH:
+                colour = PALETTE_INDEX_17;
+                break;
+            case TILE_ELEMENT_TYPE_TRACK:
+                colour = PALETTE_INDEX_183;
+                break;
+            case TILE_ELEMENT_TYPE_ENTRANCE:
+                colour = PALETTE_INDEX_186;
+                break;
+            case TILE_ELEMENT_TYPE_SMALL_SCENERY:
+            case TILE_ELEMENT_TYPE_LARGE_SCENERY:
+                colour = PALETTE_INDEX_99;
+                break;
+        }
+    }
+    return colour;
+}
+
+ParkMetadata ParkMetadata::FromGameState()
+{
+    ParkMetadata metadata;
+    metadata.Name = GetContext()->GetGameState()->GetPark().Name;
+    metadata.MonthsElapsed = static_cast<uint16_t>(gDateMonthsElapsed);
+    metadata.NumGuests = gNumGuestsInPark;
+    metadata.Cash = gCash;
+
+    metadata.Preview.resize(PREVIEW_SIZE * PREVIEW_SIZE);
+    for (int32_t y = 0; y < PREVIEW_SIZE; y++)
+    {
+        for (int32_t x = 0; x < PREVIEW_SIZE; x++)
+        {
+            auto tileCoords = TileCoordsXY{ x * gMapSize / PREVIEW_SIZE, y * gMapSize / PREVIEW_SIZE };
+            metadata.Preview[y * PREVIEW_SIZE + x] = GetPreviewColour(tileCoords.ToCoordsXY(), ((x + y) & 1) != 0);
+        }
+    }
+    return metadata;
+}
+
+static void SerialiseEntry(DataSerialiser& ds, CacheEntry& entry)
+{
+    auto& metadata = entry.Metadata;
+    ds << entry.FileName;
+    ds << entry.Size;
+    ds << entry.LastModified;
+    ds << metadata.Name;
+    ds << metadata.MonthsElapsed;
+    ds << metadata.NumGuests;
+    ds << metadata.Cash;
+    ds << metadata.Preview;
+}
+
+static std::string GetDirectoryKey(const std::string& directory)
+{
+    auto key = Path::GetAbsolute(directory);
+    while (key.size() > 1 && (key.back() == *PATH_SEPARATOR || key.back() == '/'))
+    {
+        key.pop_back();
+    }
+    return key;
+}
+
+static std::unordered_map<std::string, FileRecord> ScanParkFiles(const std::string& directory)
+{
+    std::unordered_map<std::string, FileRecord> files;
+    auto scanner = std::unique_ptr<IFileScanner>(Path::ScanDirectory(Path::Combine(directory, "*"), false));
+    while (scanner->Next())
+    {
+        const auto* fileInfo = scanner->GetFileInfo();
+        files.emplace(fileInfo->Name, FileRecord{ fileInfo->Size, fileInfo->LastModified });
+    }
+    return files;
+}
+
+static std::vector<CacheEntry> ReadCacheFile(const std::string& path)
+{
+    std::vector<CacheEntry> entries;
+    if (!File::Exists(path))
+        return entries;
+
+    try
+    {
+        auto data = File::ReadAllBytes(path);
+        MemoryStream ms(data.data(), data.size());
+        auto magic = ms.ReadValue<uint32_t>();
+        auto version = ms.ReadValue<uint32_t>();
+        auto numEntries = ms.ReadValue<uint32_t>();
+        if (magic != CACHE_MAGIC || version != CACHE_VERSION)
+            return entries;
+
+        DataSerialiser ds(false, ms);
+        for (uint32_t i = 0; i < numEntries; i++)
+        {
+            CacheEntry entry;
+            SerialiseEntry(ds, entry);
+            entries.push_back(std::move(entry));
+        }
+    }
+    catch (const std::exception& e)
+    {
+        log_warning("Unable to read park metadata cache '%s': %s", path.c_str(), e.what());
+        entries.clear();
+    }
+    return entries;
+}
+
+static void WriteCacheFile(const std::string& path, std::vector<CacheEntry>& entries)
+{
+    try
+    {
+        MemoryStream ms;
+        ms.WriteValue<uint32_t>(CACHE_MAGIC);
+        ms.WriteValue<uint32_t>(CACHE_VERSION);
+        ms.WriteValue<uint32_t>(static_cast<uint32_t>(entries.size()));
+        DataSerialiser ds(true, ms);
+        for (auto& entry : entries)
+        {
+            SerialiseEntry(ds, entry);
+        }
+
+        Path::CreateDirectory(Path::GetDirectory(path));
+        File::WriteAllBytes(path, ms.GetData(), ms.GetLength());
+    }
+    catch (const std::exception& e)
+    {
+        log_warning("Unable to write park metadata cache '%s': %s", path.c_str(), e.what());
+    }
+}
+
+static bool IsUpToDate(const CacheEntry& entry, const std::unordered_map<std::string, FileRecord>& files)
+{
+    auto it = files.find(entry.FileName);
+    return it != files.end() && it->second.Size == entry.Size && it->second.LastModified == entry.LastModified;
+}
+
+ParkMetadataCache::ParkMetadataCache(std::string cacheDirectory)
+    : _cacheDirectory(std::move(cacheDirectory))
+{
+}
+
+std::string ParkMetadataCache::GetCachePath(const std::string& directory) const
+{
+    // FNV-1a of the directory, the path itself can not be used as a file name
+    uint64_t hash = 14695981039346656037ULL;
+    for (auto c : GetDirectoryKey(directory))
+    {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ULL;
+    }
+
+    char fileName[32];
+    std::snprintf(fileName, sizeof(fileName), "%016llx.dat", static_cast<unsigned long long>(hash));
+    return Path::Combine(_cacheDirectory, fileName);
+}
+
+void ParkMetadataCache::Update(const std::string& path, const ParkMetadata& metadata) const
+{
+    auto directory = Path::GetDirectory(Path::GetAbsolute(path));
+    auto fileName = Path::GetFileName(path);
+    auto cachePath = GetCachePath(directory);
+
+    std::lock_guard<std::mutex> lock(_cacheMutex);
+    auto files = ScanParkFiles(directory);
+    auto file = files.find(fileName);
+    if (file == files.end())
+        return;
+
+    // Drop the previous entry for the file and any for parks that were deleted or changed
+    std::vector<CacheEntry> entries;
+    for (auto& entry : ReadCacheFile(cachePath))
+    {
+        if (entry.FileName != fileName && IsUpToDate(entry, files))
+        {
+            entries.push_back(std::move(entry));
+        }
+    }
+
+    CacheEntry entry;
+    entry.FileName = fileName;
+    entry.Size = file->second.Size;
+    entry.LastModified = file->second.LastModified;
+    entry.Metadata = metadata;
+    entries.push_back(std::move(entry));
+
+    WriteCacheFile(cachePath, entries);
+}
+
+std::unordered_map<std::string, ParkMetadata> ParkMetadataCache::ReadDirectory(const std::string& directory) const
+{
+    std::vector<CacheEntry> entries;
+    {
+        std::lock_guard<std::mutex> lock(_cacheMutex);
+        entries = ReadCacheFile(GetCachePath(directory));
+    }
+
+    std::unordered_map<std::string, ParkMetadata> result;
+    if (!entries.empty())
+    {
+        auto files = ScanParkFiles(directory);
+        for (auto& entry : entries)
+        {
+            if (IsUpToDate(entry, files))
+            {
+                result.emplace(std::move(entry.FileName), std::move(entry.Metadata));
+            }
+        }
+    }
+    return result;
+}
+
+ParkMetadataCache park_metadata_cache_get()
+{
+    auto env = GetContext()->GetPlatformEnvironment();
+    return ParkMetadataCache(Path::Combine(env->GetDirectoryPath(DIRBASE::CACHE), "parkmetadata"));
+}
@@ -0,0 +1,68 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "common.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Summary of a saved park shown by the load / save window, so it does not have to open the file.
+ */
+struct ParkMetadata
+{
+    static constexpr uint16_t PREVIEW_SIZE = 64;
+
+    std::string Name;
+    uint16_t MonthsElapsed = 0;
+    uint32_t NumGuests = 0;
+    money32 Cash = 0;
+    // Top down map of the park, PREVIEW_SIZE * PREVIEW_SIZE palette indices
+    std::vector<uint8_t> Preview;
+
+    /**
+     * Creates the metadata of the park currently loaded, must be called on the game thread.
+     */
+    static ParkMetadata FromGameState();
+};
+
+/**
+ * Stores the metadata of saved parks, one cache file for each directory parks are saved to. Entries are
+ * dropped once the file they describe is modified by anything other than the game.
+ */
+class ParkMetadataCache final
+{
+private:
+    std::string _cacheDirectory;
+
+public:
+    explicit ParkMetadataCache(std::string cacheDirectory);
+
+    /**
+     * Records the metadata of a park that has just been written to path, can be called from any thread.
+     */
+    void Update(const std::string& path, const ParkMetadata& metadata) const;
+
+    /**
+     * Reads the metadata of all the parks in a directory that are still up to date, by file name.
+     * Intended to be called from a background thread.
+     */
+    std::unordered_map<std::string, ParkMetadata> ReadDirectory(const std::string& directory) const;
+
+private:
+    std::string GetCachePath(const std::string& directory) const;
+};
+
+/**
+ * The cache in the user's cache directory.
+ */
+ParkMetadataCache park_metadata_cache_get();
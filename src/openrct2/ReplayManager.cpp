@@ -11,6 +11,7 @@
 
 #include "Context.h"
 #include "Game.h"
+#include "GameState.h"
 #include "GameStateSnapshots.h"
 #include "OpenRCT2.h"
 #include "ParkImporter.h"
@@ -76,6 +77,15 @@ namespace OpenRCT2
         OpenRCT2::MemoryStream data;
     };
 
+    // Full state of the park at a tick of the replay, so playback can start from there.
+    struct ReplayKeyframe
+    {
+        uint32_t tick = 0;
+        OpenRCT2::MemoryStream parkData;
+        OpenRCT2::MemoryStream parkParams;
+        OpenRCT2::MemoryStream cheatData;
+    };
+
     struct ReplayRecordData
     {
         uint32_t magic;
@@ -93,11 +103,15 @@ namespace OpenRCT2
         std::vector<std::pair<uint32_t, rct_sprite_checksum>> checksums;
         uint32_t checksumIndex;
         OpenRCT2::MemoryStream gameStateSnapshots;
+        std::vector<ReplayKeyframe> keyframes;
     };
 
     class ReplayManager final : public IReplayManager
     {
-        static constexpr uint16_t ReplayVersion = 4;
+        static constexpr uint16_t ReplayVersion = 6;
+        static constexpr uint16_t ReplayKeyframesVersion = 5;
+        static constexpr uint16_t ReplayFastChecksumVersion = 6;
+        static constexpr uint16_t ReplayMinimumVersion = 4;
         static constexpr uint32_t ReplayMagic = 0x5243524F; // ORCR.
         static constexpr int ReplayCompressionLevel = 9;
         static constexpr int NormalRecordingChecksumTicks = 1;
@@ -159,12 +173,22 @@ namespace OpenRCT2
 
             if ((_mode == ReplayMode::RECORDING || _mode == ReplayMode::NORMALISATION) && gCurrentTicks == _nextChecksumTick)
             {
-                rct_sprite_checksum checksum = sprite_checksum();
+                rct_sprite_checksum checksum = sprite_checksum(GetChecksumAlgorithm(*_currentRecording));
                 AddChecksum(gCurrentTicks, std::move(checksum));
 
                 _nextChecksumTick = gCurrentTicks + ChecksumTicksDelta();
             }
 
+            if ((_mode == ReplayMode::RECORDING || _mode == ReplayMode::NORMALISATION) && _keyframeTicks != 0
+                && gCurrentTicks == _nextKeyframeTick && gCurrentTicks < _currentRecording->tickEnd)
+            {
+                auto& keyframe = _currentRecording->keyframes.emplace_back();
+                keyframe.tick = gCurrentTicks;
+                SaveParkState(keyframe.parkData, keyframe.parkParams, keyframe.cheatData);
+
+                _nextKeyframeTick = gCurrentTicks + _keyframeTicks;
+            }
+
             if (_mode == ReplayMode::RECORDING)
             {
                 if (gCurrentTicks >= _currentRecording->tickEnd)
@@ -183,7 +207,7 @@ namespace OpenRCT2
                 ReplayCommands();
 
                 // Normal playback will always end at the specific tick.
-                if (gCurrentTicks >= _currentReplay->tickEnd)
+                if (gCurrentTicks >= _playbackEndTick)
                 {
                     StopPlayback();
                     return;
@@ -217,8 +241,27 @@ namespace OpenRCT2
             snapshots->SerialiseSnapshot(snapshot, snapShotDs);
         }
 
+        void SaveParkState(MemoryStream& parkData, MemoryStream& parkParams, MemoryStream& cheatData)
+        {
+            auto context = GetContext();
+            auto& objManager = context->GetObjectManager();
+            auto objects = objManager.GetPackableObjects();
+
+            auto s6exporter = std::make_unique<S6Exporter>();
+            s6exporter->ExportObjectsList = objects;
+            s6exporter->Export();
+            s6exporter->SaveGame(&parkData);
+
+            DataSerialiser parkParamsDs(true, parkParams);
+            SerialiseParkParameters(parkParamsDs);
+
+            DataSerialiser cheatDataDs(true, cheatData);
+            SerialiseCheats(cheatDataDs);
+        }
+
         virtual bool StartRecording(
-            const std::string& name, uint32_t maxTicks /*= k_MaxReplayTicks*/, RecordType rt /*= RecordType::NORMAL*/) override
+            const std::string& name, uint32_t maxTicks /*= k_MaxReplayTicks*/, RecordType rt /*= RecordType::NORMAL*/,
+            uint32_t keyframeTicks /*= k_ReplayKeyframeTicks*/) override
         {
             // If using silent recording, discard whatever recording there is going on, even if a new silent recording is to be
             // started.
@@ -241,23 +284,10 @@ namespace OpenRCT2
 
             replayData->filePath = name;
 
-            auto context = GetContext();
-            auto& objManager = context->GetObjectManager();
-            auto objects = objManager.GetPackableObjects();
-
-            auto s6exporter = std::make_unique<S6Exporter>();
-            s6exporter->ExportObjectsList = objects;
-            s6exporter->Export();
-            s6exporter->SaveGame(&replayData->parkData);
+            SaveParkState(replayData->parkData, replayData->parkParams, replayData->cheatData);
 
             replayData->timeRecorded = std::chrono::seconds(std::time(nullptr)).count();
 
-            DataSerialiser parkParamsDs(true, replayData->parkParams);
-            SerialiseParkParameters(parkParamsDs);
-
-            DataSerialiser cheatDataDs(true, replayData->cheatData);
-            SerialiseCheats(cheatDataDs);
-
             TakeGameStateSnapshot(replayData->gameStateSnapshots);
 
             if (_mode != ReplayMode::NORMALISATION)
@@ -266,6 +296,8 @@ namespace OpenRCT2
             _currentRecording = std::move(replayData);
             _recordType = rt;
             _nextChecksumTick = gCurrentTicks + 1;
+            _keyframeTicks = keyframeTicks;
+            _nextKeyframeTick = gCurrentTicks + keyframeTicks;
 
             return true;
         }
@@ -285,7 +317,7 @@ namespace OpenRCT2
             _currentRecording->tickEnd = gCurrentTicks;
 
             {
-                rct_sprite_checksum checksum = sprite_checksum();
+                rct_sprite_checksum checksum = sprite_checksum(GetChecksumAlgorithm(*_currentRecording));
                 AddChecksum(gCurrentTicks, std::move(checksum));
             }
 
@@ -370,10 +402,20 @@ namespace OpenRCT2
                 info.Ticks = data->tickEnd - data->tickStart;
             info.NumCommands = static_cast<uint32_t>(data->commands.size());
             info.NumChecksums = static_cast<uint32_t>(data->checksums.size());
+            info.NumKeyframes = static_cast<uint32_t>(data->keyframes.size());
 
             return true;
         }
 
+        void SkipSnapshot(MemoryStream& snapshotStream)
+        {
+            DataSerialiser ds(false, snapshotStream);
+
+            IGameStateSnapshots* snapshots = GetContext()->GetGameStateSnapshots();
+            GameStateSnapshot_t& replaySnapshot = snapshots->CreateSnapshot();
+            snapshots->SerialiseSnapshot(replaySnapshot, ds);
+        }
+
         void LoadAndCompareSnapshot(MemoryStream& snapshotStream)
         {
             DataSerialiser ds(false, snapshotStream);
@@ -414,6 +456,16 @@ namespace OpenRCT2
         }
 
         virtual bool StartPlayback(const std::string& file) override
+        {
+            return StartPlayback(file, 0, false);
+        }
+
+        virtual bool StartPlaybackSegment(const std::string& file, uint32_t segment) override
+        {
+            return StartPlayback(file, segment, true);
+        }
+
+        bool StartPlayback(const std::string& file, uint32_t segment, bool singleSegment)
         {
             if (_mode != ReplayMode::NONE && _mode != ReplayMode::NORMALISATION)
                 return false;
@@ -426,18 +478,22 @@ namespace OpenRCT2
                 return false;
             }
 
-            if (!LoadReplayDataMap(*replayData))
+            if (segment > replayData->keyframes.size())
             {
-                log_error("Unable to load map.");
+                log_error("Replay only has %u segments.", static_cast<uint32_t>(replayData->keyframes.size() + 1));
                 return false;
             }
 
-            gCurrentTicks = replayData->tickStart;
-
-            LoadAndCompareSnapshot(replayData->gameStateSnapshots);
+            if (!LoadKeyframe(*replayData, segment))
+            {
+                log_error("Unable to load map.");
+                return false;
+            }
 
             _currentReplay = std::move(replayData);
-            _currentReplay->checksumIndex = 0;
+            _playbackEndTick = _currentReplay->tickEnd;
+            if (singleSegment && segment < _currentReplay->keyframes.size())
+                _playbackEndTick = _currentReplay->keyframes[segment].tick;
             _faultyChecksumIndex = -1;
 
             // Make sure game is not paused.
@@ -449,6 +505,41 @@ namespace OpenRCT2
             return true;
         }
 
+        virtual bool SeekToTick(uint32_t tick) override
+        {
+            if (_mode != ReplayMode::PLAYING || tick < _currentReplay->tickStart || tick > _playbackEndTick)
+                return false;
+
+            // Start again from the closest keyframe unless playing on from the current tick is quicker
+            const auto& keyframes = _currentReplay->keyframes;
+            uint32_t keyframeIndex = 0;
+            while (keyframeIndex < keyframes.size() && keyframes[keyframeIndex].tick <= tick)
+            {
+                keyframeIndex++;
+            }
+            uint32_t startTick = keyframeIndex == 0 ? _currentReplay->tickStart : keyframes[keyframeIndex - 1].tick;
+            if (tick < gCurrentTicks || startTick > gCurrentTicks)
+            {
+                // Commands are removed as they are replayed, so the replay has to be read again
+                auto replayData = std::make_unique<ReplayRecordData>();
+                if (!ReadReplayData(_currentReplay->filePath, *replayData) || !LoadKeyframe(*replayData, keyframeIndex))
+                {
+                    log_error("Unable to seek to tick %u.", tick);
+                    StopPlayback();
+                    return false;
+                }
+                _currentReplay = std::move(replayData);
+                _faultyChecksumIndex = -1;
+            }
+
+            auto* gameState = GetContext()->GetGameState();
+            while (gCurrentTicks < tick && IsReplaying())
+            {
+                gameState->UpdateLogic();
+            }
+            return gCurrentTicks == tick;
+        }
+
         virtual bool IsPlaybackStateMismatching() const override
         {
             return _faultyChecksumIndex != -1;
@@ -459,7 +550,9 @@ namespace OpenRCT2
             if (_mode != ReplayMode::PLAYING && _mode != ReplayMode::NORMALISATION)
                 return false;
 
-            LoadAndCompareSnapshot(_currentReplay->gameStateSnapshots);
+            // The final snapshot only matches when playing to the end
+            if (_playbackEndTick == _currentReplay->tickEnd)
+                LoadAndCompareSnapshot(_currentReplay->gameStateSnapshots);
 
             // During normal playback we pause the game if stopped.
             if (_mode == ReplayMode::PLAYING)
@@ -488,7 +581,7 @@ namespace OpenRCT2
                 return false;
             }
 
-            if (!StartRecording(outFile, k_MaxReplayTicks, RecordType::NORMAL))
+            if (!StartRecording(outFile, k_MaxReplayTicks, RecordType::NORMAL, k_ReplayKeyframeTicks))
             {
                 StopPlayback();
                 return false;
@@ -512,17 +605,56 @@ namespace OpenRCT2
             }
         }
 
-        bool LoadReplayDataMap(ReplayRecordData& data)
+        /**
+         * Loads the state the given segment starts from, keyframe 0 being the start of the recording, and drops the
+         * commands and checksums from before it.
+         */
+        bool LoadKeyframe(ReplayRecordData& data, uint32_t keyframeIndex)
+        {
+            if (keyframeIndex == 0)
+            {
+                if (!LoadReplayDataMap(data.parkData, data.parkParams, data.cheatData))
+                    return false;
+
+                gCurrentTicks = data.tickStart;
+                LoadAndCompareSnapshot(data.gameStateSnapshots);
+            }
+            else
+            {
+                auto& keyframe = data.keyframes[keyframeIndex - 1];
+                if (!LoadReplayDataMap(keyframe.parkData, keyframe.parkParams, keyframe.cheatData))
+                    return false;
+
+                gCurrentTicks = keyframe.tick;
+                SkipSnapshot(data.gameStateSnapshots);
+
+                while (!data.commands.empty() && data.commands.begin()->tick < keyframe.tick)
+                {
+                    data.commands.erase(data.commands.begin());
+                }
+            }
+
+            data.checksumIndex = 0;
+            while (data.checksumIndex < data.checksums.size() && data.checksums[data.checksumIndex].first < gCurrentTicks)
+            {
+                data.checksumIndex++;
+            }
+            return true;
+        }
+
+        bool LoadReplayDataMap(MemoryStream& parkData, MemoryStream& parkParams, MemoryStream& cheatData)
         {
             try
             {
-                data.parkData.SetPosition(0);
+                parkData.SetPosition(0);
+                parkParams.SetPosition(0);
+                cheatData.SetPosition(0);
 
                 auto context = GetContext();
                 auto& objManager = context->GetObjectManager();
                 auto importer = ParkImporter::CreateS6(context->GetObjectRepository());
 
-                auto loadResult = importer->LoadFromStream(&data.parkData, false);
+                auto loadResult = importer->LoadFromStream(&parkData, false);
                 objManager.LoadObjects(loadResult.RequiredObjects.data(), loadResult.RequiredObjects.size());
 
                 importer->Import();
@@ -530,13 +662,13 @@ namespace OpenRCT2
                 EntityTweener::Get().Reset();
 
                 // Load all map global variables.
-                DataSerialiser parkParamsDs(false, data.parkParams);
+                DataSerialiser parkParamsDs(false, parkParams);
                 SerialiseParkParameters(parkParamsDs);
 
                 // New cheats might not be serialised, make sure they are using their defaults.
                 CheatsReset();
 
-                DataSerialiser cheatDataDs(false, data.cheatData);
+                DataSerialiser cheatDataDs(false, cheatData);
                 SerialiseCheats(cheatDataDs);
 
                 game_load_init();
@@ -645,6 +777,12 @@ namespace OpenRCT2
             data.parkParams.SetPosition(0);
             data.cheatData.SetPosition(0);
             data.gameStateSnapshots.SetPosition(0);
+            for (auto& keyframe : data.keyframes)
+            {
+                keyframe.parkData.SetPosition(0);
+                keyframe.parkParams.SetPosition(0);
+                keyframe.cheatData.SetPosition(0);
+            }
 
             return true;
         }
@@ -707,9 +845,15 @@ namespace OpenRCT2
             return true;
         }
 
+        static EntityChecksumAlgorithm GetChecksumAlgorithm(const ReplayRecordData& data)
+        {
+            return data.version >= ReplayFastChecksumVersion ? EntityChecksumAlgorithm::Fast : EntityChecksumAlgorithm::Sha1;
+        }
+
         bool Compatible(ReplayRecordData& data)
         {
-            return data.version == ReplayVersion;
+            // Older versions only lack the keyframes and hash the entities with SHA1
+            return data.version >= ReplayMinimumVersion && data.version <= ReplayVersion;
         }
 
         bool Serialise(DataSerialiser& serialiser, ReplayRecordData& data)
@@ -782,6 +926,25 @@ namespace OpenRCT2
             }
 
             serialiser << data.gameStateSnapshots;
+
+            if (data.version >= ReplayKeyframesVersion)
+            {
+                uint32_t countKeyframes = static_cast<uint32_t>(data.keyframes.size());
+                serialiser << countKeyframes;
+
+                if (serialiser.IsLoading())
+                {
+                    data.keyframes.resize(countKeyframes);
+                }
+
+                for (auto& keyframe : data.keyframes)
+                {
+                    serialiser << keyframe.tick;
+                    serialiser << keyframe.parkData;
+                    serialiser << keyframe.parkParams;
+                    serialiser << keyframe.cheatData;
+                }
+            }
             return true;
         }
 
@@ -798,7 +961,7 @@ namespace OpenRCT2
             {
                 _currentReplay->checksumIndex++;
 
-                rct_sprite_checksum checksum = sprite_checksum();
+                rct_sprite_checksum checksum = sprite_checksum(GetChecksumAlgorithm(*_currentReplay));
                 if (savedChecksum.second.raw != checksum.raw)
                 {
                     uint32_t replayTick = gCurrentTicks - _currentReplay->tickStart;
@@ -856,7 +1019,7 @@ namespace OpenRCT2
                 }
 
                 // Focus camera on event.
-                if (isPositionValid && !result->Position.isNull())
+                if (isPositionValid && !result->Position.isNull() && !gOpenRCT2NoPresentation)
                 {
                     auto* mainWindow = window_get_main();
                     if (mainWindow != nullptr)
@@ -875,6 +1038,9 @@ namespace OpenRCT2
         uint32_t _commandId = 0;
         uint32_t _nextChecksumTick = 0;
         uint32_t _nextReplayTick = 0;
+        uint32_t _keyframeTicks = 0;
+        uint32_t _nextKeyframeTick = 0;
+        uint32_t _playbackEndTick = 0;
         RecordType _recordType = RecordType::NORMAL;
     };
 
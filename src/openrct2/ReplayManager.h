@@ -20,6 +20,8 @@ struct GameAction;
 namespace OpenRCT2
 {
     static constexpr uint32_t k_MaxReplayTicks = 0xFFFFFFFF;
+    // A keyframe of the whole park is recorded every 5 minutes of game time.
+    static constexpr uint32_t k_ReplayKeyframeTicks = 40 * 60 * 5;
 
     struct ReplayRecordInfo
     {
@@ -28,6 +30,7 @@ namespace OpenRCT2
         uint64_t TimeRecorded;
         uint32_t NumCommands;
         uint32_t NumChecksums;
+        uint32_t NumKeyframes;
         std::string Name;
         std::string FilePath;
     };
@@ -52,13 +55,28 @@ namespace OpenRCT2
 
         virtual void AddGameAction(uint32_t tick, const GameAction* action) = 0;
 
+        /**
+         * Starts recording, keyframeTicks sets how often the park is stored for seeking, 0 to not store any.
+         */
         virtual bool StartRecording(
-            const std::string& name, uint32_t maxTicks = k_MaxReplayTicks, RecordType rt = RecordType::NORMAL)
+            const std::string& name, uint32_t maxTicks = k_MaxReplayTicks, RecordType rt = RecordType::NORMAL,
+            uint32_t keyframeTicks = k_ReplayKeyframeTicks)
             = 0;
         virtual bool StopRecording(bool discard = false) = 0;
         virtual bool GetCurrentReplayInfo(ReplayRecordInfo& info) const = 0;
 
         virtual bool StartPlayback(const std::string& file) = 0;
+
+        /**
+         * Plays back only the part of the replay from keyframe segment up to the next one, segment 0 starts at the
+         * beginning of the recording. The segments of a replay can be verified independently of each other.
+         */
+        virtual bool StartPlaybackSegment(const std::string& file, uint32_t segment) = 0;
+
+        /**
+         * Continues playback from the given tick, starting again from the closest keyframe before it if needed.
+         */
+        virtual bool SeekToTick(uint32_t tick) = 0;
         virtual bool IsPlaybackStateMismatching() const = 0;
         virtual bool StopPlayback() = 0;
 
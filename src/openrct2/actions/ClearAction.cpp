@@ -98,7 +98,7 @@ GameActions::Result::Ptr ClearAction::QueryExecute(bool executing) const
 
     if (_itemsToClear & CLEARABLE_ITEMS::SCENERY_LARGE)
     {
-        ResetClearLargeSceneryFlag();
+        ResetClearLargeSceneryFlag({ x0, y0, x1, y1 });
     }
 
     if (noValidTiles)
@@ -207,14 +207,13 @@ money32 ClearAction::ClearSceneryFromTile(const CoordsXY& tilePos, bool executin
     return totalCost;
 }
 
-void ClearAction::ResetClearLargeSceneryFlag()
+void ClearAction::ResetClearLargeSceneryFlag(const MapRange& range)
 {
-    // TODO: Improve efficiency of this
-    for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+    for (int32_t y = range.GetTop(); y <= range.GetBottom(); y += COORDS_XY_STEP)
     {
-        for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+        for (int32_t x = range.GetLeft(); x <= range.GetRight(); x += COORDS_XY_STEP)
         {
-            auto tileElement = map_get_first_element_at(TileCoordsXY{ x, y }.ToCoordsXY());
+            auto tileElement = map_get_first_element_at({ x, y });
             do
             {
                 if (tileElement == nullptr)
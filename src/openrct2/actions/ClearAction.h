@@ -45,9 +45,10 @@ private:
 
     /**
      * Function to clear the flag that is set to prevent cost duplication
-     * when using the clear scenery tool with large scenery.
+     * when using the clear scenery tool with large scenery. The flag is only
+     * set on elements of the cleared tiles, so only those are visited.
      */
-    static void ResetClearLargeSceneryFlag();
+    static void ResetClearLargeSceneryFlag(const MapRange& range);
 
     static bool MapCanClearAt(const CoordsXY& location);
 };
@@ -16,12 +16,14 @@
 #include "../localisation/StringIds.h"
 #include "../management/Finance.h"
 #include "../world/Footpath.h"
+#include "../world/FootpathGraph.h"
 #include "../world/Location.hpp"
 #include "../world/Park.h"
 #include "../world/Scenery.h"
 #include "../world/Surface.h"
 #include "../world/TileElementsView.h"
 #include "../world/Wall.h"
+#include "FootpathRemoveAction.h"
 
 using namespace OpenRCT2;
 
@@ -46,6 +48,21 @@ uint16_t FootpathPlaceAction::GetActionFlags() const
     return GameAction::GetActionFlags();
 }
 
+bool FootpathPlaceAction::CanCacheQuery() const
+{
+    return true;
+}
+
+bool FootpathPlaceAction::CanBePredicted() const
+{
+    return true;
+}
+
+std::unique_ptr<GameAction> FootpathPlaceAction::CreatePredictionRollback(const GameActions::Result& result) const
+{
+    return std::make_unique<FootpathRemoveAction>(_loc);
+}
+
 void FootpathPlaceAction::Serialise(DataSerialiser& stream)
 {
     GameAction::Serialise(stream);
@@ -339,6 +356,7 @@ GameActions::Result::Ptr FootpathPlaceAction::ElementInsertExecute(GameActions::
             // Set the path type but make sure it's not a queue as that will not show up
             entranceElement->SetPathType(_type & 0x7F);
             map_invalidate_tile_full(_loc);
+            FootpathGraphInvalidateTile(_loc);
         }
     }
     else
@@ -434,6 +452,7 @@ void FootpathPlaceAction::RemoveIntersectingWalls(PathElement* pathElement) cons
 
     footpath_update_queue_chains();
     map_invalidate_tile_full(_loc);
+    FootpathGraphInvalidateTile(_loc);
 }
 
 PathElement* FootpathPlaceAction::map_get_footpath_element_slope(const CoordsXYZ& footpathPos, int32_t slope) const
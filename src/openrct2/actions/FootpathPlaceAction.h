@@ -31,6 +31,9 @@ public:
     void Serialise(DataSerialiser & stream) override;
     GameActions::Result::Ptr Query() const override;
     GameActions::Result::Ptr Execute() const override;
+    bool CanCacheQuery() const override;
+    bool CanBePredicted() const override;
+    std::unique_ptr<GameAction> CreatePredictionRollback(const GameActions::Result& result) const override;
 
 private:
     GameActions::Result::Ptr ElementUpdateQuery(PathElement * pathElement, GameActions::Result::Ptr res) const;
@@ -16,6 +16,7 @@
 #include "../localisation/StringIds.h"
 #include "../management/Finance.h"
 #include "../world/Footpath.h"
+#include "../world/FootpathGraph.h"
 #include "../world/Location.hpp"
 #include "../world/Park.h"
 #include "../world/Surface.h"
@@ -226,6 +227,7 @@ GameActions::Result::Ptr FootpathPlaceFromTrackAction::ElementInsertExecute(Game
             // Set the path type but make sure it's not a queue as that will not show up
             entranceElement->SetPathType(_type & 0x7F);
             map_invalidate_tile_full(_loc);
+            FootpathGraphInvalidateTile(_loc);
         }
     }
     else
@@ -247,6 +249,8 @@ GameActions::Result::Ptr FootpathPlaceFromTrackAction::ElementInsertExecute(Game
         pathElement->SetGhost(GetFlags() & GAME_COMMAND_FLAG_GHOST);
 
         map_invalidate_tile_full(_loc);
+
+        FootpathGraphInvalidateTile(_loc);
     }
 
     // Prevent the place sound from being spammed
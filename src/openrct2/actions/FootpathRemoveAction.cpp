@@ -16,6 +16,7 @@
 #include "../localisation/StringIds.h"
 #include "../management/Finance.h"
 #include "../world/Footpath.h"
+#include "../world/FootpathGraph.h"
 #include "../world/Location.hpp"
 #include "../world/Park.h"
 #include "../world/Wall.h"
@@ -95,6 +96,7 @@ GameActions::Result::Ptr FootpathRemoveAction::Execute() const
         }
         footpath_remove_edges_at(_loc, footpathElement);
         map_invalidate_tile_full(_loc);
+        FootpathGraphInvalidateTile(_loc);
         tile_element_remove(footpathElement);
         footpath_update_queue_chains();
 
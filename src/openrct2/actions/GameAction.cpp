@@ -11,11 +11,14 @@
 
 #include "../Context.h"
 #include "../ReplayManager.h"
+#include "../config/Config.h"
 #include "../core/Guard.hpp"
 #include "../core/Memory.hpp"
 #include "../core/MemoryStream.h"
+#include "../core/Profiling.h"
 #include "../localisation/Localisation.h"
 #include "../network/network.h"
+#include "../peep/GuestPathfinding.h"
 #include "../platform/platform.h"
 #include "../scenario/Scenario.h"
 #include "../scripting/Duktape.hpp"
@@ -26,9 +29,15 @@
 #include "../world/Park.h"
 #include "../world/Scenery.h"
 #include "../world/Sprite.h"
+#include "../world/TileChanges.h"
 
 #include <algorithm>
+#include <array>
+#include <deque>
 #include <iterator>
+#include <string>
+#include <typeinfo>
+#include <vector>
 
 using namespace OpenRCT2;
 
@@ -83,6 +92,24 @@ namespace GameActions
         return message;
     }
 
+    Result::Ptr Result::Clone() const
+    {
+        auto result = std::make_unique<Result>();
+        CopyTo(*result);
+        return result;
+    }
+
+    void Result::CopyTo(Result& result) const
+    {
+        result.Error = Error;
+        result.ErrorTitle = ErrorTitle;
+        result.ErrorMessage = ErrorMessage;
+        result.ErrorMessageArgs = ErrorMessageArgs;
+        result.Position = Position;
+        result.Cost = Cost;
+        result.Expenditure = Expenditure;
+    }
+
     struct QueuedGameAction
     {
         uint32_t tick;
@@ -109,10 +136,52 @@ namespace GameActions
         }
     };
 
+    /**
+     * Action of the local player that was sent to the server and is shown as a ghost until the server has executed it.
+     * The server does not report failed actions, so the ghost is also removed after a while.
+     */
+    struct PredictedGameAction
+    {
+        uint32_t NetworkId;
+        uint32_t ExpiryTime;
+        GameAction::Ptr Action;
+        GameAction::Ptr Rollback; // Only set while the ghost is placed.
+    };
+
+    static constexpr uint32_t PredictionTimeoutMs = 3000;
+
     static GameActionFactory _actions[EnumValue(GameCommand::Count)];
-    static std::multiset<QueuedGameAction> _actionQueue;
+    // Kept in tick order, actions are nearly always queued for the current or a later tick so they go at the back
+    static std::deque<QueuedGameAction> _actionQueue;
+    static std::vector<PredictedGameAction> _predictedActions;
     static uint32_t _nextUniqueId = 0;
     static bool _suspended = false;
+    static uint32_t _executeCount = 0;
+    static uint32_t _executeDepth = 0;
+
+    /**
+     * Result of a query, valid until a tick passes, a game action runs or a tile changes.
+     */
+    struct CachedQuery
+    {
+        GameCommand Type{};
+        std::vector<uint8_t> Parameters;
+        uint32_t Tick{};
+        uint32_t ExecuteCount{};
+        uint32_t TileVersion{};
+        GameActions::Result::Ptr Result;
+
+        bool IsValid() const
+        {
+            return Result != nullptr && Tick == gCurrentTicks && ExecuteCount == _executeCount
+                && TileVersion == TileChangesGetVersion();
+        }
+    };
+
+    static constexpr size_t MaxCachedQueries = 8;
+
+    static std::array<CachedQuery, MaxCachedQueries> _cachedQueries;
+    static size_t _nextCachedQuery = 0;
 
     GameActionFactory Register(GameCommand id, GameActionFactory factory)
     {
@@ -158,7 +227,87 @@ namespace GameActions
             // as that normally happens when receiving them over network.
             ga->SetPlayer(network_get_current_player_id());
         }
-        _actionQueue.emplace(tick, std::move(ga), _nextUniqueId++);
+        QueuedGameAction queued(tick, std::move(ga), _nextUniqueId++);
+        auto it = _actionQueue.end();
+        while (it != _actionQueue.begin() && queued < *std::prev(it))
+        {
+            it--;
+        }
+        _actionQueue.insert(it, std::move(queued));
+    }
+
+    static bool ApplyPrediction(PredictedGameAction& prediction)
+    {
+        auto result = Execute(prediction.Action.get());
+        if (result->Error != Status::Ok)
+            return false;
+
+        prediction.Rollback = prediction.Action->CreatePredictionRollback(*result);
+        if (prediction.Rollback == nullptr)
+            return false;
+
+        prediction.Rollback->SetFlags(GAME_COMMAND_FLAG_ALLOW_DURING_PAUSED | GAME_COMMAND_FLAG_GHOST);
+        return true;
+    }
+
+    static void RollbackPrediction(PredictedGameAction& prediction)
+    {
+        if (prediction.Rollback != nullptr)
+        {
+            Execute(prediction.Rollback.get());
+            prediction.Rollback.reset();
+        }
+    }
+
+    static void RollbackPredictions()
+    {
+        // Newest first, later ghosts may depend on earlier ones.
+        for (auto it = _predictedActions.rbegin(); it != _predictedActions.rend(); it++)
+        {
+            RollbackPrediction(*it);
+        }
+    }
+
+    /**
+     * Places the ghosts of the predictions that were rolled back again, unless they expired or no longer fit.
+     */
+    static void ReapplyPredictions()
+    {
+        const auto currentTime = platform_get_ticks();
+        _predictedActions.erase(
+            std::remove_if(
+                _predictedActions.begin(), _predictedActions.end(),
+                [currentTime](PredictedGameAction& prediction) {
+                    if (currentTime >= prediction.ExpiryTime)
+                    {
+                        RollbackPrediction(prediction);
+                        return true;
+                    }
+                    return prediction.Rollback == nullptr && !ApplyPrediction(prediction);
+                }),
+            _predictedActions.end());
+    }
+
+    static void PredictAction(const GameAction* action)
+    {
+        if (!action->CanBePredicted())
+            return;
+
+        PredictedGameAction prediction;
+        prediction.NetworkId = action->GetNetworkId();
+        prediction.ExpiryTime = platform_get_ticks() + PredictionTimeoutMs;
+        prediction.Action = Clone(action);
+        prediction.Action->SetCallback(nullptr);
+        prediction.Action->SetFlags(action->GetFlags() | GAME_COMMAND_FLAG_ALLOW_DURING_PAUSED | GAME_COMMAND_FLAG_GHOST);
+        if (ApplyPrediction(prediction))
+        {
+            _predictedActions.push_back(std::move(prediction));
+        }
+    }
+
+    size_t GetPredictedActionCount()
+    {
+        return _predictedActions.size();
     }
 
     void ProcessQueue()
@@ -171,14 +320,19 @@ namespace GameActions
 
         const uint32_t currentTick = gCurrentTicks;
 
-        while (_actionQueue.begin() != _actionQueue.end())
+        // Ghosts must not interfere with the actions from the server, they are placed again after the queue ran.
+        if (!_predictedActions.empty() && !_actionQueue.empty() && _actionQueue.front().tick <= currentTick)
         {
-            // run all the game commands at the current tick
-            const QueuedGameAction& queued = *_actionQueue.begin();
+            RollbackPredictions();
+        }
 
+        while (!_actionQueue.empty())
+        {
+            // run all the game commands at the current tick
             if (network_get_mode() == NETWORK_MODE_CLIENT)
             {
-                if (queued.tick < currentTick)
+                const QueuedGameAction& next = _actionQueue.front();
+                if (next.tick < currentTick)
                 {
                     // This should never happen.
                     Guard::Assert(
@@ -186,14 +340,18 @@ namespace GameActions
                         "Discarding game action %s (%u) from tick behind current tick, ID: %08X, Action Tick: %08X, Current "
                         "Tick: "
                         "%08X\n",
-                        queued.action->GetName(), queued.action->GetType(), queued.uniqueId, queued.tick, currentTick);
+                        next.action->GetName(), next.action->GetType(), next.uniqueId, next.tick, currentTick);
                 }
-                else if (queued.tick > currentTick)
+                else if (next.tick > currentTick)
                 {
                     return;
                 }
             }
 
+            // Taken off the queue first, executing it can queue more actions
+            QueuedGameAction queued = std::move(_actionQueue.front());
+            _actionQueue.pop_front();
+
             // Remove ghost scenery so it doesn't interfere with incoming network command
             switch (queued.action->GetType())
             {
@@ -212,20 +370,46 @@ namespace GameActions
 
             Guard::Assert(action != nullptr);
 
+            if (!_predictedActions.empty() && action->GetPlayer().id == network_get_current_player_id())
+            {
+                // The server executed the predicted action, the real result replaces the ghost.
+                const auto networkId = action->GetNetworkId();
+                _predictedActions.erase(
+                    std::remove_if(
+                        _predictedActions.begin(), _predictedActions.end(),
+                        [networkId](const PredictedGameAction& prediction) { return prediction.NetworkId == networkId; }),
+                    _predictedActions.end());
+            }
+
             GameActions::Result::Ptr result = Execute(action);
             if (result->Error == GameActions::Status::Ok && network_get_mode() == NETWORK_MODE_SERVER)
             {
                 // Relay this action to all other clients.
                 network_send_game_action(action);
             }
+        }
 
-            _actionQueue.erase(_actionQueue.begin());
+        if (!_predictedActions.empty())
+        {
+            ReapplyPredictions();
+        }
+    }
+
+    static void ClearQueryCache()
+    {
+        for (auto& cached : _cachedQueries)
+        {
+            cached = {};
         }
     }
 
     void ClearQueue()
     {
         _actionQueue.clear();
+        ClearQueryCache();
+
+        // The ghosts went away with the map.
+        _predictedActions.clear();
     }
 
     void Initialize()
@@ -290,7 +474,63 @@ namespace GameActions
         return false;
     }
 
-    static GameActions::Result::Ptr QueryInternal(const GameAction* action, bool topLevel)
+    /**
+     * The name of the profiling zone for querying or executing the type of action, only called while capturing.
+     */
+    static const char* GetProfileZoneName(const GameAction* action, bool execute)
+    {
+        static std::array<std::string, EnumValue(GameCommand::Count)> queryNames;
+        static std::array<std::string, EnumValue(GameCommand::Count)> executeNames;
+
+        auto& name = (execute ? executeNames : queryNames)[EnumValue(action->GetType())];
+        if (name.empty())
+        {
+            name = std::string(action->GetName()) + (execute ? "::Execute" : "::Query");
+        }
+        return name.c_str();
+    }
+
+    static GameActions::Result::Ptr QueryCached(const GameAction* action)
+    {
+        // Actions can query others half way through changing the map, those have to see the current map
+        if (_executeDepth != 0)
+        {
+            return action->Query();
+        }
+
+        DataSerialiser ds(true);
+        action->Serialise(ds);
+        auto& stream = ds.GetStream();
+        const auto* data = static_cast<const uint8_t*>(stream.GetData());
+        const auto dataSize = static_cast<size_t>(stream.GetLength());
+
+        for (const auto& cached : _cachedQueries)
+        {
+            if (cached.IsValid() && cached.Type == action->GetType()
+                && std::equal(cached.Parameters.begin(), cached.Parameters.end(), data, data + dataSize))
+            {
+                return cached.Result->Clone();
+            }
+        }
+
+        auto result = action->Query();
+        auto copy = result->Clone();
+        if (typeid(*copy) == typeid(*result))
+        {
+            auto& cached = _cachedQueries[_nextCachedQuery];
+            _nextCachedQuery = (_nextCachedQuery + 1) % MaxCachedQueries;
+            cached.Type = action->GetType();
+            cached.Parameters.assign(data, data + dataSize);
+            // A tick can change anything, between ticks only game actions and tile changes can
+            cached.Tick = gCurrentTicks;
+            cached.ExecuteCount = _executeCount;
+            cached.TileVersion = TileChangesGetVersion();
+            cached.Result = std::move(copy);
+        }
+        return result;
+    }
+
+    static GameActions::Result::Ptr QueryInternal(const GameAction* action, bool topLevel, bool useCache = false)
     {
         Guard::ArgumentNotNull(action);
 
@@ -306,7 +546,11 @@ namespace GameActions
             return result;
         }
 
-        auto result = action->Query();
+        GameActions::Result::Ptr result;
+        {
+            Profiling::ScopedZone zone(Profiling::IsCapturing() ? GetProfileZoneName(action, false) : nullptr);
+            result = useCache ? QueryCached(action) : action->Query();
+        }
 
         if (result->Error == GameActions::Status::Ok)
         {
@@ -323,7 +567,7 @@ namespace GameActions
 
     GameActions::Result::Ptr Query(const GameAction* action)
     {
-        return QueryInternal(action, true);
+        return QueryInternal(action, true, action->CanCacheQuery());
     }
 
     GameActions::Result::Ptr QueryNested(const GameAction* action)
@@ -343,10 +587,17 @@ namespace GameActions
     struct ActionLogContext_t
     {
         MemoryStream output;
+        bool enabled{};
     };
 
     static void LogActionBegin(ActionLogContext_t& ctx, const GameAction* action)
     {
+        // Writing out the parameters of every action is only worth it when the text goes somewhere
+        ctx.enabled = _log_levels[EnumValue(DiagnosticLevel::Verbose)]
+            || (gConfigNetwork.log_server_actions && network_get_mode() != NETWORK_MODE_NONE);
+        if (!ctx.enabled)
+            return;
+
         MemoryStream& output = ctx.output;
 
         char temp[128] = {};
@@ -364,6 +615,9 @@ namespace GameActions
 
     static void LogActionFinish(ActionLogContext_t& ctx, const GameAction* action, const GameActions::Result::Ptr& result)
     {
+        if (!ctx.enabled)
+            return;
+
         MemoryStream& output = ctx.output;
 
         char temp[128] = {};
@@ -432,6 +686,10 @@ namespace GameActions
                         log_verbose("[%s] GameAction::Execute %s (Out)", GetRealm(), action->GetName());
                         network_send_game_action(action);
 
+                        if (gConfigNetwork.client_prediction)
+                        {
+                            PredictAction(action);
+                        }
                         return result;
                     }
                 }
@@ -453,7 +711,24 @@ namespace GameActions
             LogActionBegin(logContext, action);
 
             // Execute the action, changing the game state
-            result = action->Execute();
+            {
+                Profiling::ScopedZone zone(Profiling::IsCapturing() ? GetProfileZoneName(action, true) : nullptr);
+                _executeCount++;
+                _executeDepth++;
+                result = action->Execute();
+                _executeDepth--;
+            }
+            if (result->Error == GameActions::Status::Ok)
+            {
+                // Shared pathfinding results may no longer match the map.
+                PathfindCacheInvalidate();
+
+                // Covers the actions that modify elements in place, inserts and removals mark their own tiles
+                if (!result->Position.isNull())
+                {
+                    TileChangesMarkTile(TileCoordsXY(result->Position));
+                }
+            }
 #ifdef ENABLE_SCRIPTING
             if (result->Error == GameActions::Status::Ok)
             {
@@ -572,7 +847,10 @@ bool GameAction::LocationValid(const CoordsXY& coords) const
         return false;
 #ifdef ENABLE_SCRIPTING
     auto& hookEngine = GetContext()->GetScriptEngine().GetHookEngine();
-    if (hookEngine.HasSubscriptions(OpenRCT2::Scripting::HOOK_TYPE::ACTION_LOCATION))
+    OpenRCT2::Scripting::HookEvent hookEvent;
+    hookEvent.ActionType = EnumValue(_type);
+    hookEvent.Player = _playerId;
+    if (hookEngine.HasSubscriptions(OpenRCT2::Scripting::HOOK_TYPE::ACTION_LOCATION, hookEvent))
     {
         auto ctx = GetContext()->GetScriptEngine().GetContext();
 
@@ -589,7 +867,7 @@ bool GameAction::LocationValid(const CoordsXY& coords) const
 
         // Call the subscriptions
         auto e = obj.Take();
-        hookEngine.Call(OpenRCT2::Scripting::HOOK_TYPE::ACTION_LOCATION, e, true);
+        hookEngine.Call(OpenRCT2::Scripting::HOOK_TYPE::ACTION_LOCATION, hookEvent, e, true);
 
         auto scriptResult = OpenRCT2::Scripting::AsOrDefault(e["result"], true);
 
@@ -140,6 +140,14 @@ namespace GameActions
 
         std::string GetErrorTitle() const;
         std::string GetErrorMessage() const;
+
+        /**
+         * Copies the result, results with more fields than these override it to copy them too.
+         */
+        virtual Ptr Clone() const;
+
+    protected:
+        void CopyTo(Result& result) const;
     };
 
     class ConstructClearResult final : public Result
@@ -337,6 +345,33 @@ public:
      */
     virtual GameActions::Result::Ptr Execute() const abstract;
 
+    /**
+     * Override this for actions the tools query over and over with the same parameters while the player drags them,
+     * the result of a query is then reused until a game action runs, a tile changes or a tick passes. Query must not
+     * depend on anything else that can change in between and the result type must implement Clone.
+     */
+    virtual bool CanCacheQuery() const
+    {
+        return false;
+    }
+
+    /**
+     * Override this for actions that clients can show as a ghost while waiting for the server, the ghost is placed by
+     * executing the action with GAME_COMMAND_FLAG_GHOST.
+     */
+    virtual bool CanBePredicted() const
+    {
+        return false;
+    }
+
+    /**
+     * Creates the action that removes the ghost placed by this action, result is the result of executing it.
+     */
+    virtual std::unique_ptr<GameAction> CreatePredictionRollback(const GameActions::Result& result) const
+    {
+        return nullptr;
+    }
+
     bool LocationValid(const CoordsXY& coords) const;
 };
 
@@ -400,6 +435,9 @@ namespace GameActions
     void ProcessQueue();
     void ClearQueue();
 
+    // Number of actions sent to the server that are shown as a ghost until the server has executed them.
+    size_t GetPredictedActionCount();
+
     GameAction::Ptr Create(GameCommand id);
     GameAction::Ptr Clone(const GameAction* action);
 
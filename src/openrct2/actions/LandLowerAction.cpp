@@ -43,6 +43,11 @@ void LandLowerAction::Serialise(DataSerialiser& stream)
     stream << DS_TAG(_coords) << DS_TAG(_range) << DS_TAG(_selectionType);
 }
 
+bool LandLowerAction::CanCacheQuery() const
+{
+    return true;
+}
+
 GameActions::Result::Ptr LandLowerAction::Query() const
 {
     return QueryExecute(false);
@@ -27,6 +27,7 @@ public:
     void Serialise(DataSerialiser & stream) override;
     GameActions::Result::Ptr Query() const override;
     GameActions::Result::Ptr Execute() const override;
+    bool CanCacheQuery() const override;
 
 private:
     GameActions::Result::Ptr QueryExecute(bool isExecuting) const;
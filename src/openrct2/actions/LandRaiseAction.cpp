@@ -44,6 +44,11 @@ void LandRaiseAction::Serialise(DataSerialiser& stream)
     stream << DS_TAG(_coords) << DS_TAG(_range) << DS_TAG(_selectionType);
 }
 
+bool LandRaiseAction::CanCacheQuery() const
+{
+    return true;
+}
+
 GameActions::Result::Ptr LandRaiseAction::Query() const
 {
     return QueryExecute(false);
@@ -45,6 +45,11 @@ void LandSetHeightAction::Serialise(DataSerialiser& stream)
     stream << DS_TAG(_coords) << DS_TAG(_height) << DS_TAG(_style);
 }
 
+bool LandSetHeightAction::CanCacheQuery() const
+{
+    return true;
+}
+
 GameActions::Result::Ptr LandSetHeightAction::Query() const
 {
     if (gParkFlags & PARK_FLAGS_FORBID_LANDSCAPE_CHANGES)
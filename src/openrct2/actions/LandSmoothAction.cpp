@@ -46,6 +46,11 @@ void LandSmoothAction::Serialise(DataSerialiser& stream)
     stream << DS_TAG(_coords) << DS_TAG(_range) << DS_TAG(_selectionType) << DS_TAG(_isLowering);
 }
 
+bool LandSmoothAction::CanCacheQuery() const
+{
+    return true;
+}
+
 GameActions::Result::Ptr LandSmoothAction::Query() const
 {
     return SmoothLand(false);
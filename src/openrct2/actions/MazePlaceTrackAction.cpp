@@ -10,6 +10,7 @@
 
 #include "../management/Finance.h"
 #include "../ride/RideData.h"
+#include "../ride/RideSpatialIndex.h"
 #include "../ride/TrackData.h"
 
 MazePlaceTrackAction::MazePlaceTrackAction(const CoordsXYZ& location, NetworkRideId_t rideIndex, uint16_t mazeEntry)
@@ -178,6 +179,7 @@ GameActions::Result::Ptr MazePlaceTrackAction::Execute() const
     trackElement->SetGhost(flags & GAME_COMMAND_FLAG_GHOST);
 
     map_invalidate_tile_full(startLoc);
+    RideSpatialIndexInvalidateTile(_loc);
 
     ride->maze_tiles++;
     ride->stations[0].SetBaseZ(trackElement->GetBaseZ());
@@ -16,6 +16,7 @@
 #include "../localisation/StringIds.h"
 #include "../management/Finance.h"
 #include "../ride/RideData.h"
+#include "../ride/RideSpatialIndex.h"
 #include "../ride/Track.h"
 #include "../ride/TrackData.h"
 #include "../world/Footpath.h"
@@ -193,6 +194,7 @@ GameActions::Result::Ptr MazeSetTrackAction::Execute() const
         tileElement = trackElement->as<TileElement>();
 
         map_invalidate_tile_full(startLoc);
+        RideSpatialIndexInvalidateTile(_loc);
 
         ride->maze_tiles++;
         ride->stations[0].SetBaseZ(tileElement->GetBaseZ());
@@ -296,6 +298,7 @@ GameActions::Result::Ptr MazeSetTrackAction::Execute() const
     if ((tileElement->AsTrack()->GetMazeEntry() & 0x8888) == 0x8888)
     {
         tile_element_remove(tileElement);
+        RideSpatialIndexInvalidateTile(_loc);
         sub_6CB945(ride);
         ride->maze_tiles--;
     }
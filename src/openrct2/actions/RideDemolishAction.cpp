@@ -19,6 +19,7 @@
 #include "../management/NewsItem.h"
 #include "../ride/Ride.h"
 #include "../ride/RideData.h"
+#include "../ride/RideSpatialIndex.h"
 #include "../ui/UiContext.h"
 #include "../ui/WindowManager.h"
 #include "../world/Banner.h"
@@ -311,6 +312,7 @@ money32 RideDemolishAction::DemolishTracks() const
             if (removRes->Error != GameActions::Status::Ok)
             {
                 tile_element_remove(it.element);
+                RideSpatialIndexInvalidateTile(location);
             }
             else
             {
@@ -28,6 +28,7 @@
 #include "../world/Footpath.h"
 #include "../world/Location.hpp"
 #include "../world/Map.h"
+#include "../world/MapScan.h"
 #include "../world/Park.h"
 #include "../world/Scenery.h"
 #include "../world/Sprite.h"
@@ -354,84 +355,68 @@ ParametersRange SetCheatAction::GetParameterRange(CheatType cheatType) const
 
 void SetCheatAction::SetGrassLength(int32_t length) const
 {
-    for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
-    {
-        for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
-        {
-            auto surfaceElement = map_get_surface_element_at(TileCoordsXY{ x, y }.ToCoordsXY());
-            if (surfaceElement == nullptr)
-                continue;
+    ForEachTileParallel([length](const TileCoordsXY& coords) {
+        auto surfaceElement = map_get_surface_element_at(coords.ToCoordsXY());
+        if (surfaceElement == nullptr)
+            return;
 
-            if (surfaceElement != nullptr && (surfaceElement->GetOwnership() & OWNERSHIP_OWNED)
-                && surfaceElement->GetWaterHeight() == 0 && surfaceElement->CanGrassGrow())
-            {
-                surfaceElement->SetGrassLength(length);
-            }
+        if ((surfaceElement->GetOwnership() & OWNERSHIP_OWNED) && surfaceElement->GetWaterHeight() == 0
+            && surfaceElement->CanGrassGrow())
+        {
+            surfaceElement->SetGrassLength(length);
         }
-    }
+    });
 
     gfx_invalidate_screen();
 }
 
 void SetCheatAction::WaterPlants() const
 {
-    tile_element_iterator it;
-
-    tile_element_iterator_begin(&it);
-    do
-    {
-        if (it.element->GetType() == TILE_ELEMENT_TYPE_SMALL_SCENERY)
+    ForEachTileElementParallel([](TileElement& element, const TileCoordsXY&) {
+        if (element.GetType() == TILE_ELEMENT_TYPE_SMALL_SCENERY)
         {
-            it.element->AsSmallScenery()->SetAge(0);
+            element.AsSmallScenery()->SetAge(0);
         }
-    } while (tile_element_iterator_next(&it));
+    });
 
     gfx_invalidate_screen();
 }
 
 void SetCheatAction::FixVandalism() const
 {
-    tile_element_iterator it;
-
-    tile_element_iterator_begin(&it);
-    do
-    {
-        if (it.element->GetType() != TILE_ELEMENT_TYPE_PATH)
-            continue;
+    ForEachTileElementParallel([](TileElement& element, const TileCoordsXY&) {
+        if (element.GetType() != TILE_ELEMENT_TYPE_PATH)
+            return;
 
-        if (!(it.element)->AsPath()->HasAddition())
-            continue;
+        if (!element.AsPath()->HasAddition())
+            return;
 
-        it.element->AsPath()->SetIsBroken(false);
-    } while (tile_element_iterator_next(&it));
+        element.AsPath()->SetIsBroken(false);
+    });
 
     gfx_invalidate_screen();
 }
 
 void SetCheatAction::RemoveLitter() const
 {
-    for (auto litter : EntityList<Litter>())
+    std::vector<SpriteBase*> litter;
+    for (auto* entity : EntityList<Litter>())
     {
-        sprite_remove(litter);
+        litter.push_back(entity);
     }
+    sprite_remove_many(litter);
 
-    tile_element_iterator it;
-    rct_scenery_entry* sceneryEntry;
+    ForEachTileElementParallel([](TileElement& element, const TileCoordsXY&) {
+        if (element.GetType() != TILE_ELEMENT_TYPE_PATH)
+            return;
 
-    tile_element_iterator_begin(&it);
-    do
-    {
-        if (it.element->GetType() != TILE_ELEMENT_TYPE_PATH)
-            continue;
-
-        if (!(it.element)->AsPath()->HasAddition())
-            continue;
+        if (!element.AsPath()->HasAddition())
+            return;
 
-        sceneryEntry = it.element->AsPath()->GetAdditionEntry();
+        auto* sceneryEntry = element.AsPath()->GetAdditionEntry();
         if (sceneryEntry->path_bit.flags & PATH_BIT_FLAG_IS_BIN)
-            it.element->AsPath()->SetAdditionStatus(0xFF);
-
-    } while (tile_element_iterator_next(&it));
+            element.AsPath()->SetAdditionStatus(0xFF);
+    });
 
     gfx_invalidate_screen();
 }
@@ -659,12 +644,12 @@ void SetCheatAction::RemoveAllGuests() const
         }
     }
 
-    // Do not use the FOR_ALL_PEEPS macro for this as next sprite index
-    // will be fetched on a deleted guest.
+    std::vector<Peep*> guests;
     for (auto guest : EntityList<Guest>())
     {
-        guest->Remove();
+        guests.push_back(guest);
     }
+    peep_remove_many(guests);
 
     window_invalidate_by_class(WC_RIDE);
     gfx_invalidate_screen();
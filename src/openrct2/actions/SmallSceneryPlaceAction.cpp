@@ -48,6 +48,15 @@ SmallSceneryPlaceActionResult::SmallSceneryPlaceActionResult(GameActions::Status
 {
 }
 
+GameActions::Result::Ptr SmallSceneryPlaceActionResult::Clone() const
+{
+    auto result = std::make_unique<SmallSceneryPlaceActionResult>();
+    CopyTo(*result);
+    result->GroundFlags = GroundFlags;
+    result->tileElement = tileElement;
+    return result;
+}
+
 SmallSceneryPlaceAction::SmallSceneryPlaceAction(
     const CoordsXYZD& loc, uint8_t quadrant, ObjectEntryIndex sceneryType, uint8_t primaryColour, uint8_t secondaryColour)
     : _loc(loc)
@@ -77,6 +86,28 @@ uint16_t SmallSceneryPlaceAction::GetActionFlags() const
     return GameAction::GetActionFlags();
 }
 
+bool SmallSceneryPlaceAction::CanCacheQuery() const
+{
+    return true;
+}
+
+bool SmallSceneryPlaceAction::CanBePredicted() const
+{
+    return true;
+}
+
+std::unique_ptr<GameAction> SmallSceneryPlaceAction::CreatePredictionRollback(const GameActions::Result& result) const
+{
+    // The height and quadrant may have been chosen by the action.
+    auto sceneryResult = dynamic_cast<const SmallSceneryPlaceActionResult*>(&result);
+    if (sceneryResult == nullptr || sceneryResult->tileElement == nullptr)
+        return nullptr;
+
+    const auto* tileElement = sceneryResult->tileElement;
+    return std::make_unique<SmallSceneryRemoveAction>(
+        CoordsXYZ{ _loc, tileElement->GetBaseZ() }, tileElement->AsSmallScenery()->GetSceneryQuadrant(), _sceneryType);
+}
+
 void SmallSceneryPlaceAction::Serialise(DataSerialiser& stream)
 {
     GameAction::Serialise(stream);
@@ -20,6 +20,8 @@ public:
     SmallSceneryPlaceActionResult(GameActions::Status error, rct_string_id message);
     SmallSceneryPlaceActionResult(GameActions::Status error, rct_string_id message, uint8_t* args);
 
+    GameActions::Result::Ptr Clone() const override;
+
     uint8_t GroundFlags{ 0 };
     TileElement* tileElement = nullptr;
 };
@@ -46,4 +48,7 @@ public:
     void Serialise(DataSerialiser & stream) override;
     GameActions::Result::Ptr Query() const override;
     GameActions::Result::Ptr Execute() const override;
+    bool CanCacheQuery() const override;
+    bool CanBePredicted() const override;
+    std::unique_ptr<GameAction> CreatePredictionRollback(const GameActions::Result& result) const override;
 };
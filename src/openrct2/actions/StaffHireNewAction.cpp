@@ -188,7 +188,7 @@ GameActions::Result::Ptr StaffHireNewAction::QueryExecute(bool execute) const
         {
             spriteType = EntertainerCostumeToSprite(_entertainerType);
         }
-        newPeep->Name = nullptr;
+        newPeep->Name = {};
         newPeep->SpriteType = spriteType;
 
         const rct_sprite_bounds* spriteBounds = &GetSpriteBounds(spriteType);
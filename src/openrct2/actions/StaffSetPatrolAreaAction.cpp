@@ -68,7 +68,7 @@ GameActions::Result::Ptr StaffSetPatrolAreaAction::Execute() const
     staff_toggle_patrol_area(staff->StaffId, _loc);
 
     bool isPatrolling = false;
-    for (int32_t i = 0; i < 128; i++)
+    for (int32_t i = 0; i < STAFF_PATROL_AREA_SIZE; i++)
     {
         if (gStaffPatrolAreas[patrolOffset + i])
         {
@@ -9,6 +9,7 @@
 
 #include "TileModifyAction.h"
 
+#include "../ride/RideSpatialIndex.h"
 #include "../world/TileInspector.h"
 
 using namespace OpenRCT2;
@@ -42,7 +43,10 @@ GameActions::Result::Ptr TileModifyAction::Query() const
 
 GameActions::Result::Ptr TileModifyAction::Execute() const
 {
-    return QueryExecute(true);
+    auto result = QueryExecute(true);
+    // The tile inspector can add, remove or change track elements of any ride.
+    RideSpatialIndexInvalidateTile(_loc);
+    return result;
 }
 
 GameActions::Result::Ptr TileModifyAction::QueryExecute(bool isExecuting) const
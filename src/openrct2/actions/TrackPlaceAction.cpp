@@ -11,6 +11,7 @@
 
 #include "../management/Finance.h"
 #include "../ride/RideData.h"
+#include "../ride/RideSpatialIndex.h"
 #include "../ride/Track.h"
 #include "../ride/TrackData.h"
 #include "../ride/TrackDesign.h"
@@ -18,6 +19,7 @@
 #include "../world/MapAnimation.h"
 #include "../world/Surface.h"
 #include "RideSetSettingAction.h"
+#include "TrackRemoveAction.h"
 
 TrackPlaceActionResult::TrackPlaceActionResult()
     : GameActions::Result(GameActions::Status::Ok, STR_RIDE_CONSTRUCTION_CANT_CONSTRUCT_THIS_HERE)
@@ -71,6 +73,16 @@ uint16_t TrackPlaceAction::GetActionFlags() const
     return GameAction::GetActionFlags();
 }
 
+bool TrackPlaceAction::CanBePredicted() const
+{
+    return !_fromTrackDesign;
+}
+
+std::unique_ptr<GameAction> TrackPlaceAction::CreatePredictionRollback(const GameActions::Result& result) const
+{
+    return std::make_unique<TrackRemoveAction>(_trackType, 0, _origin);
+}
+
 void TrackPlaceAction::Serialise(DataSerialiser& stream)
 {
     GameAction::Serialise(stream);
@@ -641,6 +653,7 @@ GameActions::Result::Ptr TrackPlaceAction::Execute() const
             footpath_connect_edges(mapLoc, tileElement, GetFlags());
         }
         map_invalidate_tile_full(mapLoc);
+        RideSpatialIndexInvalidateTile(mapLoc);
     }
 
     money32 price = ride->GetRideTypeDescriptor().BuildCosts.TrackPrice;
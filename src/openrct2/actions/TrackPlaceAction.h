@@ -47,4 +47,6 @@ public:
     void Serialise(DataSerialiser & stream) override;
     GameActions::Result::Ptr Query() const override;
     GameActions::Result::Ptr Execute() const override;
+    bool CanBePredicted() const override;
+    std::unique_ptr<GameAction> CreatePredictionRollback(const GameActions::Result& result) const override;
 };
@@ -11,6 +11,7 @@
 
 #include "../management/Finance.h"
 #include "../ride/RideData.h"
+#include "../ride/RideSpatialIndex.h"
 #include "../ride/Track.h"
 #include "../ride/TrackData.h"
 #include "../ride/TrackDesign.h"
@@ -422,6 +423,7 @@ GameActions::Result::Ptr TrackRemoveAction::Execute() const
             footpath_remove_edges_at(mapLoc, tileElement);
         }
         tile_element_remove(tileElement);
+        RideSpatialIndexInvalidateTile(mapLoc);
         sub_6CB945(ride);
         if (!(GetFlags() & GAME_COMMAND_FLAG_GHOST))
         {
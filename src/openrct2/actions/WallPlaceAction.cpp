@@ -19,6 +19,7 @@
 #include "../world/SmallScenery.h"
 #include "../world/Surface.h"
 #include "../world/Wall.h"
+#include "WallRemoveAction.h"
 
 WallPlaceActionResult::WallPlaceActionResult()
     : GameActions::Result(GameActions::Status::Ok, STR_CANT_BUILD_PARK_ENTRANCE_HERE)
@@ -83,6 +84,21 @@ uint16_t WallPlaceAction::GetActionFlags() const
     return GameAction::GetActionFlags();
 }
 
+bool WallPlaceAction::CanBePredicted() const
+{
+    return true;
+}
+
+std::unique_ptr<GameAction> WallPlaceAction::CreatePredictionRollback(const GameActions::Result& result) const
+{
+    // The height may have been chosen by the action.
+    auto wallResult = dynamic_cast<const WallPlaceActionResult*>(&result);
+    if (wallResult == nullptr || wallResult->tileElement == nullptr)
+        return nullptr;
+
+    return std::make_unique<WallRemoveAction>(CoordsXYZD{ _loc, wallResult->tileElement->GetBaseZ(), _edge });
+}
+
 void WallPlaceAction::Serialise(DataSerialiser& stream)
 {
     GameAction::Serialise(stream);
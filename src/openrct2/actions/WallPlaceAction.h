@@ -49,6 +49,8 @@ public:
     void Serialise(DataSerialiser & stream) override;
     GameActions::Result::Ptr Query() const override;
     GameActions::Result::Ptr Execute() const override;
+    bool CanBePredicted() const override;
+    std::unique_ptr<GameAction> CreatePredictionRollback(const GameActions::Result& result) const override;
 
 private:
     /**
@@ -346,6 +346,7 @@ namespace OpenRCT2::Audio
         for (auto& vehicleSound : gVehicleSoundList)
         {
             vehicleSound.id = SoundIdNull;
+            vehicleSound.Fading = false;
         }
 
         _currentAudioDevice = device;
@@ -401,6 +402,7 @@ namespace OpenRCT2::Audio
             if (vehicleSound.id != SoundIdNull)
             {
                 vehicleSound.id = SoundIdNull;
+                vehicleSound.Fading = false;
                 if (vehicleSound.TrackSound.Id != SoundId::Null)
                 {
                     Mixer_Stop_Channel(vehicleSound.TrackSound.Channel);
@@ -12,6 +12,7 @@
 #include "../common.h"
 #include "../core/IStream.hpp"
 
+#include <array>
 #include <memory>
 
 #define MIXER_VOLUME_MAX 128
@@ -32,6 +33,22 @@ namespace OpenRCT2::Audio
     struct IAudioSource;
     struct IAudioChannel;
 
+    // Bucket i counts the callbacks that took less than 64 << i microseconds, the last one all that took longer
+    constexpr size_t MIXER_HISTOGRAM_BUCKETS = 12;
+
+    /**
+     * Time spent mixing in the audio callback, an overrun is a callback that took longer than the duration of the
+     * buffer it filled, which is heard as a gap.
+     */
+    struct MixerStatistics
+    {
+        uint64_t Callbacks{};
+        uint64_t Overruns{};
+        uint64_t MaxMicroseconds{};
+        uint64_t BufferMicroseconds{};
+        std::array<uint64_t, MIXER_HISTOGRAM_BUCKETS> Histogram{};
+    };
+
     /**
      * Provides an audio stream by mixing multiple audio channels together.
      */
@@ -50,6 +67,9 @@ namespace OpenRCT2::Audio
 
         virtual IAudioSource* GetSoundSource(SoundId id) abstract;
         virtual IAudioSource* GetMusicSource(int32_t id) abstract;
+
+        virtual MixerStatistics GetStatistics() abstract;
+        virtual void ResetStatistics() abstract;
     };
 } // namespace OpenRCT2::Audio
 
@@ -42,6 +42,8 @@ namespace OpenRCT2::Audio
         int16_t volume;
         Sound TrackSound;
         Sound OtherSound;
+        // Lost its voice to a louder vehicle or went out of view, fading out until it stops or is heard again
+        bool Fading;
     };
 
     struct VehicleSoundParams
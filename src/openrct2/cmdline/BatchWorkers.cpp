@@ -0,0 +1,135 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "BatchWorkers.h"
+
+#ifdef BATCH_WORKERS_FORK
+
+#    include "../core/Console.hpp"
+
+#    include <atomic>
+#    include <cstdio>
+#    include <new>
+#    include <poll.h>
+#    include <sys/mman.h>
+#    include <sys/wait.h>
+#    include <unistd.h>
+
+static bool WriteAll(int fd, const std::string& data)
+{
+    size_t written = 0;
+    while (written < data.size())
+    {
+        auto n = write(fd, data.data() + written, data.size() - written);
+        if (n < 0)
+            return false;
+        written += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+std::vector<std::string> RunBatchInWorkers(size_t count, size_t jobs, const std::function<std::string(size_t)>& work)
+{
+    auto* nextIndex = static_cast<std::atomic<size_t>*>(
+        mmap(nullptr, sizeof(std::atomic<size_t>), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0));
+    if (nextIndex == MAP_FAILED)
+    {
+        Console::Error::WriteLine("Unable to create shared memory for the workers.");
+        return {};
+    }
+    new (nextIndex) std::atomic<size_t>(0);
+
+    // Make sure nothing buffered gets written twice by the workers.
+    fflush(stdout);
+    fflush(stderr);
+
+    std::vector<pid_t> workers;
+    std::vector<pollfd> pipes;
+    for (size_t n = 0; n < jobs; n++)
+    {
+        int fds[2];
+        if (pipe(fds) != 0)
+            break;
+
+        auto pid = fork();
+        if (pid == 0)
+        {
+            close(fds[0]);
+            for (const auto& p : pipes)
+            {
+                close(p.fd);
+            }
+            size_t index;
+            while ((index = nextIndex->fetch_add(1)) < count)
+            {
+                if (!WriteAll(fds[1], work(index) + "\n"))
+                    break;
+            }
+            close(fds[1]);
+            // Skip the destructors of the state inherited from the parent.
+            _exit(0);
+        }
+
+        close(fds[1]);
+        if (pid < 0)
+        {
+            close(fds[0]);
+            break;
+        }
+        workers.push_back(pid);
+        pipes.push_back({ fds[0], POLLIN, 0 });
+    }
+
+    std::vector<std::string> results;
+    std::vector<std::string> pending(pipes.size());
+    size_t open = pipes.size();
+    while (open > 0)
+    {
+        if (poll(pipes.data(), pipes.size(), -1) < 0)
+            break;
+
+        for (size_t n = 0; n < pipes.size(); n++)
+        {
+            if (pipes[n].fd < 0 || pipes[n].revents == 0)
+                continue;
+
+            char buffer[4096];
+            auto bytesRead = read(pipes[n].fd, buffer, sizeof(buffer));
+            if (bytesRead <= 0)
+            {
+                close(pipes[n].fd);
+                pipes[n].fd = -1;
+                open--;
+                continue;
+            }
+
+            pending[n].append(buffer, static_cast<size_t>(bytesRead));
+            size_t lineEnd;
+            while ((lineEnd = pending[n].find('\n')) != std::string::npos)
+            {
+                results.push_back(pending[n].substr(0, lineEnd));
+                pending[n].erase(0, lineEnd + 1);
+            }
+        }
+    }
+
+    for (auto pid : workers)
+    {
+        int status = 0;
+        waitpid(pid, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        {
+            Console::Error::WriteLine("Worker %d did not exit cleanly, its current file is reported as failed.", pid);
+        }
+    }
+    munmap(nextIndex, sizeof(std::atomic<size_t>));
+    return results;
+}
+
+#endif // BATCH_WORKERS_FORK
@@ -0,0 +1,28 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+#    define BATCH_WORKERS_FORK
+
+/**
+ * Runs work for every index below count in forked worker processes. The parent has already loaded the objects, so the
+ * workers share them copy on write and every worker has its own copy of the global game state. Workers take the next
+ * index from a counter in shared memory and send each result back as a line, so a result must not contain a newline.
+ * The lines are returned in the order they arrived, an index lost with a crashed worker has none.
+ */
+std::vector<std::string> RunBatchInWorkers(size_t count, size_t jobs, const std::function<std::string(size_t)>& work);
+#endif
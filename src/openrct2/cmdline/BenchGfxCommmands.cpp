@@ -10,11 +10,499 @@
 #include "../interface/Screenshot.h"
 #include "CommandLine.hpp"
 
+#ifdef USE_BENCHMARK
+
+#    include "../Context.h"
+#    include "../Game.h"
+#    include "../Intro.h"
+#    include "../OpenRCT2.h"
+#    include "../drawing/Drawing.h"
+#    include "../drawing/X8DrawingEngine.h"
+#    include "../interface/Viewport.h"
+#    include "../paint/Paint.h"
+#    include "../platform/Platform2.h"
+#    include "../util/Util.h"
+#    include "../world/Map.h"
+
+#    include <benchmark/benchmark.h>
+#    include <memory>
+#    include <random>
+#    include <string>
+#    include <vector>
+
+using namespace OpenRCT2;
+using namespace OpenRCT2::Drawing;
+
+using RLERemapFn = void (*)(const uint8_t* src, uint8_t* dst, const uint8_t* table, int32_t length);
+using RLEBlendFn = void (*)(const uint8_t* src, uint8_t* dst, const uint8_t* maps, uint32_t mapsLength, int32_t length);
+using PaletteExpandFn = void (*)(uint32_t* dst, const uint8_t* src, const uint32_t* palette, int32_t length);
+
+static constexpr int32_t BenchRunCount = 256;
+static constexpr uint32_t BenchBlendMapCount = 16;
+
+struct RLEKernelInput
+{
+    std::vector<uint8_t> Source;
+    std::vector<uint8_t> Destination;
+    std::vector<uint8_t> Maps;
+};
+
+// Random pixels with a few transparent ones in between, the same every time so kernels can be compared
+static RLEKernelInput CreateRLEKernelInput(int32_t runLength)
+{
+    std::mt19937 rng(runLength);
+    RLEKernelInput input;
+    input.Source.resize(BenchRunCount * runLength);
+    input.Destination.resize(input.Source.size());
+    input.Maps.resize(BenchBlendMapCount * 256);
+    for (auto& pixel : input.Source)
+    {
+        pixel = (rng() % 8) == 0 ? 0 : 1 + (rng() % BenchBlendMapCount);
+    }
+    for (auto& pixel : input.Destination)
+    {
+        pixel = static_cast<uint8_t>(rng());
+    }
+    for (auto& entry : input.Maps)
+    {
+        entry = (rng() % 16) == 0 ? 0 : static_cast<uint8_t>(rng());
+    }
+    return input;
+}
+
+static void ApplyRLEKernel(const RLEKernelInput& input, std::vector<uint8_t>& dst, int32_t runLength, RLERemapFn fn)
+{
+    for (int32_t i = 0; i < BenchRunCount; i++)
+    {
+        fn(&input.Source[i * runLength], &dst[i * runLength], input.Maps.data(), runLength);
+    }
+}
+
+static void ApplyRLEKernel(const RLEKernelInput& input, std::vector<uint8_t>& dst, int32_t runLength, RLEBlendFn fn)
+{
+    auto mapsLength = static_cast<uint32_t>(input.Maps.size());
+    for (int32_t i = 0; i < BenchRunCount; i++)
+    {
+        fn(&input.Source[i * runLength], &dst[i * runLength], input.Maps.data(), mapsLength, runLength);
+    }
+}
+
+template<typename TFn> static void BM_rle_kernel(benchmark::State& state, TFn fn, TFn scalarFn)
+{
+    const auto runLength = static_cast<int32_t>(state.range(0));
+    const auto input = CreateRLEKernelInput(runLength);
+
+    auto expected = input.Destination;
+    auto dst = input.Destination;
+    ApplyRLEKernel(input, expected, runLength, scalarFn);
+    ApplyRLEKernel(input, dst, runLength, fn);
+    if (dst != expected)
+    {
+        state.SkipWithError("Output differs from the scalar kernel");
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        dst = input.Destination;
+        state.ResumeTiming();
+        ApplyRLEKernel(input, dst, runLength, fn);
+        benchmark::DoNotOptimize(dst.data());
+    }
+    state.SetItemsProcessed(state.iterations() * BenchRunCount * runLength);
+}
+
+template<typename TFn> static void RegisterRLEKernelBenchmark(const char* name, TFn fn, TFn scalarFn)
+{
+    // RLE runs are at most 127 pixels long
+    benchmark::RegisterBenchmark(name, BM_rle_kernel<TFn>, fn, scalarFn)->Arg(16)->Arg(32)->Arg(64)->Arg(127);
+}
+
+// A row of the screen going into a 32 bit texture
+static void BM_palette_expand(benchmark::State& state, PaletteExpandFn fn)
+{
+    const auto length = static_cast<int32_t>(state.range(0));
+    std::mt19937 rng(length);
+    std::vector<uint8_t> src(length);
+    for (auto& pixel : src)
+    {
+        pixel = static_cast<uint8_t>(rng());
+    }
+    uint32_t palette[256];
+    for (auto& colour : palette)
+    {
+        colour = rng();
+    }
+
+    std::vector<uint32_t> expected(length);
+    std::vector<uint32_t> dst(length);
+    palette_expand_row_scalar(expected.data(), src.data(), palette, length);
+    fn(dst.data(), src.data(), palette, length);
+    if (dst != expected)
+    {
+        state.SkipWithError("Output differs from the scalar kernel");
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        fn(dst.data(), src.data(), palette, length);
+        benchmark::DoNotOptimize(dst.data());
+    }
+    state.SetItemsProcessed(state.iterations() * length);
+}
+
+static int RunBenchmarks(int argc, const char** argv)
+{
+    // Google benchmark wants to reorder the pointers, so present a copy of them.
+    std::vector<char*> argv_for_benchmark;
+    argv_for_benchmark.push_back(nullptr);
+    for (int i = 0; i < argc; i++)
+    {
+        argv_for_benchmark.push_back(const_cast<char*>(argv[i]));
+    }
+    argc = static_cast<int>(argv_for_benchmark.size());
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+    ::benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
+
+static int CmdlineForBenchGfxKernels(int argc, const char** argv)
+{
+    RegisterRLEKernelBenchmark<RLERemapFn>("remap/scalar", rle_remap_scalar, rle_remap_scalar);
+    RegisterRLEKernelBenchmark<RLERemapFn>("remap_dst/scalar", rle_remap_dst_scalar, rle_remap_dst_scalar);
+    RegisterRLEKernelBenchmark<RLEBlendFn>("blend/scalar", rle_blend_scalar, rle_blend_scalar);
+    if (sse41_available())
+    {
+        RegisterRLEKernelBenchmark<RLERemapFn>("remap/sse4_1", rle_remap_sse4_1, rle_remap_scalar);
+        RegisterRLEKernelBenchmark<RLERemapFn>("remap_dst/sse4_1", rle_remap_dst_sse4_1, rle_remap_dst_scalar);
+    }
+    if (avx2_available())
+    {
+        RegisterRLEKernelBenchmark<RLERemapFn>("remap/avx2", rle_remap_avx2, rle_remap_scalar);
+        RegisterRLEKernelBenchmark<RLERemapFn>("remap_dst/avx2", rle_remap_dst_avx2, rle_remap_dst_scalar);
+        RegisterRLEKernelBenchmark<RLEBlendFn>("blend/avx2", rle_blend_avx2, rle_blend_scalar);
+    }
+    benchmark::RegisterBenchmark("palette_expand/scalar", BM_palette_expand, palette_expand_row_scalar)
+        ->Arg(1920)
+        ->Arg(3840);
+    if (avx2_available())
+    {
+        benchmark::RegisterBenchmark("palette_expand/avx2", BM_palette_expand, palette_expand_row_avx2)
+            ->Arg(1920)
+            ->Arg(3840);
+    }
+    return RunBenchmarks(argc, argv);
+}
+
+static constexpr int32_t BenchScreenWidth = 1920;
+static constexpr int32_t BenchScreenHeight = 1080;
+
+struct BenchView
+{
+    rct_viewport Viewport{};
+    std::vector<uint8_t> Pixels;
+    rct_drawpixelinfo DPI;
+    // The same 32 unit wide columns viewport_paint splits the screen into
+    std::vector<rct_drawpixelinfo> Columns;
+};
+
+struct BenchRLEKernels
+{
+    RLERemapFn Remap;
+    RLERemapFn RemapDst;
+    RLEBlendFn Blend;
+};
+
+// A screen over the middle of the map
+static std::unique_ptr<BenchView> CreateBenchView(ZoomLevel zoom, IDrawingEngine* drawingEngine)
+{
+    auto view = std::make_unique<BenchView>();
+    auto& viewport = view->Viewport;
+    viewport.width = BenchScreenWidth;
+    viewport.height = BenchScreenHeight;
+    viewport.view_width = BenchScreenWidth * zoom;
+    viewport.view_height = BenchScreenHeight * zoom;
+    viewport.zoom = zoom;
+
+    auto centre = TileCoordsXY(gMapSize / 2, gMapSize / 2).ToCoordsXY().ToTileCentre();
+    auto centre2d = translate_3d_to_2d_with_z(get_current_rotation(), CoordsXYZ(centre, tile_element_height(centre)));
+    viewport.viewPos = { (centre2d.x - viewport.view_width / 2) & ~31, centre2d.y - viewport.view_height / 2 };
+
+    view->Pixels.resize(BenchScreenWidth * BenchScreenHeight);
+    view->DPI.bits = view->Pixels.data();
+    view->DPI.width = BenchScreenWidth;
+    view->DPI.height = BenchScreenHeight;
+    view->DPI.DrawingEngine = drawingEngine;
+
+    for (int32_t x = 0; x < viewport.view_width; x += 32)
+    {
+        rct_drawpixelinfo column;
+        column.bits = view->Pixels.data() + (x / zoom);
+        column.x = viewport.viewPos.x + x;
+        column.y = viewport.viewPos.y;
+        column.width = 32;
+        column.height = viewport.view_height;
+        column.pitch = BenchScreenWidth - (32 / zoom);
+        column.zoom_level = zoom;
+        column.DrawingEngine = drawingEngine;
+        view->Columns.push_back(column);
+    }
+    return view;
+}
+
+static void AllocateSessions(const BenchView& view, std::vector<paint_session*>& sessions)
+{
+    for (auto column : view.Columns)
+    {
+        sessions.push_back(PaintSessionAlloc(&column, view.Viewport.flags));
+    }
+}
+
+static void FreeSessions(std::vector<paint_session*>& sessions)
+{
+    for (auto session : sessions)
+    {
+        PaintSessionFree(session);
+    }
+    sessions.clear();
+}
+
+static void BM_paint_generate(benchmark::State& state, const BenchView* view)
+{
+    std::vector<paint_session*> sessions;
+    for (auto _ : state)
+    {
+        AllocateSessions(*view, sessions);
+        for (auto session : sessions)
+        {
+            PaintSessionGenerate(session);
+        }
+        state.PauseTiming();
+        FreeSessions(sessions);
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * view->Columns.size());
+}
+
+static void BM_paint_arrange(benchmark::State& state, const BenchView* view)
+{
+    std::vector<paint_session*> sessions;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        AllocateSessions(*view, sessions);
+        for (auto session : sessions)
+        {
+            PaintSessionGenerate(session);
+        }
+        state.ResumeTiming();
+        for (auto session : sessions)
+        {
+            PaintSessionArrange(session);
+        }
+        state.PauseTiming();
+        FreeSessions(sessions);
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * view->Columns.size());
+}
+
+static void BM_paint_draw(benchmark::State& state, const BenchView* view, BenchRLEKernels kernels)
+{
+    auto previousKernels = BenchRLEKernels{ rle_remap_fn, rle_remap_dst_fn, rle_blend_fn };
+    rle_remap_fn = kernels.Remap;
+    rle_remap_dst_fn = kernels.RemapDst;
+    rle_blend_fn = kernels.Blend;
+
+    std::vector<paint_session*> sessions;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        AllocateSessions(*view, sessions);
+        for (auto session : sessions)
+        {
+            PaintSessionGenerate(session);
+            PaintSessionArrange(session);
+        }
+        state.ResumeTiming();
+        for (auto session : sessions)
+        {
+            PaintDrawStructs(session);
+        }
+        state.PauseTiming();
+        FreeSessions(sessions);
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * view->Columns.size());
+
+    rle_remap_fn = previousKernels.Remap;
+    rle_remap_dst_fn = previousKernels.RemapDst;
+    rle_blend_fn = previousKernels.Blend;
+}
+
+static void BM_viewport_render(benchmark::State& state, const BenchView* view)
+{
+    auto dpi = view->DPI;
+    for (auto _ : state)
+    {
+        viewport_render(&dpi, &view->Viewport, 0, 0, view->Viewport.width, view->Viewport.height);
+        benchmark::DoNotOptimize(dpi.bits);
+    }
+    state.SetItemsProcessed(state.iterations() * BenchScreenWidth * BenchScreenHeight);
+}
+
+static constexpr const char* BenchStrings[] = {
+    "Park rating: 999",
+    "The quick brown fox jumps over the lazy dog",
+    "Guests in park: 1,234 - Cash: $12,345.00",
+    "{WINDOW_COLOUR_2}Excitement rating: {BLACK}6.45 (High)",
+};
+
+static void BM_text_draw(benchmark::State& state, const BenchView* view)
+{
+    auto dpi = view->DPI;
+    for (auto _ : state)
+    {
+        for (int32_t y = 0; y < BenchScreenHeight; y += 12)
+        {
+            gfx_draw_string(&dpi, { 4, y }, BenchStrings[(y / 12) % std::size(BenchStrings)], { COLOUR_BLACK });
+        }
+        benchmark::DoNotOptimize(dpi.bits);
+    }
+    state.SetItemsProcessed(state.iterations() * (BenchScreenHeight / 12));
+}
+
+static void BM_text_width(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        int32_t width = 0;
+        for (auto text : BenchStrings)
+        {
+            width += gfx_get_string_width(text, FontSpriteBase::MEDIUM);
+        }
+        benchmark::DoNotOptimize(width);
+    }
+    state.SetItemsProcessed(state.iterations() * std::size(BenchStrings));
+}
+
+static int CmdlineForBenchGfxSuite(int argc, const char** argv)
+{
+    if (argc < 1 || !Platform::FileExists(argv[0]))
+    {
+        log_error("Expected a park to render as the first argument");
+        return -1;
+    }
+
+    core_init();
+    gOpenRCT2Headless = true;
+    auto context = CreateContext();
+    if (!context->Initialise())
+    {
+        log_error("Failed to initialise context");
+        return -1;
+    }
+    drawing_engine_init();
+    if (!context->LoadParkFromFile(argv[0]))
+    {
+        log_error("Failed to load park");
+        drawing_engine_dispose();
+        return -1;
+    }
+    gIntroState = IntroState::None;
+    gScreenFlags = SCREEN_FLAGS_PLAYING;
+
+    // Ensure sprites appear regardless of rotation
+    reset_all_sprite_quadrant_placements();
+
+    X8DrawingEngine drawingEngine(context->GetUiContext());
+    std::vector<std::unique_ptr<BenchView>> views;
+    for (int32_t zoom = 0; zoom <= ZoomLevel::max(); zoom++)
+    {
+        views.push_back(CreateBenchView(zoom, &drawingEngine));
+        const auto* view = views.back().get();
+        auto prefix = "zoom" + std::to_string(zoom) + "/";
+        benchmark::RegisterBenchmark((prefix + "paint_generate").c_str(), BM_paint_generate, view);
+        benchmark::RegisterBenchmark((prefix + "paint_arrange").c_str(), BM_paint_arrange, view);
+        benchmark::RegisterBenchmark(
+            (prefix + "paint_draw/scalar").c_str(), BM_paint_draw, view,
+            BenchRLEKernels{ rle_remap_scalar, rle_remap_dst_scalar, rle_blend_scalar });
+        if (sse41_available())
+        {
+            benchmark::RegisterBenchmark(
+                (prefix + "paint_draw/sse4_1").c_str(), BM_paint_draw, view,
+                BenchRLEKernels{ rle_remap_sse4_1, rle_remap_dst_sse4_1, rle_blend_scalar });
+        }
+        if (avx2_available())
+        {
+            benchmark::RegisterBenchmark(
+                (prefix + "paint_draw/avx2").c_str(), BM_paint_draw, view,
+                BenchRLEKernels{ rle_remap_avx2, rle_remap_dst_avx2, rle_blend_avx2 });
+        }
+        benchmark::RegisterBenchmark((prefix + "viewport_render").c_str(), BM_viewport_render, view);
+    }
+    benchmark::RegisterBenchmark("text_draw", BM_text_draw, views.front().get());
+    benchmark::RegisterBenchmark("text_width", BM_text_width);
+
+    auto result = RunBenchmarks(argc - 1, argv + 1);
+    drawing_engine_dispose();
+    return result;
+}
+
+static exitcode_t HandleBenchGfxSuite(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = CmdlineForBenchGfxSuite(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+static exitcode_t HandleBenchGfxKernels(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = CmdlineForBenchGfxKernels(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchGfxKernels(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+
+static exitcode_t HandleBenchGfxSuite(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK
+
 static exitcode_t HandleBenchGfx(CommandLineArgEnumerator* argEnumerator);
 
 const CommandLineCommand CommandLine::BenchGfxCommands[]{
     // Main commands
-    DefineCommand("", "<file> [iterations count]", nullptr, HandleBenchGfx), CommandTableEnd
+    DefineCommand("", "<file> [iterations count]", nullptr, HandleBenchGfx),
+    DefineCommand("kernels", "[--benchmark_filter=<regex>] [--benchmark_min_time=<min_time>]", nullptr, HandleBenchGfxKernels),
+    DefineCommand(
+        "suite",
+        "<file> [--benchmark_filter=<regex>] [--benchmark_min_time=<min_time>] [--benchmark_format=<console|json|csv>] "
+        "[--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>]",
+        nullptr, HandleBenchGfxSuite),
+    CommandTableEnd
 };
 
 static exitcode_t HandleBenchGfx(CommandLineArgEnumerator* argEnumerator)
@@ -0,0 +1,178 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#ifdef USE_BENCHMARK
+
+#    include "../Context.h"
+#    include "../OpenRCT2.h"
+#    include "../peep/GuestPathfinding.h"
+#    include "../peep/Peep.h"
+#    include "../platform/Platform2.h"
+#    include "../platform/platform.h"
+#    include "../scenario/Scenario.h"
+#    include "../world/EntityList.h"
+
+#    include <algorithm>
+#    include <benchmark/benchmark.h>
+#    include <chrono>
+#    include <cstdint>
+#    include <vector>
+
+using namespace OpenRCT2;
+
+static double GetPercentile(std::vector<double>& values, double percentile)
+{
+    if (values.empty())
+        return 0;
+
+    auto index = static_cast<size_t>(percentile * (values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+/**
+ * Runs guest_path_finding once for every guest walking on a footpath, the guests and the random
+ * state are restored afterwards so every iteration does the same searches. The shared pathfinding
+ * results are dropped at the start of each iteration, as they are after the map has been edited.
+ */
+static void BM_guest_path_finding(benchmark::State& state, const std::string& filename)
+{
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        state.SkipWithError("Context initialization failed.");
+        return;
+    }
+    if (!context->LoadParkFromFile(filename))
+    {
+        state.SkipWithError("Failed to load file!");
+        return;
+    }
+
+    std::vector<Guest*> guests;
+    for (auto guest : EntityList<Guest>())
+    {
+        if (guest->State == PeepState::Walking && guest->x != LOCATION_NULL && !guest->GetNextIsSurface())
+        {
+            guests.push_back(guest);
+        }
+    }
+    if (guests.empty())
+    {
+        state.SkipWithError("Park has no guests walking on footpaths!");
+        return;
+    }
+
+    std::vector<double> guestTimes;
+    gPathfindStatistics = {};
+    for (auto _ : state)
+    {
+        PathfindCacheInvalidate();
+        for (auto guest : guests)
+        {
+            auto guestBackup = *guest;
+            auto randBackup = scenario_rand_state();
+
+            auto begin = std::chrono::high_resolution_clock::now();
+            guest_path_finding(guest);
+            auto end = std::chrono::high_resolution_clock::now();
+            guestTimes.push_back(std::chrono::duration<double, std::micro>(end - begin).count());
+
+            *guest = guestBackup;
+            scenario_rand_seed(randBackup.s0, randBackup.s1);
+        }
+    }
+
+    const auto& stats = gPathfindStatistics;
+    const auto numCalls = static_cast<double>(std::max<uint64_t>(stats.ChooseDirectionCalls, 1));
+    const auto numSearches = static_cast<double>(std::max<uint64_t>(stats.EdgeSearches, 1));
+    state.SetItemsProcessed(state.iterations() * guests.size());
+    state.counters["Guests"] = static_cast<double>(guests.size());
+    state.counters["ChooseDirectionCalls"] = benchmark::Counter(
+        static_cast<double>(stats.ChooseDirectionCalls), benchmark::Counter::kIsRate);
+    state.counters["EdgeSearchesPerCall"] = (stats.EdgeSearches + stats.CachedEdgeSearches) / numCalls;
+    state.counters["CachedEdgeSearchesPerCall"] = stats.CachedEdgeSearches / numCalls;
+    state.counters["TilesPerEdgeSearch"] = stats.TilesChecked / numSearches;
+    state.counters["GuestP50_us"] = GetPercentile(guestTimes, 0.50);
+    state.counters["GuestP90_us"] = GetPercentile(guestTimes, 0.90);
+    state.counters["GuestP99_us"] = GetPercentile(guestTimes, 0.99);
+    state.counters["GuestMax_us"] = GetPercentile(guestTimes, 1.0);
+}
+
+static int CmdlineForBenchPathfinding(int argc, const char* const* argv)
+{
+    // Google benchmark does stuff to argv. It doesn't modify the pointees,
+    // but it wants to reorder the pointers, so present a copy of them.
+    std::vector<char*> argv_for_benchmark;
+
+    // argv[0] is expected to contain the binary name. It's only for logging purposes, don't bother.
+    argv_for_benchmark.push_back(nullptr);
+
+    // Extract file names from argument list. If there is no such file, consider it benchmark option.
+    for (int i = 0; i < argc; i++)
+    {
+        if (Platform::FileExists(argv[i]))
+        {
+            // Register benchmark for park if valid
+            benchmark::RegisterBenchmark(argv[i], BM_guest_path_finding, argv[i]);
+        }
+        else
+        {
+            argv_for_benchmark.push_back(const_cast<char*>(argv[i]));
+        }
+    }
+    // Update argc with all the changes made
+    argc = static_cast<int>(argv_for_benchmark.size());
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+
+    core_init();
+    gOpenRCT2Headless = true;
+
+    ::benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
+
+static exitcode_t HandleBenchPathfinding(CommandLineArgEnumerator* argEnumerator)
+{
+    const char* const* argv = static_cast<const char* const*>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = CmdlineForBenchPathfinding(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchPathfinding(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK
+
+const CommandLineCommand CommandLine::BenchPathfindingCommands[]{
+#ifdef USE_BENCHMARK
+    DefineCommand(
+        "",
+        "<file>... [--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] [--benchmark_min_time=<min_time>] "
+        "[--benchmark_repetitions=<num_repetitions>] [--benchmark_report_aggregates_only={true|false}] "
+        "[--benchmark_format=<console|json|csv>] [--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] "
+        "[--benchmark_color={auto|true|false}] [--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
+        nullptr, HandleBenchPathfinding),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchPathfinding), CommandTableEnd
+#endif // USE_BENCHMARK
+};
@@ -0,0 +1,278 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#if defined(USE_BENCHMARK) && defined(ENABLE_SCRIPTING)
+
+#    include "../Context.h"
+#    include "../OpenRCT2.h"
+#    include "../platform/Platform2.h"
+#    include "../platform/platform.h"
+#    include "../scripting/HookEngine.h"
+#    include "../scripting/Plugin.h"
+#    include "../scripting/ScriptEngine.h"
+
+#    include <algorithm>
+#    include <benchmark/benchmark.h>
+#    include <cstdint>
+#    include <stdexcept>
+#    include <vector>
+
+using namespace OpenRCT2;
+using namespace OpenRCT2::Scripting;
+
+struct ScriptWorkload
+{
+    const char* Name;
+    // Function run once before the measurements
+    const char* Setup;
+    // Function run on every iteration, it returns the number of items it processed. The interval.tick hooks
+    // are called instead when there is none.
+    const char* Iteration;
+};
+
+// clang-format off
+static constexpr const ScriptWorkload Workloads[] = {
+    {
+        "guests",
+        nullptr,
+        "(function() {"
+        "    var guests = map.getAllEntities('peep');"
+        "    var total = 0;"
+        "    for (var i = 0; i < guests.length; i++) {"
+        "        var guest = guests[i];"
+        "        total += guest.x + guest.y + guest.happiness + guest.energy;"
+        "    }"
+        "    return guests.length;"
+        "})",
+    },
+    {
+        "guestdata",
+        nullptr,
+        "(function() {"
+        "    var guests = map.getGuestData();"
+        "    var total = 0;"
+        "    for (var i = 0; i < guests.count; i++) {"
+        "        total += guests.x[i] + guests.y[i] + guests.happiness[i] + guests.energy[i];"
+        "    }"
+        "    return guests.count;"
+        "})",
+    },
+    {
+        "tiles",
+        nullptr,
+        "(function() {"
+        "    var count = 0;"
+        "    var total = 0;"
+        "    for (var y = 16; y < 48; y++) {"
+        "        for (var x = 16; x < 48; x++) {"
+        "            var elements = map.getTile(x, y).elements;"
+        "            for (var i = 0; i < elements.length; i++) {"
+        "                total += elements[i].baseHeight + elements[i].type.length;"
+        "            }"
+        "            count += elements.length;"
+        "        }"
+        "    }"
+        "    return count;"
+        "})",
+    },
+    {
+        "tick",
+        "(function() {"
+        "    for (var i = 0; i < 10; i++) {"
+        "        context.subscribe('interval.tick', function() {});"
+        "    }"
+        "})",
+        nullptr,
+    },
+    {
+        "actions",
+        nullptr,
+        "(function() {"
+        "    var name = park.name;"
+        "    for (var i = 0; i < 100; i++) {"
+        "        context.executeAction('parksetname', { name: name }, function() {});"
+        "    }"
+        "    return 100;"
+        "})",
+    },
+};
+
+static constexpr const char* BenchPluginCode =
+    "registerPlugin({"
+    "    name: 'benchscripting',"
+    "    version: '1.0',"
+    "    authors: [],"
+    "    type: 'local',"
+    "    licence: 'MIT',"
+    "    main: function() {}"
+    "});";
+// clang-format on
+
+static DukValue CompileFunction(duk_context* ctx, const char* code)
+{
+    if (duk_peval_string(ctx, code) != 0)
+    {
+        std::string error = duk_safe_to_string(ctx, -1);
+        duk_pop(ctx);
+        throw std::runtime_error(error);
+    }
+    return DukValue::take_from_stack(ctx);
+}
+
+/**
+ * Runs a plugin workload on a park, reporting the items the script processed per second and the
+ * allocations made by the script heap.
+ */
+static void BM_scripting(benchmark::State& state, const std::string& filename, const ScriptWorkload& workload)
+{
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        state.SkipWithError("Context initialization failed.");
+        return;
+    }
+    if (!context->LoadParkFromFile(filename))
+    {
+        state.SkipWithError("Failed to load file!");
+        return;
+    }
+
+    auto& scriptEngine = context->GetScriptEngine();
+    auto& hookEngine = scriptEngine.GetHookEngine();
+    // Registers the API, no plugins are loaded from the user directory
+    scriptEngine.Update();
+    auto ctx = scriptEngine.GetContext();
+
+    auto plugin = std::make_shared<Plugin>(ctx, std::string());
+    DukValue iteration;
+    try
+    {
+        ScriptExecutionInfo::PluginScope scope(scriptEngine.GetExecInfo(), plugin, false);
+        plugin->SetCode(BenchPluginCode);
+        plugin->Load();
+        plugin->Start();
+
+        if (workload.Setup != nullptr)
+        {
+            scriptEngine.ExecutePluginCall(plugin, CompileFunction(ctx, workload.Setup), {}, true);
+        }
+        if (workload.Iteration != nullptr)
+        {
+            iteration = CompileFunction(ctx, workload.Iteration);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        state.SkipWithError(e.what());
+        return;
+    }
+
+    const auto& tickTiming = plugin->GetProfile().Hooks[static_cast<size_t>(HOOK_TYPE::INTERVAL_TICK)];
+    const auto numTickCalls = tickTiming.Count;
+    const auto numAllocations = GetNumHeapAllocations(ctx);
+    int64_t numItems = 0;
+    for (auto _ : state)
+    {
+        if (workload.Iteration != nullptr)
+        {
+            auto result = scriptEngine.ExecutePluginCall(plugin, iteration, {}, true);
+            numItems += result.type() == DukValue::Type::NUMBER ? result.as_int() : 0;
+        }
+        else
+        {
+            hookEngine.Call(HOOK_TYPE::INTERVAL_TICK, true);
+        }
+    }
+    numItems += static_cast<int64_t>(tickTiming.Count - numTickCalls);
+
+    const auto iterations = static_cast<double>(std::max<benchmark::IterationCount>(state.iterations(), 1));
+    const auto allocations = static_cast<double>(GetNumHeapAllocations(ctx) - numAllocations);
+    state.SetItemsProcessed(numItems);
+    state.counters["Calls"] = benchmark::Counter(static_cast<double>(numItems), benchmark::Counter::kIsRate);
+    state.counters["AllocationsPerIteration"] = allocations / iterations;
+    state.counters["AllocationsPerCall"] = allocations / static_cast<double>(std::max<int64_t>(numItems, 1));
+
+    hookEngine.UnsubscribeAll(plugin);
+}
+
+static int CmdlineForBenchScripting(int argc, const char* const* argv)
+{
+    // Google benchmark does stuff to argv. It doesn't modify the pointees,
+    // but it wants to reorder the pointers, so present a copy of them.
+    std::vector<char*> argv_for_benchmark;
+
+    // argv[0] is expected to contain the binary name. It's only for logging purposes, don't bother.
+    argv_for_benchmark.push_back(nullptr);
+
+    // Extract file names from argument list. If there is no such file, consider it benchmark option.
+    for (int i = 0; i < argc; i++)
+    {
+        if (Platform::FileExists(argv[i]))
+        {
+            // Register the workloads for park if valid
+            for (const auto& workload : Workloads)
+            {
+                auto name = std::string(argv[i]) + "/" + workload.Name;
+                benchmark::RegisterBenchmark(name.c_str(), BM_scripting, std::string(argv[i]), workload);
+            }
+        }
+        else
+        {
+            argv_for_benchmark.push_back(const_cast<char*>(argv[i]));
+        }
+    }
+    // Update argc with all the changes made
+    argc = static_cast<int>(argv_for_benchmark.size());
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+
+    core_init();
+    gOpenRCT2Headless = true;
+
+    ::benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
+
+static exitcode_t HandleBenchScripting(CommandLineArgEnumerator* argEnumerator)
+{
+    const char* const* argv = static_cast<const char* const*>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = CmdlineForBenchScripting(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchScripting(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark or scripting not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK && ENABLE_SCRIPTING
+
+const CommandLineCommand CommandLine::BenchScriptingCommands[]{
+#if defined(USE_BENCHMARK) && defined(ENABLE_SCRIPTING)
+    DefineCommand(
+        "",
+        "<file>... [--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] [--benchmark_min_time=<min_time>] "
+        "[--benchmark_repetitions=<num_repetitions>] [--benchmark_report_aggregates_only={true|false}] "
+        "[--benchmark_format=<console|json|csv>] [--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] "
+        "[--benchmark_color={auto|true|false}] [--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
+        nullptr, HandleBenchScripting),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchScripting), CommandTableEnd
+#endif // USE_BENCHMARK && ENABLE_SCRIPTING
+};
@@ -32,44 +32,35 @@
 #    include <benchmark/benchmark.h>
 #    include <cstdint>
 #    include <iterator>
+#    include <string>
 #    include <vector>
 
-static void fixup_pointers(paint_session* s, size_t paint_session_entries, size_t paint_struct_entries, size_t quadrant_entries)
+static void fixup_pointers(std::vector<RecordedPaintSession>& sessions)
 {
-    for (size_t i = 0; i < paint_session_entries; i++)
+    for (auto& recorded : sessions)
     {
-        for (size_t j = 0; j < paint_struct_entries; j++)
+        auto& entries = recorded.Entries;
+        auto getPointer = [&entries](paint_struct* ps) -> paint_struct* {
+            auto index = reinterpret_cast<size_t>(ps);
+            return index < entries.size() ? &entries[index].basic : nullptr;
+        };
+        for (auto& entry : entries)
         {
-            if (s[i].PaintStructs[j].basic.next_quadrant_ps == reinterpret_cast<paint_struct*>(paint_struct_entries))
-            {
-                s[i].PaintStructs[j].basic.next_quadrant_ps = nullptr;
-            }
-            else
-            {
-                auto nextQuadrantPs = reinterpret_cast<uintptr_t>(s[i].PaintStructs[j].basic.next_quadrant_ps);
-                s[i].PaintStructs[j].basic.next_quadrant_ps = &s[i].PaintStructs[nextQuadrantPs].basic;
-            }
+            entry.basic.next_quadrant_ps = getPointer(entry.basic.next_quadrant_ps);
         }
-        for (size_t j = 0; j < quadrant_entries; j++)
+        for (auto& quad : recorded.Session.Quadrants)
         {
-            if (s[i].Quadrants[j] == reinterpret_cast<paint_struct*>(quadrant_entries))
-            {
-                s[i].Quadrants[j] = nullptr;
-            }
-            else
-            {
-                s[i].Quadrants[j] = &s[i].PaintStructs[reinterpret_cast<size_t>(s[i].Quadrants[j])].basic;
-            }
+            quad = getPointer(quad);
         }
     }
 }
 
-static std::vector<paint_session> extract_paint_session(const std::string parkFileName)
+static std::vector<RecordedPaintSession> extract_paint_session(const std::string parkFileName)
 {
     core_init();
     gOpenRCT2Headless = true;
     auto context = OpenRCT2::CreateContext();
-    std::vector<paint_session> sessions;
+    std::vector<RecordedPaintSession> sessions;
     log_info("Starting...");
     if (context->Initialise())
     {
@@ -133,41 +124,37 @@ static std::vector<paint_session> extract_paint_session(const std::string parkFi
 }
 
 // This function is based on benchgfx_render_screenshots
-static void BM_paint_session_arrange(benchmark::State& state, const std::vector<paint_session> inputSessions)
+static void BM_paint_session_arrange(
+    benchmark::State& state, const std::vector<RecordedPaintSession> inputSessions, void (*arrange)(paint_session*))
 {
-    std::vector<paint_session> sessions = inputSessions;
+    std::vector<RecordedPaintSession> sessions = inputSessions;
     // Fixing up the pointers continuously is wasteful. Fix it up once for `sessions` and store a copy.
-    // Keep in mind we need bit-exact copy, as the lists use pointers.
-    // Once sorted, just restore the copy with the original fixed-up version.
-    paint_session* local_s = new paint_session[std::size(sessions)];
-    fixup_pointers(&sessions[0], std::size(sessions), std::size(local_s->PaintStructs), std::size(local_s->Quadrants));
-    std::copy_n(sessions.cbegin(), std::size(sessions), local_s);
+    // Keep in mind we need bit-exact copy, as the lists use pointers into the entries of `sessions`.
+    // Once sorted, just restore the copy in place with the original fixed-up version.
+    fixup_pointers(sessions);
+    const std::vector<RecordedPaintSession> local_s = sessions;
     for (auto _ : state)
     {
         state.PauseTiming();
-        std::copy_n(local_s, std::size(sessions), sessions.begin());
+        for (size_t i = 0; i < std::size(sessions); i++)
+        {
+            sessions[i].Session = local_s[i].Session;
+            std::copy(local_s[i].Entries.begin(), local_s[i].Entries.end(), sessions[i].Entries.begin());
+        }
         state.ResumeTiming();
-        PaintSessionArrange(&sessions[0]);
+        arrange(&sessions[0].Session);
         benchmark::DoNotOptimize(sessions);
     }
     state.SetItemsProcessed(state.iterations() * std::size(sessions));
-    delete[] local_s;
 }
 
 static int cmdline_for_bench_sprite_sort(int argc, const char** argv)
 {
     {
-        // Register some basic "baseline" benchmark
-        std::vector<paint_session> sessions(1);
-        for (auto& ps : sessions[0].PaintStructs)
-        {
-            ps.basic.next_quadrant_ps = reinterpret_cast<paint_struct*>((std::size(sessions[0].PaintStructs)));
-        }
-        for (auto& quad : sessions[0].Quadrants)
-        {
-            quad = reinterpret_cast<paint_struct*>((std::size(sessions[0].Quadrants)));
-        }
-        benchmark::RegisterBenchmark("baseline", BM_paint_session_arrange, sessions);
+        // Register some basic "baseline" benchmark, a session without any entries
+        std::vector<RecordedPaintSession> sessions(1);
+        benchmark::RegisterBenchmark("baseline", BM_paint_session_arrange, sessions, PaintSessionArrange);
+        benchmark::RegisterBenchmark("baseline/linked", BM_paint_session_arrange, sessions, PaintSessionArrangeLinked);
     }
 
     // Google benchmark does stuff to argv. It doesn't modify the pointees,
@@ -183,9 +170,15 @@ static int cmdline_for_bench_sprite_sort(int argc, const char** argv)
         if (Platform::FileExists(argv[i]))
         {
             // Register benchmark for sv6 if valid
-            std::vector<paint_session> sessions = extract_paint_session(argv[i]);
+            std::vector<RecordedPaintSession> sessions = extract_paint_session(argv[i]);
             if (!sessions.empty())
-                benchmark::RegisterBenchmark(argv[i], BM_paint_session_arrange, sessions);
+            {
+                // Compare the sort key path with the original linked list one on the same sessions
+                benchmark::RegisterBenchmark(argv[i], BM_paint_session_arrange, sessions, PaintSessionArrange);
+                benchmark::RegisterBenchmark(
+                    (std::string(argv[i]) + "/linked").c_str(), BM_paint_session_arrange, sessions,
+                    PaintSessionArrangeLinked);
+            }
         }
         else
         {
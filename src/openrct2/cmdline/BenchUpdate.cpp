@@ -9,11 +9,27 @@
 
 #include "CommandLine.hpp"
 
+#include "../Context.h"
+#include "../GameState.h"
+#include "../OpenRCT2.h"
+#include "../core/Console.hpp"
+#include "../core/Json.hpp"
+#include "../core/Path.hpp"
+#include "../platform/platform.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 #ifdef USE_BENCHMARK
 
 #    include "../Context.h"
 #    include "../GameState.h"
 #    include "../OpenRCT2.h"
+#    include "../peep/Peep.h"
 #    include "../platform/Platform2.h"
 #    include "../platform/platform.h"
 
@@ -87,10 +103,52 @@ static void BM_update(benchmark::State& state, const std::string& filename)
     }
 }
 
+struct BenchPeepAnimation
+{
+    PeepSpriteType SpriteType;
+    PeepActionSpriteType ActionSpriteType;
+    uint8_t ActionFrame;
+    uint8_t ActionSpriteImageOffset;
+    rct_sprite_bounds Bounds;
+};
+
+// The animation part of Peep::UpdateAction for a crowd of every sprite type, moving on to another action whenever
+// one ends the way UpdateCurrentActionSpriteType does
+static void BM_peep_animation(benchmark::State& state)
+{
+    std::vector<BenchPeepAnimation> peeps(static_cast<size_t>(state.range(0)));
+    for (size_t i = 0; i < peeps.size(); i++)
+    {
+        peeps[i] = { static_cast<PeepSpriteType>(i % EnumValue(PeepSpriteType::Count)),
+                     static_cast<PeepActionSpriteType>((i * 7) % PeepActionSpriteTypeCount), 0, 0, {} };
+    }
+
+    for (auto _ : state)
+    {
+        for (auto& peep : peeps)
+        {
+            const auto* animation = &GetPeepAnimation(peep.SpriteType, peep.ActionSpriteType);
+            peep.ActionFrame++;
+            if (peep.ActionFrame >= animation->num_frames)
+            {
+                peep.ActionFrame = 0;
+                peep.ActionSpriteType = static_cast<PeepActionSpriteType>(
+                    (EnumValue(peep.ActionSpriteType) + 1) % PeepActionSpriteTypeCount);
+                animation = &GetPeepAnimation(peep.SpriteType, peep.ActionSpriteType);
+                peep.Bounds = animation->bounds;
+            }
+            peep.ActionSpriteImageOffset = animation->frame_offsets[peep.ActionFrame];
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
 static int CmdlineForBenchSpriteSort(int argc, const char* const* argv)
 {
     // Add a baseline test on an empty park
     benchmark::RegisterBenchmark("baseline", BM_update, std::string{});
+    benchmark::RegisterBenchmark("peep_animation", BM_peep_animation)->Arg(1000)->Arg(10000);
 
     // Google benchmark does stuff to argv. It doesn't modify the pointees,
     // but it wants to reorder the pointers, so present a copy of them.
@@ -145,6 +203,217 @@ static exitcode_t HandleBenchUpdate(CommandLineArgEnumerator* argEnumerator)
 }
 #endif // USE_BENCHMARK
 
+using namespace OpenRCT2;
+
+// Ticks run before measuring, so the first ticks after loading do not count
+static constexpr uint32_t BenchCorpusWarmupTicks = 100;
+static constexpr uint32_t BenchCorpusDefaultTicks = 1000;
+static constexpr size_t BenchCorpusPartCount = static_cast<size_t>(LogicTimePart::Scripts) + 1;
+static constexpr const char* BenchCorpusTotal = "Total";
+
+// Phases faster than this on average are left out of comparisons, their differences are mostly noise
+static constexpr double BenchCompareMinimumMs = 0.01;
+static constexpr int32_t BenchCompareDefaultThreshold = 10;
+
+static json_t GetSampleStatistics(std::vector<double>& samples)
+{
+    double mean = 0;
+    double p95 = 0;
+    if (!samples.empty())
+    {
+        for (auto sample : samples)
+        {
+            mean += sample;
+        }
+        mean /= samples.size();
+
+        std::sort(samples.begin(), samples.end());
+        p95 = samples[std::min(samples.size() - 1, (samples.size() * 95) / 100)];
+    }
+    return { { "mean_ms", mean }, { "p95_ms", p95 } };
+}
+
+static json_t RunCorpusPark(IContext& context, const std::string& name, const std::string& path, uint32_t ticks)
+{
+    Console::WriteLine("Running %s for %u ticks...", name.c_str(), ticks);
+    if (!context.LoadParkFromFile(path))
+    {
+        throw std::runtime_error("Failed to load " + path);
+    }
+
+    auto gameState = context.GetGameState();
+    for (uint32_t i = 0; i < BenchCorpusWarmupTicks; i++)
+    {
+        gameState->UpdateLogic();
+    }
+
+    // The timings are the time since the start of the tick at the end of each phase, a phase that is not reached
+    // in a tick is left negative.
+    LogicTimings timings;
+    std::vector<std::vector<double>> samples(BenchCorpusPartCount + 1);
+    for (auto& partSamples : samples)
+    {
+        partSamples.reserve(ticks);
+    }
+    for (uint32_t i = 0; i < ticks; i++)
+    {
+        auto index = timings.CurrentIdx;
+        for (size_t part = 0; part < BenchCorpusPartCount; part++)
+        {
+            timings.TimingInfo[static_cast<LogicTimePart>(part)][index] = std::chrono::duration<double>(-1);
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        gameState->UpdateLogic(&timings);
+        std::chrono::duration<double, std::milli> total = std::chrono::high_resolution_clock::now() - start;
+
+        double previousMs = 0;
+        for (size_t part = 0; part < BenchCorpusPartCount; part++)
+        {
+            auto endMs = std::chrono::duration<double, std::milli>(timings.TimingInfo[static_cast<LogicTimePart>(part)][index])
+                             .count();
+            if (endMs < 0)
+            {
+                samples[part].push_back(0);
+                continue;
+            }
+            samples[part].push_back(endMs - previousMs);
+            previousMs = endMs;
+        }
+        samples[BenchCorpusPartCount].push_back(total.count());
+    }
+
+    json_t phases = json_t::object();
+    for (size_t part = 0; part < BenchCorpusPartCount; part++)
+    {
+        phases[GetLogicTimePartName(static_cast<LogicTimePart>(part))] = GetSampleStatistics(samples[part]);
+    }
+    phases[BenchCorpusTotal] = GetSampleStatistics(samples[BenchCorpusPartCount]);
+    return { { "name", name }, { "path", path }, { "ticks", ticks }, { "phases", phases } };
+}
+
+static exitcode_t HandleBenchUpdateCorpus(CommandLineArgEnumerator* argEnumerator)
+{
+    const char* manifestPath = nullptr;
+    if (!argEnumerator->TryPopString(&manifestPath))
+    {
+        Console::Error::WriteLine("Expected a corpus manifest.");
+        return EXITCODE_FAIL;
+    }
+    const char* outputPath = nullptr;
+    argEnumerator->TryPopString(&outputPath);
+
+    try
+    {
+        auto manifest = Json::ReadFromFile(manifestPath);
+        auto manifestDirectory = Path::GetDirectory(Path::GetAbsolute(manifestPath));
+
+        core_init();
+        gOpenRCT2Headless = true;
+        // Like a headless server, unless the manifest asks to time the presentation work as well
+        auto presentation = Json::GetBoolean(manifest["presentation"]);
+        gOpenRCT2NoPresentation = !presentation;
+        std::unique_ptr<IContext> context(CreateContext());
+        if (!context->Initialise())
+        {
+            throw std::runtime_error("Context initialization failed.");
+        }
+
+        json_t parks = json_t::array();
+        for (const auto& park : manifest["parks"])
+        {
+            auto name = Json::GetString(park["name"]);
+            auto path = Path::Combine(manifestDirectory, Json::GetString(park["path"]));
+            auto ticks = Json::GetNumber<uint32_t>(park["ticks"], BenchCorpusDefaultTicks);
+            parks.push_back(RunCorpusPark(*context, name.empty() ? path : name, path, ticks));
+        }
+
+        json_t result = { { "warmup_ticks", BenchCorpusWarmupTicks }, { "presentation", presentation }, { "parks", parks } };
+        if (outputPath != nullptr)
+        {
+            Json::WriteToFile(outputPath, result);
+        }
+        else
+        {
+            Console::WriteLine("%s", result.dump(4).c_str());
+        }
+    }
+    catch (const std::exception& e)
+    {
+        Console::Error::WriteLine("%s", e.what());
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+static exitcode_t HandleBenchUpdateCompare(CommandLineArgEnumerator* argEnumerator)
+{
+    const char* baselinePath = nullptr;
+    const char* currentPath = nullptr;
+    if (!argEnumerator->TryPopString(&baselinePath) || !argEnumerator->TryPopString(&currentPath))
+    {
+        Console::Error::WriteLine("Expected a baseline and a current result file.");
+        return EXITCODE_FAIL;
+    }
+    int32_t threshold = BenchCompareDefaultThreshold;
+    argEnumerator->TryPopInteger(&threshold);
+
+    size_t regressions = 0;
+    try
+    {
+        auto baseline = Json::ReadFromFile(baselinePath);
+        auto current = Json::ReadFromFile(currentPath);
+        for (const auto& park : current["parks"])
+        {
+            auto name = Json::GetString(park["name"]);
+            auto baselinePark = std::find_if(baseline["parks"].begin(), baseline["parks"].end(), [&name](const json_t& p) {
+                return Json::GetString(p["name"]) == name;
+            });
+            if (baselinePark == baseline["parks"].end())
+            {
+                Console::WriteLine("%s: not in the baseline", name.c_str());
+                continue;
+            }
+
+            const auto& baselinePhases = (*baselinePark)["phases"];
+            for (const auto& [phase, statistics] : park["phases"].items())
+            {
+                if (!baselinePhases.contains(phase))
+                    continue;
+
+                auto before = Json::GetNumber<double>(baselinePhases[phase]["mean_ms"]);
+                auto after = Json::GetNumber<double>(statistics["mean_ms"]);
+                auto beforeP95 = Json::GetNumber<double>(baselinePhases[phase]["p95_ms"]);
+                auto afterP95 = Json::GetNumber<double>(statistics["p95_ms"]);
+                if (std::max(before, after) < BenchCompareMinimumMs)
+                    continue;
+
+                auto change = before > 0 ? ((after - before) / before) * 100 : 100;
+                bool regressed = change > threshold;
+                if (regressed)
+                {
+                    regressions++;
+                }
+                Console::WriteLine(
+                    "%s %-30s mean %8.3f -> %8.3f ms (%+6.1f%%)  p95 %8.3f -> %8.3f ms%s", name.c_str(), phase.c_str(), before,
+                    after, change, beforeP95, afterP95, regressed ? "  REGRESSION" : "");
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        Console::Error::WriteLine("%s", e.what());
+        return EXITCODE_FAIL;
+    }
+
+    if (regressions != 0)
+    {
+        Console::WriteLine("%zu phases are more than %d%% slower", regressions, threshold);
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
 const CommandLineCommand CommandLine::BenchUpdateCommands[]{
 #ifdef USE_BENCHMARK
     DefineCommand(
@@ -154,8 +423,10 @@ const CommandLineCommand CommandLine::BenchUpdateCommands[]{
         "[--benchmark_format=<console|json|csv>] [--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] "
         "[--benchmark_color={auto|true|false}] [--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
         nullptr, HandleBenchUpdate),
-    CommandTableEnd
 #else
-    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchUpdate), CommandTableEnd
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchUpdate),
 #endif // USE_BENCHMARK
+    DefineCommand("corpus", "<manifest> [<output>]", nullptr, HandleBenchUpdateCorpus),
+    DefineCommand("compare", "<baseline> <current> [<threshold %>]", nullptr, HandleBenchUpdateCompare),
+    CommandTableEnd
 };
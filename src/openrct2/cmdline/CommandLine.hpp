@@ -119,7 +119,11 @@ namespace CommandLine
     extern const CommandLineCommand BenchGfxCommands[];
     extern const CommandLineCommand BenchSpriteSortCommands[];
     extern const CommandLineCommand BenchUpdateCommands[];
+    extern const CommandLineCommand BenchPathfindingCommands[];
+    extern const CommandLineCommand BenchScriptingCommands[];
     extern const CommandLineCommand SimulateCommands[];
+    extern const CommandLineCommand SimulateBatchCommands[];
+    extern const CommandLineCommand ConvertBatchCommands[];
 
     extern const CommandLineExample RootExamples[];
 
@@ -7,58 +7,58 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include "../Context.h"
 #include "../FileClassifier.h"
 #include "../OpenRCT2.h"
 #include "../ParkImporter.h"
 #include "../common.h"
 #include "../core/Console.hpp"
+#include "../core/FileStream.h"
+#include "../core/Json.hpp"
 #include "../core/Path.hpp"
 #include "../interface/Window.h"
+#include "../platform/platform.h"
 #include "../rct2/S6Exporter.h"
+#include "BatchWorkers.h"
 #include "CommandLine.hpp"
 
+#include <algorithm>
 #include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 
 static void WriteConvertFromAndToMessage(uint32_t sourceFileType, uint32_t destinationFileType);
 static const utf8* GetFileTypeFriendlyName(uint32_t fileType);
+static exitcode_t HandleConvertBatch(CommandLineArgEnumerator* enumerator);
 
-exitcode_t CommandLine::HandleCommandConvert(CommandLineArgEnumerator* enumerator)
-{
-    exitcode_t result = CommandLine::HandleCommandDefault();
-    if (result != EXITCODE_CONTINUE)
-    {
-        return result;
-    }
-
-    // Get the source path
-    const utf8* rawSourcePath;
-    if (!enumerator->TryPopString(&rawSourcePath))
-    {
-        Console::Error::WriteLine("Expected a source path.");
-        return EXITCODE_FAIL;
-    }
-
-    utf8 sourcePath[MAX_PATH];
-    Path::GetAbsolute(sourcePath, sizeof(sourcePath), rawSourcePath);
-    uint32_t sourceFileType = get_file_extension_type(sourcePath);
+static int32_t _batchJobs;
+static bool _batchPark;
 
-    // Get the destination path
-    const utf8* rawDestinationPath;
-    if (!enumerator->TryPopString(&rawDestinationPath))
-    {
-        Console::Error::WriteLine("Expected a destination path.");
-        return EXITCODE_FAIL;
-    }
+// clang-format off
+static constexpr const CommandLineOptionDefinition ConvertBatchOptions[]
+{
+    { CMDLINE_TYPE_INTEGER, &_batchJobs, 'j', "jobs", "number of worker processes, defaults to the number of cores" },
+    { CMDLINE_TYPE_SWITCH,  &_batchPark, 'p', "park", "write .park files instead of .sc6 and .sv6 files"           },
+    OptionTableEnd
+};
+// clang-format on
 
-    utf8 destinationPath[MAX_PATH];
-    Path::GetAbsolute(destinationPath, sizeof(sourcePath), rawDestinationPath);
-    uint32_t destinationFileType = get_file_extension_type(destinationPath);
+const CommandLineCommand CommandLine::ConvertBatchCommands[]{
+    // Main commands
+    DefineCommand("", "<destination directory> <source>...", ConvertBatchOptions, HandleConvertBatch), CommandTableEnd
+};
 
+/**
+ * Returns why a file of the source type can not be converted to the destination type, or nullptr if it can.
+ */
+static const char* GetConvertError(uint32_t sourceFileType, uint32_t destinationFileType)
+{
     // Validate target type
-    if (destinationFileType != FILE_EXTENSION_SC6 && destinationFileType != FILE_EXTENSION_SV6)
+    if (destinationFileType != FILE_EXTENSION_SC6 && destinationFileType != FILE_EXTENSION_SV6
+        && destinationFileType != FILE_EXTENSION_PARK)
     {
-        Console::Error::WriteLine("Only conversion to .SC6 or .SV4 is supported.");
-        return EXITCODE_FAIL;
+        return "Only conversion to .SC6, .SV6 or .PARK is supported.";
     }
 
     // Validate the source type
@@ -66,31 +66,36 @@ exitcode_t CommandLine::HandleCommandConvert(CommandLineArgEnumerator* enumerato
     {
         case FILE_EXTENSION_SC4:
         case FILE_EXTENSION_SV4:
-            break;
+            return nullptr;
         case FILE_EXTENSION_SC6:
             if (destinationFileType == FILE_EXTENSION_SC6)
             {
-                Console::Error::WriteLine("File is already a RollerCoaster Tycoon 2 scenario.");
-                return EXITCODE_FAIL;
+                return "File is already a RollerCoaster Tycoon 2 scenario.";
             }
-            break;
+            return nullptr;
         case FILE_EXTENSION_SV6:
             if (destinationFileType == FILE_EXTENSION_SV6)
             {
-                Console::Error::WriteLine("File is already a RollerCoaster Tycoon 2 saved game.");
-                return EXITCODE_FAIL;
+                return "File is already a RollerCoaster Tycoon 2 saved game.";
+            }
+            return nullptr;
+        case FILE_EXTENSION_PARK:
+            if (destinationFileType == FILE_EXTENSION_PARK)
+            {
+                return "File is already an OpenRCT2 park.";
             }
-            break;
+            return nullptr;
         default:
-            Console::Error::WriteLine("Only conversion from .SC4, .SV4, .SC6 or .SV6 is supported.");
-            return EXITCODE_FAIL;
+            return "Only conversion from .SC4, .SV4, .SC6, .SV6 or .PARK is supported.";
     }
+}
 
-    // Perform conversion
-    WriteConvertFromAndToMessage(sourceFileType, destinationFileType);
-
-    gOpenRCT2Headless = true;
-
+/**
+ * Imports the park and saves it at the destination, returns what went wrong or an empty string.
+ */
+static std::string ConvertPark(
+    const utf8* sourcePath, uint32_t sourceFileType, const utf8* destinationPath, uint32_t destinationFileType)
+{
     try
     {
         auto importer = ParkImporter::Create(sourcePath);
@@ -99,8 +104,7 @@ exitcode_t CommandLine::HandleCommandConvert(CommandLineArgEnumerator* enumerato
     }
     catch (const std::exception& ex)
     {
-        Console::Error::WriteLine(ex.what());
-        return EXITCODE_FAIL;
+        return ex.what();
     }
 
     if (sourceFileType == FILE_EXTENSION_SC4 || sourceFileType == FILE_EXTENSION_SC6)
@@ -118,7 +122,12 @@ exitcode_t CommandLine::HandleCommandConvert(CommandLineArgEnumerator* enumerato
         window_close_by_class(WC_MAIN_WINDOW);
 
         exporter->Export();
-        if (destinationFileType == FILE_EXTENSION_SC6)
+        if (destinationFileType == FILE_EXTENSION_PARK)
+        {
+            auto fs = OpenRCT2::FileStream(destinationPath, OpenRCT2::FILE_MODE_WRITE);
+            exporter->SaveParkFile(&fs, false);
+        }
+        else if (destinationFileType == FILE_EXTENSION_SC6)
         {
             exporter->SaveScenario(destinationPath);
         }
@@ -129,7 +138,59 @@ exitcode_t CommandLine::HandleCommandConvert(CommandLineArgEnumerator* enumerato
     }
     catch (const std::exception& ex)
     {
-        Console::Error::WriteLine(ex.what());
+        return ex.what();
+    }
+    return {};
+}
+
+exitcode_t CommandLine::HandleCommandConvert(CommandLineArgEnumerator* enumerator)
+{
+    exitcode_t result = CommandLine::HandleCommandDefault();
+    if (result != EXITCODE_CONTINUE)
+    {
+        return result;
+    }
+
+    // Get the source path
+    const utf8* rawSourcePath;
+    if (!enumerator->TryPopString(&rawSourcePath))
+    {
+        Console::Error::WriteLine("Expected a source path.");
+        return EXITCODE_FAIL;
+    }
+
+    utf8 sourcePath[MAX_PATH];
+    Path::GetAbsolute(sourcePath, sizeof(sourcePath), rawSourcePath);
+    uint32_t sourceFileType = get_file_extension_type(sourcePath);
+
+    // Get the destination path
+    const utf8* rawDestinationPath;
+    if (!enumerator->TryPopString(&rawDestinationPath))
+    {
+        Console::Error::WriteLine("Expected a destination path.");
+        return EXITCODE_FAIL;
+    }
+
+    utf8 destinationPath[MAX_PATH];
+    Path::GetAbsolute(destinationPath, sizeof(sourcePath), rawDestinationPath);
+    uint32_t destinationFileType = get_file_extension_type(destinationPath);
+
+    auto error = GetConvertError(sourceFileType, destinationFileType);
+    if (error != nullptr)
+    {
+        Console::Error::WriteLine("%s", error);
+        return EXITCODE_FAIL;
+    }
+
+    // Perform conversion
+    WriteConvertFromAndToMessage(sourceFileType, destinationFileType);
+
+    gOpenRCT2Headless = true;
+
+    auto conversionError = ConvertPark(sourcePath, sourceFileType, destinationPath, destinationFileType);
+    if (!conversionError.empty())
+    {
+        Console::Error::WriteLine("%s", conversionError.c_str());
         return EXITCODE_FAIL;
     }
 
@@ -137,6 +198,140 @@ exitcode_t CommandLine::HandleCommandConvert(CommandLineArgEnumerator* enumerato
     return EXITCODE_OK;
 }
 
+struct ConvertBatchResult
+{
+    std::string Source;
+    std::string Destination;
+    std::string Error;
+
+    json_t ToJson() const
+    {
+        return { { "source", Source }, { "destination", Destination }, { "error", Error } };
+    }
+
+    static ConvertBatchResult FromJson(const json_t& jsonData)
+    {
+        ConvertBatchResult result;
+        result.Source = Json::GetString(jsonData["source"]);
+        result.Destination = Json::GetString(jsonData["destination"]);
+        result.Error = Json::GetString(jsonData["error"]);
+        return result;
+    }
+};
+
+static ConvertBatchResult ConvertBatchPark(const std::string& source, const std::string& destinationDirectory)
+{
+    ConvertBatchResult result;
+    result.Source = source;
+
+    auto sourceFileType = get_file_extension_type(source.c_str());
+    uint32_t destinationFileType;
+    if (_batchPark)
+    {
+        destinationFileType = FILE_EXTENSION_PARK;
+    }
+    else if (sourceFileType == FILE_EXTENSION_SC4 || sourceFileType == FILE_EXTENSION_SC6)
+    {
+        destinationFileType = FILE_EXTENSION_SC6;
+    }
+    else
+    {
+        destinationFileType = FILE_EXTENSION_SV6;
+    }
+
+    auto error = GetConvertError(sourceFileType, destinationFileType);
+    if (error != nullptr)
+    {
+        result.Error = error;
+        return result;
+    }
+
+    const char* extension = destinationFileType == FILE_EXTENSION_PARK
+        ? ".park"
+        : (destinationFileType == FILE_EXTENSION_SC6 ? ".sc6" : ".sv6");
+    result.Destination = Path::Combine(destinationDirectory, Path::GetFileNameWithoutExtension(source) + extension);
+    result.Error = ConvertPark(source.c_str(), sourceFileType, result.Destination.c_str(), destinationFileType);
+    return result;
+}
+
+static exitcode_t HandleConvertBatch(CommandLineArgEnumerator* enumerator)
+{
+    const char** argv = const_cast<const char**>(enumerator->GetArguments()) + enumerator->GetIndex();
+    int32_t argc = enumerator->GetCount() - enumerator->GetIndex();
+    if (argc < 2)
+    {
+        Console::Error::WriteLine("Missing arguments <destination directory> <source>...");
+        return EXITCODE_FAIL;
+    }
+
+    core_init();
+
+    auto destinationDirectory = Path::GetAbsolute(argv[0]);
+    std::vector<std::string> sources;
+    for (int32_t i = 1; i < argc; i++)
+    {
+        sources.push_back(Path::GetAbsolute(argv[i]));
+    }
+    size_t jobs = _batchJobs > 0 ? _batchJobs : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    jobs = std::min(jobs, sources.size());
+
+    gOpenRCT2Headless = true;
+
+    std::unique_ptr<OpenRCT2::IContext> context(OpenRCT2::CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    std::vector<ConvertBatchResult> results;
+#ifdef BATCH_WORKERS_FORK
+    if (jobs > 1)
+    {
+        auto lines = RunBatchInWorkers(sources.size(), jobs, [&sources, &destinationDirectory](size_t index) {
+            return ConvertBatchPark(sources[index], destinationDirectory).ToJson().dump();
+        });
+        for (const auto& line : lines)
+        {
+            results.push_back(ConvertBatchResult::FromJson(Json::FromString(line)));
+        }
+    }
+    else
+#endif
+    {
+        // The game state is global, so without separate processes the parks have to be converted one after another.
+        for (const auto& source : sources)
+        {
+            results.push_back(ConvertBatchPark(source, destinationDirectory));
+        }
+    }
+
+    // Report in the order the parks were given, parks lost with a crashed worker count as failed.
+    size_t failed = 0;
+    for (const auto& source : sources)
+    {
+        auto it = std::find_if(
+            results.begin(), results.end(), [&source](const ConvertBatchResult& r) { return r.Source == source; });
+        if (it == results.end())
+        {
+            Console::Error::WriteLine("%s: the worker converting it crashed", source.c_str());
+            failed++;
+        }
+        else if (!it->Error.empty())
+        {
+            Console::Error::WriteLine("%s: %s", source.c_str(), it->Error.c_str());
+            failed++;
+        }
+        else
+        {
+            Console::WriteLine("%s -> %s", source.c_str(), it->Destination.c_str());
+        }
+    }
+
+    Console::WriteLine("Converted %zu of %zu parks.", sources.size() - failed, sources.size());
+    return failed == 0 ? EXITCODE_OK : EXITCODE_FAIL;
+}
+
 static void WriteConvertFromAndToMessage(uint32_t sourceFileType, uint32_t destinationFileType)
 {
     const utf8* sourceFileTypeName = GetFileTypeFriendlyName(sourceFileType);
@@ -157,6 +352,8 @@ static const utf8* GetFileTypeFriendlyName(uint32_t fileType)
             return "RollerCoaster Tycoon 2 scenario";
         case FILE_EXTENSION_SV6:
             return "RollerCoaster Tycoon 2 saved game";
+        case FILE_EXTENSION_PARK:
+            return "OpenRCT2 park";
     }
 
     assert(false);
@@ -16,7 +16,9 @@
 #include "../core/Guard.hpp"
 #include "../core/Memory.hpp"
 #include "../core/Path.hpp"
+#include "../core/Profiling.h"
 #include "../core/String.hpp"
+#include "../interface/MapTiles.h"
 #include "../localisation/Language.h"
 #include "../network/network.h"
 #include "../object/ObjectRepository.h"
@@ -52,12 +54,17 @@ static bool _all = false;
 static bool _about = false;
 static bool _verbose = false;
 static bool _headless = false;
+static bool _fastStart = false;
 static utf8* _password = nullptr;
 static utf8* _userDataPath = nullptr;
 static utf8* _openrct2DataPath = nullptr;
 static utf8* _rct1DataPath = nullptr;
 static utf8* _rct2DataPath = nullptr;
 static bool _silentBreakpad = false;
+static utf8* _profileTracePath = nullptr;
+static uint32_t _profileTicks = 0;
+static utf8* _mapTilesPath = nullptr;
+static uint32_t _mapTilesInterval = 60;
 
 // clang-format off
 static constexpr const CommandLineOptionDefinition StandardOptions[]
@@ -69,6 +76,7 @@ static constexpr const CommandLineOptionDefinition StandardOptions[]
     { CMDLINE_TYPE_SWITCH,  &_about,            NAC, "about",              "show information about " OPENRCT2_NAME                      },
     { CMDLINE_TYPE_SWITCH,  &_verbose,          NAC, "verbose",            "log verbose messages"                                       },
     { CMDLINE_TYPE_SWITCH,  &_headless,         NAC, "headless",           "run " OPENRCT2_NAME " headless" IMPLIES_SILENT_BREAKPAD     },
+    { CMDLINE_TYPE_SWITCH,  &_fastStart,        NAC, "fast-start",         "load object, track design and scenario lists on first use"  },
 #ifndef DISABLE_NETWORK                                                    
     { CMDLINE_TYPE_INTEGER, &_port,             NAC, "port",               "port to use for hosting or joining a server"                },
     { CMDLINE_TYPE_STRING,  &_address,          NAC, "address",            "address to listen on when hosting a server"                 },
@@ -78,6 +86,10 @@ static constexpr const CommandLineOptionDefinition StandardOptions[]
     { CMDLINE_TYPE_STRING,  &_openrct2DataPath, NAC, "openrct2-data-path", "path to the OpenRCT2 data directory (containing languages)" },
     { CMDLINE_TYPE_STRING,  &_rct1DataPath,     NAC, "rct1-data-path",     "path to the RollerCoaster Tycoon 1 data directory (containing data/csg1.dat)" },
     { CMDLINE_TYPE_STRING,  &_rct2DataPath,     NAC, "rct2-data-path",     "path to the RollerCoaster Tycoon 2 data directory (containing data/g1.dat)" },
+    { CMDLINE_TYPE_STRING,  &_profileTracePath, NAC, "profile-trace",      "record a profiling trace and write it to the given path"    },
+    { CMDLINE_TYPE_INTEGER, &_profileTicks,     NAC, "profile-ticks",      "number of ticks to record with --profile-trace (0 = until exit)" },
+    { CMDLINE_TYPE_STRING,  &_mapTilesPath,     NAC, "map-tiles",          "keep map tile images of the park up to date in the given directory" },
+    { CMDLINE_TYPE_INTEGER, &_mapTilesInterval, NAC, "map-tiles-interval", "seconds between updates of the map tile images (default 60)" },
 #ifdef USE_BREAKPAD
     { CMDLINE_TYPE_SWITCH,  &_silentBreakpad,  NAC, "silent-breakpad",   "make breakpad crash reporting silent"                       },
 #endif // USE_BREAKPAD
@@ -141,7 +153,11 @@ const CommandLineCommand CommandLine::RootCommands[]
     DefineSubCommand("benchgfx",        CommandLine::BenchGfxCommands         ),
     DefineSubCommand("benchspritesort", CommandLine::BenchSpriteSortCommands  ),
     DefineSubCommand("benchsimulate",   CommandLine::BenchUpdateCommands      ),
+    DefineSubCommand("benchpathfind",   CommandLine::BenchPathfindingCommands ),
+    DefineSubCommand("benchscripting",  CommandLine::BenchScriptingCommands   ),
     DefineSubCommand("simulate",        CommandLine::SimulateCommands         ),
+    DefineSubCommand("simulate-batch",  CommandLine::SimulateBatchCommands    ),
+    DefineSubCommand("convert-batch",   CommandLine::ConvertBatchCommands     ),
     CommandTableEnd
 };
 
@@ -194,7 +210,11 @@ exitcode_t CommandLine::HandleCommandDefault()
     }
 
     gOpenRCT2Headless = _headless;
-    gOpenRCT2NoGraphics = _headless;
+    // Map tiles are painted with the base graphics, even when headless
+    gOpenRCT2NoGraphics = _headless && _mapTilesPath == nullptr;
+    // Nothing is presented when headless, the paint cache is still kept up to date for the map tiles
+    gOpenRCT2NoPresentation = _headless;
+    gOpenRCT2FastStart = _fastStart;
     gOpenRCT2SilentBreakpad = _silentBreakpad || _headless;
 
     if (_userDataPath != nullptr)
@@ -231,6 +251,20 @@ exitcode_t CommandLine::HandleCommandDefault()
         Memory::Free(_password);
     }
 
+    if (_profileTracePath != nullptr)
+    {
+        Profiling::StartCapture(_profileTracePath, _profileTicks);
+        Memory::Free(_profileTracePath);
+    }
+
+    if (_mapTilesPath != nullptr)
+    {
+        utf8 absolutePath[MAX_PATH]{};
+        Path::GetAbsolute(absolutePath, std::size(absolutePath), _mapTilesPath);
+        MapTilesStart(absolutePath, _mapTilesInterval);
+        Memory::Free(_mapTilesPath);
+    }
+
     return result;
 }
 
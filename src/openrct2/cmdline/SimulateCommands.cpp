@@ -12,22 +12,54 @@
 #include "../GameState.h"
 #include "../OpenRCT2.h"
 #include "../core/Console.hpp"
+#include "../core/File.h"
+#include "../core/Json.hpp"
+#include "../core/Memory.hpp"
+#include "../core/String.hpp"
 #include "../network/network.h"
+#include "../peep/Peep.h"
 #include "../platform/platform.h"
+#include "../world/Park.h"
 #include "../world/Sprite.h"
+#include "BatchWorkers.h"
 #include "CommandLine.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace OpenRCT2;
 
 static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator);
+static exitcode_t HandleSimulateBatch(CommandLineArgEnumerator* argEnumerator);
+
+static int32_t _batchJobs;
+static const char* _batchOutput;
+static const char* _batchFormat;
+
+// clang-format off
+static constexpr const CommandLineOptionDefinition SimulateBatchOptions[]
+{
+    { CMDLINE_TYPE_INTEGER, &_batchJobs,   'j', "jobs",   "number of worker processes, defaults to the number of cores" },
+    { CMDLINE_TYPE_STRING,  &_batchOutput, 'o', "output", "file to write the metrics to instead of stdout"              },
+    { CMDLINE_TYPE_STRING,  &_batchFormat, 'f', "format", "format of the metrics <json|csv>"                           },
+    OptionTableEnd
+};
+// clang-format on
 
 const CommandLineCommand CommandLine::SimulateCommands[]{ // Main commands
                                                           DefineCommand("", "<ticks>", nullptr, HandleSimulate), CommandTableEnd
 };
 
+const CommandLineCommand CommandLine::SimulateBatchCommands[]{
+    // Main commands
+    DefineCommand("", "<ticks> <file>...", SimulateBatchOptions, HandleSimulateBatch), CommandTableEnd
+};
+
 static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator)
 {
     const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
@@ -73,3 +105,212 @@ static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator)
 
     return EXITCODE_OK;
 }
+
+struct SimulateBatchResult
+{
+    std::string Path;
+    bool Success{};
+    uint32_t Ticks{};
+    double Seconds{};
+    uint32_t Guests{};
+    uint16_t ParkRating{};
+    std::string Checksum;
+
+    json_t ToJson() const
+    {
+        return { { "path", Path },
+                 { "success", Success },
+                 { "ticks", Ticks },
+                 { "seconds", Seconds },
+                 { "ticksPerSecond", Seconds > 0 ? Ticks / Seconds : 0.0 },
+                 { "guests", Guests },
+                 { "parkRating", ParkRating },
+                 { "checksum", Checksum } };
+    }
+
+    static SimulateBatchResult FromJson(const json_t& jsonData)
+    {
+        SimulateBatchResult result;
+        result.Path = Json::GetString(jsonData["path"]);
+        result.Success = Json::GetBoolean(jsonData["success"]);
+        result.Ticks = Json::GetNumber<uint32_t>(jsonData["ticks"]);
+        result.Seconds = Json::GetNumber<double>(jsonData["seconds"]);
+        result.Guests = Json::GetNumber<uint32_t>(jsonData["guests"]);
+        result.ParkRating = Json::GetNumber<uint16_t>(jsonData["parkRating"]);
+        result.Checksum = Json::GetString(jsonData["checksum"]);
+        return result;
+    }
+};
+
+static SimulateBatchResult SimulateBatchPark(IContext& context, const std::string& path, uint32_t ticks)
+{
+    SimulateBatchResult result;
+    result.Path = path;
+    if (!context.LoadParkFromFile(path))
+    {
+        return result;
+    }
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < ticks; i++)
+    {
+        context.GetGameState()->UpdateLogic();
+    }
+    result.Seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - startTime).count();
+    result.Success = true;
+    result.Ticks = ticks;
+    result.Guests = gNumGuestsInPark;
+    result.ParkRating = gParkRating;
+    result.Checksum = sprite_checksum().ToString();
+    return result;
+}
+
+#ifdef BATCH_WORKERS_FORK
+
+static std::vector<SimulateBatchResult> SimulateBatchForked(
+    IContext& context, const std::vector<std::string>& paths, uint32_t ticks, size_t jobs)
+{
+    auto lines = RunBatchInWorkers(paths.size(), jobs, [&context, &paths, ticks](size_t index) {
+        return SimulateBatchPark(context, paths[index], ticks).ToJson().dump();
+    });
+
+    std::vector<SimulateBatchResult> results;
+    for (const auto& line : lines)
+    {
+        results.push_back(SimulateBatchResult::FromJson(Json::FromString(line)));
+    }
+    return results;
+}
+
+#endif // BATCH_WORKERS_FORK
+
+static std::string QuoteCsv(const std::string& value)
+{
+    std::string result = "\"";
+    for (auto c : value)
+    {
+        if (c == '"')
+            result += '"';
+        result += c;
+    }
+    return result + "\"";
+}
+
+static std::string SimulateBatchResultsToCsv(const std::vector<SimulateBatchResult>& results)
+{
+    std::string csv = "path,success,ticks,seconds,ticks_per_second,guests,park_rating,checksum\n";
+    for (const auto& result : results)
+    {
+        auto ticksPerSecond = result.Seconds > 0 ? result.Ticks / result.Seconds : 0.0;
+        csv += QuoteCsv(result.Path) + "," + (result.Success ? "true" : "false") + "," + std::to_string(result.Ticks) + ","
+            + std::to_string(result.Seconds) + "," + std::to_string(ticksPerSecond) + "," + std::to_string(result.Guests) + ","
+            + std::to_string(result.ParkRating) + "," + result.Checksum + "\n";
+    }
+    return csv;
+}
+
+static exitcode_t HandleSimulateBatch(CommandLineArgEnumerator* argEnumerator)
+{
+    std::string format = _batchFormat != nullptr ? _batchFormat : "json";
+    std::string outputPath = _batchOutput != nullptr ? _batchOutput : "";
+    Memory::Free(_batchFormat);
+    Memory::Free(_batchOutput);
+    if (!String::Equals(format, "json", true) && !String::Equals(format, "csv", true))
+    {
+        Console::Error::WriteLine("Unknown format '%s', expected json or csv.", format.c_str());
+        return EXITCODE_FAIL;
+    }
+
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    if (argc < 2)
+    {
+        Console::Error::WriteLine("Missing arguments <ticks> <file>...");
+        return EXITCODE_FAIL;
+    }
+
+    core_init();
+
+    uint32_t ticks = atol(argv[0]);
+    std::vector<std::string> paths(argv + 1, argv + argc);
+    size_t jobs = _batchJobs > 0 ? _batchJobs : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    jobs = std::min(jobs, paths.size());
+
+    gOpenRCT2Headless = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    std::vector<SimulateBatchResult> results;
+#ifdef BATCH_WORKERS_FORK
+    if (jobs > 1)
+    {
+        results = SimulateBatchForked(*context, paths, ticks, jobs);
+    }
+    else
+#endif
+    {
+        // The game state is global, so without separate processes the parks have to run one after another.
+        for (const auto& path : paths)
+        {
+            results.push_back(SimulateBatchPark(*context, path, ticks));
+        }
+    }
+
+    // Report in the order the parks were given, parks lost with a crashed worker count as failed.
+    std::vector<SimulateBatchResult> ordered;
+    for (const auto& path : paths)
+    {
+        auto it = std::find_if(results.begin(), results.end(), [&path](const SimulateBatchResult& r) { return r.Path == path; });
+        if (it != results.end())
+        {
+            ordered.push_back(std::move(*it));
+            results.erase(it);
+        }
+        else
+        {
+            SimulateBatchResult failed;
+            failed.Path = path;
+            ordered.push_back(failed);
+        }
+    }
+
+    std::string output;
+    if (String::Equals(format, "csv", true))
+    {
+        output = SimulateBatchResultsToCsv(ordered);
+    }
+    else
+    {
+        json_t jsonResults = json_t::array();
+        for (const auto& result : ordered)
+        {
+            jsonResults.push_back(result.ToJson());
+        }
+        output = jsonResults.dump(4) + "\n";
+    }
+
+    if (outputPath.empty())
+    {
+        Console::Write(output.c_str());
+    }
+    else
+    {
+        try
+        {
+            File::WriteAllBytes(outputPath, output.data(), output.size());
+        }
+        catch (const std::exception& e)
+        {
+            Console::Error::WriteLine("Unable to write '%s': %s", outputPath.c_str(), e.what());
+            return EXITCODE_FAIL;
+        }
+    }
+
+    auto failed = std::count_if(ordered.begin(), ordered.end(), [](const SimulateBatchResult& r) { return !r.Success; });
+    return failed == 0 ? EXITCODE_OK : EXITCODE_FAIL;
+}
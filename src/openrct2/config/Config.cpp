@@ -151,6 +151,7 @@ namespace Config
             model->always_show_gridlines = reader->GetBoolean("always_show_gridlines", false);
             model->autosave_frequency = reader->GetInt32("autosave", AUTOSAVE_EVERY_5MINUTES);
             model->autosave_amount = reader->GetInt32("autosave_amount", DEFAULT_NUM_AUTOSAVES_TO_KEEP);
+            model->autosave_park_files = reader->GetBoolean("autosave_park_files", false);
             model->confirmation_prompt = reader->GetBoolean("confirmation_prompt", false);
             model->currency_format = reader->GetEnum<CurrencyType>(
                 "currency_format", platform_get_locale_currency(), Enum_Currency);
@@ -183,6 +184,7 @@ namespace Config
                 "drawing_engine", DrawingEngine::Software, Enum_DrawingEngine);
             model->uncap_fps = reader->GetBoolean("uncap_fps", false);
             model->use_vsync = reader->GetBoolean("use_vsync", true);
+            model->frame_pacing = reader->GetBoolean("frame_pacing", true);
             model->virtual_floor_style = reader->GetEnum<VirtualFloorStyles>(
                 "virtual_floor_style", VirtualFloorStyles::Glassy, Enum_VirtualFloorStyle);
             model->date_format = reader->GetEnum<int32_t>("date_format", platform_get_locale_date_format(), Enum_DateFormat);
@@ -238,6 +240,7 @@ namespace Config
         writer->WriteBoolean("always_show_gridlines", model->always_show_gridlines);
         writer->WriteInt32("autosave", model->autosave_frequency);
         writer->WriteInt32("autosave_amount", model->autosave_amount);
+        writer->WriteBoolean("autosave_park_files", model->autosave_park_files);
         writer->WriteBoolean("confirmation_prompt", model->confirmation_prompt);
         writer->WriteEnum<CurrencyType>("currency_format", model->currency_format, Enum_Currency);
         writer->WriteInt32("custom_currency_rate", model->custom_currency_rate);
@@ -265,6 +268,7 @@ namespace Config
         writer->WriteEnum<DrawingEngine>("drawing_engine", model->drawing_engine, Enum_DrawingEngine);
         writer->WriteBoolean("uncap_fps", model->uncap_fps);
         writer->WriteBoolean("use_vsync", model->use_vsync);
+        writer->WriteBoolean("frame_pacing", model->frame_pacing);
         writer->WriteEnum<int32_t>("date_format", model->date_format, Enum_DateFormat);
         writer->WriteBoolean("auto_staff", model->auto_staff_placement);
         writer->WriteBoolean("handymen_mow_default", model->handymen_mow_default);
@@ -420,6 +424,12 @@ namespace Config
             model->log_server_actions = reader->GetBoolean("log_server_actions", false);
             model->pause_server_if_no_clients = reader->GetBoolean("pause_server_if_no_clients", false);
             model->desync_debugging = reader->GetBoolean("desync_debugging", false);
+            model->map_cache_ticks = reader->GetInt32("map_cache_ticks", 200);
+            model->send_queue_limit_kib = reader->GetInt32("send_queue_limit_kib", 4096);
+            model->max_client_lag_ticks = reader->GetInt32("max_client_lag_ticks", 1200);
+            model->client_prediction = reader->GetBoolean("client_prediction", false);
+            model->metrics_log_path = reader->GetString("metrics_log_path", "");
+            model->metrics_interval = reader->GetInt32("metrics_interval", 10);
         }
     }
 
@@ -447,6 +457,12 @@ namespace Config
         writer->WriteBoolean("log_server_actions", model->log_server_actions);
         writer->WriteBoolean("pause_server_if_no_clients", model->pause_server_if_no_clients);
         writer->WriteBoolean("desync_debugging", model->desync_debugging);
+        writer->WriteInt32("map_cache_ticks", model->map_cache_ticks);
+        writer->WriteInt32("send_queue_limit_kib", model->send_queue_limit_kib);
+        writer->WriteInt32("max_client_lag_ticks", model->max_client_lag_ticks);
+        writer->WriteBoolean("client_prediction", model->client_prediction);
+        writer->WriteString("metrics_log_path", model->metrics_log_path);
+        writer->WriteInt32("metrics_interval", model->metrics_interval);
     }
 
     static void ReadNotifications(IIniReader* reader)
@@ -548,6 +564,9 @@ namespace Config
             auto model = &gConfigPlugin;
             model->enable_hot_reloading = reader->GetBoolean("enable_hot_reloading", false);
             model->allowed_hosts = reader->GetString("allowed_hosts", "");
+            model->tick_budget = reader->GetFloat("tick_budget", 0.0f);
+            model->throttle_over_budget = reader->GetBoolean("throttle_over_budget", false);
+            model->suspend_over_budget_ticks = reader->GetInt32("suspend_over_budget_ticks", 0);
         }
     }
 
@@ -557,6 +576,9 @@ namespace Config
         writer->WriteSection("plugin");
         writer->WriteBoolean("enable_hot_reloading", model->enable_hot_reloading);
         writer->WriteString("allowed_hosts", model->allowed_hosts);
+        writer->WriteFloat("tick_budget", model->tick_budget);
+        writer->WriteBoolean("throttle_over_budget", model->throttle_over_budget);
+        writer->WriteInt32("suspend_over_budget_ticks", model->suspend_over_budget_ticks);
     }
 
     static bool SetDefaults()
@@ -40,6 +40,7 @@ struct GeneralConfiguration
     ScaleQuality scale_quality;
     bool uncap_fps;
     bool use_vsync;
+    bool frame_pacing;
     bool show_fps;
     bool multithreading;
     bool minimize_fullscreen_focus_loss;
@@ -85,6 +86,7 @@ struct GeneralConfiguration
     bool debugging_tools;
     int32_t autosave_frequency;
     int32_t autosave_amount;
+    bool autosave_park_files;
     bool auto_staff_placement;
     bool handymen_mow_default;
     bool auto_open_shops;
@@ -161,6 +163,12 @@ struct NetworkConfiguration
     bool log_server_actions;
     bool pause_server_if_no_clients;
     bool desync_debugging;
+    int32_t map_cache_ticks;
+    int32_t send_queue_limit_kib;
+    int32_t max_client_lag_ticks;
+    bool client_prediction;
+    std::string metrics_log_path;
+    int32_t metrics_interval;
 };
 
 struct NotificationConfiguration
@@ -207,6 +215,9 @@ struct PluginConfiguration
 {
     bool enable_hot_reloading;
     std::string allowed_hosts;
+    float tick_budget; // Milliseconds each plugin may spend in its hooks per tick, 0 for no limit
+    bool throttle_over_budget;
+    int32_t suspend_over_budget_ticks;
 };
 
 enum class Sort : int32_t
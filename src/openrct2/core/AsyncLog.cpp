@@ -0,0 +1,169 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "AsyncLog.h"
+
+#include "Console.hpp"
+#include "MpscRingBuffer.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <ostream>
+#include <thread>
+
+namespace AsyncLog
+{
+    struct Record
+    {
+        AsyncLog::Target Target{};
+        std::ostream* Stream{};
+        std::string Text;
+    };
+
+    static constexpr size_t QueueCapacity = 4096;
+    // The writer also looks for records this often, in case it missed being woken up
+    static constexpr auto WriterWakeInterval = std::chrono::milliseconds(10);
+
+    static std::unique_ptr<MpscRingBuffer<Record>> _queue;
+    static std::thread _writer;
+    static std::thread::id _writerId;
+    static std::atomic<bool> _running = { false };
+    static std::atomic<bool> _stopping = { false };
+    static std::atomic<bool> _writerSleeping = { false };
+    static std::atomic<size_t> _written = { 0 };
+    static std::mutex _wakeMutex;
+    static std::condition_variable _wakeCondition;
+
+    static void WriteRecord(const Record& record)
+    {
+        switch (record.Target)
+        {
+            case Target::StdOut:
+                Console::WriteLine("%s", record.Text.c_str());
+                break;
+            case Target::StdErr:
+                Console::Error::WriteLine("%s", record.Text.c_str());
+                break;
+            case Target::File:
+                if (record.Stream->fail())
+                {
+                    Console::Error::WriteLine("bad ostream failed to append log");
+                }
+                else
+                {
+                    record.Stream->write(record.Text.data(), record.Text.size());
+                }
+                break;
+        }
+    }
+
+    static void DrainQueue()
+    {
+        Record record;
+        while (_queue->TryPop(record))
+        {
+            WriteRecord(record);
+            record = {};
+            _written.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    static void WriterLoop()
+    {
+        for (;;)
+        {
+            DrainQueue();
+            if (_stopping)
+                break;
+
+            std::unique_lock<std::mutex> lock(_wakeMutex);
+            _writerSleeping = true;
+            _wakeCondition.wait_for(lock, WriterWakeInterval);
+            _writerSleeping = false;
+        }
+    }
+
+    static void Post(Record&& record)
+    {
+        // When the queue is full the record is written straight away, out of order with the queued ones, rather
+        // than waiting for room.
+        if (_running.load(std::memory_order_acquire) && _queue->TryPush(std::move(record)))
+        {
+            if (_writerSleeping.load(std::memory_order_relaxed))
+            {
+                _wakeCondition.notify_one();
+            }
+            return;
+        }
+        WriteRecord(record);
+    }
+
+    void Start()
+    {
+        if (_running || _writer.joinable())
+            return;
+
+        if (_queue == nullptr)
+        {
+            _queue = std::make_unique<MpscRingBuffer<Record>>(QueueCapacity);
+        }
+        _stopping = false;
+        _writer = std::thread(WriterLoop);
+        _writerId = _writer.get_id();
+        _running.store(true, std::memory_order_release);
+    }
+
+    void Stop()
+    {
+        if (!_writer.joinable())
+            return;
+
+        _running = false;
+        _stopping = true;
+        _wakeCondition.notify_one();
+        _writer.join();
+        _writerId = {};
+
+        // Records pushed while the writer was stopping
+        while (_written.load(std::memory_order_acquire) < _queue->GetPushCount())
+        {
+            DrainQueue();
+            std::this_thread::yield();
+        }
+    }
+
+    bool IsRunning()
+    {
+        return _running.load(std::memory_order_relaxed);
+    }
+
+    void WriteLine(Target target, std::string line)
+    {
+        Post({ target, nullptr, std::move(line) });
+    }
+
+    void Write(std::ostream& stream, std::string text)
+    {
+        Post({ Target::File, &stream, std::move(text) });
+    }
+
+    void Flush()
+    {
+        if (!_running || std::this_thread::get_id() == _writerId)
+            return;
+
+        auto pushed = _queue->GetPushCount();
+        while (_written.load(std::memory_order_acquire) < pushed && _running)
+        {
+            _wakeCondition.notify_one();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+} // namespace AsyncLog
@@ -0,0 +1,47 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+/**
+ * Writes log lines on a background thread so the thread that logs only formats them. Until Start is called, and
+ * whenever the queue is full, the lines are written straight away instead.
+ */
+namespace AsyncLog
+{
+    enum class Target : uint8_t
+    {
+        StdOut,
+        StdErr,
+        File,
+    };
+
+    void Start();
+    void Stop();
+    bool IsRunning();
+
+    /**
+     * Writes a formatted line to the console, with the newline added by the console.
+     */
+    void WriteLine(Target target, std::string line);
+
+    /**
+     * Writes text as it is to the stream, which has to stay open until Flush has returned.
+     */
+    void Write(std::ostream& stream, std::string text);
+
+    /**
+     * Blocks until everything written so far has reached its target.
+     */
+    void Flush();
+} // namespace AsyncLog
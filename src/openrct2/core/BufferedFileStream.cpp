@@ -0,0 +1,172 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "BufferedFileStream.h"
+
+#include <algorithm>
+
+namespace OpenRCT2
+{
+    BufferedFileStream::BufferedFileStream(const std::string& path, BufferedFileMode mode, size_t blockSize)
+        : _blockSize(std::max<size_t>(blockSize, 1))
+    {
+        if (mode == BufferedFileMode::MemoryMapped)
+        {
+            _mapping = std::make_unique<MemoryMappedFile>(path);
+            _length = _mapping->GetLength();
+            _bufferData = _mapping->GetData();
+            _bufferLength = _length;
+        }
+        else
+        {
+            _file = std::make_unique<FileStream>(path, FILE_MODE_OPEN_SEQUENTIAL);
+            _length = _file->GetLength();
+        }
+    }
+
+    bool BufferedFileStream::CanRead() const
+    {
+        return true;
+    }
+
+    bool BufferedFileStream::CanWrite() const
+    {
+        return false;
+    }
+
+    uint64_t BufferedFileStream::GetLength() const
+    {
+        return _length;
+    }
+
+    uint64_t BufferedFileStream::GetPosition() const
+    {
+        return _position;
+    }
+
+    void BufferedFileStream::SetPosition(uint64_t position)
+    {
+        _position = position;
+    }
+
+    void BufferedFileStream::Seek(int64_t offset, int32_t origin)
+    {
+        switch (origin)
+        {
+            case STREAM_SEEK_BEGIN:
+                _position = offset;
+                break;
+            case STREAM_SEEK_CURRENT:
+                _position += offset;
+                break;
+            case STREAM_SEEK_END:
+                _position = _length + offset;
+                break;
+        }
+    }
+
+    void BufferedFileStream::FillBlock()
+    {
+        if (_filePosition != _position)
+        {
+            _file->SetPosition(_position);
+            _filePosition = _position;
+        }
+        _block.resize(_blockSize);
+        _bufferLength = _file->TryRead(_block.data(), _block.size());
+        _bufferData = _block.data();
+        _bufferStart = _position;
+        _filePosition += _bufferLength;
+    }
+
+    void BufferedFileStream::Read(void* buffer, uint64_t length)
+    {
+        if (_position > _length || length > _length - _position)
+        {
+            throw IOException("Attempted to read past end of file.");
+        }
+
+        auto dst = static_cast<uint8_t*>(buffer);
+        while (length > 0)
+        {
+            if (_position >= _bufferStart && _position < _bufferStart + _bufferLength)
+            {
+                auto offset = _position - _bufferStart;
+                auto count = std::min(length, _bufferLength - offset);
+                std::memcpy(dst, _bufferData + offset, static_cast<size_t>(count));
+                dst += count;
+                _position += count;
+                length -= count;
+            }
+            else if (length >= _blockSize)
+            {
+                // Large reads go straight to the caller rather than through the block
+                if (_filePosition != _position)
+                {
+                    _file->SetPosition(_position);
+                }
+                _file->Read(dst, length);
+                _position += length;
+                _filePosition = _position;
+                length = 0;
+            }
+            else
+            {
+                FillBlock();
+                if (_bufferLength == 0)
+                {
+                    throw IOException("Attempted to read past end of file.");
+                }
+            }
+        }
+    }
+
+    void BufferedFileStream::Read1(void* buffer)
+    {
+        Read<1>(buffer);
+    }
+
+    void BufferedFileStream::Read2(void* buffer)
+    {
+        Read<2>(buffer);
+    }
+
+    void BufferedFileStream::Read4(void* buffer)
+    {
+        Read<4>(buffer);
+    }
+
+    void BufferedFileStream::Read8(void* buffer)
+    {
+        Read<8>(buffer);
+    }
+
+    void BufferedFileStream::Read16(void* buffer)
+    {
+        Read<16>(buffer);
+    }
+
+    void BufferedFileStream::Write(const void* buffer, uint64_t length)
+    {
+        throw IOException("Attempted to write to a read-only file stream.");
+    }
+
+    uint64_t BufferedFileStream::TryRead(void* buffer, uint64_t length)
+    {
+        uint64_t remainingBytes = _position < _length ? _length - _position : 0;
+        uint64_t bytesToRead = std::min(length, remainingBytes);
+        Read(buffer, bytesToRead);
+        return bytesToRead;
+    }
+
+    const void* BufferedFileStream::GetData() const
+    {
+        return _mapping != nullptr ? _mapping->GetData() : nullptr;
+    }
+} // namespace OpenRCT2
@@ -0,0 +1,98 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "FileStream.h"
+#include "IStream.hpp"
+#include "MemoryMappedFile.h"
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OpenRCT2
+{
+    enum class BufferedFileMode : uint8_t
+    {
+        // Reads the file a block at a time, telling the OS it is read from start to end
+        Buffered,
+        // Maps the whole file, reads are copies out of the mapping
+        MemoryMapped,
+    };
+
+    /**
+     * A read-only stream over a file for readers that make many small reads, which are served from memory instead
+     * of going through the C library one at a time.
+     */
+    class BufferedFileStream final : public IStream
+    {
+    public:
+        static constexpr size_t DefaultBlockSize = 64 * 1024;
+
+    private:
+        std::unique_ptr<FileStream> _file;
+        std::unique_ptr<MemoryMappedFile> _mapping;
+        std::vector<uint8_t> _block;
+        size_t _blockSize{};
+        uint64_t _length{};
+        uint64_t _position{};
+        // The part of the file in memory, the whole of it when mapped
+        const uint8_t* _bufferData{};
+        uint64_t _bufferStart{};
+        uint64_t _bufferLength{};
+        uint64_t _filePosition{};
+
+    public:
+        explicit BufferedFileStream(
+            const std::string& path, BufferedFileMode mode = BufferedFileMode::Buffered,
+            size_t blockSize = DefaultBlockSize);
+
+        bool CanRead() const override;
+        bool CanWrite() const override;
+
+        uint64_t GetLength() const override;
+        uint64_t GetPosition() const override;
+        void SetPosition(uint64_t position) override;
+        void Seek(int64_t offset, int32_t origin) override;
+
+        void Read(void* buffer, uint64_t length) override;
+        void Read1(void* buffer) override;
+        void Read2(void* buffer) override;
+        void Read4(void* buffer) override;
+        void Read8(void* buffer) override;
+        void Read16(void* buffer) override;
+        void Write(const void* buffer, uint64_t length) override;
+        uint64_t TryRead(void* buffer, uint64_t length) override;
+
+        /**
+         * The contents of the file when it is mapped, nullptr otherwise.
+         */
+        const void* GetData() const override;
+
+    private:
+        template<size_t N> void Read(void* buffer)
+        {
+            auto offset = _position - _bufferStart;
+            if (_position >= _bufferStart && offset + N <= _bufferLength)
+            {
+                std::memcpy(buffer, _bufferData + offset, N);
+                _position += N;
+            }
+            else
+            {
+                Read(buffer, N);
+            }
+        }
+
+        void FillBlock();
+    };
+} // namespace OpenRCT2
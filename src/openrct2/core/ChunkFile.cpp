@@ -0,0 +1,244 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "ChunkFile.h"
+
+#include "IStream.hpp"
+#include "Profiling.h"
+#include "TaskScheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <zlib.h>
+
+using namespace OpenRCT2;
+using namespace OpenRCT2::ChunkFile;
+
+// Favour speed, the level barely changes the size of park data and the higher levels are several times slower.
+static constexpr int COMPRESSION_LEVEL = 1;
+
+static constexpr uint32_t MAX_CHUNKS = 1024;
+static constexpr uint64_t HEADER_SIZE = 3 * sizeof(uint32_t);
+static constexpr uint64_t ENTRY_SIZE = 2 * sizeof(uint32_t) + 3 * sizeof(uint64_t);
+
+bool ChunkFile::IsChunkFile(IStream* stream)
+{
+    auto position = stream->GetPosition();
+    uint32_t magic = 0;
+    auto bytesRead = stream->TryRead(&magic, sizeof(magic));
+    stream->SetPosition(position);
+    return bytesRead == sizeof(magic) && magic == MAGIC;
+}
+
+void ChunkFileWriter::AddChunk(uint32_t id, const void* data, size_t length)
+{
+    _chunks.push_back({ id, data, length });
+}
+
+void ChunkFileWriter::Write(IStream* stream, ChunkFileCache* cache) const
+{
+    PROFILE_SCOPE("ChunkFileWriter::Write");
+
+    std::vector<std::vector<uint8_t>> compressedData(_chunks.size());
+    std::vector<Compression> methods(_chunks.size(), Compression::None);
+
+    // Look the entries up front, the tasks then only touch their own entry
+    std::vector<ChunkFileCache::CachedChunk*> cachedChunks(_chunks.size(), nullptr);
+    std::atomic<size_t> numReused{ 0 };
+    if (cache != nullptr)
+    {
+        for (size_t i = 0; i < _chunks.size(); i++)
+        {
+            cachedChunks[i] = &cache->_chunks[_chunks[i].Id];
+        }
+    }
+
+    TaskScheduler::Get().ParallelFor(_chunks.size(), 1, [&](size_t i) {
+        const auto& chunk = _chunks[i];
+        auto& dst = compressedData[i];
+        auto cachedChunk = cachedChunks[i];
+        if (cachedChunk != nullptr && cachedChunk->Data.size() == chunk.Length
+            && (chunk.Length == 0 || std::memcmp(cachedChunk->Data.data(), chunk.Data, chunk.Length) == 0))
+        {
+            dst = cachedChunk->CompressedData;
+            methods[i] = cachedChunk->Method;
+            numReused++;
+            return;
+        }
+
+        auto dstLength = compressBound(static_cast<uLong>(chunk.Length));
+        dst.resize(dstLength);
+        auto result = compress2(
+            dst.data(), &dstLength, static_cast<const Bytef*>(chunk.Data), static_cast<uLong>(chunk.Length),
+            COMPRESSION_LEVEL);
+        if (result == Z_OK && dstLength < chunk.Length)
+        {
+            dst.resize(dstLength);
+            methods[i] = Compression::Zlib;
+        }
+        else
+        {
+            // Store chunks that do not compress as they are
+            dst.clear();
+        }
+
+        if (cachedChunk != nullptr)
+        {
+            auto src = static_cast<const uint8_t*>(chunk.Data);
+            cachedChunk->Data.assign(src, src + chunk.Length);
+            cachedChunk->CompressedData = dst;
+            cachedChunk->Method = methods[i];
+        }
+    });
+    if (cache != nullptr)
+    {
+        cache->_numReused = numReused;
+    }
+
+    auto fileStart = stream->GetPosition();
+    stream->WriteValue<uint32_t>(MAGIC);
+    stream->WriteValue<uint32_t>(VERSION);
+    stream->WriteValue<uint32_t>(static_cast<uint32_t>(_chunks.size()));
+
+    uint64_t offset = HEADER_SIZE + _chunks.size() * ENTRY_SIZE;
+    for (size_t i = 0; i < _chunks.size(); i++)
+    {
+        auto length = methods[i] == Compression::None ? _chunks[i].Length : compressedData[i].size();
+        stream->WriteValue<uint32_t>(_chunks[i].Id);
+        stream->WriteValue<uint32_t>(static_cast<uint32_t>(methods[i]));
+        stream->WriteValue<uint64_t>(offset);
+        stream->WriteValue<uint64_t>(length);
+        stream->WriteValue<uint64_t>(_chunks[i].Length);
+        offset += length;
+    }
+
+    for (size_t i = 0; i < _chunks.size(); i++)
+    {
+        if (methods[i] == Compression::None)
+            stream->Write(_chunks[i].Data, _chunks[i].Length);
+        else
+            stream->Write(compressedData[i].data(), compressedData[i].size());
+    }
+    stream->SetPosition(fileStart + offset);
+}
+
+ChunkFileReader::ChunkFileReader(IStream* stream)
+    : _stream(stream)
+    , _fileStart(stream->GetPosition())
+{
+    auto magic = stream->ReadValue<uint32_t>();
+    auto version = stream->ReadValue<uint32_t>();
+    auto numChunks = stream->ReadValue<uint32_t>();
+    if (magic != MAGIC)
+        throw IOException("Not a chunk file.");
+    if (version != VERSION)
+        throw IOException("Unsupported chunk file version.");
+    if (numChunks > MAX_CHUNKS)
+        throw IOException("Invalid chunk count.");
+
+    auto available = stream->GetLength() - _fileStart;
+    _entries.resize(numChunks);
+    for (auto& entry : _entries)
+    {
+        entry.Id = stream->ReadValue<uint32_t>();
+        entry.Method = static_cast<Compression>(stream->ReadValue<uint32_t>());
+        entry.Offset = stream->ReadValue<uint64_t>();
+        entry.Length = stream->ReadValue<uint64_t>();
+        entry.UncompressedLength = stream->ReadValue<uint64_t>();
+        if (entry.Offset > available || entry.Length > available - entry.Offset)
+            throw IOException("Chunk extends past the end of the file.");
+        if (entry.Method != Compression::None && entry.Method != Compression::Zlib)
+            throw IOException("Unsupported chunk compression.");
+        if (entry.Method == Compression::None && entry.Length != entry.UncompressedLength)
+            throw IOException("Invalid chunk length.");
+    }
+}
+
+const ChunkEntry* ChunkFileReader::FindChunk(uint32_t id) const
+{
+    auto it = std::find_if(_entries.begin(), _entries.end(), [id](const ChunkEntry& entry) { return entry.Id == id; });
+    return it != _entries.end() ? &*it : nullptr;
+}
+
+void ChunkFileReader::ReadChunk(uint32_t id, void* data, size_t length)
+{
+    ReadChunks({ { id, data, length } });
+}
+
+std::vector<uint8_t> ChunkFileReader::ReadChunk(uint32_t id)
+{
+    auto entry = FindChunk(id);
+    if (entry == nullptr)
+        throw IOException("Chunk not found.");
+
+    std::vector<uint8_t> result(static_cast<size_t>(entry->UncompressedLength));
+    ReadChunk(id, result.data(), result.size());
+    return result;
+}
+
+void ChunkFileReader::ReadChunks(const std::vector<ChunkRequest>& requests)
+{
+    PROFILE_SCOPE("ChunkFileReader::ReadChunks");
+
+    std::vector<const ChunkEntry*> entries;
+    for (const auto& request : requests)
+    {
+        auto entry = FindChunk(request.Id);
+        if (entry == nullptr)
+            throw IOException("Chunk not found.");
+        if (entry->UncompressedLength != request.Length)
+            throw IOException("Chunk has an unexpected length.");
+        entries.push_back(entry);
+    }
+
+    // Read the data in file order, stored chunks go straight to their destination
+    std::vector<size_t> order(requests.size());
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&entries](size_t a, size_t b) { return entries[a]->Offset < entries[b]->Offset; });
+
+    std::vector<std::vector<uint8_t>> compressedData(requests.size());
+    for (auto i : order)
+    {
+        const auto& entry = *entries[i];
+        _stream->SetPosition(_fileStart + entry.Offset);
+        if (entry.Method == Compression::None)
+        {
+            _stream->Read(requests[i].Data, entry.Length);
+        }
+        else
+        {
+            compressedData[i].resize(static_cast<size_t>(entry.Length));
+            _stream->Read(compressedData[i].data(), entry.Length);
+        }
+    }
+
+    std::atomic<bool> failed{ false };
+    TaskScheduler::Get().ParallelFor(requests.size(), 1, [&](size_t i) {
+        const auto& entry = *entries[i];
+        if (entry.Method != Compression::Zlib)
+            return;
+
+        const auto& src = compressedData[i];
+        auto dstLength = static_cast<uLong>(requests[i].Length);
+        auto result = uncompress(
+            static_cast<Bytef*>(requests[i].Data), &dstLength, src.data(), static_cast<uLong>(src.size()));
+        if (result != Z_OK || dstLength != requests[i].Length)
+        {
+            failed = true;
+        }
+    });
+    if (failed)
+    {
+        throw IOException("Unable to decompress chunk.");
+    }
+}
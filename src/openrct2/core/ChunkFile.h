@@ -0,0 +1,156 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace OpenRCT2
+{
+    struct IStream;
+
+    /**
+     * File made of independently compressed chunks. A table at the start of the file lists the
+     * position and size of every chunk, so a single chunk can be read without decoding the rest.
+     *
+     *   uint32 magic, uint32 version, uint32 chunk count
+     *   chunk count * { uint32 id, uint32 compression, uint64 offset, uint64 length, uint64 uncompressed length }
+     *   chunk data
+     */
+    namespace ChunkFile
+    {
+        constexpr uint32_t MAGIC = 0x4B4E4843; // CHNK
+        constexpr uint32_t VERSION = 1;
+
+        enum class Compression : uint32_t
+        {
+            None,
+            Zlib,
+        };
+
+        struct ChunkEntry
+        {
+            uint32_t Id;
+            Compression Method;
+            uint64_t Offset;
+            uint64_t Length;
+            uint64_t UncompressedLength;
+        };
+
+        /**
+         * Returns true if the stream is positioned at the start of a chunk file, the position is
+         * not changed.
+         */
+        bool IsChunkFile(IStream* stream);
+    } // namespace ChunkFile
+
+    /**
+     * Keeps the chunks of the last file written with it, so chunks that have not changed since are
+     * not compressed again. A cache must only be used by one writer at a time.
+     */
+    class ChunkFileCache
+    {
+    private:
+        friend class ChunkFileWriter;
+
+        struct CachedChunk
+        {
+            std::vector<uint8_t> Data;
+            std::vector<uint8_t> CompressedData;
+            ChunkFile::Compression Method = ChunkFile::Compression::None;
+        };
+
+        std::unordered_map<uint32_t, CachedChunk> _chunks;
+        size_t _numReused = 0;
+
+    public:
+        /**
+         * The number of chunks the last write took from the cache.
+         */
+        size_t GetNumReused() const
+        {
+            return _numReused;
+        }
+
+        void Clear()
+        {
+            _chunks.clear();
+            _numReused = 0;
+        }
+    };
+
+    class ChunkFileWriter
+    {
+    private:
+        struct PendingChunk
+        {
+            uint32_t Id;
+            const void* Data;
+            size_t Length;
+        };
+
+        std::vector<PendingChunk> _chunks;
+
+    public:
+        /**
+         * Adds a chunk to be written, data is not copied and must stay valid until Write returns.
+         */
+        void AddChunk(uint32_t id, const void* data, size_t length);
+
+        /**
+         * Compresses all the chunks in parallel and writes the file to the stream. Chunks identical
+         * to the ones in the cache reuse their compressed data, the cache is then updated.
+         */
+        void Write(IStream* stream, ChunkFileCache* cache = nullptr) const;
+    };
+
+    class ChunkFileReader
+    {
+    public:
+        struct ChunkRequest
+        {
+            uint32_t Id;
+            void* Data;
+            size_t Length;
+        };
+
+    private:
+        IStream* _stream;
+        uint64_t _fileStart;
+        std::vector<ChunkFile::ChunkEntry> _entries;
+
+    public:
+        /**
+         * Reads the chunk table, the stream must stay valid for as long as chunks are read.
+         */
+        explicit ChunkFileReader(IStream* stream);
+
+        const std::vector<ChunkFile::ChunkEntry>& GetEntries() const
+        {
+            return _entries;
+        }
+
+        const ChunkFile::ChunkEntry* FindChunk(uint32_t id) const;
+
+        /**
+         * Reads a chunk which must decompress to exactly length bytes.
+         */
+        void ReadChunk(uint32_t id, void* data, size_t length);
+        std::vector<uint8_t> ReadChunk(uint32_t id);
+
+        /**
+         * Reads several chunks at once, the compressed data is read in file order and then
+         * decompressed in parallel.
+         */
+        void ReadChunks(const std::vector<ChunkRequest>& requests);
+    };
+} // namespace OpenRCT2
@@ -19,12 +19,27 @@ class DataSerialiser
 private:
     OpenRCT2::MemoryStream _stream;
     OpenRCT2::IStream& _activeStream;
+    // Set when the active stream is a memory stream, traits that have an overload for it avoid the virtual calls.
+    OpenRCT2::MemoryStream* _memoryStream = nullptr;
     bool _isSaving = false;
     bool _isLogging = false;
 
 public:
     DataSerialiser(bool isSaving)
         : _activeStream(_stream)
+        , _memoryStream(&_stream)
+        , _isSaving(isSaving)
+        , _isLogging(false)
+    {
+    }
+
+    /**
+     * Reserves capacity bytes up front in the internal stream, so a typical payload does not have to grow it.
+     */
+    DataSerialiser(bool isSaving, size_t capacity)
+        : _stream(capacity)
+        , _activeStream(_stream)
+        , _memoryStream(&_stream)
         , _isSaving(isSaving)
         , _isLogging(false)
     {
@@ -32,6 +47,7 @@ public:
 
     DataSerialiser(bool isSaving, OpenRCT2::IStream& stream, bool isLogging = false)
         : _activeStream(stream)
+        , _memoryStream(dynamic_cast<OpenRCT2::MemoryStream*>(&stream))
         , _isSaving(isSaving)
         , _isLogging(isLogging)
     {
@@ -61,10 +77,10 @@ public:
     {
         if (!_isLogging)
         {
-            if (_isSaving)
-                DataSerializerTraits<T>::encode(&_activeStream, data);
+            if (_memoryStream != nullptr)
+                Serialise<T>(_memoryStream, const_cast<T&>(data));
             else
-                DataSerializerTraits<T>::decode(&_activeStream, const_cast<T&>(data));
+                Serialise<T>(&_activeStream, const_cast<T&>(data));
         }
         else
         {
@@ -78,10 +94,10 @@ public:
     {
         if (!_isLogging)
         {
-            if (_isSaving)
-                DataSerializerTraits<DataSerialiserTag<T>>::encode(&_activeStream, data);
+            if (_memoryStream != nullptr)
+                Serialise<DataSerialiserTag<T>>(_memoryStream, data);
             else
-                DataSerializerTraits<DataSerialiserTag<T>>::decode(&_activeStream, data);
+                Serialise<DataSerialiserTag<T>>(&_activeStream, data);
         }
         else
         {
@@ -90,4 +106,13 @@ public:
 
         return *this;
     }
+
+private:
+    template<typename T, typename TStream> void Serialise(TStream* stream, T& data)
+    {
+        if (_isSaving)
+            DataSerializerTraits<T>::encode(stream, data);
+        else
+            DataSerializerTraits<T>::decode(stream, data);
+    }
 };
@@ -60,6 +60,10 @@ template<typename T> struct DataSerializerTraits_enum
 template<typename T>
 using DataSerializerTraits = std::conditional_t<std::is_enum_v<T>, DataSerializerTraits_enum<T>, DataSerializerTraits_t<T>>;
 
+// Single byte integers are stored as they are, so containers of them can be copied in one go.
+template<typename T>
+constexpr bool DataSerializerIsByte = std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) == 1;
+
 template<typename T> struct DataSerializerTraitsIntegral
 {
     static void encode(OpenRCT2::IStream* stream, const T& val)
@@ -73,6 +77,18 @@ template<typename T> struct DataSerializerTraitsIntegral
         stream->Read(&temp);
         val = ByteSwapBE(temp);
     }
+    // Non-virtual path for the common case of serialising to memory, see DataSerialiser.
+    static void encode(OpenRCT2::MemoryStream* stream, const T& val)
+    {
+        T temp = ByteSwapBE(val);
+        stream->Write<sizeof(T)>(&temp);
+    }
+    static void decode(OpenRCT2::MemoryStream* stream, T& val)
+    {
+        T temp;
+        stream->Read<sizeof(T)>(&temp);
+        val = ByteSwapBE(temp);
+    }
     static void log(OpenRCT2::IStream* stream, const T& val)
     {
         std::stringstream ss;
@@ -245,12 +261,13 @@ template<> struct DataSerializerTraits_t<NetworkRideId_t>
 
 template<typename T> struct DataSerializerTraits_t<DataSerialiserTag<T>>
 {
-    static void encode(OpenRCT2::IStream* stream, const DataSerialiserTag<T>& tag)
+    // Templated on the stream so tagged values keep the memory stream path.
+    template<typename TStream> static void encode(TStream* stream, const DataSerialiserTag<T>& tag)
     {
         DataSerializerTraits<T> s;
         s.encode(stream, tag.Data());
     }
-    static void decode(OpenRCT2::IStream* stream, DataSerialiserTag<T>& tag)
+    template<typename TStream> static void decode(TStream* stream, DataSerialiserTag<T>& tag)
     {
         DataSerializerTraits<T> s;
         s.decode(stream, tag.Data());
@@ -302,10 +319,17 @@ template<typename _Ty, size_t _Size> struct DataSerializerTraitsPODArray
         uint16_t swapped = ByteSwapBE(len);
         stream->Write(&swapped);
 
-        DataSerializerTraits<uint8_t> s;
-        for (auto&& sub : val)
+        if constexpr (DataSerializerIsByte<_Ty>)
         {
-            s.encode(stream, sub);
+            stream->Write(val, _Size);
+        }
+        else
+        {
+            DataSerializerTraits<uint8_t> s;
+            for (auto&& sub : val)
+            {
+                s.encode(stream, sub);
+            }
         }
     }
     static void decode(OpenRCT2::IStream* stream, _Ty (&val)[_Size])
@@ -317,10 +341,17 @@ template<typename _Ty, size_t _Size> struct DataSerializerTraitsPODArray
         if (len != _Size)
             throw std::runtime_error("Invalid size, can't decode");
 
-        DataSerializerTraits<_Ty> s;
-        for (auto&& sub : val)
+        if constexpr (DataSerializerIsByte<_Ty>)
         {
-            s.decode(stream, sub);
+            stream->Read(val, _Size);
+        }
+        else
+        {
+            DataSerializerTraits<_Ty> s;
+            for (auto&& sub : val)
+            {
+                s.decode(stream, sub);
+            }
         }
     }
     static void log(OpenRCT2::IStream* stream, const _Ty (&val)[_Size])
@@ -364,10 +395,17 @@ template<typename _Ty, size_t _Size> struct DataSerializerTraits_t<std::array<_T
         uint16_t swapped = ByteSwapBE(len);
         stream->Write(&swapped);
 
-        DataSerializerTraits<_Ty> s;
-        for (auto&& sub : val)
+        if constexpr (DataSerializerIsByte<_Ty>)
         {
-            s.encode(stream, sub);
+            stream->Write(val.data(), _Size);
+        }
+        else
+        {
+            DataSerializerTraits<_Ty> s;
+            for (auto&& sub : val)
+            {
+                s.encode(stream, sub);
+            }
         }
     }
     static void decode(OpenRCT2::IStream* stream, std::array<_Ty, _Size>& val)
@@ -379,10 +417,17 @@ template<typename _Ty, size_t _Size> struct DataSerializerTraits_t<std::array<_T
         if (len != _Size)
             throw std::runtime_error("Invalid size, can't decode");
 
-        DataSerializerTraits<_Ty> s;
-        for (auto&& sub : val)
+        if constexpr (DataSerializerIsByte<_Ty>)
+        {
+            stream->Read(val.data(), _Size);
+        }
+        else
         {
-            s.decode(stream, sub);
+            DataSerializerTraits<_Ty> s;
+            for (auto&& sub : val)
+            {
+                s.decode(stream, sub);
+            }
         }
     }
     static void log(OpenRCT2::IStream* stream, const std::array<_Ty, _Size>& val)
@@ -406,10 +451,17 @@ template<typename _Ty> struct DataSerializerTraits_t<std::vector<_Ty>>
         uint16_t swapped = ByteSwapBE(len);
         stream->Write(&swapped);
 
-        DataSerializerTraits<_Ty> s;
-        for (auto&& sub : val)
+        if constexpr (DataSerializerIsByte<_Ty>)
         {
-            s.encode(stream, sub);
+            stream->Write(val.data(), val.size());
+        }
+        else
+        {
+            DataSerializerTraits<_Ty> s;
+            for (auto&& sub : val)
+            {
+                s.encode(stream, sub);
+            }
         }
     }
     static void decode(OpenRCT2::IStream* stream, std::vector<_Ty>& val)
@@ -418,12 +470,21 @@ template<typename _Ty> struct DataSerializerTraits_t<std::vector<_Ty>>
         stream->Read(&len);
         len = ByteSwapBE(len);
 
-        DataSerializerTraits<_Ty> s;
-        for (auto i = 0; i < len; ++i)
+        if constexpr (DataSerializerIsByte<_Ty>)
         {
-            _Ty sub{};
-            s.decode(stream, sub);
-            val.push_back(std::move(sub));
+            auto offset = val.size();
+            val.resize(offset + len);
+            stream->Read(val.data() + offset, len);
+        }
+        else
+        {
+            DataSerializerTraits<_Ty> s;
+            for (auto i = 0; i < len; ++i)
+            {
+                _Ty sub{};
+                s.decode(stream, sub);
+                val.push_back(std::move(sub));
+            }
         }
     }
     static void log(OpenRCT2::IStream* stream, const std::vector<_Ty>& val)
@@ -469,37 +530,16 @@ template<> struct DataSerializerTraits_t<MapRange>
 
 template<> struct DataSerializerTraits_t<TileElement>
 {
+    // All the fields are single bytes in order, so the element is copied as it is.
+    static_assert(sizeof(TileElement) == 16);
+
     static void encode(OpenRCT2::IStream* stream, const TileElement& tileElement)
     {
-        stream->WriteValue(tileElement.type);
-        stream->WriteValue(tileElement.Flags);
-        stream->WriteValue(tileElement.base_height);
-        stream->WriteValue(tileElement.clearance_height);
-        stream->WriteValue(tileElement.owner);
-        for (int i = 0; i < 3; ++i)
-        {
-            stream->WriteValue(tileElement.pad_05[i]);
-        }
-        for (int i = 0; i < 8; ++i)
-        {
-            stream->WriteValue(tileElement.pad_08[i]);
-        }
+        stream->Write(&tileElement);
     }
     static void decode(OpenRCT2::IStream* stream, TileElement& tileElement)
     {
-        tileElement.type = stream->ReadValue<uint8_t>();
-        tileElement.Flags = stream->ReadValue<uint8_t>();
-        tileElement.base_height = stream->ReadValue<uint8_t>();
-        tileElement.clearance_height = stream->ReadValue<uint8_t>();
-        tileElement.owner = stream->ReadValue<uint8_t>();
-        for (int i = 0; i < 3; ++i)
-        {
-            tileElement.pad_05[i] = stream->ReadValue<uint8_t>();
-        }
-        for (int i = 0; i < 8; ++i)
-        {
-            tileElement.pad_08[i] = stream->ReadValue<uint8_t>();
-        }
+        stream->Read(&tileElement);
     }
     static void log(OpenRCT2::IStream* stream, const TileElement& tileElement)
     {
@@ -16,12 +16,16 @@
 #include "FileScanner.h"
 #include "FileStream.h"
 #include "JobPool.h"
+#include "MemoryMappedFile.h"
+#include "MemoryStream.h"
 #include "Path.hpp"
 
 #include <chrono>
-#include <list>
+#include <limits>
+#include <optional>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 template<typename TItem> class FileIndex
@@ -35,18 +39,41 @@ private:
         uint32_t PathChecksum = 0;
     };
 
+    struct FileRecord
+    {
+        uint64_t Size = 0;
+        uint64_t LastModified = 0;
+
+        bool operator==(const FileRecord& other) const
+        {
+            return Size == other.Size && LastModified == other.LastModified;
+        }
+    };
+
     struct ScanResult
     {
         DirectoryStats const Stats;
         std::vector<std::string> const Files;
+        std::vector<FileRecord> const Records;
 
-        ScanResult(DirectoryStats stats, std::vector<std::string> files)
+        ScanResult(DirectoryStats stats, std::vector<std::string> files, std::vector<FileRecord> records)
             : Stats(stats)
             , Files(files)
+            , Records(records)
         {
         }
     };
 
+    // A file from the previous index, along with the item it produced if any.
+    struct IndexedFile
+    {
+        FileRecord Record;
+        std::optional<TItem> Item;
+    };
+    using IndexedFileMap = std::unordered_map<std::string, IndexedFile>;
+
+    static constexpr uint32_t NO_ITEM = std::numeric_limits<uint32_t>::max();
+
     struct FileIndexHeader
     {
         uint32_t HeaderSize = sizeof(FileIndexHeader);
@@ -56,10 +83,11 @@ private:
         uint16_t LanguageId = 0;
         DirectoryStats Stats;
         uint32_t NumItems = 0;
+        uint32_t NumFiles = 0;
     };
 
     // Index file format version which when incremented forces a rebuild
-    static constexpr uint8_t FILE_INDEX_VERSION = 4;
+    static constexpr uint8_t FILE_INDEX_VERSION = 5;
 
     std::string const _name;
     uint32_t const _magicNumber;
@@ -102,16 +130,17 @@ public:
     {
         std::vector<TItem> items;
         auto scanResult = Scan();
-        auto readIndexResult = ReadIndexFile(language, scanResult.Stats);
+        IndexedFileMap previousFiles;
+        auto readIndexResult = ReadIndexFile(language, scanResult.Stats, previousFiles);
         if (std::get<0>(readIndexResult))
         {
             // Index was loaded
-            items = std::get<1>(readIndexResult);
+            items = std::move(std::get<1>(readIndexResult));
         }
         else
         {
-            // Index was not loaded
-            items = Build(language, scanResult);
+            // Index was not loaded, only files that changed since the previous index need to be read
+            items = Build(language, scanResult, previousFiles);
         }
         return items;
     }
@@ -119,7 +148,7 @@ public:
     std::vector<TItem> Rebuild(int32_t language) const
     {
         auto scanResult = Scan();
-        auto items = Build(language, scanResult);
+        auto items = Build(language, scanResult, {});
         return items;
     }
 
@@ -140,41 +169,47 @@ private:
     {
         DirectoryStats stats{};
         std::vector<std::string> files;
+        std::vector<FileRecord> records;
         for (const auto& directory : SearchPaths)
         {
             auto absoluteDirectory = Path::GetAbsolute(directory);
             log_verbose("FileIndex:Scanning for %s in '%s'", _pattern.c_str(), absoluteDirectory.c_str());
 
             auto pattern = Path::Combine(absoluteDirectory, _pattern);
-            auto scanner = Path::ScanDirectory(pattern, true);
-            while (scanner->Next())
+            for (auto& file : Path::ScanDirectoryTree(pattern))
             {
-                auto fileInfo = scanner->GetFileInfo();
-                auto path = std::string(scanner->GetPath());
-
                 stats.TotalFiles++;
-                stats.TotalFileSize += fileInfo->Size;
-                stats.FileDateModifiedChecksum ^= static_cast<uint32_t>(fileInfo->LastModified >> 32)
-                    ^ static_cast<uint32_t>(fileInfo->LastModified & 0xFFFFFFFF);
+                stats.TotalFileSize += file.Size;
+                stats.FileDateModifiedChecksum ^= static_cast<uint32_t>(file.LastModified >> 32)
+                    ^ static_cast<uint32_t>(file.LastModified & 0xFFFFFFFF);
                 stats.FileDateModifiedChecksum = ror32(stats.FileDateModifiedChecksum, 5);
-                stats.PathChecksum += GetPathChecksum(path);
+                stats.PathChecksum += GetPathChecksum(file.Path);
 
-                files.push_back(std::move(path));
+                records.push_back({ file.Size, file.LastModified });
+                files.push_back(std::move(file.Path));
             }
-            delete scanner;
         }
-        return ScanResult(stats, files);
+        return ScanResult(stats, files, records);
     }
 
     void BuildRange(
-        int32_t language, const ScanResult& scanResult, size_t rangeStart, size_t rangeEnd, std::vector<TItem>& items,
-        std::atomic<size_t>& processed, std::mutex& printLock) const
+        int32_t language, const ScanResult& scanResult, const IndexedFileMap& previousFiles, size_t rangeStart,
+        size_t rangeEnd, std::vector<std::optional<TItem>>& fileItems, std::atomic<size_t>& processed,
+        std::atomic<size_t>& reused, std::mutex& printLock) const
     {
-        items.reserve(rangeEnd - rangeStart);
         for (size_t i = rangeStart; i < rangeEnd; i++)
         {
             const auto& filePath = scanResult.Files.at(i);
 
+            auto previous = previousFiles.find(filePath);
+            if (previous != previousFiles.end() && previous->second.Record == scanResult.Records.at(i))
+            {
+                fileItems[i] = previous->second.Item;
+                reused++;
+                processed++;
+                continue;
+            }
+
             if (_log_levels[static_cast<uint8_t>(DiagnosticLevel::Verbose)])
             {
                 std::lock_guard<std::mutex> lock(printLock);
@@ -184,28 +219,29 @@ private:
             auto item = Create(language, filePath);
             if (std::get<0>(item))
             {
-                items.push_back(std::get<1>(item));
+                fileItems[i] = std::move(std::get<1>(item));
             }
 
             processed++;
         }
     }
 
-    std::vector<TItem> Build(int32_t language, const ScanResult& scanResult) const
+    std::vector<TItem> Build(int32_t language, const ScanResult& scanResult, const IndexedFileMap& previousFiles) const
     {
         std::vector<TItem> allItems;
         Console::WriteLine("Building %s (%zu items)", _name.c_str(), scanResult.Files.size());
 
         auto startTime = std::chrono::high_resolution_clock::now();
 
+        // Every file gets its own slot so the items keep the order of the scan, whichever job creates them.
         const size_t totalCount = scanResult.Files.size();
+        std::vector<std::optional<TItem>> fileItems(totalCount);
+        std::atomic<size_t> reused = ATOMIC_VAR_INIT(0);
         if (totalCount > 0)
         {
             JobPool jobPool;
             std::mutex printLock; // For verbose prints.
 
-            std::list<std::vector<TItem>> containers;
-
             size_t stepSize = 100; // Handpicked, seems to work well with 4/8 cores.
 
             std::atomic<size_t> processed = ATOMIC_VAR_INIT(0);
@@ -222,33 +258,49 @@ private:
                     stepSize = totalCount - rangeStart;
                 }
 
-                auto& items = containers.emplace_back();
-
                 jobPool.AddTask(std::bind(
-                    &FileIndex<TItem>::BuildRange, this, language, std::cref(scanResult), rangeStart, rangeStart + stepSize,
-                    std::ref(items), std::ref(processed), std::ref(printLock)));
+                    &FileIndex<TItem>::BuildRange, this, language, std::cref(scanResult), std::cref(previousFiles),
+                    rangeStart, rangeStart + stepSize, std::ref(fileItems), std::ref(processed), std::ref(reused),
+                    std::ref(printLock)));
 
                 reportProgress();
             }
 
             jobPool.Join(reportProgress);
+        }
 
-            for (const auto& itr : containers)
+        std::vector<uint32_t> fileItemIndices;
+        fileItemIndices.reserve(totalCount);
+        for (auto& item : fileItems)
+        {
+            if (item.has_value())
+            {
+                fileItemIndices.push_back(static_cast<uint32_t>(allItems.size()));
+                allItems.push_back(std::move(*item));
+            }
+            else
             {
-                allItems.insert(allItems.end(), itr.begin(), itr.end());
+                fileItemIndices.push_back(NO_ITEM);
             }
         }
 
-        WriteIndexFile(language, scanResult.Stats, allItems);
+        WriteIndexFile(language, scanResult, allItems, fileItemIndices);
 
         auto endTime = std::chrono::high_resolution_clock::now();
         auto duration = std::chrono::duration<float>(endTime - startTime);
-        Console::WriteLine("Finished building %s in %.2f seconds.", _name.c_str(), duration.count());
+        Console::WriteLine(
+            "Finished building %s in %.2f seconds, %zu files were unchanged.", _name.c_str(), duration.count(),
+            reused.load());
 
         return allItems;
     }
 
-    std::tuple<bool, std::vector<TItem>> ReadIndexFile(int32_t language, const DirectoryStats& stats) const
+    /**
+     * Reads the items of the index if it is up to date. Otherwise, if the index was written by the same
+     * version for the same language, the files it was built from are added to previousFiles.
+     */
+    std::tuple<bool, std::vector<TItem>> ReadIndexFile(
+        int32_t language, const DirectoryStats& stats, IndexedFileMap& previousFiles) const
     {
         bool loadedItems = false;
         std::vector<TItem> items;
@@ -257,26 +309,53 @@ private:
             try
             {
                 log_verbose("FileIndex:Loading index: '%s'", _indexPath.c_str());
-                auto fs = OpenRCT2::FileStream(_indexPath, OpenRCT2::FILE_MODE_OPEN);
+
+                // Deserialise the items straight from the mapped file rather than through buffered reads of every field
+                auto file = OpenRCT2::MemoryMappedFile(_indexPath);
+                auto fs = OpenRCT2::MemoryStream(file.GetData(), file.GetLength());
 
                 // Read header, check if we need to re-scan
                 auto header = fs.ReadValue<FileIndexHeader>();
-                if (header.HeaderSize == sizeof(FileIndexHeader) && header.MagicNumber == _magicNumber
-                    && header.VersionA == FILE_INDEX_VERSION && header.VersionB == _version && header.LanguageId == language
-                    && header.Stats.TotalFiles == stats.TotalFiles && header.Stats.TotalFileSize == stats.TotalFileSize
+                bool sameFormat = header.HeaderSize == sizeof(FileIndexHeader) && header.MagicNumber == _magicNumber
+                    && header.VersionA == FILE_INDEX_VERSION && header.VersionB == _version
+                    && header.LanguageId == language;
+                bool upToDate = sameFormat && header.Stats.TotalFiles == stats.TotalFiles
+                    && header.Stats.TotalFileSize == stats.TotalFileSize
                     && header.Stats.FileDateModifiedChecksum == stats.FileDateModifiedChecksum
-                    && header.Stats.PathChecksum == stats.PathChecksum)
+                    && header.Stats.PathChecksum == stats.PathChecksum;
+                if (sameFormat)
                 {
                     items.reserve(header.NumItems);
                     DataSerialiser ds(false, fs);
-                    // Directory is the same, just read the saved items
                     for (uint32_t i = 0; i < header.NumItems; i++)
                     {
                         TItem item;
                         Serialise(ds, item);
                         items.emplace_back(std::move(item));
                     }
-                    loadedItems = true;
+
+                    if (upToDate)
+                    {
+                        // Directory is the same, just use the saved items
+                        loadedItems = true;
+                    }
+                    else
+                    {
+                        Console::WriteLine("%s out of date", _name.c_str());
+                        for (uint32_t i = 0; i < header.NumFiles; i++)
+                        {
+                            std::string path;
+                            IndexedFile indexedFile;
+                            uint32_t itemIndex = NO_ITEM;
+                            ds << path << indexedFile.Record.Size << indexedFile.Record.LastModified << itemIndex;
+                            if (itemIndex < items.size())
+                            {
+                                indexedFile.Item = std::move(items[itemIndex]);
+                            }
+                            previousFiles.emplace(std::move(path), std::move(indexedFile));
+                        }
+                        items.clear();
+                    }
                 }
                 else
                 {
@@ -287,12 +366,17 @@ private:
             {
                 Console::Error::WriteLine("Unable to load index: '%s'.", _indexPath.c_str());
                 Console::Error::WriteLine("%s", e.what());
+                loadedItems = false;
+                items.clear();
+                previousFiles.clear();
             }
         }
         return std::make_tuple(loadedItems, std::move(items));
     }
 
-    void WriteIndexFile(int32_t language, const DirectoryStats& stats, std::vector<TItem>& items) const
+    void WriteIndexFile(
+        int32_t language, const ScanResult& scanResult, std::vector<TItem>& items,
+        const std::vector<uint32_t>& fileItemIndices) const
     {
         try
         {
@@ -306,8 +390,9 @@ private:
             header.VersionA = FILE_INDEX_VERSION;
             header.VersionB = _version;
             header.LanguageId = language;
-            header.Stats = stats;
+            header.Stats = scanResult.Stats;
             header.NumItems = static_cast<uint32_t>(items.size());
+            header.NumFiles = static_cast<uint32_t>(scanResult.Files.size());
             fs.WriteValue(header);
 
             DataSerialiser ds(true, fs);
@@ -316,6 +401,15 @@ private:
             {
                 Serialise(ds, item);
             }
+
+            // Write the files the items were created from, so a later build can skip the unchanged ones
+            for (size_t i = 0; i < scanResult.Files.size(); i++)
+            {
+                auto path = scanResult.Files[i];
+                auto record = scanResult.Records[i];
+                auto itemIndex = fileItemIndices[i];
+                ds << path << record.Size << record.LastModified << itemIndex;
+            }
         }
         catch (const std::exception& e)
         {
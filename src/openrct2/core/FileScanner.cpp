@@ -15,6 +15,7 @@
 
 #if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
 #    include <dirent.h>
+#    include <fcntl.h>
 #    include <sys/stat.h>
 #    include <sys/types.h>
 #    include <unistd.h>
@@ -23,14 +24,19 @@
 #    include "../localisation/Language.h"
 #endif
 
+#include "../platform/platform.h"
 #include "FileScanner.h"
 #include "Memory.hpp"
 #include "Path.hpp"
 #include "String.hpp"
+#include "TaskScheduler.h"
 
+#include <algorithm>
 #include <memory>
+#include <mutex>
 #include <stack>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 enum class DIRECTORY_CHILD_TYPE
@@ -176,9 +182,15 @@ private:
 
     bool PatternMatch(const std::string& fileName)
     {
-        for (const auto& pattern : _patterns)
+        return PatternMatch(_patterns, fileName.c_str());
+    }
+
+public:
+    static bool PatternMatch(const std::vector<std::string>& patterns, const utf8* fileName)
+    {
+        for (const auto& pattern : patterns)
         {
-            if (MatchWildcard(fileName.c_str(), pattern.c_str()))
+            if (MatchWildcard(fileName, pattern.c_str()))
             {
                 return true;
             }
@@ -224,12 +236,19 @@ public:
     }
 
     void GetDirectoryChildren(std::vector<DirectoryChild>& children, const std::string& path) override
+    {
+        ListDirectory(children, path);
+    }
+
+    static void ListDirectory(std::vector<DirectoryChild>& children, const std::string& path)
     {
         auto pattern = path + "\\*";
         auto wPattern = String::ToWideChar(pattern.c_str());
 
+        // Skip the short names and fetch the listing in larger batches, which matters on network drives
         WIN32_FIND_DATAW findData;
-        HANDLE hFile = FindFirstFileW(wPattern.c_str(), &findData);
+        HANDLE hFile = FindFirstFileExW(
+            wPattern.c_str(), FindExInfoBasic, &findData, FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH);
         if (hFile != INVALID_HANDLE_VALUE)
         {
             do
@@ -277,21 +296,32 @@ public:
     }
 
     void GetDirectoryChildren(std::vector<DirectoryChild>& children, const std::string& path) override
+    {
+        ListDirectory(children, path);
+    }
+
+    static void ListDirectory(std::vector<DirectoryChild>& children, const std::string& path)
     {
         struct dirent** namelist;
         int32_t count = scandir(path.c_str(), &namelist, FilterFunc, alphasort);
         if (count > 0)
         {
+            // The files are stat'd relative to the directory so the path is not resolved again for each of them
+            int32_t directoryFd = open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
             for (int32_t i = 0; i < count; i++)
             {
                 const struct dirent* node = namelist[i];
                 if (!String::Equals(node->d_name, ".") && !String::Equals(node->d_name, ".."))
                 {
-                    children.push_back(CreateChild(path.c_str(), node));
+                    children.push_back(CreateChild(directoryFd, path.c_str(), node));
                 }
                 free(namelist[i]);
             }
             free(namelist);
+            if (directoryFd != -1)
+            {
+                close(directoryFd);
+            }
         }
     }
 
@@ -301,7 +331,7 @@ private:
         return 1;
     }
 
-    static DirectoryChild CreateChild(const utf8* directory, const struct dirent* node)
+    static DirectoryChild CreateChild(int32_t directoryFd, const utf8* directory, const struct dirent* node)
     {
         DirectoryChild result;
         result.Name = std::string(node->d_name);
@@ -309,6 +339,24 @@ private:
         {
             result.Type = DIRECTORY_CHILD_TYPE::DC_DIRECTORY;
         }
+        else if (directoryFd != -1)
+        {
+            result.Type = DIRECTORY_CHILD_TYPE::DC_FILE;
+
+            struct stat statInfo
+            {
+            };
+            if (fstatat(directoryFd, node->d_name, &statInfo, 0) != -1)
+            {
+                result.Size = statInfo.st_size;
+                result.LastModified = statInfo.st_mtime;
+
+                if (S_ISDIR(statInfo.st_mode))
+                {
+                    result.Type = DIRECTORY_CHILD_TYPE::DC_DIRECTORY;
+                }
+            }
+        }
         else
         {
             result.Type = DIRECTORY_CHILD_TYPE::DC_FILE;
@@ -342,6 +390,176 @@ private:
 
 #endif // defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
 
+static void ListDirectory(std::vector<DirectoryChild>& children, const std::string& path)
+{
+#ifdef _WIN32
+    FileScannerWindows::ListDirectory(children, path);
+#elif defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+    FileScannerUnix::ListDirectory(children, path);
+#endif
+}
+
+namespace
+{
+    struct DirectoryTreeNode
+    {
+        std::string Path;
+        std::vector<DirectoryChild> Listing;
+        // The node of each child that is a directory, in the same order as Listing
+        std::vector<size_t> ChildNodes;
+    };
+
+    /**
+     * Every file under a directory, ordered as FileScannerBase would return them.
+     */
+    struct DirectoryTree
+    {
+        std::string Root;
+        std::vector<ScannedFile> Files;
+    };
+
+    std::mutex _directoryListingCacheMutex;
+    uint32_t _directoryListingCacheScopes;
+    std::unordered_map<std::string, std::shared_ptr<const DirectoryTree>> _directoryListingCache;
+} // namespace
+
+static void FlattenDirectoryTree(const std::vector<DirectoryTreeNode>& nodes, size_t index, std::vector<ScannedFile>& files)
+{
+    const auto& node = nodes[index];
+    for (size_t i = 0; i < node.Listing.size(); i++)
+    {
+        const auto& child = node.Listing[i];
+        if (child.Type == DIRECTORY_CHILD_TYPE::DC_DIRECTORY)
+        {
+            FlattenDirectoryTree(nodes, node.ChildNodes[i], files);
+        }
+        else
+        {
+            files.push_back({ Path::Combine(node.Path, child.Name), child.Size, child.LastModified });
+        }
+    }
+}
+
+static std::shared_ptr<const DirectoryTree> ListDirectoryTree(const std::string& root)
+{
+    std::vector<DirectoryTreeNode> nodes;
+    nodes.push_back({ root, {}, {} });
+
+    // List a whole level of the tree at a time, each directory on its own task as they mostly wait on the disk
+    size_t levelBegin = 0;
+    while (levelBegin < nodes.size())
+    {
+        size_t levelEnd = nodes.size();
+        OpenRCT2::TaskScheduler::Get().ParallelFor(
+            levelEnd - levelBegin, 1, [&nodes, levelBegin](size_t i) {
+                auto& node = nodes[levelBegin + i];
+                ListDirectory(node.Listing, node.Path);
+            });
+
+        for (size_t i = levelBegin; i < levelEnd; i++)
+        {
+            nodes[i].ChildNodes.resize(nodes[i].Listing.size());
+            for (size_t j = 0; j < nodes[i].Listing.size(); j++)
+            {
+                const auto& child = nodes[i].Listing[j];
+                if (child.Type == DIRECTORY_CHILD_TYPE::DC_DIRECTORY)
+                {
+                    nodes[i].ChildNodes[j] = nodes.size();
+                    nodes.push_back({ Path::Combine(nodes[i].Path, child.Name), {}, {} });
+                }
+            }
+        }
+        levelBegin = levelEnd;
+    }
+
+    auto tree = std::make_shared<DirectoryTree>();
+    tree->Root = root;
+    FlattenDirectoryTree(nodes, 0, tree->Files);
+    return tree;
+}
+
+/**
+ * Returns the listing of root, or of a cached directory containing root along with its files that are under root.
+ */
+static std::shared_ptr<const DirectoryTree> GetDirectoryTree(const std::string& root, size_t& filesBegin, size_t& filesEnd)
+{
+    std::shared_ptr<const DirectoryTree> tree;
+    {
+        std::lock_guard<std::mutex> lock(_directoryListingCacheMutex);
+        for (const auto& [cachedRoot, cachedTree] : _directoryListingCache)
+        {
+            if (root == cachedRoot || String::StartsWith(root, cachedRoot + PATH_SEPARATOR))
+            {
+                tree = cachedTree;
+                break;
+            }
+        }
+    }
+
+    if (tree == nullptr)
+    {
+        tree = ListDirectoryTree(root);
+
+        std::lock_guard<std::mutex> lock(_directoryListingCacheMutex);
+        if (_directoryListingCacheScopes != 0)
+        {
+            _directoryListingCache[root] = tree;
+        }
+    }
+
+    filesBegin = 0;
+    filesEnd = tree->Files.size();
+    if (tree->Root != root)
+    {
+        // The files under root follow each other as the listing is depth first
+        auto prefix = root + PATH_SEPARATOR;
+        auto inRoot = [&prefix](const ScannedFile& file) { return String::StartsWith(file.Path, prefix); };
+        auto begin = std::find_if(tree->Files.begin(), tree->Files.end(), inRoot);
+        auto end = std::find_if_not(begin, tree->Files.end(), inRoot);
+        filesBegin = begin - tree->Files.begin();
+        filesEnd = end - tree->Files.begin();
+    }
+    return tree;
+}
+
+std::vector<ScannedFile> Path::ScanDirectoryTree(const std::string& pattern)
+{
+    auto root = Path::GetDirectory(pattern);
+    auto patterns = FileScannerBase::GetPatterns(Path::GetFileName(pattern));
+
+    size_t filesBegin, filesEnd;
+    auto tree = GetDirectoryTree(root, filesBegin, filesEnd);
+
+    std::vector<ScannedFile> result;
+    for (size_t i = filesBegin; i < filesEnd; i++)
+    {
+        const auto& file = tree->Files[i];
+        auto nameStart = file.Path.find_last_of(*PATH_SEPARATOR);
+        auto name = file.Path.c_str() + (nameStart == std::string::npos ? 0 : nameStart + 1);
+        if (FileScannerBase::PatternMatch(patterns, name))
+        {
+            result.push_back(file);
+        }
+    }
+    return result;
+}
+
+Path::DirectoryListingCache::DirectoryListingCache()
+{
+    std::lock_guard<std::mutex> lock(_directoryListingCacheMutex);
+    _directoryListingCacheScopes++;
+}
+
+Path::DirectoryListingCache::~DirectoryListingCache()
+{
+    std::lock_guard<std::mutex> lock(_directoryListingCacheMutex);
+    _directoryListingCacheScopes--;
+    if (_directoryListingCacheScopes == 0)
+    {
+        _directoryListingCache.clear();
+    }
+}
+
 IFileScanner* Path::ScanDirectory(const std::string& pattern, bool recurse)
 {
 #ifdef _WIN32
@@ -33,6 +33,13 @@ struct IFileScanner
     virtual bool Next() abstract;
 };
 
+struct ScannedFile
+{
+    std::string Path;
+    uint64_t Size;
+    uint64_t LastModified;
+};
+
 struct QueryDirectoryResult
 {
     uint32_t TotalFiles;
@@ -59,5 +66,27 @@ namespace Path
      */
     void QueryDirectory(QueryDirectoryResult* result, const std::string& pattern);
 
+    /**
+     * Scans a directory and all sub directories for files that match the given pattern, in the same order as
+     * ScanDirectory. The sub directories of each level are listed in parallel, and while a DirectoryListingCache
+     * is alive, the listing of a directory is shared by all scans of it or of any directory inside it.
+     * @param pattern The path followed by a semi-colon delimited list of wildcard patterns.
+     */
+    std::vector<ScannedFile> ScanDirectoryTree(const std::string& pattern);
+
+    /**
+     * Keeps the listings made by ScanDirectoryTree until the last cache goes out of scope, so scans made close
+     * together (such as the repositories at startup) only walk each directory once. Files added or changed in the
+     * meantime are not seen.
+     */
+    class DirectoryListingCache
+    {
+    public:
+        DirectoryListingCache();
+        DirectoryListingCache(const DirectoryListingCache&) = delete;
+        DirectoryListingCache& operator=(const DirectoryListingCache&) = delete;
+        ~DirectoryListingCache();
+    };
+
     std::vector<std::string> GetDirectories(const std::string& path);
 } // namespace Path
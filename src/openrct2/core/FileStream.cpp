@@ -15,6 +15,7 @@
 #include <algorithm>
 
 #ifndef _WIN32
+#    include <fcntl.h>
 #    include <sys/stat.h>
 #endif
 
@@ -50,6 +51,16 @@ namespace OpenRCT2
                 _canRead = true;
                 _canWrite = false;
                 break;
+            case FILE_MODE_OPEN_SEQUENTIAL:
+#ifdef _WIN32
+                // Opens the file with FILE_FLAG_SEQUENTIAL_SCAN
+                mode = "rbS";
+#else
+                mode = "rb";
+#endif
+                _canRead = true;
+                _canWrite = false;
+                break;
             case FILE_MODE_WRITE:
                 mode = "w+b";
                 _canRead = true;
@@ -79,7 +90,7 @@ namespace OpenRCT2
         auto modeW = String::ToWideChar(mode);
         _file = _wfopen(pathW.c_str(), modeW.c_str());
 #else
-        if (fileMode == FILE_MODE_OPEN)
+        if (fileMode == FILE_MODE_OPEN || fileMode == FILE_MODE_OPEN_SEQUENTIAL)
         {
             struct stat fileStat;
             // Only allow regular files to be opened as its possible to open directories.
@@ -97,6 +108,12 @@ namespace OpenRCT2
         {
             throw IOException(String::StdFormat("Unable to open '%s'", path));
         }
+#if !defined(_WIN32) && defined(POSIX_FADV_SEQUENTIAL)
+        if (fileMode == FILE_MODE_OPEN_SEQUENTIAL)
+        {
+            posix_fadvise(fileno(_file), 0, 0, POSIX_FADV_SEQUENTIAL);
+        }
+#endif
 
         Seek(0, STREAM_SEEK_END);
         _fileSize = GetPosition();
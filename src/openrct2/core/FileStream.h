@@ -20,6 +20,8 @@ namespace OpenRCT2
         FILE_MODE_OPEN,
         FILE_MODE_WRITE,
         FILE_MODE_APPEND,
+        // Like FILE_MODE_OPEN, with a hint to the OS that the file will be read from start to end
+        FILE_MODE_OPEN_SEQUENTIAL,
     };
 
     /**
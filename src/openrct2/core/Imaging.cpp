@@ -351,4 +351,128 @@ namespace Imaging
                 throw std::runtime_error(EXCEPTION_IMAGE_FORMAT_UNKNOWN);
         }
     }
+
+    struct PngRowWriter::Impl
+    {
+        std::ofstream Stream;
+        png_structp Png{};
+        png_infop Info{};
+        png_colorp Palette{};
+        uint32_t Height{};
+        uint32_t RowsWritten{};
+
+        ~Impl()
+        {
+            if (Png != nullptr)
+            {
+                png_free(Png, Palette);
+                png_destroy_write_struct(&Png, &Info);
+            }
+        }
+    };
+
+    PngRowWriter::PngRowWriter(std::string_view path, uint32_t width, uint32_t height, const GamePalette& palette)
+        : _impl(std::make_unique<Impl>())
+    {
+#if defined(_WIN32) && !defined(__MINGW32__)
+        _impl->Stream.open(String::ToWideChar(path), std::ios::binary);
+#else
+        _impl->Stream.open(std::string(path), std::ios::binary);
+#endif
+        if (!_impl->Stream.is_open())
+        {
+            throw std::runtime_error("Unable to open file.");
+        }
+        _impl->Height = height;
+
+        auto png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, PngError, PngWarning);
+        if (png_ptr == nullptr)
+        {
+            throw std::runtime_error("png_create_write_struct failed.");
+        }
+        _impl->Png = png_ptr;
+
+        auto info_ptr = png_create_info_struct(png_ptr);
+        if (info_ptr == nullptr)
+        {
+            throw std::runtime_error("png_create_info_struct failed.");
+        }
+        _impl->Info = info_ptr;
+
+        auto png_palette = static_cast<png_colorp>(png_malloc(png_ptr, PNG_MAX_PALETTE_LENGTH * sizeof(png_color)));
+        if (png_palette == nullptr)
+        {
+            throw std::runtime_error("png_malloc failed.");
+        }
+        _impl->Palette = png_palette;
+        for (size_t i = 0; i < PNG_MAX_PALETTE_LENGTH; i++)
+        {
+            const auto& entry = palette[static_cast<uint16_t>(i)];
+            png_palette[i].blue = entry.Blue;
+            png_palette[i].green = entry.Green;
+            png_palette[i].red = entry.Red;
+        }
+        png_set_PLTE(png_ptr, info_ptr, png_palette, PNG_MAX_PALETTE_LENGTH);
+
+        png_set_write_fn(png_ptr, &_impl->Stream, PngWriteData, PngFlush);
+
+        png_text text_ptr[1];
+        text_ptr[0].key = const_cast<char*>("Software");
+        text_ptr[0].text = const_cast<char*>(gVersionInfoFull);
+        text_ptr[0].compression = PNG_TEXT_COMPRESSION_zTXt;
+
+        if (setjmp(png_jmpbuf(png_ptr)))
+        {
+            throw std::runtime_error("PNG ERROR");
+        }
+
+        png_byte transparentIndex = 0;
+        png_set_tRNS(png_ptr, info_ptr, &transparentIndex, 1, nullptr);
+        png_set_text(png_ptr, info_ptr, text_ptr, 1);
+        png_set_IHDR(
+            png_ptr, info_ptr, width, height, 8, PNG_COLOR_TYPE_PALETTE, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT,
+            PNG_FILTER_TYPE_DEFAULT);
+        png_write_info(png_ptr, info_ptr);
+    }
+
+    PngRowWriter::~PngRowWriter() = default;
+
+    void PngRowWriter::WriteRows(const uint8_t* pixels, uint32_t rows, uint32_t stride)
+    {
+        if (_impl->RowsWritten + rows > _impl->Height)
+        {
+            throw std::runtime_error("Too many rows written to PNG.");
+        }
+
+        auto png_ptr = _impl->Png;
+        if (setjmp(png_jmpbuf(png_ptr)))
+        {
+            throw std::runtime_error("PNG ERROR");
+        }
+        for (uint32_t y = 0; y < rows; y++)
+        {
+            png_write_row(png_ptr, const_cast<png_byte*>(pixels + static_cast<size_t>(y) * stride));
+        }
+        _impl->RowsWritten += rows;
+    }
+
+    void PngRowWriter::Finish()
+    {
+        if (_impl->RowsWritten != _impl->Height)
+        {
+            throw std::runtime_error("Not all rows were written to PNG.");
+        }
+
+        auto png_ptr = _impl->Png;
+        if (setjmp(png_jmpbuf(png_ptr)))
+        {
+            throw std::runtime_error("PNG ERROR");
+        }
+        png_write_end(png_ptr, nullptr);
+        _impl->Stream.flush();
+        if (!_impl->Stream)
+        {
+            throw std::runtime_error("Unable to write file.");
+        }
+    }
 } // namespace Imaging
@@ -52,4 +52,23 @@ namespace Imaging
     void WriteToFile(std::string_view path, const Image& image, IMAGE_FORMAT format = IMAGE_FORMAT::AUTOMATIC);
 
     void SetReader(IMAGE_FORMAT format, ImageReaderFunc impl);
+
+    /**
+     * Writes an 8-bit PNG a few rows at a time, for images too big to keep in memory at once.
+     * The rows are expected from top to bottom, Finish must be called after the last one.
+     */
+    class PngRowWriter
+    {
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> _impl;
+
+    public:
+        PngRowWriter(std::string_view path, uint32_t width, uint32_t height, const GamePalette& palette);
+        PngRowWriter(const PngRowWriter&) = delete;
+        ~PngRowWriter();
+
+        void WriteRows(const uint8_t* pixels, uint32_t rows, uint32_t stride);
+        void Finish();
+    };
 } // namespace Imaging
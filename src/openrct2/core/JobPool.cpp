@@ -9,117 +9,100 @@
 
 #include "JobPool.h"
 
-#include <algorithm>
-#include <cassert>
+#include <thread>
 
-JobPool::TaskData::TaskData(std::function<void()> workFn, std::function<void()> completionFn)
-    : WorkFn(workFn)
+JobPool::TaskData::TaskData(JobPool* pool, std::function<void()> workFn, std::function<void()> completionFn)
+    : Pool(pool)
+    , WorkFn(workFn)
     , CompletionFn(completionFn)
 {
 }
 
 JobPool::JobPool(size_t maxThreads)
+    : _scheduler(OpenRCT2::TaskScheduler::Get())
 {
-    maxThreads = std::min<size_t>(maxThreads, std::thread::hardware_concurrency());
-    for (size_t n = 0; n < maxThreads; n++)
-    {
-        _threads.emplace_back(&JobPool::ProcessQueue, this);
-    }
 }
 
 JobPool::~JobPool()
 {
+    // Tasks reference this pool, they must all have finished before it goes away.
+    if (_pending != 0)
     {
-        unique_lock lock(_mutex);
-        _shouldStop = true;
-        _condPending.notify_all();
+        _scheduler.Wait(_pending);
     }
+}
 
-    for (auto& th : _threads)
+void JobPool::AddTask(std::function<void()> workFn, std::function<void()> completionFn)
+{
+    const TaskData* taskData;
     {
-        assert(th.joinable() != false);
-        th.join();
+        unique_lock lock(_mutex);
+        taskData = &_tasks.emplace_back(this, workFn, completionFn);
     }
+    _scheduler.Submit({ &JobPool::RunTask, const_cast<TaskData*>(taskData), 0, 0, &_pending });
 }
 
-void JobPool::AddTask(std::function<void()> workFn, std::function<void()> completionFn)
+void JobPool::RunTask(void* context, size_t, size_t)
 {
-    unique_lock lock(_mutex);
-    _pending.emplace_back(workFn, completionFn);
-    _condPending.notify_one();
+    auto* taskData = static_cast<const TaskData*>(context);
+    taskData->WorkFn();
+
+    auto* pool = taskData->Pool;
+    unique_lock lock(pool->_mutex);
+    pool->_completed.push_back(taskData);
 }
 
-void JobPool::Join(std::function<void()> reportFn)
+bool JobPool::DispatchCompleted()
 {
+    bool dispatched = false;
     unique_lock lock(_mutex);
-    while (true)
+    while (!_completed.empty())
     {
-        // Wait for the queue to become empty or having completed tasks.
-        _condComplete.wait(lock, [this]() { return (_pending.empty() && _processing == 0) || !_completed.empty(); });
+        auto taskData = _completed.front();
+        _completed.pop_front();
 
-        // Dispatch all completion callbacks if there are any.
-        while (!_completed.empty())
+        if (taskData->CompletionFn)
         {
-            auto taskData = _completed.front();
-            _completed.pop_front();
-
-            if (taskData.CompletionFn)
-            {
-                lock.unlock();
+            lock.unlock();
 
-                taskData.CompletionFn();
+            taskData->CompletionFn();
 
-                lock.lock();
-            }
+            lock.lock();
         }
+        dispatched = true;
+    }
+    return dispatched;
+}
 
-        if (reportFn)
-        {
-            lock.unlock();
+void JobPool::Join(std::function<void()> reportFn)
+{
+    while (true)
+    {
+        // Help out with queued work instead of sleeping, this also makes nested joins safe.
+        bool ranTask = _scheduler.RunPendingTask();
+        bool allDone = _pending.load(std::memory_order_acquire) == 0;
 
+        bool dispatched = DispatchCompleted();
+        if ((dispatched || allDone) && reportFn)
+        {
             reportFn();
-
-            lock.lock();
         }
 
-        // If everything is empty and no more work has to be done we can stop waiting.
-        if (_completed.empty() && _pending.empty() && _processing == 0)
+        if (allDone)
         {
             break;
         }
+        if (!ranTask && !dispatched)
+        {
+            std::this_thread::yield();
+        }
     }
-}
 
-size_t JobPool::CountPending()
-{
-    return _pending.size();
+    unique_lock lock(_mutex);
+    _tasks.clear();
 }
 
-void JobPool::ProcessQueue()
+size_t JobPool::CountPending()
 {
-    unique_lock lock(_mutex);
-    do
-    {
-        // Wait for work or cancellation.
-        _condPending.wait(lock, [this]() { return _shouldStop || !_pending.empty(); });
-
-        if (!_pending.empty())
-        {
-            _processing++;
-
-            auto taskData = _pending.front();
-            _pending.pop_front();
-
-            lock.unlock();
-
-            taskData.WorkFn();
-
-            lock.lock();
-
-            _completed.push_back(std::move(taskData));
-
-            _processing--;
-            _condComplete.notify_one();
-        }
-    } while (!_shouldStop);
+    return _pending;
 }
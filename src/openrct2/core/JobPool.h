@@ -9,37 +9,41 @@
 
 #pragma once
 
+#include "TaskScheduler.h"
+
 #include <atomic>
 #include <condition_variable>
 #include <deque>
 #include <functional>
+#include <list>
 #include <mutex>
-#include <thread>
-#include <vector>
 
+/**
+ * Compatibility layer over the process-wide TaskScheduler, all pools share the same worker threads.
+ * Completion callbacks are still dispatched on the thread calling Join.
+ */
 class JobPool
 {
 private:
     struct TaskData
     {
+        JobPool* const Pool;
         const std::function<void()> WorkFn;
         const std::function<void()> CompletionFn;
 
-        TaskData(std::function<void()> workFn, std::function<void()> completionFn);
+        TaskData(JobPool* pool, std::function<void()> workFn, std::function<void()> completionFn);
     };
 
-    std::atomic_bool _shouldStop = { false };
-    std::atomic<size_t> _processing = { 0 };
-    std::vector<std::thread> _threads;
-    std::deque<TaskData> _pending;
-    std::deque<TaskData> _completed;
-    std::condition_variable _condPending;
-    std::condition_variable _condComplete;
+    OpenRCT2::TaskScheduler& _scheduler;
+    std::atomic<size_t> _pending = { 0 };
+    std::list<TaskData> _tasks;
+    std::deque<const TaskData*> _completed;
     std::mutex _mutex;
 
     using unique_lock = std::unique_lock<std::mutex>;
 
 public:
+    // maxThreads is kept for source compatibility, concurrency is decided by the shared scheduler.
     JobPool(size_t maxThreads = 255);
     ~JobPool();
 
@@ -48,5 +52,6 @@ public:
     size_t CountPending();
 
 private:
-    void ProcessQueue();
+    static void RunTask(void* context, size_t begin, size_t end);
+    bool DispatchCompleted();
 };
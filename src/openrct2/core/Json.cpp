@@ -13,9 +13,28 @@
 #include "Memory.hpp"
 #include "String.hpp"
 
+#include <algorithm>
+
 namespace Json
 {
+    static json_t::parser_callback_t SkipRootKeys(const std::vector<std::string_view>& skippedRootKeys)
+    {
+        return [&skippedRootKeys](int depth, json_t::parse_event_t event, json_t& parsed) {
+            if (event == json_t::parse_event_t::key && depth == 1)
+            {
+                const auto& key = parsed.get_ref<const std::string&>();
+                return std::find(skippedRootKeys.begin(), skippedRootKeys.end(), key) == skippedRootKeys.end();
+            }
+            return true;
+        };
+    }
+
     json_t ReadFromFile(const utf8* path, size_t maxSize)
+    {
+        return ReadFromFile(path, {}, maxSize);
+    }
+
+    json_t ReadFromFile(const utf8* path, const std::vector<std::string_view>& skippedRootKeys, size_t maxSize)
     {
         auto fs = OpenRCT2::FileStream(path, OpenRCT2::FILE_MODE_OPEN);
 
@@ -32,7 +51,14 @@ namespace Json
 
         try
         {
-            json = json_t::parse(fileData);
+            if (skippedRootKeys.empty())
+            {
+                json = json_t::parse(fileData);
+            }
+            else
+            {
+                json = json_t::parse(fileData, SkipRootKeys(skippedRootKeys));
+            }
         }
         catch (const json_t::exception& e)
         {
@@ -81,12 +107,24 @@ namespace Json
     }
 
     json_t FromVector(const std::vector<uint8_t>& vec)
+    {
+        return FromVector(vec, {});
+    }
+
+    json_t FromVector(const std::vector<uint8_t>& vec, const std::vector<std::string_view>& skippedRootKeys)
     {
         json_t json;
 
         try
         {
-            json = json_t::parse(vec.begin(), vec.end());
+            if (skippedRootKeys.empty())
+            {
+                json = json_t::parse(vec.begin(), vec.end());
+            }
+            else
+            {
+                json = json_t::parse(vec.begin(), vec.end(), SkipRootKeys(skippedRootKeys));
+            }
         }
         catch (const json_t::exception& e)
         {
@@ -62,6 +62,15 @@ namespace Json
      */
     json_t FromVector(const std::vector<uint8_t>& vec);
 
+    /**
+     * Parse JSON from a file or a vector of characters, without building the values of the given keys of the root
+     * object, they are checked for syntax but left out. Saves allocating large arrays that are not going to be read.
+     * @note ReadFromFile throws if the JSON cannot be parsed, FromVector returns null like the overload above
+     */
+    json_t ReadFromFile(
+        const utf8* path, const std::vector<std::string_view>& skippedRootKeys, size_t maxSize = MAX_JSON_SIZE);
+    json_t FromVector(const std::vector<uint8_t>& vec, const std::vector<std::string_view>& skippedRootKeys);
+
     /**
      * Explicit type conversion between a JSON object and a compatible number value
      * @param T Destination numeric type
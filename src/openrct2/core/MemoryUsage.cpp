@@ -0,0 +1,61 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "MemoryUsage.h"
+
+#include <atomic>
+#include <mutex>
+
+static constexpr const char* _categoryNames[] = {
+    "tile_elements", "entities", "object_images", "texture_cache", "paint_sessions", "text_caches", "network", "scripts",
+};
+static_assert(std::size(_categoryNames) == MEMORY_USAGE_CATEGORY_COUNT);
+
+static std::mutex _reportersMutex;
+static std::array<MemoryUsageReporter, MEMORY_USAGE_CATEGORY_COUNT> _reporters;
+static std::array<std::atomic<int64_t>, MEMORY_USAGE_CATEGORY_COUNT> _tracked;
+
+const char* MemoryUsageGetCategoryName(MemoryUsageCategory category)
+{
+    auto index = static_cast<size_t>(category);
+    return index < MEMORY_USAGE_CATEGORY_COUNT ? _categoryNames[index] : "unknown";
+}
+
+void MemoryUsageSetReporter(MemoryUsageCategory category, MemoryUsageReporter reporter)
+{
+    std::lock_guard<std::mutex> lock(_reportersMutex);
+    _reporters[static_cast<size_t>(category)] = std::move(reporter);
+}
+
+void MemoryUsageTrack(MemoryUsageCategory category, int64_t bytes)
+{
+    _tracked[static_cast<size_t>(category)].fetch_add(bytes, std::memory_order_relaxed);
+}
+
+MemoryUsageReport MemoryUsageGetReport()
+{
+    // Reporters take their own locks, call them without holding ours so a subsystem can unregister while
+    // it holds its lock
+    std::array<MemoryUsageReporter, MEMORY_USAGE_CATEGORY_COUNT> reporters;
+    {
+        std::lock_guard<std::mutex> lock(_reportersMutex);
+        reporters = _reporters;
+    }
+
+    MemoryUsageReport report;
+    for (size_t i = 0; i < MEMORY_USAGE_CATEGORY_COUNT; i++)
+    {
+        if (reporters[i])
+        {
+            report.Reported[i] = reporters[i]();
+        }
+        report.Tracked[i] = _tracked[i].load(std::memory_order_relaxed);
+    }
+    return report;
+}
@@ -0,0 +1,119 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+enum class MemoryUsageCategory : uint8_t
+{
+    TileElements,
+    Entities,
+    ObjectImages,
+    TextureCache,
+    PaintSessions,
+    TextCaches,
+    Network,
+    Scripts,
+    Count,
+};
+
+constexpr size_t MEMORY_USAGE_CATEGORY_COUNT = static_cast<size_t>(MemoryUsageCategory::Count);
+
+const char* MemoryUsageGetCategoryName(MemoryUsageCategory category);
+
+/**
+ * Returns the number of bytes a subsystem holds right now. It is called from whichever thread asks for a report
+ * so it has to take care of its own locking.
+ */
+using MemoryUsageReporter = std::function<size_t()>;
+
+/**
+ * Registers the reporter of a subsystem, pass nullptr when the subsystem goes away.
+ */
+void MemoryUsageSetReporter(MemoryUsageCategory category, MemoryUsageReporter reporter);
+
+/**
+ * Adds (or with a negative amount removes) bytes to the running count of a category, for memory that is
+ * allocated in many places and is easier to count as it happens than to walk later.
+ */
+void MemoryUsageTrack(MemoryUsageCategory category, int64_t bytes);
+
+struct MemoryUsageReport
+{
+    std::array<size_t, MEMORY_USAGE_CATEGORY_COUNT> Reported{};
+    std::array<int64_t, MEMORY_USAGE_CATEGORY_COUNT> Tracked{};
+
+    size_t Get(MemoryUsageCategory category) const
+    {
+        auto index = static_cast<size_t>(category);
+        return Reported[index] + static_cast<size_t>(std::max<int64_t>(Tracked[index], 0));
+    }
+
+    size_t GetTotal() const
+    {
+        size_t total = 0;
+        for (size_t i = 0; i < MEMORY_USAGE_CATEGORY_COUNT; i++)
+        {
+            total += Get(static_cast<MemoryUsageCategory>(i));
+        }
+        return total;
+    }
+};
+
+MemoryUsageReport MemoryUsageGetReport();
+
+/**
+ * A std::allocator that counts what a container holds under the given category, so hot containers can be
+ * accounted for without a reporter.
+ */
+template<typename T, MemoryUsageCategory TCategory> class TrackingAllocator
+{
+public:
+    using value_type = T;
+
+    template<typename U> struct rebind
+    {
+        using other = TrackingAllocator<U, TCategory>;
+    };
+
+    TrackingAllocator() noexcept = default;
+
+    template<typename U> TrackingAllocator(const TrackingAllocator<U, TCategory>&) noexcept
+    {
+    }
+
+    T* allocate(size_t n)
+    {
+        auto result = std::allocator<T>().allocate(n);
+        MemoryUsageTrack(TCategory, static_cast<int64_t>(n * sizeof(T)));
+        return result;
+    }
+
+    void deallocate(T* p, size_t n) noexcept
+    {
+        std::allocator<T>().deallocate(p, n);
+        MemoryUsageTrack(TCategory, -static_cast<int64_t>(n * sizeof(T)));
+    }
+
+    template<typename U> bool operator==(const TrackingAllocator<U, TCategory>&) const noexcept
+    {
+        return true;
+    }
+
+    template<typename U> bool operator!=(const TrackingAllocator<U, TCategory>&) const noexcept
+    {
+        return false;
+    }
+};
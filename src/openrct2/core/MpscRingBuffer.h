@@ -0,0 +1,111 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * A bounded queue any number of threads can push to without locking, while a single thread pops. Every slot carries
+ * a sequence number that tells the producers whether it is free and the consumer whether it has been written.
+ */
+template<typename _TType> class MpscRingBuffer
+{
+private:
+    struct Slot
+    {
+        std::atomic<size_t> Sequence;
+        _TType Value;
+    };
+
+    std::unique_ptr<Slot[]> _slots;
+    size_t _mask;
+    std::atomic<size_t> _pushPos = { 0 };
+    size_t _popPos = 0;
+
+public:
+    /**
+     * capacity is rounded up to a power of two.
+     */
+    explicit MpscRingBuffer(size_t capacity)
+    {
+        size_t size = 1;
+        while (size < capacity)
+        {
+            size <<= 1;
+        }
+        _slots = std::make_unique<Slot[]>(size);
+        _mask = size - 1;
+        for (size_t i = 0; i < size; i++)
+        {
+            _slots[i].Sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRingBuffer(const MpscRingBuffer&) = delete;
+    MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+
+    /**
+     * Returns false without moving from value when the queue is full.
+     */
+    bool TryPush(_TType&& value)
+    {
+        auto pos = _pushPos.load(std::memory_order_relaxed);
+        Slot* slot;
+        for (;;)
+        {
+            slot = &_slots[pos & _mask];
+            auto sequence = slot->Sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0)
+            {
+                if (_pushPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = _pushPos.load(std::memory_order_relaxed);
+            }
+        }
+        slot->Value = std::move(value);
+        slot->Sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Only to be called from the consumer thread.
+     */
+    bool TryPop(_TType& value)
+    {
+        auto& slot = _slots[_popPos & _mask];
+        auto sequence = slot.Sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(_popPos + 1) < 0)
+            return false;
+
+        value = std::move(slot.Value);
+        slot.Sequence.store(_popPos + _mask + 1, std::memory_order_release);
+        _popPos++;
+        return true;
+    }
+
+    /**
+     * The number of pushes so far, including the ones still being written.
+     */
+    size_t GetPushCount() const
+    {
+        return _pushPos.load(std::memory_order_acquire);
+    }
+};
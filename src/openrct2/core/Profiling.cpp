@@ -0,0 +1,177 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "Profiling.h"
+
+#include "../Diagnostic.h"
+#include "File.h"
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Profiling
+{
+    namespace Detail
+    {
+        std::atomic_bool Capturing = { false };
+    }
+
+    struct ZoneEvent
+    {
+        const char* Name;
+        int64_t Begin;
+        int64_t End;
+    };
+
+    struct ThreadTrack
+    {
+        std::mutex Mutex;
+        uint32_t Id{};
+        std::string Name;
+        std::vector<ZoneEvent> Events;
+    };
+
+    // Tracks are never released as a thread may record a zone at any point of its lifetime.
+    static std::mutex _tracksMutex;
+    static std::vector<std::unique_ptr<ThreadTrack>> _tracks;
+    static thread_local ThreadTrack* _threadTrack = nullptr;
+
+    static std::string _outputPath;
+    static uint32_t _ticksRemaining;
+    static int64_t _captureBegin;
+
+    static ThreadTrack& GetThreadTrack()
+    {
+        if (_threadTrack == nullptr)
+        {
+            std::lock_guard<std::mutex> lock(_tracksMutex);
+            auto& track = _tracks.emplace_back(std::make_unique<ThreadTrack>());
+            track->Id = static_cast<uint32_t>(_tracks.size());
+            track->Name = "Thread " + std::to_string(track->Id);
+            _threadTrack = track.get();
+        }
+        return *_threadTrack;
+    }
+
+    int64_t GetTimestamp()
+    {
+        auto now = std::chrono::steady_clock::now().time_since_epoch();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+    }
+
+    void RecordZone(const char* name, int64_t begin, int64_t end)
+    {
+        auto& track = GetThreadTrack();
+        std::lock_guard<std::mutex> lock(track.Mutex);
+        track.Events.push_back({ name, begin, end });
+    }
+
+    void SetThreadName(const std::string& name)
+    {
+        auto& track = GetThreadTrack();
+        std::lock_guard<std::mutex> lock(track.Mutex);
+        track.Name = name;
+    }
+
+    static void AppendEscaped(std::string& out, const std::string& text)
+    {
+        for (auto c : text)
+        {
+            if (c == '"' || c == '\\')
+                out.push_back('\\');
+            out.push_back(c);
+        }
+    }
+
+    static std::string CreateChromeTrace()
+    {
+        std::string result = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        bool first = true;
+        char buffer[128];
+
+        std::lock_guard<std::mutex> tracksLock(_tracksMutex);
+        for (auto& track : _tracks)
+        {
+            std::lock_guard<std::mutex> lock(track->Mutex);
+            if (!first)
+                result += ',';
+            first = false;
+
+            result += "{\"ph\":\"M\",\"pid\":1,\"tid\":" + std::to_string(track->Id) + ",\"name\":\"thread_name\",\"args\":{\"name\":\"";
+            AppendEscaped(result, track->Name);
+            result += "\"}}";
+
+            for (const auto& e : track->Events)
+            {
+                result += ",{\"ph\":\"X\",\"pid\":1,\"tid\":" + std::to_string(track->Id) + ",\"name\":\"";
+                AppendEscaped(result, e.Name);
+                std::snprintf(
+                    buffer, sizeof(buffer), "\",\"ts\":%.3f,\"dur\":%.3f}", (e.Begin - _captureBegin) / 1000.0,
+                    (e.End - e.Begin) / 1000.0);
+                result += buffer;
+            }
+        }
+        result += "]}";
+        return result;
+    }
+
+    void StartCapture(const std::string& path, uint32_t numTicks)
+    {
+        {
+            std::lock_guard<std::mutex> tracksLock(_tracksMutex);
+            for (auto& track : _tracks)
+            {
+                std::lock_guard<std::mutex> lock(track->Mutex);
+                track->Events.clear();
+            }
+        }
+
+        SetThreadName("Main");
+        _outputPath = path;
+        _ticksRemaining = numTicks;
+        _captureBegin = GetTimestamp();
+        Detail::Capturing = true;
+    }
+
+    bool StopCapture()
+    {
+        if (!IsCapturing())
+            return false;
+
+        Detail::Capturing = false;
+        try
+        {
+            auto trace = CreateChromeTrace();
+            File::WriteAllBytes(_outputPath, trace.data(), trace.size());
+            log_info("Profiling trace written to '%s'", _outputPath.c_str());
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            log_error("Unable to write profiling trace to '%s': %s", _outputPath.c_str(), e.what());
+            return false;
+        }
+    }
+
+    void OnTickEnd()
+    {
+        if (IsCapturing() && _ticksRemaining != 0)
+        {
+            _ticksRemaining--;
+            if (_ticksRemaining == 0)
+            {
+                StopCapture();
+            }
+        }
+    }
+} // namespace Profiling
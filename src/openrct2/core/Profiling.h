@@ -0,0 +1,75 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/**
+ * Lightweight instrumentation that records scoped zones per thread and writes them as a Chrome
+ * trace (chrome://tracing, ui.perfetto.dev). While no capture is running a zone costs a single
+ * relaxed atomic load.
+ */
+namespace Profiling
+{
+    namespace Detail
+    {
+        extern std::atomic_bool Capturing;
+    }
+
+    inline bool IsCapturing()
+    {
+        return Detail::Capturing.load(std::memory_order_relaxed);
+    }
+
+    int64_t GetTimestamp();
+    void RecordZone(const char* name, int64_t begin, int64_t end);
+
+    /**
+     * Starts recording zones, the trace is written to the given path once numTicks game logic
+     * updates have completed. A numTicks of 0 records until StopCapture is called.
+     */
+    void StartCapture(const std::string& path, uint32_t numTicks);
+    bool StopCapture();
+    void OnTickEnd();
+
+    /**
+     * Names the track of the calling thread in the trace.
+     */
+    void SetThreadName(const std::string& name);
+
+    class ScopedZone
+    {
+    private:
+        const char* _name;
+        int64_t _begin;
+
+    public:
+        explicit ScopedZone(const char* name)
+            : _name(name)
+            , _begin(IsCapturing() ? GetTimestamp() : -1)
+        {
+        }
+        ScopedZone(const ScopedZone&) = delete;
+        ScopedZone& operator=(const ScopedZone&) = delete;
+        ~ScopedZone()
+        {
+            if (_begin >= 0)
+            {
+                RecordZone(_name, _begin, GetTimestamp());
+            }
+        }
+    };
+} // namespace Profiling
+
+#define PROFILING_CONCAT_IMPL(a, b) a##b
+#define PROFILING_CONCAT(a, b) PROFILING_CONCAT_IMPL(a, b)
+#define PROFILE_SCOPE(name) Profiling::ScopedZone PROFILING_CONCAT(_profilingZone, __LINE__)(name)
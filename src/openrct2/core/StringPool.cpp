@@ -0,0 +1,150 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "StringPool.h"
+
+#include "Guard.hpp"
+
+#include <cstring>
+
+using namespace OpenRCT2;
+
+StringPool::Handle StringPool::Add(std::string_view value)
+{
+    if (value.empty())
+        return Null;
+
+    auto it = _lookup.find(value);
+    if (it != _lookup.end())
+    {
+        _entries[it->second - 1].References++;
+        return it->second;
+    }
+
+    uint8_t capacityBits = MinCapacityBits;
+    while ((size_t{ 1 } << capacityBits) < value.size() + 1)
+    {
+        capacityBits++;
+    }
+
+    Handle handle;
+    if (!_freeHandles.empty())
+    {
+        handle = _freeHandles.back();
+        _freeHandles.pop_back();
+    }
+    else
+    {
+        _entries.emplace_back();
+        handle = static_cast<Handle>(_entries.size());
+    }
+
+    auto& entry = _entries[handle - 1];
+    entry.Text = Allocate(capacityBits);
+    entry.Length = static_cast<uint32_t>(value.size());
+    entry.CapacityBits = capacityBits;
+    entry.References = 1;
+    std::memcpy(entry.Text, value.data(), value.size());
+    entry.Text[value.size()] = '\0';
+
+    _lookup.emplace(std::string_view(entry.Text, entry.Length), handle);
+    return handle;
+}
+
+void StringPool::AddReference(Handle handle)
+{
+    if (handle == Null)
+        return;
+
+    Guard::Assert(handle <= _entries.size() && _entries[handle - 1].References != 0, "Invalid string pool handle");
+    _entries[handle - 1].References++;
+}
+
+void StringPool::Release(Handle handle)
+{
+    if (handle == Null)
+        return;
+
+    Guard::Assert(handle <= _entries.size() && _entries[handle - 1].References != 0, "Invalid string pool handle");
+    auto& entry = _entries[handle - 1];
+    entry.References--;
+    if (entry.References == 0)
+    {
+        _lookup.erase(std::string_view(entry.Text, entry.Length));
+        _freeSpace[entry.CapacityBits].push_back(entry.Text);
+        _freeHandles.push_back(handle);
+        entry = {};
+    }
+}
+
+const char* StringPool::Get(Handle handle) const
+{
+    if (handle == Null || handle > _entries.size())
+        return nullptr;
+
+    return _entries[handle - 1].Text;
+}
+
+std::string_view StringPool::GetView(Handle handle) const
+{
+    if (handle == Null || handle > _entries.size())
+        return {};
+
+    const auto& entry = _entries[handle - 1];
+    return std::string_view(entry.Text, entry.Length);
+}
+
+size_t StringPool::GetCount() const
+{
+    return _lookup.size();
+}
+
+void StringPool::Clear()
+{
+    _lookup.clear();
+    _entries.clear();
+    _freeHandles.clear();
+    for (auto& space : _freeSpace)
+    {
+        space.clear();
+    }
+    _blocks.clear();
+    _currentBlock = nullptr;
+    _blockUsed = BlockSize;
+}
+
+char* StringPool::Allocate(uint8_t capacityBits)
+{
+    auto& freeSpace = _freeSpace[capacityBits];
+    if (!freeSpace.empty())
+    {
+        auto* space = freeSpace.back();
+        freeSpace.pop_back();
+        return space;
+    }
+
+    auto capacity = size_t{ 1 } << capacityBits;
+    if (capacity > BlockSize / 4)
+    {
+        // Too large to share a block
+        _blocks.push_back(std::make_unique<char[]>(capacity));
+        return _blocks.back().get();
+    }
+
+    if (_blockUsed + capacity > BlockSize)
+    {
+        _blocks.push_back(std::make_unique<char[]>(BlockSize));
+        _currentBlock = _blocks.back().get();
+        _blockUsed = 0;
+    }
+
+    auto* space = _currentBlock + _blockUsed;
+    _blockUsed += capacity;
+    return space;
+}
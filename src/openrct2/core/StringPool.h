@@ -0,0 +1,81 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace OpenRCT2
+{
+    /**
+     * Reference counted strings where equal strings share one copy and one handle. The text is kept in large blocks,
+     * so adding a string rarely allocates, and the pointer returned by Get stays valid while the string is referenced.
+     * Handles are small and safe to copy around with the structure holding them, unlike an owning pointer.
+     */
+    class StringPool
+    {
+    public:
+        using Handle = uint32_t;
+        static constexpr Handle Null = 0;
+
+    private:
+        static constexpr size_t BlockSize = 64 * 1024;
+        static constexpr size_t MinCapacityBits = 4;
+
+        struct Entry
+        {
+            char* Text{};
+            uint32_t Length{};
+            uint8_t CapacityBits{};
+            uint32_t References{};
+        };
+
+        std::vector<std::unique_ptr<char[]>> _blocks;
+        char* _currentBlock{};
+        size_t _blockUsed = BlockSize;
+        std::vector<Entry> _entries;
+        std::vector<Handle> _freeHandles;
+        // Released space, by the power of two it holds
+        std::array<std::vector<char*>, 32> _freeSpace;
+        std::unordered_map<std::string_view, Handle> _lookup;
+
+    public:
+        StringPool() = default;
+        StringPool(const StringPool&) = delete;
+        StringPool& operator=(const StringPool&) = delete;
+
+        /**
+         * Adds a reference to value, copying it into the pool if it is not in it yet. An empty value gives Null.
+         */
+        Handle Add(std::string_view value);
+        void AddReference(Handle handle);
+        void Release(Handle handle);
+
+        /**
+         * The text of handle, null terminated, or nullptr for Null.
+         */
+        const char* Get(Handle handle) const;
+        std::string_view GetView(Handle handle) const;
+
+        size_t GetCount() const;
+
+        /**
+         * Drops every string, for when all the holders of handles have been reset at once.
+         */
+        void Clear();
+
+    private:
+        char* Allocate(uint8_t capacityBits);
+    };
+} // namespace OpenRCT2
@@ -0,0 +1,186 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TaskScheduler.h"
+
+#include "Profiling.h"
+
+#include <cassert>
+#include <limits>
+
+using namespace OpenRCT2;
+
+static constexpr size_t NO_QUEUE = std::numeric_limits<size_t>::max();
+
+// Index of the queue owned by the current thread, only set for worker threads.
+static thread_local size_t _threadQueueIndex = NO_QUEUE;
+
+bool TaskScheduler::WorkQueue::PushBack(const Task& task)
+{
+    std::lock_guard<std::mutex> lock(Mutex);
+    if (Count == Items.size())
+        return false;
+
+    Items[(Head + Count) % Items.size()] = task;
+    Count++;
+    return true;
+}
+
+bool TaskScheduler::WorkQueue::PopBack(Task& task)
+{
+    std::lock_guard<std::mutex> lock(Mutex);
+    if (Count == 0)
+        return false;
+
+    Count--;
+    task = Items[(Head + Count) % Items.size()];
+    return true;
+}
+
+bool TaskScheduler::WorkQueue::PopFront(Task& task)
+{
+    std::lock_guard<std::mutex> lock(Mutex);
+    if (Count == 0)
+        return false;
+
+    task = Items[Head];
+    Head = (Head + 1) % Items.size();
+    Count--;
+    return true;
+}
+
+TaskScheduler& TaskScheduler::Get()
+{
+    // The calling thread always takes part when waiting, so only spawn one worker less than the core count.
+    static TaskScheduler scheduler(std::max<size_t>(std::thread::hardware_concurrency(), 1) - 1);
+    return scheduler;
+}
+
+TaskScheduler::TaskScheduler(size_t numWorkers)
+{
+    for (size_t n = 0; n <= numWorkers; n++)
+    {
+        _queues.push_back(std::make_unique<WorkQueue>());
+    }
+    for (size_t n = 0; n < numWorkers; n++)
+    {
+        _threads.emplace_back(&TaskScheduler::WorkerLoop, this, n);
+    }
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+        _shouldStop = true;
+    }
+    _wakeCondition.notify_all();
+
+    for (auto& th : _threads)
+    {
+        assert(th.joinable() != false);
+        th.join();
+    }
+}
+
+size_t TaskScheduler::GetConcurrency() const
+{
+    return _threads.size() + 1;
+}
+
+void TaskScheduler::Submit(const Task& task)
+{
+    task.Pending->fetch_add(1, std::memory_order_relaxed);
+
+    // Count before pushing so thieves never see more tasks than _queued claims.
+    _queued.fetch_add(1);
+    auto queueIndex = _threadQueueIndex != NO_QUEUE ? _threadQueueIndex : _queues.size() - 1;
+    if (!_queues[queueIndex]->PushBack(task))
+    {
+        // Queue is full, running the task right away keeps submitting allocation free.
+        _queued.fetch_sub(1);
+        Execute(task);
+        return;
+    }
+
+    if (_sleeping.load() != 0)
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+        _wakeCondition.notify_one();
+    }
+}
+
+bool TaskScheduler::RunPendingTask()
+{
+    Task task;
+    auto queueIndex = _threadQueueIndex != NO_QUEUE ? _threadQueueIndex : _queues.size() - 1;
+    if (!TryTakeTask(queueIndex, task))
+        return false;
+
+    Execute(task);
+    return true;
+}
+
+void TaskScheduler::Wait(const std::atomic<size_t>& pending)
+{
+    while (pending.load(std::memory_order_acquire) != 0)
+    {
+        if (!RunPendingTask())
+        {
+            // The remaining tasks are running on other threads.
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool TaskScheduler::TryTakeTask(size_t queueIndex, Task& task)
+{
+    if (_queued.load() == 0)
+        return false;
+
+    // Newest work of our own first as it is most likely to be in cache, then steal the oldest work of others.
+    bool found = _queues[queueIndex]->PopBack(task);
+    for (size_t n = 1; !found && n < _queues.size(); n++)
+    {
+        found = _queues[(queueIndex + n) % _queues.size()]->PopFront(task);
+    }
+    if (found)
+    {
+        _queued.fetch_sub(1);
+    }
+    return found;
+}
+
+void TaskScheduler::Execute(const Task& task)
+{
+    PROFILE_SCOPE("Task");
+    task.Fn(task.Context, task.Begin, task.End);
+    task.Pending->fetch_sub(1, std::memory_order_release);
+}
+
+void TaskScheduler::WorkerLoop(size_t queueIndex)
+{
+    _threadQueueIndex = queueIndex;
+    Profiling::SetThreadName("Worker " + std::to_string(queueIndex + 1));
+
+    Task task;
+    while (!_shouldStop)
+    {
+        if (TryTakeTask(queueIndex, task))
+        {
+            Execute(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_wakeMutex);
+        _sleeping++;
+        _wakeCondition.wait(lock, [this]() { return _shouldStop || _queued.load() != 0; });
+        _sleeping--;
+    }
+}
@@ -0,0 +1,191 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OpenRCT2
+{
+    /**
+     * Process-wide work-stealing scheduler. Each worker owns a bounded deque, it pushes and pops
+     * its own work from the back while idle workers steal from the front of the other deques.
+     * Tasks only reference state owned by the caller, so submitting work never allocates.
+     */
+    class TaskScheduler
+    {
+    public:
+        using TaskFn = void (*)(void* context, size_t begin, size_t end);
+
+        struct Task
+        {
+            TaskFn Fn;
+            void* Context;
+            size_t Begin;
+            size_t End;
+            std::atomic<size_t>* Pending;
+        };
+
+    private:
+        static constexpr size_t QueueCapacity = 1024;
+
+        struct WorkQueue
+        {
+            std::mutex Mutex;
+            std::array<Task, QueueCapacity> Items;
+            size_t Head = 0;
+            size_t Count = 0;
+
+            bool PushBack(const Task& task);
+            bool PopBack(Task& task);
+            bool PopFront(Task& task);
+        };
+
+        std::vector<std::thread> _threads;
+        // One queue per worker, the last queue is shared by all non-worker threads.
+        std::vector<std::unique_ptr<WorkQueue>> _queues;
+        std::atomic<size_t> _queued = { 0 };
+        std::atomic<size_t> _sleeping = { 0 };
+        std::atomic_bool _shouldStop = { false };
+        std::mutex _wakeMutex;
+        std::condition_variable _wakeCondition;
+
+    public:
+        static TaskScheduler& Get();
+
+        explicit TaskScheduler(size_t numWorkers);
+        TaskScheduler(const TaskScheduler&) = delete;
+        TaskScheduler& operator=(const TaskScheduler&) = delete;
+        ~TaskScheduler();
+
+        /**
+         * Number of threads that can execute tasks at the same time, including the waiting thread.
+         */
+        size_t GetConcurrency() const;
+
+        /**
+         * Queues a task, task.Pending is incremented now and decremented once the task has run.
+         */
+        void Submit(const Task& task);
+
+        /**
+         * Runs one queued task on the calling thread, returns false if no task was available.
+         */
+        bool RunPendingTask();
+
+        /**
+         * Blocks until the counter reaches zero, the calling thread executes queued tasks meanwhile
+         * which means it is safe to wait from within a task.
+         */
+        void Wait(const std::atomic<size_t>& pending);
+
+        /**
+         * Calls func(i) for every i in [0, count), split into chunks of grainSize indices.
+         */
+        template<typename TFunc> void ParallelFor(size_t count, size_t grainSize, const TFunc& func)
+        {
+            if (count == 0)
+                return;
+
+            grainSize = std::max<size_t>(grainSize, 1);
+            if (count <= grainSize || _threads.empty())
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    func(i);
+                }
+                return;
+            }
+
+            std::atomic<size_t> pending = { 0 };
+            auto* context = const_cast<void*>(static_cast<const void*>(&func));
+            for (size_t begin = 0; begin < count; begin += grainSize)
+            {
+                auto end = std::min(count, begin + grainSize);
+                Submit({ &InvokeRange<TFunc>, context, begin, end, &pending });
+            }
+            Wait(pending);
+        }
+
+        /**
+         * Calls func(i) for every i in [0, count), picking a grain size that gives each thread a few chunks.
+         */
+        template<typename TFunc> void ParallelFor(size_t count, const TFunc& func)
+        {
+            auto chunks = GetConcurrency() * 4;
+            ParallelFor(count, (count + chunks - 1) / chunks, func);
+        }
+
+    private:
+        void WorkerLoop(size_t queueIndex);
+        bool TryTakeTask(size_t queueIndex, Task& task);
+        static void Execute(const Task& task);
+
+        template<typename TFunc> static void InvokeRange(void* context, size_t begin, size_t end)
+        {
+            const auto& func = *static_cast<const TFunc*>(context);
+            for (size_t i = begin; i < end; i++)
+            {
+                func(i);
+            }
+        }
+    };
+
+    /**
+     * A set of tasks that can be waited on together. Callables passed to Run are referenced, not
+     * copied, so they must stay alive until Wait returns.
+     */
+    class TaskGroup
+    {
+    private:
+        TaskScheduler& _scheduler;
+        std::atomic<size_t> _pending = { 0 };
+
+    public:
+        TaskGroup()
+            : _scheduler(TaskScheduler::Get())
+        {
+        }
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+        ~TaskGroup()
+        {
+            Wait();
+        }
+
+        template<typename TFunc> void Run(const TFunc& func)
+        {
+            _scheduler.Submit({ &Invoke<TFunc>, const_cast<void*>(static_cast<const void*>(&func)), 0, 0, &_pending });
+        }
+
+        void Wait()
+        {
+            _scheduler.Wait(_pending);
+        }
+
+        size_t CountPending() const
+        {
+            return _pending.load(std::memory_order_acquire);
+        }
+
+    private:
+        template<typename TFunc> static void Invoke(void* context, size_t, size_t)
+        {
+            (*static_cast<const TFunc*>(context))();
+        }
+    };
+} // namespace OpenRCT2
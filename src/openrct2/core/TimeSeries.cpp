@@ -0,0 +1,195 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TimeSeries.h"
+
+#include "IStream.hpp"
+
+#include <algorithm>
+
+using namespace OpenRCT2;
+
+static void WriteVarUInt(std::vector<uint8_t>& data, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        data.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    data.push_back(static_cast<uint8_t>(value));
+}
+
+static uint64_t ReadVarUInt(const uint8_t*& data)
+{
+    uint64_t value = 0;
+    for (int32_t shift = 0;; shift += 7)
+    {
+        auto b = *data++;
+        value |= static_cast<uint64_t>(b & 0x7F) << shift;
+        if (!(b & 0x80))
+            return value;
+    }
+}
+
+// Zigzag encoding keeps small negative changes small
+static uint64_t EncodeDelta(int64_t delta)
+{
+    return (static_cast<uint64_t>(delta) << 1) ^ static_cast<uint64_t>(delta >> 63);
+}
+
+static int64_t DecodeDelta(uint64_t value)
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+void TimeSeries::Append(uint32_t tick, int64_t value)
+{
+    if (!_blocks.empty() && tick < _blocks.back().LastTick)
+        return;
+
+    if (_blocks.empty() || _blocks.back().Count >= SamplesPerBlock)
+    {
+        Block block;
+        block.FirstTick = block.LastTick = tick;
+        block.FirstValue = block.LastValue = value;
+        block.Offset = static_cast<uint32_t>(_data.size());
+        block.Count = 1;
+        _blocks.push_back(block);
+        return;
+    }
+
+    auto& block = _blocks.back();
+    WriteVarUInt(_data, tick - block.LastTick);
+    WriteVarUInt(_data, EncodeDelta(value - block.LastValue));
+    block.LastTick = tick;
+    block.LastValue = value;
+    block.Count++;
+}
+
+std::vector<TimeSeriesSample> TimeSeries::GetRange(uint32_t firstTick, uint32_t lastTick) const
+{
+    std::vector<TimeSeriesSample> result;
+    if (firstTick > lastTick)
+        return result;
+
+    // The first block that ends at or after the first tick
+    auto it = std::lower_bound(
+        _blocks.begin(), _blocks.end(), firstTick, [](const Block& block, uint32_t tick) { return block.LastTick < tick; });
+    for (; it != _blocks.end() && it->FirstTick <= lastTick; it++)
+    {
+        const auto& block = *it;
+        auto tick = block.FirstTick;
+        auto value = block.FirstValue;
+        const uint8_t* data = _data.data() + block.Offset;
+        for (uint32_t i = 0; i < block.Count; i++)
+        {
+            if (i != 0)
+            {
+                tick += static_cast<uint32_t>(ReadVarUInt(data));
+                value += DecodeDelta(ReadVarUInt(data));
+            }
+            if (tick > lastTick)
+                return result;
+            if (tick >= firstTick)
+                result.push_back({ tick, value });
+        }
+    }
+    return result;
+}
+
+size_t TimeSeries::GetCount() const
+{
+    size_t count = 0;
+    for (const auto& block : _blocks)
+    {
+        count += block.Count;
+    }
+    return count;
+}
+
+size_t TimeSeries::GetDataSize() const
+{
+    return _data.size() + _blocks.size() * sizeof(Block);
+}
+
+void TimeSeries::Clear()
+{
+    _blocks.clear();
+    _data.clear();
+}
+
+void TimeSeries::Write(IStream& stream) const
+{
+    stream.WriteValue<uint32_t>(static_cast<uint32_t>(_blocks.size()));
+    for (const auto& block : _blocks)
+    {
+        stream.WriteValue<uint32_t>(block.FirstTick);
+        stream.WriteValue<uint32_t>(block.LastTick);
+        stream.WriteValue<int64_t>(block.FirstValue);
+        stream.WriteValue<int64_t>(block.LastValue);
+        stream.WriteValue<uint32_t>(block.Offset);
+        stream.WriteValue<uint32_t>(block.Count);
+    }
+    stream.WriteValue<uint32_t>(static_cast<uint32_t>(_data.size()));
+    stream.Write(_data.data(), _data.size());
+}
+
+void TimeSeries::Read(IStream& stream)
+{
+    Clear();
+
+    constexpr uint64_t blockSize = 4 + 4 + 8 + 8 + 4 + 4;
+    auto numBlocks = stream.ReadValue<uint32_t>();
+    if (numBlocks > (stream.GetLength() - stream.GetPosition()) / blockSize)
+        throw IOException("Invalid time series.");
+
+    std::vector<Block> blocks(numBlocks);
+    for (auto& block : blocks)
+    {
+        block.FirstTick = stream.ReadValue<uint32_t>();
+        block.LastTick = stream.ReadValue<uint32_t>();
+        block.FirstValue = stream.ReadValue<int64_t>();
+        block.LastValue = stream.ReadValue<int64_t>();
+        block.Offset = stream.ReadValue<uint32_t>();
+        block.Count = stream.ReadValue<uint32_t>();
+    }
+    auto dataSize = stream.ReadValue<uint32_t>();
+    if (dataSize > stream.GetLength() - stream.GetPosition())
+        throw IOException("Invalid time series.");
+
+    std::vector<uint8_t> data(dataSize);
+    stream.Read(data.data(), data.size());
+
+    // Check the samples of every block are where it says, so GetRange never reads past the data
+    uint32_t expectedOffset = 0;
+    for (const auto& block : blocks)
+    {
+        if (block.Count == 0 || block.Count > SamplesPerBlock || block.Offset != expectedOffset
+            || block.LastTick < block.FirstTick)
+            throw IOException("Invalid time series.");
+
+        // A tick delta and a value delta for every sample after the first, each ends with a byte below 0x80
+        auto end = block.Offset;
+        for (uint32_t i = 0; i < (block.Count - 1) * 2; i++)
+        {
+            auto start = end;
+            while (end < dataSize && (data[end] & 0x80) && end - start < 10)
+                end++;
+            if (end >= dataSize || (data[end] & 0x80))
+                throw IOException("Invalid time series.");
+            end++;
+        }
+        expectedOffset = end;
+    }
+    if (expectedOffset != dataSize)
+        throw IOException("Invalid time series.");
+
+    _blocks = std::move(blocks);
+    _data = std::move(data);
+}
@@ -0,0 +1,67 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace OpenRCT2
+{
+    struct IStream;
+
+    struct TimeSeriesSample
+    {
+        uint32_t Tick;
+        int64_t Value;
+    };
+
+    /**
+     * An append only series of values over time. Samples are delta encoded as variable length integers in blocks,
+     * a value that changes slowly takes two or three bytes a sample, and each block records its first and last tick
+     * so a range can be read without decoding the rest.
+     */
+    class TimeSeries
+    {
+    private:
+        static constexpr uint32_t SamplesPerBlock = 256;
+
+        struct Block
+        {
+            uint32_t FirstTick{};
+            uint32_t LastTick{};
+            int64_t FirstValue{};
+            int64_t LastValue{};
+            uint32_t Offset{};
+            uint32_t Count{};
+        };
+
+        std::vector<Block> _blocks;
+        std::vector<uint8_t> _data;
+
+    public:
+        /**
+         * Samples have to be appended in tick order, one older than the last sample is ignored.
+         */
+        void Append(uint32_t tick, int64_t value);
+
+        /**
+         * The samples from first to last tick, both included.
+         */
+        std::vector<TimeSeriesSample> GetRange(uint32_t firstTick, uint32_t lastTick) const;
+
+        size_t GetCount() const;
+        size_t GetDataSize() const;
+        void Clear();
+
+        void Write(IStream& stream) const;
+        void Read(IStream& stream);
+    };
+} // namespace OpenRCT2
@@ -12,6 +12,7 @@
 #include "IStream.hpp"
 
 #include <algorithm>
+#include <unordered_map>
 #ifndef __ANDROID__
 #    include <zip.h>
 #endif
@@ -74,6 +75,10 @@ private:
     ZIP_ACCESS _access;
     std::vector<std::vector<uint8_t>> _writeBuffers;
 
+    // Normalised path to index of the first entry with that path, built on first lookup.
+    mutable std::unordered_map<std::string, size_t> _pathIndex;
+    mutable bool _pathIndexValid{};
+
 public:
     ZipArchive(std::string_view path, ZIP_ACCESS access)
     {
@@ -127,6 +132,32 @@ public:
         }
     }
 
+    std::optional<size_t> GetIndexFromPath(std::string_view path) const override
+    {
+        // Objects look up hundreds of images by path, comparing against every entry each time adds up.
+        if (!_pathIndexValid)
+        {
+            _pathIndex.clear();
+            auto numFiles = GetNumFiles();
+            for (size_t i = 0; i < numFiles; i++)
+            {
+                _pathIndex.emplace(NormalisePath(GetFileName(i)), i);
+            }
+            _pathIndexValid = true;
+        }
+
+        auto normalisedPath = NormalisePath(path);
+        if (!normalisedPath.empty())
+        {
+            auto it = _pathIndex.find(normalisedPath);
+            if (it != _pathIndex.end())
+            {
+                return it->second;
+            }
+        }
+        return std::nullopt;
+    }
+
     std::vector<uint8_t> GetFileData(std::string_view path) const override
     {
         std::vector<uint8_t> result;
@@ -179,6 +210,7 @@ public:
         {
             zip_add(_zip, path.data(), source);
         }
+        _pathIndexValid = false;
     }
 
     void DeleteFile(std::string_view path) override
@@ -187,6 +219,7 @@ public:
         if (index)
         {
             zip_delete(_zip, *index);
+            _pathIndexValid = false;
         }
         else
         {
@@ -200,6 +233,7 @@ public:
         if (index)
         {
             zip_file_rename(_zip, *index, newPath.data(), ZIP_FL_ENC_GUESS);
+            _pathIndexValid = false;
         }
         else
         {
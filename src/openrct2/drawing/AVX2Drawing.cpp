@@ -42,6 +42,121 @@ void mask_avx2(
     }
 }
 
+// Looks up 32 bytes in a 256 entry table with one shuffle per 16 entry row of the table. Indices are moved so only
+// the ones in the current row end up in 0x70 to 0x7F, the others have the top bit set which makes the shuffle give 0.
+static inline __m256i lookup_avx2(__m256i indices, const uint8_t* RESTRICT table)
+{
+    const __m256i rowStep = _mm256_set1_epi8(0x10);
+    const __m256i rowBias = _mm256_set1_epi8(0x70);
+    __m256i result = _mm256_setzero_si256();
+    for (int32_t i = 0; i < 16; i++)
+    {
+        // Shuffles stay within 128 bit lanes, so both lanes need the whole row
+        const __m256i entries = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(table + i * 16)));
+        result = _mm256_or_si256(result, _mm256_shuffle_epi8(entries, _mm256_adds_epu8(indices, rowBias)));
+        indices = _mm256_sub_epi8(indices, rowStep);
+    }
+    return result;
+}
+
+void rle_remap_avx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT table, int32_t length)
+{
+    const __m256i zero = {};
+    int32_t i = 0;
+    for (; i + 32 <= length; i += 32)
+    {
+        const __m256i source = _mm256_lddqu_si256(reinterpret_cast<const __m256i*>(src + i));
+        const __m256i dest = _mm256_lddqu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        const __m256i pixels = lookup_avx2(source, table);
+        const __m256i keep = _mm256_or_si256(_mm256_cmpeq_epi8(source, zero), _mm256_cmpeq_epi8(pixels, zero));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_blendv_epi8(pixels, dest, keep));
+    }
+    rle_remap_scalar(src + i, dst + i, table, length - i);
+}
+
+void rle_remap_dst_avx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT table, int32_t length)
+{
+    const __m256i zero = {};
+    int32_t i = 0;
+    for (; i + 32 <= length; i += 32)
+    {
+        const __m256i source = _mm256_lddqu_si256(reinterpret_cast<const __m256i*>(src + i));
+        const __m256i dest = _mm256_lddqu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        const __m256i pixels = lookup_avx2(dest, table);
+        const __m256i keep = _mm256_or_si256(_mm256_cmpeq_epi8(source, zero), _mm256_cmpeq_epi8(pixels, zero));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_blendv_epi8(pixels, dest, keep));
+    }
+    rle_remap_dst_scalar(src + i, dst + i, table, length - i);
+}
+
+void rle_blend_avx2(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT maps, uint32_t mapsLength, int32_t length)
+{
+    int32_t i = 0;
+    if (mapsLength >= 4 && mapsLength <= INT32_MAX)
+    {
+        const __m256i zero = {};
+        const __m128i zero128 = {};
+        const __m256i byteMask = _mm256_set1_epi32(0xFF);
+        const __m256i mapSize = _mm256_set1_epi32(256);
+        const __m256i mapsEnd = _mm256_set1_epi32(static_cast<int32_t>(mapsLength));
+        // Each gathered lane reads four bytes, so the last three entries can not be gathered
+        const __m256i gatherEnd = _mm256_set1_epi32(static_cast<int32_t>(mapsLength) - 3);
+        for (; i + 8 <= length; i += 8)
+        {
+            const __m128i source8 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i));
+            const __m128i dest8 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(dst + i));
+            const __m256i source = _mm256_cvtepu8_epi32(source8);
+            const __m256i dest = _mm256_cvtepu8_epi32(dest8);
+
+            // Same lookup as PaletteMap::Blend, ((src - 1) * 256) + dst
+            const __m256i index = _mm256_add_epi32(_mm256_sub_epi32(_mm256_slli_epi32(source, 8), mapSize), dest);
+            const __m256i opaque = _mm256_xor_si256(_mm256_cmpeq_epi32(source, zero), _mm256_set1_epi32(-1));
+            const __m256i inMaps = _mm256_and_si256(opaque, _mm256_cmpgt_epi32(mapsEnd, index));
+            const __m256i gatherable = _mm256_and_si256(inMaps, _mm256_cmpgt_epi32(gatherEnd, index));
+            if (_mm256_movemask_epi8(_mm256_xor_si256(inMaps, gatherable)) != 0)
+            {
+                break;
+            }
+
+            const __m256i mapped = _mm256_and_si256(
+                _mm256_mask_i32gather_epi32(zero, reinterpret_cast<const int*>(maps), index, gatherable, 1), byteMask);
+            const __m128i words = _mm_packus_epi32(_mm256_castsi256_si128(mapped), _mm256_extracti128_si256(mapped, 1));
+            const __m128i pixels = _mm_packus_epi16(words, words);
+            const __m128i keep = _mm_or_si128(_mm_cmpeq_epi8(source8, zero128), _mm_cmpeq_epi8(pixels, zero128));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i), _mm_blendv_epi8(pixels, dest8, keep));
+        }
+    }
+    rle_blend_scalar(src + i, dst + i, maps, mapsLength, length - i);
+}
+
+void filter_row_avx2(uint8_t* RESTRICT dst, const uint8_t* RESTRICT table, int32_t length)
+{
+    int32_t i = 0;
+    for (; i + 32 <= length; i += 32)
+    {
+        const __m256i dest = _mm256_lddqu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), lookup_avx2(dest, table));
+    }
+    filter_row_scalar(dst + i, table, length - i);
+}
+
+void palette_expand_row_avx2(
+    uint32_t* RESTRICT dst, const uint8_t* RESTRICT src, const uint32_t* RESTRICT palette, int32_t length)
+{
+    const int* table = reinterpret_cast<const int*>(palette);
+    int32_t i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        const __m128i source = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m256i lower = _mm256_i32gather_epi32(table, _mm256_cvtepu8_epi32(source), 4);
+        const __m256i upper = _mm256_i32gather_epi32(table, _mm256_cvtepu8_epi32(_mm_srli_si128(source, 8)), 4);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), lower);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 8), upper);
+    }
+    palette_expand_row_scalar(dst + i, src + i, palette, length - i);
+}
+
 #else
 
 #    ifdef OPENRCT2_X86
@@ -55,4 +170,31 @@ void mask_avx2(
     openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
 }
 
+void rle_remap_avx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT table, int32_t length)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
+void rle_remap_dst_avx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT table, int32_t length)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
+void rle_blend_avx2(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT maps, uint32_t mapsLength, int32_t length)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
+void filter_row_avx2(uint8_t* RESTRICT dst, const uint8_t* RESTRICT table, int32_t length)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
+void palette_expand_row_avx2(
+    uint32_t* RESTRICT dst, const uint8_t* RESTRICT src, const uint32_t* RESTRICT palette, int32_t length)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
 #endif // __AVX2__
@@ -7,10 +7,135 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include "../sprites.h"
 #include "Drawing.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Runs shorter than this are not worth the call into a vectorised kernel.
+static constexpr int32_t RLE_KERNEL_MIN_RUN_LENGTH = 16;
+
+// Zoom levels 1 to 3 have one minified sprite for each alignment of their zoom by zoom pixel blocks.
+static constexpr size_t MINIFIED_SPRITE_SLOT_COUNT = 4 + 16 + 64;
+static constexpr size_t MINIFIED_SPRITE_PAGE_SIZE = 1024;
+static constexpr size_t MINIFIED_SPRITE_PAGE_COUNT = (SPR_IMAGE_LIST_END + MINIFIED_SPRITE_PAGE_SIZE - 1)
+    / MINIFIED_SPRITE_PAGE_SIZE;
+static constexpr size_t MINIFIED_SPRITE_CACHE_MAX_SIZE = 64 * 1024 * 1024;
+
+/**
+ * The pixels of an RLE sprite that are drawn at one zoom level and alignment, as an RLE sprite drawn at zoom level 0.
+ */
+struct MinifiedSprite
+{
+    rct_g1_element Element{};
+    std::vector<uint8_t> Data;
+};
+
+struct MinifiedSpriteImage
+{
+    std::array<std::atomic<MinifiedSprite*>, MINIFIED_SPRITE_SLOT_COUNT> Sprites{};
+};
+
+struct MinifiedSpritePage
+{
+    std::array<std::atomic<MinifiedSpriteImage*>, MINIFIED_SPRITE_PAGE_SIZE> Images{};
+};
+
+// Looked up without a lock while painting, only created and freed under the mutex. Freeing only happens while nothing
+// is being painted.
+static std::array<std::atomic<MinifiedSpritePage*>, MINIFIED_SPRITE_PAGE_COUNT> _minifiedSpritePages{};
+static std::mutex _minifiedSpriteMutex;
+static size_t _minifiedSpriteCacheSize;
+
+// Marks the sprites that could not be minified, they are drawn from the original sprite.
+static MinifiedSprite _minifiedSpriteUnavailable;
+
+void rle_remap_scalar(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT table, int32_t length)
+{
+    for (int32_t i = 0; i < length; i++)
+    {
+        if (src[i] != 0)
+        {
+            auto pixel = table[src[i]];
+            if (pixel != 0)
+            {
+                dst[i] = pixel;
+            }
+        }
+    }
+}
+
+void rle_remap_dst_scalar(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT table, int32_t length)
+{
+    for (int32_t i = 0; i < length; i++)
+    {
+        if (src[i] != 0)
+        {
+            auto pixel = table[dst[i]];
+            if (pixel != 0)
+            {
+                dst[i] = pixel;
+            }
+        }
+    }
+}
+
+void rle_blend_scalar(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT maps, uint32_t mapsLength, int32_t length)
+{
+    for (int32_t i = 0; i < length; i++)
+    {
+        if (src[i] != 0)
+        {
+            // Same lookup as PaletteMap::Blend
+            auto index = ((src[i] - 1) * 256) + dst[i];
+            auto pixel = static_cast<uint32_t>(index) < mapsLength ? maps[index] : 0;
+            if (pixel != 0)
+            {
+                dst[i] = pixel;
+            }
+        }
+    }
+}
+
+/**
+ * Draws a run at zoom level 0 with the kernel registered by rle_init, returns false if the blend op has no kernel or
+ * the palette map cannot be used by one.
+ */
+template<DrawBlendOp TBlendOp>
+static bool BlitRunWithKernel(const uint8_t* src, uint8_t* dst, const PaletteMap& paletteMap, int32_t numPixels)
+{
+    const auto* data = paletteMap.GetData();
+    if (data == nullptr)
+        return false;
+
+    if constexpr (((TBlendOp & BLEND_SRC) != 0) && ((TBlendOp & BLEND_DST) != 0))
+    {
+        rle_blend_fn(src, dst, data, paletteMap.GetDataLength(), numPixels);
+        return true;
+    }
+    else if constexpr ((TBlendOp & BLEND_SRC) != 0)
+    {
+        if (paletteMap.GetDataLength() < 256)
+            return false;
+        rle_remap_fn(src, dst, data, numPixels);
+        return true;
+    }
+    else if constexpr ((TBlendOp & BLEND_DST) != 0)
+    {
+        if (paletteMap.GetDataLength() < 256)
+            return false;
+        rle_remap_dst_fn(src, dst, data, numPixels);
+        return true;
+    }
+    return false;
+}
 
 template<DrawBlendOp TBlendOp, size_t TZoom> static void FASTCALL DrawRLESpriteMagnify(DrawSpriteArgs& args)
 {
@@ -166,6 +291,14 @@ template<DrawBlendOp TBlendOp, size_t TZoom> static void FASTCALL DrawRLESpriteM
             else
             {
                 auto& paletteMap = args.PalMap;
+                if constexpr (TZoom == 0 && (TBlendOp & BLEND_TRANSPARENT) != 0)
+                {
+                    // Every source pixel is drawn at this zoom level so the run is contiguous
+                    if (numPixels >= RLE_KERNEL_MIN_RUN_LENGTH && BlitRunWithKernel<TBlendOp>(src, dst, paletteMap, numPixels))
+                    {
+                        continue;
+                    }
+                }
                 while (numPixels > 0)
                 {
                     BlitPixel<TBlendOp>(src, dst, paletteMap);
@@ -178,6 +311,277 @@ template<DrawBlendOp TBlendOp, size_t TZoom> static void FASTCALL DrawRLESpriteM
     }
 }
 
+static bool IsMinifiedSpriteCacheable(uint32_t image)
+{
+    // Scrolling text and the temporary image change all the time.
+    return image < SPR_SCROLLING_TEXT_START || (image >= SPR_IMAGE_LIST_BEGIN && image < SPR_IMAGE_LIST_END);
+}
+
+static size_t GetMinifiedSpriteSlot(int32_t zoom, int32_t alignX, int32_t alignY)
+{
+    static constexpr size_t firstSlots[] = { 0, 0, 4, 20 };
+    return firstSlots[zoom] + (alignY << zoom) + alignX;
+}
+
+static size_t GetMinifiedSpriteSize(const MinifiedSprite& sprite)
+{
+    return sizeof(MinifiedSprite) + sprite.Data.capacity();
+}
+
+/**
+ * Copies every zoom-th pixel of every zoom-th line from alignX, alignY into a new RLE sprite. Transparent pixels are left
+ * out of the runs as they are not drawn at zoom levels above 0.
+ */
+static std::unique_ptr<MinifiedSprite> CreateMinifiedSprite(
+    const rct_g1_element& g1, int32_t zoom, int32_t alignX, int32_t alignY)
+{
+    const int32_t zoomSize = 1 << zoom;
+    const int32_t width = g1.width > alignX ? ((g1.width - alignX + zoomSize - 1) >> zoom) : 0;
+    const int32_t height = g1.height > alignY ? ((g1.height - alignY + zoomSize - 1) >> zoom) : 0;
+
+    auto sprite = std::make_unique<MinifiedSprite>();
+    auto& data = sprite->Data;
+    data.resize(static_cast<size_t>(height) * 2);
+    std::vector<uint8_t> line(width);
+    for (int32_t y = 0; y < height; y++)
+    {
+        std::fill(line.begin(), line.end(), 0);
+
+        int32_t srcY = alignY + (y << zoom);
+        uint16_t srcLineOffset = g1.offset[srcY * 2] | (g1.offset[srcY * 2 + 1] << 8);
+        auto nextRun = g1.offset + srcLineOffset;
+        auto isEndOfLine = false;
+        while (!isEndOfLine)
+        {
+            auto src = nextRun;
+            auto dataSize = *src++;
+            auto firstPixelX = *src++;
+            isEndOfLine = (dataSize & 0x80) != 0;
+            dataSize &= 0x7F;
+            nextRun = src + dataSize;
+
+            for (int32_t i = 0; i < dataSize; i++)
+            {
+                int32_t x = firstPixelX + i - alignX;
+                if (x >= 0 && (x & (zoomSize - 1)) == 0 && (x >> zoom) < width)
+                {
+                    line[x >> zoom] = src[i];
+                }
+            }
+        }
+
+        if (data.size() > 0xFFFF)
+        {
+            return nullptr;
+        }
+        data[y * 2] = static_cast<uint8_t>(data.size() & 0xFF);
+        data[y * 2 + 1] = static_cast<uint8_t>(data.size() >> 8);
+
+        size_t lastRun = SIZE_MAX;
+        int32_t x = 0;
+        while (x < width)
+        {
+            if (line[x] == 0)
+            {
+                x++;
+                continue;
+            }
+            int32_t runLength = 0;
+            while (x + runLength < width && runLength < 0x7F && line[x + runLength] != 0)
+            {
+                runLength++;
+            }
+            lastRun = data.size();
+            data.push_back(static_cast<uint8_t>(runLength));
+            data.push_back(static_cast<uint8_t>(x));
+            data.insert(data.end(), line.begin() + x, line.begin() + x + runLength);
+            x += runLength;
+        }
+        if (lastRun == SIZE_MAX)
+        {
+            // Empty line
+            data.push_back(0x80);
+            data.push_back(0);
+        }
+        else
+        {
+            data[lastRun] |= 0x80;
+        }
+    }
+    data.shrink_to_fit();
+
+    sprite->Element.offset = data.data();
+    sprite->Element.width = width;
+    sprite->Element.height = height;
+    sprite->Element.flags = G1_FLAG_RLE_COMPRESSION;
+    return sprite;
+}
+
+static const MinifiedSprite* GetMinifiedSprite(
+    uint32_t image, const rct_g1_element& g1, int32_t zoom, int32_t alignX, int32_t alignY)
+{
+    auto& pageSlot = _minifiedSpritePages[image / MINIFIED_SPRITE_PAGE_SIZE];
+    auto slot = GetMinifiedSpriteSlot(zoom, alignX, alignY);
+
+    const MinifiedSprite* sprite = nullptr;
+    auto* page = pageSlot.load(std::memory_order_acquire);
+    if (page != nullptr)
+    {
+        auto* spriteImage = page->Images[image % MINIFIED_SPRITE_PAGE_SIZE].load(std::memory_order_acquire);
+        if (spriteImage != nullptr)
+        {
+            sprite = spriteImage->Sprites[slot].load(std::memory_order_acquire);
+        }
+    }
+
+    if (sprite == nullptr)
+    {
+        std::lock_guard<std::mutex> lock(_minifiedSpriteMutex);
+        page = pageSlot.load(std::memory_order_relaxed);
+        if (page == nullptr)
+        {
+            page = new MinifiedSpritePage();
+            pageSlot.store(page, std::memory_order_release);
+        }
+
+        auto& imageSlot = page->Images[image % MINIFIED_SPRITE_PAGE_SIZE];
+        auto* spriteImage = imageSlot.load(std::memory_order_relaxed);
+        if (spriteImage == nullptr)
+        {
+            spriteImage = new MinifiedSpriteImage();
+            imageSlot.store(spriteImage, std::memory_order_release);
+        }
+
+        auto& spriteSlot = spriteImage->Sprites[slot];
+        sprite = spriteSlot.load(std::memory_order_relaxed);
+        if (sprite == nullptr)
+        {
+            std::unique_ptr<MinifiedSprite> created;
+            if (_minifiedSpriteCacheSize < MINIFIED_SPRITE_CACHE_MAX_SIZE)
+            {
+                created = CreateMinifiedSprite(g1, zoom, alignX, alignY);
+            }
+            if (created != nullptr)
+            {
+                _minifiedSpriteCacheSize += GetMinifiedSpriteSize(*created);
+                sprite = created.release();
+            }
+            else
+            {
+                sprite = &_minifiedSpriteUnavailable;
+            }
+            spriteSlot.store(const_cast<MinifiedSprite*>(sprite), std::memory_order_release);
+        }
+    }
+    return sprite != &_minifiedSpriteUnavailable ? sprite : nullptr;
+}
+
+static void FreeMinifiedSpriteImage(MinifiedSpriteImage* spriteImage)
+{
+    if (spriteImage == nullptr)
+        return;
+
+    for (auto& spriteSlot : spriteImage->Sprites)
+    {
+        auto* sprite = spriteSlot.load(std::memory_order_relaxed);
+        if (sprite != nullptr && sprite != &_minifiedSpriteUnavailable)
+        {
+            _minifiedSpriteCacheSize -= GetMinifiedSpriteSize(*sprite);
+            delete sprite;
+        }
+    }
+    delete spriteImage;
+}
+
+void gfx_invalidate_minified_sprite(uint32_t image)
+{
+    if (!IsMinifiedSpriteCacheable(image))
+        return;
+
+    std::lock_guard<std::mutex> lock(_minifiedSpriteMutex);
+    auto* page = _minifiedSpritePages[image / MINIFIED_SPRITE_PAGE_SIZE].load(std::memory_order_relaxed);
+    if (page != nullptr)
+    {
+        FreeMinifiedSpriteImage(page->Images[image % MINIFIED_SPRITE_PAGE_SIZE].exchange(nullptr));
+    }
+}
+
+void gfx_invalidate_all_minified_sprites()
+{
+    std::lock_guard<std::mutex> lock(_minifiedSpriteMutex);
+    for (auto& pageSlot : _minifiedSpritePages)
+    {
+        auto* page = pageSlot.exchange(nullptr);
+        if (page != nullptr)
+        {
+            for (auto& imageSlot : page->Images)
+            {
+                FreeMinifiedSpriteImage(imageSlot.load(std::memory_order_relaxed));
+            }
+            delete page;
+        }
+    }
+}
+
+/**
+ * Draws an RLE sprite at zoom levels 1 to 3 from a copy holding only the pixels drawn at its zoom level and alignment,
+ * so the runs are drawn whole like at zoom level 0 instead of pixel by pixel. The pixels drawn are the same as
+ * if the original sprite was drawn by gfx_draw_sprite_palette_set_software. Returns false if no copy could be made.
+ */
+bool FASTCALL gfx_rle_sprite_to_buffer_minified(
+    rct_drawpixelinfo* dpi, ImageId imageId, const rct_g1_element& g1, const ScreenCoordsXY& coords,
+    const PaletteMap& paletteMap)
+{
+    auto zoom = static_cast<int8_t>(dpi->zoom_level);
+    auto image = imageId.GetIndex();
+    if (zoom < 1 || zoom > 3 || g1.offset == nullptr || !IsMinifiedSpriteCacheable(image))
+        return false;
+
+    const int32_t zoomMask = (1 << zoom) - 1;
+
+    // The position of the sprite on the destination before zooming, placed and truncated the same way as the original
+    int16_t left = ((coords.x + g1.x_offset) & ~zoomMask) - dpi->x;
+    int16_t top = static_cast<int16_t>(coords.y - zoomMask + g1.y_offset) - dpi->y;
+
+    // Only the pixels that land on a multiple of the zoom are drawn
+    int32_t alignX = -left & zoomMask;
+    int32_t alignY = -top & zoomMask;
+    const auto* sprite = GetMinifiedSprite(image, g1, zoom, alignX, alignY);
+    if (sprite == nullptr)
+        return false;
+
+    const auto& element = sprite->Element;
+    int32_t dstX = (left + alignX) >> zoom;
+    int32_t dstY = (top + alignY) >> zoom;
+
+    // The original leaves out the right most columns that have to be moved over to the next multiple of the zoom,
+    // also when cut off by the right side of the destination.
+    int32_t skipRight = left >= 0 ? (left & zoomMask) : 0;
+    int32_t skipBottom = top >= 0 ? (top & zoomMask) : 0;
+    int32_t srcRight = std::min<int32_t>(element.width, (g1.width - skipRight - alignX + zoomMask) >> zoom);
+    int32_t dstRight = (dpi->width - skipRight + zoomMask) >> zoom;
+    int32_t dstBottom = (dpi->height - skipBottom + zoomMask) >> zoom;
+
+    int32_t srcX = std::max(0, -dstX);
+    int32_t srcY = std::max(0, -dstY);
+    int32_t width = std::min(srcRight, dstRight - dstX) - srcX;
+    int32_t height = std::min<int32_t>(element.height, dstBottom - dstY) - srcY;
+    if (width <= 0 || height <= 0)
+        return true;
+
+    rct_drawpixelinfo minifiedDpi = *dpi;
+    minifiedDpi.x = 0;
+    minifiedDpi.y = 0;
+    minifiedDpi.width = dpi->width / dpi->zoom_level;
+    minifiedDpi.height = dpi->height / dpi->zoom_level;
+    minifiedDpi.zoom_level = 0;
+
+    uint8_t* dst = dpi->bits + (static_cast<size_t>(minifiedDpi.width) + dpi->pitch) * (dstY + srcY) + dstX + srcX;
+    DrawSpriteArgs args(&minifiedDpi, imageId, paletteMap, element, srcX, srcY, width, height, dst);
+    gfx_rle_sprite_to_buffer(args);
+    return true;
+}
+
 template<DrawBlendOp TBlendOp> static void FASTCALL DrawRLESprite(DrawSpriteArgs& args)
 {
     auto zoom_level = static_cast<int8_t>(args.DPI->zoom_level);
@@ -12,6 +12,7 @@
 #include "../PlatformEnvironment.h"
 #include "../config/Config.h"
 #include "../core/FileStream.h"
+#include "../core/MemoryMappedFile.h"
 #include "../core/Path.hpp"
 #include "../platform/platform.h"
 #include "../sprites.h"
@@ -181,6 +182,9 @@ void mask_scalar(
 static rct_gx _g1 = {};
 static rct_gx _g2 = {};
 static rct_gx _csg = {};
+static std::unique_ptr<MemoryMappedFile> _g1Mapping;
+static std::unique_ptr<MemoryMappedFile> _g2Mapping;
+static std::unique_ptr<MemoryMappedFile> _csgMapping;
 static rct_g1_element _scrollingText[MaxScrollingTextEntries]{};
 static bool _csgLoaded = false;
 
@@ -188,6 +192,46 @@ static rct_g1_element _g1Temp = {};
 static std::vector<rct_g1_element> _imageListElements;
 bool gTinyFontAntiAliased = false;
 
+/**
+ * Points the element offsets of a gx file at its sprite data, which starts at the current position of stream. The
+ * data is mapped from the file when possible so only the pages of sprites that are drawn get read, otherwise it is
+ * read into gx.data.
+ */
+static void gx_load_data(rct_gx& gx, std::unique_ptr<MemoryMappedFile>& mapping, const std::string& path, IStream& stream)
+{
+    const uint8_t* data = nullptr;
+    auto dataOffset = stream.GetPosition();
+    try
+    {
+        mapping = std::make_unique<MemoryMappedFile>(path);
+        if (mapping->GetLength() >= dataOffset + gx.header.total_size)
+        {
+            data = mapping->GetData() + dataOffset;
+        }
+        else
+        {
+            // Let reading the data report the truncated file
+            mapping.reset();
+        }
+    }
+    catch (const IOException& e)
+    {
+        log_verbose("Reading sprite data instead of mapping it: %s", e.what());
+        mapping.reset();
+    }
+
+    if (data == nullptr)
+    {
+        gx.data = stream.ReadArray<uint8_t>(gx.header.total_size);
+        data = gx.data.get();
+    }
+
+    for (uint32_t i = 0; i < gx.header.num_entries; i++)
+    {
+        gx.elements[i].offset += reinterpret_cast<uintptr_t>(data);
+    }
+}
+
 /**
  *
  *  rct2: 0x00678998
@@ -195,6 +239,7 @@ bool gTinyFontAntiAliased = false;
 bool gfx_load_g1(const IPlatformEnvironment& env)
 {
     log_verbose("gfx_load_g1(...)");
+    gfx_invalidate_all_minified_sprites();
     try
     {
         auto path = Path::Combine(env.GetDirectoryPath(DIRBASE::RCT2, DIRID::DATA), "g1.dat");
@@ -214,18 +259,13 @@ bool gfx_load_g1(const IPlatformEnvironment& env)
         read_and_convert_gxdat(&fs, _g1.header.num_entries, is_rctc, _g1.elements.data());
         gTinyFontAntiAliased = is_rctc;
 
-        // Read element data
-        _g1.data = fs.ReadArray<uint8_t>(_g1.header.total_size);
-
-        // Fix entry data offsets
-        for (uint32_t i = 0; i < _g1.header.num_entries; i++)
-        {
-            _g1.elements[i].offset += reinterpret_cast<uintptr_t>(_g1.data.get());
-        }
+        // Read element data and fix entry data offsets
+        gx_load_data(_g1, _g1Mapping, path, fs);
         return true;
     }
     catch (const std::exception&)
     {
+        _g1Mapping.reset();
         _g1.elements.clear();
         _g1.elements.shrink_to_fit();
 
@@ -241,21 +281,27 @@ bool gfx_load_g1(const IPlatformEnvironment& env)
 
 void gfx_unload_g1()
 {
+    gfx_invalidate_all_minified_sprites();
     _g1.data.reset();
+    _g1Mapping.reset();
     _g1.elements.clear();
     _g1.elements.shrink_to_fit();
 }
 
 void gfx_unload_g2()
 {
+    gfx_invalidate_all_minified_sprites();
     _g2.data.reset();
+    _g2Mapping.reset();
     _g2.elements.clear();
     _g2.elements.shrink_to_fit();
 }
 
 void gfx_unload_csg()
 {
+    gfx_invalidate_all_minified_sprites();
     _csg.data.reset();
+    _csgMapping.reset();
     _csg.elements.clear();
     _csg.elements.shrink_to_fit();
 }
@@ -263,6 +309,7 @@ void gfx_unload_csg()
 bool gfx_load_g2()
 {
     log_verbose("gfx_load_g2()");
+    gfx_invalidate_all_minified_sprites();
 
     char path[MAX_PATH];
 
@@ -277,18 +324,13 @@ bool gfx_load_g2()
         _g2.elements.resize(_g2.header.num_entries);
         read_and_convert_gxdat(&fs, _g2.header.num_entries, false, _g2.elements.data());
 
-        // Read element data
-        _g2.data = fs.ReadArray<uint8_t>(_g2.header.total_size);
-
-        // Fix entry data offsets
-        for (uint32_t i = 0; i < _g2.header.num_entries; i++)
-        {
-            _g2.elements[i].offset += reinterpret_cast<uintptr_t>(_g2.data.get());
-        }
+        // Read element data and fix entry data offsets
+        gx_load_data(_g2, _g2Mapping, path, fs);
         return true;
     }
     catch (const std::exception&)
     {
+        _g2Mapping.reset();
         _g2.elements.clear();
         _g2.elements.shrink_to_fit();
 
@@ -305,6 +347,7 @@ bool gfx_load_g2()
 bool gfx_load_csg()
 {
     log_verbose("gfx_load_csg()");
+    gfx_invalidate_all_minified_sprites();
 
     if (str_is_null_or_empty(gConfigGeneral.rct1_path))
     {
@@ -334,13 +377,10 @@ bool gfx_load_csg()
         _csg.elements.resize(_csg.header.num_entries);
         read_and_convert_gxdat(&fileHeader, _csg.header.num_entries, false, _csg.elements.data());
 
-        // Read element data
-        _csg.data = fileData.ReadArray<uint8_t>(_csg.header.total_size);
-
-        // Fix entry data offsets
+        // Read element data and fix entry data offsets
+        gx_load_data(_csg, _csgMapping, pathDataPath, fileData);
         for (uint32_t i = 0; i < _csg.header.num_entries; i++)
         {
-            _csg.elements[i].offset += reinterpret_cast<uintptr_t>(_csg.data.get());
             // RCT1 used zoomed offsets that counted from the beginning of the file, rather than from the current sprite.
             if (_csg.elements[i].flags & G1_FLAG_HAS_ZOOM_SPRITE)
             {
@@ -352,6 +392,7 @@ bool gfx_load_csg()
     }
     catch (const std::exception&)
     {
+        _csgMapping.reset();
         _csg.elements.clear();
         _csg.elements.shrink_to_fit();
 
@@ -459,6 +500,12 @@ void FASTCALL gfx_draw_sprite_palette_set_software(
         return;
     }
 
+    if (dpi->zoom_level > 0 && (g1->flags & G1_FLAG_RLE_COMPRESSION)
+        && gfx_rle_sprite_to_buffer_minified(dpi, imageId, *g1, coords, paletteMap))
+    {
+        return;
+    }
+
     // Its used super often so we will define it to a separate variable.
     auto zoom_level = dpi->zoom_level;
     int32_t zoom_mask = zoom_level > 0 ? 0xFFFFFFFF * zoom_level : 0xFFFFFFFF;
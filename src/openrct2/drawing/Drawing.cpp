@@ -13,6 +13,7 @@
 #include "../OpenRCT2.h"
 #include "../common.h"
 #include "../core/Guard.hpp"
+#include "../interface/Window.h"
 #include "../object/Object.h"
 #include "../platform/platform.h"
 #include "../sprites.h"
@@ -575,6 +576,92 @@ void mask_init()
     }
 }
 
+// Default to the scalar kernels so sprites can be drawn before rle_init is called.
+void (*rle_remap_fn)(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT table, int32_t length)
+    = rle_remap_scalar;
+void (*rle_remap_dst_fn)(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT table, int32_t length)
+    = rle_remap_dst_scalar;
+void (*rle_blend_fn)(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT maps, uint32_t mapsLength, int32_t length)
+    = rle_blend_scalar;
+
+void rle_init()
+{
+    if (avx2_available())
+    {
+        log_verbose("registering AVX2 RLE functions");
+        rle_remap_fn = rle_remap_avx2;
+        rle_remap_dst_fn = rle_remap_dst_avx2;
+        rle_blend_fn = rle_blend_avx2;
+    }
+    else if (sse41_available())
+    {
+        // Blending needs a gather which SSE 4.1 does not have, keep it scalar
+        log_verbose("registering SSE4.1 RLE functions");
+        rle_remap_fn = rle_remap_sse4_1;
+        rle_remap_dst_fn = rle_remap_dst_sse4_1;
+        rle_blend_fn = rle_blend_scalar;
+    }
+    else
+    {
+        log_verbose("registering scalar RLE functions");
+        rle_remap_fn = rle_remap_scalar;
+        rle_remap_dst_fn = rle_remap_dst_scalar;
+        rle_blend_fn = rle_blend_scalar;
+    }
+}
+
+void filter_row_scalar(uint8_t* RESTRICT dst, const uint8_t* RESTRICT table, int32_t length)
+{
+    for (int32_t i = 0; i < length; i++)
+    {
+        dst[i] = table[dst[i]];
+    }
+}
+
+void (*filter_row_fn)(uint8_t* RESTRICT dst, const uint8_t* RESTRICT table, int32_t length) = filter_row_scalar;
+
+void filter_init()
+{
+    if (avx2_available())
+    {
+        log_verbose("registering AVX2 filter function");
+        filter_row_fn = filter_row_avx2;
+    }
+    else
+    {
+        log_verbose("registering scalar filter function");
+        filter_row_fn = filter_row_scalar;
+    }
+}
+
+void palette_expand_row_scalar(
+    uint32_t* RESTRICT dst, const uint8_t* RESTRICT src, const uint32_t* RESTRICT palette, int32_t length)
+{
+    for (int32_t i = 0; i < length; i++)
+    {
+        dst[i] = palette[src[i]];
+    }
+}
+
+void (*palette_expand_row_fn)(
+    uint32_t* RESTRICT dst, const uint8_t* RESTRICT src, const uint32_t* RESTRICT palette, int32_t length)
+    = palette_expand_row_scalar;
+
+void palette_expand_init()
+{
+    if (avx2_available())
+    {
+        log_verbose("registering AVX2 palette expand function");
+        palette_expand_row_fn = palette_expand_row_avx2;
+    }
+    else
+    {
+        log_verbose("registering scalar palette expand function");
+        palette_expand_row_fn = palette_expand_row_scalar;
+    }
+}
+
 void gfx_filter_pixel(rct_drawpixelinfo* dpi, const ScreenCoordsXY& coords, FilterPaletteID palette)
 {
     gfx_filter_rect(dpi, { coords, coords }, palette);
@@ -655,6 +742,8 @@ void load_palette()
  */
 void gfx_invalidate_screen()
 {
+    // Anything may have changed, not only what is underneath the windows
+    window_discard_cached_pixels();
     gfx_set_dirty_blocks({ { 0, 0 }, { context_get_width(), context_get_height() } });
 }
 
@@ -537,6 +537,16 @@ public:
     uint8_t operator[](size_t index) const;
     uint8_t Blend(uint8_t src, uint8_t dst) const;
     void Copy(size_t dstIndex, const PaletteMap& src, size_t srcIndex, size_t length);
+
+    const uint8_t* GetData() const
+    {
+        return _data;
+    }
+
+    uint32_t GetDataLength() const
+    {
+        return _dataLength;
+    }
 };
 
 struct DrawSpriteArgs
@@ -719,6 +729,11 @@ size_t ImageListGetMaximum();
 void FASTCALL gfx_sprite_to_buffer(DrawSpriteArgs& args);
 void FASTCALL gfx_bmp_sprite_to_buffer(DrawSpriteArgs& args);
 void FASTCALL gfx_rle_sprite_to_buffer(DrawSpriteArgs& args);
+bool FASTCALL gfx_rle_sprite_to_buffer_minified(
+    rct_drawpixelinfo* dpi, ImageId imageId, const rct_g1_element& g1, const ScreenCoordsXY& coords,
+    const PaletteMap& paletteMap);
+void gfx_invalidate_minified_sprite(uint32_t image);
+void gfx_invalidate_all_minified_sprites();
 void FASTCALL gfx_draw_sprite(rct_drawpixelinfo* dpi, ImageId image_id, const ScreenCoordsXY& coords);
 void FASTCALL gfx_draw_sprite(rct_drawpixelinfo* dpi, int32_t image_id, const ScreenCoordsXY& coords, uint32_t tertiary_colour);
 void FASTCALL
@@ -788,6 +803,45 @@ extern void (*mask_fn)(
     int32_t width, int32_t height, const uint8_t* RESTRICT maskSrc, const uint8_t* RESTRICT colourSrc, uint8_t* RESTRICT dst,
     int32_t maskWrap, int32_t colourWrap, int32_t dstWrap);
 
+// Kernels for a run of RLE sprite pixels at zoom level 0. A pixel is left untouched if its source is transparent or
+// it maps to 0, the same as BlitPixel with BLEND_TRANSPARENT. Remap tables must have at least 256 entries.
+void rle_remap_scalar(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT table, int32_t length);
+void rle_remap_sse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT table, int32_t length);
+void rle_remap_avx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT table, int32_t length);
+void rle_remap_dst_scalar(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT table, int32_t length);
+void rle_remap_dst_sse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT table, int32_t length);
+void rle_remap_dst_avx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT table, int32_t length);
+void rle_blend_scalar(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT maps, uint32_t mapsLength, int32_t length);
+void rle_blend_avx2(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT maps, uint32_t mapsLength, int32_t length);
+void rle_init();
+
+extern void (*rle_remap_fn)(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT table, int32_t length);
+extern void (*rle_remap_dst_fn)(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT table, int32_t length);
+extern void (*rle_blend_fn)(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT maps, uint32_t mapsLength, int32_t length);
+
+// Kernels for a row of a filtered rectangle, every pixel is replaced by its entry in the table which must have at
+// least 256 entries. There is no SSE 4.1 version as its lookup takes longer than the scalar loop.
+void filter_row_scalar(uint8_t* RESTRICT dst, const uint8_t* RESTRICT table, int32_t length);
+void filter_row_avx2(uint8_t* RESTRICT dst, const uint8_t* RESTRICT table, int32_t length);
+void filter_init();
+
+extern void (*filter_row_fn)(uint8_t* RESTRICT dst, const uint8_t* RESTRICT table, int32_t length);
+
+// Kernels for a row of the screen going into a 32 bit texture, every pixel is replaced by its entry in the palette which
+// must have 256 entries. There is no SSE 4.1 version as it has no gather.
+void palette_expand_row_scalar(
+    uint32_t* RESTRICT dst, const uint8_t* RESTRICT src, const uint32_t* RESTRICT palette, int32_t length);
+void palette_expand_row_avx2(
+    uint32_t* RESTRICT dst, const uint8_t* RESTRICT src, const uint32_t* RESTRICT palette, int32_t length);
+void palette_expand_init();
+
+extern void (*palette_expand_row_fn)(
+    uint32_t* RESTRICT dst, const uint8_t* RESTRICT src, const uint32_t* RESTRICT palette, int32_t length);
+
 std::optional<uint32_t> GetPaletteG1Index(colour_t paletteId);
 std::optional<PaletteMap> GetPaletteMapForColour(colour_t paletteId);
 
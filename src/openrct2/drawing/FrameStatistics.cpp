@@ -0,0 +1,212 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "FrameStatistics.h"
+
+#include "../Diagnostic.h"
+#include "../core/File.h"
+#include "../paint/Paint.h"
+#include "TTF.h"
+
+#include <atomic>
+#include <cstdio>
+#include <exception>
+
+static std::atomic<bool> _enabled;
+
+static std::atomic<int64_t> _timings[static_cast<size_t>(FrameTiming::Count)];
+static std::atomic<uint32_t> _sessions;
+static std::atomic<uint32_t> _paintStructs;
+static std::atomic<uint32_t> _attachedPaintStructs;
+static std::atomic<uint32_t> _peakSessionPaintStructs;
+static std::atomic<uint64_t> _pixelsRedrawn;
+static std::atomic<uint32_t> _textureUploads;
+
+#ifndef NO_TTF
+static TTFCacheStatistics _lastTextCacheStatistics;
+#endif
+
+static std::vector<FrameStatistics> _history;
+static size_t _historyIndex;
+
+static std::string _csvPath;
+static std::vector<FrameStatistics> _csvFrames;
+
+static void ResetCurrentFrame()
+{
+    for (auto& timing : _timings)
+    {
+        timing = 0;
+    }
+    _sessions = 0;
+    _paintStructs = 0;
+    _attachedPaintStructs = 0;
+    _peakSessionPaintStructs = 0;
+    _pixelsRedrawn = 0;
+    _textureUploads = 0;
+#ifndef NO_TTF
+    _lastTextCacheStatistics = ttf_get_cache_statistics();
+#endif
+}
+
+bool FrameStatisticsIsEnabled()
+{
+    return _enabled.load(std::memory_order_relaxed);
+}
+
+void FrameStatisticsSetEnabled(bool enabled)
+{
+    if (enabled && !_enabled)
+    {
+        _history.clear();
+        _historyIndex = 0;
+        ResetCurrentFrame();
+    }
+    _enabled = enabled;
+}
+
+void FrameStatisticsAddTiming(FrameTiming timing, std::chrono::steady_clock::duration duration)
+{
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    _timings[static_cast<size_t>(timing)].fetch_add(us, std::memory_order_relaxed);
+}
+
+void FrameStatisticsAddSession(uint32_t paintStructs, uint32_t attachedPaintStructs)
+{
+    if (!FrameStatisticsIsEnabled())
+        return;
+
+    _sessions.fetch_add(1, std::memory_order_relaxed);
+    _paintStructs.fetch_add(paintStructs, std::memory_order_relaxed);
+    _attachedPaintStructs.fetch_add(attachedPaintStructs, std::memory_order_relaxed);
+
+    auto peak = _peakSessionPaintStructs.load(std::memory_order_relaxed);
+    while (paintStructs > peak && !_peakSessionPaintStructs.compare_exchange_weak(peak, paintStructs))
+    {
+    }
+}
+
+void FrameStatisticsAddPixelsRedrawn(uint64_t pixels)
+{
+    if (!FrameStatisticsIsEnabled())
+        return;
+
+    _pixelsRedrawn.fetch_add(pixels, std::memory_order_relaxed);
+}
+
+void FrameStatisticsAddTextureUpload()
+{
+    if (!FrameStatisticsIsEnabled())
+        return;
+
+    _textureUploads.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FrameStatisticsEndFrame()
+{
+    if (!FrameStatisticsIsEnabled())
+        return;
+
+    FrameStatistics frame;
+    for (size_t i = 0; i < std::size(_timings); i++)
+    {
+        frame.Timings[i] = _timings[i];
+    }
+    frame.Sessions = _sessions;
+    frame.PaintStructs = _paintStructs;
+    frame.AttachedPaintStructs = _attachedPaintStructs;
+    frame.PeakSessionPaintStructs = _peakSessionPaintStructs;
+    frame.PaintEntryChunks = PaintEntryPoolGetChunkCount();
+    frame.PixelsRedrawn = _pixelsRedrawn;
+    frame.TextureUploads = _textureUploads;
+#ifndef NO_TTF
+    auto textCacheStatistics = ttf_get_cache_statistics();
+    frame.TextCacheHits = (textCacheStatistics.SurfaceHits - _lastTextCacheStatistics.SurfaceHits)
+        + (textCacheStatistics.WidthHits - _lastTextCacheStatistics.WidthHits);
+    frame.TextCacheMisses = (textCacheStatistics.SurfaceMisses - _lastTextCacheStatistics.SurfaceMisses)
+        + (textCacheStatistics.WidthMisses - _lastTextCacheStatistics.WidthMisses);
+#endif
+    ResetCurrentFrame();
+
+    if (_history.size() < FRAME_STATISTICS_HISTORY_SIZE)
+    {
+        _history.push_back(frame);
+    }
+    else
+    {
+        _history[_historyIndex] = frame;
+        _historyIndex = (_historyIndex + 1) % FRAME_STATISTICS_HISTORY_SIZE;
+    }
+
+    if (!_csvPath.empty())
+    {
+        _csvFrames.push_back(frame);
+    }
+}
+
+std::vector<FrameStatistics> FrameStatisticsGetHistory()
+{
+    std::vector<FrameStatistics> result;
+    result.reserve(_history.size());
+    result.insert(result.end(), _history.begin() + _historyIndex, _history.end());
+    result.insert(result.end(), _history.begin(), _history.begin() + _historyIndex);
+    return result;
+}
+
+void FrameStatisticsStartCsv(const std::string& path)
+{
+    _csvPath = path;
+    _csvFrames.clear();
+}
+
+bool FrameStatisticsIsWritingCsv()
+{
+    return !_csvPath.empty();
+}
+
+bool FrameStatisticsStopCsv()
+{
+    if (_csvPath.empty())
+        return false;
+
+    std::string csv = "frame,total_us,viewports_us,windows_us,generate_us,arrange_us,draw_us,sessions,paint_structs,"
+                      "attached_paint_structs,peak_session_paint_structs,paint_entry_chunks,pixels_redrawn,texture_uploads,"
+                      "text_cache_hits,text_cache_misses\n";
+    char line[256];
+    for (size_t i = 0; i < _csvFrames.size(); i++)
+    {
+        const auto& frame = _csvFrames[i];
+        std::snprintf(
+            line, sizeof(line), "%zu,%lld,%lld,%lld,%lld,%lld,%lld,%u,%u,%u,%u,%u,%llu,%u,%u,%u\n", i,
+            static_cast<long long>(frame.GetTiming(FrameTiming::Total)),
+            static_cast<long long>(frame.GetTiming(FrameTiming::Viewports)),
+            static_cast<long long>(frame.GetTiming(FrameTiming::Windows)),
+            static_cast<long long>(frame.GetTiming(FrameTiming::PaintGenerate)),
+            static_cast<long long>(frame.GetTiming(FrameTiming::PaintArrange)),
+            static_cast<long long>(frame.GetTiming(FrameTiming::PaintDraw)), frame.Sessions, frame.PaintStructs,
+            frame.AttachedPaintStructs, frame.PeakSessionPaintStructs, frame.PaintEntryChunks,
+            static_cast<unsigned long long>(frame.PixelsRedrawn), frame.TextureUploads, frame.TextCacheHits,
+            frame.TextCacheMisses);
+        csv += line;
+    }
+
+    auto path = std::move(_csvPath);
+    _csvPath.clear();
+    _csvFrames.clear();
+    try
+    {
+        File::WriteAllBytes(path, csv.data(), csv.size());
+    }
+    catch (const std::exception& e)
+    {
+        log_error("Unable to write frame statistics to '%s': %s", path.c_str(), e.what());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,114 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+enum class FrameTiming : uint8_t
+{
+    // Summed over the columns, which can be painted by several threads at once
+    PaintGenerate,
+    PaintArrange,
+    PaintDraw,
+    // Wall time
+    Viewports,
+    Windows,
+    Total,
+    Count,
+};
+
+/**
+ * What it took to draw one frame, timings are in microseconds.
+ */
+struct FrameStatistics
+{
+    int64_t Timings[static_cast<size_t>(FrameTiming::Count)]{};
+    uint32_t Sessions{};
+    uint32_t PaintStructs{};
+    uint32_t AttachedPaintStructs{};
+    // Paint structs of the busiest session and the paint entry chunks allocated so far
+    uint32_t PeakSessionPaintStructs{};
+    uint32_t PaintEntryChunks{};
+    uint64_t PixelsRedrawn{};
+    uint32_t TextureUploads{};
+    uint32_t TextCacheHits{};
+    uint32_t TextCacheMisses{};
+
+    int64_t GetTiming(FrameTiming timing) const
+    {
+        return Timings[static_cast<size_t>(timing)];
+    }
+};
+
+constexpr size_t FRAME_STATISTICS_HISTORY_SIZE = 120;
+
+/**
+ * The statistics are only gathered while enabled, all the Add functions can be called from any thread.
+ */
+bool FrameStatisticsIsEnabled();
+void FrameStatisticsSetEnabled(bool enabled);
+
+void FrameStatisticsAddTiming(FrameTiming timing, std::chrono::steady_clock::duration duration);
+void FrameStatisticsAddSession(uint32_t paintStructs, uint32_t attachedPaintStructs);
+void FrameStatisticsAddPixelsRedrawn(uint64_t pixels);
+void FrameStatisticsAddTextureUpload();
+
+/**
+ * Moves the statistics gathered since the last call into the history, called once at the end of each frame.
+ */
+void FrameStatisticsEndFrame();
+
+/**
+ * The frames drawn most recently, oldest first.
+ */
+std::vector<FrameStatistics> FrameStatisticsGetHistory();
+
+/**
+ * Keeps every frame from now on until FrameStatisticsStopCsv writes them to path as CSV.
+ */
+void FrameStatisticsStartCsv(const std::string& path);
+bool FrameStatisticsIsWritingCsv();
+bool FrameStatisticsStopCsv();
+
+/**
+ * Adds the time until it goes out of scope, does nothing when the statistics are disabled.
+ */
+class FrameTimingScope
+{
+private:
+    FrameTiming _timing;
+    bool _enabled;
+    std::chrono::steady_clock::time_point _start;
+
+public:
+    explicit FrameTimingScope(FrameTiming timing)
+        : _timing(timing)
+        , _enabled(FrameStatisticsIsEnabled())
+    {
+        if (_enabled)
+        {
+            _start = std::chrono::steady_clock::now();
+        }
+    }
+
+    FrameTimingScope(const FrameTimingScope&) = delete;
+
+    ~FrameTimingScope()
+    {
+        if (_enabled)
+        {
+            FrameStatisticsAddTiming(_timing, std::chrono::steady_clock::now() - _start);
+        }
+    }
+};
@@ -11,7 +11,10 @@
 
 #include "../core/Imaging.h"
 
+#include <algorithm>
+#include <array>
 #include <cstring>
+#include <limits>
 #include <stdexcept>
 #include <string>
 
@@ -20,6 +23,175 @@ using ImportResult = ImageImporter::ImportResult;
 
 constexpr int32_t PALETTE_TRANSPARENT = -1;
 
+/**
+ * @returns true if pixel index is an index not used for remapping.
+ */
+static bool IsChangablePaletteIndex(int32_t paletteIndex)
+{
+    if (paletteIndex == PALETTE_TRANSPARENT)
+        return true;
+    if (paletteIndex == 0)
+        return false;
+    if (paletteIndex >= 203 && paletteIndex < 214)
+        return false;
+    if (paletteIndex == 226)
+        return false;
+    if (paletteIndex >= 227 && paletteIndex < 229)
+        return false;
+    if (paletteIndex >= 243)
+        return false;
+    return true;
+}
+
+/**
+ * Lookup tables for StandardPalette, replacing the linear searches through the palette that used
+ * to be done for every pixel, up to five times per pixel when dithering.
+ */
+class StandardPaletteLookup
+{
+private:
+    static constexpr size_t HashSize = 1024;
+    static constexpr uint32_t EmptySlot = 0;
+
+    // Open addressing table of 0xFFRRGGBB to the first palette index with that colour.
+    std::array<uint32_t, HashSize> _keys{};
+    std::array<uint8_t, HashSize> _values{};
+
+    // Colours that can be picked as the closest match, sorted by the sum of their channels.
+    struct Candidate
+    {
+        int32_t Sum;
+        int32_t Red;
+        int32_t Green;
+        int32_t Blue;
+        int32_t Index;
+    };
+    std::array<Candidate, PALETTE_SIZE> _candidates{};
+    size_t _numCandidates{};
+
+    static uint32_t GetKey(int32_t r, int32_t g, int32_t b)
+    {
+        return 0xFF000000 | (r << 16) | (g << 8) | b;
+    }
+
+    static size_t GetSlot(uint32_t key)
+    {
+        return ((key * 2654435761u) >> 22) % HashSize;
+    }
+
+public:
+    StandardPaletteLookup()
+    {
+        for (int32_t i = 0; i < PALETTE_SIZE; i++)
+        {
+            const auto& entry = StandardPalette[i];
+            auto key = GetKey(entry.Red, entry.Green, entry.Blue);
+            auto slot = GetSlot(key);
+            while (_keys[slot] != EmptySlot && _keys[slot] != key)
+            {
+                slot = (slot + 1) % HashSize;
+            }
+            if (_keys[slot] == EmptySlot)
+            {
+                _keys[slot] = key;
+                _values[slot] = static_cast<uint8_t>(i);
+            }
+
+            if (IsChangablePaletteIndex(i))
+            {
+                auto sum = entry.Red + entry.Green + entry.Blue;
+                _candidates[_numCandidates++] = { sum, entry.Red, entry.Green, entry.Blue, i };
+            }
+        }
+        std::stable_sort(_candidates.begin(), _candidates.begin() + _numCandidates, [](const auto& a, const auto& b) {
+            return a.Sum < b.Sum;
+        });
+    }
+
+    int32_t Find(const int16_t* colour) const
+    {
+        // Dithering can push channels out of range, such colours are never in the palette.
+        if (colour[0] < 0 || colour[0] > 255 || colour[1] < 0 || colour[1] > 255 || colour[2] < 0 || colour[2] > 255)
+        {
+            return PALETTE_TRANSPARENT;
+        }
+
+        auto key = GetKey(colour[0], colour[1], colour[2]);
+        for (auto slot = GetSlot(key); _keys[slot] != EmptySlot; slot = (slot + 1) % HashSize)
+        {
+            if (_keys[slot] == key)
+            {
+                return _values[slot];
+            }
+        }
+        return PALETTE_TRANSPARENT;
+    }
+
+    /**
+     * Finds the candidate with the smallest squared distance, the lowest palette index of equally close
+     * colours wins. As (dr + dg + db)^2 <= 3 * (dr^2 + dg^2 + db^2), the search walks outwards from
+     * the colour's channel sum and stops once the sums differ too much to beat the best match.
+     */
+    int32_t FindClosest(const int16_t* colour) const
+    {
+        if (_numCandidates == 0)
+        {
+            return PALETTE_TRANSPARENT;
+        }
+
+        const int32_t r = colour[0];
+        const int32_t g = colour[1];
+        const int32_t b = colour[2];
+        const int32_t sum = r + g + b;
+
+        auto bestError = std::numeric_limits<int64_t>::max();
+        auto bestMatch = PALETTE_TRANSPARENT;
+        auto check = [&](const Candidate& candidate) {
+            int64_t dr = candidate.Red - r;
+            int64_t dg = candidate.Green - g;
+            int64_t db = candidate.Blue - b;
+            auto error = dr * dr + dg * dg + db * db;
+            if (error < bestError || (error == bestError && candidate.Index < bestMatch))
+            {
+                bestError = error;
+                bestMatch = candidate.Index;
+            }
+        };
+        auto canImprove = [&](const Candidate& candidate) {
+            int64_t ds = candidate.Sum - sum;
+            return ds * ds <= 3 * bestError;
+        };
+
+        const auto* begin = _candidates.data();
+        const auto* end = begin + _numCandidates;
+        const auto* upper = std::lower_bound(
+            begin, end, sum, [](const Candidate& candidate, int32_t value) { return candidate.Sum < value; });
+        const auto* lower = upper;
+        bool searchLower = true;
+        bool searchUpper = true;
+        while (searchLower || searchUpper)
+        {
+            searchLower = searchLower && lower != begin && canImprove(*(lower - 1));
+            if (searchLower)
+            {
+                check(*--lower);
+            }
+            searchUpper = searchUpper && upper != end && canImprove(*upper);
+            if (searchUpper)
+            {
+                check(*upper++);
+            }
+        }
+        return bestMatch;
+    }
+};
+
+static const StandardPaletteLookup& GetStandardPaletteLookup()
+{
+    static const StandardPaletteLookup lookup;
+    return lookup;
+}
+
 ImportResult ImageImporter::Import(
     const Image& image, int32_t offsetX, int32_t offsetY, IMPORT_FLAGS flags, IMPORT_MODE mode) const
 {
@@ -216,17 +388,17 @@ int32_t ImageImporter::CalculatePaletteIndex(
     IMPORT_MODE mode, int16_t* rgbaSrc, int32_t x, int32_t y, int32_t width, int32_t height)
 {
     auto& palette = StandardPalette;
-    auto paletteIndex = GetPaletteIndex(palette, rgbaSrc);
+    auto paletteIndex = GetPaletteIndex(rgbaSrc);
     if (mode == IMPORT_MODE::CLOSEST || mode == IMPORT_MODE::DITHERING)
     {
         if (paletteIndex == PALETTE_TRANSPARENT && !IsTransparentPixel(rgbaSrc))
         {
-            paletteIndex = GetClosestPaletteIndex(palette, rgbaSrc);
+            paletteIndex = GetClosestPaletteIndex(rgbaSrc);
         }
     }
     if (mode == IMPORT_MODE::DITHERING)
     {
-        if (!IsTransparentPixel(rgbaSrc) && IsChangablePixel(GetPaletteIndex(palette, rgbaSrc)))
+        if (!IsTransparentPixel(rgbaSrc) && IsChangablePixel(GetPaletteIndex(rgbaSrc)))
         {
             auto dr = rgbaSrc[0] - static_cast<int16_t>(palette[paletteIndex].Red);
             auto dg = rgbaSrc[1] - static_cast<int16_t>(palette[paletteIndex].Green);
@@ -234,7 +406,7 @@ int32_t ImageImporter::CalculatePaletteIndex(
 
             if (x + 1 < width)
             {
-                if (!IsTransparentPixel(rgbaSrc + 4) && IsChangablePixel(GetPaletteIndex(palette, rgbaSrc + 4)))
+                if (!IsTransparentPixel(rgbaSrc + 4) && IsChangablePixel(GetPaletteIndex(rgbaSrc + 4)))
                 {
                     // Right
                     rgbaSrc[4] += dr * 7 / 16;
@@ -248,7 +420,7 @@ int32_t ImageImporter::CalculatePaletteIndex(
                 if (x > 0)
                 {
                     if (!IsTransparentPixel(rgbaSrc + 4 * (width - 1))
-                        && IsChangablePixel(GetPaletteIndex(palette, rgbaSrc + 4 * (width - 1))))
+                        && IsChangablePixel(GetPaletteIndex(rgbaSrc + 4 * (width - 1))))
                     {
                         // Bottom left
                         rgbaSrc[4 * (width - 1)] += dr * 3 / 16;
@@ -258,7 +430,7 @@ int32_t ImageImporter::CalculatePaletteIndex(
                 }
 
                 // Bottom
-                if (!IsTransparentPixel(rgbaSrc + 4 * width) && IsChangablePixel(GetPaletteIndex(palette, rgbaSrc + 4 * width)))
+                if (!IsTransparentPixel(rgbaSrc + 4 * width) && IsChangablePixel(GetPaletteIndex(rgbaSrc + 4 * width)))
                 {
                     rgbaSrc[4 * width] += dr * 5 / 16;
                     rgbaSrc[4 * width + 1] += dg * 5 / 16;
@@ -268,7 +440,7 @@ int32_t ImageImporter::CalculatePaletteIndex(
                 if (x + 1 < width)
                 {
                     if (!IsTransparentPixel(rgbaSrc + 4 * (width + 1))
-                        && IsChangablePixel(GetPaletteIndex(palette, rgbaSrc + 4 * (width + 1))))
+                        && IsChangablePixel(GetPaletteIndex(rgbaSrc + 4 * (width + 1))))
                     {
                         // Bottom right
                         rgbaSrc[4 * (width + 1)] += dr * 1 / 16;
@@ -282,18 +454,11 @@ int32_t ImageImporter::CalculatePaletteIndex(
     return paletteIndex;
 }
 
-int32_t ImageImporter::GetPaletteIndex(const GamePalette& palette, int16_t* colour)
+int32_t ImageImporter::GetPaletteIndex(const int16_t* colour)
 {
     if (!IsTransparentPixel(colour))
     {
-        for (int32_t i = 0; i < PALETTE_SIZE; i++)
-        {
-            if (static_cast<int16_t>(palette[i].Red) == colour[0] && static_cast<int16_t>(palette[i].Green) == colour[1]
-                && static_cast<int16_t>(palette[i].Blue) == colour[2])
-            {
-                return i;
-            }
-        }
+        return GetStandardPaletteLookup().Find(colour);
     }
     return PALETTE_TRANSPARENT;
 }
@@ -303,45 +468,12 @@ bool ImageImporter::IsTransparentPixel(const int16_t* colour)
     return colour[3] < 128;
 }
 
-/**
- * @returns true if pixel index is an index not used for remapping.
- */
 bool ImageImporter::IsChangablePixel(int32_t paletteIndex)
 {
-    if (paletteIndex == PALETTE_TRANSPARENT)
-        return true;
-    if (paletteIndex == 0)
-        return false;
-    if (paletteIndex >= 203 && paletteIndex < 214)
-        return false;
-    if (paletteIndex == 226)
-        return false;
-    if (paletteIndex >= 227 && paletteIndex < 229)
-        return false;
-    if (paletteIndex >= 243)
-        return false;
-    return true;
+    return IsChangablePaletteIndex(paletteIndex);
 }
 
-int32_t ImageImporter::GetClosestPaletteIndex(const GamePalette& palette, const int16_t* colour)
+int32_t ImageImporter::GetClosestPaletteIndex(const int16_t* colour)
 {
-    auto smallestError = static_cast<uint32_t>(-1);
-    auto bestMatch = PALETTE_TRANSPARENT;
-    for (int32_t x = 0; x < PALETTE_SIZE; x++)
-    {
-        if (IsChangablePixel(x))
-        {
-            uint32_t error = (static_cast<int16_t>(palette[x].Red) - colour[0])
-                    * (static_cast<int16_t>(palette[x].Red) - colour[0])
-                + (static_cast<int16_t>(palette[x].Green) - colour[1]) * (static_cast<int16_t>(palette[x].Green) - colour[1])
-                + (static_cast<int16_t>(palette[x].Blue) - colour[2]) * (static_cast<int16_t>(palette[x].Blue) - colour[2]);
-
-            if (smallestError == static_cast<uint32_t>(-1) || smallestError > error)
-            {
-                bestMatch = x;
-                smallestError = error;
-            }
-        }
-    }
-    return bestMatch;
+    return GetStandardPaletteLookup().FindClosest(colour);
 }
@@ -86,6 +86,9 @@ static ZoomLevel _current_view_zoom_back_delay = 0;
 
 static GamePalette gPalette_light;
 
+static void (*_lightfxAddLightRowFn)(uint8_t* RESTRICT dst, const uint8_t* RESTRICT src, uint32_t scale, int32_t length)
+    = lightfx_add_light_row_scalar;
+
 static uint8_t calc_light_intensity_lantern(int32_t x, int32_t y)
 {
     double distance = static_cast<double>(x * x + y * y);
@@ -145,6 +148,8 @@ void lightfx_init()
     _LightListBack = _LightListA;
     _LightListFront = _LightListB;
 
+    _lightfxAddLightRowFn = sse41_available() ? lightfx_add_light_row_sse4_1 : lightfx_add_light_row_scalar;
+
     std::fill_n(_bakedLightTexture_lantern_0, 32 * 32, 0xFF);
     std::fill_n(_bakedLightTexture_lantern_1, 64 * 64, 0xFF);
     std::fill_n(_bakedLightTexture_lantern_2, 128 * 128, 0xFF);
@@ -584,36 +589,22 @@ void lightfx_render_lights_to_frontbuffer()
         bufReadSkip = bufReadWidth - bufWriteWidth;
         bufWriteSkip = _pixelInfo.width - bufWriteWidth;
 
-        if (entry->lightIntensity == 0xFF)
+        // A full intensity light is scaled by 256 / 256, which leaves the texture unchanged
+        const uint32_t scale = 1 + entry->lightIntensity;
+        for (int32_t y = 0; y < bufWriteHeight; y++)
         {
-            for (int32_t y = 0; y < bufWriteHeight; y++)
-            {
-                for (int32_t x = 0; x < bufWriteWidth; x++)
-                {
-                    *bufWriteBase = std::min(0xFF, *bufWriteBase + *bufReadBase);
-                    bufWriteBase++;
-                    bufReadBase++;
-                }
-
-                bufWriteBase += bufWriteSkip;
-                bufReadBase += bufReadSkip;
-            }
+            _lightfxAddLightRowFn(bufWriteBase, bufReadBase, scale, bufWriteWidth);
+            bufWriteBase += bufWriteWidth + bufWriteSkip;
+            bufReadBase += bufWriteWidth + bufReadSkip;
         }
-        else
-        {
-            for (int32_t y = 0; y < bufWriteHeight; y++)
-            {
-                for (int32_t x = 0; x < bufWriteWidth; x++)
-                {
-                    *bufWriteBase = std::min(0xFF, *bufWriteBase + (((*bufReadBase) * (1 + entry->lightIntensity)) >> 8));
-                    bufWriteBase++;
-                    bufReadBase++;
-                }
+    }
+}
 
-                bufWriteBase += bufWriteSkip;
-                bufReadBase += bufReadSkip;
-            }
-        }
+void lightfx_add_light_row_scalar(uint8_t* RESTRICT dst, const uint8_t* RESTRICT src, uint32_t scale, int32_t length)
+{
+    for (int32_t i = 0; i < length; i++)
+    {
+        dst[i] = std::min<uint32_t>(0xFF, dst[i] + ((src[i] * scale) >> 8));
     }
 }
 
@@ -1001,26 +992,25 @@ void lightfx_render_to_texture(
     {
         uintptr_t dstOffset = static_cast<uintptr_t>(y * dstPitch);
         uint32_t* dst = reinterpret_cast<uint32_t*>(reinterpret_cast<uintptr_t>(dstPixels) + dstOffset);
+        const uint8_t* src = &bits[y * width];
+        const uint8_t* light = &lightBits[y * width];
+
+        // Most of the screen is unlit, so expand the whole row and only mix the lit pixels afterwards
+        palette_expand_row_fn(dst, src, palette, static_cast<int32_t>(width));
         for (uint32_t x = 0; x < width; x++)
         {
-            uint8_t* src = &bits[y * width + x];
-            uint32_t darkColour = palette[*src];
-            uint32_t lightColour = lightPalette[*src];
-            uint8_t lightIntensity = lightBits[y * width + x];
-
-            uint32_t colour = 0;
-            if (lightIntensity == 0)
-            {
-                colour = darkColour;
-            }
-            else
+            uint8_t lightIntensity = light[x];
+            if (lightIntensity != 0)
             {
+                uint32_t darkColour = dst[x];
+                uint32_t lightColour = lightPalette[src[x]];
+                uint32_t colour = 0;
                 colour |= mix_light((darkColour >> 0) & 0xFF, (lightColour >> 0) & 0xFF, lightIntensity);
                 colour |= mix_light((darkColour >> 8) & 0xFF, (lightColour >> 8) & 0xFF, lightIntensity) << 8;
                 colour |= mix_light((darkColour >> 16) & 0xFF, (lightColour >> 16) & 0xFF, lightIntensity) << 16;
                 colour |= mix_light((darkColour >> 24) & 0xFF, (lightColour >> 24) & 0xFF, lightIntensity) << 24;
+                dst[x] = colour;
             }
-            *dst++ = colour;
         }
     }
 }
@@ -75,6 +75,10 @@ void lightfx_render_to_texture(
     void* dstPixels, uint32_t dstPitch, uint8_t* bits, uint32_t width, uint32_t height, const uint32_t* palette,
     const uint32_t* lightPalette);
 
+// Adds a row of a light texture to the light buffer, scaled by scale / 256 and saturated at 0xFF.
+void lightfx_add_light_row_scalar(uint8_t* RESTRICT dst, const uint8_t* RESTRICT src, uint32_t scale, int32_t length);
+void lightfx_add_light_row_sse4_1(uint8_t* RESTRICT dst, const uint8_t* RESTRICT src, uint32_t scale, int32_t length);
+
 #endif // __ENABLE_LIGHTFX__
 
 #endif
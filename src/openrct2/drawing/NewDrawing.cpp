@@ -135,6 +135,8 @@ bool drawing_engine_has_dirty_optimisations()
 
 void drawing_engine_invalidate_image(uint32_t image)
 {
+    gfx_invalidate_minified_sprite(image);
+
     auto drawingEngine = GetDrawingEngine();
     if (drawingEngine != nullptr)
     {
@@ -10,6 +10,7 @@
 #include "../common.h"
 #include "../core/Guard.hpp"
 #include "Drawing.h"
+#include "LightFX.h"
 
 #ifdef __SSE4_1__
 
@@ -56,6 +57,72 @@ void mask_sse4_1(
     }
 }
 
+// Looks up 16 bytes in a 256 entry table with one shuffle per 16 entry row of the table. Indices are moved so only
+// the ones in the current row end up in 0x70 to 0x7F, the others have the top bit set which makes the shuffle give 0.
+static inline __m128i lookup_sse4_1(__m128i indices, const uint8_t* RESTRICT table)
+{
+    const __m128i rowStep = _mm_set1_epi8(0x10);
+    const __m128i rowBias = _mm_set1_epi8(0x70);
+    __m128i result = _mm_setzero_si128();
+    for (int32_t i = 0; i < 16; i++)
+    {
+        const __m128i entries = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table + i * 16));
+        result = _mm_or_si128(result, _mm_shuffle_epi8(entries, _mm_adds_epu8(indices, rowBias)));
+        indices = _mm_sub_epi8(indices, rowStep);
+    }
+    return result;
+}
+
+void rle_remap_sse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT table, int32_t length)
+{
+    const __m128i zero128 = {};
+    int32_t i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        const __m128i source = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i dest = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        const __m128i pixels = lookup_sse4_1(source, table);
+        const __m128i keep = _mm_or_si128(_mm_cmpeq_epi8(source, zero128), _mm_cmpeq_epi8(pixels, zero128));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_blendv_epi8(pixels, dest, keep));
+    }
+    rle_remap_scalar(src + i, dst + i, table, length - i);
+}
+
+void rle_remap_dst_sse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT table, int32_t length)
+{
+    const __m128i zero128 = {};
+    int32_t i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        const __m128i source = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i dest = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        const __m128i pixels = lookup_sse4_1(dest, table);
+        const __m128i keep = _mm_or_si128(_mm_cmpeq_epi8(source, zero128), _mm_cmpeq_epi8(pixels, zero128));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_blendv_epi8(pixels, dest, keep));
+    }
+    rle_remap_dst_scalar(src + i, dst + i, table, length - i);
+}
+
+#    ifdef __ENABLE_LIGHTFX__
+void lightfx_add_light_row_sse4_1(uint8_t* RESTRICT dst, const uint8_t* RESTRICT src, uint32_t scale, int32_t length)
+{
+    // Light values times 256 still fit in 16 bits, so the scaling is done on unsigned 16 bit lanes
+    const __m128i zero128 = {};
+    const __m128i scale128 = _mm_set1_epi16(static_cast<int16_t>(scale));
+    int32_t i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        const __m128i source = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i dest = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        const __m128i low = _mm_srli_epi16(_mm_mullo_epi16(_mm_cvtepu8_epi16(source), scale128), 8);
+        const __m128i high = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(source, zero128), scale128), 8);
+        const __m128i light = _mm_packus_epi16(low, high);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_adds_epu8(dest, light));
+    }
+    lightfx_add_light_row_scalar(dst + i, src + i, scale, length - i);
+}
+#    endif
+
 #else
 
 #    ifdef OPENRCT2_X86
@@ -69,4 +136,21 @@ void mask_sse4_1(
     openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
 }
 
+void rle_remap_sse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT table, int32_t length)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+
+void rle_remap_dst_sse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT table, int32_t length)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+
+#    ifdef __ENABLE_LIGHTFX__
+void lightfx_add_light_row_sse4_1(uint8_t* RESTRICT dst, const uint8_t* RESTRICT src, uint32_t scale, int32_t length)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+#    endif
+
 #endif // __SSE4_1__
@@ -22,6 +22,8 @@
 
 #include <algorithm>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 
 using namespace OpenRCT2;
 
@@ -36,15 +38,44 @@ struct rct_draw_scroll_text
     uint8_t bitmap[64 * 40];
 };
 
+enum class ScrollingTextPixel : uint8_t
+{
+    None,
+    Colour,
+    // Shades the pixel already in the bitmap, used for hinted TrueType text
+    Blend,
+};
+
+/**
+ * Every column of a string as it scrolls past, so each scroll position only has to place the columns it shows
+ * instead of formatting and rasterising the string again.
+ */
+struct ScrollingTextStrip
+{
+    rct_string_id StringId{};
+    uint8_t StringArgs[32]{};
+    colour_t CreatedColour{};
+
+    // Eight rows for every column
+    std::vector<ScrollingTextPixel> Pixels;
+    std::vector<colour_t> Colours;
+    int32_t Width{};
+    // Sprite text is repeated at most four times, TrueType text forever
+    bool Repeats{};
+    // When sprite text repeats, the columns before its first colour change are drawn in its final colour
+    int32_t LeadingColumns{};
+    colour_t FinalColour{};
+};
+
 static rct_draw_scroll_text _drawScrollTextList[OpenRCT2::MaxScrollingTextEntries];
+static std::unordered_map<uint64_t, uint16_t> _drawScrollTextIndex;
+static std::unordered_map<uint64_t, ScrollingTextStrip> _scrollTextStrips;
 static uint8_t _characterBitmaps[FONT_SPRITE_GLYPH_COUNT + SPR_G2_GLYPH_COUNT][8];
 static uint32_t _drawSCrollNextIndex = 0;
 static std::mutex _scrollingTextMutex;
 
-static void scrolling_text_set_bitmap_for_sprite(
-    std::string_view text, int32_t scroll, uint8_t* bitmap, const int16_t* scrollPositionOffsets, colour_t colour);
-static void scrolling_text_set_bitmap_for_ttf(
-    std::string_view text, int32_t scroll, uint8_t* bitmap, const int16_t* scrollPositionOffsets, colour_t colour);
+static void scrolling_text_create_strip_for_sprite(ScrollingTextStrip& strip, std::string_view text, colour_t colour);
+static void scrolling_text_create_strip_for_ttf(ScrollingTextStrip& strip, std::string_view text, colour_t colour);
 
 void scrolling_text_initialise_bitmaps()
 {
@@ -134,41 +165,80 @@ static uint8_t* font_sprite_get_codepoint_bitmap(int32_t codepoint)
     }
 }
 
-static int32_t scrolling_text_get_matching_or_oldest(
+static uint64_t scrolling_text_hash(rct_string_id stringId, const uint8_t* stringArgs, colour_t colour)
+{
+    // FNV-1a over the string and its arguments
+    uint64_t hash = 0xCBF29CE484222325;
+    auto add = [&hash](uint8_t value) {
+        hash ^= value;
+        hash *= 0x100000001B3;
+    };
+    add(static_cast<uint8_t>(stringId));
+    add(static_cast<uint8_t>(stringId >> 8));
+    for (size_t i = 0; i < sizeof(rct_draw_scroll_text::string_args); i++)
+    {
+        add(stringArgs[i]);
+    }
+    add(colour);
+    return hash;
+}
+
+static uint64_t scrolling_text_hash(
+    rct_string_id stringId, const uint8_t* stringArgs, colour_t colour, uint16_t scroll, uint16_t scrollingMode)
+{
+    auto position = (static_cast<uint64_t>(scroll) << 16) | scrollingMode;
+    return scrolling_text_hash(stringId, stringArgs, colour) ^ (position * 0x9E3779B97F4A7C15);
+}
+
+static bool scrolling_text_matches(
+    const rct_draw_scroll_text& scrollText, rct_string_id stringId, const uint8_t* stringArgs, colour_t colour)
+{
+    return scrollText.string_id == stringId
+        && std::memcmp(scrollText.string_args, stringArgs, sizeof(scrollText.string_args)) == 0
+        && scrollText.colour == colour;
+}
+
+static int32_t scrolling_text_get_matching(
     rct_string_id stringId, Formatter& ft, uint16_t scroll, uint16_t scrollingMode, colour_t colour)
 {
-    uint32_t oldestId = 0xFFFFFFFF;
-    int32_t scrollIndex = -1;
-    for (size_t i = 0; i < std::size(_drawScrollTextList); i++)
+    auto it = _drawScrollTextIndex.find(scrolling_text_hash(stringId, ft.Buf(), colour, scroll, scrollingMode));
+    if (it != _drawScrollTextIndex.end())
     {
-        rct_draw_scroll_text* scrollText = &_drawScrollTextList[i];
-        if (oldestId >= scrollText->id)
+        auto& scrollText = _drawScrollTextList[it->second];
+        if (scrolling_text_matches(scrollText, stringId, ft.Buf(), colour) && scrollText.position == scroll
+            && scrollText.mode == scrollingMode)
         {
-            oldestId = scrollText->id;
-            scrollIndex = static_cast<int32_t>(i);
+            scrollText.id = _drawSCrollNextIndex;
+            return static_cast<int32_t>(it->second);
         }
+    }
+    return -1;
+}
 
-        // If exact match return the matching index
-        if (scrollText->string_id == stringId
-            && std::memcmp(scrollText->string_args, ft.Buf(), sizeof(scrollText->string_args)) == 0
-            && scrollText->colour == colour && scrollText->position == scroll && scrollText->mode == scrollingMode)
+static int32_t scrolling_text_get_oldest()
+{
+    uint32_t oldestId = 0xFFFFFFFF;
+    int32_t scrollIndex = 0;
+    for (size_t i = 0; i < std::size(_drawScrollTextList); i++)
+    {
+        if (oldestId >= _drawScrollTextList[i].id)
         {
-            scrollText->id = _drawSCrollNextIndex;
-            return static_cast<int32_t>(i + SPR_SCROLLING_TEXT_START);
+            oldestId = _drawScrollTextList[i].id;
+            scrollIndex = static_cast<int32_t>(i);
         }
     }
     return scrollIndex;
 }
 
-static void scrolling_text_format(utf8* dst, size_t size, rct_draw_scroll_text* scrollText)
+static void scrolling_text_format(utf8* dst, size_t size, rct_string_id stringId, const uint8_t* stringArgs)
 {
     if (gConfigGeneral.upper_case_banners)
     {
-        format_string_to_upper(dst, size, scrollText->string_id, scrollText->string_args);
+        format_string_to_upper(dst, size, stringId, stringArgs);
     }
     else
     {
-        format_string(dst, size, scrollText->string_id, scrollText->string_args);
+        format_string(dst, size, stringId, stringArgs);
     }
 }
 
@@ -1440,11 +1510,90 @@ static constexpr const int16_t* _scrollPositions[MAX_SCROLLING_TEXT_MODES] = {
 
 void scrolling_text_invalidate()
 {
+    std::scoped_lock<std::mutex> lock(_scrollingTextMutex);
+
     for (auto& scrollText : _drawScrollTextList)
     {
         scrollText.string_id = 0;
         std::memset(scrollText.string_args, 0, sizeof(scrollText.string_args));
     }
+    _drawScrollTextIndex.clear();
+    _scrollTextStrips.clear();
+}
+
+static const ScrollingTextStrip& scrolling_text_get_strip(rct_string_id stringId, const uint8_t* stringArgs, colour_t colour)
+{
+    auto hash = scrolling_text_hash(stringId, stringArgs, colour);
+    auto it = _scrollTextStrips.find(hash);
+    if (it != _scrollTextStrips.end() && it->second.StringId == stringId
+        && std::memcmp(it->second.StringArgs, stringArgs, sizeof(it->second.StringArgs)) == 0
+        && it->second.CreatedColour == colour)
+    {
+        return it->second;
+    }
+
+    // Strips are small, so rather than tracking their age start again once there are many more than can be shown
+    if (_scrollTextStrips.size() >= 2 * OpenRCT2::MaxScrollingTextEntries)
+    {
+        _scrollTextStrips.clear();
+    }
+
+    auto& strip = _scrollTextStrips[hash];
+    strip = {};
+    strip.StringId = stringId;
+    std::memcpy(strip.StringArgs, stringArgs, sizeof(strip.StringArgs));
+    strip.CreatedColour = colour;
+
+    // Create the string to draw
+    utf8 scrollString[256];
+    scrolling_text_format(scrollString, 256, stringId, stringArgs);
+    if (LocalisationService_UseTrueTypeFont())
+    {
+        scrolling_text_create_strip_for_ttf(strip, scrollString, colour);
+    }
+    else
+    {
+        scrolling_text_create_strip_for_sprite(strip, scrollString, colour);
+    }
+    return strip;
+}
+
+static void scrolling_text_draw_strip(
+    const ScrollingTextStrip& strip, int32_t scroll, uint8_t* bitmap, const int16_t* scrollPositionOffsets)
+{
+    if (strip.Width == 0)
+        return;
+
+    const int32_t end = strip.Repeats ? INT32_MAX : strip.Width * 4;
+    for (int32_t column = scroll; *scrollPositionOffsets != -1; column++, scrollPositionOffsets++)
+    {
+        if (column >= end)
+            return;
+
+        int16_t scrollPosition = *scrollPositionOffsets;
+        if (scrollPosition > -1)
+        {
+            const int32_t stripColumn = column % strip.Width;
+            const auto colour = column >= strip.Width && stripColumn < strip.LeadingColumns ? strip.FinalColour
+                                                                                            : strip.Colours[stripColumn];
+            const auto* pixels = &strip.Pixels[stripColumn * 8];
+            auto dst = &bitmap[scrollPosition];
+            for (int32_t y = 0; y < 8; y++)
+            {
+                if (pixels[y] == ScrollingTextPixel::Colour)
+                {
+                    *dst = colour;
+                }
+                else if (pixels[y] == ScrollingTextPixel::Blend)
+                {
+                    *dst = blendColours(colour, *dst);
+                }
+
+                // Jump to next row
+                dst += 64;
+            }
+        }
+    }
 }
 
 int32_t scrolling_text_setup(
@@ -1461,108 +1610,91 @@ int32_t scrolling_text_setup(
 
     _drawSCrollNextIndex++;
     ft.Rewind();
-    int32_t scrollIndex = scrolling_text_get_matching_or_oldest(stringId, ft, scroll, scrollingMode, colour);
-    if (scrollIndex >= SPR_SCROLLING_TEXT_START)
-        return scrollIndex;
+    int32_t scrollIndex = scrolling_text_get_matching(stringId, ft, scroll, scrollingMode, colour);
+    if (scrollIndex != -1)
+        return SPR_SCROLLING_TEXT_START + scrollIndex;
 
     // Setup scrolling text
+    scrollIndex = scrolling_text_get_oldest();
     auto scrollText = &_drawScrollTextList[scrollIndex];
+    auto oldHash = scrolling_text_hash(
+        scrollText->string_id, scrollText->string_args, scrollText->colour, scrollText->position, scrollText->mode);
+    auto oldIt = _drawScrollTextIndex.find(oldHash);
+    if (oldIt != _drawScrollTextIndex.end() && oldIt->second == scrollIndex)
+    {
+        _drawScrollTextIndex.erase(oldIt);
+    }
+
     scrollText->string_id = stringId;
     std::memcpy(scrollText->string_args, ft.Buf(), sizeof(scrollText->string_args));
     scrollText->colour = colour;
     scrollText->position = scroll;
     scrollText->mode = scrollingMode;
     scrollText->id = _drawSCrollNextIndex;
+    auto hash = scrolling_text_hash(stringId, scrollText->string_args, colour, scroll, scrollingMode);
+    _drawScrollTextIndex[hash] = static_cast<uint16_t>(scrollIndex);
 
-    // Create the string to draw
-    utf8 scrollString[256];
-    scrolling_text_format(scrollString, 256, scrollText);
-
-    const int16_t* scrollingModePositions = _scrollPositions[scrollingMode];
-
+    const auto& strip = scrolling_text_get_strip(stringId, scrollText->string_args, colour);
     std::fill_n(scrollText->bitmap, 320 * 8, 0x00);
-    if (LocalisationService_UseTrueTypeFont())
-    {
-        scrolling_text_set_bitmap_for_ttf(scrollString, scroll, scrollText->bitmap, scrollingModePositions, colour);
-    }
-    else
-    {
-        scrolling_text_set_bitmap_for_sprite(scrollString, scroll, scrollText->bitmap, scrollingModePositions, colour);
-    }
+    scrolling_text_draw_strip(strip, scroll, scrollText->bitmap, _scrollPositions[scrollingMode]);
 
     uint32_t imageId = SPR_SCROLLING_TEXT_START + scrollIndex;
     drawing_engine_invalidate_image(imageId);
     return imageId;
 }
 
-static void scrolling_text_set_bitmap_for_sprite(
-    std::string_view text, int32_t scroll, uint8_t* bitmap, const int16_t* scrollPositionOffsets, colour_t colour)
+static void scrolling_text_create_strip_for_sprite(ScrollingTextStrip& strip, std::string_view text, colour_t colour)
 {
     auto characterColour = colour;
+    bool colourChanged = false;
     auto fmt = FmtString(text);
-
-    // Repeat string a maximum of four times (eliminates possibility of infinite loop)
-    for (auto i = 0; i < 4; i++)
+    for (const auto& token : fmt)
     {
-        for (const auto& token : fmt)
+        if (token.IsLiteral())
         {
-            if (token.IsLiteral())
+            CodepointView codepoints(token.text);
+            for (auto codepoint : codepoints)
             {
-                CodepointView codepoints(token.text);
-                for (auto codepoint : codepoints)
+                auto characterWidth = font_sprite_get_codepoint_width(FontSpriteBase::TINY, codepoint);
+                auto characterBitmap = font_sprite_get_codepoint_bitmap(codepoint);
+                for (; characterWidth != 0; characterWidth--, characterBitmap++)
                 {
-                    auto characterWidth = font_sprite_get_codepoint_width(FontSpriteBase::TINY, codepoint);
-                    auto characterBitmap = font_sprite_get_codepoint_bitmap(codepoint);
-                    for (; characterWidth != 0; characterWidth--, characterBitmap++)
+                    for (int32_t y = 0; y < 8; y++)
                     {
-                        // Skip any non-displayed columns
-                        if (scroll != 0)
-                        {
-                            scroll--;
-                            continue;
-                        }
-
-                        int16_t scrollPosition = *scrollPositionOffsets;
-                        if (scrollPosition == -1)
-                            return;
-
-                        if (scrollPosition > -1)
-                        {
-                            auto dst = &bitmap[scrollPosition];
-                            for (uint8_t char_bitmap = *characterBitmap; char_bitmap != 0; char_bitmap >>= 1)
-                            {
-                                if (char_bitmap & 1)
-                                    *dst = characterColour;
-
-                                // Jump to next row
-                                dst += 64;
-                            }
-                        }
-                        scrollPositionOffsets++;
+                        strip.Pixels.push_back(
+                            (*characterBitmap & (1 << y)) ? ScrollingTextPixel::Colour : ScrollingTextPixel::None);
+                    }
+                    strip.Colours.push_back(characterColour);
+                    if (!colourChanged)
+                    {
+                        strip.LeadingColumns++;
                     }
                 }
             }
-            else if (FormatTokenIsColour(token.kind))
+        }
+        else if (FormatTokenIsColour(token.kind))
+        {
+            auto g1 = gfx_get_g1_element(SPR_TEXT_PALETTE);
+            if (g1 != nullptr)
             {
-                auto g1 = gfx_get_g1_element(SPR_TEXT_PALETTE);
-                if (g1 != nullptr)
-                {
-                    auto colourIndex = FormatTokenGetTextColourIndex(token.kind);
-                    characterColour = g1->offset[colourIndex * 4];
-                }
+                auto colourIndex = FormatTokenGetTextColourIndex(token.kind);
+                characterColour = g1->offset[colourIndex * 4];
             }
+            colourChanged = true;
         }
     }
+    strip.Width = static_cast<int32_t>(strip.Colours.size());
+    strip.Repeats = false;
+    strip.FinalColour = characterColour;
 }
 
-static void scrolling_text_set_bitmap_for_ttf(
-    std::string_view text, int32_t scroll, uint8_t* bitmap, const int16_t* scrollPositionOffsets, colour_t colour)
+static void scrolling_text_create_strip_for_ttf(ScrollingTextStrip& strip, std::string_view text, colour_t colour)
 {
 #ifndef NO_TTF
     auto fontDesc = ttf_get_font_from_sprite_base(FontSpriteBase::TINY);
     if (fontDesc->font == nullptr)
     {
-        scrolling_text_set_bitmap_for_sprite(text, scroll, bitmap, scrollPositionOffsets, colour);
+        scrolling_text_create_strip_for_sprite(strip, text, colour);
         return;
     }
 
@@ -1606,46 +1738,29 @@ static void scrolling_text_set_bitmap_for_ttf(
 
     bool use_hinting = gConfigFonts.enable_hinting && fontDesc->hinting_threshold > 0;
 
-    for (int32_t x = 0;; x++)
+    strip.Pixels.assign(static_cast<size_t>(width) * 8, ScrollingTextPixel::None);
+    for (int32_t x = 0; x < width; x++)
     {
-        if (x >= width)
-            x = 0;
-
-        // Skip any non-displayed columns
-        if (scroll == 0)
+        auto pixels = &strip.Pixels[x * 8];
+        for (int32_t y = min_vpos; y < max_vpos; y++)
         {
-            int16_t scrollPosition = *scrollPositionOffsets;
-            if (scrollPosition == -1)
-                return;
-
-            if (scrollPosition > -1)
+            uint8_t src_pixel = src[y * pitch + x];
+            if ((!use_hinting && src_pixel != 0) || src_pixel > 140)
             {
-                uint8_t* dst = &bitmap[scrollPosition];
-
-                for (int32_t y = min_vpos; y < max_vpos; y++)
-                {
-                    uint8_t src_pixel = src[y * pitch + x];
-                    if ((!use_hinting && src_pixel != 0) || src_pixel > 140)
-                    {
-                        // Centre of the glyph: use full colour.
-                        *dst = colour;
-                    }
-                    else if (use_hinting && src_pixel > fontDesc->hinting_threshold)
-                    {
-                        // Simulate font hinting by shading the background colour instead.
-                        *dst = blendColours(colour, *dst);
-                    }
-
-                    // Jump to next row
-                    dst += 64;
-                }
+                // Centre of the glyph: use full colour.
+                *pixels = ScrollingTextPixel::Colour;
             }
-            scrollPositionOffsets++;
-        }
-        else
-        {
-            scroll--;
+            else if (use_hinting && src_pixel > fontDesc->hinting_threshold)
+            {
+                // Simulate font hinting by shading the background colour instead.
+                *pixels = ScrollingTextPixel::Blend;
+            }
+            pixels++;
         }
     }
+    strip.Colours.assign(width, colour);
+    strip.Width = width;
+    strip.Repeats = true;
+    strip.FinalColour = colour;
 #endif // NO_TTF
 }
@@ -3,6 +3,6 @@
 namespace OpenRCT2
 {
     static auto constexpr MaxScrollingTextLegacyEntries = 32;
-    static auto constexpr MaxScrollingTextEntries = 256;
+    static auto constexpr MaxScrollingTextEntries = 1024;
 
 } // namespace OpenRCT2
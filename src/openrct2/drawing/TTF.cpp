@@ -10,6 +10,7 @@
 #ifndef NO_TTF
 
 #    include <atomic>
+#    include <cstring>
 #    include <mutex>
 #    pragma clang diagnostic push
 #    pragma clang diagnostic ignored "-Wdocumentation"
@@ -19,6 +20,7 @@
 
 #    include "../OpenRCT2.h"
 #    include "../config/Config.h"
+#    include "../core/MemoryUsage.h"
 #    include "../core/String.hpp"
 #    include "../localisation/Localisation.h"
 #    include "../localisation/LocalisationService.h"
@@ -48,13 +50,13 @@ struct ttf_getwidth_cache_entry
 
 static ttf_cache_entry _ttfSurfaceCache[TTF_SURFACE_CACHE_SIZE] = {};
 static int32_t _ttfSurfaceCacheCount = 0;
-static int32_t _ttfSurfaceCacheHitCount = 0;
-static int32_t _ttfSurfaceCacheMissCount = 0;
+static uint32_t _ttfSurfaceCacheHitCount = 0;
+static uint32_t _ttfSurfaceCacheMissCount = 0;
 
 static ttf_getwidth_cache_entry _ttfGetWidthCache[TTF_GETWIDTH_CACHE_SIZE] = {};
 static int32_t _ttfGetWidthCacheCount = 0;
-static int32_t _ttfGetWidthCacheHitCount = 0;
-static int32_t _ttfGetWidthCacheMissCount = 0;
+static uint32_t _ttfGetWidthCacheHitCount = 0;
+static uint32_t _ttfGetWidthCacheMissCount = 0;
 
 static std::mutex _mutex;
 
@@ -141,6 +143,8 @@ bool ttf_initialise()
 
     ttf_toggle_hinting(true);
 
+    MemoryUsageSetReporter(MemoryUsageCategory::TextCaches, ttf_get_cache_memory_usage);
+
     _ttfInitialised = true;
 
     return true;
@@ -168,6 +172,8 @@ void ttf_dispose()
 
     TTF_Quit();
 
+    MemoryUsageSetReporter(MemoryUsageCategory::TextCaches, nullptr);
+
     _ttfInitialised = false;
 }
 
@@ -183,10 +189,12 @@ static void ttf_close_font(TTF_Font* font)
 
 static uint32_t ttf_surface_cache_hash(TTF_Font* font, std::string_view text)
 {
-    uint32_t hash = static_cast<uint32_t>(((reinterpret_cast<uintptr_t>(font) * 23) ^ 0xAAAAAAAA) & 0xFFFFFFFF);
+    // FNV-1a, strings that only differ in their last digits (counters, money) used to hash to neighbouring
+    // slots and the linear probing then evicted each other.
+    uint32_t hash = 2166136261u ^ static_cast<uint32_t>(reinterpret_cast<uintptr_t>(font) >> 4);
     for (auto c : text)
     {
-        hash = ror32(hash, 3) ^ (c * 13);
+        hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
     }
     return hash;
 }
@@ -264,7 +272,6 @@ TTFSurface* ttf_surface_cache_get_or_add(TTF_Font* font, std::string_view text)
     }
 
     _ttfSurfaceCacheMissCount++;
-    // printf("CACHE HITS: %d   MISSES: %d)\n", _ttfSurfaceCacheHitCount, _ttfSurfaceCacheMissCount);
 
     _ttfSurfaceCacheCount++;
     entry->surface = surface;
@@ -346,6 +353,37 @@ uint32_t ttf_getwidth_cache_get_or_add(TTF_Font* font, std::string_view text)
     return entry->width;
 }
 
+TTFCacheStatistics ttf_get_cache_statistics()
+{
+    FontLockHelper<std::mutex> lock(_mutex);
+    return { _ttfSurfaceCacheHitCount, _ttfSurfaceCacheMissCount, _ttfGetWidthCacheHitCount, _ttfGetWidthCacheMissCount };
+}
+
+size_t ttf_get_cache_memory_usage()
+{
+    FontLockHelper<std::mutex> lock(_mutex);
+    size_t result = sizeof(_ttfSurfaceCache) + sizeof(_ttfGetWidthCache);
+    for (const auto& entry : _ttfSurfaceCache)
+    {
+        if (entry.surface != nullptr)
+        {
+            result += sizeof(TTFSurface) + static_cast<size_t>(entry.surface->pitch) * entry.surface->h;
+        }
+        if (entry.text != nullptr)
+        {
+            result += std::strlen(entry.text) + 1;
+        }
+    }
+    for (const auto& entry : _ttfGetWidthCache)
+    {
+        if (entry.text != nullptr)
+        {
+            result += std::strlen(entry.text) + 1;
+        }
+    }
+    return result;
+}
+
 TTFFontDescriptor* ttf_get_font_from_sprite_base(FontSpriteBase spriteBase)
 {
     FontLockHelper<std::mutex> lock(_mutex);
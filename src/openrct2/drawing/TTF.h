@@ -26,10 +26,20 @@ struct TTFSurface
     int32_t pitch;
 };
 
+struct TTFCacheStatistics
+{
+    uint32_t SurfaceHits;
+    uint32_t SurfaceMisses;
+    uint32_t WidthHits;
+    uint32_t WidthMisses;
+};
+
 TTFFontDescriptor* ttf_get_font_from_sprite_base(FontSpriteBase spriteBase);
 void ttf_toggle_hinting();
 TTFSurface* ttf_surface_cache_get_or_add(TTF_Font* font, std::string_view text);
 uint32_t ttf_getwidth_cache_get_or_add(TTF_Font* font, std::string_view text);
+TTFCacheStatistics ttf_get_cache_statistics();
+size_t ttf_get_cache_memory_usage();
 bool ttf_provides_glyph(const TTF_Font* font, codepoint_t codepoint);
 void ttf_free_surface(TTFSurface* surface);
 
@@ -18,30 +18,110 @@
 #include "Drawing.h"
 #include "IDrawingEngine.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
 using namespace OpenRCT2;
 using namespace OpenRCT2::Drawing;
 
-static void DrawLightRain(IWeatherDrawer* weatherDrawer, int32_t left, int32_t top, int32_t width, int32_t height);
-static void DrawHeavyRain(IWeatherDrawer* weatherDrawer, int32_t left, int32_t top, int32_t width, int32_t height);
-static void DrawLightSnow(IWeatherDrawer* weatherDrawer, int32_t left, int32_t top, int32_t width, int32_t height);
-static void DrawHeavySnow(IWeatherDrawer* weatherDrawer, int32_t left, int32_t top, int32_t width, int32_t height);
+struct WeatherLayer
+{
+    int32_t XStart;
+    int32_t YStart;
+    const uint8_t* Pattern;
+};
+
+struct WeatherRect
+{
+    int32_t Left;
+    int32_t Top;
+    int32_t Width;
+    int32_t Height;
+};
+
+// The least important layers come last so the budget drops them first
+static constexpr size_t MaxWeatherLayers = 4;
+
+// Average frame times in microseconds, above the first a layer is dropped and below the second one is added back
+static constexpr int64_t WeatherShedLayerFrameTime = 50000;
+static constexpr int64_t WeatherRestoreLayerFrameTime = 30000;
+
+static size_t _weatherLayerBudget = MaxWeatherLayers;
+static int64_t _weatherAverageFrameTime;
+static std::chrono::steady_clock::time_point _weatherLastFrame;
+static std::vector<WeatherRect> _weatherRects;
+
+static size_t GetLightRainLayers(WeatherLayer* layers);
+static size_t GetHeavyRainLayers(WeatherLayer* layers);
+static size_t GetLightSnowLayers(WeatherLayer* layers);
+static size_t GetHeavySnowLayers(WeatherLayer* layers);
+
+using GetWeatherLayersFunc = size_t (*)(WeatherLayer* layers);
 
 /**
  *
  *  rct2: 0x009AC058
  */
-const DrawWeatherFunc DrawRainFunctions[] = {
+static constexpr const GetWeatherLayersFunc GetRainLayerFunctions[] = {
     nullptr,
-    &DrawLightRain,
-    &DrawHeavyRain,
+    &GetLightRainLayers,
+    &GetHeavyRainLayers,
 };
 
-const DrawWeatherFunc DrawSnowFunctions[] = {
+static constexpr const GetWeatherLayersFunc GetSnowLayerFunctions[] = {
     nullptr,
-    &DrawLightSnow,
-    &DrawHeavySnow,
+    &GetLightSnowLayers,
+    &GetHeavySnowLayers,
 };
 
+/**
+ * Only records the rectangle, so the parts of the screen the weather is visible in are found once per frame rather than
+ * once per layer.
+ */
+static void CollectWeatherRect(
+    [[maybe_unused]] IWeatherDrawer* weatherDrawer, int32_t left, int32_t top, int32_t width, int32_t height)
+{
+    if (width > 0 && height > 0)
+    {
+        _weatherRects.push_back({ left, top, width, height });
+    }
+}
+
+/**
+ * Drops a layer while the frames take too long and brings it back once they are quick again. The frame time is
+ * averaged over roughly the last sixteen frames so a single slow frame (a park loading, a window opening) is ignored.
+ */
+static void UpdateWeatherLayerBudget(size_t numLayers)
+{
+    constexpr int64_t settledFrameTime = (WeatherShedLayerFrameTime + WeatherRestoreLayerFrameTime) / 2;
+
+    auto now = std::chrono::steady_clock::now();
+    auto frameTime = std::chrono::duration_cast<std::chrono::microseconds>(now - _weatherLastFrame).count();
+    _weatherLastFrame = now;
+
+    // Weather was not drawn for a while, start measuring again
+    if (frameTime > 1000000)
+    {
+        _weatherAverageFrameTime = settledFrameTime;
+        return;
+    }
+
+    _weatherAverageFrameTime += (frameTime - _weatherAverageFrameTime) / 16;
+    auto budget = std::min(_weatherLayerBudget, numLayers);
+    if (_weatherAverageFrameTime > WeatherShedLayerFrameTime && budget > 1)
+    {
+        _weatherLayerBudget = budget - 1;
+        _weatherAverageFrameTime = settledFrameTime;
+    }
+    else if (_weatherAverageFrameTime < WeatherRestoreLayerFrameTime && _weatherLayerBudget < MaxWeatherLayers)
+    {
+        _weatherLayerBudget++;
+        _weatherAverageFrameTime = settledFrameTime;
+    }
+}
+
 /**
  *
  *  rct2: 0x00684218
@@ -60,121 +140,75 @@ void DrawWeather(rct_drawpixelinfo* dpi, IWeatherDrawer* weatherDrawer)
         auto weatherLevel = gClimateCurrent.Level;
         if (weatherLevel != WeatherLevel::None && !gTrackDesignSaveMode && !(viewFlags & VIEWPORT_FLAG_HIGHLIGHT_PATH_ISSUES))
         {
-            auto drawFunc = DrawRainFunctions[static_cast<int8_t>(weatherLevel)];
+            auto getLayersFunc = GetRainLayerFunctions[static_cast<int8_t>(weatherLevel)];
             if (climate_is_snowing())
             {
-                drawFunc = DrawSnowFunctions[static_cast<int8_t>(weatherLevel)];
+                getLayersFunc = GetSnowLayerFunctions[static_cast<int8_t>(weatherLevel)];
             }
+
+            _weatherRects.clear();
             auto uiContext = GetContext()->GetUiContext();
-            uiContext->DrawWeatherAnimation(weatherDrawer, dpi, drawFunc);
+            uiContext->DrawWeatherAnimation(weatherDrawer, dpi, &CollectWeatherRect);
+
+            WeatherLayer layers[MaxWeatherLayers];
+            auto numLayers = getLayersFunc(layers);
+            UpdateWeatherLayerBudget(numLayers);
+            numLayers = std::min(numLayers, _weatherLayerBudget);
+            for (size_t i = 0; i < numLayers; i++)
+            {
+                const auto& layer = layers[i];
+                for (const auto& rect : _weatherRects)
+                {
+                    weatherDrawer->Draw(
+                        rect.Left, rect.Top, rect.Width, rect.Height, rect.Left + layer.XStart, rect.Top + layer.YStart,
+                        layer.Pattern);
+                }
+            }
         }
     }
 }
 
 /**
- *
+ * The layers are offsets relative to the rectangle being drawn, so the pattern stays in place on the screen whichever
+ * viewport it is drawn in.
  *  rct2: 0x00684114
  */
-static void DrawLightRain(IWeatherDrawer* weatherDrawer, int32_t left, int32_t top, int32_t width, int32_t height)
+static size_t GetLightRainLayers(WeatherLayer* layers)
 {
-    int32_t x_start = -static_cast<int32_t>(gScenarioTicks) + 8;
-    int32_t y_start = (gScenarioTicks * 3) + 7;
-    y_start = -y_start;
-    x_start += left;
-    y_start += top;
-    weatherDrawer->Draw(left, top, width, height, x_start, y_start, RainPattern);
-
-    x_start = -static_cast<int32_t>(gScenarioTicks) + 0x18;
-    y_start = (gScenarioTicks * 4) + 0x0D;
-    y_start = -y_start;
-    x_start += left;
-    y_start += top;
-    weatherDrawer->Draw(left, top, width, height, x_start, y_start, RainPattern);
+    const int32_t negT = -static_cast<int32_t>(gScenarioTicks);
+    layers[0] = { negT + 8, -static_cast<int32_t>(gScenarioTicks * 3 + 7), RainPattern };
+    layers[1] = { negT + 0x18, -static_cast<int32_t>(gScenarioTicks * 4 + 0x0D), RainPattern };
+    return 2;
 }
 
 /**
- *
+ * The two light rain layers and two faster ones.
  *  rct2: 0x0068416D
  */
-static void DrawHeavyRain(IWeatherDrawer* weatherDrawer, int32_t left, int32_t top, int32_t width, int32_t height)
+static size_t GetHeavyRainLayers(WeatherLayer* layers)
 {
-    int32_t x_start = -static_cast<int32_t>(gScenarioTicks);
-    int32_t y_start = gScenarioTicks * 5;
-    y_start = -y_start;
-    x_start += left;
-    y_start += top;
-    weatherDrawer->Draw(left, top, width, height, x_start, y_start, RainPattern);
-
-    x_start = -static_cast<int32_t>(gScenarioTicks) + 0x10;
-    y_start = (gScenarioTicks * 6) + 5;
-    y_start = -y_start;
-    x_start += left;
-    y_start += top;
-    weatherDrawer->Draw(left, top, width, height, x_start, y_start, RainPattern);
-
-    x_start = -static_cast<int32_t>(gScenarioTicks) + 8;
-    y_start = (gScenarioTicks * 3) + 7;
-    y_start = -y_start;
-    x_start += left;
-    y_start += top;
-    weatherDrawer->Draw(left, top, width, height, x_start, y_start, RainPattern);
-
-    x_start = -static_cast<int32_t>(gScenarioTicks) + 0x18;
-    y_start = (gScenarioTicks * 4) + 0x0D;
-    y_start = -y_start;
-    x_start += left;
-    y_start += top;
-    weatherDrawer->Draw(left, top, width, height, x_start, y_start, RainPattern);
+    const int32_t negT = -static_cast<int32_t>(gScenarioTicks);
+    GetLightRainLayers(layers);
+    layers[2] = { negT, -static_cast<int32_t>(gScenarioTicks * 5), RainPattern };
+    layers[3] = { negT + 0x10, -static_cast<int32_t>(gScenarioTicks * 6 + 5), RainPattern };
+    return 4;
 }
 
-static void DrawLightSnow(IWeatherDrawer* weatherDrawer, int32_t left, int32_t top, int32_t width, int32_t height)
+static size_t GetLightSnowLayers(WeatherLayer* layers)
 {
     const uint32_t t = gScenarioTicks / 2;
     const int32_t negT = -static_cast<int32_t>(t);
     const double cosTick = static_cast<double>(gScenarioTicks) * 0.05;
-
-    int32_t x_start = negT + 1 + (cos(1.0 + cosTick) * 6);
-    int32_t y_start = t + 1;
-    y_start = -y_start;
-    x_start += left;
-    y_start += top;
-    weatherDrawer->Draw(left, top, width, height, x_start, y_start, SnowPattern);
-
-    x_start = negT + 16 + (cos(cosTick) * 6);
-    y_start = t + 16;
-    y_start = -y_start;
-    x_start += left;
-    y_start += top;
-    weatherDrawer->Draw(left, top, width, height, x_start, y_start, SnowPattern);
+    layers[0] = { static_cast<int32_t>(negT + 1 + (cos(1.0 + cosTick) * 6)), -static_cast<int32_t>(t + 1), SnowPattern };
+    layers[1] = { static_cast<int32_t>(negT + 16 + (cos(cosTick) * 6)), -static_cast<int32_t>(t + 16), SnowPattern };
+    return 2;
 }
 
-static void DrawHeavySnow(IWeatherDrawer* weatherDrawer, int32_t left, int32_t top, int32_t width, int32_t height)
+static size_t GetHeavySnowLayers(WeatherLayer* layers)
 {
-    int32_t x_start = -static_cast<int32_t>(gScenarioTicks * 3) + 1;
-    int32_t y_start = gScenarioTicks + 23;
-    y_start = -y_start;
-    x_start += left;
-    y_start += top;
-    weatherDrawer->Draw(left, top, width, height, x_start, y_start, SnowPattern);
-
-    x_start = -static_cast<int32_t>(gScenarioTicks * 4) + 6;
-    y_start = gScenarioTicks + 5;
-    y_start = -y_start;
-    x_start += left;
-    y_start += top;
-    weatherDrawer->Draw(left, top, width, height, x_start, y_start, SnowPattern);
-
-    x_start = -static_cast<int32_t>(gScenarioTicks * 2) + 11;
-    y_start = gScenarioTicks + 18;
-    y_start = -y_start;
-    x_start += left;
-    y_start += top;
-    weatherDrawer->Draw(left, top, width, height, x_start, y_start, SnowPattern);
-
-    x_start = -static_cast<int32_t>(gScenarioTicks * 3) + 17;
-    y_start = gScenarioTicks + 11;
-    y_start = -y_start;
-    x_start += left;
-    y_start += top;
-    weatherDrawer->Draw(left, top, width, height, x_start, y_start, SnowPattern);
+    layers[0] = { -static_cast<int32_t>(gScenarioTicks * 3) + 1, -static_cast<int32_t>(gScenarioTicks + 23), SnowPattern };
+    layers[1] = { -static_cast<int32_t>(gScenarioTicks * 4) + 6, -static_cast<int32_t>(gScenarioTicks + 5), SnowPattern };
+    layers[2] = { -static_cast<int32_t>(gScenarioTicks * 2) + 11, -static_cast<int32_t>(gScenarioTicks + 18), SnowPattern };
+    layers[3] = { -static_cast<int32_t>(gScenarioTicks * 3) + 17, -static_cast<int32_t>(gScenarioTicks + 11), SnowPattern };
+    return 4;
 }
@@ -20,6 +20,7 @@
 #include "../util/Util.h"
 #include "../world/Climate.h"
 #include "Drawing.h"
+#include "FrameStatistics.h"
 #include "IDrawingContext.h"
 #include "IDrawingEngine.h"
 #include "LightFX.h"
@@ -101,13 +102,14 @@ void X8WeatherDrawer::Restore()
     {
         uint32_t numPixels = (_screenDPI->width + _screenDPI->pitch) * _screenDPI->height;
         uint8_t* bits = _screenDPI->bits;
-        for (uint32_t i = 0; i < _weatherPixelsCount; i++)
+        // Newest first, where two layers covered the same pixel the first one saved the colour underneath the weather
+        for (uint32_t i = _weatherPixelsCount; i > 0; i--)
         {
-            WeatherPixel weatherPixel = _weatherPixels[i];
+            WeatherPixel weatherPixel = _weatherPixels[i - 1];
             if (weatherPixel.Position >= numPixels)
             {
-                // Pixel out of bounds, bail
-                break;
+                // Pixel out of bounds, skip
+                continue;
             }
 
             bits[weatherPixel.Position] = weatherPixel.Colour;
@@ -211,6 +213,7 @@ void X8DrawingEngine::EndDraw()
 
 void X8DrawingEngine::PaintWindows()
 {
+    FrameTimingScope timingScope(FrameTiming::Windows);
     window_reset_visibilities();
 
     // Redraw dirty regions before updating the viewports, otherwise
@@ -447,6 +450,7 @@ void X8DrawingEngine::DrawDirtyBlocks(uint32_t x, uint32_t y, uint32_t columns,
     }
 
     // Draw region
+    FrameStatisticsAddPixelsRedrawn(static_cast<uint64_t>(right - left) * (bottom - top));
     OnDrawDirtyBlock(x, y, columns, rows);
     window_draw_all(&_bitsDPI, left, top, right, bottom);
 }
@@ -582,22 +586,13 @@ void X8DrawingContext::FillRect(uint32_t colour, int32_t left, int32_t top, int3
         uint8_t* dst = (startY * (dpi->width + dpi->pitch)) + startX + dpi->bits;
         for (int32_t i = 0; i < height; i++)
         {
-            uint8_t* nextdst = dst + dpi->width + dpi->pitch;
-            uint32_t p = ror32(crossPattern, 1);
-            p = (p & 0xFFFF0000) | width;
-
-            // Fill every other pixel with the colour
-            for (; (p & 0xFFFF) != 0; p--)
+            // Fill every other pixel with the colour, starting on the second one when the lowest bit of the pattern is set
+            for (int32_t j = crossPattern & 1; j < width; j += 2)
             {
-                p = p ^ 0x80000000;
-                if (p & 0x80000000)
-                {
-                    *dst = colour & 0xFF;
-                }
-                dst++;
+                dst[j] = colour & 0xFF;
             }
             crossPattern ^= 1;
-            dst = nextdst;
+            dst += dpi->width + dpi->pitch;
         }
     }
     else if (colour & 0x2000000)
@@ -709,13 +704,24 @@ void X8DrawingContext::FilterRect(FilterPaletteID palette, int32_t left, int32_t
 
         // Fill the rectangle with the colours from the colour table
         auto c = height / dpi->zoom_level;
-        for (int32_t i = 0; i < c; i++)
+        if (paletteMap->GetDataLength() >= 256)
+        {
+            const uint8_t* table = paletteMap->GetData();
+            for (int32_t i = 0; i < c; i++)
+            {
+                filter_row_fn(dst + step * i, table, scaled_width);
+            }
+        }
+        else
         {
-            uint8_t* nextdst = dst + step * i;
-            for (int32_t j = 0; j < scaled_width; j++)
+            for (int32_t i = 0; i < c; i++)
             {
-                auto index = *(nextdst + j);
-                *(nextdst + j) = (*paletteMap)[index];
+                uint8_t* nextdst = dst + step * i;
+                for (int32_t j = 0; j < scaled_width; j++)
+                {
+                    auto index = *(nextdst + j);
+                    *(nextdst + j) = (*paletteMap)[index];
+                }
             }
         }
     }
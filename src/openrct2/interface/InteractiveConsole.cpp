@@ -21,15 +21,21 @@
 #include "../actions/RideSetSettingAction.h"
 #include "../actions/SetCheatAction.h"
 #include "../actions/StaffSetCostumeAction.h"
+#include "../audio/AudioContext.h"
+#include "../audio/AudioMixer.h"
 #include "../config/Config.h"
 #include "../core/Guard.hpp"
+#include "../core/MemoryUsage.h"
 #include "../core/Path.hpp"
+#include "../core/Profiling.h"
 #include "../core/String.hpp"
 #include "../drawing/Drawing.h"
 #include "../drawing/Font.h"
+#include "../drawing/FrameStatistics.h"
 #include "../interface/Chat.h"
 #include "../interface/Colour.h"
 #include "../interface/Window_internal.h"
+#include "../localisation/Formatting.h"
 #include "../localisation/Localisation.h"
 #include "../management/Finance.h"
 #include "../management/NewsItem.h"
@@ -50,9 +56,12 @@
 #include "../world/Park.h"
 #include "../world/Scenery.h"
 #include "../world/Sprite.h"
+#include "../world/TileChanges.h"
 #include "Viewport.h"
 
 #include <algorithm>
+#include <chrono>
+#include <cinttypes>
 #include <cmath>
 #include <cstdarg>
 #include <cstdlib>
@@ -66,6 +75,11 @@
 #    include "../drawing/TTF.h"
 #endif
 
+#ifdef ENABLE_SCRIPTING
+#    include "../scripting/Plugin.h"
+#    include "../scripting/ScriptEngine.h"
+#endif
+
 using arguments_t = std::vector<std::string>;
 
 static constexpr const char* ClimateNames[] = {
@@ -1268,6 +1282,126 @@ static int32_t cc_show_limits(InteractiveConsole& console, [[maybe_unused]] cons
     return 0;
 }
 
+static double get_cache_hit_rate(uint64_t hits, uint64_t misses)
+{
+    return hits + misses == 0 ? 0.0 : 100.0 * hits / (static_cast<double>(hits) + misses);
+}
+
+static int32_t cc_format_cache(InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
+{
+    auto stats = OpenRCT2::GetFormatStringCacheStatistics();
+    console.WriteFormatLine(
+        "Format string cache: %" PRIu64 " hits, %" PRIu64 " misses (%.1f%%)", stats.Hits, stats.Misses,
+        get_cache_hit_rate(stats.Hits, stats.Misses));
+    return 0;
+}
+
+static int32_t cc_audio_mixer(InteractiveConsole& console, const arguments_t& argv)
+{
+    auto mixer = OpenRCT2::GetContext()->GetAudioContext()->GetMixer();
+    if (mixer == nullptr)
+    {
+        console.WriteLineError("There is no audio mixer.");
+        return 1;
+    }
+    if (!argv.empty() && argv[0] == "reset")
+    {
+        mixer->ResetStatistics();
+        return 0;
+    }
+
+    auto stats = mixer->GetStatistics();
+    console.WriteFormatLine(
+        "%" PRIu64 " callbacks, %" PRIu64 " overruns (longer than %" PRIu64 " us), longest %" PRIu64 " us", stats.Callbacks,
+        stats.Overruns, stats.BufferMicroseconds, stats.MaxMicroseconds);
+    for (size_t i = 0; i < stats.Histogram.size(); i++)
+    {
+        if (stats.Histogram[i] == 0)
+            continue;
+
+        auto percent = 100.0 * stats.Histogram[i] / static_cast<double>(stats.Callbacks);
+        if (i + 1 < stats.Histogram.size())
+            console.WriteFormatLine("  < %6llu us: %" PRIu64 " (%.1f%%)", 64ULL << i, stats.Histogram[i], percent);
+        else
+            console.WriteFormatLine(" >= %6llu us: %" PRIu64 " (%.1f%%)", 64ULL << (i - 1), stats.Histogram[i], percent);
+    }
+    return 0;
+}
+
+#ifndef NO_TTF
+static int32_t cc_ttf_cache(InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
+{
+    auto stats = ttf_get_cache_statistics();
+    console.WriteFormatLine(
+        "Surface cache: %u hits, %u misses (%.1f%%)", stats.SurfaceHits, stats.SurfaceMisses,
+        get_cache_hit_rate(stats.SurfaceHits, stats.SurfaceMisses));
+    console.WriteFormatLine(
+        "Width cache: %u hits, %u misses (%.1f%%)", stats.WidthHits, stats.WidthMisses,
+        get_cache_hit_rate(stats.WidthHits, stats.WidthMisses));
+    return 0;
+}
+#endif
+
+static int32_t cc_memory(InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
+{
+    auto report = MemoryUsageGetReport();
+    for (size_t i = 0; i < MEMORY_USAGE_CATEGORY_COUNT; i++)
+    {
+        auto category = static_cast<MemoryUsageCategory>(i);
+        console.WriteFormatLine("%-16s %10.2f KiB", MemoryUsageGetCategoryName(category), report.Get(category) / 1024.0);
+    }
+    console.WriteFormatLine("%-16s %10.2f KiB", "total", report.GetTotal() / 1024.0);
+    return 0;
+}
+
+static int32_t cc_frame_stats(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (argv.size() == 1 && (argv[0] == "on" || argv[0] == "off"))
+    {
+        FrameStatisticsSetEnabled(argv[0] == "on");
+        if (argv[0] == "off" && FrameStatisticsIsWritingCsv())
+        {
+            if (!FrameStatisticsStopCsv())
+            {
+                console.WriteFormatLine("Unable to write the frame statistics, see the log for details.");
+            }
+        }
+    }
+    else if (argv.size() == 2 && argv[0] == "csv")
+    {
+        std::string path = argv[1];
+        if (!String::EndsWith(path, ".csv", true))
+        {
+            path += ".csv";
+        }
+        FrameStatisticsSetEnabled(true);
+        FrameStatisticsStartCsv(path);
+        console.WriteFormatLine("Recording every frame to %s until frame_stats off is used", path.c_str());
+        return 0;
+    }
+    else if (!argv.empty())
+    {
+        return 1;
+    }
+    console.WriteFormatLine("Frame statistics are %s", FrameStatisticsIsEnabled() ? "on" : "off");
+    return 0;
+}
+
+static int32_t cc_tile_changes(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (argv.size() == 1 && (argv[0] == "on" || argv[0] == "off"))
+    {
+        TileChangesSetConsumer(TileChangesConsumer::Console, argv[0] == "on");
+    }
+    else if (!argv.empty())
+    {
+        return 1;
+    }
+    console.WriteFormatLine(
+        "Tile changes are %s", TileChangesIsConsumerEnabled(TileChangesConsumer::Console) ? "written to stdout" : "off");
+    return 0;
+}
+
 static int32_t cc_for_date([[maybe_unused]] InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
 {
     int32_t year = 0;
@@ -1493,8 +1627,15 @@ static int32_t cc_replay_start(InteractiveConsole& console, const arguments_t& a
 
     std::string name = argv[0];
 
+    // Optionally only play back one segment between keyframes
     auto* replayManager = OpenRCT2::GetContext()->GetReplayManager();
-    if (replayManager->StartPlayback(name))
+    bool started = false;
+    if (argv.size() >= 2)
+        started = replayManager->StartPlaybackSegment(name, static_cast<uint32_t>(atol(argv[1].c_str())));
+    else
+        started = replayManager->StartPlayback(name);
+
+    if (started)
     {
         OpenRCT2::ReplayRecordInfo info;
         replayManager->GetCurrentReplayInfo(info);
@@ -1508,10 +1649,13 @@ static int32_t cc_replay_start(InteractiveConsole& console, const arguments_t& a
                              "  Date Recorded: %s\n"
                              "  Ticks: %u\n"
                              "  Commands: %u\n"
-                             "  Checksums: %u";
+                             "  Checksums: %u\n"
+                             "  Keyframes: %u";
 
-        console.WriteFormatLine(logFmt, info.FilePath.c_str(), recordingDate, info.Ticks, info.NumCommands, info.NumChecksums);
-        log_info(logFmt, info.FilePath.c_str(), recordingDate, info.Ticks, info.NumCommands, info.NumChecksums);
+        console.WriteFormatLine(
+            logFmt, info.FilePath.c_str(), recordingDate, info.Ticks, info.NumCommands, info.NumChecksums, info.NumKeyframes);
+        log_info(
+            logFmt, info.FilePath.c_str(), recordingDate, info.Ticks, info.NumCommands, info.NumChecksums, info.NumKeyframes);
 
         return 1;
     }
@@ -1537,6 +1681,26 @@ static int32_t cc_replay_stop(InteractiveConsole& console, const arguments_t& ar
     return 0;
 }
 
+static int32_t cc_replay_seek(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (argv.size() < 1)
+    {
+        console.WriteFormatLine("Parameters required <tick>");
+        return 0;
+    }
+
+    auto tick = static_cast<uint32_t>(atol(argv[0].c_str()));
+    auto* replayManager = OpenRCT2::GetContext()->GetReplayManager();
+    if (replayManager->SeekToTick(tick))
+    {
+        console.WriteFormatLine("Replay at tick %u", tick);
+        return 1;
+    }
+
+    console.WriteFormatLine("Unable to seek to tick %u", tick);
+    return 0;
+}
+
 static int32_t cc_replay_normalise(InteractiveConsole& console, const arguments_t& argv)
 {
     if (network_get_mode() != NETWORK_MODE_NONE)
@@ -1708,6 +1872,114 @@ static int32_t cc_add_news_item([[maybe_unused]] InteractiveConsole& console, [[
     return 0;
 }
 
+static int32_t cc_profiler_start(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (argv.size() < 1)
+    {
+        console.WriteFormatLine("Parameters required <file> [<ticks = 0>]");
+        return 0;
+    }
+
+    std::string path = argv[0];
+    if (!String::EndsWith(path, ".json", true))
+    {
+        path += ".json";
+    }
+
+    uint32_t numTicks = 0;
+    if (argv.size() >= 2)
+    {
+        numTicks = atol(argv[1].c_str());
+    }
+
+    Profiling::StartCapture(path, numTicks);
+    if (numTicks != 0)
+        console.WriteFormatLine("Profiling the next %u ticks to %s", numTicks, path.c_str());
+    else
+        console.WriteFormatLine("Profiling to %s until profiler_stop is used", path.c_str());
+    return 1;
+}
+
+static int32_t cc_profiler_stop(InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
+{
+    if (!Profiling::IsCapturing())
+    {
+        console.WriteFormatLine("No profiler capture is running.");
+        return 0;
+    }
+    if (!Profiling::StopCapture())
+    {
+        console.WriteFormatLine("Unable to write the profiler trace, see the log for details.");
+        return 0;
+    }
+    console.WriteFormatLine("Profiler trace written.");
+    return 1;
+}
+
+#ifdef ENABLE_SCRIPTING
+static double to_milliseconds(std::chrono::duration<double> duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+static int32_t cc_plugin_profile(InteractiveConsole& console, const arguments_t& argv)
+{
+    using namespace OpenRCT2::Scripting;
+
+    auto& scriptEngine = GetContext()->GetScriptEngine();
+    auto& plugins = scriptEngine.GetPlugins();
+    if (argv.size() >= 1 && argv[0] == "reset")
+    {
+        for (auto& plugin : plugins)
+        {
+            auto& profile = plugin->GetProfile();
+            profile.Hooks = {};
+            profile.MaxTickTime = {};
+            profile.TotalOverBudgetTicks = 0;
+        }
+        console.WriteFormatLine("Plugin timings reset.");
+        return 1;
+    }
+    if (argv.size() >= 1 && argv[0] == "resume")
+    {
+        for (auto& plugin : plugins)
+        {
+            auto& profile = plugin->GetProfile();
+            if (profile.Suspended && (argv.size() < 2 || plugin->GetMetadata().Name == argv[1]))
+            {
+                profile.Suspended = false;
+                profile.OverBudgetTicks = 0;
+                profile.ThrottledTicks = 0;
+                console.WriteFormatLine("Resumed %s", plugin->GetMetadata().Name.c_str());
+            }
+        }
+        return 1;
+    }
+
+    for (auto& plugin : plugins)
+    {
+        const auto& profile = plugin->GetProfile();
+        console.WriteFormatLine(
+            "%s: %.3f ms max per tick, %" PRIu64 " ticks over budget, %u active intervals%s",
+            plugin->GetMetadata().Name.c_str(), to_milliseconds(profile.MaxTickTime), profile.TotalOverBudgetTicks,
+            scriptEngine.GetNumIntervals(plugin),
+            profile.Suspended ? ", suspended" : (profile.ThrottledTicks != 0 ? ", throttled" : ""));
+        for (size_t i = 0; i < profile.Hooks.size(); i++)
+        {
+            const auto& timing = profile.Hooks[i];
+            if (timing.Count == 0)
+                continue;
+
+            console.WriteFormatLine(
+                "    %s: %" PRIu64 " calls, %.3f ms total, %.3f ms average, %.3f ms max",
+                GetHookTypeName(static_cast<HOOK_TYPE>(i)), timing.Count, to_milliseconds(timing.Total),
+                to_milliseconds(timing.Total) / timing.Count, to_milliseconds(timing.Max));
+        }
+    }
+    return 1;
+}
+#endif
+
 using console_command_func = int32_t (*)(InteractiveConsole& console, const arguments_t& argv);
 struct console_command
 {
@@ -1770,12 +2042,15 @@ static constexpr const console_command console_command_table[] = {
     { "abort", cc_abort, "Calls std::abort(), for testing purposes only.", "abort" },
     { "add_news_item", cc_add_news_item, "Inserts a news item", "add_news_item [<type> <message> <assoc>]" },
     { "assert", cc_assert, "Triggers assertion failure, for testing purposes only", "assert" },
+    { "audio_mixer", cc_audio_mixer, "Shows how long the audio callback takes to mix the channels, or resets the timings.", "audio_mixer [reset]" },
     { "clear", cc_clear, "Clears the console.", "clear" },
     { "close", cc_close, "Closes the console.", "close" },
     { "date", cc_for_date, "Sets the date to a given date.", "Format <year>[ <month>[ <day>]]." },
     { "dereference", cc_dereference, "Dereferences a nullptr, for testing purposes only", "dereference" },
     { "echo", cc_echo, "Echoes the text to the console.", "echo <text>" },
     { "exit", cc_close, "Closes the console.", "exit" },
+    { "format_cache", cc_format_cache, "Shows the hit rate of the formatted string cache.", "format_cache" },
+    { "frame_stats", cc_frame_stats, "Shows the time spent drawing each frame with a graph of the recent frames, and can record every frame to a CSV file.", "frame_stats [on|off|csv <file>]" },
     { "get", cc_get, "Gets the value of the specified variable.", "get <variable>" },
     { "help", cc_help, "Lists commands or info about a command.", "help [command]" },
     { "hide", cc_hide, "Hides the console.", "hide" },
@@ -1784,8 +2059,14 @@ static constexpr const console_command console_command_table[] = {
                                     "This is a safer method opposed to \"open object_selection\".",
                                     "load_object <objectfilenodat>" },
     { "load_park", cc_load_park, "Load park from save directory or by absolute path", "load_park <filename>" },
+    { "memory", cc_memory, "Shows the memory held by each subsystem that reports it.", "memory" },
     { "object_count", cc_object_count, "Shows the number of objects of each type in the scenario.", "object_count" },
     { "open", cc_open, "Opens the window with the give name.", "open <window>." },
+#ifdef ENABLE_SCRIPTING
+    { "plugin_profile", cc_plugin_profile, "Shows the time plugins spend in their hooks and their active intervals, or resets the timings or resumes suspended plugins.", "plugin_profile [reset|resume [plugin]]" },
+#endif
+    { "profiler_start", cc_profiler_start, "Records a trace of the main loop and worker threads.", "profiler_start <file> [ticks]" },
+    { "profiler_stop", cc_profiler_stop, "Stops the running profiler capture and writes the trace.", "profiler_stop" },
     { "quit", cc_close, "Closes the console.", "quit" },
     { "remove_park_fences", cc_remove_park_fences, "Removes all park fences from the surface", "remove_park_fences" },
     { "remove_unused_objects", cc_remove_unused_objects, "Removes all the unused objects from the object selection.", "remove_unused_objects" },
@@ -1797,11 +2078,16 @@ static constexpr const console_command console_command_table[] = {
     { "show_limits", cc_show_limits, "Shows the map data counts and limits.", "show_limits" },
     { "staff", cc_staff, "Staff management.", "staff <subcommand>" },
     { "terminate", cc_terminate, "Calls std::terminate(), for testing purposes only.", "terminate" },
+#ifndef NO_TTF
+    { "ttf_cache", cc_ttf_cache, "Shows the hit rate of the TrueType text caches.", "ttf_cache" },
+#endif
+    { "tile_changes", cc_tile_changes, "Writes the tiles changed each tick to stdout, as 'tile_changes <tick> x,y ...' or 'tile_changes <tick> all'.", "tile_changes [on|off]" },
     { "variables", cc_variables, "Lists all the variables that can be used with get and sometimes set.", "variables" },
     { "windows", cc_windows, "Lists all the windows that can be opened.", "windows" },
     { "replay_startrecord", cc_replay_startrecord, "Starts recording a new replay.", "replay_startrecord <name> [max_ticks]"},
     { "replay_stoprecord", cc_replay_stoprecord, "Stops recording a new replay.", "replay_stoprecord"},
-    { "replay_start", cc_replay_start, "Starts a replay", "replay_start <name>"},
+    { "replay_start", cc_replay_start, "Starts a replay, or only one segment of it", "replay_start <name> [segment]"},
+    { "replay_seek", cc_replay_seek, "Seeks the current replay to a tick", "replay_seek <tick>"},
     { "replay_stop", cc_replay_stop, "Stops the replay", "replay_stop"},
     { "replay_normalise", cc_replay_normalise, "Normalises the replay to remove all gaps", "replay_normalise <input file> <output file>"},
     { "mp_desync", cc_mp_desync, "Forces a multiplayer desync", "cc_mp_desync [desync_type, 0 = Random t-shirt color on random guest, 1 = Remove random guest ]"},
@@ -0,0 +1,365 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "MapTiles.h"
+
+#include "../Context.h"
+#include "../Diagnostic.h"
+#include "../core/File.h"
+#include "../core/FileSystem.hpp"
+#include "../core/Imaging.h"
+#include "../core/Path.hpp"
+#include "../drawing/X8DrawingEngine.h"
+#include "../platform/Platform2.h"
+#include "../world/Map.h"
+#include "../world/TileChanges.h"
+#include "Screenshot.h"
+#include "Viewport.h"
+#include "Window.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+
+using namespace OpenRCT2;
+using namespace OpenRCT2::Drawing;
+
+static constexpr int32_t MAP_TILE_SIZE = 256;
+// One level per zoom level, level 0 is the map zoomed out the furthest
+static constexpr int32_t MAP_TILE_LEVELS = 4;
+// How long images are painted for in each tick
+static constexpr uint32_t MAP_TILE_BUDGET_MS = 20;
+// Sprites drawn beyond the box of their tile, such as tree tops and the supports of track
+static constexpr int32_t MAP_TILE_MARGIN = 64;
+
+struct MapTileKey
+{
+    int32_t Level;
+    int32_t X;
+    int32_t Y;
+};
+
+struct MapTileLayout
+{
+    int32_t Rotation{ -1 };
+    ScreenCoordsXY Origin;
+    int32_t Width{};
+    int32_t Height{};
+};
+
+// The lowest and highest point of the elements of a tile when its images were last marked
+struct MapTileHeights
+{
+    int16_t BaseZ;
+    int16_t ClearanceZ;
+};
+
+static bool _enabled;
+static std::string _directory;
+static uint32_t _intervalMs;
+static uint32_t _lastPassTicks;
+static bool _passDue;
+
+static MapTileLayout _layout;
+static std::vector<MapTileHeights> _heights;
+static bool _allDirty;
+static std::unordered_set<uint64_t> _dirty[MAP_TILE_LEVELS];
+
+static std::vector<MapTileKey> _pass;
+static size_t _passIndex;
+
+static std::unique_ptr<X8DrawingEngine> _drawingEngine;
+static std::vector<uint8_t> _pixels;
+
+static ZoomLevel GetLevelZoom(int32_t level)
+{
+    return static_cast<int8_t>(MAP_TILE_LEVELS - 1 - level);
+}
+
+static int32_t GetLevelColumns(int32_t level)
+{
+    return ((_layout.Width / GetLevelZoom(level)) + MAP_TILE_SIZE - 1) / MAP_TILE_SIZE;
+}
+
+static int32_t GetLevelRows(int32_t level)
+{
+    return ((_layout.Height / GetLevelZoom(level)) + MAP_TILE_SIZE - 1) / MAP_TILE_SIZE;
+}
+
+static uint64_t GetKey(int32_t x, int32_t y)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+static MapTileHeights GetTileHeights(const TileCoordsXY& tilePos)
+{
+    MapTileHeights heights{ 0, 0 };
+    auto tileElement = map_get_first_element_at(tilePos.ToCoordsXY());
+    if (tileElement == nullptr)
+        return heights;
+
+    heights.BaseZ = tileElement->GetBaseZ();
+    do
+    {
+        heights.BaseZ = std::min<int16_t>(heights.BaseZ, tileElement->GetBaseZ());
+        heights.ClearanceZ = std::max<int16_t>(heights.ClearanceZ, tileElement->GetClearanceZ());
+    } while (!(tileElement++)->IsLastForTile());
+    return heights;
+}
+
+void MapTilesStart(const std::string& directory, uint32_t intervalSeconds)
+{
+    _directory = directory;
+    _intervalMs = std::max<uint32_t>(intervalSeconds, 1) * 1000;
+    _enabled = true;
+    _passDue = true;
+    _allDirty = true;
+    TileChangesSetConsumer(TileChangesConsumer::MapTiles, true);
+}
+
+void MapTilesStop()
+{
+    TileChangesSetConsumer(TileChangesConsumer::MapTiles, false);
+    _enabled = false;
+    _layout = {};
+    _heights.clear();
+    for (auto& dirty : _dirty)
+    {
+        dirty.clear();
+    }
+    _pass.clear();
+    _passIndex = 0;
+    _drawingEngine = nullptr;
+}
+
+bool MapTilesIsEnabled()
+{
+    return _enabled;
+}
+
+static void MarkTile(const TileCoordsXY& tilePos)
+{
+    if (tilePos.x < 0 || tilePos.y < 0 || tilePos.x >= MAXIMUM_MAP_SIZE_TECHNICAL || tilePos.y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+        return;
+
+    // The images over what was removed have to be painted too
+    auto& lastHeights = _heights[tilePos.y * MAXIMUM_MAP_SIZE_TECHNICAL + tilePos.x];
+    auto heights = GetTileHeights(tilePos);
+    auto baseZ = std::min(heights.BaseZ, lastHeights.BaseZ);
+    auto clearanceZ = std::max(heights.ClearanceZ, lastHeights.ClearanceZ);
+    lastHeights = heights;
+
+    auto mapPos = tilePos.ToCoordsXY();
+    ScreenCoordsXY topLeft{ std::numeric_limits<int32_t>::max(), std::numeric_limits<int32_t>::max() };
+    ScreenCoordsXY bottomRight{ std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::min() };
+    for (auto offset : { CoordsXY{ 0, 0 }, CoordsXY{ COORDS_XY_STEP, 0 }, CoordsXY{ 0, COORDS_XY_STEP },
+                         CoordsXY{ COORDS_XY_STEP, COORDS_XY_STEP } })
+    {
+        for (auto z : { baseZ, clearanceZ })
+        {
+            auto screenPos = translate_3d_to_2d_with_z(_layout.Rotation, CoordsXYZ{ mapPos + offset, z });
+            topLeft.x = std::min(topLeft.x, screenPos.x);
+            topLeft.y = std::min(topLeft.y, screenPos.y);
+            bottomRight.x = std::max(bottomRight.x, screenPos.x);
+            bottomRight.y = std::max(bottomRight.y, screenPos.y);
+        }
+    }
+    if (topLeft.y < _layout.Origin.y)
+    {
+        // Taller than anything the images were laid out for
+        _allDirty = true;
+        return;
+    }
+    topLeft -= _layout.Origin + ScreenCoordsXY{ MAP_TILE_MARGIN, MAP_TILE_MARGIN };
+    bottomRight -= _layout.Origin - ScreenCoordsXY{ MAP_TILE_MARGIN, MAP_TILE_MARGIN };
+
+    for (int32_t level = 0; level < MAP_TILE_LEVELS; level++)
+    {
+        auto zoom = GetLevelZoom(level);
+        auto left = std::max(0, (topLeft.x / zoom) / MAP_TILE_SIZE);
+        auto top = std::max(0, (topLeft.y / zoom) / MAP_TILE_SIZE);
+        auto right = std::min(GetLevelColumns(level) - 1, (bottomRight.x / zoom) / MAP_TILE_SIZE);
+        auto bottom = std::min(GetLevelRows(level) - 1, (bottomRight.y / zoom) / MAP_TILE_SIZE);
+        for (auto y = top; y <= bottom; y++)
+        {
+            for (auto x = left; x <= right; x++)
+            {
+                _dirty[level].insert(GetKey(x, y));
+            }
+        }
+    }
+}
+
+void MapTilesAddChanges(const TileChanges& changes)
+{
+    if (!_enabled || _allDirty)
+        return;
+
+    if (changes.All || _layout.Rotation != get_current_rotation())
+    {
+        _allDirty = true;
+        return;
+    }
+
+    for (const auto& tilePos : changes.Tiles)
+    {
+        MarkTile(tilePos);
+        if (_allDirty)
+            return;
+    }
+}
+
+static void WriteLayout()
+{
+    char json[256];
+    std::snprintf(
+        json, sizeof(json), "{\"tileSize\":%d,\"minZoom\":0,\"maxZoom\":%d,\"width\":%d,\"height\":%d}\n", MAP_TILE_SIZE,
+        MAP_TILE_LEVELS - 1, _layout.Width, _layout.Height);
+    File::WriteAllBytes(Path::Combine(_directory, "tiles.json"), json, std::strlen(json));
+}
+
+static void StartPass()
+{
+    _pass.clear();
+    _passIndex = 0;
+    if (_allDirty)
+    {
+        auto viewport = GetGiantViewport(gMapSize, get_current_rotation(), 0);
+        _layout.Rotation = get_current_rotation();
+        _layout.Origin = viewport.viewPos;
+        _layout.Width = viewport.view_width;
+        _layout.Height = viewport.view_height;
+
+        _heights.resize(MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL);
+        for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+        {
+            for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+            {
+                _heights[y * MAXIMUM_MAP_SIZE_TECHNICAL + x] = GetTileHeights({ x, y });
+            }
+        }
+
+        for (int32_t level = 0; level < MAP_TILE_LEVELS; level++)
+        {
+            _dirty[level].clear();
+            for (int32_t y = 0; y < GetLevelRows(level); y++)
+            {
+                for (int32_t x = 0; x < GetLevelColumns(level); x++)
+                {
+                    _pass.push_back({ level, x, y });
+                }
+            }
+        }
+        _allDirty = false;
+
+        try
+        {
+            Path::CreateDirectory(_directory);
+            WriteLayout();
+        }
+        catch (const std::exception& e)
+        {
+            log_error("Unable to write map tile layout: %s", e.what());
+        }
+    }
+    else
+    {
+        for (int32_t level = 0; level < MAP_TILE_LEVELS; level++)
+        {
+            for (auto key : _dirty[level])
+            {
+                _pass.push_back({ level, static_cast<int32_t>(key >> 32), static_cast<int32_t>(key & 0xFFFFFFFF) });
+            }
+            _dirty[level].clear();
+        }
+    }
+}
+
+static void PaintMapTile(const MapTileKey& key)
+{
+    auto zoom = GetLevelZoom(key.Level);
+    rct_viewport viewport{};
+    viewport.viewPos = _layout.Origin + ScreenCoordsXY{ (key.X * MAP_TILE_SIZE) * zoom, (key.Y * MAP_TILE_SIZE) * zoom };
+    viewport.width = MAP_TILE_SIZE;
+    viewport.height = MAP_TILE_SIZE;
+    viewport.view_width = MAP_TILE_SIZE * zoom;
+    viewport.view_height = MAP_TILE_SIZE * zoom;
+    viewport.zoom = zoom;
+    viewport.flags = VIEWPORT_FLAG_TRANSPARENT_BACKGROUND;
+
+    if (_drawingEngine == nullptr)
+    {
+        _drawingEngine = std::make_unique<X8DrawingEngine>(GetContext()->GetUiContext());
+    }
+    _pixels.assign(MAP_TILE_SIZE * MAP_TILE_SIZE, PALETTE_INDEX_0);
+
+    rct_drawpixelinfo dpi;
+    dpi.bits = _pixels.data();
+    dpi.width = MAP_TILE_SIZE;
+    dpi.height = MAP_TILE_SIZE;
+    dpi.DrawingEngine = _drawingEngine.get();
+    viewport_render(&dpi, &viewport, 0, 0, MAP_TILE_SIZE, MAP_TILE_SIZE);
+
+    Image image;
+    image.Width = MAP_TILE_SIZE;
+    image.Height = MAP_TILE_SIZE;
+    image.Depth = 8;
+    image.Stride = MAP_TILE_SIZE;
+    image.Palette = std::make_unique<GamePalette>(gPalette);
+    image.Pixels = _pixels;
+
+    auto directory = Path::Combine(_directory, std::to_string(key.Level), std::to_string(key.X));
+    auto path = Path::Combine(directory, std::to_string(key.Y) + ".png");
+    Path::CreateDirectory(directory);
+
+    // Written next to the image first, so viewers never read one that is half written
+    auto tempPath = path + ".tmp";
+    Imaging::WriteToFile(tempPath, image, IMAGE_FORMAT::PNG);
+    std::error_code ec;
+    fs::rename(fs::u8path(tempPath), fs::u8path(path), ec);
+    if (ec)
+    {
+        throw std::runtime_error(ec.message());
+    }
+}
+
+void MapTilesUpdate()
+{
+    if (!_enabled)
+        return;
+
+    auto ticks = Platform::GetTicks();
+    if (_passIndex >= _pass.size())
+    {
+        if (!_passDue && ticks - _lastPassTicks < _intervalMs)
+            return;
+
+        _passDue = false;
+        _lastPassTicks = ticks;
+        StartPass();
+    }
+
+    while (_passIndex < _pass.size() && Platform::GetTicks() - ticks < MAP_TILE_BUDGET_MS)
+    {
+        const auto& key = _pass[_passIndex++];
+        try
+        {
+            PaintMapTile(key);
+        }
+        catch (const std::exception& e)
+        {
+            log_error("Unable to write map tile %d/%d/%d: %s", key.Level, key.X, key.Y, e.what());
+        }
+    }
+}
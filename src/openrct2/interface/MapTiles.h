@@ -0,0 +1,36 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+
+#include <string>
+
+struct TileChanges;
+
+/*
+ * Keeps a pyramid of map images up to date on disk while the park runs, for web map viewers. The images are
+ * laid out as <directory>/<z>/<x>/<y>.png, 256 pixels square, where the highest z is the map at 100% zoom and
+ * each level below it halves the size. Only the images over tiles whose elements changed are painted again.
+ */
+void MapTilesStart(const std::string& directory, uint32_t intervalSeconds);
+void MapTilesStop();
+bool MapTilesIsEnabled();
+
+/**
+ * Marks the images over the changed tiles to be painted on the next pass.
+ */
+void MapTilesAddChanges(const TileChanges& changes);
+
+/**
+ * Called once per tick, starts a pass whenever the interval has passed and paints the images of the current pass
+ * for a few milliseconds so the game does not stall.
+ */
+void MapTilesUpdate();
@@ -18,6 +18,7 @@
 #include "../audio/audio.h"
 #include "../core/Console.hpp"
 #include "../core/Imaging.h"
+#include "../core/TaskScheduler.h"
 #include "../drawing/Drawing.h"
 #include "../drawing/X8DrawingEngine.h"
 #include "../localisation/Localisation.h"
@@ -29,9 +30,11 @@
 #include "../world/Surface.h"
 #include "Viewport.h"
 
+#include <array>
 #include <cctype>
 #include <chrono>
 #include <cstdlib>
+#include <exception>
 #include <memory>
 #include <optional>
 #include <string>
@@ -335,7 +338,7 @@ static void ReleaseDPI(rct_drawpixelinfo& dpi)
     dpi.height = 0;
 }
 
-static rct_viewport GetGiantViewport(int32_t mapSize, int32_t rotation, ZoomLevel zoom)
+rct_viewport GetGiantViewport(int32_t mapSize, int32_t rotation, ZoomLevel zoom)
 {
     // Get the tile coordinates of each corner
     auto leftTileCoords = GetEdgeTile(mapSize, rotation, EdgeType::LEFT, false);
@@ -378,9 +381,95 @@ static void RenderViewport(IDrawingEngine* drawingEngine, const rct_viewport& vi
     viewport_render(&dpi, &viewport, 0, 0, viewport.width, viewport.height);
 }
 
+// Rows of the image that are painted at once
+static constexpr int32_t SCREENSHOT_STRIP_HEIGHT = 256;
+
+struct ScreenshotStripJob
+{
+    Imaging::PngRowWriter* Writer{};
+    const uint8_t* Pixels{};
+    uint32_t Rows{};
+    uint32_t Stride{};
+    std::exception_ptr Error;
+};
+
+static void EncodeScreenshotStrip(void* context, size_t, size_t)
+{
+    auto& job = *static_cast<ScreenshotStripJob*>(context);
+    try
+    {
+        job.Writer->WriteRows(job.Pixels, job.Rows, job.Stride);
+    }
+    catch (...)
+    {
+        job.Error = std::current_exception();
+    }
+}
+
+/**
+ * Paints the viewport a strip at a time and streams the strips into a PNG, so only two strips are
+ * held in memory however big the image is. Each strip is compressed by the scheduler while the next
+ * one is painted, the painting itself is already spread over the scheduler by viewport_paint.
+ */
+static void RenderViewportToFile(std::string_view path, const rct_viewport& viewport)
+{
+    // Ensure sprites appear regardless of rotation
+    reset_all_sprite_quadrant_placements();
+
+    X8DrawingEngine drawingEngine(GetContext()->GetUiContext());
+    Imaging::PngRowWriter writer(path, viewport.width, viewport.height, gPalette);
+
+    auto stripHeight = std::min<int32_t>(SCREENSHOT_STRIP_HEIGHT, viewport.height);
+    auto stripSize = static_cast<size_t>(viewport.width) * stripHeight;
+    std::array<std::vector<uint8_t>, 2> strips;
+    for (auto& strip : strips)
+    {
+        strip.resize(stripSize);
+    }
+
+    auto& scheduler = TaskScheduler::Get();
+    std::atomic<size_t> pending = { 0 };
+    ScreenshotStripJob job;
+    size_t stripIndex = 0;
+    for (int32_t top = 0; top < viewport.height; top += stripHeight)
+    {
+        // The other strip may still be compressed meanwhile, the one painted now was finished before it was submitted
+        auto& strip = strips[stripIndex];
+        auto rows = std::min<int32_t>(stripHeight, viewport.height - top);
+        if (viewport.flags & VIEWPORT_FLAG_TRANSPARENT_BACKGROUND)
+        {
+            std::fill(strip.begin(), strip.end(), PALETTE_INDEX_0);
+        }
+
+        rct_drawpixelinfo dpi;
+        dpi.bits = strip.data();
+        dpi.x = 0;
+        dpi.y = top;
+        dpi.width = viewport.width;
+        dpi.height = rows;
+        dpi.DrawingEngine = &drawingEngine;
+        viewport_render(&dpi, &viewport, 0, top, viewport.width, top + rows);
+
+        scheduler.Wait(pending);
+        if (job.Error)
+        {
+            std::rethrow_exception(job.Error);
+        }
+        job = { &writer, strip.data(), static_cast<uint32_t>(rows), static_cast<uint32_t>(viewport.width), nullptr };
+        scheduler.Submit({ &EncodeScreenshotStrip, &job, 0, 1, &pending });
+        stripIndex ^= 1;
+    }
+
+    scheduler.Wait(pending);
+    if (job.Error)
+    {
+        std::rethrow_exception(job.Error);
+    }
+    writer.Finish();
+}
+
 void screenshot_giant()
 {
-    rct_drawpixelinfo dpi{};
     try
     {
         auto path = screenshot_get_next_path();
@@ -409,10 +498,7 @@ void screenshot_giant()
             viewport.flags |= VIEWPORT_FLAG_TRANSPARENT_BACKGROUND;
         }
 
-        dpi = CreateDPI(viewport);
-
-        RenderViewport(nullptr, viewport, dpi);
-        WriteDpiToFile(path->c_str(), &dpi, gPalette);
+        RenderViewportToFile(*path, viewport);
 
         // Show user that screenshot saved successfully
         Formatter ft;
@@ -425,8 +511,6 @@ void screenshot_giant()
         log_error("%s", e.what());
         context_show_error(STR_SCREENSHOT_FAILED, STR_NONE, {});
     }
-
-    ReleaseDPI(dpi);
 }
 
 // TODO: Move this at some point into a more appropriate place.
@@ -619,7 +703,6 @@ int32_t cmdline_for_screenshot(const char** argv, int32_t argc, ScreenshotOption
     }
 
     int32_t exitCode = 1;
-    rct_drawpixelinfo dpi;
     try
     {
         core_init();
@@ -721,17 +804,13 @@ int32_t cmdline_for_screenshot(const char** argv, int32_t argc, ScreenshotOption
 
         ApplyOptions(options, viewport);
 
-        dpi = CreateDPI(viewport);
-
-        RenderViewport(nullptr, viewport, dpi);
-        WriteDpiToFile(outputPath, &dpi, gPalette);
+        RenderViewportToFile(outputPath, viewport);
     }
     catch (const std::exception& e)
     {
         std::printf("%s\n", e.what());
         exitCode = -1;
     }
-    ReleaseDPI(dpi);
 
     drawing_engine_dispose();
 
@@ -820,10 +899,14 @@ void CaptureImage(const CaptureOptions& options)
     }
 
     auto outputPath = ResolveFilenameForCapture(options.Filename);
-    auto dpi = CreateDPI(viewport);
-    RenderViewport(nullptr, viewport, dpi);
-    WriteDpiToFile(outputPath, &dpi, gPalette);
-    ReleaseDPI(dpi);
+    try
+    {
+        RenderViewportToFile(outputPath, viewport);
+    }
+    catch (const std::exception& e)
+    {
+        log_error("Unable to write png: %s", e.what());
+    }
 
     gCurrentRotation = backupRotation;
 }
@@ -19,6 +19,7 @@
 #include <string>
 
 struct rct_drawpixelinfo;
+struct rct_viewport;
 
 extern uint8_t gScreenshotCountdown;
 
@@ -57,6 +58,11 @@ std::string screenshot_dump();
 std::string screenshot_dump_png(rct_drawpixelinfo* dpi);
 std::string screenshot_dump_png_32bpp(int32_t width, int32_t height, const void* pixels);
 
+/**
+ * The viewport that fits the whole map, its view position does not depend on the zoom level.
+ */
+rct_viewport GetGiantViewport(int32_t mapSize, int32_t rotation, ZoomLevel zoom);
+
 void screenshot_giant();
 int32_t cmdline_for_screenshot(const char** argv, int32_t argc, ScreenshotOptions* options);
 int32_t cmdline_for_gfxbench(const char** argv, int32_t argc);
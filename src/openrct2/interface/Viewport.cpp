@@ -15,8 +15,10 @@
 #include "../OpenRCT2.h"
 #include "../config/Config.h"
 #include "../core/Guard.hpp"
-#include "../core/JobPool.h"
+#include "../core/Profiling.h"
+#include "../core/TaskScheduler.h"
 #include "../drawing/Drawing.h"
+#include "../drawing/FrameStatistics.h"
 #include "../drawing/IDrawingEngine.h"
 #include "../paint/Paint.h"
 #include "../peep/Staff.h"
@@ -35,6 +37,7 @@
 #include <algorithm>
 #include <cstring>
 #include <list>
+#include <unordered_map>
 
 using namespace OpenRCT2;
 
@@ -46,9 +49,15 @@ uint8_t gShowConstuctionRightsRefCount;
 static std::list<rct_viewport> _viewports;
 rct_viewport* g_music_tracking_viewport;
 
-static std::unique_ptr<JobPool> _paintJobs;
 static std::vector<paint_session*> _paintColumns;
 
+// Paint structs per pixel row that each column produced the last time it was painted, keyed by zoom level and column.
+static std::unordered_map<uint32_t, float> _paintColumnDensities;
+static std::vector<float> _paintColumnCosts;
+static std::vector<size_t> _paintBatchStarts;
+static std::vector<float> _paintBatchCosts;
+static std::vector<size_t> _paintBatchOrder;
+
 ScreenCoordsXY gSavedView;
 ZoomLevel gSavedViewZoom;
 uint8_t gSavedViewRotation;
@@ -216,6 +225,25 @@ void viewports_invalidate(int32_t left, int32_t top, int32_t right, int32_t bott
     }
 }
 
+/**
+ * Whether the area, in view coordinates, can be seen in any viewport that is not covered by another window.
+ */
+bool viewports_intersect(int32_t left, int32_t top, int32_t right, int32_t bottom)
+{
+    for (const auto& vp : _viewports)
+    {
+        if (vp.visibility == VisibilityCache::Covered)
+            continue;
+
+        if (right > vp.viewPos.x && bottom > vp.viewPos.y && left < vp.viewPos.x + vp.view_width
+            && top < vp.viewPos.y + vp.view_height)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 /**
  *
  *  rct2: 0x00689174
@@ -805,7 +833,7 @@ void viewport_update_smart_vehicle_follow(rct_window* window)
  */
 void viewport_render(
     rct_drawpixelinfo* dpi, const rct_viewport* viewport, int32_t left, int32_t top, int32_t right, int32_t bottom,
-    std::vector<paint_session>* sessions)
+    std::vector<RecordedPaintSession>* sessions)
 {
     if (right <= viewport->pos.x)
         return;
@@ -846,36 +874,50 @@ void viewport_render(
 #endif
 }
 
-static void record_session(const paint_session* session, std::vector<paint_session>* recorded_sessions, size_t record_index)
+static void record_session(
+    const paint_session* session, std::vector<RecordedPaintSession>* recorded_sessions, size_t record_index)
 {
     // Perform a deep copy of the paint session, use relative offsets.
     // This is done to extract the session for benchmark.
     // Place the copied session at provided record_index, so the caller can decide which columns/paint sessions to copy;
     // there is no column information embedded in the session itself.
-    (*recorded_sessions)[record_index] = (*session);
-    paint_session* session_copy = &recorded_sessions->at(record_index);
+    auto& recorded = recorded_sessions->at(record_index);
+    recorded.Session = *session;
+
+    const auto& entries = session->PaintStructs;
+    recorded.Entries.resize(entries.size());
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        recorded.Entries[i] = entries[i];
+    }
 
-    // Mind the offset needs to be calculated against the original `session`, not `session_copy`
-    for (auto& ps : session_copy->PaintStructs)
+    // Mind the offset needs to be calculated against the original `session`, not the copy
+    auto getIndex = [&entries](const paint_struct* ps) {
+        return reinterpret_cast<paint_struct*>(ps != nullptr ? entries.IndexOf(ps) : entries.size());
+    };
+    for (auto& entry : recorded.Entries)
     {
-        ps.basic.next_quadrant_ps = reinterpret_cast<paint_struct*>(
-            ps.basic.next_quadrant_ps ? int(ps.basic.next_quadrant_ps - &session->PaintStructs[0].basic)
-                                      : std::size(session->PaintStructs));
+        entry.basic.next_quadrant_ps = getIndex(entry.basic.next_quadrant_ps);
     }
-    for (auto& quad : session_copy->Quadrants)
+    for (auto& quad : recorded.Session.Quadrants)
     {
-        quad = reinterpret_cast<paint_struct*>(
-            quad ? int(quad - &session->PaintStructs[0].basic) : std::size(session->Quadrants));
+        quad = getIndex(quad);
     }
 }
 
-static void viewport_fill_column(paint_session* session, std::vector<paint_session>* recorded_sessions, size_t record_index)
+static void viewport_fill_column(
+    paint_session* session, std::vector<RecordedPaintSession>* recorded_sessions, size_t record_index)
 {
-    PaintSessionGenerate(session);
+    {
+        FrameTimingScope timingScope(FrameTiming::PaintGenerate);
+        PaintSessionGenerate(session);
+    }
+    FrameStatisticsAddSession(static_cast<uint32_t>(session->PaintStructs.size()), session->AttachedPaintStructCount);
     if (recorded_sessions != nullptr)
     {
         record_session(session, recorded_sessions, record_index);
     }
+    FrameTimingScope timingScope(FrameTiming::PaintArrange);
     PaintSessionArrange(session);
 }
 
@@ -894,7 +936,10 @@ static void viewport_paint_column(paint_session* session)
         gfx_clear(&session->DPI, colour);
     }
 
-    PaintDrawStructs(session);
+    {
+        FrameTimingScope timingScope(FrameTiming::PaintDraw);
+        PaintDrawStructs(session);
+    }
 
     if (gConfigGeneral.render_weather_gloom && !gTrackDesignSaveMode && !(session->ViewFlags & VIEWPORT_FLAG_INVISIBLE_SPRITES)
         && !(session->ViewFlags & VIEWPORT_FLAG_HIGHLIGHT_PATH_ISSUES))
@@ -910,6 +955,81 @@ static void viewport_paint_column(paint_session* session)
     PaintSessionFree(session);
 }
 
+static uint32_t viewport_column_key(ZoomLevel zoom, int16_t x)
+{
+    return (static_cast<uint8_t>(static_cast<int8_t>(zoom)) << 16) | static_cast<uint16_t>(x);
+}
+
+/**
+ * Groups neighbouring columns into batches of roughly equal cost, estimated from the paint struct density the same
+ * columns had last time, and orders the batches most expensive first so they are the first to be taken by workers.
+ * Columns that have not been painted before are assumed to be of average density.
+ */
+static void viewport_plan_column_batches(ZoomLevel zoom, int16_t alignedX, int16_t height)
+{
+    const size_t columnCount = _paintColumns.size();
+    _paintColumnCosts.resize(columnCount);
+
+    float knownDensity = 0;
+    size_t knownColumns = 0;
+    for (size_t i = 0; i < columnCount; i++)
+    {
+        auto it = _paintColumnDensities.find(viewport_column_key(zoom, alignedX + static_cast<int16_t>(i * 32)));
+        _paintColumnCosts[i] = -1;
+        if (it != _paintColumnDensities.end())
+        {
+            _paintColumnCosts[i] = it->second;
+            knownDensity += it->second;
+            knownColumns++;
+        }
+    }
+    const float averageDensity = knownColumns != 0 ? knownDensity / knownColumns : 0;
+
+    float totalCost = 0;
+    for (auto& cost : _paintColumnCosts)
+    {
+        // Every column has a fixed cost for its session, even when there is nothing to paint.
+        cost = 1 + (cost < 0 ? averageDensity : cost) * height;
+        totalCost += cost;
+    }
+
+    const size_t batchCount = std::min(columnCount, TaskScheduler::Get().GetConcurrency() * 4);
+    const float targetCost = totalCost / batchCount;
+    _paintBatchStarts.clear();
+    _paintBatchCosts.clear();
+    for (size_t i = 0; i < columnCount; i++)
+    {
+        if (_paintBatchStarts.empty() || _paintBatchCosts.back() + _paintColumnCosts[i] > targetCost)
+        {
+            _paintBatchStarts.push_back(i);
+            _paintBatchCosts.push_back(0);
+        }
+        _paintBatchCosts.back() += _paintColumnCosts[i];
+    }
+    _paintBatchStarts.push_back(columnCount);
+
+    _paintBatchOrder.resize(_paintBatchCosts.size());
+    for (size_t i = 0; i < _paintBatchOrder.size(); i++)
+    {
+        _paintBatchOrder[i] = i;
+    }
+    std::stable_sort(_paintBatchOrder.begin(), _paintBatchOrder.end(), [](size_t a, size_t b) {
+        return _paintBatchCosts[a] > _paintBatchCosts[b];
+    });
+}
+
+static void viewport_update_column_densities(ZoomLevel zoom, int16_t alignedX, int16_t height)
+{
+    if (height <= 0)
+        return;
+
+    for (size_t i = 0; i < _paintColumns.size(); i++)
+    {
+        auto key = viewport_column_key(zoom, alignedX + static_cast<int16_t>(i * 32));
+        _paintColumnDensities[key] = static_cast<float>(_paintColumns[i]->PaintStructs.size()) / height;
+    }
+}
+
 /**
  *
  *  rct2: 0x00685CBF
@@ -922,8 +1042,11 @@ static void viewport_paint_column(paint_session* session)
  */
 void viewport_paint(
     const rct_viewport* viewport, rct_drawpixelinfo* dpi, int16_t left, int16_t top, int16_t right, int16_t bottom,
-    std::vector<paint_session>* recorded_sessions)
+    std::vector<RecordedPaintSession>* recorded_sessions)
 {
+    PROFILE_SCOPE("viewport_paint");
+    FrameTimingScope timingScope(FrameTiming::Viewports);
+
     uint32_t viewFlags = viewport->flags;
     uint16_t width = right - left;
     uint16_t height = bottom - top;
@@ -964,14 +1087,6 @@ void viewport_paint(
     _paintColumns.clear();
 
     bool useMultithreading = gConfigGeneral.multithreading;
-    if (useMultithreading && _paintJobs == nullptr)
-    {
-        _paintJobs = std::make_unique<JobPool>();
-    }
-    else if (useMultithreading == false && _paintJobs != nullptr)
-    {
-        _paintJobs.reset();
-    }
 
     // Create space to record sessions and keep track which index is being drawn
     size_t index = 0;
@@ -1007,12 +1122,7 @@ void viewport_paint(
         }
         dpi2.width = paintRight - dpi2.x;
 
-        if (useMultithreading)
-        {
-            _paintJobs->AddTask(
-                [session, recorded_sessions, index]() -> void { viewport_fill_column(session, recorded_sessions, index); });
-        }
-        else
+        if (!useMultithreading)
         {
             viewport_fill_column(session, recorded_sessions, index);
         }
@@ -1020,7 +1130,17 @@ void viewport_paint(
 
     if (useMultithreading)
     {
-        _paintJobs->Join();
+        // Columns stay 32 pixels wide, the sprite sort depends on the column bounds so changing them would change the
+        // output. Only the way they are handed out to the workers adapts to the scene.
+        viewport_plan_column_batches(viewport->zoom, alignedX, dpi1.height);
+        TaskScheduler::Get().ParallelFor(_paintBatchOrder.size(), 1, [recorded_sessions](size_t i) {
+            const auto batch = _paintBatchOrder[i];
+            for (size_t column = _paintBatchStarts[batch]; column < _paintBatchStarts[batch + 1]; column++)
+            {
+                viewport_fill_column(_paintColumns[column], recorded_sessions, column);
+            }
+        });
+        viewport_update_column_densities(viewport->zoom, alignedX, dpi1.height);
     }
 
     for (auto column : _paintColumns)
@@ -18,6 +18,7 @@
 #include "../config/Config.h"
 #include "../core/Guard.hpp"
 #include "../drawing/Drawing.h"
+#include "../drawing/NewDrawing.h"
 #include "../interface/Cursors.h"
 #include "../localisation/Localisation.h"
 #include "../localisation/StringIds.h"
@@ -34,12 +35,21 @@
 #include "Window_internal.h"
 
 #include <algorithm>
+#include <array>
+#include <bitset>
 #include <cmath>
+#include <cstring>
 #include <functional>
 #include <iterator>
 #include <list>
 
 std::list<std::shared_ptr<rct_window>> g_window_list;
+
+// Number of open windows of each class, so invalidating a class with no open windows costs nothing
+static std::array<uint16_t, 256> _windowClassCounts;
+// Classes to invalidate the next time the windows are drawn
+static std::bitset<256> _pendingClassInvalidations;
+static bool _invalidationsPending;
 rct_window* gWindowAudioExclusive;
 
 uint16_t TextInputDescriptionArgs[4];
@@ -87,6 +97,9 @@ namespace WindowCloseFlags
 
 static void window_draw_core(rct_drawpixelinfo* dpi, rct_window* w, int32_t left, int32_t top, int32_t right, int32_t bottom);
 static void window_draw_single(rct_drawpixelinfo* dpi, rct_window* w, int32_t left, int32_t top, int32_t right, int32_t bottom);
+static bool window_can_cache_pixels(const rct_window* w);
+static bool window_has_cached_pixels(const rct_window* w);
+static void window_draw_cached_pixels(rct_drawpixelinfo* dpi, const rct_window* w);
 
 std::list<std::shared_ptr<rct_window>>::iterator window_get_iterator(const rct_window* w)
 {
@@ -95,6 +108,16 @@ std::list<std::shared_ptr<rct_window>>::iterator window_get_iterator(const rct_w
     });
 }
 
+void window_register(rct_window* w)
+{
+    _windowClassCounts[w->classification]++;
+}
+
+static bool window_class_is_open(rct_windowclass cls)
+{
+    return _windowClassCounts[cls] != 0;
+}
+
 void window_visit_each(std::function<void(rct_window*)> func)
 {
     auto windowList = g_window_list;
@@ -227,7 +250,10 @@ void window_close(rct_window* w)
     // The window list may have been modified in the close event
     itWindow = window_get_iterator(w);
     if (itWindow != g_window_list.end())
+    {
+        _windowClassCounts[window->classification]--;
         g_window_list.erase(itWindow);
+    }
 }
 
 template<typename _TPred> static void window_close_by_condition(_TPred pred, uint32_t flags = WindowCloseFlags::None)
@@ -310,6 +336,9 @@ void window_close_by_number(rct_windowclass cls, rct_windownumber number)
  */
 rct_window* window_find_by_class(rct_windowclass cls)
 {
+    if (!window_class_is_open(cls))
+        return nullptr;
+
     for (auto& w : g_window_list)
     {
         if (w->classification == cls)
@@ -329,6 +358,9 @@ rct_window* window_find_by_class(rct_windowclass cls)
  */
 rct_window* window_find_by_number(rct_windowclass cls, rct_windownumber number)
 {
+    if (!window_class_is_open(cls))
+        return nullptr;
+
     for (auto& w : g_window_list)
     {
         if (w->classification == cls && w->number == number)
@@ -454,39 +486,58 @@ rct_widgetindex window_find_widget_from_point(rct_window* w, const ScreenCoordsX
 }
 
 /**
- * Invalidates the specified window.
- *  rct2: 0x006EB13A
- *
- * @param window The window to invalidate (esi).
+ * Invalidates all windows with the specified window class. The windows are invalidated once when they are
+ * next drawn, no matter how often this is called until then.
+ *  rct2: 0x006EC3AC
+ * @param cls (al) with bit 14 set
  */
-template<typename _TPred> static void window_invalidate_by_condition(_TPred pred)
+void window_invalidate_by_class(rct_windowclass cls)
 {
-    window_visit_each([pred](rct_window* w) {
-        if (pred(w))
-        {
-            w->Invalidate();
-        }
-    });
+    if (window_class_is_open(cls))
+    {
+        _pendingClassInvalidations.set(cls);
+        _invalidationsPending = true;
+    }
 }
 
 /**
- * Invalidates all windows with the specified window class.
+ * Invalidates all windows with the specified window class and number, when they are next drawn.
  *  rct2: 0x006EC3AC
- * @param cls (al) with bit 14 set
  */
-void window_invalidate_by_class(rct_windowclass cls)
+void window_invalidate_by_number(rct_windowclass cls, rct_windownumber number)
 {
-    window_invalidate_by_condition([cls](rct_window* w) -> bool { return w->classification == cls; });
+    if (!window_class_is_open(cls) || _pendingClassInvalidations.test(cls))
+        return;
+
+    for (auto& w : g_window_list)
+    {
+        if (w->classification == cls && w->number == number)
+        {
+            w->invalidate_pending = true;
+            _invalidationsPending = true;
+        }
+    }
 }
 
 /**
- * Invalidates all windows with the specified window class and number.
- *  rct2: 0x006EC3AC
+ * Invalidates the windows of the invalidations deferred since the last call, called once before the windows
+ * are drawn.
  */
-void window_invalidate_by_number(rct_windowclass cls, rct_windownumber number)
+void window_flush_invalidations()
 {
-    window_invalidate_by_condition(
-        [cls, number](rct_window* w) -> bool { return w->classification == cls && w->number == number; });
+    if (!_invalidationsPending)
+        return;
+
+    for (auto& w : g_window_list)
+    {
+        if (w->invalidate_pending || _pendingClassInvalidations.test(w->classification))
+        {
+            w->invalidate_pending = false;
+            w->Invalidate();
+        }
+    }
+    _pendingClassInvalidations.reset();
+    _invalidationsPending = false;
 }
 
 /**
@@ -497,6 +548,18 @@ void window_invalidate_all()
     window_visit_each([](rct_window* w) { w->Invalidate(); });
 }
 
+/**
+ * Makes every window paint itself again when it is next drawn, for changes that affect windows without them being
+ * invalidated, such as the whole screen being invalidated.
+ */
+void window_discard_cached_pixels()
+{
+    for (auto& w : g_window_list)
+    {
+        w->cached_pixels_valid = false;
+    }
+}
+
 /**
  * Invalidates the specified widget of a window.
  *  rct2: 0x006EC402
@@ -513,6 +576,9 @@ void widget_invalidate(rct_window* w, rct_widgetindex widgetIndex)
     }
 #endif
 
+    // The cached pixels hold the whole window, so any widget change means painting it again
+    w->cached_pixels_valid = false;
+
     widget = &w->widgets[widgetIndex];
     if (widget->left == -2)
         return;
@@ -521,27 +587,21 @@ void widget_invalidate(rct_window* w, rct_widgetindex widgetIndex)
                            { w->windowPos + ScreenCoordsXY{ widget->right + 1, widget->bottom + 1 } } });
 }
 
-template<typename _TPred> static void widget_invalidate_by_condition(_TPred pred)
-{
-    window_visit_each([pred](rct_window* w) {
-        if (pred(w))
-        {
-            w->Invalidate();
-        }
-    });
-}
-
 /**
  * Invalidates the specified widget of all windows that match the specified window class.
  */
 void widget_invalidate_by_class(rct_windowclass cls, rct_widgetindex widgetIndex)
 {
-    window_visit_each([cls, widgetIndex](rct_window* w) {
+    if (!window_class_is_open(cls))
+        return;
+
+    for (auto& w : g_window_list)
+    {
         if (w->classification == cls)
         {
-            widget_invalidate(w, widgetIndex);
+            widget_invalidate(w.get(), widgetIndex);
         }
-    });
+    }
 }
 
 /**
@@ -550,12 +610,16 @@ void widget_invalidate_by_class(rct_windowclass cls, rct_widgetindex widgetIndex
  */
 void widget_invalidate_by_number(rct_windowclass cls, rct_windownumber number, rct_widgetindex widgetIndex)
 {
-    window_visit_each([cls, number, widgetIndex](rct_window* w) {
+    if (!window_class_is_open(cls))
+        return;
+
+    for (auto& w : g_window_list)
+    {
         if (w->classification == cls && w->number == number)
         {
-            widget_invalidate(w, widgetIndex);
+            widget_invalidate(w.get(), widgetIndex);
         }
-    });
+    }
 }
 
 /**
@@ -1224,6 +1288,14 @@ static void window_draw_single(rct_drawpixelinfo* dpi, rct_window* w, int32_t le
             return;
     }
 
+    // Windows that did not change since they were last painted are copied from their cached pixels. This keeps
+    // windows on top of a moving viewport from painting every frame.
+    if (window_has_cached_pixels(w) && dpi->zoom_level == 0)
+    {
+        window_draw_cached_pixels(dpi, w);
+        return;
+    }
+
     // Invalidate modifies the window colours so first get the correct
     // colour before setting the global variables for the string painting
     window_event_invalidate_call(w);
@@ -1234,7 +1306,82 @@ static void window_draw_single(rct_drawpixelinfo* dpi, rct_window* w, int32_t le
     gCurrentWindowColours[2] = NOT_TRANSLUCENT(w->colours[2]);
     gCurrentWindowColours[3] = NOT_TRANSLUCENT(w->colours[3]);
 
-    window_event_paint_call(w, dpi);
+    if (!window_can_cache_pixels(w) || dpi->zoom_level != 0)
+    {
+        w->cached_pixels.clear();
+        w->cached_pixels.shrink_to_fit();
+        w->cached_pixels_valid = false;
+        window_event_paint_call(w, dpi);
+        return;
+    }
+
+    // The whole window is painted into the cache, even if only part of it is drawn now
+    w->cached_pixels.resize(static_cast<size_t>(w->width) * w->height);
+    rct_drawpixelinfo cacheDPI = {};
+    cacheDPI.bits = w->cached_pixels.data();
+    cacheDPI.x = w->windowPos.x;
+    cacheDPI.y = w->windowPos.y;
+    cacheDPI.width = w->width;
+    cacheDPI.height = w->height;
+    cacheDPI.DrawingEngine = dpi->DrawingEngine;
+
+    // Set before painting, so windows that invalidate themselves while painting are painted again next time
+    w->cached_pixels_valid = true;
+    window_event_paint_call(w, &cacheDPI);
+    window_draw_cached_pixels(dpi, w);
+}
+
+/**
+ * Whether the window can be drawn from pixels painted earlier. The window must paint every one of its pixels without
+ * looking at what is underneath, so it has to be opaque, start with a frame covering all of it and not have a
+ * viewport. The cached pixels are in palette indices, so only the software drawing engines can use them.
+ */
+static bool window_can_cache_pixels(const rct_window* w)
+{
+    if (w->viewport != nullptr || (w->flags & (WF_TRANSPARENT | WF_NO_BACKGROUND)))
+        return false;
+
+    for (auto colour : w->colours)
+    {
+        if (colour & COLOUR_FLAG_TRANSLUCENT)
+            return false;
+    }
+
+    const auto* frame = w->widgets;
+    if (frame == nullptr || frame->type != WindowWidgetType::Frame || frame->left > 0 || frame->top > 0
+        || frame->right < w->width - 1 || frame->bottom < w->height - 1)
+    {
+        return false;
+    }
+    return drawing_engine_has_dirty_optimisations();
+}
+
+static bool window_has_cached_pixels(const rct_window* w)
+{
+    return w->cached_pixels_valid && w->viewport == nullptr
+        && w->cached_pixels.size() == static_cast<size_t>(w->width) * w->height;
+}
+
+/**
+ * Copies the part of the window's cached pixels that lies within the clipped dpi.
+ */
+static void window_draw_cached_pixels(rct_drawpixelinfo* dpi, const rct_window* w)
+{
+    const int32_t left = std::max<int32_t>(dpi->x, w->windowPos.x);
+    const int32_t top = std::max<int32_t>(dpi->y, w->windowPos.y);
+    const int32_t right = std::min<int32_t>(dpi->x + dpi->width, w->windowPos.x + w->width);
+    const int32_t bottom = std::min<int32_t>(dpi->y + dpi->height, w->windowPos.y + w->height);
+    if (left >= right || top >= bottom)
+        return;
+
+    const size_t dstStride = dpi->width + dpi->pitch;
+    const size_t length = right - left;
+    for (int32_t y = top; y < bottom; y++)
+    {
+        const auto* src = &w->cached_pixels[(y - w->windowPos.y) * w->width + (left - w->windowPos.x)];
+        auto* dst = dpi->bits + (y - dpi->y) * dstStride + (left - dpi->x);
+        std::memcpy(dst, src, length);
+    }
 }
 
 /**
@@ -41,6 +41,7 @@ void rct_window::ScrollToViewport()
 
 void rct_window::Invalidate()
 {
+    cached_pixels_valid = false;
     gfx_set_dirty_blocks({ windowPos, windowPos + ScreenCoordsXY{ width, height } });
 }
 
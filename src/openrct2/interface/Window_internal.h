@@ -13,6 +13,7 @@
 
 #include <list>
 #include <memory>
+#include <vector>
 
 enum class TileInspectorPage : int16_t;
 
@@ -102,6 +103,9 @@ struct rct_window
     colour_t colours[6]{};
     VisibilityCache visibility{};
     uint16_t viewport_smart_follow_sprite = SPRITE_INDEX_NULL; // Handles setting viewport target sprite etc
+    bool invalidate_pending{};                                 // Set by window_invalidate_by_number until drawn
+    std::vector<uint8_t> cached_pixels;                        // The window as last painted, see window_draw_single
+    bool cached_pixels_valid{};                                // Cleared when the window or a widget is invalidated
 
     void SetLocation(const CoordsXYZ& coords);
     void ScrollToViewport();
@@ -190,3 +194,6 @@ struct rct_window
 
 // rct2: 0x01420078
 extern std::list<std::shared_ptr<rct_window>> g_window_list;
+
+// Must be called once a new window in g_window_list has its classification set
+void window_register(rct_window* w);
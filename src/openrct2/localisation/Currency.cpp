@@ -11,6 +11,7 @@
 
 #include "../config/Config.h"
 #include "../util/Util.h"
+#include "Formatting.h"
 #include "StringIds.h"
 
 // clang-format off
@@ -46,4 +47,5 @@ void currency_load_custom_currency_config()
             CurrencyDescriptors[EnumValue(CurrencyType::Custom)].symbol_unicode, gConfigGeneral.custom_currency_symbol,
             CURRENCY_SYMBOL_MAX_SIZE);
     }
+    OpenRCT2::FormatStringCacheInvalidate();
 }
@@ -9,18 +9,25 @@
 
 #include "Formatting.h"
 
+#include "../OpenRCT2.h"
 #include "../config/Config.h"
 #include "../util/Util.h"
 #include "Localisation.h"
 #include "StringIds.h"
 
+#include <atomic>
 #include <cmath>
 #include <cstdint>
+#include <memory>
+#include <unordered_map>
 
 namespace OpenRCT2
 {
     static void FormatMonthYear(FormatBuffer& ss, int32_t month, int32_t year);
 
+    // Incremented whenever language strings or currencies change, see FormatStringCacheInvalidate.
+    static std::atomic<uint32_t> _formatStringCacheGeneration;
+
     static std::optional<int32_t> ParseNumericToken(std::string_view s)
     {
         if (s.size() >= 3 && s.size() <= 5 && s[0] == '{' && s[s.size() - 1] == '}')
@@ -86,6 +93,14 @@ namespace OpenRCT2
         update();
     }
 
+    FmtString::iterator::iterator(std::string_view s, const TokenList& t)
+        : str(s)
+        , index(0)
+        , tokens(&t)
+    {
+        update();
+    }
+
     void FmtString::iterator::update()
     {
         auto i = index;
@@ -95,6 +110,12 @@ namespace OpenRCT2
             return;
         }
 
+        if (tokens != nullptr)
+        {
+            current = (*tokens)[tokenIndex];
+            return;
+        }
+
         if (str[i] == '\n' || str[i] == '\r')
         {
             i++;
@@ -205,6 +226,7 @@ namespace OpenRCT2
         if (index < str.size())
         {
             index += current.text.size();
+            tokenIndex++;
             update();
         }
         return *this;
@@ -213,11 +235,7 @@ namespace OpenRCT2
     FmtString::iterator FmtString::iterator::operator++(int)
     {
         auto result = *this;
-        if (index < str.size())
-        {
-            index += current.text.size();
-            update();
-        }
+        ++(*this);
         return result;
     }
 
@@ -242,8 +260,18 @@ namespace OpenRCT2
     {
     }
 
+    FmtString::FmtString(std::string_view s, std::shared_ptr<const TokenList> tokens)
+        : _str(s)
+        , _tokens(std::move(tokens))
+    {
+    }
+
     FmtString::iterator FmtString::begin() const
     {
+        if (_tokens != nullptr)
+        {
+            return iterator(_str, *_tokens);
+        }
         return iterator(_str, 0);
     }
 
@@ -624,10 +652,37 @@ namespace OpenRCT2
         return id >= REAL_NAME_START && id <= REAL_NAME_END;
     }
 
+    struct FmtStringTokensEntry
+    {
+        const char* Str{};
+        uint32_t Generation{};
+        std::shared_ptr<const FmtString::TokenList> Tokens;
+    };
+
     FmtString GetFmtStringById(rct_string_id id)
     {
         auto fmtc = language_get_string(id);
-        return FmtString(fmtc);
+        if (fmtc == nullptr)
+        {
+            return FmtString(fmtc);
+        }
+
+        // Language strings are tokenised the first time a thread formats them rather than on every use.
+        thread_local std::unordered_map<rct_string_id, FmtStringTokensEntry> tokensCache;
+        auto generation = _formatStringCacheGeneration.load(std::memory_order_relaxed);
+        auto& entry = tokensCache[id];
+        if (entry.Str != fmtc || entry.Generation != generation || entry.Tokens == nullptr)
+        {
+            auto tokens = std::make_shared<FmtString::TokenList>();
+            for (const auto& t : FmtString(fmtc))
+            {
+                tokens->push_back(t);
+            }
+            entry.Str = fmtc;
+            entry.Generation = generation;
+            entry.Tokens = std::move(tokens);
+        }
+        return FmtString(fmtc, entry.Tokens);
     }
 
     FormatBuffer& GetThreadFormatStream()
@@ -798,13 +853,133 @@ namespace OpenRCT2
         }
     }
 
+    /**
+     * Results of FormatStringLegacy for the frame being drawn. Windows are painted once for every
+     * dirty region they overlap and measure their text before drawing it, so the same strings are
+     * formatted several times a frame. Strings are copied into a fixed arena which is reset with the
+     * cache, once it is full the remaining strings of the frame are formatted without caching.
+     */
+    struct FormatStringCache
+    {
+        static constexpr size_t ArenaSize = 64 * 1024;
+
+        uint32_t DrawCount{};
+        uint32_t Generation{};
+        std::unique_ptr<char[]> Arena = std::make_unique<char[]>(ArenaSize);
+        size_t ArenaUsed{};
+        std::unordered_map<std::string_view, std::string_view> Entries;
+
+        const char* Store(std::string_view str)
+        {
+            if (ArenaSize - ArenaUsed < str.size())
+                return nullptr;
+
+            auto result = Arena.get() + ArenaUsed;
+            std::copy(str.begin(), str.end(), result);
+            ArenaUsed += str.size();
+            return result;
+        }
+    };
+
+    static std::atomic<uint64_t> _formatStringCacheHits;
+    static std::atomic<uint64_t> _formatStringCacheMisses;
+
+    static FormatStringCache& GetFormatStringCache()
+    {
+        thread_local FormatStringCache cache;
+        auto generation = _formatStringCacheGeneration.load(std::memory_order_relaxed);
+        if (cache.DrawCount != gCurrentDrawCount || cache.Generation != generation)
+        {
+            cache.DrawCount = gCurrentDrawCount;
+            cache.Generation = generation;
+            cache.ArenaUsed = 0;
+            cache.Entries.clear();
+        }
+        return cache;
+    }
+
+    template<typename T> static void AppendCacheKey(std::string& key, const T& value)
+    {
+        key.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    static void BuildFormatStringCacheKey(std::string& key, rct_string_id id, const std::vector<FormatArg_t>& args)
+    {
+        // Besides the arguments, only the language strings and these settings change the result.
+        key.clear();
+        AppendCacheKey(key, id);
+        AppendCacheKey(key, gConfigGeneral.currency_format);
+        AppendCacheKey(key, gConfigGeneral.measurement_format);
+        for (const auto& arg : args)
+        {
+            key.push_back(static_cast<char>(arg.index()));
+            if (auto value16 = std::get_if<uint16_t>(&arg))
+            {
+                AppendCacheKey(key, *value16);
+            }
+            else if (auto value32 = std::get_if<int32_t>(&arg))
+            {
+                AppendCacheKey(key, *value32);
+            }
+            else if (auto sz = std::get_if<const char*>(&arg))
+            {
+                // The string is compared by content as callers reuse their buffers.
+                if (*sz != nullptr)
+                    key.append(*sz);
+                key.push_back('\0');
+            }
+            else if (auto str = std::get_if<std::string>(&arg))
+            {
+                key.append(*str);
+                key.push_back('\0');
+            }
+        }
+    }
+
     size_t FormatStringLegacy(char* buffer, size_t bufferLen, rct_string_id id, const void* args)
     {
         thread_local std::vector<FormatArg_t> anyArgs;
+        thread_local std::string key;
         anyArgs.clear();
         auto fmt = GetFmtStringById(id);
         BuildAnyArgListFromLegacyArgBuffer(fmt, anyArgs, args);
-        return FormatStringAny(buffer, bufferLen, fmt, anyArgs);
+
+        auto& cache = GetFormatStringCache();
+        BuildFormatStringCacheKey(key, id, anyArgs);
+        auto it = cache.Entries.find(key);
+        if (it != cache.Entries.end())
+        {
+            _formatStringCacheHits.fetch_add(1, std::memory_order_relaxed);
+            auto result = it->second;
+            auto copyLen = std::min<size_t>(bufferLen - 1, result.size());
+            std::copy(result.begin(), result.begin() + copyLen, buffer);
+            buffer[copyLen] = '\0';
+            return result.size();
+        }
+        _formatStringCacheMisses.fetch_add(1, std::memory_order_relaxed);
+
+        auto& ss = GetThreadFormatStream();
+        size_t argIndex = 0;
+        FormatStringAny(ss, fmt, anyArgs, argIndex);
+
+        auto storedKey = cache.Store(key);
+        auto storedResult = cache.Store({ ss.data(), ss.size() });
+        if (storedKey != nullptr && storedResult != nullptr)
+        {
+            cache.Entries.emplace(std::string_view(storedKey, key.size()), std::string_view(storedResult, ss.size()));
+        }
+        return CopyStringStreamToBuffer(buffer, bufferLen, ss);
+    }
+
+    void FormatStringCacheInvalidate()
+    {
+        _formatStringCacheGeneration.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    FormatStringCacheStatistics GetFormatStringCacheStatistics()
+    {
+        return { _formatStringCacheHits.load(std::memory_order_relaxed),
+                 _formatStringCacheMisses.load(std::memory_order_relaxed) };
     }
 
     static void FormatMonthYear(FormatBuffer& ss, int32_t month, int32_t year)
@@ -14,6 +14,7 @@
 #include "Language.h"
 
 #include <cstring>
+#include <memory>
 #include <sstream>
 #include <stack>
 #include <string>
@@ -167,17 +168,22 @@ namespace OpenRCT2
             codepoint_t GetCodepoint() const;
         };
 
+        using TokenList = std::vector<token>;
+
         struct iterator
         {
         private:
             std::string_view str;
             size_t index;
+            const TokenList* tokens{};
+            size_t tokenIndex{};
             token current;
 
             void update();
 
         public:
             iterator(std::string_view s, size_t i);
+            iterator(std::string_view s, const TokenList& t);
             bool operator==(iterator& rhs);
             bool operator!=(iterator& rhs);
             token CreateToken(size_t len);
@@ -192,10 +198,15 @@ namespace OpenRCT2
         FmtString(std::string&& s);
         FmtString(std::string_view s);
         FmtString(const char* s);
+        FmtString(std::string_view s, std::shared_ptr<const TokenList> tokens);
         iterator begin() const;
         iterator end() const;
 
         std::string WithoutFormatTokens() const;
+
+    private:
+        // Tokens of _str parsed in advance, if set the iterators walk these instead of scanning _str.
+        std::shared_ptr<const TokenList> _tokens;
     };
 
     template<typename T> void FormatArgument(FormatBuffer& ss, FormatToken token, T arg);
@@ -310,4 +321,14 @@ namespace OpenRCT2
     std::string FormatStringAny(const FmtString& fmt, const std::vector<FormatArg_t>& args);
     size_t FormatStringAny(char* buffer, size_t bufferLen, const FmtString& fmt, const std::vector<FormatArg_t>& args);
     size_t FormatStringLegacy(char* buffer, size_t bufferLen, rct_string_id id, const void* args);
+
+    struct FormatStringCacheStatistics
+    {
+        uint64_t Hits;
+        uint64_t Misses;
+    };
+
+    // Drops the strings cached by FormatStringLegacy, called when language strings or currencies change.
+    void FormatStringCacheInvalidate();
+    FormatStringCacheStatistics GetFormatStringCacheStatistics();
 } // namespace OpenRCT2
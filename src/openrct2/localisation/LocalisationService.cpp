@@ -14,6 +14,7 @@
 #include "../core/Path.hpp"
 #include "../interface/Fonts.h"
 #include "../object/ObjectManager.h"
+#include "Formatting.h"
 #include "Language.h"
 #include "LanguagePack.h"
 #include "StringIds.h"
@@ -105,6 +106,7 @@ void LocalisationService::OpenLanguage(int32_t id)
 
 void LocalisationService::CloseLanguages()
 {
+    FormatStringCacheInvalidate();
     _languageFallback = nullptr;
     _languageCurrent = nullptr;
     _currentLanguage = LANGUAGE_UNDEFINED;
@@ -133,6 +135,7 @@ rct_string_id LocalisationService::AllocateObjectString(const std::string& targe
     auto stringId = _availableObjectStringIds.top();
     _availableObjectStringIds.pop();
     _languageCurrent->SetString(stringId, target);
+    FormatStringCacheInvalidate();
     return stringId;
 }
 
@@ -145,6 +148,7 @@ void LocalisationService::FreeObjectString(rct_string_id stringId)
             _languageCurrent->RemoveString(stringId);
         }
         _availableObjectStringIds.push(stringId);
+        FormatStringCacheInvalidate();
     }
 }
 
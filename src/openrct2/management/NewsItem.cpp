@@ -24,8 +24,26 @@
 #include "../world/Location.hpp"
 #include "../world/Sprite.h"
 
+#include <vector>
+
 News::ItemQueues gNewsItems;
 
+namespace
+{
+    struct PendingItem
+    {
+        News::Item Item;
+        rct_string_id StringId;
+        std::vector<uint8_t> Args;
+    };
+} // namespace
+
+// Two slots of the recent queue are always kept free, more items than the rest in one tick would push the first
+// ones into the archive before they are shown.
+static constexpr size_t MaxPendingItems = News::ItemHistoryStart - 2;
+
+static std::vector<PendingItem> _pendingItems;
+
 News::Item& News::ItemQueues::Current()
 {
     return Recent.front();
@@ -103,6 +121,7 @@ void News::ItemQueues::Clear()
 
 void News::InitQueue()
 {
+    _pendingItems.clear();
     gNewsItems.Clear();
     assert(gNewsItems.IsEmpty());
 
@@ -125,7 +144,7 @@ static void TickCurrent()
 {
     int32_t ticks = gNewsItems.IncrementTicks();
     // Only play news item sound when in normal playing mode
-    if (ticks == 1 && (gScreenFlags == SCREEN_FLAGS_PLAYING))
+    if (ticks == 1 && (gScreenFlags == SCREEN_FLAGS_PLAYING) && !gOpenRCT2NoPresentation)
     {
         // Play sound
         OpenRCT2::Audio::Play(OpenRCT2::Audio::SoundId::NewsItem, 0, context_get_width() / 2);
@@ -152,6 +171,8 @@ bool News::ItemQueues::CurrentShouldBeArchived() const
  */
 void News::UpdateCurrentItem()
 {
+    FlushPendingItems();
+
     // Check if there is a current news item
     if (gNewsItems.IsEmpty())
         return;
@@ -301,29 +322,65 @@ News::Item* News::ItemQueues::FirstOpenOrNewSlot()
  *
  *  rct2: 0x0066DF55
  */
-News::Item* News::AddItemToQueue(News::ItemType type, rct_string_id string_id, uint32_t assoc, const Formatter& formatter)
+static void InitialiseItem(News::Item& newsItem, News::ItemType type, uint32_t assoc)
 {
-    utf8 buffer[256];
+    newsItem.Type = type;
+    newsItem.Flags = 0;
+    newsItem.Assoc = assoc; // Make optional for Award, Money, Graph and Null
+    newsItem.Ticks = 0;
+    newsItem.MonthYear = static_cast<uint16_t>(gDateMonthsElapsed);
+    newsItem.Day = ((days_in_month[date_get_month(newsItem.MonthYear)] * gDateMonthTicks) >> 16) + 1;
+}
 
-    // overflows possible?
-    format_string(buffer, 256, string_id, formatter.Data());
-    return News::AddItemToQueue(type, buffer, assoc);
+void News::AddItemToQueue(News::ItemType type, rct_string_id string_id, uint32_t assoc, const Formatter& formatter)
+{
+    auto args = formatter.Data();
+    auto argsEnd = args + formatter.NumBytes();
+    auto duplicate = std::find_if(_pendingItems.begin(), _pendingItems.end(), [&](const PendingItem& pending) {
+        return pending.Item.Type == type && pending.Item.Assoc == assoc && pending.StringId == string_id
+            && std::equal(pending.Args.begin(), pending.Args.end(), args, argsEnd);
+    });
+    if (duplicate != _pendingItems.end())
+        return;
+
+    if (_pendingItems.size() >= MaxPendingItems)
+    {
+        log_verbose("Dropped news item %u, too many news items this tick.", string_id);
+        return;
+    }
+
+    // The arguments can point at names that do not outlive the tick, so the text is formatted now
+    auto& pending = _pendingItems.emplace_back();
+    pending.StringId = string_id;
+    pending.Args.assign(args, argsEnd);
+    InitialiseItem(pending.Item, type, assoc);
+
+    utf8 buffer[256];
+    format_string(buffer, sizeof(buffer), string_id, args);
+    pending.Item.Text = buffer;
 }
 
 News::Item* News::AddItemToQueue(News::ItemType type, const utf8* text, uint32_t assoc)
 {
+    // Keeps the items in the order they were added
+    FlushPendingItems();
+
     News::Item* newsItem = gNewsItems.FirstOpenOrNewSlot();
-    newsItem->Type = type;
-    newsItem->Flags = 0;
-    newsItem->Assoc = assoc; // Make optional for Award, Money, Graph and Null
-    newsItem->Ticks = 0;
-    newsItem->MonthYear = static_cast<uint16_t>(gDateMonthsElapsed);
-    newsItem->Day = ((days_in_month[date_get_month(newsItem->MonthYear)] * gDateMonthTicks) >> 16) + 1;
+    InitialiseItem(*newsItem, type, assoc);
     newsItem->Text = text;
 
     return newsItem;
 }
 
+void News::FlushPendingItems()
+{
+    for (const auto& pending : _pendingItems)
+    {
+        *gNewsItems.FirstOpenOrNewSlot() = pending.Item;
+    }
+    _pendingItems.clear();
+}
+
 /**
  * Checks if News::ItemType requires an assoc
  * @return A boolean if assoc is required.
@@ -434,32 +491,66 @@ void News::OpenSubject(News::ItemType type, int32_t subject)
  *
  *  rct2: 0x0066E407
  */
-void News::DisableNewsItems(News::ItemType type, uint32_t assoc)
+template<typename TPredicate> static void DisableNewsItemsMatching(News::ItemType type, const TPredicate& matchesAssoc)
 {
     // TODO: write test invalidating windows
-    gNewsItems.ForeachRecentNews([type, assoc](auto& newsItem) {
-        if (type == newsItem.Type && assoc == newsItem.Assoc)
+    for (auto& pending : _pendingItems)
+    {
+        if (type == pending.Item.Type && matchesAssoc(pending.Item.Assoc))
+        {
+            pending.Item.SetFlags(News::ItemFlags::HasButton);
+        }
+    }
+
+    bool invalidateTicker = false;
+    gNewsItems.ForeachRecentNews([type, &matchesAssoc, &invalidateTicker](auto& newsItem) {
+        if (type == newsItem.Type && matchesAssoc(newsItem.Assoc))
         {
             newsItem.SetFlags(News::ItemFlags::HasButton);
             if (&newsItem == &gNewsItems.Current())
             {
-                auto intent = Intent(INTENT_ACTION_INVALIDATE_TICKER_NEWS);
-                context_broadcast_intent(&intent);
+                invalidateTicker = true;
             }
         }
     });
+    if (invalidateTicker)
+    {
+        auto intent = Intent(INTENT_ACTION_INVALIDATE_TICKER_NEWS);
+        context_broadcast_intent(&intent);
+    }
 
-    gNewsItems.ForeachArchivedNews([type, assoc](auto& newsItem) {
-        if (type == newsItem.Type && assoc == newsItem.Assoc)
+    bool invalidateRecentNews = false;
+    gNewsItems.ForeachArchivedNews([type, &matchesAssoc, &invalidateRecentNews](auto& newsItem) {
+        if (type == newsItem.Type && matchesAssoc(newsItem.Assoc))
         {
             newsItem.SetFlags(News::ItemFlags::HasButton);
-            window_invalidate_by_class(WC_RECENT_NEWS);
+            invalidateRecentNews = true;
         }
     });
+    if (invalidateRecentNews)
+    {
+        window_invalidate_by_class(WC_RECENT_NEWS);
+    }
+}
+
+void News::DisableNewsItems(News::ItemType type, uint32_t assoc)
+{
+    DisableNewsItemsMatching(type, [assoc](uint32_t itemAssoc) { return itemAssoc == assoc; });
+}
+
+void News::DisableNewsItems(News::ItemType type, const std::vector<uint32_t>& assocs)
+{
+    if (assocs.empty())
+        return;
+
+    DisableNewsItemsMatching(
+        type, [&assocs](uint32_t itemAssoc) { return std::binary_search(assocs.begin(), assocs.end(), itemAssoc); });
 }
 
 void News::AddItemToQueue(News::Item* newNewsItem)
 {
+    FlushPendingItems();
+
     News::Item* newsItem = gNewsItems.FirstOpenOrNewSlot();
     *newsItem = *newNewsItem;
 }
@@ -16,6 +16,7 @@
 #include <iterator>
 #include <optional>
 #include <string>
+#include <vector>
 
 struct CoordsXYZ;
 class Formatter;
@@ -290,15 +291,29 @@ namespace News
 
     std::optional<CoordsXYZ> GetSubjectLocation(News::ItemType type, int32_t subject);
 
-    News::Item* AddItemToQueue(News::ItemType type, rct_string_id string_id, uint32_t assoc, const Formatter& formatter);
+    /**
+     * Queues a news item to be added at the end of the tick, an item equal to one already queued this tick is
+     * dropped without being formatted and so are the ones past the number the ticker can show at once.
+     */
+    void AddItemToQueue(News::ItemType type, rct_string_id string_id, uint32_t assoc, const Formatter& formatter);
     News::Item* AddItemToQueue(News::ItemType type, const utf8* text, uint32_t assoc);
 
+    /**
+     * Adds the news items queued since the last call, in the order they were queued.
+     */
+    void FlushPendingItems();
+
     bool CheckIfItemRequiresAssoc(News::ItemType type);
 
     void OpenSubject(News::ItemType type, int32_t subject);
 
     void DisableNewsItems(News::ItemType type, uint32_t assoc);
 
+    /**
+     * The same as calling DisableNewsItems for each subject, assocs has to be sorted.
+     */
+    void DisableNewsItems(News::ItemType type, const std::vector<uint32_t>& assocs);
+
     News::Item* GetItem(int32_t index);
 
     bool IsQueueEmpty();
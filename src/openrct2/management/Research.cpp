@@ -32,6 +32,7 @@
 #include "NewsItem.h"
 
 #include <algorithm>
+#include <bitset>
 #include <iterator>
 
 static constexpr const int32_t _researchRate[] = {
@@ -56,9 +57,15 @@ std::vector<ResearchItem> gResearchItemsInvented;
 // 0x00EE787C
 uint8_t gResearchUncompletedCategories;
 
-static bool _researchedRideTypes[RIDE_TYPE_COUNT];
-static bool _researchedRideEntries[MAX_RIDE_OBJECTS];
-static bool _researchedSceneryItems[SCENERY_TYPE_COUNT][UINT16_MAX];
+static std::bitset<RIDE_TYPE_COUNT> _researchedRideTypes;
+static std::bitset<MAX_RIDE_OBJECTS> _researchedRideEntries;
+static std::bitset<UINT16_MAX> _researchedSceneryItems[SCENERY_TYPE_COUNT];
+
+// Set while research_reset_current_item finishes every invented item, the research lists do not change meanwhile
+// so the ride entries in them are only gathered once and the scenery is initialised once at the end.
+static bool _researchFinishingAll;
+static bool _researchSceneryFinished;
+static std::bitset<MAX_RIDE_OBJECTS> _rideEntriesInResearch;
 
 bool gSilentResearch = false;
 
@@ -182,6 +189,20 @@ static void research_next_design()
     research_invalidate_related_windows();
 }
 
+static std::bitset<MAX_RIDE_OBJECTS> research_get_ride_entries_in_research()
+{
+    std::bitset<MAX_RIDE_OBJECTS> result;
+    for (auto const& researchItem : gResearchItemsUninvented)
+    {
+        result[researchItem.entryIndex] = true;
+    }
+    for (auto const& researchItem : gResearchItemsInvented)
+    {
+        result[researchItem.entryIndex] = true;
+    }
+    return result;
+}
+
 /**
  *
  *  rct2: 0x006848D4
@@ -210,17 +231,8 @@ void research_finish_item(ResearchItem* researchItem)
             ride_type_set_invented(base_ride_type);
             ride_entry_set_invented(rideEntryIndex);
 
-            bool seenRideEntry[MAX_RIDE_OBJECTS]{};
-            for (auto const& researchItem3 : gResearchItemsUninvented)
-            {
-                ObjectEntryIndex index = researchItem3.entryIndex;
-                seenRideEntry[index] = true;
-            }
-            for (auto const& researchItem3 : gResearchItemsInvented)
-            {
-                ObjectEntryIndex index = researchItem3.entryIndex;
-                seenRideEntry[index] = true;
-            }
+            const auto seenRideEntry = _researchFinishingAll ? _rideEntriesInResearch
+                                                             : research_get_ride_entries_in_research();
 
             // RCT2 made non-separated vehicles available at once, by removing all but one from research.
             // To ensure old files keep working, look for ride entries not in research, and make them available as well.
@@ -297,7 +309,14 @@ void research_finish_item(ResearchItem* researchItem)
             }
 
             research_invalidate_related_windows();
-            init_scenery();
+            if (_researchFinishingAll)
+            {
+                _researchSceneryFinished = true;
+            }
+            else
+            {
+                init_scenery();
+            }
         }
     }
 }
@@ -378,10 +397,18 @@ void research_reset_current_item()
     set_all_scenery_items_invented();
     set_all_scenery_groups_not_invented();
 
+    _researchFinishingAll = true;
+    _researchSceneryFinished = false;
+    _rideEntriesInResearch = research_get_ride_entries_in_research();
     for (auto& researchItem : gResearchItemsInvented)
     {
         research_finish_item(&researchItem);
     }
+    _researchFinishingAll = false;
+    if (_researchSceneryFinished)
+    {
+        init_scenery();
+    }
 
     gResearchLastItem = std::nullopt;
     gResearchProgressStage = RESEARCH_STAGE_INITIAL_RESEARCH;
@@ -647,38 +674,39 @@ void set_all_scenery_groups_not_invented()
 
 void set_all_scenery_items_invented()
 {
-    for (auto sceneryType = 0; sceneryType < SCENERY_TYPE_COUNT; sceneryType++)
+    for (auto& sceneryItems : _researchedSceneryItems)
     {
-        std::fill(std::begin(_researchedSceneryItems[sceneryType]), std::end(_researchedSceneryItems[sceneryType]), true);
+        sceneryItems.set();
     }
 }
 
 void set_all_scenery_items_not_invented()
 {
-    for (auto sceneryType = 0; sceneryType < SCENERY_TYPE_COUNT; sceneryType++)
+    // This has always marked every item as invented, parks are imported with that behaviour
+    for (auto& sceneryItems : _researchedSceneryItems)
     {
-        std::fill(std::begin(_researchedSceneryItems[sceneryType]), std::end(_researchedSceneryItems[sceneryType]), true);
+        sceneryItems.set();
     }
 }
 
 void set_every_ride_type_invented()
 {
-    std::fill(std::begin(_researchedRideTypes), std::end(_researchedRideTypes), true);
+    _researchedRideTypes.set();
 }
 
 void set_every_ride_type_not_invented()
 {
-    std::fill(std::begin(_researchedRideTypes), std::end(_researchedRideTypes), false);
+    _researchedRideTypes.reset();
 }
 
 void set_every_ride_entry_invented()
 {
-    std::fill(std::begin(_researchedRideEntries), std::end(_researchedRideEntries), true);
+    _researchedRideEntries.set();
 }
 
 void set_every_ride_entry_not_invented()
 {
-    std::fill(std::begin(_researchedRideEntries), std::end(_researchedRideEntries), false);
+    _researchedRideEntries.reset();
 }
 
 /**
@@ -17,8 +17,12 @@
 #include "../actions/LoadOrQuitAction.h"
 #include "../actions/NetworkModifyGroupAction.h"
 #include "../actions/PeepPickupAction.h"
+#include "../core/Crypt.h"
 #include "../core/Guard.hpp"
 #include "../core/Json.hpp"
+#include "../core/MemoryUsage.h"
+#include "../core/Profiling.h"
+#include "../core/TaskScheduler.h"
 #include "../platform/Platform2.h"
 #include "../scripting/ScriptEngine.h"
 #include "../ui/UiContext.h"
@@ -36,7 +40,7 @@
 // This string specifies which version of network stream current build uses.
 // It is used for making sure only compatible builds get connected, even within
 // single OpenRCT2 version.
-#define NETWORK_STREAM_VERSION "7"
+#define NETWORK_STREAM_VERSION "12"
 #define NETWORK_STREAM_ID OPENRCT2_VERSION "-" NETWORK_STREAM_VERSION
 
 static Peep* _pickup_peep = nullptr;
@@ -46,6 +50,24 @@ static int32_t _pickup_peep_old_x = LOCATION_NULL;
 // with uint16_t and needs some spare room for other data in the packet.
 static constexpr uint32_t CHUNK_SIZE = 1024 * 63;
 
+// Interval of the traffic summary printed by headless servers.
+static constexpr uint32_t TELEMETRY_LOG_INTERVAL_MS = 60 * 1000;
+
+// A game action batch is sent early when it grows past this, it has to stay below the maximum packet size.
+static constexpr size_t GAME_ACTION_BATCH_MAX_SIZE = 1024 * 60;
+
+// Space reserved for serialising a single game action, enough for almost all of them without growing the buffer.
+static constexpr size_t GAME_ACTION_SERIALISE_RESERVE = 256;
+
+// How long a client that lost its connection can take to come back without loading the map again, 30 seconds.
+static constexpr uint32_t NETWORK_RESUME_TICKS = 40 * 30;
+
+// Number of map chunks that may wait in the outbound queue of a connection, more are queued once those are sent.
+static constexpr size_t MAP_TRANSFER_MAX_QUEUED_CHUNKS = 4;
+
+// Packed objects are small, anything larger than this is not an object.
+static constexpr uint32_t OBJECT_BUNDLE_MAX_SIZE = 16 * 1024 * 1024;
+
 #ifndef DISABLE_NETWORK
 
 #    include "../Cheats.h"
@@ -53,6 +75,7 @@ static constexpr uint32_t CHUNK_SIZE = 1024 * 63;
 #    include "../Version.h"
 #    include "../actions/GameAction.h"
 #    include "../config/Config.h"
+#    include "../core/AsyncLog.h"
 #    include "../core/Console.hpp"
 #    include "../core/FileStream.h"
 #    include "../core/MemoryStream.h"
@@ -82,6 +105,7 @@ static constexpr uint32_t CHUNK_SIZE = 1024 * 63;
 #    include <algorithm>
 #    include <array>
 #    include <cerrno>
+#    include <chrono>
 #    include <cmath>
 #    include <fstream>
 #    include <functional>
@@ -112,8 +136,11 @@ NetworkBase::NetworkBase()
 
     client_command_handlers[NetworkCommand::Auth] = &NetworkBase::Client_Handle_AUTH;
     client_command_handlers[NetworkCommand::Map] = &NetworkBase::Client_Handle_MAP;
+    client_command_handlers[NetworkCommand::Resume] = &NetworkBase::Client_Handle_RESUME;
     client_command_handlers[NetworkCommand::Chat] = &NetworkBase::Client_Handle_CHAT;
     client_command_handlers[NetworkCommand::GameAction] = &NetworkBase::Client_Handle_GAME_ACTION;
+    client_command_handlers[NetworkCommand::GameActionBatch] = &NetworkBase::Client_Handle_GAME_ACTION_BATCH;
+    client_command_handlers[NetworkCommand::ObjectBundle] = &NetworkBase::Client_Handle_OBJECT_BUNDLE;
     client_command_handlers[NetworkCommand::Tick] = &NetworkBase::Client_Handle_TICK;
     client_command_handlers[NetworkCommand::PlayerList] = &NetworkBase::Client_Handle_PLAYERLIST;
     client_command_handlers[NetworkCommand::PlayerInfo] = &NetworkBase::Client_Handle_PLAYERINFO;
@@ -127,6 +154,7 @@ NetworkBase::NetworkBase()
     client_command_handlers[NetworkCommand::Token] = &NetworkBase::Client_Handle_TOKEN;
     client_command_handlers[NetworkCommand::ObjectsList] = &NetworkBase::Client_Handle_OBJECTS_LIST;
     client_command_handlers[NetworkCommand::Scripts] = &NetworkBase::Client_Handle_SCRIPTS;
+    client_command_handlers[NetworkCommand::PluginStorage] = &NetworkBase::Client_Handle_PLUGIN_STORAGE;
     client_command_handlers[NetworkCommand::GameState] = &NetworkBase::Client_Handle_GAMESTATE;
 
     server_command_handlers[NetworkCommand::Auth] = &NetworkBase::Server_Handle_AUTH;
@@ -141,6 +169,8 @@ NetworkBase::NetworkBase()
 
     _chat_log_fs << std::unitbuf;
     _server_log_fs << std::unitbuf;
+
+    MemoryUsageSetReporter(MemoryUsageCategory::Network, [this]() { return GetMemoryUsage(); });
 }
 
 void NetworkBase::SetEnvironment(const std::shared_ptr<IPlatformEnvironment>& env)
@@ -195,11 +225,16 @@ void NetworkBase::Close()
         client_connection_list.clear();
         GameActions::ClearQueue();
         GameActions::ResumeQueue();
-        player_list.clear();
-        group_list.clear();
         _serverTickData.clear();
-        _pendingPlayerLists.clear();
-        _pendingPlayerInfo.clear();
+        _gameActionBatch.Clear();
+        _resume.reset();
+        if (!_resumeRequest)
+        {
+            player_list.clear();
+            group_list.clear();
+            _pendingPlayerLists.clear();
+            _pendingPlayerInfo.clear();
+        }
 
         gfx_invalidate_screen();
 
@@ -227,9 +262,21 @@ void NetworkBase::CloseConnection()
     if (mode == NETWORK_MODE_CLIENT)
     {
         _serverConnection.reset();
+        _authSignature = {};
+#    ifdef ENABLE_SCRIPTING
+        // The replicated storage belongs to the server, it is kept up to date when resuming.
+        if (!_resumeRequest)
+        {
+            GetContext()->GetScriptEngine().GetReplicatedStorage().Clear();
+        }
+#    endif
     }
     else if (mode == NETWORK_MODE_SERVER)
     {
+        _socketPoller.reset();
+        _mapCache.reset();
+        _resumeGameCommands.clear();
+        _objectBundles.clear();
         _listenSocket.reset();
         _advertiser.reset();
     }
@@ -251,6 +298,8 @@ bool NetworkBase::BeginClient(const std::string& host, uint16_t port)
         return false;
 
     mode = NETWORK_MODE_CLIENT;
+    _resume = std::exchange(_resumeRequest, std::nullopt);
+    _serverSessionId = 0;
 
     log_info("Connecting to %s:%u", host.c_str(), port);
     _host = host;
@@ -349,6 +398,7 @@ bool NetworkBase::BeginServer(uint16_t port, const std::string& address)
         return false;
 
     mode = NETWORK_MODE_SERVER;
+    ResetResumeWindow();
 
     _userManager.Load();
 
@@ -366,6 +416,18 @@ bool NetworkBase::BeginServer(uint16_t port, const std::string& address)
         return false;
     }
 
+    try
+    {
+        _socketPoller = CreateSocketPoller();
+        _socketPoller->Add(*_listenSocket, nullptr);
+    }
+    catch (const std::exception& ex)
+    {
+        // Not fatal, every connection is checked each frame instead.
+        log_warning("Unable to create socket poller: %s", ex.what());
+        _socketPoller.reset();
+    }
+
     ServerName = gConfigNetwork.server_name;
     ServerDescription = gConfigNetwork.server_description;
     ServerGreeting = gConfigNetwork.server_greeting;
@@ -404,6 +466,9 @@ bool NetworkBase::BeginServer(uint16_t port, const std::string& address)
 
     game_load_scripts();
 
+    // Pack the custom objects up front, so the first client does not have to wait for it.
+    PrepareObjectBundles(GetContext()->GetObjectManager().GetPackableObjects());
+
     return true;
 }
 
@@ -455,6 +520,8 @@ NetworkConnection* NetworkBase::GetPlayerConnection(uint8_t id)
 
 void NetworkBase::Update()
 {
+    PROFILE_SCOPE("NetworkBase::Update");
+
     _closeLock = true;
 
     // Update is not necessarily called per game tick, maintain our own delta time
@@ -479,6 +546,7 @@ void NetworkBase::Update()
         Close();
         if (_requireReconnect)
         {
+            _requireReconnect = false;
             Reconnect();
         }
     }
@@ -492,28 +560,112 @@ void NetworkBase::Flush()
     }
     else
     {
+        Server_Send_GAME_ACTION_BATCH();
         for (auto& it : client_connection_list)
         {
             it->SendQueuedPackets();
+            UpdateWriteInterest(*it);
         }
     }
 }
 
+/**
+ * Blocks until a client socket is ready or the timeout elapsed, returns false if there is
+ * nothing to wait on so the caller has to sleep instead.
+ */
+bool NetworkBase::WaitForEvents(uint32_t timeoutMs)
+{
+    if (GetMode() != NETWORK_MODE_SERVER || _socketPoller == nullptr)
+        return false;
+
+    PollServerSockets(static_cast<int32_t>(timeoutMs));
+    return true;
+}
+
+void NetworkBase::PollServerSockets(int32_t timeoutMs)
+{
+    if (_socketPoller == nullptr)
+    {
+        _listenSocketReadable = true;
+        for (auto& connection : client_connection_list)
+        {
+            connection->IsReadable = true;
+        }
+        return;
+    }
+
+    // Readiness accumulates until the next UpdateServer, a socket may become ready while waiting between ticks.
+    for (const auto& ready : _socketPoller->Wait(timeoutMs))
+    {
+        if (ready.UserData == nullptr)
+        {
+            _listenSocketReadable = true;
+        }
+        else if (ready.Readable)
+        {
+            static_cast<NetworkConnection*>(ready.UserData)->IsReadable = true;
+        }
+    }
+}
+
+void NetworkBase::UpdateWriteInterest(NetworkConnection& connection)
+{
+    // Only wait for the socket to become writable while there is data the socket could not take yet.
+    const bool wantWrite = !connection.IsDisconnected && connection.HasQueuedPackets();
+    if (_socketPoller != nullptr && connection.HasWriteInterest != wantWrite)
+    {
+        _socketPoller->SetWriteInterest(*connection.Socket, &connection, wantWrite);
+        connection.HasWriteInterest = wantWrite;
+    }
+}
+
 void NetworkBase::UpdateServer()
 {
+    // Actions executed while paused are not followed by a flush.
+    Server_Send_GAME_ACTION_BATCH();
+
+    PollServerSockets(0);
+
     for (auto& connection : client_connection_list)
     {
         // This can be called multiple times before the connection is removed.
         if (connection->IsDisconnected)
             continue;
 
-        if (!ProcessConnection(*connection))
+        if (connection->MapTransfer != nullptr)
+        {
+            UpdateMapTransfer(*connection);
+        }
+        if (connection->PendingAuth != nullptr)
+        {
+            UpdatePendingAuth(*connection);
+        }
+
+        // Idle connections only have their queued packets sent and their timeout checked.
+        const bool readable = connection->IsReadable;
+        connection->IsReadable = false;
+        if (!ProcessConnection(*connection, readable))
+        {
+            connection->IsDisconnected = true;
+        }
+        else if (IsClientTooSlow(*connection))
         {
+            char text[256];
+            snprintf(
+                text, sizeof(text), "Disconnecting %s, it is not keeping up (%u bytes queued)",
+                connection->Socket->GetHostName(), static_cast<uint32_t>(connection->GetQueuedByteCount()));
+            log_warning("%s", text);
+            AppendServerLog(text);
+
+            connection->SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_TOO_SLOW);
+            connection->Socket->Disconnect();
             connection->IsDisconnected = true;
+            _slowClientsDisconnected++;
         }
         else
         {
             DecayCooldown(connection->Player);
+            UpdateWriteInterest(*connection);
         }
     }
 
@@ -529,10 +681,22 @@ void NetworkBase::UpdateServer()
         _advertiser->Update();
     }
 
-    std::unique_ptr<ITcpSocket> tcpSocket = _listenSocket->Accept();
-    if (tcpSocket != nullptr)
+    if (gOpenRCT2Headless && ticks > _lastTelemetryLogTime + TELEMETRY_LOG_INTERVAL_MS)
+    {
+        LogServerTelemetry();
+    }
+
+    if (_listenSocketReadable)
     {
-        AddClient(std::move(tcpSocket));
+        _listenSocketReadable = false;
+        std::unique_ptr<ITcpSocket> tcpSocket = _listenSocket->Accept();
+        if (tcpSocket != nullptr)
+        {
+            AddClient(std::move(tcpSocket));
+
+            // There may be more pending connections, check again next frame.
+            _listenSocketReadable = true;
+        }
     }
 }
 
@@ -610,8 +774,19 @@ void NetworkBase::UpdateClient()
         }
         case NETWORK_STATUS_CONNECTED:
         {
+            Client_UpdateAuth();
             if (!ProcessConnection(*_serverConnection))
             {
+                if (_clientMapLoaded && _serverSessionId != 0 && _serverConnection->AuthStatus == NetworkAuth::Ok
+                    && _serverState.state == NetworkServerState::Ok)
+                {
+                    // Only the connection was lost, ask for what was missed since instead of the whole map.
+                    log_info("Lost the connection to the server, resuming from tick %u", gCurrentTicks);
+                    _resumeRequest = ResumeState{ _serverSessionId, gCurrentTicks };
+                    Reconnect();
+                    break;
+                }
+
                 // Do not show disconnect message window when password window closed/canceled
                 if (_serverConnection->AuthStatus == NetworkAuth::RequirePassword)
                 {
@@ -714,6 +889,23 @@ const char* NetworkBase::FormatChat(NetworkPlayer* fromplayer, const char* text)
 
 void NetworkBase::SendPacketToClients(const NetworkPacket& packet, bool front, bool gameCmd)
 {
+    // Serialise once, all connections share the same buffer.
+    auto buffer = NetworkPacketBuffer::Create(packet);
+    if (buffer->Command == NetworkCommand::Tick || buffer->Command == NetworkCommand::GameAction
+        || buffer->Command == NetworkCommand::GameActionBatch || buffer->Command == NetworkCommand::PluginStorage)
+    {
+        if (_mapCache != nullptr)
+        {
+            _mapCache->GameCommands.push_back(buffer);
+        }
+
+        _resumeGameCommands.emplace_back(gCurrentTicks, buffer);
+        while (!_resumeGameCommands.empty() && gCurrentTicks - _resumeGameCommands.front().first > NETWORK_RESUME_TICKS)
+        {
+            _resumeWindowStart = _resumeGameCommands.front().first + 1;
+            _resumeGameCommands.pop_front();
+        }
+    }
     for (auto& client_connection : client_connection_list)
     {
         if (client_connection->IsDisconnected)
@@ -733,8 +925,7 @@ void NetworkBase::SendPacketToClients(const NetworkPacket& packet, bool front, b
                 continue;
             }
         }
-        auto packetCopy = packet;
-        client_connection->QueuePacket(std::move(packetCopy), front);
+        client_connection->QueuePacket(buffer, front);
     }
 }
 
@@ -759,7 +950,7 @@ bool NetworkBase::CheckSRAND(uint32_t tick, uint32_t srand0)
 
     if (!storedTick.spriteHash.empty())
     {
-        rct_sprite_checksum checksum = sprite_checksum();
+        rct_sprite_checksum checksum = sprite_checksum_rolling();
         std::string clientSpriteHash = checksum.ToString();
         if (clientSpriteHash != storedTick.spriteHash)
         {
@@ -776,6 +967,11 @@ bool NetworkBase::IsDesynchronised()
     return _serverState.state == NetworkServerState::Desynced;
 }
 
+bool NetworkBase::IsResuming() const
+{
+    return _resumeRequest.has_value() || _resume.has_value();
+}
+
 bool NetworkBase::CheckDesynchronizaton()
 {
     // Check synchronisation
@@ -1076,11 +1272,6 @@ std::string NetworkBase::BeginLog(const std::string& directory, const std::strin
 
 void NetworkBase::AppendLog(std::ostream& fs, const std::string& s)
 {
-    if (fs.fail())
-    {
-        log_error("bad ostream failed to append log");
-        return;
-    }
     try
     {
         utf8 buffer[1024];
@@ -1092,7 +1283,8 @@ void NetworkBase::AppendLog(std::ostream& fs, const std::string& s)
             String::Append(buffer, sizeof(buffer), s.c_str());
             String::Append(buffer, sizeof(buffer), PLATFORM_NEWLINE);
 
-            fs.write(buffer, strlen(buffer));
+            // Written on the log thread, which also checks the stream did not fail
+            AsyncLog::Write(fs, buffer);
         }
     }
     catch (const std::exception& ex)
@@ -1124,6 +1316,7 @@ void NetworkBase::AppendChatLog(const std::string& s)
 
 void NetworkBase::CloseChatLog()
 {
+    AsyncLog::Flush();
     _chat_log_fs.close();
 }
 
@@ -1183,6 +1376,7 @@ void NetworkBase::CloseServerLog()
         Guard::Assert(false, "Unknown network mode!");
     }
     AppendServerLog(logMessage);
+    AsyncLog::Flush();
     _server_log_fs.close();
 }
 
@@ -1234,6 +1428,8 @@ void NetworkBase::Client_Send_MAPREQUEST(const std::vector<std::string>& objects
         log_verbose("client requests object %s", object.c_str());
         packet.Write(reinterpret_cast<const uint8_t*>(object.c_str()), 8);
     }
+    // The session is zero when there is no park to resume.
+    packet << (_resume ? _resume->SessionId : 0u) << (_resume ? _resume->Tick : 0u);
     _serverConnection->QueuePacket(std::move(packet));
 }
 
@@ -1335,6 +1531,21 @@ NetworkStats_t NetworkBase::GetStats() const
                 stats.bytesReceived[n] += connection->Stats.bytesReceived[n];
                 stats.bytesSent[n] += connection->Stats.bytesSent[n];
             }
+            for (size_t n = 0; n < EnumValue(NetworkCommand::Max); n++)
+            {
+                const auto& src = connection->Stats.commands[n];
+                auto& dst = stats.commands[n];
+                dst.packetsReceived += src.packetsReceived;
+                dst.bytesReceived += src.bytesReceived;
+                dst.packetsSent += src.packetsSent;
+                dst.bytesSent += src.bytesSent;
+                dst.processTimeUs += src.processTimeUs;
+            }
+            for (size_t n = 0; n < NetworkPingHistogramSize; n++)
+            {
+                stats.pingHistogram[n] += connection->Stats.pingHistogram[n];
+            }
+            stats.packetsCoalesced += connection->Stats.packetsCoalesced;
         }
     }
     return stats;
@@ -1349,7 +1560,11 @@ void NetworkBase::Server_Send_AUTH(NetworkConnection& connection)
     }
     NetworkPacket packet(NetworkCommand::Auth);
     packet << static_cast<uint32_t>(connection.AuthStatus) << new_playerid;
-    if (connection.AuthStatus == NetworkAuth::BadVersion)
+    if (connection.AuthStatus == NetworkAuth::Ok)
+    {
+        packet << _sessionId;
+    }
+    else if (connection.AuthStatus == NetworkAuth::BadVersion)
     {
         packet.WriteString(network_get_version().c_str());
     }
@@ -1366,6 +1581,8 @@ void NetworkBase::Server_Send_MAP(NetworkConnection* connection)
     if (connection)
     {
         objects = connection->RequestedObjects;
+        BeginMapTransfer(*connection, objects);
+        return;
     }
     else
     {
@@ -1376,14 +1593,13 @@ void NetworkBase::Server_Send_MAP(NetworkConnection* connection)
         objects = objManager.GetPackableObjects();
     }
 
+    // The park changed, clients joining from now on need the new map.
+    _mapCache.reset();
+    ResetResumeWindow();
+
     auto header = save_for_network(objects);
     if (header.empty())
     {
-        if (connection)
-        {
-            connection->SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
-            connection->Socket->Disconnect();
-        }
         return;
     }
     size_t chunksize = CHUNK_SIZE;
@@ -1393,15 +1609,251 @@ void NetworkBase::Server_Send_MAP(NetworkConnection* connection)
         NetworkPacket packet(NetworkCommand::Map);
         packet << static_cast<uint32_t>(header.size()) << static_cast<uint32_t>(i);
         packet.Write(&header[i], datasize);
-        if (connection)
+        SendPacketToClients(packet);
+    }
+}
+
+/**
+ * Starts a new session, clients that lost their connection before now have to load the map again.
+ */
+void NetworkBase::ResetResumeWindow()
+{
+    do
+    {
+        _sessionId = util_rand();
+    } while (_sessionId == 0);
+    _resumeGameCommands.clear();
+    _resumeWindowStart = gCurrentTicks;
+}
+
+/**
+ * Sends the ticks and game actions from the given tick on to a client that still has the park from before it lost
+ * its connection, instead of the whole map.
+ */
+void NetworkBase::Server_Send_RESUME(NetworkConnection& connection, uint32_t tick)
+{
+    log_verbose("Resuming client from tick %u, now at tick %u", tick, gCurrentTicks);
+
+    NetworkPacket packet(NetworkCommand::Resume);
+    packet << tick;
+    connection.QueuePacket(std::move(packet));
+
+    for (const auto& [sentTick, buffer] : _resumeGameCommands)
+    {
+        if (sentTick >= tick)
         {
-            connection->QueuePacket(std::move(packet));
+            connection.QueuePacket(buffer);
         }
-        else
+    }
+}
+
+static std::string GetObjectBundleKey(const ObjectRepositoryItem& object)
+{
+    return String::StdFormat("%.8s-%08X", object.ObjectEntry.name, object.ObjectEntry.checksum);
+}
+
+/**
+ * Packs the custom objects that have not been packed yet, spread over the worker threads.
+ */
+void NetworkBase::PrepareObjectBundles(const std::vector<const ObjectRepositoryItem*>& objects)
+{
+    std::vector<const ObjectRepositoryItem*> unpacked;
+    for (const auto* object : objects)
+    {
+        if (IsObjectCustom(object) && _objectBundles.find(GetObjectBundleKey(*object)) == _objectBundles.end())
+        {
+            unpacked.push_back(object);
+        }
+    }
+    if (unpacked.empty())
+        return;
+
+    PROFILE_SCOPE("NetworkBase::PrepareObjectBundles");
+
+    auto& repo = GetContext()->GetObjectRepository();
+    std::vector<std::shared_ptr<NetworkObjectBundle>> bundles(unpacked.size());
+    OpenRCT2::TaskScheduler::Get().ParallelFor(unpacked.size(), 1, [&](size_t i) {
+        try
+        {
+            std::vector<const ObjectRepositoryItem*> object = { unpacked[i] };
+            OpenRCT2::MemoryStream ms;
+            repo.WritePackedObjects(&ms, object);
+
+            auto bundle = std::make_shared<NetworkObjectBundle>();
+            const auto* data = static_cast<const uint8_t*>(ms.GetData());
+            bundle->Data.assign(data, data + ms.GetLength());
+            bundle->Hash = Crypt::SHA1(bundle->Data.data(), bundle->Data.size());
+            bundles[i] = std::move(bundle);
+        }
+        catch (const std::exception& e)
+        {
+            log_warning("Unable to pack object %.8s: %s", unpacked[i]->ObjectEntry.name, e.what());
+        }
+    });
+
+    for (size_t i = 0; i < unpacked.size(); i++)
+    {
+        if (bundles[i] != nullptr && !bundles[i]->Data.empty())
         {
-            SendPacketToClients(packet);
+            _objectBundles.emplace(GetObjectBundleKey(*unpacked[i]), std::move(bundles[i]));
         }
     }
+    log_verbose(
+        "Packed %u objects, %u are cached", static_cast<uint32_t>(unpacked.size()),
+        static_cast<uint32_t>(_objectBundles.size()));
+}
+
+/**
+ * Copies the game state for the client and saves and compresses the copy on a worker thread, so a
+ * joining client does not stall the game for everyone else. Clients joining within map_cache_ticks
+ * of each other get the same map along with the ticks and game actions since it was saved.
+ * The objects the client is missing are sent ahead of the map from the packed object cache.
+ */
+void NetworkBase::BeginMapTransfer(NetworkConnection& connection, const std::vector<const ObjectRepositoryItem*>& objects)
+{
+    PrepareObjectBundles(objects);
+    std::vector<std::shared_ptr<const NetworkObjectBundle>> bundles;
+    for (const auto* object : objects)
+    {
+        auto it = _objectBundles.find(GetObjectBundleKey(*object));
+        if (it != _objectBundles.end())
+        {
+            bundles.push_back(it->second);
+        }
+    }
+
+    const auto cacheTicks = static_cast<uint32_t>(std::max(gConfigNetwork.map_cache_ticks, 0));
+    if (_mapCache != nullptr && (gCurrentTicks < _mapCache->Tick || gCurrentTicks - _mapCache->Tick > cacheTicks))
+    {
+        _mapCache.reset();
+    }
+
+    if (_mapCache != nullptr)
+    {
+        log_verbose(
+            "Sending cached map from tick %u with %u game commands", _mapCache->Tick,
+            static_cast<uint32_t>(_mapCache->GameCommands.size()));
+
+        auto transfer = std::make_unique<NetworkMapTransfer>();
+        transfer->Objects = std::move(bundles);
+        transfer->Data = _mapCache->Data;
+        connection.MapTransfer = std::move(transfer);
+
+        // Held back until the map has been sent, ahead of anything sent from now on.
+        for (const auto& buffer : _mapCache->GameCommands)
+        {
+            connection.QueuePacket(buffer);
+        }
+        return;
+    }
+
+    map_reorganise_elements();
+    viewport_set_saved_view();
+
+    auto s6exporter = std::make_shared<S6Exporter>();
+    auto extras = std::make_shared<OpenRCT2::MemoryStream>();
+    try
+    {
+        s6exporter->Export();
+        WriteMapExtras(extras.get());
+    }
+    catch (const std::exception&)
+    {
+        log_warning("Failed to export map.");
+        connection.SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
+        connection.Socket->Disconnect();
+        return;
+    }
+
+    auto transfer = std::make_unique<NetworkMapTransfer>();
+    transfer->Objects = std::move(bundles);
+    auto data = std::async(std::launch::async, [s6exporter, extras]() {
+        PROFILE_SCOPE("NetworkBase::MapTransfer");
+
+        gUseRLE = false;
+        auto ms = OpenRCT2::MemoryStream();
+        s6exporter->SaveGame(&ms);
+        ms.Write(extras->GetData(), extras->GetLength());
+        return CompressMapForNetwork(ms.GetData(), ms.GetLength());
+    });
+    transfer->Data = data.share();
+
+    if (cacheTicks > 0)
+    {
+        _mapCache = std::make_unique<MapCache>();
+        _mapCache->Tick = gCurrentTicks;
+        _mapCache->Data = transfer->Data;
+    }
+    connection.MapTransfer = std::move(transfer);
+}
+
+void NetworkBase::UpdateMapTransfer(NetworkConnection& connection)
+{
+    auto& transfer = *connection.MapTransfer;
+
+    // Objects go first, the client installs them before it loads the map.
+    while (transfer.ObjectIndex < transfer.Objects.size()
+           && connection.GetQueuedPacketCount() < MAP_TRANSFER_MAX_QUEUED_CHUNKS)
+    {
+        const auto& bundle = *transfer.Objects[transfer.ObjectIndex];
+        const size_t offset = transfer.ObjectBytesQueued;
+        const size_t datasize = std::min<size_t>(CHUNK_SIZE, bundle.Data.size() - offset);
+        NetworkPacket packet(NetworkCommand::ObjectBundle);
+        packet << static_cast<uint32_t>(transfer.ObjectIndex) << static_cast<uint32_t>(transfer.Objects.size());
+        packet.Write(bundle.Hash.data(), bundle.Hash.size());
+        packet << static_cast<uint32_t>(bundle.Data.size()) << static_cast<uint32_t>(offset);
+        packet.Write(&bundle.Data[offset], datasize);
+        connection.QueueMapChunk(packet);
+
+        transfer.ObjectBytesQueued += datasize;
+        if (transfer.ObjectBytesQueued == bundle.Data.size())
+        {
+            transfer.ObjectIndex++;
+            transfer.ObjectBytesQueued = 0;
+        }
+    }
+    if (transfer.ObjectIndex < transfer.Objects.size())
+        return;
+
+    if (transfer.Data.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return;
+
+    const std::vector<uint8_t>* result = nullptr;
+    try
+    {
+        result = &transfer.Data.get();
+    }
+    catch (const std::exception& e)
+    {
+        log_warning("Failed to save map: %s", e.what());
+    }
+
+    if (result == nullptr || result->empty())
+    {
+        _mapCache.reset();
+        connection.MapTransfer.reset();
+        connection.SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
+        connection.Socket->Disconnect();
+        return;
+    }
+
+    // Only keep a few chunks queued so a slow client does not hold the whole map in its outbound queue.
+    const auto& data = *result;
+    while (transfer.BytesQueued < data.size() && connection.GetQueuedPacketCount() < MAP_TRANSFER_MAX_QUEUED_CHUNKS)
+    {
+        const size_t offset = transfer.BytesQueued;
+        const size_t datasize = std::min<size_t>(CHUNK_SIZE, data.size() - offset);
+        NetworkPacket packet(NetworkCommand::Map);
+        packet << static_cast<uint32_t>(data.size()) << static_cast<uint32_t>(offset);
+        packet.Write(&data[offset], datasize);
+        connection.QueueMapChunk(packet);
+        transfer.BytesQueued += datasize;
+    }
+
+    if (transfer.BytesQueued == data.size())
+    {
+        connection.EndMapTransfer();
+    }
 }
 
 std::vector<uint8_t> NetworkBase::save_for_network(const std::vector<const ObjectRepositoryItem*>& objects) const
@@ -1418,9 +1870,12 @@ std::vector<uint8_t> NetworkBase::save_for_network(const std::vector<const Objec
     }
     gUseRLE = RLEState;
 
-    const void* data = ms.GetData();
-    int32_t size = ms.GetLength();
+    return CompressMapForNetwork(ms.GetData(), ms.GetLength());
+}
 
+std::vector<uint8_t> NetworkBase::CompressMapForNetwork(const void* data, size_t size)
+{
+    std::vector<uint8_t> header;
     auto compressed = util_zlib_deflate(static_cast<const uint8_t*>(data), size);
     if (compressed != std::nullopt)
     {
@@ -1428,7 +1883,9 @@ std::vector<uint8_t> NetworkBase::save_for_network(const std::vector<const Objec
         header.resize(headerString.size() + 1 + compressed->size());
         std::memcpy(&header[0], headerString.c_str(), headerString.size() + 1);
         std::memcpy(&header[headerString.size() + 1], compressed->data(), compressed->size());
-        log_verbose("Sending map of size %u bytes, compressed to %u bytes", size, headerString.size() + 1 + compressed->size());
+        log_verbose(
+            "Sending map of size %u bytes, compressed to %u bytes", static_cast<uint32_t>(size),
+            static_cast<uint32_t>(headerString.size() + 1 + compressed->size()));
     }
     else
     {
@@ -1483,7 +1940,7 @@ void NetworkBase::Client_Send_GAME_ACTION(const GameAction* action)
         _gameActionCallbacks.insert(std::make_pair(networkId, action->GetCallback()));
     }
 
-    DataSerialiser stream(true);
+    DataSerialiser stream(true, GAME_ACTION_SERIALISE_RESERVE);
     action->Serialise(stream);
 
     packet << gCurrentTicks << action->GetType() << stream;
@@ -1492,18 +1949,76 @@ void NetworkBase::Client_Send_GAME_ACTION(const GameAction* action)
 
 void NetworkBase::Server_Send_GAME_ACTION(const GameAction* action)
 {
-    NetworkPacket packet(NetworkCommand::GameAction);
-
-    DataSerialiser stream(true);
+    DataSerialiser stream(true, GAME_ACTION_SERIALISE_RESERVE);
     action->Serialise(stream);
 
-    packet << gCurrentTicks << action->GetType() << stream;
+    const auto& data = stream.GetStream();
+    if (!_gameActionBatch.Data.empty()
+        && (_gameActionBatchTick != gCurrentTicks || _gameActionBatch.Data.size() + data.GetLength() > GAME_ACTION_BATCH_MAX_SIZE))
+    {
+        Server_Send_GAME_ACTION_BATCH();
+    }
 
-    SendPacketToClients(packet);
+    if (_gameActionBatch.Data.empty())
+    {
+        _gameActionBatch = NetworkPacket(NetworkCommand::GameActionBatch);
+        _gameActionBatch << gCurrentTicks;
+        _gameActionBatchTick = gCurrentTicks;
+    }
+
+    // Type and length of each action, followed by its serialised fields.
+    _gameActionBatch.WriteVarInt(static_cast<uint32_t>(action->GetType()));
+    _gameActionBatch.WriteVarInt(static_cast<uint32_t>(data.GetLength()));
+    _gameActionBatch.Write(data.GetData(), data.GetLength());
+}
+
+/**
+ * Sends all game actions relayed since the last call in a single packet.
+ */
+void NetworkBase::Server_Send_GAME_ACTION_BATCH()
+{
+    if (_gameActionBatch.Data.empty())
+        return;
+
+    SendPacketToClients(_gameActionBatch);
+    _gameActionBatch.Clear();
+}
+
+/**
+ * Sends the keys of the replicated plugin storage changed since the last call in a single packet.
+ */
+void NetworkBase::Server_Send_PLUGIN_STORAGE()
+{
+#    ifdef ENABLE_SCRIPTING
+    auto& storage = GetContext()->GetScriptEngine().GetReplicatedStorage();
+    if (!storage.HasChanges())
+        return;
+
+    auto changes = storage.TakeChanges();
+    NetworkPacket packet(NetworkCommand::PluginStorage);
+    packet << storage.GetRevision();
+    packet.WriteVarInt(static_cast<uint32_t>(changes.size()));
+    for (const auto& change : changes)
+    {
+        packet.WriteString(change.Key.c_str());
+        packet << static_cast<uint8_t>(change.Value ? 1 : 0);
+        if (change.Value)
+        {
+            packet.WriteString(change.Value->c_str());
+        }
+    }
+
+    // Clients that have not been sent the map yet get the whole storage with it.
+    SendPacketToClients(packet, false, true);
+#    endif
 }
 
 void NetworkBase::Server_Send_TICK()
 {
+    // Actions of the previous tick have to arrive before the client can advance past it.
+    Server_Send_GAME_ACTION_BATCH();
+    Server_Send_PLUGIN_STORAGE();
+
     NetworkPacket packet(NetworkCommand::Tick);
     packet << gCurrentTicks << scenario_rand_state().s0;
     uint32_t flags = 0;
@@ -1522,7 +2037,10 @@ void NetworkBase::Server_Send_TICK()
     packet << flags;
     if (flags & NETWORK_TICK_FLAG_CHECKSUMS)
     {
-        rct_sprite_checksum checksum = sprite_checksum();
+        rct_sprite_checksum checksum = sprite_checksum_rolling();
+#    if DEBUG_LEVEL_1
+        Guard::Assert(checksum.raw == sprite_checksum_rolling(true).raw, "Rolling sprite checksum is out of date");
+#    endif
         packet.WriteString(checksum.ToString().c_str());
     }
 
@@ -1596,9 +2114,217 @@ json_t NetworkBase::GetServerInfoAsJson() const
         { "maxPlayers", gConfigNetwork.maxplayers },    { "description", gConfigNetwork.server_description },
         { "greeting", gConfigNetwork.server_greeting }, { "dedicated", gOpenRCT2Headless },
     };
+
+    auto memoryUsage = MemoryUsageGetReport();
+    json_t jsonMemory = { { "total", memoryUsage.GetTotal() } };
+    for (size_t i = 0; i < MEMORY_USAGE_CATEGORY_COUNT; i++)
+    {
+        auto category = static_cast<MemoryUsageCategory>(i);
+        jsonMemory[MemoryUsageGetCategoryName(category)] = memoryUsage.Get(category);
+    }
+    jsonObj["memory"] = jsonMemory;
     return jsonObj;
 }
 
+size_t NetworkBase::GetMemoryUsage() const
+{
+    size_t result = 0;
+    for (const auto& connection : client_connection_list)
+    {
+        result += connection->GetMemoryUsage();
+    }
+    if (_serverConnection != nullptr)
+    {
+        result += _serverConnection->GetMemoryUsage();
+    }
+    return result;
+}
+
+static const char* GetNetworkCommandName(NetworkCommand command)
+{
+    switch (command)
+    {
+        case NetworkCommand::Auth:
+            return "auth";
+        case NetworkCommand::Map:
+            return "map";
+        case NetworkCommand::Chat:
+            return "chat";
+        case NetworkCommand::Tick:
+            return "tick";
+        case NetworkCommand::PlayerList:
+            return "playerList";
+        case NetworkCommand::Ping:
+            return "ping";
+        case NetworkCommand::PingList:
+            return "pingList";
+        case NetworkCommand::DisconnectMessage:
+            return "disconnectMessage";
+        case NetworkCommand::GameInfo:
+            return "gameInfo";
+        case NetworkCommand::ShowError:
+            return "showError";
+        case NetworkCommand::GroupList:
+            return "groupList";
+        case NetworkCommand::Event:
+            return "event";
+        case NetworkCommand::Token:
+            return "token";
+        case NetworkCommand::ObjectsList:
+            return "objectsList";
+        case NetworkCommand::MapRequest:
+            return "mapRequest";
+        case NetworkCommand::GameAction:
+            return "gameAction";
+        case NetworkCommand::PlayerInfo:
+            return "playerInfo";
+        case NetworkCommand::RequestGameState:
+            return "requestGameState";
+        case NetworkCommand::GameState:
+            return "gameState";
+        case NetworkCommand::Scripts:
+            return "scripts";
+        case NetworkCommand::Heartbeat:
+            return "heartbeat";
+        case NetworkCommand::GameActionBatch:
+            return "gameActionBatch";
+        case NetworkCommand::ObjectBundle:
+            return "objectBundle";
+        case NetworkCommand::Resume:
+            return "resume";
+        default:
+            return nullptr;
+    }
+}
+
+static json_t GetConnectionStatsAsJson(const NetworkStats_t& stats)
+{
+    json_t commands = json_t::object();
+    for (size_t n = 0; n < EnumValue(NetworkCommand::Max); n++)
+    {
+        const auto& command = stats.commands[n];
+        const char* name = GetNetworkCommandName(static_cast<NetworkCommand>(n));
+        if (name == nullptr || (command.packetsReceived == 0 && command.packetsSent == 0))
+            continue;
+
+        commands[name] = {
+            { "packetsReceived", command.packetsReceived }, { "bytesReceived", command.bytesReceived },
+            { "packetsSent", command.packetsSent },         { "bytesSent", command.bytesSent },
+            { "processTimeUs", command.processTimeUs },
+        };
+    }
+
+    json_t pingHistogram = json_t::array();
+    for (size_t n = 0; n < NetworkPingHistogramSize; n++)
+    {
+        pingHistogram.push_back(stats.pingHistogram[n]);
+    }
+
+    return {
+        { "bytesReceived", stats.bytesReceived[EnumValue(NetworkStatisticsGroup::Total)] },
+        { "bytesSent", stats.bytesSent[EnumValue(NetworkStatisticsGroup::Total)] },
+        { "commands", commands },
+        { "pingHistogram", pingHistogram },
+        { "packetsCoalesced", stats.packetsCoalesced },
+    };
+}
+
+/**
+ * Traffic counters of every connection, for the client only the connection to the server.
+ */
+json_t NetworkBase::GetTelemetryAsJson() const
+{
+    json_t pingBounds = json_t::array();
+    for (auto bound : NetworkPingHistogramBounds)
+    {
+        pingBounds.push_back(bound);
+    }
+
+    json_t connections = json_t::array();
+    auto addConnection = [&connections](const NetworkConnection& connection) {
+        auto jsonConnection = GetConnectionStatsAsJson(connection.Stats);
+        if (connection.Player != nullptr)
+        {
+            jsonConnection["player"] = connection.Player->Id;
+            jsonConnection["name"] = connection.Player->Name;
+            jsonConnection["ping"] = connection.Player->Ping;
+        }
+        jsonConnection["queuedPackets"] = connection.GetQueuedPacketCount();
+        jsonConnection["queuedBytes"] = connection.GetQueuedByteCount();
+        connections.push_back(jsonConnection);
+    };
+
+    if (mode == NETWORK_MODE_CLIENT)
+    {
+        if (_serverConnection != nullptr)
+        {
+            addConnection(*_serverConnection);
+        }
+    }
+    else
+    {
+        for (const auto& connection : client_connection_list)
+        {
+            addConnection(*connection);
+        }
+    }
+
+    return {
+        { "total", GetConnectionStatsAsJson(GetStats()) },
+        { "pingHistogramBounds", pingBounds },
+        { "slowClientsDisconnected", _slowClientsDisconnected },
+        { "connections", connections },
+    };
+}
+
+/**
+ * Whether the client fell so far behind that the server gives up on it. The send queue may grow past its limit
+ * as only some packets can be coalesced, twice the limit is kept as a hard bound on the memory held per client.
+ */
+bool NetworkBase::IsClientTooSlow(const NetworkConnection& connection) const
+{
+    if (connection.SendQueueLimit != 0 && connection.GetQueuedByteCount() > connection.SendQueueLimit * 2)
+        return true;
+
+    // Ticks are held back during a map transfer, so the client is not lagging behind yet.
+    if (gConfigNetwork.max_client_lag_ticks > 0 && connection.MapTransfer == nullptr)
+    {
+        auto oldestTick = connection.GetOldestQueuedTick();
+        if (oldestTick.has_value() && gCurrentTicks - *oldestTick > static_cast<uint32_t>(gConfigNetwork.max_client_lag_ticks))
+            return true;
+    }
+    return false;
+}
+
+void NetworkBase::LogServerTelemetry()
+{
+    const auto ticks = platform_get_ticks();
+    const auto stats = GetStats();
+    if (_lastTelemetryLogTime != 0)
+    {
+        const auto total = EnumValue(NetworkStatisticsGroup::Total);
+        const auto elapsed = std::max<uint32_t>(ticks - _lastTelemetryLogTime, 1);
+
+        // Counters of disconnected clients are gone, so the rates can not go below zero.
+        const auto sent = stats.bytesSent[total] - std::min(stats.bytesSent[total], _lastTelemetryLogStats.bytesSent[total]);
+        const auto received = stats.bytesReceived[total]
+            - std::min(stats.bytesReceived[total], _lastTelemetryLogStats.bytesReceived[total]);
+
+        size_t maxQueuedBytes = 0;
+        for (const auto& connection : client_connection_list)
+        {
+            maxQueuedBytes = std::max(maxQueuedBytes, connection->GetQueuedByteCount());
+        }
+
+        Console::WriteLine(
+            "Network: %u connections, sent %.1f KiB/s, received %.1f KiB/s, largest send queue %u bytes",
+            static_cast<uint32_t>(client_connection_list.size()), sent * 1000.0 / elapsed / 1024.0,
+            received * 1000.0 / elapsed / 1024.0, static_cast<uint32_t>(maxQueuedBytes));
+    }
+    _lastTelemetryLogTime = ticks;
+    _lastTelemetryLogStats = stats;
+}
+
 void NetworkBase::Server_Send_GAMEINFO(NetworkConnection& connection)
 {
     NetworkPacket packet(NetworkCommand::GameInfo);
@@ -1656,10 +2382,10 @@ void NetworkBase::Server_Send_EVENT_PLAYER_DISCONNECTED(const char* playerName,
     SendPacketToClients(packet);
 }
 
-bool NetworkBase::ProcessConnection(NetworkConnection& connection)
+bool NetworkBase::ProcessConnection(NetworkConnection& connection, bool readable)
 {
-    NetworkReadPacket packetStatus;
-    do
+    NetworkReadPacket packetStatus = NetworkReadPacket::NoData;
+    while (readable)
     {
         packetStatus = connection.ReadPacket();
         switch (packetStatus)
@@ -1686,7 +2412,9 @@ bool NetworkBase::ProcessConnection(NetworkConnection& connection)
                 // could not read anything from socket
                 break;
         }
-    } while (packetStatus == NetworkReadPacket::Success);
+        if (packetStatus != NetworkReadPacket::Success)
+            break;
+    }
 
     connection.SendQueuedPackets();
 
@@ -1711,7 +2439,16 @@ void NetworkBase::ProcessPacket(NetworkConnection& connection, NetworkPacket& pa
         auto commandHandler = it->second;
         if (connection.AuthStatus == NetworkAuth::Ok || !packet.CommandRequiresAuth())
         {
+            const auto startTime = std::chrono::steady_clock::now();
             (this->*commandHandler)(connection, packet);
+            const auto endTime = std::chrono::steady_clock::now();
+
+            const auto command = EnumValue(packet.GetCommand());
+            if (command < EnumValue(NetworkCommand::Max))
+            {
+                const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime);
+                connection.Stats.commands[command].processTimeUs += elapsed.count();
+            }
         }
     }
 
@@ -1924,6 +2661,10 @@ void NetworkBase::ProcessDisconnectedClients()
         {
             ServerClientDisconnected(connection);
             RemovePlayer(connection);
+            if (_socketPoller != nullptr && connection->Socket != nullptr)
+            {
+                _socketPoller->Remove(*connection->Socket);
+            }
 
             it = client_connection_list.erase(it);
         }
@@ -1944,6 +2685,14 @@ void NetworkBase::AddClient(std::unique_ptr<ITcpSocket>&& socket)
     // Store connection
     auto connection = std::make_unique<NetworkConnection>();
     connection->Socket = std::move(socket);
+    connection->SendQueueLimit = static_cast<size_t>(std::max(gConfigNetwork.send_queue_limit_kib, 0)) * 1024;
+
+    // Read right away as the client usually sends its first packet together with connecting.
+    connection->IsReadable = true;
+    if (_socketPoller != nullptr)
+    {
+        _socketPoller->Add(*connection->Socket, connection.get());
+    }
 
     client_connection_list.push_back(std::move(connection));
 }
@@ -2121,44 +2870,73 @@ void NetworkBase::Client_Handle_TOKEN(NetworkConnection& connection, NetworkPack
         return;
     }
 
-    try
-    {
-        auto fs = FileStream(keyPath, FILE_MODE_OPEN);
-        if (!_key.LoadPrivate(&fs))
-        {
-            throw std::runtime_error("Failed to load private key.");
-        }
-    }
-    catch (const std::exception&)
+    uint32_t challenge_size;
+    packet >> challenge_size;
+    const uint8_t* challenge = packet.Read(challenge_size);
+    if (challenge == nullptr)
     {
-        log_error("Failed to load key %s", keyPath);
+        log_error("Received invalid challenge from server.");
         connection.SetLastDisconnectReason(STR_MULTIPLAYER_VERIFICATION_FAILURE);
         connection.Socket->Disconnect();
         return;
     }
+    _challenge.assign(challenge, challenge + challenge_size);
 
-    uint32_t challenge_size;
-    packet >> challenge_size;
-    const char* challenge = reinterpret_cast<const char*>(packet.Read(challenge_size));
+    const char* password = String::IsNullOrEmpty(gCustomPassword) ? "" : gCustomPassword;
+    Client_BeginAuth(password);
+}
+
+/**
+ * Loads the private key and signs the challenge on a worker thread, Client_UpdateAuth sends the result.
+ */
+void NetworkBase::Client_BeginAuth(const std::string& password)
+{
+    utf8 keyPath[MAX_PATH];
+    network_get_private_key_path(keyPath, sizeof(keyPath), gConfigNetwork.player_name);
+
+    _authPassword = password;
+    _authSignature = std::async(std::launch::async, [keyPath = std::string(keyPath), challenge = _challenge]() {
+        NetworkAuthSignature result;
+        // The key only lives for this job. There's no need to keep it in memory and it may get leaked
+        // when process dump gets collected at some point in future.
+        NetworkKey key;
+        try
+        {
+            auto fs = FileStream(keyPath, FILE_MODE_OPEN);
+            if (!key.LoadPrivate(&fs))
+            {
+                throw std::runtime_error("Failed to load private key.");
+            }
+        }
+        catch (const std::exception&)
+        {
+            log_error("Failed to load key %s", keyPath.c_str());
+            return result;
+        }
+
+        result.PublicKey = key.PublicKeyString();
+        result.Ok = key.Sign(challenge.data(), challenge.size(), result.Signature);
+        if (!result.Ok)
+        {
+            log_error("Failed to sign server's challenge.");
+        }
+        return result;
+    });
+}
+
+void NetworkBase::Client_UpdateAuth()
+{
+    if (!_authSignature.valid() || _authSignature.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return;
 
-    std::vector<uint8_t> signature;
-    const std::string pubkey = _key.PublicKeyString();
-    _challenge.resize(challenge_size);
-    std::memcpy(_challenge.data(), challenge, challenge_size);
-    bool ok = _key.Sign(_challenge.data(), _challenge.size(), signature);
-    if (!ok)
+    auto result = _authSignature.get();
+    if (!result.Ok)
     {
-        log_error("Failed to sign server's challenge.");
-        connection.SetLastDisconnectReason(STR_MULTIPLAYER_VERIFICATION_FAILURE);
-        connection.Socket->Disconnect();
+        _serverConnection->SetLastDisconnectReason(STR_MULTIPLAYER_VERIFICATION_FAILURE);
+        _serverConnection->Socket->Disconnect();
         return;
     }
-    // Don't keep private key in memory. There's no need and it may get leaked
-    // when process dump gets collected at some point in future.
-    _key.Unload();
-
-    const char* password = String::IsNullOrEmpty(gCustomPassword) ? "" : gCustomPassword;
-    Client_Send_AUTH(gConfigNetwork.player_name.c_str(), password, pubkey.c_str(), signature);
+    Client_Send_AUTH(gConfigNetwork.player_name, _authPassword, result.PublicKey, result.Signature);
 }
 
 void NetworkBase::Server_Handle_REQUEST_GAMESTATE(NetworkConnection& connection, NetworkPacket& packet)
@@ -2217,6 +2995,7 @@ void NetworkBase::Client_Handle_AUTH(NetworkConnection& connection, NetworkPacke
     switch (connection.AuthStatus)
     {
         case NetworkAuth::Ok:
+            packet >> _serverSessionId;
             Client_Send_GAMEINFO();
             break;
         case NetworkAuth::BadName:
@@ -2270,6 +3049,7 @@ void NetworkBase::Server_Client_Joined(const char* name, const std::string& keyh
         auto context = GetContext();
         auto& objManager = context->GetObjectManager();
         auto objects = objManager.GetPackableObjects();
+        PrepareObjectBundles(objects);
         Server_Send_OBJECTS_LIST(connection, objects);
         Server_Send_SCRIPTS(connection);
 
@@ -2373,7 +3153,11 @@ void NetworkBase::Client_Handle_SCRIPTS(NetworkConnection& connection, NetworkPa
         uint32_t codeLength{};
         packet >> codeLength;
         auto code = std::string_view(reinterpret_cast<const char*>(packet.Read(codeLength)), codeLength);
-        scriptEngine.AddNetworkPlugin(code);
+        // The plugins from before the connection was lost are still running.
+        if (!_resume)
+        {
+            scriptEngine.AddNetworkPlugin(code);
+        }
     }
 #    else
     if (numScripts > 0)
@@ -2384,6 +3168,38 @@ void NetworkBase::Client_Handle_SCRIPTS(NetworkConnection& connection, NetworkPa
 #    endif
 }
 
+void NetworkBase::Client_Handle_PLUGIN_STORAGE([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
+{
+#    ifdef ENABLE_SCRIPTING
+    using namespace OpenRCT2::Scripting;
+
+    uint32_t revision{};
+    uint32_t numChanges{};
+    packet >> revision;
+    if (!packet.ReadVarInt(numChanges))
+    {
+        log_error("Received malformed plugin storage changes");
+        return;
+    }
+
+    std::vector<ReplicatedStorage::Change> changes;
+    for (uint32_t i = 0; i < numChanges; i++)
+    {
+        const char* key = packet.ReadString();
+        uint8_t hasValue{};
+        packet >> hasValue;
+        const char* value = hasValue != 0 ? packet.ReadString() : nullptr;
+        if (key == nullptr || (hasValue != 0 && value == nullptr))
+        {
+            log_error("Received malformed plugin storage changes");
+            return;
+        }
+        changes.push_back({ key, value != nullptr ? std::make_optional<std::string>(value) : std::nullopt });
+    }
+    GetContext()->GetScriptEngine().GetReplicatedStorage().ApplyChanges(revision, changes);
+#    endif
+}
+
 void NetworkBase::Client_Handle_GAMESTATE(NetworkConnection& connection, NetworkPacket& packet)
 {
     uint32_t tick;
@@ -2490,124 +3306,236 @@ void NetworkBase::Server_Handle_MAPREQUEST(NetworkConnection& connection, Networ
         }
     }
 
+    uint32_t resumeSessionId = 0;
+    uint32_t resumeTick = 0;
+    packet >> resumeSessionId >> resumeTick;
+
     const char* player_name = static_cast<const char*>(connection.Player->Name.c_str());
-    Server_Send_MAP(&connection);
+    if (resumeSessionId != 0 && resumeSessionId == _sessionId && resumeTick >= _resumeWindowStart
+        && resumeTick <= gCurrentTicks)
+    {
+        Server_Send_RESUME(connection, resumeTick);
+    }
+    else
+    {
+        Server_Send_MAP(&connection);
+    }
     Server_Send_EVENT_PLAYER_JOINED(player_name);
     Server_Send_GROUPLIST(connection);
 }
 
-void NetworkBase::Server_Handle_AUTH(NetworkConnection& connection, NetworkPacket& packet)
+static NetworkAuthVerification VerifyAuthSignature(
+    const std::string& publicKey, const std::vector<uint8_t>& challenge, const std::vector<uint8_t>& signature)
 {
-    if (connection.AuthStatus != NetworkAuth::Ok)
+    NetworkAuthVerification result;
+    try
     {
-        const char* gameversion = packet.ReadString();
-        const char* name = packet.ReadString();
-        const char* password = packet.ReadString();
-        const char* pubkey = packet.ReadString();
-        uint32_t sigsize;
-        packet >> sigsize;
-        if (pubkey == nullptr)
+        NetworkKey key;
+        auto ms = MemoryStream(publicKey.data(), publicKey.size());
+        if (!key.LoadPublic(&ms))
         {
-            connection.AuthStatus = NetworkAuth::VerificationFailure;
+            throw std::runtime_error("Failed to load public key.");
+        }
+
+        result.Verified = key.Verify(challenge.data(), challenge.size(), signature);
+        result.PublicKeyHash = key.PublicKeyHash();
+        if (result.Verified)
+        {
+            log_verbose("Signature verification ok. Hash %s", result.PublicKeyHash.c_str());
         }
         else
         {
-            try
-            {
-                std::vector<uint8_t> signature;
-                signature.resize(sigsize);
+            log_verbose("Signature verification failed!");
+        }
+    }
+    catch (const std::exception&)
+    {
+        result.Verified = false;
+        log_verbose("Signature verification failed, invalid data!");
+    }
+    return result;
+}
 
-                const uint8_t* signatureData = packet.Read(sigsize);
-                if (signatureData == nullptr)
-                {
-                    throw std::runtime_error("Failed to read packet.");
-                }
+void NetworkBase::Server_Handle_AUTH(NetworkConnection& connection, NetworkPacket& packet)
+{
+    if (connection.AuthStatus == NetworkAuth::Ok || connection.PendingAuth != nullptr)
+        return;
+
+    auto request = std::make_unique<NetworkAuthRequest>();
+    const char* gameversion = packet.ReadString();
+    const char* name = packet.ReadString();
+    const char* password = packet.ReadString();
+    const char* pubkey = packet.ReadString();
+    uint32_t sigsize;
+    packet >> sigsize;
+    if (gameversion != nullptr)
+        request->GameVersion = gameversion;
+    if (name != nullptr)
+        request->Name = name;
+    if (password != nullptr)
+        request->Password = password;
+
+    const uint8_t* signatureData = pubkey == nullptr ? nullptr : packet.Read(sigsize);
+    if (signatureData == nullptr)
+    {
+        log_verbose("Signature verification failed, invalid data!");
+        std::promise<NetworkAuthVerification> failure;
+        failure.set_value({});
+        request->Verification = failure.get_future();
+    }
+    else
+    {
+        // RSA verification takes long enough to stall the game when many players join at once, so it runs on a
+        // worker thread and UpdatePendingAuth completes the request once it is done.
+        std::vector<uint8_t> signature(signatureData, signatureData + sigsize);
+        request->Verification = std::async(
+            std::launch::async,
+            [publicKey = std::string(pubkey), challenge = connection.Challenge, signature = std::move(signature)]() {
+                return VerifyAuthSignature(publicKey, challenge, signature);
+            });
+    }
+    connection.PendingAuth = std::move(request);
+}
 
-                std::memcpy(signature.data(), signatureData, sigsize);
+void NetworkBase::UpdatePendingAuth(NetworkConnection& connection)
+{
+    auto& request = *connection.PendingAuth;
+    if (request.Verification.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return;
 
-                auto ms = MemoryStream(pubkey, strlen(pubkey));
-                if (!connection.Key.LoadPublic(&ms))
-                {
-                    throw std::runtime_error("Failed to load public key.");
-                }
+    auto pendingAuth = std::move(connection.PendingAuth);
+    Server_Complete_AUTH(connection, *pendingAuth, pendingAuth->Verification.get());
+}
 
-                bool verified = connection.Key.Verify(connection.Challenge.data(), connection.Challenge.size(), signature);
-                const std::string hash = connection.Key.PublicKeyHash();
-                if (verified)
-                {
-                    log_verbose("Signature verification ok. Hash %s", hash.c_str());
-                    if (gConfigNetwork.known_keys_only && _userManager.GetUserByHash(hash) == nullptr)
-                    {
-                        log_verbose("Hash %s, not known", hash.c_str());
-                        connection.AuthStatus = NetworkAuth::UnknownKeyDisallowed;
-                    }
-                    else
-                    {
-                        connection.AuthStatus = NetworkAuth::Verified;
-                    }
-                }
-                else
-                {
-                    connection.AuthStatus = NetworkAuth::VerificationFailure;
-                    log_verbose("Signature verification failed!");
-                }
-            }
-            catch (const std::exception&)
-            {
-                connection.AuthStatus = NetworkAuth::VerificationFailure;
-                log_verbose("Signature verification failed, invalid data!");
-            }
-        }
+void NetworkBase::Server_Complete_AUTH(
+    NetworkConnection& connection, const NetworkAuthRequest& request, const NetworkAuthVerification& verification)
+{
+    const std::string& hash = verification.PublicKeyHash;
+    if (!verification.Verified)
+    {
+        connection.AuthStatus = NetworkAuth::VerificationFailure;
+    }
+    else if (gConfigNetwork.known_keys_only && _userManager.GetUserByHash(hash) == nullptr)
+    {
+        log_verbose("Hash %s, not known", hash.c_str());
+        connection.AuthStatus = NetworkAuth::UnknownKeyDisallowed;
+    }
+    else
+    {
+        connection.AuthStatus = NetworkAuth::Verified;
+    }
 
-        bool passwordless = false;
-        if (connection.AuthStatus == NetworkAuth::Verified)
+    bool passwordless = false;
+    if (connection.AuthStatus == NetworkAuth::Verified)
+    {
+        const NetworkGroup* group = GetGroupByID(GetGroupIDByHash(hash));
+        passwordless = group->CanPerformCommand(GameCommand::PasswordlessLogin);
+    }
+    if (!request.GameVersion.has_value() || network_get_version() != *request.GameVersion)
+    {
+        connection.AuthStatus = NetworkAuth::BadVersion;
+    }
+    else if (!request.Name.has_value())
+    {
+        connection.AuthStatus = NetworkAuth::BadName;
+    }
+    else if (!passwordless)
+    {
+        if ((!request.Password.has_value() || request.Password->empty()) && !_password.empty())
         {
-            const NetworkGroup* group = GetGroupByID(GetGroupIDByHash(connection.Key.PublicKeyHash()));
-            passwordless = group->CanPerformCommand(GameCommand::PasswordlessLogin);
+            connection.AuthStatus = NetworkAuth::RequirePassword;
         }
-        if (!gameversion || network_get_version() != gameversion)
+        else if (request.Password.has_value() && _password != *request.Password)
         {
-            connection.AuthStatus = NetworkAuth::BadVersion;
+            connection.AuthStatus = NetworkAuth::BadPassword;
         }
-        else if (!name)
+    }
+
+    if (static_cast<size_t>(gConfigNetwork.maxplayers) <= player_list.size())
+    {
+        connection.AuthStatus = NetworkAuth::Full;
+    }
+    else if (connection.AuthStatus == NetworkAuth::Verified)
+    {
+        const char* name = request.Name->c_str();
+        if (ProcessPlayerAuthenticatePluginHooks(connection, name, hash))
         {
-            connection.AuthStatus = NetworkAuth::BadName;
+            connection.AuthStatus = NetworkAuth::Ok;
+            Server_Client_Joined(name, hash, connection);
         }
-        else if (!passwordless)
+        else
         {
-            if ((!password || strlen(password) == 0) && !_password.empty())
-            {
-                connection.AuthStatus = NetworkAuth::RequirePassword;
-            }
-            else if (password && _password != password)
-            {
-                connection.AuthStatus = NetworkAuth::BadPassword;
-            }
+            connection.AuthStatus = NetworkAuth::VerificationFailure;
         }
+    }
+    else if (connection.AuthStatus != NetworkAuth::RequirePassword)
+    {
+        log_error("Unknown failure (%d) while authenticating client", connection.AuthStatus);
+    }
+    Server_Send_AUTH(connection);
+}
 
-        if (static_cast<size_t>(gConfigNetwork.maxplayers) <= player_list.size())
-        {
-            connection.AuthStatus = NetworkAuth::Full;
-        }
-        else if (connection.AuthStatus == NetworkAuth::Verified)
+void NetworkBase::Client_Handle_OBJECT_BUNDLE(NetworkConnection& connection, NetworkPacket& packet)
+{
+    uint32_t index{};
+    uint32_t count{};
+    packet >> index >> count;
+    const auto* hash = packet.Read(std::tuple_size_v<Crypt::Sha1Algorithm::Result>);
+    uint32_t size{};
+    uint32_t offset{};
+    packet >> size >> offset;
+    const size_t chunksize = packet.Header.Size - std::min<size_t>(packet.BytesRead, packet.Header.Size);
+    const auto* chunk = packet.Read(chunksize);
+
+    if (offset == 0)
+    {
+        _objectBundleBuffer.clear();
+    }
+    if (hash == nullptr || chunk == nullptr || chunksize == 0 || size > OBJECT_BUNDLE_MAX_SIZE
+        || offset != _objectBundleBuffer.size() || offset + chunksize > size)
+    {
+        log_warning("Received invalid object data from server");
+        _objectBundleBuffer.clear();
+        connection.SetLastDisconnectReason(STR_MULTIPLAYER_RECEIVED_INVALID_DATA);
+        connection.Socket->Disconnect();
+        return;
+    }
+
+    char objectsMsg[256];
+    const uint32_t args[] = {
+        index + 1,
+        count,
+    };
+    format_string(objectsMsg, 256, STR_MULTIPLAYER_RECEIVING_OBJECTS, &args);
+
+    auto intent = Intent(WC_NETWORK_STATUS);
+    intent.putExtra(INTENT_EXTRA_MESSAGE, std::string{ objectsMsg });
+    intent.putExtra(INTENT_EXTRA_CALLBACK, []() -> void { gNetwork.Close(); });
+    context_open_intent(&intent);
+
+    _objectBundleBuffer.insert(_objectBundleBuffer.end(), chunk, chunk + chunksize);
+    if (_objectBundleBuffer.size() < size)
+        return;
+
+    const auto receivedHash = Crypt::SHA1(_objectBundleBuffer.data(), _objectBundleBuffer.size());
+    if (std::memcmp(receivedHash.data(), hash, receivedHash.size()) != 0)
+    {
+        log_warning("Object %u received from server does not match its hash", index);
+    }
+    else
+    {
+        // Installed into the user's object directory, it is not requested again from any server.
+        try
         {
-            const std::string hash = connection.Key.PublicKeyHash();
-            if (ProcessPlayerAuthenticatePluginHooks(connection, name, hash))
-            {
-                connection.AuthStatus = NetworkAuth::Ok;
-                Server_Client_Joined(name, hash, connection);
-            }
-            else
-            {
-                connection.AuthStatus = NetworkAuth::VerificationFailure;
-            }
+            auto ms = OpenRCT2::MemoryStream(_objectBundleBuffer.data(), _objectBundleBuffer.size());
+            GetContext()->GetObjectRepository().ExportPackedObject(&ms);
         }
-        else if (connection.AuthStatus != NetworkAuth::RequirePassword)
+        catch (const std::exception& e)
         {
-            log_error("Unknown failure (%d) while authenticating client", connection.AuthStatus);
+            log_warning("Unable to install object received from server: %s", e.what());
         }
-        Server_Send_AUTH(connection);
     }
+    _objectBundleBuffer.clear();
 }
 
 void NetworkBase::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
@@ -2650,6 +3578,8 @@ void NetworkBase::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connecti
     {
         // Allow queue processing of game actions again.
         GameActions::ResumeQueue();
+        // The server could not resume the park from before the connection was lost, it is replaced.
+        _resume.reset();
 
         context_force_close_window_by_class(WC_NETWORK_STATUS);
         bool has_to_free = false;
@@ -2709,6 +3639,34 @@ void NetworkBase::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connecti
     }
 }
 
+void NetworkBase::Client_Handle_RESUME(NetworkConnection& connection, NetworkPacket& packet)
+{
+    uint32_t tick{};
+    packet >> tick;
+    if (!_resume || _resume->Tick != tick)
+    {
+        log_warning("Received a resume from tick %u that was not asked for", tick);
+        connection.SetLastDisconnectReason(STR_MULTIPLAYER_RECEIVED_INVALID_DATA);
+        connection.Socket->Disconnect();
+        return;
+    }
+
+    log_verbose("Resuming from tick %u", tick);
+    _resume.reset();
+
+    // The game actions received since authenticating are sent again with the missed ones that follow.
+    GameActions::ClearQueue();
+    GameActions::ResumeQueue();
+
+    context_force_close_window_by_class(WC_NETWORK_STATUS);
+    _serverState.tick = gCurrentTicks;
+    _serverState.state = NetworkServerState::Ok;
+    _clientMapLoaded = true;
+
+    network_chat_show_connected_message();
+    ProcessPlayerList();
+}
+
 bool NetworkBase::LoadMap(IStream* stream)
 {
     bool result = false;
@@ -2756,6 +3714,18 @@ bool NetworkBase::LoadMap(IStream* stream)
         gCheatsIgnoreResearchStatus = stream->ReadValue<uint8_t>() != 0;
         gAllowEarlyCompletionInNetworkPlay = stream->ReadValue<uint8_t>() != 0;
 
+#    ifdef ENABLE_SCRIPTING
+        GetContext()->GetScriptEngine().GetReplicatedStorage().Read(*stream);
+#    else
+        // Revision, then the key and value of each entry
+        stream->ReadValue<uint32_t>();
+        auto numStorageEntries = stream->ReadValue<uint32_t>();
+        for (uint32_t i = 0; i < numStorageEntries * 2; i++)
+        {
+            stream->ReadStdString();
+        }
+#    endif
+
         gLastAutoSaveUpdate = AUTOSAVE_PAUSE;
         result = true;
     }
@@ -2776,35 +3746,7 @@ bool NetworkBase::SaveMap(IStream* stream, const std::vector<const ObjectReposit
         s6exporter->ExportObjectsList = objects;
         s6exporter->Export();
         s6exporter->SaveGame(stream);
-
-        // Write other data not in normal save files
-        stream->WriteValue<uint32_t>(gGamePaused);
-        stream->WriteValue<uint32_t>(_guestGenerationProbability);
-        stream->WriteValue<uint32_t>(_suggestedGuestMaximum);
-        stream->WriteValue<uint8_t>(gCheatsAllowTrackPlaceInvalidHeights);
-        stream->WriteValue<uint8_t>(gCheatsEnableAllDrawableTrackPieces);
-        stream->WriteValue<uint8_t>(gCheatsSandboxMode);
-        stream->WriteValue<uint8_t>(gCheatsDisableClearanceChecks);
-        stream->WriteValue<uint8_t>(gCheatsDisableSupportLimits);
-        stream->WriteValue<uint8_t>(gCheatsDisableTrainLengthLimit);
-        stream->WriteValue<uint8_t>(gCheatsEnableChainLiftOnAllTrack);
-        stream->WriteValue<uint8_t>(gCheatsShowAllOperatingModes);
-        stream->WriteValue<uint8_t>(gCheatsShowVehiclesFromOtherTrackTypes);
-        stream->WriteValue<uint8_t>(gCheatsFastLiftHill);
-        stream->WriteValue<uint8_t>(gCheatsDisableBrakesFailure);
-        stream->WriteValue<uint8_t>(gCheatsDisableAllBreakdowns);
-        stream->WriteValue<uint8_t>(gCheatsBuildInPauseMode);
-        stream->WriteValue<uint8_t>(gCheatsIgnoreRideIntensity);
-        stream->WriteValue<uint8_t>(gCheatsDisableVandalism);
-        stream->WriteValue<uint8_t>(gCheatsDisableLittering);
-        stream->WriteValue<uint8_t>(gCheatsNeverendingMarketing);
-        stream->WriteValue<uint8_t>(gCheatsFreezeWeather);
-        stream->WriteValue<uint8_t>(gCheatsDisablePlantAging);
-        stream->WriteValue<uint8_t>(gCheatsAllowArbitraryRideTypeChanges);
-        stream->WriteValue<uint8_t>(gCheatsDisableRideValueAging);
-        stream->WriteValue<uint8_t>(gConfigGeneral.show_real_names_of_guests);
-        stream->WriteValue<uint8_t>(gCheatsIgnoreResearchStatus);
-        stream->WriteValue<uint8_t>(gConfigGeneral.allow_early_completion);
+        WriteMapExtras(stream);
 
         result = true;
     }
@@ -2814,6 +3756,47 @@ bool NetworkBase::SaveMap(IStream* stream, const std::vector<const ObjectReposit
     return result;
 }
 
+/**
+ * Writes other data not in normal save files.
+ */
+void NetworkBase::WriteMapExtras(IStream* stream) const
+{
+    stream->WriteValue<uint32_t>(gGamePaused);
+    stream->WriteValue<uint32_t>(_guestGenerationProbability);
+    stream->WriteValue<uint32_t>(_suggestedGuestMaximum);
+    stream->WriteValue<uint8_t>(gCheatsAllowTrackPlaceInvalidHeights);
+    stream->WriteValue<uint8_t>(gCheatsEnableAllDrawableTrackPieces);
+    stream->WriteValue<uint8_t>(gCheatsSandboxMode);
+    stream->WriteValue<uint8_t>(gCheatsDisableClearanceChecks);
+    stream->WriteValue<uint8_t>(gCheatsDisableSupportLimits);
+    stream->WriteValue<uint8_t>(gCheatsDisableTrainLengthLimit);
+    stream->WriteValue<uint8_t>(gCheatsEnableChainLiftOnAllTrack);
+    stream->WriteValue<uint8_t>(gCheatsShowAllOperatingModes);
+    stream->WriteValue<uint8_t>(gCheatsShowVehiclesFromOtherTrackTypes);
+    stream->WriteValue<uint8_t>(gCheatsFastLiftHill);
+    stream->WriteValue<uint8_t>(gCheatsDisableBrakesFailure);
+    stream->WriteValue<uint8_t>(gCheatsDisableAllBreakdowns);
+    stream->WriteValue<uint8_t>(gCheatsBuildInPauseMode);
+    stream->WriteValue<uint8_t>(gCheatsIgnoreRideIntensity);
+    stream->WriteValue<uint8_t>(gCheatsDisableVandalism);
+    stream->WriteValue<uint8_t>(gCheatsDisableLittering);
+    stream->WriteValue<uint8_t>(gCheatsNeverendingMarketing);
+    stream->WriteValue<uint8_t>(gCheatsFreezeWeather);
+    stream->WriteValue<uint8_t>(gCheatsDisablePlantAging);
+    stream->WriteValue<uint8_t>(gCheatsAllowArbitraryRideTypeChanges);
+    stream->WriteValue<uint8_t>(gCheatsDisableRideValueAging);
+    stream->WriteValue<uint8_t>(gConfigGeneral.show_real_names_of_guests);
+    stream->WriteValue<uint8_t>(gCheatsIgnoreResearchStatus);
+    stream->WriteValue<uint8_t>(gConfigGeneral.allow_early_completion);
+
+#    ifdef ENABLE_SCRIPTING
+    GetContext()->GetScriptEngine().GetReplicatedStorage().Write(*stream);
+#    else
+    stream->WriteValue<uint32_t>(0);
+    stream->WriteValue<uint32_t>(0);
+#    endif
+}
+
 void NetworkBase::Client_Handle_CHAT([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
 {
     const char* text = packet.ReadString();
@@ -2895,11 +3878,39 @@ void NetworkBase::Client_Handle_GAME_ACTION([[maybe_unused]] NetworkConnection&
     GameCommand actionType;
     packet >> tick >> actionType;
 
-    MemoryStream stream;
     const size_t size = packet.Header.Size - packet.BytesRead;
-    stream.WriteArray(packet.Read(size), size);
-    stream.SetPosition(0);
+    Client_EnqueueGameAction(tick, actionType, packet.Read(size), size);
+}
+
+void NetworkBase::Client_Handle_GAME_ACTION_BATCH([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
+{
+    uint32_t tick;
+    packet >> tick;
+
+    while (packet.BytesRead < packet.Header.Size)
+    {
+        uint32_t actionType;
+        uint32_t size;
+        if (!packet.ReadVarInt(actionType) || !packet.ReadVarInt(size))
+        {
+            log_error("Received malformed game action batch for tick %u", tick);
+            return;
+        }
 
+        const uint8_t* data = packet.Read(size);
+        if (data == nullptr)
+        {
+            log_error("Received truncated game action batch for tick %u", tick);
+            return;
+        }
+        Client_EnqueueGameAction(tick, static_cast<GameCommand>(actionType), data, size);
+    }
+}
+
+void NetworkBase::Client_EnqueueGameAction(uint32_t tick, GameCommand actionType, const uint8_t* data, size_t size)
+{
+    // Read the action straight from the packet
+    MemoryStream stream(data, size);
     DataSerialiser ds(false, stream);
 
     GameAction::Ptr action = GameActions::Create(actionType);
@@ -2985,10 +3996,9 @@ void NetworkBase::Server_Handle_GAME_ACTION(NetworkConnection& connection, Netwo
         }
     }
 
-    DataSerialiser stream(false);
     const size_t size = packet.Header.Size - packet.BytesRead;
-    stream.GetStream().WriteArray(packet.Read(size), size);
-    stream.GetStream().SetPosition(0);
+    MemoryStream actionData(packet.Read(size), size);
+    DataSerialiser stream(false, actionData);
 
     ga->Serialise(stream);
     // Set player to sender, should be 0 if sent from client.
@@ -2999,6 +4009,10 @@ void NetworkBase::Server_Handle_GAME_ACTION(NetworkConnection& connection, Netwo
 
 void NetworkBase::Client_Handle_TICK([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
 {
+    // The ticks sent before the resume are sent again right after it, in order.
+    if (_resume)
+        return;
+
     uint32_t srand0;
     uint32_t flags;
     uint32_t serverTick;
@@ -3069,6 +4083,14 @@ void NetworkBase::Server_Handle_PING(NetworkConnection& connection, [[maybe_unus
     {
         ping = 0;
     }
+
+    size_t bucket = 0;
+    while (bucket < std::size(NetworkPingHistogramBounds) && static_cast<uint32_t>(ping) >= NetworkPingHistogramBounds[bucket])
+    {
+        bucket++;
+    }
+    connection.Stats.pingHistogram[bucket]++;
+
     if (connection.Player)
     {
         connection.Player->Ping = ping;
@@ -3103,6 +4125,9 @@ void NetworkBase::Client_Handle_SETDISCONNECTMSG(NetworkConnection& connection,
         msg = disconnectmsg;
         connection.SetLastDisconnectReason(msg.c_str());
     }
+
+    // The server ended the session on purpose, it is not resumed.
+    _serverSessionId = 0;
 }
 
 void NetworkBase::Server_Handle_GAMEINFO(NetworkConnection& connection, [[maybe_unused]] NetworkPacket& packet)
@@ -3241,6 +4266,11 @@ void network_flush()
     gNetwork.Flush();
 }
 
+bool network_wait_for_events(uint32_t timeoutMs)
+{
+    return gNetwork.WaitForEvents(timeoutMs);
+}
+
 int32_t network_get_mode()
 {
     return gNetwork.GetMode();
@@ -3256,6 +4286,11 @@ bool network_is_desynchronised()
     return gNetwork.IsDesynchronised();
 }
 
+bool network_is_resuming()
+{
+    return gNetwork.IsResuming();
+}
+
 bool network_check_desynchronisation()
 {
     return gNetwork.CheckDesynchronizaton();
@@ -3862,24 +4897,7 @@ void network_send_password(const std::string& password)
         log_error("Private key %s missing! Restart the game to generate it.", keyPath);
         return;
     }
-    try
-    {
-        auto fs = FileStream(keyPath, FILE_MODE_OPEN);
-        gNetwork._key.LoadPrivate(&fs);
-    }
-    catch (const std::exception&)
-    {
-        log_error("Error reading private key from %s.", keyPath);
-        return;
-    }
-    const std::string pubkey = gNetwork._key.PublicKeyString();
-
-    std::vector<uint8_t> signature;
-    gNetwork._key.Sign(gNetwork._challenge.data(), gNetwork._challenge.size(), signature);
-    // Don't keep private key in memory. There's no need and it may get leaked
-    // when process dump gets collected at some point in future.
-    gNetwork._key.Unload();
-    gNetwork.Client_Send_AUTH(gConfigNetwork.player_name.c_str(), password, pubkey.c_str(), signature);
+    gNetwork.Client_BeginAuth(password);
 }
 
 void network_set_password(const char* password)
@@ -3967,6 +4985,11 @@ json_t network_get_server_info_as_json()
 {
     return gNetwork.GetServerInfoAsJson();
 }
+
+json_t network_get_telemetry_as_json()
+{
+    return gNetwork.GetTelemetryAsJson();
+}
 #else
 int32_t network_get_mode()
 {
@@ -3987,6 +5010,10 @@ uint32_t network_get_server_tick()
 void network_flush()
 {
 }
+bool network_wait_for_events(uint32_t timeoutMs)
+{
+    return false;
+}
 void network_send_tick()
 {
 }
@@ -3994,6 +5021,10 @@ bool network_is_desynchronised()
 {
     return false;
 }
+bool network_is_resuming()
+{
+    return false;
+}
 bool network_gamestate_snapshots_enabled()
 {
     return false;
@@ -4232,4 +5263,8 @@ json_t network_get_server_info_as_json()
 {
     return {};
 }
+json_t network_get_telemetry_as_json()
+{
+    return {};
+}
 #endif /* DISABLE_NETWORK */
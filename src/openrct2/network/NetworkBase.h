@@ -8,7 +8,9 @@
 #include "NetworkTypes.h"
 #include "NetworkUser.h"
 
+#include <deque>
 #include <fstream>
+#include <optional>
 
 #ifndef DISABLE_NETWORK
 
@@ -28,6 +30,7 @@ public: // Common
     uint32_t GetServerTick();
     void Update();
     void Flush();
+    bool WaitForEvents(uint32_t timeoutMs);
     void ProcessPending();
     void ProcessPlayerList();
     std::vector<std::unique_ptr<NetworkPlayer>>::iterator GetPlayerIteratorByID(uint8_t id);
@@ -43,7 +46,9 @@ public: // Common
     void CloseChatLog();
     NetworkStats_t GetStats() const;
     json_t GetServerInfoAsJson() const;
-    bool ProcessConnection(NetworkConnection& connection);
+    size_t GetMemoryUsage() const;
+    json_t GetTelemetryAsJson() const;
+    bool ProcessConnection(NetworkConnection& connection, bool readable = true);
     void CloseConnection();
     NetworkPlayer* AddPlayer(const std::string& name, const std::string& keyhash);
     void ProcessPacket(NetworkConnection& connection, NetworkPacket& packet);
@@ -67,17 +72,31 @@ public: // Server
     void SetupDefaultGroups();
     void RemovePlayer(std::unique_ptr<NetworkConnection>& connection);
     void UpdateServer();
+    void LogServerTelemetry();
+    void PollServerSockets(int32_t timeoutMs);
+    void UpdateWriteInterest(NetworkConnection& connection);
+    bool IsClientTooSlow(const NetworkConnection& connection) const;
     void ServerClientDisconnected(std::unique_ptr<NetworkConnection>& connection);
     bool SaveMap(OpenRCT2::IStream* stream, const std::vector<const ObjectRepositoryItem*>& objects) const;
+    void WriteMapExtras(OpenRCT2::IStream* stream) const;
     std::vector<uint8_t> save_for_network(const std::vector<const ObjectRepositoryItem*>& objects) const;
+    static std::vector<uint8_t> CompressMapForNetwork(const void* data, size_t size);
+    void BeginMapTransfer(NetworkConnection& connection, const std::vector<const ObjectRepositoryItem*>& objects);
+    void UpdateMapTransfer(NetworkConnection& connection);
+    void UpdatePendingAuth(NetworkConnection& connection);
+    void PrepareObjectBundles(const std::vector<const ObjectRepositoryItem*>& objects);
     std::string MakePlayerNameUnique(const std::string& name);
+    void ResetResumeWindow();
 
     // Packet dispatchers.
     void Server_Send_AUTH(NetworkConnection& connection);
     void Server_Send_TOKEN(NetworkConnection& connection);
     void Server_Send_MAP(NetworkConnection* connection = nullptr);
+    void Server_Send_RESUME(NetworkConnection& connection, uint32_t tick);
     void Server_Send_CHAT(const char* text, const std::vector<uint8_t>& playerIds = {});
     void Server_Send_GAME_ACTION(const GameAction* action);
+    void Server_Send_GAME_ACTION_BATCH();
+    void Server_Send_PLUGIN_STORAGE();
     void Server_Send_TICK();
     void Server_Send_PLAYERINFO(int32_t playerId);
     void Server_Send_PLAYERLIST();
@@ -96,6 +115,8 @@ public: // Server
     void Server_Handle_REQUEST_GAMESTATE(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Handle_HEARTBEAT(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Handle_AUTH(NetworkConnection& connection, NetworkPacket& packet);
+    void Server_Complete_AUTH(
+        NetworkConnection& connection, const NetworkAuthRequest& request, const NetworkAuthVerification& verification);
     void Server_Client_Joined(const char* name, const std::string& keyhash, NetworkConnection& connection);
     void Server_Handle_CHAT(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Handle_GAME_ACTION(NetworkConnection& connection, NetworkPacket& packet);
@@ -118,6 +139,7 @@ public: // Client
     bool CheckDesynchronizaton();
     void RequestStateSnapshot();
     bool IsDesynchronised();
+    bool IsResuming() const;
     NetworkServerState_t GetServerState() const;
     void ServerClientDisconnected();
     bool LoadMap(OpenRCT2::IStream* stream);
@@ -128,6 +150,8 @@ public: // Client
     void Client_Send_TOKEN();
     void Client_Send_AUTH(
         const std::string& name, const std::string& password, const std::string& pubkey, const std::vector<uint8_t>& signature);
+    void Client_BeginAuth(const std::string& password);
+    void Client_UpdateAuth();
     void Client_Send_CHAT(const char* text);
     void Client_Send_GAME_ACTION(const GameAction* action);
     void Client_Send_PING();
@@ -138,8 +162,12 @@ public: // Client
     // Handlers.
     void Client_Handle_AUTH(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_MAP(NetworkConnection& connection, NetworkPacket& packet);
+    void Client_Handle_RESUME(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_CHAT(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_GAME_ACTION(NetworkConnection& connection, NetworkPacket& packet);
+    void Client_Handle_GAME_ACTION_BATCH(NetworkConnection& connection, NetworkPacket& packet);
+    void Client_EnqueueGameAction(uint32_t tick, GameCommand actionType, const uint8_t* data, size_t size);
+    void Client_Handle_OBJECT_BUNDLE(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_TICK(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_PLAYERINFO(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_PLAYERLIST(NetworkConnection& connection, NetworkPacket& packet);
@@ -153,9 +181,12 @@ public: // Client
     void Client_Handle_TOKEN(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_OBJECTS_LIST(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_SCRIPTS(NetworkConnection& connection, NetworkPacket& packet);
+    void Client_Handle_PLUGIN_STORAGE(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_GAMESTATE(NetworkConnection& connection, NetworkPacket& packet);
 
     std::vector<uint8_t> _challenge;
+    std::future<NetworkAuthSignature> _authSignature;
+    std::string _authPassword;
     std::map<uint32_t, GameAction::Callback_t> _gameActionCallbacks;
     NetworkKey _key;
     NetworkUserManager _userManager;
@@ -175,6 +206,7 @@ private: // Common Data
 
     std::shared_ptr<OpenRCT2::IPlatformEnvironment> _env;
     std::vector<uint8_t> chunk_buffer;
+    std::vector<uint8_t> _objectBundleBuffer;
     std::ofstream _chat_log_fs;
     uint32_t _lastUpdateTime = 0;
     uint32_t _currentDeltaTime = 0;
@@ -187,6 +219,32 @@ private: // Common Data
 private: // Server Data
     std::unordered_map<NetworkCommand, CommandHandler> server_command_handlers;
     std::unique_ptr<ITcpSocket> _listenSocket;
+    std::unique_ptr<ISocketPoller> _socketPoller;
+
+    // The last map sent to a joining client, reused for clients that join shortly after.
+    struct MapCache
+    {
+        uint32_t Tick = 0;
+        std::shared_future<std::vector<uint8_t>> Data;
+
+        // Ticks and game actions sent since the map was saved, replayed to bring new clients up to date.
+        std::vector<std::shared_ptr<const NetworkPacketBuffer>> GameCommands;
+    };
+    std::unique_ptr<MapCache> _mapCache;
+
+    // Ticks and game actions sent during the last NETWORK_RESUME_TICKS along with the tick they were sent on, for
+    // clients that lost their connection to catch up with instead of loading the map again. Changes with the park.
+    std::deque<std::pair<uint32_t, std::shared_ptr<const NetworkPacketBuffer>>> _resumeGameCommands;
+    uint32_t _resumeWindowStart = 0;
+    uint32_t _sessionId = 0;
+
+    // Custom objects packed for joining clients, keyed by name and checksum. Each object is only packed once.
+    std::unordered_map<std::string, std::shared_ptr<const NetworkObjectBundle>> _objectBundles;
+
+    // Game actions relayed to the clients are sent in one packet per tick.
+    NetworkPacket _gameActionBatch;
+    uint32_t _gameActionBatchTick = 0;
+    bool _listenSocketReadable = false;
     std::unique_ptr<INetworkServerAdvertiser> _advertiser;
     std::list<std::unique_ptr<NetworkConnection>> client_connection_list;
     std::string _serverLogPath;
@@ -208,6 +266,13 @@ private: // Client Data
         std::string spriteHash;
     };
 
+    // Where the client left off when its connection was lost, the park is held there until the server sends what was missed.
+    struct ResumeState
+    {
+        uint32_t SessionId;
+        uint32_t Tick;
+    };
+
     std::unordered_map<NetworkCommand, CommandHandler> client_command_handlers;
     std::unique_ptr<NetworkConnection> _serverConnection;
     std::map<uint32_t, PlayerListUpdate> _pendingPlayerLists;
@@ -220,8 +285,14 @@ private: // Client Data
     std::string _password;
     OpenRCT2::MemoryStream _serverGameState;
     NetworkServerState_t _serverState;
+    uint32_t _serverSessionId = 0;
+    std::optional<ResumeState> _resumeRequest;
+    std::optional<ResumeState> _resume;
     uint32_t _lastSentHeartbeat = 0;
     uint32_t last_ping_sent_time = 0;
+    uint32_t _lastTelemetryLogTime = 0;
+    NetworkStats_t _lastTelemetryLogStats = {};
+    uint32_t _slowClientsDisconnected = 0;
     uint32_t server_connect_time = 0;
     uint32_t _actionId;
     int32_t status = NETWORK_STATUS_NONE;
@@ -89,7 +89,7 @@ NetworkReadPacket NetworkConnection::ReadPacket()
             // Received complete packet.
             _lastPacketTime = platform_get_ticks();
 
-            RecordPacketStats(InboundPacket, false);
+            RecordPacketStats(InboundPacket.GetCommand(), InboundPacket.BytesTransferred, false);
 
             return NetworkReadPacket::Success;
         }
@@ -98,69 +98,185 @@ NetworkReadPacket NetworkConnection::ReadPacket()
     return NetworkReadPacket::MoreData;
 }
 
-bool NetworkConnection::SendPacket(NetworkPacket& packet)
+void NetworkConnection::QueuePacket(const NetworkPacket& packet, bool front)
 {
-    auto header = packet.Header;
+    if (AuthStatus == NetworkAuth::Ok || !packet.CommandRequiresAuth())
+    {
+        QueuePacket(NetworkPacketBuffer::Create(packet), front);
+    }
+}
 
-    std::vector<uint8_t> buffer;
-    buffer.reserve(sizeof(header) + header.Size);
+void NetworkConnection::QueuePacket(std::shared_ptr<const NetworkPacketBuffer> buffer, bool front)
+{
+    if (AuthStatus == NetworkAuth::Ok || !buffer->RequiresAuth)
+    {
+        if (SendQueueLimit != 0 && GetQueuedByteCount() >= SendQueueLimit && CoalescePacket(buffer))
+        {
+            return;
+        }
 
-    // NOTE: For compatibility reasons for the master server we need to add sizeof(Header.Id) to the size.
-    // Previously the Id field was not part of the header rather part of the body.
-    header.Size += sizeof(header.Id);
-    header.Size = Convert::HostToNetwork(header.Size);
-    header.Id = ByteSwapBE(header.Id);
+        if (MapTransfer != nullptr)
+        {
+            _queuedBytes += buffer->Bytes.size();
+            if (front)
+                _heldPackets.push_front(std::move(buffer));
+            else
+                _heldPackets.push_back(std::move(buffer));
+            return;
+        }
+        EnqueuePacket(std::move(buffer), front);
+    }
+}
 
-    buffer.insert(buffer.end(), reinterpret_cast<uint8_t*>(&header), reinterpret_cast<uint8_t*>(&header) + sizeof(header));
-    buffer.insert(buffer.end(), packet.Data.begin(), packet.Data.end());
+void NetworkConnection::QueueMapChunk(const NetworkPacket& packet)
+{
+    EnqueuePacket(NetworkPacketBuffer::Create(packet), false);
+}
 
-    size_t bufferSize = buffer.size() - packet.BytesTransferred;
-    size_t sent = Socket->SendData(buffer.data() + packet.BytesTransferred, bufferSize);
-    if (sent > 0)
+void NetworkConnection::EndMapTransfer()
+{
+    MapTransfer.reset();
+    for (auto& buffer : _heldPackets)
     {
-        packet.BytesTransferred += sent;
+        _queuedBytes -= buffer->Bytes.size();
+        EnqueuePacket(std::move(buffer), false);
     }
+    _heldPackets.clear();
+}
 
-    bool sendComplete = packet.BytesTransferred == buffer.size();
-    if (sendComplete)
+/**
+ * Replaces the newest queued packet of the same kind if it only carries state that the new packet supersedes.
+ */
+bool NetworkConnection::CoalescePacket(const std::shared_ptr<const NetworkPacketBuffer>& buffer)
+{
+    switch (buffer->Command)
     {
-        RecordPacketStats(packet, true);
+        case NetworkCommand::Ping:
+        case NetworkCommand::PingList:
+        case NetworkCommand::PlayerList:
+            break;
+        default:
+            return false;
+    }
+
+    auto& queue = MapTransfer != nullptr ? _heldPackets : _outboundPackets;
+    for (auto it = queue.rbegin(); it != queue.rend(); it++)
+    {
+        // The partially sent packet can not be replaced.
+        if (&queue == &_outboundPackets && it == std::prev(queue.rend()) && _outboundBytesTransferred > 0)
+            break;
+
+        if ((*it)->Command == buffer->Command)
+        {
+            _queuedBytes = _queuedBytes - (*it)->Bytes.size() + buffer->Bytes.size();
+            *it = buffer;
+            Stats.packetsCoalesced++;
+            return true;
+        }
     }
-    return sendComplete;
+    return false;
 }
 
-void NetworkConnection::QueuePacket(NetworkPacket&& packet, bool front)
+void NetworkConnection::EnqueuePacket(std::shared_ptr<const NetworkPacketBuffer> buffer, bool front)
 {
-    if (AuthStatus == NetworkAuth::Ok || !packet.CommandRequiresAuth())
+    _queuedBytes += buffer->Bytes.size();
+    if (front)
     {
-        packet.Header.Size = static_cast<uint16_t>(packet.Data.size());
-        if (front)
+        // If the first packet was already partially sent add new packet to second position
+        if (!_outboundPackets.empty() && _outboundBytesTransferred > 0)
         {
-            // If the first packet was already partially sent add new packet to second position
-            if (!_outboundPackets.empty() && _outboundPackets.front().BytesTransferred > 0)
-            {
-                auto it = _outboundPackets.begin();
-                it++; // Second position
-                _outboundPackets.insert(it, std::move(packet));
-            }
-            else
-            {
-                _outboundPackets.push_front(std::move(packet));
-            }
+            auto it = _outboundPackets.begin();
+            it++; // Second position
+            _outboundPackets.insert(it, std::move(buffer));
         }
         else
         {
-            _outboundPackets.push_back(std::move(packet));
+            _outboundPackets.push_front(std::move(buffer));
         }
     }
+    else
+    {
+        _outboundPackets.push_back(std::move(buffer));
+    }
 }
 
 void NetworkConnection::SendQueuedPackets()
 {
-    while (!_outboundPackets.empty() && SendPacket(_outboundPackets.front()))
+    // Hand as many queued packets as possible to the socket in a single call.
+    constexpr size_t MaxPacketsPerSend = 64;
+    SocketBuffer buffers[MaxPacketsPerSend];
+
+    while (!_outboundPackets.empty())
+    {
+        size_t numBuffers = 0;
+        size_t totalSize = 0;
+        for (const auto& packet : _outboundPackets)
+        {
+            if (numBuffers == MaxPacketsPerSend)
+                break;
+
+            const size_t skip = numBuffers == 0 ? _outboundBytesTransferred : 0;
+            buffers[numBuffers] = { packet->Bytes.data() + skip, packet->Bytes.size() - skip };
+            totalSize += buffers[numBuffers].Size;
+            numBuffers++;
+        }
+
+        const size_t totalSent = Socket->SendData(buffers, numBuffers);
+        size_t sent = totalSent;
+        while (sent > 0)
+        {
+            const auto& packet = *_outboundPackets.front();
+            const size_t remaining = packet.Bytes.size() - _outboundBytesTransferred;
+            if (sent < remaining)
+            {
+                _outboundBytesTransferred += sent;
+                break;
+            }
+
+            sent -= remaining;
+            RecordPacketStats(packet.Command, packet.Bytes.size(), true);
+            _queuedBytes -= packet.Bytes.size();
+            _outboundPackets.pop_front();
+            _outboundBytesTransferred = 0;
+        }
+
+        if (totalSent < totalSize)
+        {
+            // Socket would block, try again next time.
+            break;
+        }
+    }
+}
+
+/**
+ * Returns the tick of the oldest tick packet the client has not received yet.
+ */
+std::optional<uint32_t> NetworkConnection::GetOldestQueuedTick() const
+{
+    for (const auto* queue : { &_outboundPackets, &_heldPackets })
     {
-        _outboundPackets.pop_front();
+        for (const auto& packet : *queue)
+        {
+            if (packet->Command == NetworkCommand::Tick)
+                return packet->Tick;
+        }
     }
+    return std::nullopt;
+}
+
+/**
+ * Bytes held for this connection. Packets broadcast to several clients share one buffer, which is counted for
+ * each connection it waits on.
+ */
+size_t NetworkConnection::GetMemoryUsage() const
+{
+    size_t result = sizeof(NetworkConnection) + _queuedBytes + InboundPacket.Data.capacity();
+    if (MapTransfer != nullptr && MapTransfer->Data.valid()
+        && MapTransfer->Data.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+    {
+        result += MapTransfer->Data.get().capacity();
+    }
+    return result;
 }
 
 void NetworkConnection::ResetLastPacketTime()
@@ -207,17 +323,19 @@ void NetworkConnection::SetLastDisconnectReason(const rct_string_id string_id, v
     SetLastDisconnectReason(buffer);
 }
 
-void NetworkConnection::RecordPacketStats(const NetworkPacket& packet, bool sending)
+void NetworkConnection::RecordPacketStats(NetworkCommand command, size_t size, bool sending)
 {
-    uint32_t packetSize = static_cast<uint32_t>(packet.BytesTransferred);
+    uint32_t packetSize = static_cast<uint32_t>(size);
     NetworkStatisticsGroup trafficGroup;
 
-    switch (packet.GetCommand())
+    switch (command)
     {
         case NetworkCommand::GameAction:
+        case NetworkCommand::GameActionBatch:
             trafficGroup = NetworkStatisticsGroup::Commands;
             break;
         case NetworkCommand::Map:
+        case NetworkCommand::ObjectBundle:
             trafficGroup = NetworkStatisticsGroup::MapData;
             break;
         default:
@@ -225,15 +343,31 @@ void NetworkConnection::RecordPacketStats(const NetworkPacket& packet, bool send
             break;
     }
 
+    NetworkCommandStats_t* commandStats = nullptr;
+    if (EnumValue(command) < EnumValue(NetworkCommand::Max))
+    {
+        commandStats = &Stats.commands[EnumValue(command)];
+    }
+
     if (sending)
     {
         Stats.bytesSent[EnumValue(trafficGroup)] += packetSize;
         Stats.bytesSent[EnumValue(NetworkStatisticsGroup::Total)] += packetSize;
+        if (commandStats != nullptr)
+        {
+            commandStats->packetsSent++;
+            commandStats->bytesSent += packetSize;
+        }
     }
     else
     {
         Stats.bytesReceived[EnumValue(trafficGroup)] += packetSize;
         Stats.bytesReceived[EnumValue(NetworkStatisticsGroup::Total)] += packetSize;
+        if (commandStats != nullptr)
+        {
+            commandStats->packetsReceived++;
+            commandStats->bytesReceived += packetSize;
+        }
     }
 }
 
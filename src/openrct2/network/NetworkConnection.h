@@ -16,13 +16,70 @@
 #    include "NetworkTypes.h"
 #    include "Socket.h"
 
+#    include <array>
 #    include <deque>
+#    include <future>
 #    include <memory>
+#    include <optional>
+#    include <string>
 #    include <vector>
 
 class NetworkPlayer;
 struct ObjectRepositoryItem;
 
+/**
+ * Packed custom object as sent to joining clients, identified by the SHA-1 of the packed data.
+ */
+struct NetworkObjectBundle
+{
+    std::array<uint8_t, 20> Hash;
+    std::vector<uint8_t> Data;
+};
+
+/**
+ * A map that is being saved on a worker thread or streamed to the client in chunks.
+ */
+struct NetworkMapTransfer
+{
+    // Objects the client is missing, streamed ahead of the map.
+    std::vector<std::shared_ptr<const NetworkObjectBundle>> Objects;
+    size_t ObjectIndex = 0;
+    size_t ObjectBytesQueued = 0;
+
+    std::shared_future<std::vector<uint8_t>> Data;
+    size_t BytesQueued = 0;
+};
+
+/**
+ * The outcome of checking a client's signature of the challenge on a worker thread.
+ */
+struct NetworkAuthVerification
+{
+    bool Verified = false;
+    std::string PublicKeyHash;
+};
+
+/**
+ * An authentication request from a client, kept until its signature has been verified.
+ */
+struct NetworkAuthRequest
+{
+    std::optional<std::string> GameVersion;
+    std::optional<std::string> Name;
+    std::optional<std::string> Password;
+    std::future<NetworkAuthVerification> Verification;
+};
+
+/**
+ * The server's challenge signed with the player's private key on a worker thread.
+ */
+struct NetworkAuthSignature
+{
+    bool Ok = false;
+    std::string PublicKey;
+    std::vector<uint8_t> Signature;
+};
+
 class NetworkConnection final
 {
 public:
@@ -32,23 +89,45 @@ public:
     NetworkStats_t Stats = {};
     NetworkPlayer* Player = nullptr;
     uint32_t PingTime = 0;
-    NetworkKey Key;
     std::vector<uint8_t> Challenge;
     std::vector<const ObjectRepositoryItem*> RequestedObjects;
     bool IsDisconnected = false;
+    bool IsReadable = false;
+    bool HasWriteInterest = false;
+
+    // Once this many bytes are queued, ping and player list updates replace older queued ones. 0 for no limit.
+    size_t SendQueueLimit = 0;
+
+    // While set, all other packets are held back as the client can only handle them after loading the map.
+    std::unique_ptr<NetworkMapTransfer> MapTransfer;
+
+    // While set, the signature of the client is being verified and further Auth packets are ignored.
+    std::unique_ptr<NetworkAuthRequest> PendingAuth;
 
     NetworkConnection();
     ~NetworkConnection();
 
     NetworkReadPacket ReadPacket();
-    void QueuePacket(NetworkPacket&& packet, bool front = false);
-    void QueuePacket(const NetworkPacket& packet, bool front = false)
+    void QueuePacket(const NetworkPacket& packet, bool front = false);
+    void QueuePacket(std::shared_ptr<const NetworkPacketBuffer> buffer, bool front = false);
+    void QueueMapChunk(const NetworkPacket& packet);
+    void EndMapTransfer();
+    size_t GetQueuedPacketCount() const
+    {
+        return _outboundPackets.size();
+    }
+    size_t GetQueuedByteCount() const
     {
-        auto copy = packet;
-        return QueuePacket(std::move(copy), front);
+        return _queuedBytes - _outboundBytesTransferred;
     }
+    std::optional<uint32_t> GetOldestQueuedTick() const;
+    size_t GetMemoryUsage() const;
 
     void SendQueuedPackets();
+    bool HasQueuedPackets() const
+    {
+        return !_outboundPackets.empty();
+    }
     void ResetLastPacketTime();
     bool ReceivedPacketRecently();
 
@@ -57,12 +136,16 @@ public:
     void SetLastDisconnectReason(const rct_string_id string_id, void* args = nullptr);
 
 private:
-    std::deque<NetworkPacket> _outboundPackets;
+    std::deque<std::shared_ptr<const NetworkPacketBuffer>> _outboundPackets;
+    size_t _outboundBytesTransferred = 0; // Of the first outbound packet.
+    std::deque<std::shared_ptr<const NetworkPacketBuffer>> _heldPackets;
+    size_t _queuedBytes = 0; // Of both the outbound and the held packets.
     uint32_t _lastPacketTime = 0;
     utf8* _lastDisconnectReason = nullptr;
 
-    void RecordPacketStats(const NetworkPacket& packet, bool sending);
-    bool SendPacket(NetworkPacket& packet);
+    void RecordPacketStats(NetworkCommand command, size_t size, bool sending);
+    void EnqueuePacket(std::shared_ptr<const NetworkPacketBuffer> buffer, bool front);
+    bool CoalescePacket(const std::shared_ptr<const NetworkPacketBuffer>& buffer);
 };
 
 #endif // DISABLE_NETWORK
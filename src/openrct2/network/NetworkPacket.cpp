@@ -12,7 +12,9 @@
 #    include "NetworkPacket.h"
 
 #    include "NetworkTypes.h"
+#    include "Socket.h"
 
+#    include <cstring>
 #    include <memory>
 
 NetworkPacket::NetworkPacket(NetworkCommand id)
@@ -42,7 +44,7 @@ void NetworkPacket::Clear()
     Data.clear();
 }
 
-bool NetworkPacket::CommandRequiresAuth()
+bool NetworkPacket::CommandRequiresAuth() const
 {
     switch (GetCommand())
     {
@@ -71,6 +73,21 @@ void NetworkPacket::WriteString(const utf8* string)
     Write(reinterpret_cast<const uint8_t*>(string), strlen(string) + 1);
 }
 
+/**
+ * Writes the value in 7 bit groups, least significant first, the high bit is set on all but the last byte.
+ */
+void NetworkPacket::WriteVarInt(uint32_t value)
+{
+    while (value >= 0x80)
+    {
+        const uint8_t byte = static_cast<uint8_t>(value | 0x80);
+        Write(&byte, sizeof(byte));
+        value >>= 7;
+    }
+    const uint8_t byte = static_cast<uint8_t>(value);
+    Write(&byte, sizeof(byte));
+}
+
 const uint8_t* NetworkPacket::Read(size_t size)
 {
     if (BytesRead + size > Header.Size)
@@ -85,6 +102,22 @@ const uint8_t* NetworkPacket::Read(size_t size)
     }
 }
 
+bool NetworkPacket::ReadVarInt(uint32_t& value)
+{
+    value = 0;
+    for (uint32_t shift = 0; shift < 32; shift += 7)
+    {
+        const uint8_t* byte = Read(1);
+        if (byte == nullptr)
+            return false;
+
+        value |= static_cast<uint32_t>(*byte & 0x7F) << shift;
+        if ((*byte & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
 const utf8* NetworkPacket::ReadString()
 {
     char* str = reinterpret_cast<char*>(&GetData()[BytesRead]);
@@ -102,4 +135,30 @@ const utf8* NetworkPacket::ReadString()
     return str;
 }
 
+std::shared_ptr<const NetworkPacketBuffer> NetworkPacketBuffer::Create(const NetworkPacket& packet)
+{
+    auto buffer = std::make_shared<NetworkPacketBuffer>();
+    buffer->Command = packet.GetCommand();
+    buffer->RequiresAuth = packet.CommandRequiresAuth();
+    if (buffer->Command == NetworkCommand::Tick && packet.Data.size() >= sizeof(uint32_t))
+    {
+        uint32_t tick;
+        std::memcpy(&tick, packet.Data.data(), sizeof(tick));
+        buffer->Tick = ByteSwapBE(tick);
+    }
+
+    PacketHeader header = packet.Header;
+    // NOTE: For compatibility reasons for the master server we need to add sizeof(Header.Id) to the size.
+    // Previously the Id field was not part of the header rather part of the body.
+    header.Size = static_cast<uint16_t>(packet.Data.size() + sizeof(header.Id));
+    header.Size = Convert::HostToNetwork(header.Size);
+    header.Id = ByteSwapBE(header.Id);
+
+    auto& bytes = buffer->Bytes;
+    bytes.reserve(sizeof(header) + packet.Data.size());
+    bytes.insert(bytes.end(), reinterpret_cast<uint8_t*>(&header), reinterpret_cast<uint8_t*>(&header) + sizeof(header));
+    bytes.insert(bytes.end(), packet.Data.begin(), packet.Data.end());
+    return buffer;
+}
+
 #endif
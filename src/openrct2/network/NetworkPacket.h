@@ -36,13 +36,15 @@ struct NetworkPacket final
     NetworkCommand GetCommand() const;
 
     void Clear();
-    bool CommandRequiresAuth();
+    bool CommandRequiresAuth() const;
 
     const uint8_t* Read(size_t size);
     const utf8* ReadString();
+    bool ReadVarInt(uint32_t& value);
 
     void Write(const void* bytes, size_t size);
     void WriteString(const utf8* string);
+    void WriteVarInt(uint32_t value);
 
     template<typename T> NetworkPacket& operator>>(T& value)
     {
@@ -79,3 +81,17 @@ public:
     size_t BytesTransferred = 0;
     size_t BytesRead = 0;
 };
+
+/**
+ * Immutable copy of a packet in the form it is sent over the wire, header included. Connections
+ * queue a reference to it so a packet broadcast to all clients is only serialised once.
+ */
+struct NetworkPacketBuffer final
+{
+    NetworkCommand Command = NetworkCommand::Invalid;
+    bool RequiresAuth = true;
+    uint32_t Tick = 0; // Only for tick packets.
+    std::vector<uint8_t> Bytes;
+
+    static std::shared_ptr<const NetworkPacketBuffer> Create(const NetworkPacket& packet);
+};
@@ -14,6 +14,8 @@
 #include "../ride/RideTypes.h"
 #include "../util/Util.h"
 
+#include <iterator>
+
 enum
 {
     SERVER_EVENT_PLAYER_JOINED,
@@ -83,6 +85,10 @@ enum class NetworkCommand : uint32_t
     GameState,
     Scripts,
     Heartbeat,
+    GameActionBatch,
+    ObjectBundle,
+    PluginStorage,
+    Resume,
     Max,
     Invalid = static_cast<uint32_t>(-1),
 };
@@ -141,8 +147,24 @@ enum class NetworkStatisticsGroup : uint32_t
     Max,
 };
 
+// Upper bounds in milliseconds of the ping histogram buckets, the last bucket holds everything above.
+constexpr uint32_t NetworkPingHistogramBounds[] = { 25, 50, 100, 200, 400, 800, 1600 };
+constexpr size_t NetworkPingHistogramSize = std::size(NetworkPingHistogramBounds) + 1;
+
+struct NetworkCommandStats_t
+{
+    uint64_t packetsReceived;
+    uint64_t bytesReceived;
+    uint64_t packetsSent;
+    uint64_t bytesSent;
+    uint64_t processTimeUs; // Time spent handling received packets.
+};
+
 struct NetworkStats_t
 {
     uint64_t bytesReceived[EnumValue(NetworkStatisticsGroup::Max)];
     uint64_t bytesSent[EnumValue(NetworkStatisticsGroup::Max)];
+    NetworkCommandStats_t commands[EnumValue(NetworkCommand::Max)];
+    uint32_t pingHistogram[NetworkPingHistogramSize];
+    uint64_t packetsCoalesced; // Replaced by a newer packet of the same kind while the send queue was full.
 };
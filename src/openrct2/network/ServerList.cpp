@@ -14,6 +14,7 @@
 #    include "../Context.h"
 #    include "../PlatformEnvironment.h"
 #    include "../config/Config.h"
+#    include "../core/File.h"
 #    include "../core/FileStream.h"
 #    include "../core/Guard.hpp"
 #    include "../core/Http.h"
@@ -156,6 +157,15 @@ void ServerList::Clear()
     _serverEntries.clear();
 }
 
+void ServerList::RemoveOnlineServers()
+{
+    _serverEntries.erase(
+        std::remove_if(
+            _serverEntries.begin(), _serverEntries.end(),
+            [](const ServerListEntry& entry) { return !entry.Favourite && !entry.Local; }),
+        _serverEntries.end());
+}
+
 std::vector<ServerListEntry> ServerList::ReadFavourites() const
 {
     log_verbose("server_list_read(...)");
@@ -326,6 +336,47 @@ std::future<std::vector<ServerListEntry>> ServerList::FetchLocalServerListAsync(
     });
 }
 
+static std::vector<ServerListEntry> ParseOnlineServerList(const std::string& body)
+{
+    auto root = Json::FromString(body);
+    if (!root.is_object())
+    {
+        throw MasterServerException(STR_SERVER_LIST_NO_CONNECTION);
+    }
+
+    auto jsonStatus = root["status"];
+    if (!jsonStatus.is_number_integer())
+    {
+        throw MasterServerException(STR_SERVER_LIST_INVALID_RESPONSE_JSON_NUMBER);
+    }
+
+    auto status = Json::GetNumber<int32_t>(jsonStatus);
+    if (status != 200)
+    {
+        throw MasterServerException(STR_SERVER_LIST_MASTER_SERVER_FAILED);
+    }
+
+    auto jServers = root["servers"];
+    if (!jServers.is_array())
+    {
+        throw MasterServerException(STR_SERVER_LIST_INVALID_RESPONSE_JSON_ARRAY);
+    }
+
+    std::vector<ServerListEntry> entries;
+    for (auto& jServer : jServers)
+    {
+        if (jServer.is_object())
+        {
+            auto entry = ServerListEntry::FromJson(jServer);
+            if (entry.has_value())
+            {
+                entries.push_back(std::move(*entry));
+            }
+        }
+    }
+    return entries;
+}
+
 std::future<std::vector<ServerListEntry>> ServerList::FetchOnlineServerListAsync() const
 {
 #    ifdef DISABLE_HTTP
@@ -345,8 +396,8 @@ std::future<std::vector<ServerListEntry>> ServerList::FetchOnlineServerListAsync
     request.url = masterServerUrl;
     request.method = Http::Method::GET;
     request.header["Accept"] = "application/json";
-    Http::DoAsync(request, [p](Http::Response& response) -> void {
-        json_t root;
+    auto cachePath = GetContext()->GetPlatformEnvironment()->GetFilePath(PATHID::CACHE_SERVER_LIST);
+    Http::DoAsync(request, [p, cachePath](Http::Response& response) -> void {
         try
         {
             if (response.status != Http::Status::Ok)
@@ -354,42 +405,16 @@ std::future<std::vector<ServerListEntry>> ServerList::FetchOnlineServerListAsync
                 throw MasterServerException(STR_SERVER_LIST_NO_CONNECTION);
             }
 
-            root = Json::FromString(response.body);
-            if (root.is_object())
+            auto entries = ParseOnlineServerList(response.body);
+            try
             {
-                auto jsonStatus = root["status"];
-                if (!jsonStatus.is_number_integer())
-                {
-                    throw MasterServerException(STR_SERVER_LIST_INVALID_RESPONSE_JSON_NUMBER);
-                }
-
-                auto status = Json::GetNumber<int32_t>(jsonStatus);
-                if (status != 200)
-                {
-                    throw MasterServerException(STR_SERVER_LIST_MASTER_SERVER_FAILED);
-                }
-
-                auto jServers = root["servers"];
-                if (!jServers.is_array())
-                {
-                    throw MasterServerException(STR_SERVER_LIST_INVALID_RESPONSE_JSON_ARRAY);
-                }
-
-                std::vector<ServerListEntry> entries;
-                for (auto& jServer : jServers)
-                {
-                    if (jServer.is_object())
-                    {
-                        auto entry = ServerListEntry::FromJson(jServer);
-                        if (entry.has_value())
-                        {
-                            entries.push_back(std::move(*entry));
-                        }
-                    }
-                }
-
-                p->set_value(entries);
+                File::WriteAllBytes(cachePath, response.body.data(), response.body.size());
             }
+            catch (const std::exception& e)
+            {
+                log_warning("Unable to write server list cache: %s", e.what());
+            }
+            p->set_value(entries);
         }
         catch (...)
         {
@@ -400,6 +425,23 @@ std::future<std::vector<ServerListEntry>> ServerList::FetchOnlineServerListAsync
 #    endif
 }
 
+std::vector<ServerListEntry> ServerList::ReadCachedOnlineServerList() const
+{
+    try
+    {
+        auto path = GetContext()->GetPlatformEnvironment()->GetFilePath(PATHID::CACHE_SERVER_LIST);
+        if (Platform::FileExists(path))
+        {
+            return ParseOnlineServerList(File::ReadAllText(path));
+        }
+    }
+    catch (const std::exception& e)
+    {
+        log_warning("Unable to read server list cache: %s", e.what());
+    }
+    return {};
+}
+
 uint32_t ServerList::GetTotalPlayerCount() const
 {
     return std::accumulate(_serverEntries.begin(), _serverEntries.end(), 0, [](uint32_t acc, const ServerListEntry& entry) {
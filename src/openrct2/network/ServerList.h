@@ -62,11 +62,21 @@ public:
     void AddRange(const std::vector<ServerListEntry>& entries);
     void Clear();
 
+    /**
+     * Removes the servers from the master server, to make room for a newer list.
+     */
+    void RemoveOnlineServers();
+
     void ReadAndAddFavourites();
     void WriteFavourites() const;
 
     std::future<std::vector<ServerListEntry>> FetchLocalServerListAsync() const;
     std::future<std::vector<ServerListEntry>> FetchOnlineServerListAsync() const;
+
+    /**
+     * The servers from the last successful fetch of the online list, so they can be shown until the new list arrives.
+     */
+    std::vector<ServerListEntry> ReadCachedOnlineServerList() const;
     uint32_t GetTotalPlayerCount() const;
 };
 
@@ -0,0 +1,238 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "ServerMetrics.h"
+
+#include "../Diagnostic.h"
+#include "../Game.h"
+#include "../OpenRCT2.h"
+#include "../config/Config.h"
+#include "../core/AsyncLog.h"
+#include "../core/MemoryUsage.h"
+#include "../platform/platform.h"
+#include "../world/Entity.h"
+#include "../world/EntityList.h"
+#include "../world/Map.h"
+#include "network.h"
+
+#include <algorithm>
+#include <array>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+
+using namespace OpenRCT2;
+
+static constexpr double TickTimeBucketBoundsMs[] = { 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10, 25, 50, 100 };
+static constexpr size_t NumLogicTimeParts = static_cast<size_t>(LogicTimePart::Scripts) + 1;
+
+static constexpr const char* EntityTypeNames[] = {
+    "vehicle",
+    "guest",
+    "staff",
+    "litter",
+    "steam_particle",
+    "money_effect",
+    "crashed_vehicle_particle",
+    "explosion_cloud",
+    "crash_splash",
+    "explosion_flare",
+    "jumping_fountain",
+    "balloon",
+    "duck",
+};
+static_assert(std::size(EntityTypeNames) == static_cast<size_t>(EntityType::Count));
+
+struct TickTimeHistogram
+{
+    // The last bucket counts everything above the highest bound
+    std::array<uint32_t, std::size(TickTimeBucketBoundsMs) + 1> Buckets{};
+    uint32_t Count{};
+    double SumMs{};
+    double MaxMs{};
+
+    void Add(double ms)
+    {
+        auto bucket = std::lower_bound(std::begin(TickTimeBucketBoundsMs), std::end(TickTimeBucketBoundsMs), ms)
+            - std::begin(TickTimeBucketBoundsMs);
+        Buckets[bucket]++;
+        Count++;
+        SumMs += ms;
+        MaxMs = std::max(MaxMs, ms);
+    }
+
+    json_t ToJson() const
+    {
+        return {
+            { "count", Count },
+            { "sumMs", SumMs },
+            { "maxMs", MaxMs },
+            { "buckets", Buckets },
+        };
+    }
+};
+
+static LogicTimings _timings;
+static size_t _tickIndex;
+static TickTimeHistogram _tickTimes;
+static std::array<TickTimeHistogram, NumLogicTimeParts> _partTimes;
+static uint32_t _intervalStart;
+
+static std::ofstream _log;
+static std::string _logPath;
+
+static bool ServerMetricsIsEnabled()
+{
+    return gOpenRCT2Headless && !gConfigNetwork.metrics_log_path.empty();
+}
+
+LogicTimings* ServerMetricsBeginTick()
+{
+    if (!ServerMetricsIsEnabled())
+        return nullptr;
+
+    // Parts that do not run in this tick are left at a negative time, like the ones after a tick returned early
+    _tickIndex = _timings.CurrentIdx;
+    for (size_t part = 0; part < NumLogicTimeParts; part++)
+    {
+        _timings.TimingInfo[static_cast<LogicTimePart>(part)][_tickIndex] = std::chrono::duration<double>(-1);
+    }
+    return &_timings;
+}
+
+void ServerMetricsEndTick()
+{
+    // Only ticks that ran to the end move on to the next index
+    if (!ServerMetricsIsEnabled() || _timings.CurrentIdx == _tickIndex)
+        return;
+
+    double previousMs = 0;
+    for (size_t part = 0; part < NumLogicTimeParts; part++)
+    {
+        const auto& end = _timings.TimingInfo[static_cast<LogicTimePart>(part)][_tickIndex];
+        auto endMs = std::chrono::duration<double, std::milli>(end).count();
+        if (endMs < 0)
+            continue;
+
+        _partTimes[part].Add(endMs - previousMs);
+        previousMs = endMs;
+    }
+    _tickTimes.Add(previousMs);
+}
+
+json_t ServerMetricsGetAsJson()
+{
+    const auto elapsedMs = std::max<uint32_t>(platform_get_ticks() - _intervalStart, 1);
+
+    json_t parts = json_t::object();
+    for (size_t part = 0; part < NumLogicTimeParts; part++)
+    {
+        parts[GetLogicTimePartName(static_cast<LogicTimePart>(part))] = _partTimes[part].ToJson();
+    }
+
+    json_t entities = { { "free", GetNumFreeEntities() }, { "max", MAX_ENTITIES } };
+    for (size_t type = 0; type < std::size(EntityTypeNames); type++)
+    {
+        entities[EntityTypeNames[type]] = GetEntityListCount(static_cast<EntityType>(type));
+    }
+
+    // Tiles that were moved leave holes behind until the elements are reorganised, the end is what runs out
+    const auto tileElementsEnd = static_cast<size_t>(gNextFreeTileElement - gTileElements);
+
+    auto telemetry = network_get_telemetry_as_json();
+    size_t queuedPackets = 0;
+    size_t queuedBytes = 0;
+    size_t maxQueuedBytes = 0;
+    for (const auto& connection : telemetry["connections"])
+    {
+        queuedPackets += connection["queuedPackets"].get<size_t>();
+        auto connectionBytes = connection["queuedBytes"].get<size_t>();
+        queuedBytes += connectionBytes;
+        maxQueuedBytes = std::max(maxQueuedBytes, connectionBytes);
+    }
+
+    auto memoryUsage = MemoryUsageGetReport();
+    json_t memory = { { "total", memoryUsage.GetTotal() } };
+    for (size_t i = 0; i < MEMORY_USAGE_CATEGORY_COUNT; i++)
+    {
+        auto category = static_cast<MemoryUsageCategory>(i);
+        memory[MemoryUsageGetCategoryName(category)] = memoryUsage.Get(category);
+    }
+
+    return {
+        { "time", static_cast<int64_t>(std::time(nullptr)) },
+        { "intervalMs", elapsedMs },
+        { "gameTick", gCurrentTicks },
+        { "ticksPerSecond", _tickTimes.Count * 1000.0 / elapsedMs },
+        { "tickTimes", _tickTimes.ToJson() },
+        { "tickTimeBucketBoundsMs", TickTimeBucketBoundsMs },
+        { "partTimes", parts },
+        { "entities", entities },
+        { "tileElements", { { "end", tileElementsEnd }, { "max", MAX_TILE_ELEMENTS } } },
+        { "network",
+          {
+              { "connections", telemetry["connections"].size() },
+              { "queuedPackets", queuedPackets },
+              { "queuedBytes", queuedBytes },
+              { "maxQueuedBytes", maxQueuedBytes },
+              { "slowClientsDisconnected", telemetry["slowClientsDisconnected"] },
+          } },
+        { "memory", memory },
+    };
+}
+
+static bool OpenLog()
+{
+    if (_log.is_open() && _logPath == gConfigNetwork.metrics_log_path)
+        return true;
+
+    AsyncLog::Flush();
+    _log.close();
+    _logPath = gConfigNetwork.metrics_log_path;
+    _log.open(_logPath, std::ios::out | std::ios::app);
+    if (!_log.is_open())
+    {
+        log_error("Unable to open metrics log '%s'", _logPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+void ServerMetricsUpdate()
+{
+    if (!ServerMetricsIsEnabled())
+    {
+        if (_log.is_open())
+        {
+            AsyncLog::Flush();
+            _log.close();
+        }
+        return;
+    }
+
+    const auto now = platform_get_ticks();
+    if (_intervalStart == 0)
+    {
+        _intervalStart = now;
+        return;
+    }
+
+    const auto intervalMs = static_cast<uint32_t>(std::max(gConfigNetwork.metrics_interval, 1)) * 1000;
+    if (now - _intervalStart < intervalMs)
+        return;
+
+    if (OpenLog())
+    {
+        AsyncLog::Write(_log, ServerMetricsGetAsJson().dump() + "\n");
+    }
+
+    _tickTimes = {};
+    _partTimes = {};
+    _intervalStart = now;
+}
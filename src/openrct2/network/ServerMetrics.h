@@ -0,0 +1,40 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../GameState.h"
+#include "../core/Json.hpp"
+
+/*
+ * Always-on metrics for headless servers, collected when network.metrics_log_path is set. The time of every tick and
+ * of each part of it goes into fixed histograms. Every network.metrics_interval seconds they are written to the log
+ * as one JSON object per line, together with a sample of the entity counts, tile element usage, network queues and
+ * memory usage, and then start again from zero.
+ */
+
+/**
+ * Returns the timings UpdateLogic should fill in for the next tick, nullptr when no metrics are collected.
+ */
+OpenRCT2::LogicTimings* ServerMetricsBeginTick();
+
+/**
+ * Adds the times of the tick that was just run with the timings from ServerMetricsBeginTick.
+ */
+void ServerMetricsEndTick();
+
+/**
+ * Writes the metrics of the interval to the log once it has passed.
+ */
+void ServerMetricsUpdate();
+
+/**
+ * The metrics of the current interval so far, in the same form as they are written to the log.
+ */
+json_t ServerMetricsGetAsJson();
@@ -51,6 +51,7 @@
     #include <netinet/tcp.h>
     #include <sys/ioctl.h>
     #include <sys/socket.h>
+    #include <sys/uio.h>
     #include "../common.h"
     using SOCKET = int32_t;
     #define SOCKET_ERROR -1
@@ -60,9 +61,17 @@
     #define ioctlsocket ioctl
     #if defined(__linux__)
         #define FLAG_NO_PIPE MSG_NOSIGNAL
+        #define SOCKET_POLLER_EPOLL
+        #include <sys/epoll.h>
     #else
         #define FLAG_NO_PIPE 0
     #endif // defined(__linux__)
+    #if defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__)
+        #define SOCKET_POLLER_KQUEUE
+        #include <sys/event.h>
+    #endif
+    #include <poll.h>
+    #include <unistd.h>
 #endif // _WIN32
 // clang-format on
 
@@ -281,6 +290,11 @@ public:
         return _error.empty() ? nullptr : _error.c_str();
     }
 
+    SOCKET GetNativeHandle() const
+    {
+        return _socket;
+    }
+
     void SetNoDelay(bool noDelay) override
     {
         if (_socket != INVALID_SOCKET)
@@ -565,6 +579,77 @@ public:
         return totalSent;
     }
 
+    size_t SendData(const SocketBuffer* buffers, size_t count) override
+    {
+        if (_status != SocketStatus::Connected)
+        {
+            throw std::runtime_error("Socket not connected.");
+        }
+
+        constexpr size_t MaxBuffersPerCall = 64;
+#    ifdef _WIN32
+        WSABUF chunks[MaxBuffersPerCall];
+#    else
+        iovec chunks[MaxBuffersPerCall];
+#    endif
+
+        size_t totalSent = 0;
+        size_t index = 0;
+        size_t offset = 0;
+        while (index < count)
+        {
+            size_t numChunks = 0;
+            for (size_t i = index; i < count && numChunks < MaxBuffersPerCall; i++)
+            {
+                const size_t skip = i == index ? offset : 0;
+                if (buffers[i].Size == skip)
+                    continue;
+
+                auto data = const_cast<char*>(static_cast<const char*>(buffers[i].Data)) + skip;
+                const size_t length = buffers[i].Size - skip;
+#    ifdef _WIN32
+                chunks[numChunks].buf = data;
+                chunks[numChunks].len = static_cast<ULONG>(length);
+#    else
+                chunks[numChunks].iov_base = data;
+                chunks[numChunks].iov_len = length;
+#    endif
+                numChunks++;
+            }
+            if (numChunks == 0)
+                break;
+
+#    ifdef _WIN32
+            DWORD sentBytes = 0;
+            if (WSASend(_socket, chunks, static_cast<DWORD>(numChunks), &sentBytes, 0, nullptr, nullptr) == SOCKET_ERROR)
+            {
+                return totalSent;
+            }
+#    else
+            msghdr message{};
+            message.msg_iov = chunks;
+            message.msg_iovlen = numChunks;
+            ssize_t sentBytes = sendmsg(_socket, &message, FLAG_NO_PIPE);
+            if (sentBytes == SOCKET_ERROR)
+            {
+                return totalSent;
+            }
+#    endif
+            totalSent += static_cast<size_t>(sentBytes);
+
+            // Move past the buffers that were sent completely.
+            size_t remaining = static_cast<size_t>(sentBytes);
+            while (index < count && remaining >= buffers[index].Size - offset)
+            {
+                remaining -= buffers[index].Size - offset;
+                index++;
+                offset = 0;
+            }
+            offset += remaining;
+        }
+        return totalSent;
+    }
+
     NetworkReadPacket ReceiveData(void* buffer, size_t size, size_t* sizeReceived) override
     {
         if (_status != SocketStatus::Connected)
@@ -882,6 +967,248 @@ private:
     }
 };
 
+static SOCKET GetNativeHandle(ITcpSocket& socket)
+{
+    auto tcpSocket = dynamic_cast<TcpSocket*>(&socket);
+    if (tcpSocket == nullptr)
+    {
+        throw std::invalid_argument("socket is not compatible.");
+    }
+    return tcpSocket->GetNativeHandle();
+}
+
+#    if defined(SOCKET_POLLER_EPOLL)
+class SocketPoller final : public ISocketPoller
+{
+private:
+    int _epoll = -1;
+    std::vector<epoll_event> _events;
+    std::vector<SocketReadiness> _ready;
+
+public:
+    SocketPoller()
+    {
+        _epoll = epoll_create1(EPOLL_CLOEXEC);
+        if (_epoll == -1)
+        {
+            throw SocketException("Unable to create epoll instance.");
+        }
+    }
+
+    ~SocketPoller() override
+    {
+        close(_epoll);
+    }
+
+    void Add(ITcpSocket& socket, void* userData) override
+    {
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.ptr = userData;
+        if (epoll_ctl(_epoll, EPOLL_CTL_ADD, GetNativeHandle(socket), &ev) == 0)
+        {
+            _events.resize(_events.size() + 1);
+        }
+        else
+        {
+            log_error("Unable to add socket to epoll instance.");
+        }
+    }
+
+    void Remove(ITcpSocket& socket) override
+    {
+        if (epoll_ctl(_epoll, EPOLL_CTL_DEL, GetNativeHandle(socket), nullptr) == 0)
+        {
+            _events.pop_back();
+        }
+    }
+
+    void SetWriteInterest(ITcpSocket& socket, void* userData, bool enabled) override
+    {
+        epoll_event ev{};
+        ev.events = EPOLLIN | (enabled ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+        ev.data.ptr = userData;
+        epoll_ctl(_epoll, EPOLL_CTL_MOD, GetNativeHandle(socket), &ev);
+    }
+
+    const std::vector<SocketReadiness>& Wait(int32_t timeoutMs) override
+    {
+        _ready.clear();
+        if (_events.empty())
+        {
+            return _ready;
+        }
+
+        int32_t numEvents = epoll_wait(_epoll, _events.data(), static_cast<int32_t>(_events.size()), timeoutMs);
+        for (int32_t i = 0; i < numEvents; i++)
+        {
+            const auto& ev = _events[i];
+            const bool error = (ev.events & (EPOLLERR | EPOLLHUP)) != 0;
+            _ready.push_back({ ev.data.ptr, error || (ev.events & EPOLLIN) != 0, error || (ev.events & EPOLLOUT) != 0 });
+        }
+        return _ready;
+    }
+};
+#    elif defined(SOCKET_POLLER_KQUEUE)
+class SocketPoller final : public ISocketPoller
+{
+private:
+    int _kqueue = -1;
+    size_t _numSockets = 0;
+    std::vector<struct kevent> _events;
+    std::vector<SocketReadiness> _ready;
+
+public:
+    SocketPoller()
+    {
+        _kqueue = kqueue();
+        if (_kqueue == -1)
+        {
+            throw SocketException("Unable to create kqueue.");
+        }
+    }
+
+    ~SocketPoller() override
+    {
+        close(_kqueue);
+    }
+
+    void Add(ITcpSocket& socket, void* userData) override
+    {
+        struct kevent change;
+        EV_SET(&change, GetNativeHandle(socket), EVFILT_READ, EV_ADD, 0, 0, userData);
+        if (kevent(_kqueue, &change, 1, nullptr, 0, nullptr) == 0)
+        {
+            _numSockets++;
+        }
+        else
+        {
+            log_error("Unable to add socket to kqueue.");
+        }
+    }
+
+    void Remove(ITcpSocket& socket) override
+    {
+        struct kevent changes[2];
+        EV_SET(&changes[0], GetNativeHandle(socket), EVFILT_READ, EV_DELETE, 0, 0, nullptr);
+        EV_SET(&changes[1], GetNativeHandle(socket), EVFILT_WRITE, EV_DELETE, 0, 0, nullptr);
+        kevent(_kqueue, &changes[0], 1, nullptr, 0, nullptr);
+        kevent(_kqueue, &changes[1], 1, nullptr, 0, nullptr);
+        _numSockets--;
+    }
+
+    void SetWriteInterest(ITcpSocket& socket, void* userData, bool enabled) override
+    {
+        struct kevent change;
+        EV_SET(&change, GetNativeHandle(socket), EVFILT_WRITE, enabled ? EV_ADD : EV_DELETE, 0, 0, userData);
+        kevent(_kqueue, &change, 1, nullptr, 0, nullptr);
+    }
+
+    const std::vector<SocketReadiness>& Wait(int32_t timeoutMs) override
+    {
+        _ready.clear();
+        if (_numSockets == 0)
+        {
+            return _ready;
+        }
+
+        // Read and write readiness are separate events, at most two per socket.
+        _events.resize(_numSockets * 2);
+        timespec timeout{ timeoutMs / 1000, (timeoutMs % 1000) * 1000000L };
+        int32_t numEvents = kevent(
+            _kqueue, nullptr, 0, _events.data(), static_cast<int32_t>(_events.size()), timeoutMs < 0 ? nullptr : &timeout);
+        for (int32_t i = 0; i < numEvents; i++)
+        {
+            const auto& ev = _events[i];
+            const bool error = (ev.flags & (EV_EOF | EV_ERROR)) != 0;
+            _ready.push_back({ ev.udata, error || ev.filter == EVFILT_READ, error || ev.filter == EVFILT_WRITE });
+        }
+        return _ready;
+    }
+};
+#    else
+// Fallback for platforms without a scalable readiness API, also used for Windows as WSAPoll
+// has the same readiness semantics as the other backends.
+class SocketPoller final : public ISocketPoller
+{
+private:
+#        ifdef _WIN32
+    std::vector<WSAPOLLFD> _fds;
+#        else
+    std::vector<pollfd> _fds;
+#        endif
+    std::vector<void*> _userData;
+    std::vector<SocketReadiness> _ready;
+
+public:
+    void Add(ITcpSocket& socket, void* userData) override
+    {
+        auto& fd = _fds.emplace_back();
+        fd.fd = GetNativeHandle(socket);
+        fd.events = POLLIN;
+        fd.revents = 0;
+        _userData.push_back(userData);
+    }
+
+    void Remove(ITcpSocket& socket) override
+    {
+        auto index = Find(GetNativeHandle(socket));
+        if (index < _fds.size())
+        {
+            _fds.erase(_fds.begin() + index);
+            _userData.erase(_userData.begin() + index);
+        }
+    }
+
+    void SetWriteInterest(ITcpSocket& socket, void* userData, bool enabled) override
+    {
+        auto index = Find(GetNativeHandle(socket));
+        if (index < _fds.size())
+        {
+            _fds[index].events = POLLIN | (enabled ? POLLOUT : 0);
+            _userData[index] = userData;
+        }
+    }
+
+    const std::vector<SocketReadiness>& Wait(int32_t timeoutMs) override
+    {
+        _ready.clear();
+        if (_fds.empty())
+        {
+            return _ready;
+        }
+
+#        ifdef _WIN32
+        int32_t numEvents = WSAPoll(_fds.data(), static_cast<ULONG>(_fds.size()), timeoutMs);
+#        else
+        int32_t numEvents = poll(_fds.data(), static_cast<nfds_t>(_fds.size()), timeoutMs);
+#        endif
+        for (size_t i = 0; i < _fds.size() && numEvents > 0; i++)
+        {
+            const auto revents = _fds[i].revents;
+            if (revents == 0)
+                continue;
+
+            const bool error = (revents & (POLLERR | POLLHUP | POLLNVAL)) != 0;
+            _ready.push_back({ _userData[i], error || (revents & POLLIN) != 0, error || (revents & POLLOUT) != 0 });
+            numEvents--;
+        }
+        return _ready;
+    }
+
+private:
+    size_t Find(SOCKET handle) const
+    {
+        for (size_t i = 0; i < _fds.size(); i++)
+        {
+            if (_fds[i].fd == handle)
+                return i;
+        }
+        return _fds.size();
+    }
+};
+#    endif
+
 std::unique_ptr<ITcpSocket> CreateTcpSocket()
 {
     InitialiseWSA();
@@ -894,6 +1221,12 @@ std::unique_ptr<IUdpSocket> CreateUdpSocket()
     return std::make_unique<UdpSocket>();
 }
 
+std::unique_ptr<ISocketPoller> CreateSocketPoller()
+{
+    InitialiseWSA();
+    return std::make_unique<SocketPoller>();
+}
+
 #    ifdef _WIN32
 static std::vector<INTERFACE_INFO> GetNetworkInterfaces()
 {
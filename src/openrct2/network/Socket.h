@@ -33,6 +33,15 @@ enum class NetworkReadPacket : int32_t
     Disconnected
 };
 
+/**
+ * A range of bytes to send, used to send several buffers with a single call.
+ */
+struct SocketBuffer
+{
+    const void* Data = nullptr;
+    size_t Size = 0;
+};
+
 /**
  * Represents an address and port.
  */
@@ -66,6 +75,7 @@ public:
     virtual void ConnectAsync(const std::string& address, uint16_t port) abstract;
 
     virtual size_t SendData(const void* buffer, size_t size) abstract;
+    virtual size_t SendData(const SocketBuffer* buffers, size_t count) abstract;
     virtual NetworkReadPacket ReceiveData(void* buffer, size_t size, size_t* sizeReceived) abstract;
 
     virtual void SetNoDelay(bool noDelay) abstract;
@@ -98,8 +108,39 @@ public:
     virtual void Close() abstract;
 };
 
+/**
+ * A socket that became ready, passes back the user data the socket was added with.
+ */
+struct SocketReadiness
+{
+    void* UserData;
+    bool Readable;
+    bool Writable;
+};
+
+/**
+ * Waits for any of a set of TCP sockets to have data to read or room to write. Uses epoll,
+ * kqueue or poll depending on the platform. Sockets must be removed before they are destroyed.
+ */
+struct ISocketPoller
+{
+public:
+    virtual ~ISocketPoller() = default;
+
+    virtual void Add(ITcpSocket& socket, void* userData) abstract;
+    virtual void Remove(ITcpSocket& socket) abstract;
+    virtual void SetWriteInterest(ITcpSocket& socket, void* userData, bool enabled) abstract;
+
+    /**
+     * Blocks for at most timeoutMs milliseconds until a socket is ready. A socket may be reported more
+     * than once, errors and hang ups are reported as both readable and writable.
+     */
+    virtual const std::vector<SocketReadiness>& Wait(int32_t timeoutMs) abstract;
+};
+
 std::unique_ptr<ITcpSocket> CreateTcpSocket();
 std::unique_ptr<IUdpSocket> CreateUdpSocket();
+std::unique_ptr<ISocketPoller> CreateSocketPoller();
 std::vector<std::unique_ptr<INetworkEndpoint>> GetBroadcastAddresses();
 
 namespace Convert
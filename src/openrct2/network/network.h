@@ -50,6 +50,7 @@ int32_t network_begin_server(int32_t port, const std::string& address);
 int32_t network_get_mode();
 int32_t network_get_status();
 bool network_is_desynchronised();
+bool network_is_resuming();
 bool network_check_desynchronisation();
 void network_request_gamestate_snapshot();
 void network_send_tick();
@@ -57,6 +58,7 @@ bool network_gamestate_snapshots_enabled();
 void network_update();
 void network_process_pending();
 void network_flush();
+bool network_wait_for_events(uint32_t timeoutMs);
 
 NetworkAuth network_get_authstatus();
 uint32_t network_get_server_tick();
@@ -122,3 +124,4 @@ std::string network_get_version();
 NetworkStats_t network_get_stats();
 NetworkServerState_t network_get_server_state();
 json_t network_get_server_info_as_json();
+json_t network_get_telemetry_as_json();
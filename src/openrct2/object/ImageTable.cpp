@@ -17,6 +17,7 @@
 #include "../core/IStream.hpp"
 #include "../core/Json.hpp"
 #include "../core/Path.hpp"
+#include "../core/Profiling.h"
 #include "../core/String.hpp"
 #include "../drawing/ImageImporter.h"
 #include "../sprites.h"
@@ -290,6 +291,7 @@ std::string ImageTable::FindLegacyObject(const std::string& name)
 
 ImageTable::~ImageTable()
 {
+    MemoryUsageTrack(MemoryUsageCategory::ObjectImages, -static_cast<int64_t>(_dataSize));
     if (_data == nullptr)
     {
         for (auto& entry : _entries)
@@ -301,6 +303,7 @@ ImageTable::~ImageTable()
 
 void ImageTable::Read(IReadObjectContext* context, OpenRCT2::IStream* stream)
 {
+    PROFILE_SCOPE("ImageTable::Read");
     if (gOpenRCT2NoGraphics)
     {
         return;
@@ -359,6 +362,8 @@ void ImageTable::Read(IReadObjectContext* context, OpenRCT2::IStream* stream)
         }
 
         _data = std::move(data);
+        _dataSize += dataSize;
+        MemoryUsageTrack(MemoryUsageCategory::ObjectImages, static_cast<int64_t>(dataSize));
         _entries.insert(_entries.end(), newEntries.begin(), newEntries.end());
     }
     catch (const std::exception&)
@@ -371,6 +376,7 @@ void ImageTable::Read(IReadObjectContext* context, OpenRCT2::IStream* stream)
 void ImageTable::ReadJson(IReadObjectContext* context, json_t& root)
 {
     Guard::Assert(root.is_object(), "ImageTable::ReadJson expects parameter root to be object");
+    PROFILE_SCOPE("ImageTable::ReadJson");
 
     if (context->ShouldLoadImages())
     {
@@ -397,10 +403,9 @@ void ImageTable::ReadJson(IReadObjectContext* context, json_t& root)
 
         // Now add all the images to the image table
         auto imagesStartIndex = GetCount();
-        for (const auto& img : allImages)
+        for (auto& img : allImages)
         {
-            const auto& g1 = img->g1;
-            AddImage(&g1);
+            AddImage(*img);
         }
 
         // Add all the zoom images at the very end of the image table.
@@ -408,7 +413,7 @@ void ImageTable::ReadJson(IReadObjectContext* context, json_t& root)
         for (size_t j = 0; j < allImages.size(); j++)
         {
             const auto tableIndex = imagesStartIndex + j;
-            const auto* img = allImages[j].get();
+            auto* img = allImages[j].get();
             if (img->next_zoom != nullptr)
             {
                 img = img->next_zoom.get();
@@ -419,12 +424,11 @@ void ImageTable::ReadJson(IReadObjectContext* context, json_t& root)
 
                 while (img != nullptr)
                 {
-                    auto g1b = img->g1;
                     if (img->next_zoom != nullptr)
                     {
-                        g1b.zoomed_offset = -1;
+                        img->g1.zoomed_offset = -1;
                     }
-                    AddImage(&g1b);
+                    AddImage(*img);
                     img = img->next_zoom.get();
                 }
             }
@@ -444,6 +448,26 @@ void ImageTable::AddImage(const rct_g1_element* g1)
     {
         newg1.offset = new uint8_t[length];
         std::copy_n(g1->offset, length, newg1.offset);
+        _dataSize += length;
+        MemoryUsageTrack(MemoryUsageCategory::ObjectImages, static_cast<int64_t>(length));
+    }
+    _entries.push_back(std::move(newg1));
+}
+
+void ImageTable::AddImage(RequiredImage& image)
+{
+    // The pixels were already copied into the required image, take them over instead of copying them again.
+    rct_g1_element newg1 = image.g1;
+    auto length = g1_calculate_data_size(&newg1);
+    if (length == 0)
+    {
+        newg1.offset = nullptr;
+    }
+    else
+    {
+        image.g1.offset = nullptr;
+        _dataSize += length;
+        MemoryUsageTrack(MemoryUsageCategory::ObjectImages, static_cast<int64_t>(length));
     }
     _entries.push_back(std::move(newg1));
 }
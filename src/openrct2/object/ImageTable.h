@@ -11,6 +11,7 @@
 
 #include "../common.h"
 #include "../core/JsonFwd.hpp"
+#include "../core/MemoryUsage.h"
 #include "../drawing/Drawing.h"
 
 #include <memory>
@@ -26,7 +27,9 @@ class ImageTable
 {
 private:
     std::unique_ptr<uint8_t[]> _data;
-    std::vector<rct_g1_element> _entries;
+    std::vector<rct_g1_element, TrackingAllocator<rct_g1_element, MemoryUsageCategory::ObjectImages>> _entries;
+    // Bytes of pixel data owned by the table, counted under MemoryUsageCategory::ObjectImages
+    size_t _dataSize{};
 
     /**
      * Container for a G1 image, additional information and RAII. Used by ReadJson
@@ -41,6 +44,7 @@ private:
         IReadObjectContext* context, const std::string& name, const std::vector<int32_t>& range);
     static std::vector<int32_t> ParseRange(std::string s);
     static std::string FindLegacyObject(const std::string& name);
+    void AddImage(RequiredImage& image);
 
 public:
     ImageTable() = default;
@@ -12,11 +12,13 @@
 #include "../OpenRCT2.h"
 #include "../core/Console.hpp"
 #include "../core/File.h"
+#include "../core/BufferedFileStream.h"
 #include "../core/FileStream.h"
 #include "../core/Json.hpp"
 #include "../core/Memory.hpp"
 #include "../core/MemoryStream.h"
 #include "../core/Path.hpp"
+#include "../core/Profiling.h"
 #include "../core/String.hpp"
 #include "../core/Zip.h"
 #include "../rct12/SawyerChunkReader.h"
@@ -189,7 +191,17 @@ namespace ObjectFactory
      * @note jRoot is deliberately left non-const: json_t behaviour changes when const
      */
     static std::unique_ptr<Object> CreateObjectFromJson(
-        IObjectRepository& objectRepository, json_t& jRoot, const IFileDataRetriever* fileRetriever);
+        IObjectRepository& objectRepository, json_t& jRoot, const IFileDataRetriever* fileRetriever, bool loadImages);
+
+    /**
+     * The root keys of object.json that are not needed when the images are not loaded.
+     */
+    static const std::vector<std::string_view>& GetSkippedKeys(bool loadImages)
+    {
+        static const std::vector<std::string_view> none;
+        static const std::vector<std::string_view> images = { "images" };
+        return loadImages ? none : images;
+    }
 
     static ObjectSourceGame ParseSourceGame(const std::string& s)
     {
@@ -231,7 +243,7 @@ namespace ObjectFactory
         std::unique_ptr<Object> result;
         try
         {
-            auto fs = OpenRCT2::FileStream(path, OpenRCT2::FILE_MODE_OPEN);
+            auto fs = OpenRCT2::BufferedFileStream(path);
             auto chunkReader = SawyerChunkReader(&fs);
 
             rct_object_entry entry = fs.ReadValue<rct_object_entry>();
@@ -244,12 +256,19 @@ namespace ObjectFactory
                 object_entry_get_name_fixed(objectName, sizeof(objectName), &entry);
                 log_verbose("  entry: { 0x%08X, \"%s\", 0x%08X }", entry.flags, objectName, entry.checksum);
 
-                auto chunk = chunkReader.ReadChunk();
+                std::shared_ptr<SawyerChunk> chunk;
+                {
+                    PROFILE_SCOPE("ObjectFactory::ReadFile");
+                    chunk = chunkReader.ReadChunk();
+                }
                 log_verbose("  size: %zu", chunk->GetLength());
 
                 auto chunkStream = OpenRCT2::MemoryStream(chunk->GetData(), chunk->GetLength());
                 auto readContext = ReadObjectContext(objectRepository, objectName, !gOpenRCT2NoGraphics, nullptr);
-                ReadObjectLegacy(*result, &readContext, &chunkStream);
+                {
+                    PROFILE_SCOPE("ObjectFactory::ParseObject");
+                    ReadObjectLegacy(*result, &readContext, &chunkStream);
+                }
                 if (readContext.WasError())
                 {
                     throw std::runtime_error("Object has errors");
@@ -380,23 +399,30 @@ namespace ObjectFactory
         return ObjectType::None;
     }
 
-    std::unique_ptr<Object> CreateObjectFromZipFile(IObjectRepository& objectRepository, std::string_view path)
+    std::unique_ptr<Object> CreateObjectFromZipFile(
+        IObjectRepository& objectRepository, std::string_view path, bool loadImages)
     {
+        loadImages = loadImages && !gOpenRCT2NoGraphics;
         try
         {
-            auto archive = Zip::Open(path, ZIP_ACCESS::READ);
-            auto jsonBytes = archive->GetFileData("object.json");
+            std::unique_ptr<IZipArchive> archive;
+            std::vector<uint8_t> jsonBytes;
+            {
+                PROFILE_SCOPE("ObjectFactory::ReadFile");
+                archive = Zip::Open(path, ZIP_ACCESS::READ);
+                jsonBytes = archive->GetFileData("object.json");
+            }
             if (jsonBytes.empty())
             {
                 throw std::runtime_error("Unable to open object.json.");
             }
 
-            json_t jRoot = Json::FromVector(jsonBytes);
+            json_t jRoot = Json::FromVector(jsonBytes, GetSkippedKeys(loadImages));
 
             if (jRoot.is_object())
             {
                 auto fileDataRetriever = ZipDataRetriever(path, *archive);
-                return CreateObjectFromJson(objectRepository, jRoot, &fileDataRetriever);
+                return CreateObjectFromJson(objectRepository, jRoot, &fileDataRetriever, loadImages);
             }
         }
         catch (const std::exception& e)
@@ -406,15 +432,21 @@ namespace ObjectFactory
         return nullptr;
     }
 
-    std::unique_ptr<Object> CreateObjectFromJsonFile(IObjectRepository& objectRepository, const std::string& path)
+    std::unique_ptr<Object> CreateObjectFromJsonFile(
+        IObjectRepository& objectRepository, const std::string& path, bool loadImages)
     {
+        loadImages = loadImages && !gOpenRCT2NoGraphics;
         log_verbose("CreateObjectFromJsonFile(\"%s\")", path.c_str());
 
         try
         {
-            json_t jRoot = Json::ReadFromFile(path.c_str());
+            json_t jRoot;
+            {
+                PROFILE_SCOPE("ObjectFactory::ReadFile");
+                jRoot = Json::ReadFromFile(path.c_str(), GetSkippedKeys(loadImages));
+            }
             auto fileDataRetriever = FileSystemDataRetriever(Path::GetDirectory(path));
-            return CreateObjectFromJson(objectRepository, jRoot, &fileDataRetriever);
+            return CreateObjectFromJson(objectRepository, jRoot, &fileDataRetriever, loadImages);
         }
         catch (const std::runtime_error& err)
         {
@@ -457,7 +489,7 @@ namespace ObjectFactory
     }
 
     std::unique_ptr<Object> CreateObjectFromJson(
-        IObjectRepository& objectRepository, json_t& jRoot, const IFileDataRetriever* fileRetriever)
+        IObjectRepository& objectRepository, json_t& jRoot, const IFileDataRetriever* fileRetriever, bool loadImages)
     {
         Guard::Assert(jRoot.is_object(), "ObjectFactory::CreateObjectFromJson expects parameter jRoot to be object");
 
@@ -487,8 +519,11 @@ namespace ObjectFactory
             result = CreateObject(entry);
             result->SetIdentifier(id);
             result->MarkAsJsonObject();
-            auto readContext = ReadObjectContext(objectRepository, id, !gOpenRCT2NoGraphics, fileRetriever);
-            result->ReadJson(&readContext, jRoot);
+            auto readContext = ReadObjectContext(objectRepository, id, loadImages, fileRetriever);
+            {
+                PROFILE_SCOPE("ObjectFactory::ParseObject");
+                result->ReadJson(&readContext, jRoot);
+            }
             if (readContext.WasError())
             {
                 throw std::runtime_error("Object has errors");
@@ -12,8 +12,12 @@
 #include "../Context.h"
 #include "../ParkImporter.h"
 #include "../core/Console.hpp"
+#include "../core/File.h"
 #include "../core/Memory.hpp"
+#include "../core/Profiling.h"
+#include "../core/TaskScheduler.h"
 #include "../localisation/StringIds.h"
+#include "../paint/PaintCache.h"
 #include "../util/Util.h"
 #include "FootpathItemObject.h"
 #include "LargeSceneryObject.h"
@@ -27,16 +31,31 @@
 
 #include <algorithm>
 #include <array>
+#include <iterator>
 #include <memory>
 #include <mutex>
-#include <thread>
+#include <numeric>
+#include <unordered_map>
 #include <unordered_set>
 
 class ObjectManager final : public IObjectManager
 {
 private:
+    struct CachedObject
+    {
+        std::unique_ptr<Object> Instance;
+        uint64_t FileSize{};
+        uint64_t LastModified{};
+        uint32_t Generation{};
+    };
+
     IObjectRepository& _objectRepository;
     std::vector<std::unique_ptr<Object>> _loadedObjects;
+
+    // Objects unloaded since the previous park was loaded, they keep their parsed strings and images
+    // so loading them again does not need to read and decode the file.
+    std::unordered_map<std::string, CachedObject> _objectCache;
+    uint32_t _objectCacheGeneration{};
     std::array<std::vector<ObjectEntryIndex>, RIDE_TYPE_COUNT> _rideTypeToObjectMap;
 
     // Used to return a safe empty vector back from GetAllRideEntries, can be removed when std::span is available
@@ -127,6 +146,8 @@ public:
         LoadDefaultObjects();
         UpdateSceneryGroupIndexes();
         ResetTypeToRideEntryIndexMap();
+        PaintCacheInvalidateAll();
+        TrimObjectCache();
         log_verbose("%u / %u new objects loaded", numNewLoadedObjects, requiredObjects.size());
     }
 
@@ -155,6 +176,7 @@ public:
         {
             UpdateSceneryGroupIndexes();
             ResetTypeToRideEntryIndexMap();
+            PaintCacheInvalidateAll();
         }
     }
 
@@ -166,6 +188,7 @@ public:
         }
         UpdateSceneryGroupIndexes();
         ResetTypeToRideEntryIndexMap();
+        PaintCacheInvalidateAll();
     }
 
     void ResetObjects() override
@@ -180,6 +203,7 @@ public:
         }
         UpdateSceneryGroupIndexes();
         ResetTypeToRideEntryIndexMap();
+        PaintCacheInvalidateAll();
     }
 
     std::vector<const ObjectRepositoryItem*> GetPackableObjects() override
@@ -365,6 +389,7 @@ private:
                         _loadedObjects[*slot] = std::move(object);
                         UpdateSceneryGroupIndexes();
                         ResetTypeToRideEntryIndexMap();
+                        PaintCacheInvalidateAll();
                     }
                 }
             }
@@ -433,16 +458,77 @@ private:
 
             // Because it's possible to have the same loaded object for multiple
             // slots, we have to make sure find and set all of them to nullptr
+            bool cached = false;
             for (auto& obj : _loadedObjects)
             {
                 if (obj.get() == object)
                 {
+                    if (ori != nullptr && !cached)
+                    {
+                        CacheObject(ori, std::move(obj));
+                        cached = true;
+                    }
+                    else if (cached)
+                    {
+                        // Owned by the cache now
+                        obj.release();
+                    }
                     obj = nullptr;
                 }
             }
         }
     }
 
+    void CacheObject(const ObjectRepositoryItem* ori, std::unique_ptr<Object>&& object)
+    {
+        auto& cachedObject = _objectCache[ori->Path];
+        cachedObject.Instance = std::move(object);
+        cachedObject.FileSize = ori->FileSize;
+        cachedObject.LastModified = File::GetLastModified(ori->Path);
+        cachedObject.Generation = _objectCacheGeneration;
+    }
+
+    std::unique_ptr<Object> TakeCachedObject(const ObjectRepositoryItem* ori)
+    {
+        auto it = _objectCache.find(ori->Path);
+        if (it == _objectCache.end())
+            return nullptr;
+
+        auto cachedObject = std::move(it->second);
+        _objectCache.erase(it);
+
+        // The file may have been replaced since the object was read
+        if (cachedObject.FileSize != ori->FileSize || cachedObject.LastModified != File::GetLastModified(ori->Path))
+            return nullptr;
+        return std::move(cachedObject.Instance);
+    }
+
+    /**
+     * Drops the cached objects that were not needed by the park that has just been loaded, which
+     * keeps the cache to at most one park worth of objects.
+     */
+    void TrimObjectCache()
+    {
+        for (auto it = _objectCache.begin(); it != _objectCache.end();)
+        {
+            if (it->second.Generation != _objectCacheGeneration)
+                it = _objectCache.erase(it);
+            else
+                it++;
+        }
+        _objectCacheGeneration++;
+    }
+
+    std::unique_ptr<Object> CreateObject(const ObjectRepositoryItem* ori)
+    {
+        auto object = TakeCachedObject(ori);
+        if (object == nullptr)
+        {
+            object = _objectRepository.LoadObject(ori);
+        }
+        return object;
+    }
+
     void UnloadObjectsExcept(const std::vector<std::unique_ptr<Object>>& newLoadedObjects)
     {
         // Build a hash set for quick checking
@@ -585,7 +671,7 @@ private:
             else
             {
                 auto loadedObject = ori->LoadedObject;
-                if (loadedObject == nullptr)
+                if (loadedObject == nullptr && _objectCache.find(ori->Path) == _objectCache.end())
                 {
                     auto object = _objectRepository.LoadObject(ori);
                     if (object == nullptr)
@@ -628,42 +714,58 @@ private:
         return requiredObjects;
     }
 
+    static std::vector<size_t> GetLoadOrder(const std::vector<const ObjectRepositoryItem*>& requiredObjects)
+    {
+        std::vector<size_t> order(requiredObjects.size());
+        std::iota(order.begin(), order.end(), 0);
+
+        // Start with the largest files so the small objects fill up the gaps at the end.
+        auto getFileSize = [&requiredObjects](size_t i) -> uint64_t {
+            auto requiredObject = requiredObjects[i];
+            return requiredObject != nullptr && requiredObject->LoadedObject == nullptr ? requiredObject->FileSize : 0;
+        };
+        std::stable_sort(order.begin(), order.end(), [&getFileSize](size_t a, size_t b) {
+            return getFileSize(a) > getFileSize(b);
+        });
+        return order;
+    }
+
     template<typename T, typename TFunc> static void ParallelFor(const std::vector<T>& items, TFunc func)
     {
-        auto partitions = std::thread::hardware_concurrency();
-        auto partitionSize = (items.size() + (partitions - 1)) / partitions;
-        std::vector<std::thread> threads;
-        for (size_t n = 0; n < partitions; n++)
-        {
-            auto begin = n * partitionSize;
-            auto end = std::min(items.size(), begin + partitionSize);
-            threads.emplace_back(
-                [func](size_t pbegin, size_t pend) {
-                    for (size_t i = pbegin; i < pend; i++)
-                    {
-                        func(i);
-                    }
-                },
-                begin, end);
-        }
-        for (auto& t : threads)
-        {
-            t.join();
-        }
+        // Loading an object is mostly file I/O, hand out one object at a time to balance the workers.
+        OpenRCT2::TaskScheduler::Get().ParallelFor(items.size(), 1, func);
     }
 
     std::vector<std::unique_ptr<Object>> LoadObjects(
         std::vector<const ObjectRepositoryItem*>& requiredObjects, size_t* outNewObjectsLoaded)
     {
+        PROFILE_SCOPE("ObjectManager::LoadObjects");
+
         std::vector<std::unique_ptr<Object>> objects;
+        std::vector<Object*> newObjects;
         std::vector<Object*> loadedObjects;
         std::vector<rct_object_entry> badObjects;
         objects.resize(OBJECT_ENTRY_COUNT);
+        newObjects.resize(requiredObjects.size());
         loadedObjects.reserve(OBJECT_ENTRY_COUNT);
 
+        // Take the objects that are still cached before the workers start
+        std::vector<std::unique_ptr<Object>> cachedObjects(requiredObjects.size());
+        for (size_t i = 0; i < requiredObjects.size(); i++)
+        {
+            auto requiredObject = requiredObjects[i];
+            if (requiredObject != nullptr && requiredObject->LoadedObject == nullptr)
+            {
+                cachedObjects[i] = TakeCachedObject(requiredObject);
+            }
+        }
+
         // Read objects
         std::mutex commonMutex;
-        ParallelFor(requiredObjects, [this, &commonMutex, requiredObjects, &objects, &badObjects, &loadedObjects](size_t i) {
+        auto loadOrder = GetLoadOrder(requiredObjects);
+        ParallelFor(loadOrder, [&](size_t n) {
+            PROFILE_SCOPE("ObjectManager::ReadObject");
+            auto i = loadOrder[n];
             auto requiredObject = requiredObjects[i];
             std::unique_ptr<Object> object;
             if (requiredObject != nullptr)
@@ -673,7 +775,8 @@ private:
                 {
                     // Object requires to be loaded, if the object successfully loads it will register it
                     // as a loaded object otherwise placed into the badObjects list.
-                    object = _objectRepository.LoadObject(requiredObject);
+                    object = cachedObjects[i] != nullptr ? std::move(cachedObjects[i])
+                                                         : _objectRepository.LoadObject(requiredObject);
                     std::lock_guard<std::mutex> guard(commonMutex);
                     if (object == nullptr)
                     {
@@ -682,7 +785,7 @@ private:
                     }
                     else
                     {
-                        loadedObjects.push_back(object.get());
+                        newObjects[i] = object.get();
                         // Connect the ori to the registered object
                         _objectRepository.RegisterLoadedObject(requiredObject, object.get());
                     }
@@ -705,10 +808,16 @@ private:
             objects[i] = std::move(object);
         });
 
-        // Load objects
-        for (auto obj : loadedObjects)
+        // Load objects in entry order, whichever order they were read in, so they are always given the same image ids
+        std::copy_if(newObjects.begin(), newObjects.end(), std::back_inserter(loadedObjects), [](const Object* obj) {
+            return obj != nullptr;
+        });
         {
-            obj->Load();
+            PROFILE_SCOPE("ObjectManager::RegisterObjects");
+            for (auto obj : loadedObjects)
+            {
+                obj->Load();
+            }
         }
 
         if (!badObjects.empty())
@@ -735,7 +844,7 @@ private:
         if (loadedObject == nullptr)
         {
             // Try to load object
-            object = _objectRepository.LoadObject(ori);
+            object = CreateObject(ori);
             if (object != nullptr)
             {
                 object->Load();
@@ -16,6 +16,8 @@
 #include "../core/Console.hpp"
 #include "../core/DataSerialiser.h"
 #include "../core/FileIndex.hpp"
+#include "../core/FileSystem.hpp"
+#include "../core/BufferedFileStream.h"
 #include "../core/FileStream.h"
 #include "../core/Guard.hpp"
 #include "../core/IStream.hpp"
@@ -76,7 +78,7 @@ class ObjectFileIndex final : public FileIndex<ObjectRepositoryItem>
 {
 private:
     static constexpr uint32_t MAGIC_NUMBER = 0x5844494F; // OIDX
-    static constexpr uint16_t VERSION = 27;
+    static constexpr uint16_t VERSION = 28;
     static constexpr auto PATTERN = "*.dat;*.pob;*.json;*.parkobj";
 
     IObjectRepository& _objectRepository;
@@ -100,11 +102,11 @@ public:
         auto extension = Path::GetExtension(path);
         if (String::Equals(extension, ".json", true))
         {
-            object = ObjectFactory::CreateObjectFromJsonFile(_objectRepository, path);
+            object = ObjectFactory::CreateObjectFromJsonFile(_objectRepository, path, false);
         }
         else if (String::Equals(extension, ".parkobj", true))
         {
-            object = ObjectFactory::CreateObjectFromZipFile(_objectRepository, path);
+            object = ObjectFactory::CreateObjectFromZipFile(_objectRepository, path, false);
         }
         else
         {
@@ -116,6 +118,7 @@ public:
             item.Identifier = object->GetIdentifier();
             item.ObjectEntry = *object->GetObjectEntry();
             item.Path = path;
+            item.FileSize = GetFileSize(path);
             item.Name = object->GetName();
             item.Authors = object->GetAuthors();
             item.Sources = object->GetSourceGames();
@@ -131,6 +134,7 @@ protected:
         ds << item.Identifier;
         ds << item.ObjectEntry;
         ds << item.Path;
+        ds << item.FileSize;
         ds << item.Name;
 
         ds << item.Sources;
@@ -155,6 +159,13 @@ protected:
     }
 
 private:
+    static uint64_t GetFileSize(const std::string& path)
+    {
+        std::error_code ec;
+        auto size = fs::file_size(fs::u8path(path), ec);
+        return ec ? 0 : static_cast<uint64_t>(size);
+    }
+
     bool IsTrackReadOnly(const std::string& path) const
     {
         return String::StartsWith(path, SearchPaths[0]) || String::StartsWith(path, SearchPaths[1]);
@@ -604,7 +615,7 @@ private:
         }
 
         // Read object data from file
-        auto fs = OpenRCT2::FileStream(item->Path, OpenRCT2::FILE_MODE_OPEN);
+        auto fs = OpenRCT2::BufferedFileStream(item->Path);
         auto fileEntry = fs.ReadValue<rct_object_entry>();
         if (!object_entry_compare(entry, &fileEntry))
         {
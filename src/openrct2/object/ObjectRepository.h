@@ -40,6 +40,7 @@ struct ObjectRepositoryItem
     std::string Identifier; // e.g. rct2.c3d
     rct_object_entry ObjectEntry;
     std::string Path;
+    uint64_t FileSize{};
     std::string Name;
     std::vector<std::string> Authors;
     std::vector<ObjectSourceGame> Sources;
@@ -12,6 +12,8 @@
 #include "../Context.h"
 #include "../config/Config.h"
 #include "../core/Guard.hpp"
+#include "../core/MemoryUsage.h"
+#include "../core/Profiling.h"
 #include "../drawing/Drawing.h"
 #include "../interface/Viewport.h"
 #include "../localisation/Localisation.h"
@@ -23,6 +25,10 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 using namespace OpenRCT2;
 
@@ -75,8 +81,80 @@ static constexpr int32_t CalculatePositionHash(const paint_struct& ps, uint8_t r
     return pos.x + pos.y;
 }
 
-static void PaintSessionAddPSToQuadrant(paint_session* session, paint_struct* ps)
+static std::mutex _paintEntryPoolMutex;
+static std::vector<std::unique_ptr<PaintEntryChunk>> _paintEntryChunks;
+static std::vector<PaintEntryChunk*> _paintEntryFreeChunks;
+
+PaintEntryChunk* PaintEntryPoolAcquire()
 {
+    std::lock_guard<std::mutex> lock(_paintEntryPoolMutex);
+    if (_paintEntryFreeChunks.empty())
+    {
+        // Deliberately not value initialised, every entry is written before it is read.
+        _paintEntryChunks.emplace_back(new PaintEntryChunk);
+        MemoryUsageTrack(MemoryUsageCategory::PaintSessions, sizeof(PaintEntryChunk));
+        return _paintEntryChunks.back().get();
+    }
+
+    auto* chunk = _paintEntryFreeChunks.back();
+    _paintEntryFreeChunks.pop_back();
+    return chunk;
+}
+
+void PaintEntryPoolRelease(PaintEntryChunk* const* chunks, size_t count)
+{
+    std::lock_guard<std::mutex> lock(_paintEntryPoolMutex);
+    _paintEntryFreeChunks.insert(_paintEntryFreeChunks.end(), chunks, chunks + count);
+}
+
+uint32_t PaintEntryPoolGetChunkCount()
+{
+    std::lock_guard<std::mutex> lock(_paintEntryPoolMutex);
+    return static_cast<uint32_t>(_paintEntryChunks.size());
+}
+
+void PaintEntryList::AddChunk()
+{
+    auto* chunk = PaintEntryPoolAcquire();
+    _chunks.push_back(chunk);
+    _next = std::begin(chunk->Entries);
+    _end = std::end(chunk->Entries);
+}
+
+size_t PaintEntryList::IndexOf(const void* entry) const
+{
+    auto address = reinterpret_cast<uintptr_t>(entry);
+    for (size_t i = 0; i < _chunks.size(); i++)
+    {
+        auto begin = reinterpret_cast<uintptr_t>(std::begin(_chunks[i]->Entries));
+        if (address >= begin && address < reinterpret_cast<uintptr_t>(std::end(_chunks[i]->Entries)))
+        {
+            auto index = i * PAINT_ENTRY_CHUNK_SIZE + (address - begin) / sizeof(paint_entry);
+            return index < _count ? index : _count;
+        }
+    }
+    return _count;
+}
+
+void PaintEntryList::clear()
+{
+    if (!_chunks.empty())
+    {
+        PaintEntryPoolRelease(_chunks.data(), _chunks.size());
+        _chunks.clear();
+    }
+    _next = nullptr;
+    _end = nullptr;
+    _count = 0;
+}
+
+void PaintSessionAddPSToQuadrant(paint_session* session, paint_struct* ps)
+{
+    if (session->CacheRecording.Active)
+    {
+        session->CacheRecording.Roots.push_back(ps);
+    }
+
     auto positionHash = CalculatePositionHash(*ps, session->CurrentRotation);
     uint32_t paintQuadrantIndex = std::clamp(positionHash / 32, 0, MAX_PAINT_QUADRANTS - 1);
     ps->quadrant_index = paintQuadrantIndex;
@@ -139,9 +217,6 @@ static paint_struct* CreateNormalPaintStruct(
     paint_session* session, const uint32_t image_id, const CoordsXYZ& offset, const CoordsXYZ& boundBoxSize,
     const CoordsXYZ& boundBoxOffset)
 {
-    if (session->NoPaintStructsAvailable())
-        return nullptr;
-
     auto* const g1 = gfx_get_g1_element(image_id & 0x7FFFF);
     if (g1 == nullptr)
     {
@@ -154,7 +229,8 @@ static paint_struct* CreateNormalPaintStruct(
 
     const auto imagePos = translate_3d_to_2d_with_z(session->CurrentRotation, swappedRotCoord);
 
-    if (!ImageWithinDPI(imagePos, *g1, session->DPI))
+    // Recordings for the paint cache are replayed into sessions with other DPIs.
+    if (!session->CacheRecording.Active && !ImageWithinDPI(imagePos, *g1, session->DPI))
     {
         return nullptr;
     }
@@ -164,6 +240,7 @@ static paint_struct* CreateNormalPaintStruct(
 
     paint_struct* ps = session->AllocateNormalPaintEntry();
     ps->image_id = image_id;
+    ps->tertiary_colour = 0;
     ps->x = imagePos.x;
     ps->y = imagePos.y;
     ps->bounds.x_end = rotBoundBoxSize.x + rotBoundBoxOffset.x + session->SpritePosition.x;
@@ -172,11 +249,15 @@ static paint_struct* CreateNormalPaintStruct(
     ps->bounds.x = rotBoundBoxOffset.x + session->SpritePosition.x;
     ps->bounds.y = rotBoundBoxOffset.y + session->SpritePosition.y;
     ps->bounds.z = rotBoundBoxOffset.z;
+    ps->quadrant_index = 0;
     ps->flags = 0;
+    ps->quadrant_flags = 0;
     ps->attached_ps = nullptr;
     ps->children = nullptr;
+    ps->next_quadrant_ps = nullptr;
     ps->sprite_type = session->InteractionType;
     ps->var_29 = 0;
+    ps->pad_2A = 0;
     ps->map_x = session->MapPosition.x;
     ps->map_y = session->MapPosition.y;
     ps->tileElement = reinterpret_cast<TileElement*>(const_cast<void*>(session->CurrentlyDrawnItem));
@@ -383,7 +464,7 @@ static paint_struct* PaintArrangeStructsHelperRotation(paint_struct* ps_next, ui
     }
 }
 
-template<int TRotation> static void PaintSessionArrange(paint_session* session, bool)
+template<int TRotation> static void PaintSessionArrangeLinked(paint_session* session, bool)
 {
     paint_struct* psHead = &session->PaintHead;
 
@@ -419,12 +500,174 @@ template<int TRotation> static void PaintSessionArrange(paint_session* session,
     }
 }
 
+/**
+ * The fields of a paint struct the arrange step reads, about a third of the size of the paint struct
+ * itself. The list is linked by index into the key array rather than by pointer.
+ */
+struct PaintSortKey
+{
+    paint_struct_bound_box Bounds;
+    uint16_t QuadrantIndex;
+    uint16_t Next;
+    uint8_t QuadrantFlags;
+};
+
+static constexpr uint16_t PAINT_SORT_KEY_NULL = std::numeric_limits<uint16_t>::max();
+
+// Reused by every session arranged on the thread so arranging never allocates.
+static thread_local std::vector<PaintSortKey> _sortKeys;
+static thread_local std::vector<paint_struct*> _sortKeyStructs;
+
+/**
+ * Same as PaintArrangeStructsHelperRotation, step for step, but on sort keys so the resulting order
+ * is identical.
+ */
+template<uint8_t TRotation>
+static uint16_t PaintArrangeSortKeysHelperRotation(PaintSortKey* keys, uint16_t next, uint16_t quadrantIndex, uint8_t flag)
+{
+    uint16_t current;
+    uint16_t temp;
+    do
+    {
+        current = next;
+        next = keys[next].Next;
+        if (next == PAINT_SORT_KEY_NULL)
+            return current;
+    } while (quadrantIndex > keys[next].QuadrantIndex);
+
+    // Cache the last visited node so we don't have to walk the whole list again
+    const uint16_t cache = current;
+
+    temp = current;
+    do
+    {
+        current = keys[current].Next;
+        if (current == PAINT_SORT_KEY_NULL)
+            break;
+
+        auto& key = keys[current];
+        if (key.QuadrantIndex > quadrantIndex + 1)
+        {
+            key.QuadrantFlags = PAINT_QUADRANT_FLAG_BIGGER;
+        }
+        else if (key.QuadrantIndex == quadrantIndex + 1)
+        {
+            key.QuadrantFlags = PAINT_QUADRANT_FLAG_NEXT | PAINT_QUADRANT_FLAG_IDENTICAL;
+        }
+        else if (key.QuadrantIndex == quadrantIndex)
+        {
+            key.QuadrantFlags = flag | PAINT_QUADRANT_FLAG_IDENTICAL;
+        }
+    } while (keys[current].QuadrantIndex <= quadrantIndex + 1);
+    current = temp;
+
+    while (true)
+    {
+        while (true)
+        {
+            next = keys[current].Next;
+            if (next == PAINT_SORT_KEY_NULL)
+                return cache;
+            if (keys[next].QuadrantFlags & PAINT_QUADRANT_FLAG_BIGGER)
+                return cache;
+            if (keys[next].QuadrantFlags & PAINT_QUADRANT_FLAG_IDENTICAL)
+                break;
+            current = next;
+        }
+
+        keys[next].QuadrantFlags &= ~PAINT_QUADRANT_FLAG_IDENTICAL;
+        temp = current;
+
+        const paint_struct_bound_box initialBBox = keys[next].Bounds;
+
+        while (true)
+        {
+            current = next;
+            next = keys[next].Next;
+            if (next == PAINT_SORT_KEY_NULL)
+                break;
+            if (keys[next].QuadrantFlags & PAINT_QUADRANT_FLAG_BIGGER)
+                break;
+            if (!(keys[next].QuadrantFlags & PAINT_QUADRANT_FLAG_NEXT))
+                continue;
+
+            if (CheckBoundingBox<TRotation>(initialBBox, keys[next].Bounds))
+            {
+                keys[current].Next = keys[next].Next;
+                keys[next].Next = keys[temp].Next;
+                keys[temp].Next = next;
+                next = current;
+            }
+        }
+
+        current = temp;
+    }
+}
+
+template<int TRotation> static void PaintSessionArrange(paint_session* session, bool)
+{
+    paint_struct* psHead = &session->PaintHead;
+    psHead->next_quadrant_ps = nullptr;
+
+    const uint32_t backIndex = session->QuadrantBackIndex;
+    if (backIndex == UINT32_MAX)
+        return;
+
+    auto& keys = _sortKeys;
+    auto& structs = _sortKeyStructs;
+    const size_t maxKeys = session->PaintStructs.size() + 1;
+    if (keys.capacity() < maxKeys)
+    {
+        keys.reserve(maxKeys);
+        structs.reserve(maxKeys);
+    }
+    keys.clear();
+    structs.clear();
+
+    // Key 0 is the list head, the quadrant lists are appended in back to front order.
+    keys.push_back({ {}, 0, PAINT_SORT_KEY_NULL, 0 });
+    structs.push_back(psHead);
+    for (uint32_t quadrantIndex = backIndex; quadrantIndex <= session->QuadrantFrontIndex; quadrantIndex++)
+    {
+        for (auto* ps = session->Quadrants[quadrantIndex]; ps != nullptr; ps = ps->next_quadrant_ps)
+        {
+            // The keys link to each other with 16 bit indices, sessions with more paint structs than that are
+            // sorted through the paint structs themselves.
+            if (keys.size() >= PAINT_SORT_KEY_NULL)
+            {
+                PaintSessionArrangeLinked<TRotation>(session, true);
+                return;
+            }
+            keys.back().Next = static_cast<uint16_t>(keys.size());
+            keys.push_back({ ps->bounds, ps->quadrant_index, PAINT_SORT_KEY_NULL, ps->quadrant_flags });
+            structs.push_back(ps);
+        }
+    }
+
+    uint16_t cache = PaintArrangeSortKeysHelperRotation<TRotation>(
+        keys.data(), 0, backIndex & 0xFFFF, PAINT_QUADRANT_FLAG_NEXT);
+    for (uint32_t quadrantIndex = backIndex + 1; quadrantIndex < session->QuadrantFrontIndex; quadrantIndex++)
+    {
+        cache = PaintArrangeSortKeysHelperRotation<TRotation>(keys.data(), cache, quadrantIndex & 0xFFFF, 0);
+    }
+
+    // Write the sorted order back to the paint structs for PaintDrawStructs.
+    for (uint16_t index = 0; index != PAINT_SORT_KEY_NULL; index = keys[index].Next)
+    {
+        const auto next = keys[index].Next;
+        structs[index]->next_quadrant_ps = next != PAINT_SORT_KEY_NULL ? structs[next] : nullptr;
+        structs[index]->quadrant_flags = keys[index].QuadrantFlags;
+    }
+}
+
 /**
  *
  *  rct2: 0x00688217
  */
 void PaintSessionArrange(paint_session* session)
 {
+    PROFILE_SCOPE("PaintSessionArrange");
+
     switch (session->CurrentRotation)
     {
         case 0:
@@ -439,6 +682,22 @@ void PaintSessionArrange(paint_session* session)
     Guard::Assert(false);
 }
 
+void PaintSessionArrangeLinked(paint_session* session)
+{
+    switch (session->CurrentRotation)
+    {
+        case 0:
+            return PaintSessionArrangeLinked<0>(session, true);
+        case 1:
+            return PaintSessionArrangeLinked<1>(session, true);
+        case 2:
+            return PaintSessionArrangeLinked<2>(session, true);
+        case 3:
+            return PaintSessionArrangeLinked<3>(session, true);
+    }
+    Guard::Assert(false);
+}
+
 static void PaintDrawStruct(paint_session* session, paint_struct* ps)
 {
     rct_drawpixelinfo* dpi = &session->DPI;
@@ -847,11 +1106,6 @@ paint_struct* PaintAddImageAsChild(
  */
 bool PaintAttachToPreviousAttach(paint_session* session, uint32_t image_id, int16_t x, int16_t y)
 {
-    if (session->NoPaintStructsAvailable())
-    {
-        return false;
-    }
-
     attached_paint_struct* previousAttachedPS = session->LastAttachedPS;
     if (previousAttachedPS == nullptr)
     {
@@ -860,9 +1114,11 @@ bool PaintAttachToPreviousAttach(paint_session* session, uint32_t image_id, int1
 
     attached_paint_struct* ps = session->AllocateAttachedPaintEntry();
     ps->image_id = image_id;
+    ps->tertiary_colour = 0;
     ps->x = x;
     ps->y = y;
     ps->flags = 0;
+    ps->pad_0D = 0;
     ps->next = nullptr;
 
     previousAttachedPS->next = ps;
@@ -880,11 +1136,6 @@ bool PaintAttachToPreviousAttach(paint_session* session, uint32_t image_id, int1
  */
 bool PaintAttachToPreviousPS(paint_session* session, uint32_t image_id, int16_t x, int16_t y)
 {
-    if (session->NoPaintStructsAvailable())
-    {
-        return false;
-    }
-
     paint_struct* masterPs = session->LastPS;
     if (masterPs == nullptr)
     {
@@ -893,9 +1144,11 @@ bool PaintAttachToPreviousPS(paint_session* session, uint32_t image_id, int16_t
 
     attached_paint_struct* ps = session->AllocateAttachedPaintEntry();
     ps->image_id = image_id;
+    ps->tertiary_colour = 0;
     ps->x = x;
     ps->y = y;
     ps->flags = 0;
+    ps->pad_0D = 0;
 
     attached_paint_struct* oldFirstAttached = masterPs->attached_ps;
     masterPs->attached_ps = ps;
@@ -918,11 +1171,6 @@ void PaintFloatingMoneyEffect(
     paint_session* session, money32 amount, rct_string_id string_id, int16_t y, int16_t z, int8_t y_offsets[], int16_t offset_x,
     uint32_t rotation)
 {
-    if (session->NoPaintStructsAvailable())
-    {
-        return;
-    }
-
     const CoordsXYZ position = {
         session->SpritePosition.x,
         session->SpritePosition.y,
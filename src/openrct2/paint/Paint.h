@@ -10,10 +10,12 @@
 #pragma once
 
 #include "../common.h"
-#include "../core/FixedVector.h"
 #include "../drawing/Drawing.h"
 #include "../interface/Colour.h"
 #include "../world/Location.hpp"
+#include "PaintCache.h"
+
+#include <vector>
 
 struct TileElement;
 enum class ViewportInteractionItem : uint8_t;
@@ -106,6 +108,120 @@ union paint_entry
     paint_string_struct string;
 };
 
+constexpr size_t PAINT_ENTRY_CHUNK_SIZE = 1024;
+
+struct PaintEntryChunk
+{
+    paint_entry Entries[PAINT_ENTRY_CHUNK_SIZE];
+};
+
+/**
+ * The pool of chunks shared by all paint sessions. Chunks are kept when they are given back and handed out again
+ * as they are, without clearing them. Can be called from any thread.
+ */
+PaintEntryChunk* PaintEntryPoolAcquire();
+void PaintEntryPoolRelease(PaintEntryChunk* const* chunks, size_t count);
+uint32_t PaintEntryPoolGetChunkCount();
+
+/**
+ * The entries of a paint session, stored in chunks that are taken from the pool one at a time as the session
+ * fills up, so the thread painting the session only locks the pool once per chunk. Entries never move, the
+ * pointers between them stay valid until the list is cleared.
+ *
+ * Copies start out empty, the chunks stay with the list that took them.
+ */
+class PaintEntryList
+{
+private:
+    std::vector<PaintEntryChunk*> _chunks;
+    paint_entry* _next = nullptr;
+    paint_entry* _end = nullptr;
+    size_t _count = 0;
+
+public:
+    PaintEntryList() = default;
+    PaintEntryList(const PaintEntryList&)
+    {
+    }
+    PaintEntryList& operator=(const PaintEntryList&)
+    {
+        clear();
+        return *this;
+    }
+    ~PaintEntryList()
+    {
+        clear();
+    }
+
+    /**
+     * The entry is not initialised, it may still hold what was painted with the chunk before.
+     */
+    paint_entry& emplace_back()
+    {
+        if (_next == _end)
+        {
+            AddChunk();
+        }
+        _count++;
+        return *_next++;
+    }
+
+    /**
+     * Makes sure the next count entries are next to each other in memory, which is only possible when they fit
+     * in the current chunk or a new chunk.
+     */
+    bool ReserveContiguous(size_t count)
+    {
+        if (count <= static_cast<size_t>(_end - _next))
+            return true;
+        if (_next != _end || count > PAINT_ENTRY_CHUNK_SIZE)
+            return false;
+        AddChunk();
+        return true;
+    }
+
+    size_t size() const
+    {
+        return _count;
+    }
+
+    bool empty() const
+    {
+        return _count == 0;
+    }
+
+    paint_entry& operator[](size_t index)
+    {
+        return _chunks[index / PAINT_ENTRY_CHUNK_SIZE]->Entries[index % PAINT_ENTRY_CHUNK_SIZE];
+    }
+
+    const paint_entry& operator[](size_t index) const
+    {
+        return _chunks[index / PAINT_ENTRY_CHUNK_SIZE]->Entries[index % PAINT_ENTRY_CHUNK_SIZE];
+    }
+
+    /**
+     * Returns whether the entries from first up to the end of the list are next to each other in memory.
+     */
+    bool IsContiguous(size_t first) const
+    {
+        return first >= _count || first / PAINT_ENTRY_CHUNK_SIZE == (_count - 1) / PAINT_ENTRY_CHUNK_SIZE;
+    }
+
+    /**
+     * Returns the index of the entry at the given address, or size() if it is not one of the entries.
+     */
+    size_t IndexOf(const void* entry) const;
+
+    /**
+     * Gives the chunks back to the pool.
+     */
+    void clear();
+
+private:
+    void AddChunk();
+};
+
 struct sprite_bb
 {
     uint32_t sprite_id;
@@ -138,7 +254,7 @@ struct tunnel_entry
 struct paint_session
 {
     rct_drawpixelinfo DPI;
-    FixedVector<paint_entry, 4000> PaintStructs;
+    PaintEntryList PaintStructs;
     paint_struct* Quadrants[MAX_PAINT_QUADRANTS];
     paint_struct* LastPS;
     paint_string_struct* PSStringHead;
@@ -149,6 +265,7 @@ struct paint_session
     TileElement* PathElementOnSameHeight;
     TileElement* TrackElementOnSameHeight;
     paint_struct PaintHead;
+    uint32_t AttachedPaintStructCount;
     uint32_t ViewFlags;
     uint32_t QuadrantBackIndex;
     uint32_t QuadrantFrontIndex;
@@ -168,25 +285,22 @@ struct paint_session
     uint8_t Unk141E9DB;
     uint16_t WaterHeight;
     uint32_t TrackColours[4];
+    PaintCacheRecording CacheRecording;
 
-    constexpr bool NoPaintStructsAvailable() noexcept
-    {
-        return PaintStructs.size() >= PaintStructs.capacity();
-    }
-
-    constexpr paint_struct* AllocateNormalPaintEntry() noexcept
+    paint_struct* AllocateNormalPaintEntry()
     {
         LastPS = &PaintStructs.emplace_back().basic;
         return LastPS;
     }
 
-    constexpr attached_paint_struct* AllocateAttachedPaintEntry() noexcept
+    attached_paint_struct* AllocateAttachedPaintEntry()
     {
+        AttachedPaintStructCount++;
         LastAttachedPS = &PaintStructs.emplace_back().attached;
         return LastAttachedPS;
     }
 
-    constexpr paint_string_struct* AllocateStringPaintEntry() noexcept
+    paint_string_struct* AllocateStringPaintEntry()
     {
         auto* string = &PaintStructs.emplace_back().string;
         if (LastPSString == nullptr)
@@ -202,6 +316,16 @@ struct paint_session
     }
 };
 
+/**
+ * A paint session as recorded for the sprite sort benchmark. The entries are copied out of the session, the
+ * pointers between them are stored as indices into Entries with Entries.size() meaning none.
+ */
+struct RecordedPaintSession
+{
+    paint_session Session;
+    std::vector<paint_entry> Entries;
+};
+
 extern paint_session gPaintSession;
 
 // Globals for paint clipping
@@ -260,7 +384,13 @@ void PaintFloatingMoneyEffect(
 paint_session* PaintSessionAlloc(rct_drawpixelinfo* dpi, uint32_t viewFlags);
 void PaintSessionFree(paint_session* session);
 void PaintSessionGenerate(paint_session* session);
+void PaintSessionAddPSToQuadrant(paint_session* session, paint_struct* ps);
 void PaintSessionArrange(paint_session* session);
+/**
+ * The original arrange step that sorts the linked paint structs in place. Gives the same order as
+ * PaintSessionArrange, which sorts compact keys instead; kept to check and benchmark against.
+ */
+void PaintSessionArrangeLinked(paint_session* session);
 void PaintDrawStructs(paint_session* session);
 void PaintDrawMoneyStructs(rct_drawpixelinfo* dpi, paint_string_struct* ps);
 
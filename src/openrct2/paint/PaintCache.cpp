@@ -0,0 +1,556 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "PaintCache.h"
+
+#include "../Cheats.h"
+#include "../OpenRCT2.h"
+#include "../config/Config.h"
+#include "../drawing/Drawing.h"
+#include "../drawing/LightFX.h"
+#include "../interface/Viewport.h"
+#include "../peep/Staff.h"
+#include "../ride/TrackDesign.h"
+#include "../world/Banner.h"
+#include "../world/Map.h"
+#include "../world/Scenery.h"
+#include "../world/SmallScenery.h"
+#include "Paint.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+
+// Everything besides the tile elements that the cacheable element types read while painting.
+struct PaintCacheState
+{
+    uint32_t ViewFlags;
+    ZoomLevel Zoom;
+    uint8_t Rotation;
+    uint8_t Unk141E9DB;
+    uint8_t ClipHeight;
+    uint8_t ScreenFlags;
+    int16_t MapBaseZ;
+    CoordsXY ClipSelectionA;
+    CoordsXY ClipSelectionB;
+    bool SandboxMode;
+    bool WidePathsAsGhost;
+    bool BlockedTiles;
+    bool LandscapeSmoothing;
+    bool UpperCaseBanners;
+
+    bool operator==(const PaintCacheState& other) const
+    {
+        return ViewFlags == other.ViewFlags && Zoom == other.Zoom && Rotation == other.Rotation
+            && Unk141E9DB == other.Unk141E9DB && ClipHeight == other.ClipHeight && ScreenFlags == other.ScreenFlags
+            && MapBaseZ == other.MapBaseZ && ClipSelectionA == other.ClipSelectionA && ClipSelectionB == other.ClipSelectionB
+            && SandboxMode == other.SandboxMode && WidePathsAsGhost == other.WidePathsAsGhost
+            && BlockedTiles == other.BlockedTiles && LandscapeSmoothing == other.LandscapeSmoothing
+            && UpperCaseBanners == other.UpperCaseBanners;
+    }
+};
+
+enum class PaintCacheEntryKind : uint8_t
+{
+    Unused,
+    Normal,
+    Attached,
+};
+
+struct PaintCacheRoot
+{
+    uint16_t Index;
+    // Screen area covered by the root, its children and attachments.
+    int32_t Left;
+    int32_t Top;
+    int32_t Right;
+    int32_t Bottom;
+};
+
+struct PaintCacheTile
+{
+    PaintCacheState State;
+    // Elements of the tile followed by the surface elements of the four adjacent tiles.
+    std::vector<TileElement> Key;
+
+    std::vector<paint_entry> Entries;
+    std::vector<PaintCacheEntryKind> Kinds;
+    std::vector<uint8_t> ElementIndices;
+    std::vector<PaintCacheRoot> Roots;
+    // Address of the first entry when recorded, pointers between entries are relative to it.
+    uintptr_t RecordedBase;
+    int32_t LastPS;
+    int32_t LastAttachedPS;
+    uint8_t LastDrawnElement;
+
+    support_height SupportSegments[9];
+    support_height Support;
+    uint16_t WaterHeight;
+    uint8_t Unk141E9DB;
+    uint8_t VerticalTunnelHeight;
+    bool DidPassSurface;
+    ViewportInteractionItem InteractionType;
+};
+
+static constexpr int32_t PAINT_CACHE_NO_ENTRY = -1;
+static constexpr int32_t PAINT_CACHE_UNCHANGED = -2;
+
+static constexpr size_t PAINT_CACHE_TILE_COUNT = MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL;
+static constexpr size_t PAINT_CACHE_STRIPE_COUNT = 64;
+// Roughly 16 MiB of paint entries, the whole cache is dropped once it holds more.
+static constexpr size_t PAINT_CACHE_MAX_ENTRIES = 320000;
+
+static std::array<std::unique_ptr<PaintCacheTile>, PAINT_CACHE_TILE_COUNT> _paintCacheTiles;
+// Viewport columns are painted in parallel, tiles are guarded by a mutex shared with a few other tiles.
+static std::array<std::mutex, PAINT_CACHE_STRIPE_COUNT> _paintCacheStripes;
+static std::atomic<size_t> _paintCacheEntryCount = { 0 };
+
+static thread_local std::vector<TileElement> _paintCacheKeyScratch;
+
+static size_t PaintCacheGetTileIndex(const CoordsXY& tilePos)
+{
+    auto tileX = tilePos.x / COORDS_XY_STEP;
+    auto tileY = tilePos.y / COORDS_XY_STEP;
+    if (tileX < 0 || tileY < 0 || tileX >= MAXIMUM_MAP_SIZE_TECHNICAL || tileY >= MAXIMUM_MAP_SIZE_TECHNICAL)
+        return PAINT_CACHE_TILE_COUNT;
+    return tileX * MAXIMUM_MAP_SIZE_TECHNICAL + tileY;
+}
+
+static PaintCacheState PaintCacheGetState(const paint_session* session)
+{
+    PaintCacheState state{};
+    state.ViewFlags = session->ViewFlags;
+    state.Zoom = session->DPI.zoom_level;
+    state.Rotation = session->CurrentRotation;
+    state.Unk141E9DB = session->Unk141E9DB;
+    state.ClipHeight = gClipHeight;
+    state.ScreenFlags = gScreenFlags;
+    state.MapBaseZ = gMapBaseZ;
+    state.ClipSelectionA = gClipSelectionA;
+    state.ClipSelectionB = gClipSelectionB;
+    state.SandboxMode = gCheatsSandboxMode;
+    state.WidePathsAsGhost = gPaintWidePathsAsGhost;
+    state.BlockedTiles = gPaintBlockedTiles;
+    state.LandscapeSmoothing = gConfigGeneral.landscape_smoothing;
+    state.UpperCaseBanners = gConfigGeneral.upper_case_banners;
+    return state;
+}
+
+static bool PaintCacheIsElementCacheable(const TileElement& element)
+{
+    switch (element.GetType())
+    {
+        case TILE_ELEMENT_TYPE_SURFACE:
+            return true;
+        case TILE_ELEMENT_TYPE_PATH:
+            // Queue banners show the name and status of the ride.
+            return !element.AsPath()->IsQueue();
+        case TILE_ELEMENT_TYPE_SMALL_SCENERY:
+        {
+            auto* entry = element.AsSmallScenery()->GetEntry();
+            return entry != nullptr && !scenery_small_entry_has_flag(entry, SMALL_SCENERY_FLAG_ANIMATED);
+        }
+        case TILE_ELEMENT_TYPE_WALL:
+        {
+            auto* entry = element.AsWall()->GetEntry();
+            return entry != nullptr && !(entry->wall.flags2 & WALL_SCENERY_2_ANIMATED)
+                && entry->wall.scrolling_mode == SCROLLING_MODE_NONE;
+        }
+        case TILE_ELEMENT_TYPE_LARGE_SCENERY:
+        {
+            auto* entry = element.AsLargeScenery()->GetEntry();
+            return entry != nullptr && entry->large_scenery.scrolling_mode == SCROLLING_MODE_NONE
+                && !(entry->large_scenery.flags & LARGE_SCENERY_FLAG_3D_TEXT);
+        }
+        default:
+            // Tracks, entrances and banners depend on ride and banner state and are often animated.
+            return false;
+    }
+}
+
+static bool PaintCacheIsTileCacheable(const paint_session* session, const TileElement* firstElement)
+{
+    // Modes that highlight tiles based on state outside of the tile elements.
+    if (gTrackDesignSaveMode || gStaffDrawPatrolAreas != SPRITE_INDEX_NULL || (gMapSelectFlags & MAP_SELECT_FLAG_ENABLE_CONSTRUCT))
+        return false;
+
+    // Lamps add lights while they are painted.
+    if (lightfx_is_available())
+        return false;
+
+    const auto& pos = session->MapPosition;
+    if ((gMapSelectFlags & MAP_SELECT_FLAG_ENABLE) && pos.x >= gMapSelectPositionA.x && pos.x <= gMapSelectPositionB.x
+        && pos.y >= gMapSelectPositionA.y && pos.y <= gMapSelectPositionB.y)
+    {
+        return false;
+    }
+
+    if ((gScreenFlags & SCREEN_FLAGS_SCENARIO_EDITOR) || gCheatsSandboxMode)
+    {
+        for (const auto& spawn : gPeepSpawns)
+        {
+            if ((spawn.x & 0xFFE0) == pos.x && (spawn.y & 0xFFE0) == pos.y)
+                return false;
+        }
+    }
+
+    size_t numElements = 0;
+    const auto* element = firstElement;
+    do
+    {
+        if (!PaintCacheIsElementCacheable(*element) || ++numElements > std::numeric_limits<uint8_t>::max())
+            return false;
+    } while (!(element++)->IsLastForTile());
+    return true;
+}
+
+static void PaintCacheGetKey(const CoordsXY& pos, const TileElement* firstElement, std::vector<TileElement>& key)
+{
+    key.clear();
+    const auto* element = firstElement;
+    do
+    {
+        key.push_back(*element);
+    } while (!(element++)->IsLastForTile());
+
+    // Surfaces draw their edges based on the adjacent surfaces.
+    static constexpr const CoordsXY adjacentOffsets[] = { { COORDS_XY_STEP, 0 },
+                                                          { 0, COORDS_XY_STEP },
+                                                          { -COORDS_XY_STEP, 0 },
+                                                          { 0, -COORDS_XY_STEP } };
+    for (const auto& offset : adjacentOffsets)
+    {
+        auto& adjacent = key.emplace_back();
+        std::memset(&adjacent, 0, sizeof(adjacent));
+        const auto* surface = map_get_surface_element_at(pos + offset);
+        if (surface != nullptr)
+        {
+            std::memcpy(&adjacent, surface, sizeof(adjacent));
+        }
+    }
+}
+
+static bool PaintCacheKeyEquals(const std::vector<TileElement>& a, const std::vector<TileElement>& b)
+{
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(TileElement)) == 0;
+}
+
+// Index of the entry ptr points at within [base, base + count), or PAINT_CACHE_NO_ENTRY.
+static int32_t PaintCacheGetEntryIndex(const void* ptr, const paint_entry* base, size_t count)
+{
+    auto offset = reinterpret_cast<uintptr_t>(ptr) - reinterpret_cast<uintptr_t>(base);
+    if (ptr == nullptr || offset % sizeof(paint_entry) != 0 || offset / sizeof(paint_entry) >= count)
+        return PAINT_CACHE_NO_ENTRY;
+    return static_cast<int32_t>(offset / sizeof(paint_entry));
+}
+
+static void PaintCacheExtendBounds(PaintCacheRoot& root, uint32_t imageId, int32_t x, int32_t y)
+{
+    const auto* g1 = gfx_get_g1_element(imageId & 0x7FFFF);
+    if (g1 == nullptr)
+        return;
+
+    const int32_t left = x + g1->x_offset;
+    const int32_t top = y + g1->y_offset;
+    root.Left = std::min(root.Left, left);
+    root.Top = std::min(root.Top, top);
+    root.Right = std::max(root.Right, left + g1->width);
+    root.Bottom = std::max(root.Bottom, top + g1->height);
+}
+
+static std::unique_ptr<PaintCacheTile> PaintCacheCreateTile(paint_session* session, const TileElement* firstElement)
+{
+    const auto& recording = session->CacheRecording;
+    // Replaying relocates the pointers between the entries by their offset, which needs them in one chunk.
+    if (!session->PaintStructs.IsContiguous(recording.FirstEntry))
+        return nullptr;
+
+    const auto count = session->PaintStructs.size() - recording.FirstEntry;
+    const auto* base = count != 0 ? &session->PaintStructs[recording.FirstEntry] : nullptr;
+
+    auto tile = std::make_unique<PaintCacheTile>();
+    PaintCacheGetKey(session->MapPosition, firstElement, tile->Key);
+    const auto numElements = tile->Key.size() - 4;
+
+    auto getElementIndex = [firstElement, numElements](const void* element) -> int32_t {
+        auto offset = reinterpret_cast<uintptr_t>(element) - reinterpret_cast<uintptr_t>(firstElement);
+        if (offset % sizeof(TileElement) != 0 || offset / sizeof(TileElement) >= numElements)
+            return PAINT_CACHE_NO_ENTRY;
+        return static_cast<int32_t>(offset / sizeof(TileElement));
+    };
+
+    tile->Kinds.resize(count, PaintCacheEntryKind::Unused);
+    tile->ElementIndices.resize(count, 0);
+    for (auto* rootPS : recording.Roots)
+    {
+        PaintCacheRoot root{};
+        root.Index = static_cast<uint16_t>(PaintCacheGetEntryIndex(rootPS, base, count));
+        root.Left = root.Top = std::numeric_limits<int32_t>::max();
+        root.Right = root.Bottom = std::numeric_limits<int32_t>::min();
+
+        for (const auto* ps = rootPS; ps != nullptr; ps = ps->children)
+        {
+            // Every entry may only be reached once, anything pointing outside of the tile can not be replayed.
+            auto index = PaintCacheGetEntryIndex(ps, base, count);
+            if (index == PAINT_CACHE_NO_ENTRY || tile->Kinds[index] != PaintCacheEntryKind::Unused)
+                return nullptr;
+
+            auto elementIndex = getElementIndex(ps->tileElement);
+            if (elementIndex == PAINT_CACHE_NO_ENTRY)
+                return nullptr;
+
+            tile->Kinds[index] = PaintCacheEntryKind::Normal;
+            tile->ElementIndices[index] = static_cast<uint8_t>(elementIndex);
+            PaintCacheExtendBounds(root, ps->image_id, ps->x, ps->y);
+
+            for (const auto* attached = ps->attached_ps; attached != nullptr; attached = attached->next)
+            {
+                auto attachedIndex = PaintCacheGetEntryIndex(attached, base, count);
+                if (attachedIndex == PAINT_CACHE_NO_ENTRY || tile->Kinds[attachedIndex] != PaintCacheEntryKind::Unused)
+                    return nullptr;
+
+                tile->Kinds[attachedIndex] = PaintCacheEntryKind::Attached;
+                PaintCacheExtendBounds(root, attached->image_id, ps->x + attached->x, ps->y + attached->y);
+            }
+        }
+        tile->Roots.push_back(root);
+    }
+
+    tile->LastPS = PAINT_CACHE_UNCHANGED;
+    if (session->LastPS != recording.OuterLastPS)
+    {
+        tile->LastPS = PaintCacheGetEntryIndex(session->LastPS, base, count);
+        if (tile->LastPS != PAINT_CACHE_NO_ENTRY && tile->Kinds[tile->LastPS] != PaintCacheEntryKind::Normal)
+            tile->LastPS = PAINT_CACHE_NO_ENTRY;
+    }
+    tile->LastAttachedPS = PAINT_CACHE_UNCHANGED;
+    if (session->LastAttachedPS != recording.OuterLastAttachedPS)
+    {
+        tile->LastAttachedPS = PaintCacheGetEntryIndex(session->LastAttachedPS, base, count);
+        if (tile->LastAttachedPS != PAINT_CACHE_NO_ENTRY
+            && tile->Kinds[tile->LastAttachedPS] != PaintCacheEntryKind::Attached)
+            tile->LastAttachedPS = PAINT_CACHE_NO_ENTRY;
+    }
+
+    auto lastDrawnElement = getElementIndex(session->CurrentlyDrawnItem);
+    if (lastDrawnElement == PAINT_CACHE_NO_ENTRY)
+        return nullptr;
+
+    tile->State = PaintCacheGetState(session);
+    tile->Entries.assign(base, base + count);
+    tile->RecordedBase = reinterpret_cast<uintptr_t>(base);
+    tile->LastDrawnElement = static_cast<uint8_t>(lastDrawnElement);
+    std::copy(std::begin(session->SupportSegments), std::end(session->SupportSegments), std::begin(tile->SupportSegments));
+    tile->Support = session->Support;
+    tile->WaterHeight = session->WaterHeight;
+    tile->Unk141E9DB = session->Unk141E9DB;
+    tile->VerticalTunnelHeight = session->VerticalTunnelHeight;
+    tile->DidPassSurface = session->DidPassSurface;
+    tile->InteractionType = session->InteractionType;
+    return tile;
+}
+
+static bool PaintCacheReplay(paint_session* session, const PaintCacheTile& tile, const TileElement* firstElement)
+{
+    const auto count = tile.Entries.size();
+    if (!session->PaintStructs.ReserveContiguous(count))
+        return false;
+
+    const auto first = session->PaintStructs.size();
+    for (const auto& entry : tile.Entries)
+    {
+        session->PaintStructs.emplace_back() = entry;
+    }
+
+    auto* base = count != 0 ? &session->PaintStructs[first] : nullptr;
+    auto relocate = [&tile, base](auto* ptr) -> decltype(ptr) {
+        if (ptr == nullptr)
+            return nullptr;
+        auto offset = reinterpret_cast<uintptr_t>(ptr) - tile.RecordedBase;
+        return reinterpret_cast<decltype(ptr)>(reinterpret_cast<uintptr_t>(base) + offset);
+    };
+
+    auto* elements = const_cast<TileElement*>(firstElement);
+    for (size_t i = 0; i < count; i++)
+    {
+        switch (tile.Kinds[i])
+        {
+            case PaintCacheEntryKind::Normal:
+            {
+                auto& ps = base[i].basic;
+                ps.attached_ps = relocate(ps.attached_ps);
+                ps.children = relocate(ps.children);
+                ps.next_quadrant_ps = nullptr;
+                ps.tileElement = elements + tile.ElementIndices[i];
+                break;
+            }
+            case PaintCacheEntryKind::Attached:
+                base[i].attached.next = relocate(base[i].attached.next);
+                break;
+            case PaintCacheEntryKind::Unused:
+                break;
+        }
+    }
+
+    // Only roots that can be seen through the session are sorted and drawn, like CreateNormalPaintStruct does.
+    const auto& dpi = session->DPI;
+    for (const auto& root : tile.Roots)
+    {
+        if (root.Right <= dpi.x || root.Bottom <= dpi.y || root.Left >= dpi.x + dpi.width || root.Top >= dpi.y + dpi.height)
+            continue;
+
+        PaintSessionAddPSToQuadrant(session, &base[root.Index].basic);
+    }
+
+    if (tile.LastPS != PAINT_CACHE_UNCHANGED)
+        session->LastPS = tile.LastPS == PAINT_CACHE_NO_ENTRY ? nullptr : &base[tile.LastPS].basic;
+    if (tile.LastAttachedPS != PAINT_CACHE_UNCHANGED)
+        session->LastAttachedPS = tile.LastAttachedPS == PAINT_CACHE_NO_ENTRY ? nullptr : &base[tile.LastAttachedPS].attached;
+
+    session->CurrentlyDrawnItem = elements + tile.LastDrawnElement;
+    std::copy(std::begin(tile.SupportSegments), std::end(tile.SupportSegments), std::begin(session->SupportSegments));
+    session->Support = tile.Support;
+    session->WaterHeight = tile.WaterHeight;
+    session->Unk141E9DB = tile.Unk141E9DB;
+    session->VerticalTunnelHeight = tile.VerticalTunnelHeight;
+    session->DidPassSurface = tile.DidPassSurface;
+    session->InteractionType = tile.InteractionType;
+    return true;
+}
+
+bool PaintCacheBeginTile(paint_session* session, const TileElement* firstElement)
+{
+    auto& recording = session->CacheRecording;
+    recording.Active = false;
+
+    const auto tileIndex = PaintCacheGetTileIndex(session->MapPosition);
+    if (tileIndex >= PAINT_CACHE_TILE_COUNT || !PaintCacheIsTileCacheable(session, firstElement))
+        return false;
+
+    {
+        std::lock_guard<std::mutex> lock(_paintCacheStripes[tileIndex % PAINT_CACHE_STRIPE_COUNT]);
+        const auto* tile = _paintCacheTiles[tileIndex].get();
+        if (tile != nullptr && tile->State == PaintCacheGetState(session))
+        {
+            PaintCacheGetKey(session->MapPosition, firstElement, _paintCacheKeyScratch);
+            if (PaintCacheKeyEquals(tile->Key, _paintCacheKeyScratch))
+            {
+                // Without one chunk with room for the whole tile it is painted again, without recording it.
+                return PaintCacheReplay(session, *tile, firstElement);
+            }
+        }
+    }
+
+    recording.Active = true;
+    recording.FirstEntry = session->PaintStructs.size();
+    recording.Roots.clear();
+    recording.OuterLastPS = session->LastPS;
+    recording.OuterLastPSChildren = session->LastPS != nullptr ? session->LastPS->children : nullptr;
+    recording.OuterLastPSAttached = session->LastPS != nullptr ? session->LastPS->attached_ps : nullptr;
+    recording.OuterLastAttachedPS = session->LastAttachedPS;
+    recording.OuterLastAttachedNext = session->LastAttachedPS != nullptr ? session->LastAttachedPS->next : nullptr;
+    recording.OuterPrependTo = session->WoodenSupportsPrependTo;
+    recording.OuterPrependToChildren = session->WoodenSupportsPrependTo != nullptr ? session->WoodenSupportsPrependTo->children
+                                                                                   : nullptr;
+    return false;
+}
+
+void PaintCacheEndTile(paint_session* session, const TileElement* firstElement, bool completed)
+{
+    auto& recording = session->CacheRecording;
+    if (!recording.Active)
+        return;
+
+    recording.Active = false;
+    if (!completed)
+        return;
+
+    // The tile must not have changed any paint struct created before it.
+    if (session->WoodenSupportsPrependTo != recording.OuterPrependTo
+        || (recording.OuterPrependTo != nullptr && recording.OuterPrependTo->children != recording.OuterPrependToChildren)
+        || (recording.OuterLastPS != nullptr
+            && (recording.OuterLastPS->children != recording.OuterLastPSChildren
+                || recording.OuterLastPS->attached_ps != recording.OuterLastPSAttached))
+        || (recording.OuterLastAttachedPS != nullptr && recording.OuterLastAttachedPS->next != recording.OuterLastAttachedNext))
+    {
+        return;
+    }
+
+    const auto tileIndex = PaintCacheGetTileIndex(session->MapPosition);
+    if (tileIndex >= PAINT_CACHE_TILE_COUNT)
+        return;
+
+    auto tile = PaintCacheCreateTile(session, firstElement);
+    if (tile == nullptr)
+        return;
+
+    if (_paintCacheEntryCount.load(std::memory_order_relaxed) > PAINT_CACHE_MAX_ENTRIES)
+    {
+        PaintCacheInvalidateAll();
+    }
+
+    std::lock_guard<std::mutex> lock(_paintCacheStripes[tileIndex % PAINT_CACHE_STRIPE_COUNT]);
+    auto& slot = _paintCacheTiles[tileIndex];
+    if (slot != nullptr)
+    {
+        _paintCacheEntryCount -= slot->Entries.size();
+    }
+    _paintCacheEntryCount += tile->Entries.size();
+    slot = std::move(tile);
+}
+
+void PaintCacheInvalidateTile(const CoordsXY& tilePos)
+{
+    const auto tileIndex = PaintCacheGetTileIndex(tilePos.ToTileStart());
+    if (tileIndex >= PAINT_CACHE_TILE_COUNT)
+        return;
+
+    std::lock_guard<std::mutex> lock(_paintCacheStripes[tileIndex % PAINT_CACHE_STRIPE_COUNT]);
+    auto& slot = _paintCacheTiles[tileIndex];
+    if (slot != nullptr)
+    {
+        _paintCacheEntryCount -= slot->Entries.size();
+        slot = nullptr;
+    }
+}
+
+void PaintCacheInvalidateRegion(const CoordsXY& mins, const CoordsXY& maxs)
+{
+    constexpr int32_t maxTileStart = (MAXIMUM_MAP_SIZE_TECHNICAL - 1) * COORDS_XY_STEP;
+    const auto start = CoordsXY{ std::max(mins.x, 0), std::max(mins.y, 0) }.ToTileStart();
+    const auto end = CoordsXY{ std::min(maxs.x, maxTileStart), std::min(maxs.y, maxTileStart) }.ToTileStart();
+    for (int32_t y = start.y; y <= end.y; y += COORDS_XY_STEP)
+    {
+        for (int32_t x = start.x; x <= end.x; x += COORDS_XY_STEP)
+        {
+            PaintCacheInvalidateTile({ x, y });
+        }
+    }
+}
+
+void PaintCacheInvalidateAll()
+{
+    for (size_t stripe = 0; stripe < PAINT_CACHE_STRIPE_COUNT; stripe++)
+    {
+        std::lock_guard<std::mutex> lock(_paintCacheStripes[stripe]);
+        for (size_t tileIndex = stripe; tileIndex < PAINT_CACHE_TILE_COUNT; tileIndex += PAINT_CACHE_STRIPE_COUNT)
+        {
+            auto& slot = _paintCacheTiles[tileIndex];
+            if (slot != nullptr)
+            {
+                _paintCacheEntryCount -= slot->Entries.size();
+                slot = nullptr;
+            }
+        }
+    }
+}
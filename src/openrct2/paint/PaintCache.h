@@ -0,0 +1,57 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "../world/Location.hpp"
+
+#include <vector>
+
+struct attached_paint_struct;
+struct paint_session;
+struct paint_struct;
+struct TileElement;
+
+/**
+ * State of a tile that is being recorded into the paint cache. The paint structs created for the
+ * tile are not culled against the session DPI so the recording can be replayed into any session.
+ */
+struct PaintCacheRecording
+{
+    bool Active;
+    size_t FirstEntry;
+    std::vector<paint_struct*> Roots;
+
+    // Paint structs created before the tile, the recording is discarded if the tile modified them.
+    paint_struct* OuterLastPS;
+    paint_struct* OuterLastPSChildren;
+    attached_paint_struct* OuterLastPSAttached;
+    attached_paint_struct* OuterLastAttachedPS;
+    attached_paint_struct* OuterLastAttachedNext;
+    paint_struct* OuterPrependTo;
+    paint_struct* OuterPrependToChildren;
+};
+
+/**
+ * Replays the cached paint structs of the tile elements at session->MapPosition if the tile and
+ * the view state have not changed since they were recorded. Otherwise returns false and, if the
+ * tile can be cached, starts recording the paint structs the caller creates for the tile.
+ */
+bool PaintCacheBeginTile(paint_session* session, const TileElement* firstElement);
+
+/**
+ * Stores the recording started by PaintCacheBeginTile, completed is false if painting the tile
+ * stopped early.
+ */
+void PaintCacheEndTile(paint_session* session, const TileElement* firstElement, bool completed);
+
+void PaintCacheInvalidateTile(const CoordsXY& tilePos);
+void PaintCacheInvalidateRegion(const CoordsXY& mins, const CoordsXY& maxs);
+void PaintCacheInvalidateAll();
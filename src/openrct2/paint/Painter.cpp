@@ -14,10 +14,14 @@
 #include "../OpenRCT2.h"
 #include "../ReplayManager.h"
 #include "../config/Config.h"
+#include "../core/MemoryUsage.h"
+#include "../core/Profiling.h"
 #include "../drawing/Drawing.h"
+#include "../drawing/FrameStatistics.h"
 #include "../drawing/IDrawingEngine.h"
 #include "../interface/Chat.h"
 #include "../interface/InteractiveConsole.h"
+#include "../interface/Window.h"
 #include "../localisation/FormatCodes.h"
 #include "../localisation/Formatting.h"
 #include "../localisation/Language.h"
@@ -25,6 +29,10 @@
 #include "../title/TitleScreen.h"
 #include "../ui/UiContext.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
 using namespace OpenRCT2;
 using namespace OpenRCT2::Drawing;
 using namespace OpenRCT2::Paint;
@@ -35,8 +43,17 @@ Painter::Painter(const std::shared_ptr<IUiContext>& uiContext)
 {
 }
 
+Painter::~Painter()
+{
+    MemoryUsageTrack(
+        MemoryUsageCategory::PaintSessions, -static_cast<int64_t>(_paintSessionPool.size() * sizeof(paint_session)));
+}
+
 void Painter::Paint(IDrawingEngine& de)
 {
+    PROFILE_SCOPE("Painter::Paint");
+    auto startTime = std::chrono::steady_clock::now();
+
     auto dpi = de.GetDrawingPixelInfo();
     if (gIntroState != IntroState::None)
     {
@@ -44,6 +61,7 @@ void Painter::Paint(IDrawingEngine& de)
     }
     else
     {
+        window_flush_invalidations();
         de.PaintWindows();
 
         update_palette_effects();
@@ -77,6 +95,12 @@ void Painter::Paint(IDrawingEngine& de)
     {
         PaintFPS(dpi);
     }
+    if (FrameStatisticsIsEnabled())
+    {
+        PaintFrameStatistics(dpi);
+        FrameStatisticsAddTiming(FrameTiming::Total, std::chrono::steady_clock::now() - startTime);
+        FrameStatisticsEndFrame();
+    }
     gCurrentDrawCount++;
 }
 
@@ -115,6 +139,102 @@ void Painter::PaintFPS(rct_drawpixelinfo* dpi)
     gfx_set_dirty_blocks({ { screenCoords - ScreenCoordsXY{ 16, 4 } }, { gLastDrawStringX + 16, 16 } });
 }
 
+void Painter::PaintFrameStatistics(rct_drawpixelinfo* dpi)
+{
+    constexpr int32_t barWidth = 2;
+    constexpr int32_t graphHeight = 50;
+    // Two pixels per millisecond, so a frame at 30 FPS fills the graph
+    constexpr int64_t microsecondsPerPixel = 500;
+    constexpr int64_t targetFrameTime = 16667;
+
+    auto history = FrameStatisticsGetHistory();
+    if (history.empty())
+        return;
+
+    const auto& frame = history.back();
+    auto ms = [&frame](FrameTiming timing) { return frame.GetTiming(timing) / 1000.0; };
+    auto viewports = frame.GetTiming(FrameTiming::Viewports);
+    auto textCacheLookups = frame.TextCacheHits + frame.TextCacheMisses;
+
+    auto memoryUsage = MemoryUsageGetReport();
+    auto mib = [&memoryUsage](MemoryUsageCategory category) { return memoryUsage.Get(category) / (1024.0 * 1024.0); };
+
+    char lines[5][128]{};
+    std::snprintf(
+        lines[0], sizeof(lines[0]), "Frame %.2f ms, viewports %.2f ms, windows %.2f ms", ms(FrameTiming::Total),
+        ms(FrameTiming::Viewports), std::max<int64_t>(0, frame.GetTiming(FrameTiming::Windows) - viewports) / 1000.0);
+    std::snprintf(
+        lines[1], sizeof(lines[1]), "Generate %.2f ms, arrange %.2f ms, draw %.2f ms", ms(FrameTiming::PaintGenerate),
+        ms(FrameTiming::PaintArrange), ms(FrameTiming::PaintDraw));
+    std::snprintf(
+        lines[2], sizeof(lines[2]), "%u sessions, %u paint structs (peak %u), %u attached, %u chunks", frame.Sessions,
+        frame.PaintStructs, frame.PeakSessionPaintStructs, frame.AttachedPaintStructs, frame.PaintEntryChunks);
+    std::snprintf(
+        lines[3], sizeof(lines[3]), "%llu pixels redrawn, %u texture uploads, text cache %.1f%% hits",
+        static_cast<unsigned long long>(frame.PixelsRedrawn), frame.TextureUploads,
+        textCacheLookups == 0 ? 100.0 : frame.TextCacheHits * 100.0 / textCacheLookups);
+    std::snprintf(
+        lines[4], sizeof(lines[4]), "Memory %.1f MiB: map %.1f, entities %.1f, images %.1f, textures %.1f, paint %.1f",
+        memoryUsage.GetTotal() / (1024.0 * 1024.0), mib(MemoryUsageCategory::TileElements),
+        mib(MemoryUsageCategory::Entities), mib(MemoryUsageCategory::ObjectImages), mib(MemoryUsageCategory::TextureCache),
+        mib(MemoryUsageCategory::PaintSessions));
+
+    auto lineHeight = font_get_line_height(FontSpriteBase::MEDIUM);
+    ScreenCoordsXY topLeft(4, 32);
+    auto graphTop = topLeft.y + static_cast<int32_t>(std::size(lines)) * lineHeight + 2;
+    auto graphBottom = graphTop + graphHeight;
+    auto graphRight = topLeft.x + static_cast<int32_t>(FRAME_STATISTICS_HISTORY_SIZE) * barWidth;
+
+    char buffers[std::size(lines)][160]{};
+    auto right = graphRight;
+    for (size_t i = 0; i < std::size(lines); i++)
+    {
+        FormatStringToBuffer(buffers[i], sizeof(buffers[i]), "{OUTLINE}{WHITE}{STRING}", lines[i]);
+        right = std::max(right, topLeft.x + gfx_get_string_width(buffers[i], FontSpriteBase::MEDIUM));
+    }
+
+    gfx_filter_rect(dpi, { topLeft - ScreenCoordsXY{ 2, 2 }, { right + 2, graphBottom + 2 } }, FilterPaletteID::Palette51);
+    for (size_t i = 0; i < std::size(lines); i++)
+    {
+        gfx_draw_string(dpi, topLeft + ScreenCoordsXY{ 0, static_cast<int32_t>(i) * lineHeight }, buffers[i]);
+    }
+
+    // The darker part of each bar is the time spent painting viewports
+    auto x = topLeft.x + static_cast<int32_t>(FRAME_STATISTICS_HISTORY_SIZE - history.size()) * barWidth;
+    for (const auto& item : history)
+    {
+        auto total = item.GetTiming(FrameTiming::Total);
+        auto totalHeight = static_cast<int32_t>(std::min<int64_t>(graphHeight, total / microsecondsPerPixel));
+        auto viewportHeight = static_cast<int32_t>(
+            std::min<int64_t>(totalHeight, item.GetTiming(FrameTiming::Viewports) / microsecondsPerPixel));
+        colour_t colour = COLOUR_BRIGHT_GREEN;
+        if (total > targetFrameTime * 2)
+            colour = COLOUR_BRIGHT_RED;
+        else if (total > targetFrameTime)
+            colour = COLOUR_YELLOW;
+
+        if (totalHeight > 0)
+        {
+            gfx_fill_rect(
+                dpi, { { x, graphBottom - totalHeight }, { x + barWidth - 1, graphBottom - 1 } },
+                ColourMapA[colour].lighter);
+        }
+        if (viewportHeight > 0)
+        {
+            gfx_fill_rect(
+                dpi, { { x, graphBottom - viewportHeight }, { x + barWidth - 1, graphBottom - 1 } },
+                ColourMapA[colour].mid_dark);
+        }
+        x += barWidth;
+    }
+
+    auto targetY = graphBottom - static_cast<int32_t>(targetFrameTime / microsecondsPerPixel);
+    gfx_fill_rect(dpi, { { topLeft.x, targetY }, { graphRight - 1, targetY } }, ColourMapA[COLOUR_WHITE].lighter);
+
+    // Make area dirty so the overlay doesn't get drawn over the last
+    gfx_set_dirty_blocks({ topLeft - ScreenCoordsXY{ 2, 2 }, { right + 2, graphBottom + 2 } });
+}
+
 void Painter::MeasureFPS()
 {
     _frames++;
@@ -145,6 +265,7 @@ paint_session* Painter::CreateSession(rct_drawpixelinfo* dpi, uint32_t viewFlags
         // Create new one in pool.
         _paintSessionPool.emplace_back(std::make_unique<paint_session>());
         session = _paintSessionPool.back().get();
+        MemoryUsageTrack(MemoryUsageCategory::PaintSessions, sizeof(paint_session));
     }
 
     session->DPI = *dpi;
@@ -156,9 +277,11 @@ paint_session* Painter::CreateSession(rct_drawpixelinfo* dpi, uint32_t viewFlags
     std::fill(std::begin(session->Quadrants), std::end(session->Quadrants), nullptr);
     session->LastPS = nullptr;
     session->LastAttachedPS = nullptr;
+    session->AttachedPaintStructCount = 0;
     session->PSStringHead = nullptr;
     session->LastPSString = nullptr;
     session->WoodenSupportsPrependTo = nullptr;
+    session->CacheRecording.Active = false;
     session->CurrentlyDrawnItem = nullptr;
     session->SurfaceElement = nullptr;
 
@@ -167,5 +290,7 @@ paint_session* Painter::CreateSession(rct_drawpixelinfo* dpi, uint32_t viewFlags
 
 void Painter::ReleaseSession(paint_session* session)
 {
+    // Give the chunks back right away so the busier sessions of the next frame can use them.
+    session->PaintStructs.clear();
     _freePaintSessions.push_back(session);
 }
@@ -44,6 +44,7 @@ namespace OpenRCT2
 
         public:
             explicit Painter(const std::shared_ptr<Ui::IUiContext>& uiContext);
+            ~Painter();
             void Paint(Drawing::IDrawingEngine& de);
 
             paint_session* CreateSession(rct_drawpixelinfo* dpi, uint32_t viewFlags);
@@ -52,6 +53,7 @@ namespace OpenRCT2
         private:
             void PaintReplayNotice(rct_drawpixelinfo* dpi, const char* text);
             void PaintFPS(rct_drawpixelinfo* dpi);
+            void PaintFrameStatistics(rct_drawpixelinfo* dpi);
             void MeasureFPS();
         };
     } // namespace Paint
@@ -23,7 +23,9 @@
 #include "tile_element/Paint.TileElement.h"
 
 #include <algorithm>
+#include <atomic>
 #include <limits>
+#include <memory>
 
 using namespace OpenRCT2;
 
@@ -40,6 +42,72 @@ enum VirtualFloorFlags
     VIRTUAL_FLOOR_FORCE_INVALIDATION = (1 << 2),
 };
 
+// What the elements of a tile look like at the virtual floor height, the edges are kept in the upper byte.
+enum VirtualFloorTileProperties : uint16_t
+{
+    VIRTUAL_FLOOR_TILE_KNOWN = (1 << 0),
+    VIRTUAL_FLOOR_TILE_OCCUPIED = (1 << 1),
+    VIRTUAL_FLOOR_TILE_BELOW_GROUND = (1 << 2),
+    VIRTUAL_FLOOR_TILE_ABOVE_GROUND = (1 << 3),
+    VIRTUAL_FLOOR_TILE_OWNED = (1 << 4),
+    VIRTUAL_FLOOR_TILE_GHOST = (1 << 5),
+};
+
+/**
+ * The tile properties of the area around the selection, filled in as the tiles are painted and cleared whenever the
+ * height or area changes or a tile is invalidated. Viewport columns are painted in parallel, so two threads can fill
+ * in the same tile, which is harmless as they compute the same value.
+ */
+struct VirtualFloorGrid
+{
+    TileCoordsXY Min;
+    TileCoordsXY Max;
+    int16_t Height{};
+    size_t Width{};
+    size_t Size{};
+    std::unique_ptr<std::atomic<uint16_t>[]> Tiles;
+
+    std::atomic<uint16_t>* GetTile(const CoordsXY& loc)
+    {
+        TileCoordsXY tileLoc(loc);
+        if (Tiles == nullptr || Height != _virtualFloorHeight || tileLoc.x < Min.x || tileLoc.y < Min.y
+            || tileLoc.x > Max.x || tileLoc.y > Max.y)
+        {
+            return nullptr;
+        }
+        return &Tiles[(tileLoc.y - Min.y) * Width + (tileLoc.x - Min.x)];
+    }
+
+    void Clear()
+    {
+        for (size_t i = 0; i < Size; i++)
+        {
+            Tiles[i].store(0, std::memory_order_relaxed);
+        }
+        Height = _virtualFloorHeight;
+    }
+};
+
+static VirtualFloorGrid _virtualFloorGrid;
+
+static void virtual_floor_set_grid_area(const CoordsXY& min_position, const CoordsXY& max_position)
+{
+    // The neighbouring tiles of the edges are looked at as well.
+    TileCoordsXY min(min_position - CoordsXY{ COORDS_XY_STEP, COORDS_XY_STEP });
+    TileCoordsXY max(max_position + CoordsXY{ COORDS_XY_STEP, COORDS_XY_STEP });
+
+    auto& grid = _virtualFloorGrid;
+    if (grid.Tiles == nullptr || grid.Min != min || grid.Max != max)
+    {
+        grid.Min = min;
+        grid.Max = max;
+        grid.Width = max.x - min.x + 1;
+        grid.Size = grid.Width * (max.y - min.y + 1);
+        grid.Tiles = std::make_unique<std::atomic<uint16_t>[]>(grid.Size);
+    }
+    grid.Clear();
+}
+
 bool virtual_floor_is_enabled()
 {
     return (_virtualFloorFlags & VIRTUAL_FLOOR_FLAG_ENABLED) != 0;
@@ -56,6 +124,10 @@ void virtual_floor_set_height(int16_t height)
     {
         virtual_floor_invalidate();
         _virtualFloorHeight = height;
+        if (_virtualFloorGrid.Tiles != nullptr)
+        {
+            _virtualFloorGrid.Clear();
+        }
     }
 }
 
@@ -66,6 +138,7 @@ static void virtual_floor_reset()
     _virtualFloorLastMaxPos.x = std::numeric_limits<int32_t>::lowest();
     _virtualFloorLastMaxPos.y = std::numeric_limits<int32_t>::lowest();
     _virtualFloorHeight = 0;
+    _virtualFloorGrid = {};
 }
 
 void virtual_floor_enable()
@@ -159,6 +232,7 @@ void virtual_floor_invalidate()
         && max_position.x != std::numeric_limits<int32_t>::lowest() && max_position.y != std::numeric_limits<int32_t>::lowest())
     {
         map_invalidate_region(min_position, max_position);
+        virtual_floor_set_grid_area(min_position, max_position);
 
         // Save minimal and maximal positions.
         _virtualFloorLastMinPos.x = min_position.x;
@@ -202,44 +276,16 @@ bool virtual_floor_tile_is_floor(const CoordsXY& loc)
     return false;
 }
 
-static void virtual_floor_get_tile_properties(
-    const CoordsXY& loc, int16_t height, bool* outOccupied, bool* tileOwned, uint8_t* outOccupiedEdges, bool* outBelowGround,
-    bool* aboveGround, bool* outLit)
+static uint16_t virtual_floor_compute_tile_properties(const CoordsXY& loc, int16_t height)
 {
-    *outOccupied = false;
-    *outOccupiedEdges = 0;
-    *outBelowGround = false;
-    *outLit = false;
-    *aboveGround = false;
-    *tileOwned = false;
-
-    // See if we are a selected tile
-    if ((gMapSelectFlags & MAP_SELECT_FLAG_ENABLE))
-    {
-        if (loc >= gMapSelectPositionA && loc <= gMapSelectPositionB)
-        {
-            *outLit = true;
-        }
-    }
+    uint16_t properties = VIRTUAL_FLOOR_TILE_KNOWN;
+    uint8_t occupiedEdges = 0;
 
-    // See if we are on top of the selection tiles
-    if (gMapSelectFlags & MAP_SELECT_FLAG_ENABLE_CONSTRUCT)
+    if (map_is_location_owned({ loc, height }))
     {
-        for (const auto& tile : gMapSelectionTiles)
-        {
-            if (tile == loc)
-            {
-                *outLit = true;
-                break;
-            }
-        }
+        properties |= VIRTUAL_FLOOR_TILE_OWNED;
     }
 
-    *tileOwned = map_is_location_owned({ loc, height });
-
-    if (gCheatsSandboxMode)
-        *tileOwned = true;
-
     // Iterate through the map elements of the current tile to find:
     //  * Surfaces, which may put us underground
     //  * Walls / banners, which are displayed as occupied edges
@@ -252,16 +298,15 @@ static void virtual_floor_get_tile_properties(
         {
             if (height < tileElement->GetClearanceZ())
             {
-                *outBelowGround = true;
+                properties |= VIRTUAL_FLOOR_TILE_BELOW_GROUND;
             }
             else if (height < (tileElement->GetBaseZ() + LAND_HEIGHT_STEP) && tileElement->AsSurface()->GetSlope() != 0)
             {
-                *outBelowGround = true;
-                *outOccupied = true;
+                properties |= VIRTUAL_FLOOR_TILE_BELOW_GROUND | VIRTUAL_FLOOR_TILE_OCCUPIED;
             }
             if (height > tileElement->GetBaseZ())
             {
-                *aboveGround = true;
+                properties |= VIRTUAL_FLOOR_TILE_ABOVE_GROUND;
             }
             continue;
         }
@@ -274,17 +319,106 @@ static void virtual_floor_get_tile_properties(
         if (elementType == TILE_ELEMENT_TYPE_WALL || elementType == TILE_ELEMENT_TYPE_BANNER)
         {
             int32_t direction = tileElement->GetDirection();
-            *outOccupiedEdges |= 1 << direction;
+            occupiedEdges |= 1 << direction;
             continue;
         }
 
         if (tileElement->IsGhost())
         {
-            *outLit = true;
+            properties |= VIRTUAL_FLOOR_TILE_GHOST;
             continue;
         }
 
-        *outOccupied = true;
+        properties |= VIRTUAL_FLOOR_TILE_OCCUPIED;
+    }
+
+    return properties | (occupiedEdges << 8);
+}
+
+static void virtual_floor_get_tile_properties(
+    const CoordsXY& loc, int16_t height, bool* outOccupied, bool* tileOwned, uint8_t* outOccupiedEdges, bool* outBelowGround,
+    bool* aboveGround, bool* outLit)
+{
+    *outOccupied = false;
+    *outOccupiedEdges = 0;
+    *outBelowGround = false;
+    *outLit = false;
+    *aboveGround = false;
+    *tileOwned = false;
+
+    // See if we are a selected tile
+    if ((gMapSelectFlags & MAP_SELECT_FLAG_ENABLE))
+    {
+        if (loc >= gMapSelectPositionA && loc <= gMapSelectPositionB)
+        {
+            *outLit = true;
+        }
+    }
+
+    // See if we are on top of the selection tiles
+    if (gMapSelectFlags & MAP_SELECT_FLAG_ENABLE_CONSTRUCT)
+    {
+        for (const auto& tile : gMapSelectionTiles)
+        {
+            if (tile == loc)
+            {
+                *outLit = true;
+                break;
+            }
+        }
+    }
+
+    // The elements of the tile are only looked at again once it has been invalidated
+    auto* cachedTile = _virtualFloorGrid.GetTile(loc);
+    uint16_t properties = cachedTile != nullptr ? cachedTile->load(std::memory_order_relaxed) : 0;
+    if (!(properties & VIRTUAL_FLOOR_TILE_KNOWN))
+    {
+        properties = virtual_floor_compute_tile_properties(loc, height);
+        if (cachedTile != nullptr)
+        {
+            cachedTile->store(properties, std::memory_order_relaxed);
+        }
+    }
+
+    *outOccupied = (properties & VIRTUAL_FLOOR_TILE_OCCUPIED) != 0;
+    *outBelowGround = (properties & VIRTUAL_FLOOR_TILE_BELOW_GROUND) != 0;
+    *aboveGround = (properties & VIRTUAL_FLOOR_TILE_ABOVE_GROUND) != 0;
+    *tileOwned = (properties & VIRTUAL_FLOOR_TILE_OWNED) != 0 || gCheatsSandboxMode;
+    *outOccupiedEdges = properties >> 8;
+    if (properties & VIRTUAL_FLOOR_TILE_GHOST)
+    {
+        *outLit = true;
+    }
+}
+
+void virtual_floor_invalidate_tiles(const CoordsXY& mins, const CoordsXY& maxs)
+{
+    auto& grid = _virtualFloorGrid;
+    if (grid.Tiles == nullptr)
+    {
+        return;
+    }
+
+    TileCoordsXY min(mins);
+    TileCoordsXY max(maxs);
+    min.x = std::max(min.x, grid.Min.x);
+    min.y = std::max(min.y, grid.Min.y);
+    max.x = std::min(max.x, grid.Max.x);
+    max.y = std::min(max.y, grid.Max.y);
+    for (int32_t y = min.y; y <= max.y; y++)
+    {
+        for (int32_t x = min.x; x <= max.x; x++)
+        {
+            grid.Tiles[(y - grid.Min.y) * grid.Width + (x - grid.Min.x)].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+void virtual_floor_invalidate_all_tiles()
+{
+    if (_virtualFloorGrid.Tiles != nullptr)
+    {
+        _virtualFloorGrid.Clear();
     }
 }
 
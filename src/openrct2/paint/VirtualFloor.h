@@ -33,4 +33,10 @@ void virtual_floor_invalidate();
 
 bool virtual_floor_tile_is_floor(const CoordsXY& loc);
 
+/**
+ * Forgets what the elements of the tiles looked like, for when they have changed.
+ */
+void virtual_floor_invalidate_tiles(const CoordsXY& mins, const CoordsXY& maxs);
+void virtual_floor_invalidate_all_tiles();
+
 void virtual_floor_paint(paint_session* session);
@@ -26,6 +26,7 @@
 #include "../../world/Sprite.h"
 #include "../../world/Surface.h"
 #include "../Paint.h"
+#include "../PaintCache.h"
 #include "../Supports.h"
 #include "../VirtualFloor.h"
 #include "Paint.Surface.h"
@@ -38,6 +39,7 @@ uint16_t testPaintVerticalTunnelHeight;
 
 static void blank_tiles_paint(paint_session* session, int32_t x, int32_t y);
 static void sub_68B3FB(paint_session* session, int32_t x, int32_t y);
+static bool paint_tile_elements(paint_session* session, TileElement* tile_element);
 
 const int32_t SEGMENTS_ALL = SEGMENT_B4 | SEGMENT_B8 | SEGMENT_BC | SEGMENT_C0 | SEGMENT_C4 | SEGMENT_C8 | SEGMENT_CC
     | SEGMENT_D0 | SEGMENT_D4;
@@ -128,6 +130,103 @@ static void blank_tiles_paint(paint_session* session, int32_t x, int32_t y)
     PaintAddImageAsParent(session, SPR_BLANK_TILE, 0, 0, 32, 32, -1, 16);
 }
 
+/**
+ * Paints all elements of the tile starting at tile_element, returns false if a corrupt element
+ * stopped painting of the remaining elements.
+ */
+static bool paint_tile_elements(paint_session* session, TileElement* tile_element)
+{
+    uint8_t rotation = session->CurrentRotation;
+    int32_t previousBaseZ = 0;
+    do
+    {
+        // Only paint tile_elements below the clip height.
+        if ((session->ViewFlags & VIEWPORT_FLAG_CLIP_VIEW) && (tile_element->GetBaseZ() > gClipHeight * COORDS_Z_STEP))
+            continue;
+
+        Direction direction = tile_element->GetDirectionWithOffset(rotation);
+        int32_t baseZ = tile_element->GetBaseZ();
+
+        // If we are on a new baseZ level, look through elements on the
+        //  same baseZ and store any types might be relevant to others
+        if (baseZ != previousBaseZ)
+        {
+            previousBaseZ = baseZ;
+            session->PathElementOnSameHeight = nullptr;
+            session->TrackElementOnSameHeight = nullptr;
+            TileElement* tile_element_sub_iterator = tile_element;
+            while (!(tile_element_sub_iterator++)->IsLastForTile())
+            {
+                if (tile_element_sub_iterator->GetBaseZ() != tile_element->GetBaseZ())
+                {
+                    break;
+                }
+                switch (tile_element_sub_iterator->GetType())
+                {
+                    case TILE_ELEMENT_TYPE_PATH:
+                        session->PathElementOnSameHeight = tile_element_sub_iterator;
+                        break;
+                    case TILE_ELEMENT_TYPE_TRACK:
+                        session->TrackElementOnSameHeight = tile_element_sub_iterator;
+                        break;
+                    case TILE_ELEMENT_TYPE_CORRUPT:
+                        // To preserve regular behaviour, make an element hidden by
+                        //  corruption also invisible to this method.
+                        if (tile_element->IsLastForTile())
+                        {
+                            break;
+                        }
+                        tile_element_sub_iterator++;
+                        break;
+                }
+            }
+        }
+
+        CoordsXY mapPosition = session->MapPosition;
+        session->CurrentlyDrawnItem = tile_element;
+        // Setup the painting of for example: the underground, signs, rides, scenery, etc.
+        switch (tile_element->GetType())
+        {
+            case TILE_ELEMENT_TYPE_SURFACE:
+                surface_paint(session, direction, baseZ, tile_element);
+                break;
+            case TILE_ELEMENT_TYPE_PATH:
+                path_paint(session, baseZ, tile_element);
+                break;
+            case TILE_ELEMENT_TYPE_TRACK:
+                track_paint(session, direction, baseZ, tile_element);
+                break;
+            case TILE_ELEMENT_TYPE_SMALL_SCENERY:
+                scenery_paint(session, direction, baseZ, tile_element);
+                break;
+            case TILE_ELEMENT_TYPE_ENTRANCE:
+                entrance_paint(session, direction, baseZ, tile_element);
+                break;
+            case TILE_ELEMENT_TYPE_WALL:
+                fence_paint(session, direction, baseZ, tile_element);
+                break;
+            case TILE_ELEMENT_TYPE_LARGE_SCENERY:
+                large_scenery_paint(session, direction, baseZ, tile_element);
+                break;
+            case TILE_ELEMENT_TYPE_BANNER:
+                banner_paint(session, direction, baseZ, tile_element);
+                break;
+            // A corrupt element inserted by OpenRCT2 itself, which skips the drawing of the next element only.
+            case TILE_ELEMENT_TYPE_CORRUPT:
+                if (tile_element->IsLastForTile())
+                    return false;
+                tile_element++;
+                break;
+            default:
+                // An undefined map element is most likely a corrupt element inserted by 8 cars' MOM feature to skip drawing of
+                // all elements after it.
+                return false;
+        }
+        session->MapPosition = mapPosition;
+    } while (!(tile_element++)->IsLastForTile());
+    return true;
+}
+
 bool gShowSupportSegmentHeights = false;
 
 /**
@@ -241,93 +340,19 @@ static void sub_68B3FB(paint_session* session, int32_t x, int32_t y)
     session->SpritePosition.x = x;
     session->SpritePosition.y = y;
     session->DidPassSurface = false;
-    int32_t previousBaseZ = 0;
-    do
-    {
-        // Only paint tile_elements below the clip height.
-        if ((session->ViewFlags & VIEWPORT_FLAG_CLIP_VIEW) && (tile_element->GetBaseZ() > gClipHeight * COORDS_Z_STEP))
-            continue;
-
-        Direction direction = tile_element->GetDirectionWithOffset(rotation);
-        int32_t baseZ = tile_element->GetBaseZ();
-
-        // If we are on a new baseZ level, look through elements on the
-        //  same baseZ and store any types might be relevant to others
-        if (baseZ != previousBaseZ)
-        {
-            previousBaseZ = baseZ;
-            session->PathElementOnSameHeight = nullptr;
-            session->TrackElementOnSameHeight = nullptr;
-            TileElement* tile_element_sub_iterator = tile_element;
-            while (!(tile_element_sub_iterator++)->IsLastForTile())
-            {
-                if (tile_element_sub_iterator->GetBaseZ() != tile_element->GetBaseZ())
-                {
-                    break;
-                }
-                switch (tile_element_sub_iterator->GetType())
-                {
-                    case TILE_ELEMENT_TYPE_PATH:
-                        session->PathElementOnSameHeight = tile_element_sub_iterator;
-                        break;
-                    case TILE_ELEMENT_TYPE_TRACK:
-                        session->TrackElementOnSameHeight = tile_element_sub_iterator;
-                        break;
-                    case TILE_ELEMENT_TYPE_CORRUPT:
-                        // To preserve regular behaviour, make an element hidden by
-                        //  corruption also invisible to this method.
-                        if (tile_element->IsLastForTile())
-                        {
-                            break;
-                        }
-                        tile_element_sub_iterator++;
-                        break;
-                }
-            }
-        }
 
-        CoordsXY mapPosition = session->MapPosition;
-        session->CurrentlyDrawnItem = tile_element;
-        // Setup the painting of for example: the underground, signs, rides, scenery, etc.
-        switch (tile_element->GetType())
-        {
-            case TILE_ELEMENT_TYPE_SURFACE:
-                surface_paint(session, direction, baseZ, tile_element);
-                break;
-            case TILE_ELEMENT_TYPE_PATH:
-                path_paint(session, baseZ, tile_element);
-                break;
-            case TILE_ELEMENT_TYPE_TRACK:
-                track_paint(session, direction, baseZ, tile_element);
-                break;
-            case TILE_ELEMENT_TYPE_SMALL_SCENERY:
-                scenery_paint(session, direction, baseZ, tile_element);
-                break;
-            case TILE_ELEMENT_TYPE_ENTRANCE:
-                entrance_paint(session, direction, baseZ, tile_element);
-                break;
-            case TILE_ELEMENT_TYPE_WALL:
-                fence_paint(session, direction, baseZ, tile_element);
-                break;
-            case TILE_ELEMENT_TYPE_LARGE_SCENERY:
-                large_scenery_paint(session, direction, baseZ, tile_element);
-                break;
-            case TILE_ELEMENT_TYPE_BANNER:
-                banner_paint(session, direction, baseZ, tile_element);
-                break;
-            // A corrupt element inserted by OpenRCT2 itself, which skips the drawing of the next element only.
-            case TILE_ELEMENT_TYPE_CORRUPT:
-                if (tile_element->IsLastForTile())
-                    return;
-                tile_element++;
-                break;
-            default:
-                // An undefined map element is most likely a corrupt element inserted by 8 cars' MOM feature to skip drawing of
-                // all elements after it.
-                return;
-        }
-        session->MapPosition = mapPosition;
-    } while (!(tile_element++)->IsLastForTile());
+#ifndef __TESTPAINT__
+    if (!PaintCacheBeginTile(session, tile_element))
+    {
+        bool completed = paint_tile_elements(session, tile_element);
+        PaintCacheEndTile(session, tile_element, completed);
+        if (!completed)
+            return;
+    }
+#else
+    if (!paint_tile_elements(session, tile_element))
+        return;
+#endif // __TESTPAINT__
 
 #ifndef __TESTPAINT__
     if (gConfigGeneral.virtual_floor_style != VirtualFloorStyles::Off && partOfVirtualFloor)
@@ -341,7 +366,11 @@ static void sub_68B3FB(paint_session* session, int32_t x, int32_t y)
         return;
     }
 
-    if ((tile_element - 1)->GetType() == TILE_ELEMENT_TYPE_SURFACE)
+    while (!tile_element->IsLastForTile())
+    {
+        tile_element++;
+    }
+    if (tile_element->GetType() == TILE_ELEMENT_TYPE_SURFACE)
     {
         return;
     }
@@ -13,6 +13,7 @@
 #include "../audio/audio.h"
 #include "../config/Config.h"
 #include "../core/Guard.hpp"
+#include "../core/TaskScheduler.h"
 #include "../interface/Window_internal.h"
 #include "../localisation/Localisation.h"
 #include "../management/Finance.h"
@@ -22,6 +23,7 @@
 #include "../rct2/RCT2.h"
 #include "../ride/Ride.h"
 #include "../ride/RideData.h"
+#include "../ride/RideSpatialIndex.h"
 #include "../ride/ShopItem.h"
 #include "../ride/Station.h"
 #include "../ride/Track.h"
@@ -1617,10 +1619,83 @@ void Guest::PickRideToGoOn()
     }
 }
 
+namespace
+{
+    struct PrecomputedRideConsideration
+    {
+        uint16_t SpriteIndex;
+        int16_t X;
+        int16_t Y;
+        bool HasMap;
+        std::bitset<MAX_RIDES> Rides;
+    };
+} // namespace
+
+// Sorted by sprite index, only valid during peep_update_all.
+static std::vector<PrecomputedRideConsideration> _precomputedRideConsiderations;
+
+// Ratings do not change while peeps update, so the tall rides are only looked up once per update.
+static std::bitset<MAX_RIDES> _precomputedTallRides;
+static bool _precomputedTallRidesValid;
+
+static std::bitset<MAX_RIDES> GetTallRides()
+{
+    std::bitset<MAX_RIDES> tallRides;
+    for (auto& ride : GetRideManager())
+    {
+        if (ride.highest_drop_height > 66 || ride.excitement >= RIDE_RATING(8, 00))
+        {
+            tallRides[ride.id] = true;
+        }
+    }
+    return tallRides;
+}
+
+void Guest::PrecomputeTallRides()
+{
+    _precomputedTallRides = GetTallRides();
+    _precomputedTallRidesValid = true;
+}
+
+void Guest::PrecomputeRideConsiderations(const std::vector<Guest*>& guests)
+{
+    // The workers only read from the ride spatial index.
+    RideSpatialIndexUpdate();
+
+    _precomputedRideConsiderations.resize(guests.size());
+    TaskScheduler::Get().ParallelFor(guests.size(), [&guests](size_t i) {
+        auto* guest = guests[i];
+        auto& entry = _precomputedRideConsiderations[i];
+        entry.SpriteIndex = guest->sprite_index;
+        entry.X = guest->x;
+        entry.Y = guest->y;
+        entry.HasMap = guest->HasItem(ShopItem::Map);
+        entry.Rides = guest->FindRidesToGoOn();
+    });
+}
+
+void Guest::ClearPrecomputedRideConsiderations()
+{
+    _precomputedRideConsiderations.clear();
+    _precomputedTallRidesValid = false;
+}
+
 Ride* Guest::FindBestRideToGoOn()
 {
     // Pick the most exciting ride
-    auto rideConsideration = FindRidesToGoOn();
+    std::bitset<MAX_RIDES> rideConsideration;
+    auto precomputed = std::lower_bound(
+        _precomputedRideConsiderations.begin(), _precomputedRideConsiderations.end(), sprite_index,
+        [](const PrecomputedRideConsideration& entry, uint16_t index) { return entry.SpriteIndex < index; });
+    if (precomputed != _precomputedRideConsiderations.end() && precomputed->SpriteIndex == sprite_index
+        && precomputed->X == x && precomputed->Y == y && precomputed->HasMap == HasItem(ShopItem::Map))
+    {
+        rideConsideration = precomputed->Rides;
+    }
+    else
+    {
+        rideConsideration = FindRidesToGoOn();
+    }
     Ride* mostExcitingRide = nullptr;
     for (auto& ride : GetRideManager())
     {
@@ -1662,33 +1737,12 @@ std::bitset<MAX_RIDES> Guest::FindRidesToGoOn()
     else
     {
         // Take nearby rides into consideration
-        constexpr auto radius = 10 * 32;
-        int32_t cx = floor2(x, 32);
-        int32_t cy = floor2(y, 32);
-        for (int32_t tileX = cx - radius; tileX <= cx + radius; tileX += COORDS_XY_STEP)
-        {
-            for (int32_t tileY = cy - radius; tileY <= cy + radius; tileY += COORDS_XY_STEP)
-            {
-                auto location = CoordsXY{ tileX, tileY };
-                if (!map_is_location_valid(location))
-                    continue;
-
-                for (auto* trackElement : TileElementsView<TrackElement>(location))
-                {
-                    auto rideIndex = trackElement->GetRideIndex();
-                    rideConsideration[rideIndex] = true;
-                }
-            }
-        }
+        constexpr auto radius = 10;
+        auto tile = TileCoordsXY{ CoordsXY{ floor2(x, 32), floor2(y, 32) } };
+        rideConsideration = RideSpatialIndexQuery({ tile.x - radius, tile.y - radius }, { tile.x + radius, tile.y + radius });
 
         // Always take the tall rides into consideration (realistic as you can usually see them from anywhere in the park)
-        for (auto& ride : GetRideManager())
-        {
-            if (ride.highest_drop_height > 66 || ride.excitement >= RIDE_RATING(8, 00))
-            {
-                rideConsideration[ride.id] = true;
-            }
-        }
+        rideConsideration |= _precomputedTallRidesValid ? _precomputedTallRides : GetTallRides();
     }
 
     return rideConsideration;
@@ -2203,7 +2257,7 @@ static void peep_ride_is_too_intense(Guest* peep, Ride* ride, bool peepAtRide)
  *
  *  rct2: 0x00691C6E
  */
-static Vehicle* peep_choose_car_from_ride(Peep* peep, Ride* ride, std::vector<uint8_t>& car_array)
+static Vehicle* peep_choose_car_from_ride(Peep* peep, Ride* ride, GuestCarArray& car_array)
 {
     uint8_t chosen_car = scenario_rand();
     if (ride->GetRideTypeDescriptor().HasFlag(RIDE_TYPE_FLAG_HAS_G_FORCES) && ((chosen_car & 0xC) != 0xC))
@@ -2297,7 +2351,7 @@ void Guest::GoToRideEntrance(Ride* ride)
     RemoveFromQueue();
 }
 
-bool Guest::FindVehicleToEnter(Ride* ride, std::vector<uint8_t>& car_array)
+bool Guest::FindVehicleToEnter(Ride* ride, GuestCarArray& car_array)
 {
     uint8_t chosen_train = RideStation::NO_TRAIN;
 
@@ -2335,7 +2389,7 @@ bool Guest::FindVehicleToEnter(Ride* ride, std::vector<uint8_t>& car_array)
     int32_t i = 0;
 
     uint16_t vehicle_id = ride->vehicles[chosen_train];
-    for (Vehicle* vehicle = GetEntity<Vehicle>(vehicle_id); vehicle != nullptr;
+    for (Vehicle* vehicle = GetEntity<Vehicle>(vehicle_id); vehicle != nullptr && i < MAX_CARS_PER_TRAIN;
          vehicle = GetEntity<Vehicle>(vehicle->next_vehicle_on_train), ++i)
     {
         uint8_t num_seats = vehicle->num_seats;
@@ -3226,7 +3280,7 @@ void Guest::UpdateRideAtEntrance()
         }
     }
 
-    std::vector<uint8_t> carArray;
+    GuestCarArray carArray;
 
     if (ride->GetRideTypeDescriptor().HasFlag(RIDE_TYPE_FLAG_NO_VEHICLES))
     {
@@ -0,0 +1,55 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "GuestDensity.h"
+
+#include "../world/EntitySpatialIndex.h"
+
+#include <array>
+
+static std::array<uint16_t, GUEST_DENSITY_GRID_SIZE * GUEST_DENSITY_GRID_SIZE> _guestDensity;
+
+static size_t GetGuestDensityCell(size_t spatialIndexCell)
+{
+    // Spatial index cells are tile x * MAXIMUM_MAP_SIZE_TECHNICAL + tile y.
+    auto tileX = static_cast<int32_t>(spatialIndexCell / MAXIMUM_MAP_SIZE_TECHNICAL);
+    auto tileY = static_cast<int32_t>(spatialIndexCell % MAXIMUM_MAP_SIZE_TECHNICAL);
+    return (tileY / GUEST_DENSITY_CELL_SIZE) * GUEST_DENSITY_GRID_SIZE + tileX / GUEST_DENSITY_CELL_SIZE;
+}
+
+void GuestDensityClear()
+{
+    _guestDensity.fill(0);
+}
+
+void GuestDensityInsert(size_t spatialIndexCell)
+{
+    if (spatialIndexCell == SPATIAL_INDEX_LOCATION_NULL)
+        return;
+
+    _guestDensity[GetGuestDensityCell(spatialIndexCell)]++;
+}
+
+void GuestDensityRemove(size_t spatialIndexCell)
+{
+    if (spatialIndexCell == SPATIAL_INDEX_LOCATION_NULL)
+        return;
+
+    auto& count = _guestDensity[GetGuestDensityCell(spatialIndexCell)];
+    if (count > 0)
+        count--;
+}
+
+uint16_t GuestDensityGetCount(const TileCoordsXY& cellPos)
+{
+    if (cellPos.x < 0 || cellPos.y < 0 || cellPos.x >= GUEST_DENSITY_GRID_SIZE || cellPos.y >= GUEST_DENSITY_GRID_SIZE)
+        return 0;
+
+    return _guestDensity[cellPos.y * GUEST_DENSITY_GRID_SIZE + cellPos.x];
+}
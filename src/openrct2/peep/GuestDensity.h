@@ -0,0 +1,30 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "../world/Location.hpp"
+#include "../world/Map.h"
+
+/*
+ * Number of guests in each cell of GUEST_DENSITY_CELL_SIZE x GUEST_DENSITY_CELL_SIZE tiles. The
+ * counts follow the entity spatial index, guests without a location are not counted.
+ */
+constexpr int32_t GUEST_DENSITY_CELL_SIZE = 8;
+constexpr int32_t GUEST_DENSITY_GRID_SIZE = MAXIMUM_MAP_SIZE_TECHNICAL / GUEST_DENSITY_CELL_SIZE;
+
+void GuestDensityClear();
+void GuestDensityInsert(size_t spatialIndexCell);
+void GuestDensityRemove(size_t spatialIndexCell);
+
+/**
+ * Returns the number of guests in the given cell, cellPos is in units of GUEST_DENSITY_CELL_SIZE tiles.
+ */
+uint16_t GuestDensityGetCount(const TileCoordsXY& cellPos);
@@ -17,10 +17,13 @@
 #include "../util/Util.h"
 #include "../world/Entrance.h"
 #include "../world/Footpath.h"
+#include "../world/FootpathGraph.h"
 #include "Peep.h"
 #include "Staff.h"
 
+#include <array>
 #include <cstring>
+#include <unordered_map>
 
 static bool _peepPathFindIsStaff;
 static int8_t _peepPathFindNumJunctions;
@@ -39,8 +42,44 @@ bool gPathFindDebug = false;
 utf8 gPathFindDebugPeepName[256];
 #endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
 
+PathfindStatistics gPathfindStatistics;
+
 static int32_t guest_surface_path_finding(Peep* peep);
 
+/* Results of the heuristic search shared between peeps heading for the same
+ * goal. Apart from the map and the staff patrol areas, the result of searching
+ * down an edge only depends on the inputs packed into the key, so a cached
+ * result is always the result the search would return. The cache is dropped
+ * whenever the map or a patrol area changes. */
+using PathfindCacheKey = std::array<uint8_t, 32>;
+
+struct PathfindCacheKeyHash
+{
+    size_t operator()(const PathfindCacheKey& key) const
+    {
+        // FNV-1a
+        uint32_t hash = 2166136261u;
+        for (auto b : key)
+        {
+            hash = (hash ^ b) * 16777619u;
+        }
+        return hash;
+    }
+};
+
+struct PathfindCacheResult
+{
+    uint16_t Score;
+    uint8_t Steps;
+};
+
+using PathfindDestinationCache = std::unordered_map<PathfindCacheKey, PathfindCacheResult, PathfindCacheKeyHash>;
+
+static constexpr size_t PathfindCacheMaxResults = 1 << 16;
+
+static std::unordered_map<uint32_t, PathfindDestinationCache> _pathfindCache;
+static size_t _pathfindCacheNumResults;
+
 /* A junction history for the peep pathfinding heuristic search
  * The magic number 16 is the largest value returned by
  * peep_pathfind_get_max_number_junctions() which should eventually
@@ -688,6 +727,69 @@ static void peep_pathfind_heuristic_search(
             currentElementIsWide = false;
     }
 
+    /* Walk through the footpath corridor ahead without recursing. On corridor
+     * tiles only the loop, patrol area, goal and search limit checks below can
+     * end the search path and the exit edge is the only edge to continue on. */
+#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+    const bool useCorridors = !gPathFindDebug;
+#else
+    const bool useCorridors = true;
+#endif
+    const FootpathGraphEdge* corridor = useCorridors ? &FootpathGraphGetEdge(loc, test_edge) : nullptr;
+    if (corridor != nullptr && !corridor->Steps.empty())
+    {
+        const Staff* mechanic = peep->As<Staff>();
+        if (mechanic != nullptr && !mechanic->IsMechanic())
+            mechanic = nullptr;
+
+        for (const auto& step : corridor->Steps)
+        {
+            ++counter;
+            _peepPathFindTilesChecked--;
+
+            if ((_peepPathFindHistory[0].location.x == static_cast<uint8_t>(step.Location.x))
+                && (_peepPathFindHistory[0].location.y == static_cast<uint8_t>(step.Location.y))
+                && (_peepPathFindHistory[0].location.z == loc.z))
+            {
+                return;
+            }
+
+            if (mechanic != nullptr)
+            {
+                bool nextInPatrolArea = mechanic->IsLocationInPatrol(step.Location.ToCoordsXY());
+                if (inPatrolArea && !nextInPatrolArea)
+                    return;
+                inPatrolArea = nextInPatrolArea;
+            }
+
+            uint16_t new_score = CalculateHeuristicPathingScore(step.Location, gPeepPathFindGoalPosition);
+            if (new_score == 0 || counter >= 200 || _peepPathFindTilesChecked <= 0)
+            {
+                /* The goal or a search limit is reached, the current search path ends here. */
+                if (new_score < *endScore || (new_score == *endScore && counter < *endSteps))
+                {
+                    *endScore = new_score;
+                    *endSteps = counter;
+                    *endXYZ = step.Location;
+                    *endJunctions = _peepPathFindMaxJunctions - _peepPathFindNumJunctions;
+                    for (uint8_t junctInd = 0; junctInd < *endJunctions; junctInd++)
+                    {
+                        uint8_t histIdx = _peepPathFindMaxJunctions - junctInd;
+                        junctionList[junctInd].x = _peepPathFindHistory[histIdx].location.x;
+                        junctionList[junctInd].y = _peepPathFindHistory[histIdx].location.y;
+                        junctionList[junctInd].z = _peepPathFindHistory[histIdx].location.z;
+                        directionList[junctInd] = _peepPathFindHistory[histIdx].direction;
+                    }
+                }
+                return;
+            }
+
+            loc = { step.Location.x, step.Location.y, step.ExitZ };
+            test_edge = step.Exit;
+        }
+        currentElementIsWide = false;
+    }
+
     loc += TileDirectionDelta[test_edge];
 
     ++counter;
@@ -1248,6 +1350,67 @@ static void peep_pathfind_heuristic_search(
     }
 }
 
+static uint32_t GetPathfindGoalKey(const TileCoordsXYZ& goal)
+{
+    return static_cast<uint8_t>(goal.x) | (static_cast<uint8_t>(goal.y) << 8) | (static_cast<uint16_t>(goal.z) << 16);
+}
+
+static PathfindCacheKey GetPathfindCacheKey(
+    const TileCoordsXYZ& loc, Direction testEdge, const Peep* peep, const Staff* staff, bool inPatrolArea)
+{
+    PathfindCacheKey key{};
+    key[0] = static_cast<uint8_t>(loc.x);
+    key[1] = static_cast<uint8_t>(loc.y);
+    key[2] = static_cast<uint8_t>(loc.z);
+    key[3] = testEdge;
+    std::memcpy(&key[4], &_peepPathFindTilesChecked, sizeof(_peepPathFindTilesChecked));
+    key[8] = static_cast<uint8_t>(_peepPathFindMaxJunctions);
+    std::memcpy(&key[9], &gPeepPathFindQueueRideIndex, sizeof(gPeepPathFindQueueRideIndex));
+    key[11] = gPeepPathFindIgnoreForeignQueues ? 1 : 0;
+    static_assert(sizeof(peep->PathfindHistory) == 16);
+    std::memcpy(&key[12], peep->PathfindHistory, sizeof(peep->PathfindHistory));
+    // Staff can ignore wide flags and mechanics stay in their patrol area, so staff results are only shared with themselves.
+    if (staff != nullptr)
+    {
+        key[28] = 1;
+        key[29] = staff->StaffId;
+        key[30] = staff->IsMechanic() ? 1 : 0;
+        key[31] = inPatrolArea ? 1 : 0;
+    }
+    return key;
+}
+
+static const PathfindCacheResult* PathfindCacheFind(const TileCoordsXYZ& goal, const PathfindCacheKey& key)
+{
+    auto destinationIt = _pathfindCache.find(GetPathfindGoalKey(goal));
+    if (destinationIt == _pathfindCache.end())
+        return nullptr;
+
+    auto resultIt = destinationIt->second.find(key);
+    if (resultIt == destinationIt->second.end())
+        return nullptr;
+
+    return &resultIt->second;
+}
+
+static void PathfindCacheStore(const TileCoordsXYZ& goal, const PathfindCacheKey& key, const PathfindCacheResult& result)
+{
+    if (_pathfindCacheNumResults >= PathfindCacheMaxResults)
+    {
+        PathfindCacheInvalidate();
+    }
+    if (_pathfindCache[GetPathfindGoalKey(goal)].emplace(key, result).second)
+    {
+        _pathfindCacheNumResults++;
+    }
+}
+
+void PathfindCacheInvalidate()
+{
+    _pathfindCache.clear();
+    _pathfindCacheNumResults = 0;
+}
+
 /**
  * Returns:
  *   -1   - no direction chosen
@@ -1257,6 +1420,8 @@ static void peep_pathfind_heuristic_search(
  */
 Direction peep_pathfind_choose_direction(const TileCoordsXYZ& loc, Peep* peep)
 {
+    gPathfindStatistics.ChooseDirectionCalls++;
+
     // The max number of thin junctions searched - a per-search-path limit.
     _peepPathFindMaxJunctions = peep_pathfind_get_max_number_junctions(peep);
 
@@ -1510,9 +1675,37 @@ Direction peep_pathfind_choose_direction(const TileCoordsXYZ& loc, Peep* peep)
             }
 #endif // defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
 
-            peep_pathfind_heuristic_search(
-                { loc.x, loc.y, height }, peep, first_tile_element, inPatrolArea, 0, &score, test_edge, &endJunctions,
-                endJunctionList, endDirectionList, &endXYZ, &endSteps);
+#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+            const bool useCache = !gPathFindDebug;
+#else
+            const bool useCache = true;
+#endif
+            PathfindCacheKey cacheKey{};
+            const PathfindCacheResult* cachedResult = nullptr;
+            if (useCache)
+            {
+                cacheKey = GetPathfindCacheKey(loc, test_edge, peep, staff, inPatrolArea);
+                cachedResult = PathfindCacheFind(goal, cacheKey);
+            }
+
+            if (cachedResult != nullptr)
+            {
+                score = cachedResult->Score;
+                endSteps = cachedResult->Steps;
+                gPathfindStatistics.CachedEdgeSearches++;
+            }
+            else
+            {
+                peep_pathfind_heuristic_search(
+                    { loc.x, loc.y, height }, peep, first_tile_element, inPatrolArea, 0, &score, test_edge, &endJunctions,
+                    endJunctionList, endDirectionList, &endXYZ, &endSteps);
+                gPathfindStatistics.EdgeSearches++;
+                gPathfindStatistics.TilesChecked += (maxTilesChecked / numEdges) - _peepPathFindTilesChecked;
+                if (useCache)
+                {
+                    PathfindCacheStore(goal, cacheKey, { score, endSteps });
+                }
+            }
 
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
             if (gPathFindDebug)
@@ -1799,28 +1992,34 @@ static int32_t guest_path_find_park_entrance(Peep* peep, uint8_t edges)
  * In case where the map element at (x, y) is invalid or there is no entrance
  * or queue leading to it the function will not update its arguments.
  */
-static void get_ride_queue_end(TileCoordsXYZ& loc)
+/**
+ * entranceElement is the ride entrance at loc when the caller already knows it, otherwise it is searched for.
+ */
+static void get_ride_queue_end(TileCoordsXYZ& loc, EntranceElement* entranceElement)
 {
     TileCoordsXY queueEnd = { 0, 0 };
-    TileElement* tileElement = map_get_first_element_at(loc.ToCoordsXY());
-
-    if (tileElement == nullptr)
+    TileElement* tileElement = reinterpret_cast<TileElement*>(entranceElement);
+    bool found = tileElement != nullptr;
+    if (!found)
     {
-        return;
-    }
+        tileElement = map_get_first_element_at(loc.ToCoordsXY());
+        if (tileElement == nullptr)
+        {
+            return;
+        }
 
-    bool found = false;
-    do
-    {
-        if (tileElement->GetType() != TILE_ELEMENT_TYPE_ENTRANCE)
-            continue;
+        do
+        {
+            if (tileElement->GetType() != TILE_ELEMENT_TYPE_ENTRANCE)
+                continue;
 
-        if (loc.z != tileElement->base_height)
-            continue;
+            if (loc.z != tileElement->base_height)
+                continue;
 
-        found = true;
-        break;
-    } while (!(tileElement++)->IsLastForTile());
+            found = true;
+            break;
+        } while (!(tileElement++)->IsLastForTile());
+    }
 
     if (!found)
         return;
@@ -2215,6 +2414,7 @@ int32_t guest_path_finding(Guest* peep)
         closestStationNum = guest_pathfinding_select_random_station(peep, numEntranceStations, entranceStations);
     }
 
+    EntranceElement* entranceElement = nullptr;
     if (numEntranceStations == 0)
     {
         // closestStationNum is always 0 here.
@@ -2229,9 +2429,10 @@ int32_t guest_path_finding(Guest* peep)
         loc.x = entranceXYZD.x;
         loc.y = entranceXYZD.y;
         loc.z = entranceXYZD.z;
+        entranceElement = ride_get_entrance_element(ride, closestStationNum);
     }
 
-    get_ride_queue_end(loc);
+    get_ride_queue_end(loc, entranceElement);
 
     gPeepPathFindGoalPosition = loc;
     gPeepPathFindIgnoreForeignQueues = true;
@@ -45,6 +45,19 @@ Direction peep_pathfind_choose_direction(const TileCoordsXYZ& loc, Peep* peep);
 // moving in direction currentDirection.
 bool IsValidPathZAndDirection(TileElement* tileElement, int32_t currentZ, int32_t currentDirection);
 
+// Drops the pathfinding results shared between guests, called whenever the map changes.
+void PathfindCacheInvalidate();
+
+// Counters of the work done by peep_pathfind_choose_direction, only read by benchmarks.
+struct PathfindStatistics
+{
+    uint64_t ChooseDirectionCalls;
+    uint64_t EdgeSearches;
+    uint64_t CachedEdgeSearches;
+    uint64_t TilesChecked;
+};
+extern PathfindStatistics gPathfindStatistics;
+
 // Overall guest pathfinding AI. Sets up Peep::DestinationX/DestinationY (which they move to in a
 // straight line, no pathfinding). Called whenever the guest has arrived at their previously set destination.
 //
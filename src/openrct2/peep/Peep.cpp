@@ -19,6 +19,7 @@
 #include "../audio/audio.h"
 #include "../config/Config.h"
 #include "../core/Guard.hpp"
+#include "../core/Profiling.h"
 #include "../interface/Window.h"
 #include "../localisation/Localisation.h"
 #include "../management/Finance.h"
@@ -46,12 +47,15 @@
 #include "../world/SmallScenery.h"
 #include "../world/Sprite.h"
 #include "../world/Surface.h"
+#include "GuestDensity.h"
 #include "GuestPathfinding.h"
 #include "Staff.h"
 
 #include <algorithm>
+#include <array>
 #include <iterator>
 #include <limits>
+#include <string>
 
 uint8_t gGuestChangeModifier;
 uint32_t gNumGuestsInPark;
@@ -393,11 +397,58 @@ int32_t peep_get_staff_count()
  *
  *  rct2: 0x0068F0A9
  */
+/**
+ * Collects the guests that will run their 128 tick update this tick and might pick a ride to go on,
+ * the expensive ride search for those is then done up front on worker threads.
+ */
+static void peep_precompute_guest_decisions()
+{
+    std::vector<Guest*> candidates;
+    int32_t i = 0;
+    for (auto guest : EntityList<Guest>())
+    {
+        if (static_cast<uint32_t>(i & 0x7F) == (gCurrentTicks & 0x7F) && guest->State == PeepState::Walking
+            && !(guest->PeepFlags & PEEP_FLAGS_LEAVING_PARK) && guest->GuestHeadingToRideId == RIDE_ID_NULL
+            && guest->x != LOCATION_NULL)
+        {
+            candidates.push_back(guest);
+        }
+        i++;
+    }
+    Guest::PrecomputeRideConsiderations(candidates);
+}
+
+/**
+ * Returns the profiler zone name for the peeps that run their 128 tick update on the given tick.
+ * Peeps are assigned to one of 128 buckets by their position in the peep lists.
+ */
+static const char* peep_get_128_tick_zone_name(uint32_t tick)
+{
+    static const auto zoneNames = []() {
+        std::array<std::string, 128> names;
+        for (size_t i = 0; i < names.size(); i++)
+        {
+            names[i] = "peep_128_tick_update bucket " + std::to_string(i);
+        }
+        return names;
+    }();
+    return zoneNames[tick & 0x7F].c_str();
+}
+
 void peep_update_all()
 {
     if (gScreenFlags & SCREEN_FLAGS_EDITOR)
         return;
 
+    PROFILE_SCOPE("peep_update_all");
+    const char* tick128ZoneName = peep_get_128_tick_zone_name(gCurrentTicks);
+
+    Guest::PrecomputeTallRides();
+    if (gConfigGeneral.multithreading)
+    {
+        peep_precompute_guest_decisions();
+    }
+
     int32_t i = 0;
     // Warning this loop can delete peeps
     for (auto peep : EntityList<Guest>())
@@ -408,7 +459,10 @@ void peep_update_all()
         }
         else
         {
-            peep_128_tick_update(peep, i);
+            {
+                Profiling::ScopedZone zone(tick128ZoneName);
+                peep_128_tick_update(peep, i);
+            }
             // 128 tick can delete so double check its not deleted
             if (peep->Type == EntityType::Guest)
             {
@@ -427,7 +481,10 @@ void peep_update_all()
         }
         else
         {
-            peep_128_tick_update(staff, i);
+            {
+                Profiling::ScopedZone zone(tick128ZoneName);
+                peep_128_tick_update(staff, i);
+            }
             // 128 tick can delete so double check its not deleted
             if (staff->Type == EntityType::Staff)
             {
@@ -437,6 +494,8 @@ void peep_update_all()
 
         i++;
     }
+
+    Guest::ClearPrecomputedRideConsiderations();
 }
 
 /**
@@ -527,7 +586,7 @@ PeepActionSpriteType Peep::GetActionSpriteType()
  */
 void Peep::UpdateCurrentActionSpriteType()
 {
-    if (EnumValue(SpriteType) >= std::size(g_peep_animation_entries))
+    if (SpriteType >= PeepSpriteType::Count)
     {
         return;
     }
@@ -630,28 +689,27 @@ std::optional<CoordsXY> Peep::UpdateAction(int16_t& xy_distance)
         CoordsXY loc = { x, y };
         loc += word_981D7C[nextDirection / 8];
         WalkingFrameNum++;
-        const rct_peep_animation* peepAnimation = &GetPeepAnimation(SpriteType);
-        const uint8_t* imageOffset = peepAnimation[EnumValue(ActionSpriteType)].frame_offsets;
-        if (WalkingFrameNum >= peepAnimation[EnumValue(ActionSpriteType)].num_frames)
+        const auto& peepAnimation = GetPeepAnimation(SpriteType, ActionSpriteType);
+        if (WalkingFrameNum >= peepAnimation.num_frames)
         {
             WalkingFrameNum = 0;
         }
-        ActionSpriteImageOffset = imageOffset[WalkingFrameNum];
+        ActionSpriteImageOffset = peepAnimation.frame_offsets[WalkingFrameNum];
         return loc;
     }
 
-    const rct_peep_animation* peepAnimation = &GetPeepAnimation(SpriteType);
+    const auto& peepAnimation = GetPeepAnimation(SpriteType, ActionSpriteType);
     ActionFrame++;
 
     // If last frame of action
-    if (ActionFrame >= peepAnimation[EnumValue(ActionSpriteType)].num_frames)
+    if (ActionFrame >= peepAnimation.num_frames)
     {
         ActionSpriteImageOffset = 0;
         Action = PeepActionType::None2;
         UpdateCurrentActionSpriteType();
         return { { x, y } };
     }
-    ActionSpriteImageOffset = peepAnimation[EnumValue(ActionSpriteType)].frame_offsets[ActionFrame];
+    ActionSpriteImageOffset = peepAnimation.frame_offsets[ActionFrame];
 
     // If not throwing up and not at the frame where sick appears.
     if (Action != PeepActionType::ThrowUp || ActionFrame != 15)
@@ -855,10 +913,114 @@ void peep_sprite_remove(Peep* peep)
     }
     sprite_remove(peep);
 
-    auto intent = Intent(wasGuest ? INTENT_ACTION_REFRESH_GUEST_LIST : INTENT_ACTION_REFRESH_STAFF_LIST);
+    auto intent = Intent(wasGuest ? INTENT_ACTION_UPDATE_GUEST_COUNT : INTENT_ACTION_REFRESH_STAFF_LIST);
     context_broadcast_intent(&intent);
 }
 
+/**
+ * Removes all of the given peeps the same way as calling Remove on each of them. Queues are relinked, and windows,
+ * news items and patrol areas are updated, once for all peeps instead of once per peep.
+ */
+void peep_remove_many(const std::vector<Peep*>& peeps)
+{
+    if (peeps.empty())
+        return;
+
+    std::bitset<MAX_ENTITIES> removedIds;
+    std::vector<std::pair<ride_id_t, StationIndex>> queues;
+    std::vector<uint32_t> guestIds;
+    std::vector<uint32_t> staffIds;
+    for (auto* peep : peeps)
+    {
+        removedIds[peep->sprite_index] = true;
+        auto* guest = peep->As<Guest>();
+        if (guest != nullptr)
+        {
+            if (!guest->OutsideOfPark)
+            {
+                decrement_guests_in_park();
+            }
+            if (guest->State == PeepState::EnteringPark)
+            {
+                decrement_guests_heading_for_park();
+            }
+
+            // Same as RemoveFromRide, but the queue is relinked below
+            if (guest->State == PeepState::Queuing)
+            {
+                auto ride = get_ride(guest->CurrentRide);
+                if (ride != nullptr)
+                {
+                    auto& station = ride->stations[guest->CurrentRideStation];
+                    if (station.QueueLength > 0)
+                    {
+                        station.QueueLength--;
+                    }
+                    queues.emplace_back(guest->CurrentRide, guest->CurrentRideStation);
+                }
+            }
+            guest->StateReset();
+            guestIds.push_back(guest->sprite_index);
+        }
+        else
+        {
+            gStaffModes[peep->StaffId] = StaffMode::None;
+            staffIds.push_back(peep->sprite_index);
+        }
+
+        peep->Invalidate();
+        window_close_by_number(WC_PEEP, peep->sprite_index);
+    }
+
+    std::sort(queues.begin(), queues.end());
+    queues.erase(std::unique(queues.begin(), queues.end()), queues.end());
+    auto skipRemoved = [&removedIds](uint16_t spriteIndex) {
+        while (spriteIndex < MAX_ENTITIES && removedIds[spriteIndex])
+        {
+            auto* guest = GetEntity<Guest>(spriteIndex);
+            spriteIndex = guest != nullptr ? guest->GuestNextInQueue : SPRITE_INDEX_NULL;
+        }
+        return spriteIndex;
+    };
+    for (const auto& [rideIndex, stationIndex] : queues)
+    {
+        auto& station = get_ride(rideIndex)->stations[stationIndex];
+        station.LastPeepInQueue = skipRemoved(station.LastPeepInQueue);
+        for (auto* guest = GetEntity<Guest>(station.LastPeepInQueue); guest != nullptr;
+             guest = GetEntity<Guest>(guest->GuestNextInQueue))
+        {
+            guest->GuestNextInQueue = skipRemoved(guest->GuestNextInQueue);
+        }
+    }
+
+    if (!guestIds.empty())
+    {
+        window_close_by_number(WC_FIRE_PROMPT, EnumValue(EntityType::Guest));
+        std::sort(guestIds.begin(), guestIds.end());
+        News::DisableNewsItems(News::ItemType::PeepOnRide, guestIds);
+    }
+    if (!staffIds.empty())
+    {
+        window_close_by_number(WC_FIRE_PROMPT, EnumValue(EntityType::Staff));
+        staff_update_greyed_patrol_areas();
+        std::sort(staffIds.begin(), staffIds.end());
+        News::DisableNewsItems(News::ItemType::Peep, staffIds);
+    }
+
+    sprite_remove_many(std::vector<SpriteBase*>(peeps.begin(), peeps.end()));
+
+    if (!guestIds.empty())
+    {
+        auto intent = Intent(INTENT_ACTION_UPDATE_GUEST_COUNT);
+        context_broadcast_intent(&intent);
+    }
+    if (!staffIds.empty())
+    {
+        auto intent = Intent(INTENT_ACTION_REFRESH_STAFF_LIST);
+        context_broadcast_intent(&intent);
+    }
+}
+
 /**
  * New function removes peep from park existence. Works with staff.
  */
@@ -1189,6 +1351,7 @@ void Peep::Update()
  */
 void peep_problem_warnings_update()
 {
+    PROFILE_SCOPE("peep_problem_warnings_update");
     Ride* ride;
     uint32_t hunger_counter = 0, lost_counter = 0, noexit_counter = 0, thirst_counter = 0, litter_counter = 0,
              disgust_counter = 0, toilet_counter = 0, vandalism_counter = 0;
@@ -1354,6 +1517,38 @@ void peep_stop_crowd_noise()
  *
  *  rct2: 0x006BD18A
  */
+/**
+ * Returns whether a guest in the given density cell can be visible in the viewport, guests are
+ * assumed to be between the ground and the maximum height with sprites smaller than a tile.
+ */
+static bool peep_is_guest_density_cell_in_viewport(const rct_viewport* viewport, int32_t rotation, const TileCoordsXY& cellPos)
+{
+    constexpr int32_t cellLength = GUEST_DENSITY_CELL_SIZE * COORDS_XY_STEP;
+    constexpr int32_t spriteMargin = COORDS_XY_STEP * 2;
+
+    const auto cellStart = CoordsXY{ cellPos.x * cellLength, cellPos.y * cellLength };
+    ScreenCoordsXY mins{ std::numeric_limits<int32_t>::max(), std::numeric_limits<int32_t>::max() };
+    ScreenCoordsXY maxs{ std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::min() };
+    const CoordsXY corners[] = { { 0, 0 }, { cellLength, 0 }, { 0, cellLength }, { cellLength, cellLength } };
+    for (const auto& corner : corners)
+    {
+        for (auto z : { 0, MAX_ELEMENT_HEIGHT * COORDS_Z_STEP })
+        {
+            auto screenPos = translate_3d_to_2d_with_z(rotation, { cellStart + corner, z });
+            mins.x = std::min(mins.x, screenPos.x);
+            mins.y = std::min(mins.y, screenPos.y);
+            maxs.x = std::max(maxs.x, screenPos.x);
+            maxs.y = std::max(maxs.y, screenPos.y);
+        }
+    }
+
+    if (maxs.x + spriteMargin < viewport->viewPos.x || mins.x - spriteMargin > viewport->viewPos.x + viewport->view_width)
+        return false;
+    if (maxs.y + spriteMargin < viewport->viewPos.y || mins.y - spriteMargin > viewport->viewPos.y + viewport->view_height)
+        return false;
+    return true;
+}
+
 void peep_update_crowd_noise()
 {
     if (OpenRCT2::Audio::gGameSoundsOff)
@@ -1372,20 +1567,35 @@ void peep_update_crowd_noise()
     // Count the number of peeps visible
     auto visiblePeeps = 0;
 
-    for (auto peep : EntityList<Guest>())
+    // Only visit the guests in the density cells that can overlap the viewport.
+    const auto rotation = get_current_rotation();
+    for (int32_t cellY = 0; cellY < GUEST_DENSITY_GRID_SIZE; cellY++)
     {
-        if (peep->sprite_left == LOCATION_NULL)
-            continue;
-        if (viewport->viewPos.x > peep->sprite_right)
-            continue;
-        if (viewport->viewPos.x + viewport->view_width < peep->sprite_left)
-            continue;
-        if (viewport->viewPos.y > peep->sprite_bottom)
-            continue;
-        if (viewport->viewPos.y + viewport->view_height < peep->sprite_top)
-            continue;
+        for (int32_t cellX = 0; cellX < GUEST_DENSITY_GRID_SIZE; cellX++)
+        {
+            if (GuestDensityGetCount({ cellX, cellY }) == 0)
+                continue;
+            if (!peep_is_guest_density_cell_in_viewport(viewport, rotation, { cellX, cellY }))
+                continue;
+
+            const auto cellTile = TileCoordsXY{ cellX * GUEST_DENSITY_CELL_SIZE, cellY * GUEST_DENSITY_CELL_SIZE };
+            const auto cellLastTile = TileCoordsXY{ cellTile.x + GUEST_DENSITY_CELL_SIZE - 1,
+                                                    cellTile.y + GUEST_DENSITY_CELL_SIZE - 1 };
+            ForEachEntityInTileRange<Guest>(cellTile, cellLastTile, [&](Guest* peep) {
+                if (peep->sprite_left == LOCATION_NULL)
+                    return;
+                if (viewport->viewPos.x > peep->sprite_right)
+                    return;
+                if (viewport->viewPos.x + viewport->view_width < peep->sprite_left)
+                    return;
+                if (viewport->viewPos.y > peep->sprite_bottom)
+                    return;
+                if (viewport->viewPos.y + viewport->view_height < peep->sprite_top)
+                    return;
 
-        visiblePeeps += peep->State == PeepState::Queuing ? 1 : 2;
+                visiblePeeps += peep->State == PeepState::Queuing ? 1 : 2;
+            });
+        }
     }
 
     // This function doesn't account for the fact that the screen might be so big that 100 peeps could potentially be very
@@ -1713,7 +1923,7 @@ Peep* Peep::Generate(const CoordsXYZ& coords)
     peep->GuestNumRides = 0;
     std::fill_n(peep->RideTypesBeenOn, 16, 0x00);
     peep->Id = gNextGuestNumber++;
-    peep->Name = nullptr;
+    peep->Name = {};
 
     money32 cash = (scenario_rand() & 0x3) * 100 - 100 + gGuestInitialCash;
     if (cash < 0)
@@ -1964,7 +2174,8 @@ void Peep::FormatActionTo(Formatter& ft) const
 
 void Peep::FormatNameTo(Formatter& ft) const
 {
-    if (Name == nullptr)
+    auto name = GetCustomName();
+    if (name == nullptr)
     {
         if (Is<Staff>())
         {
@@ -1996,7 +2207,7 @@ void Peep::FormatNameTo(Formatter& ft) const
     }
     else
     {
-        ft.Add<rct_string_id>(STR_STRING).Add<const char*>(Name);
+        ft.Add<rct_string_id>(STR_STRING).Add<const char*>(name);
     }
 }
 
@@ -2007,27 +2218,24 @@ std::string Peep::GetName() const
     return format_string(STR_STRINGID, ft.Data());
 }
 
+const char* Peep::GetCustomName() const
+{
+    return GetPeepNamePool().Get(Name);
+}
+
 bool Peep::SetName(std::string_view value)
 {
-    if (value.empty())
-    {
-        std::free(Name);
-        Name = nullptr;
-        return true;
-    }
-    else
-    {
-        auto newNameMemory = static_cast<char*>(std::malloc(value.size() + 1));
-        if (newNameMemory != nullptr)
-        {
-            std::memcpy(newNameMemory, value.data(), value.size());
-            newNameMemory[value.size()] = '\0';
-            std::free(Name);
-            Name = newNameMemory;
-            return true;
-        }
-    }
-    return false;
+    auto& pool = GetPeepNamePool();
+    auto newName = pool.Add(value);
+    pool.Release(Name);
+    Name = newName;
+    return true;
+}
+
+OpenRCT2::StringPool& GetPeepNamePool()
+{
+    static OpenRCT2::StringPool pool;
+    return pool;
 }
 
 /**
@@ -3185,7 +3393,7 @@ int32_t peep_compare(const uint16_t sprite_index_a, const uint16_t sprite_index_
         return static_cast<int32_t>(peep_a->Type) - static_cast<int32_t>(peep_b->Type);
     }
 
-    if (peep_a->Name == nullptr && peep_b->Name == nullptr)
+    if (peep_a->Name == OpenRCT2::StringPool::Null && peep_b->Name == OpenRCT2::StringPool::Null)
     {
         if (gParkFlags & PARK_FLAGS_SHOW_REAL_GUEST_NAMES)
         {
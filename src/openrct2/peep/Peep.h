@@ -11,6 +11,8 @@
 #define _PEEP_H_
 
 #include "../common.h"
+#include "../core/FixedVector.h"
+#include "../core/StringPool.h"
 #include "../management/Finance.h"
 #include "../rct12/RCT12.h"
 #include "../ride/Ride.h"
@@ -21,8 +23,10 @@
 #include "../world/SpriteBase.h"
 
 #include <algorithm>
+#include <array>
 #include <bitset>
 #include <optional>
+#include <vector>
 
 #define PEEP_MAX_THOUGHTS 5
 #define PEEP_THOUGHT_ITEM_NONE 255
@@ -359,6 +363,8 @@ enum class PeepActionSpriteType : uint8_t
     Invalid = 255
 };
 
+constexpr size_t PeepActionSpriteTypeCount = EnumValue(PeepActionSpriteType::WithdrawMoney) + 1;
+
 enum PeepFlags : uint32_t
 {
     PEEP_FLAGS_LEAVING_PARK = (1 << 0),
@@ -549,7 +555,8 @@ public:
 
 struct Peep : SpriteBase
 {
-    char* Name;
+    // A name given by the player, held in the pool from GetPeepNamePool()
+    OpenRCT2::StringPool::Handle Name;
     CoordsXYZ NextLoc;
     uint8_t NextFlags;
     bool OutsideOfPark;
@@ -743,6 +750,8 @@ public: // Peep
     void FormatActionTo(Formatter&) const;
     void FormatNameTo(Formatter&) const;
     std::string GetName() const;
+    // The name given by the player, or nullptr if the peep goes by a generated name
+    const char* GetCustomName() const;
     bool SetName(std::string_view value);
 
     // Reset the peep's stored goal, which means they will forget any stored pathfinding history
@@ -774,6 +783,9 @@ private:
     void UpdatePicked();
 };
 
+// Indices of the cars a guest can board, kept on the stack as it is filled every tick a guest waits at the entrance.
+using GuestCarArray = FixedVector<uint8_t, MAX_CARS_PER_TRAIN>;
+
 struct Guest : Peep
 {
     static constexpr auto cEntityType = EntityType::Guest;
@@ -817,6 +829,15 @@ public:
     int32_t GetEasterEggNameId() const;
     void UpdateEasterEggInteractions();
 
+    /**
+     * Runs the read-only part of PickRideToGoOn for the given guests on worker threads, the results
+     * are only used while the guest position and map ownership are unchanged so the outcome is
+     * identical to the serial path.
+     */
+    static void PrecomputeTallRides();
+    static void PrecomputeRideConsiderations(const std::vector<Guest*>& guests);
+    static void ClearPrecomputedRideConsiderations();
+
 private:
     void UpdateRide();
     void UpdateOnRide(){}; // TODO
@@ -859,7 +880,7 @@ private:
     void GivePassingPeepsIceCream(Guest* passingPeep);
     Ride* FindBestRideToGoOn();
     std::bitset<MAX_RIDES> FindRidesToGoOn();
-    bool FindVehicleToEnter(Ride* ride, std::vector<uint8_t>& car_array);
+    bool FindVehicleToEnter(Ride* ride, GuestCarArray& car_array);
     void GoToRideEntrance(Ride* ride);
 };
 
@@ -939,18 +960,18 @@ struct rct_sprite_bounds
     uint8_t sprite_height_positive; // 0x02
 };
 
+/**
+ * One action of one sprite type, the frames and bounds a peep steps through are read from the one entry.
+ */
 struct rct_peep_animation
 {
-    uint32_t base_image; // 0x00
-    size_t num_frames;
+    uint32_t base_image;
+    uint8_t num_frames;
+    rct_sprite_bounds bounds;
     const uint8_t* frame_offsets;
 };
 
-struct rct_peep_animation_entry
-{
-    const rct_peep_animation* sprite_animation; // 0x00
-    const rct_sprite_bounds* sprite_bounds;     // 0x04
-};
+using PeepAnimationTable = std::array<rct_peep_animation, EnumValue(PeepSpriteType::Count) * PeepActionSpriteTypeCount>;
 
 enum
 {
@@ -988,8 +1009,8 @@ enum
     PATHING_RIDE_ENTRANCE = 1 << 3,
 };
 
-// rct2: 0x00982708
-extern const rct_peep_animation_entry g_peep_animation_entries[EnumValue(PeepSpriteType::Count)];
+// rct2: 0x00982708, the actions of each sprite type are next to each other
+extern const PeepAnimationTable gPeepAnimations;
 extern const bool gSpriteTypeToSlowWalkMap[48];
 
 extern uint8_t gGuestChangeModifier;
@@ -1008,6 +1029,11 @@ extern uint8_t gPeepWarningThrottle[16];
 
 Peep* try_get_guest(uint16_t spriteIndex);
 int32_t peep_get_staff_count();
+/**
+ * Names given to peeps, equal names are stored once. Cleared along with the sprite list.
+ */
+OpenRCT2::StringPool& GetPeepNamePool();
+
 void peep_update_all();
 void peep_problem_warnings_update();
 void peep_stop_crowd_noise();
@@ -1018,6 +1044,7 @@ void peep_thought_set_format_args(const rct_peep_thought* thought, Formatter& ft
 int32_t get_peep_face_sprite_small(Peep* peep);
 int32_t get_peep_face_sprite_large(Peep* peep);
 void peep_sprite_remove(Peep* peep);
+void peep_remove_many(const std::vector<Peep*>& peeps);
 
 void peep_window_state_update(Peep* peep);
 void peep_decrement_num_riders(Peep* peep);
@@ -1039,13 +1066,13 @@ rct_string_id get_real_name_string_id_from_id(uint32_t id);
 inline const rct_peep_animation& GetPeepAnimation(
     PeepSpriteType spriteType, PeepActionSpriteType actionSpriteType = PeepActionSpriteType::None)
 {
-    return g_peep_animation_entries[EnumValue(spriteType)].sprite_animation[EnumValue(actionSpriteType)];
+    return gPeepAnimations[EnumValue(spriteType) * PeepActionSpriteTypeCount + EnumValue(actionSpriteType)];
 };
 
 inline const rct_sprite_bounds& GetSpriteBounds(
     PeepSpriteType spriteType, PeepActionSpriteType actionSpriteType = PeepActionSpriteType::None)
 {
-    return g_peep_animation_entries[EnumValue(spriteType)].sprite_bounds[EnumValue(actionSpriteType)];
+    return GetPeepAnimation(spriteType, actionSpriteType).bounds;
 };
 
 #endif
@@ -140,24 +140,21 @@ bool staff_hire_new_member(StaffType staffType, EntertainerCostume entertainerTy
  */
 void staff_update_greyed_patrol_areas()
 {
-    for (int32_t staff_type = 0; staff_type < static_cast<uint8_t>(StaffType::Count); ++staff_type)
+    auto* staffTypePatrolAreas = &gStaffPatrolAreas[STAFF_MAX_COUNT * STAFF_PATROL_AREA_SIZE];
+    std::fill_n(staffTypePatrolAreas, static_cast<uint8_t>(StaffType::Count) * STAFF_PATROL_AREA_SIZE, 0);
+
+    // Merge every staff member into the area of their type in a single pass over the staff list.
+    for (auto peep : EntityList<Staff>())
     {
-        int32_t staffPatrolOffset = (staff_type + STAFF_MAX_COUNT) * STAFF_PATROL_AREA_SIZE;
+        auto staffType = static_cast<uint8_t>(peep->AssignedStaffType);
+        if (staffType >= static_cast<uint8_t>(StaffType::Count))
+            continue;
+
+        auto* staffPatrolArea = &staffTypePatrolAreas[staffType * STAFF_PATROL_AREA_SIZE];
+        const auto* peepPatrolArea = &gStaffPatrolAreas[peep->StaffId * STAFF_PATROL_AREA_SIZE];
         for (int32_t i = 0; i < STAFF_PATROL_AREA_SIZE; i++)
         {
-            gStaffPatrolAreas[staffPatrolOffset + i] = 0;
-        }
-
-        for (auto peep : EntityList<Staff>())
-        {
-            if (static_cast<uint8_t>(peep->AssignedStaffType) == staff_type)
-            {
-                int32_t peepPatrolOffset = peep->StaffId * STAFF_PATROL_AREA_SIZE;
-                for (int32_t i = 0; i < STAFF_PATROL_AREA_SIZE; i++)
-                {
-                    gStaffPatrolAreas[staffPatrolOffset + i] |= gStaffPatrolAreas[peepPatrolOffset + i];
-                }
-            }
+            staffPatrolArea[i] |= peepPatrolArea[i];
         }
     }
 }
@@ -168,28 +165,33 @@ void staff_update_greyed_patrol_areas()
  */
 bool Staff::IsLocationInPatrol(const CoordsXY& loc) const
 {
-    // Check if location is in the park
-    if (!map_is_location_owned_or_has_rights(loc))
+    // Check the patrol area bit map first as it is much cheaper than looking up the surface element
+    if (gStaffModes[StaffId] == StaffMode::Patrol && !IsPatrolAreaSet(loc))
         return false;
 
-    // Check if staff has patrol area
-    if (gStaffModes[StaffId] != StaffMode::Patrol)
-        return true;
-
-    return IsPatrolAreaSet(loc);
+    // Check if location is in the park
+    return map_is_location_owned_or_has_rights(loc);
 }
 
 // Check whether the location x,y is inside and on the edge of the
 // patrol zone for mechanic.
 bool Staff::IsLocationOnPatrolEdge(const CoordsXY& loc) const
 {
-    bool onZoneEdge = false;
-    for (uint8_t neighbourDir = 0; !onZoneEdge && neighbourDir <= 7; neighbourDir++)
+    // Neighbours are usually in the same patrol quad, so test all of their patrol area bits before the ownership of any.
+    if (gStaffModes[StaffId] == StaffMode::Patrol)
+    {
+        for (uint8_t neighbourDir = 0; neighbourDir <= 7; neighbourDir++)
+        {
+            if (!IsPatrolAreaSet(loc + CoordsDirectionDelta[neighbourDir]))
+                return true;
+        }
+    }
+    for (uint8_t neighbourDir = 0; neighbourDir <= 7; neighbourDir++)
     {
-        auto neighbourPos = loc + CoordsDirectionDelta[neighbourDir];
-        onZoneEdge = !IsLocationInPatrol(neighbourPos);
+        if (!map_is_location_owned_or_has_rights(loc + CoordsDirectionDelta[neighbourDir]))
+            return true;
     }
-    return onZoneEdge;
+    return false;
 }
 
 bool Staff::CanIgnoreWideFlag(const CoordsXYZ& staffPos, TileElement* path) const
@@ -421,18 +423,20 @@ void staff_toggle_patrol_area(int32_t staffIndex, const CoordsXY& coords)
  */
 Direction Staff::HandymanDirectionToNearestLitter() const
 {
+    // Only litter on the tiles within MAX_LITTER_DISTANCE can be picked, so scan those tiles instead of all litter. Ties
+    // go to the lowest sprite index to match the order of the litter list.
     uint16_t nearestLitterDist = 0xFFFF;
     Litter* nearestLitter = nullptr;
-    for (auto litter : EntityList<Litter>())
-    {
+    ForEachEntityInRange<Litter>({ x, y }, MAX_LITTER_DISTANCE, [&](Litter* litter) {
         uint16_t distance = abs(litter->x - x) + abs(litter->y - y) + abs(litter->z - z) * 4;
 
-        if (distance < nearestLitterDist)
+        if (distance < nearestLitterDist
+            || (distance == nearestLitterDist && litter->sprite_index < nearestLitter->sprite_index))
         {
             nearestLitterDist = distance;
             nearestLitter = litter;
         }
-    }
+    });
 
     if (nearestLitterDist > MAX_LITTER_DISTANCE)
     {
@@ -17,12 +17,14 @@
 #include "../audio/audio.h"
 #include "../core/Collections.hpp"
 #include "../core/Console.hpp"
+#include "../core/BufferedFileStream.h"
 #include "../core/FileStream.h"
 #include "../core/Guard.hpp"
 #include "../core/IStream.hpp"
 #include "../core/Memory.hpp"
 #include "../core/Path.hpp"
 #include "../core/String.hpp"
+#include "../core/TaskScheduler.h"
 #include "../interface/Window.h"
 #include "../localisation/Date.h"
 #include "../localisation/Localisation.h"
@@ -135,9 +137,6 @@ private:
     std::bitset<MAX_RIDE_OBJECTS> _researchRideEntryUsed{};
     std::bitset<RCT1_RIDE_TYPE_COUNT> _researchRideTypeUsed{};
 
-    // Scenario repository - used for determining scenario name
-    IScenarioRepository* _scenarioRepository = GetScenarioRepository();
-
 public:
     ParkLoadResult Load(const utf8* path) override
     {
@@ -158,14 +157,14 @@ public:
 
     ParkLoadResult LoadSavedGame(const utf8* path, bool skipObjectCheck = false) override
     {
-        auto fs = FileStream(path, FILE_MODE_OPEN);
+        auto fs = BufferedFileStream(path, BufferedFileMode::MemoryMapped);
         auto result = LoadFromStream(&fs, false, skipObjectCheck, path);
         return result;
     }
 
     ParkLoadResult LoadScenario(const utf8* path, bool skipObjectCheck = false) override
     {
-        auto fs = FileStream(path, FILE_MODE_OPEN);
+        auto fs = BufferedFileStream(path, BufferedFileMode::MemoryMapped);
         auto result = LoadFromStream(&fs, true, skipObjectCheck, path);
         return result;
     }
@@ -348,7 +347,8 @@ private:
 
     std::string GetRCT1ScenarioName()
     {
-        const scenario_index_entry* scenarioEntry = _scenarioRepository->GetByInternalName(_s4.scenario_name);
+        // Not looked up on construction, the scenario index itself creates importers while scanning in the background.
+        const scenario_index_entry* scenarioEntry = GetScenarioRepository()->GetByInternalName(_s4.scenario_name);
         if (scenarioEntry == nullptr)
         {
             return "";
@@ -1595,20 +1595,13 @@ private:
         // Build tile pointer cache (needed to get the first element at a certain location)
         auto tilePointerIndex = TilePointerIndex<RCT12TileElement>(RCT1_MAX_MAP_SIZE, _s4.tile_elements);
 
-        TileElement* dstElement = gTileElements;
-
-        for (TileCoordsXY coords = { 0, 0 }; coords.y < MAXIMUM_MAP_SIZE_TECHNICAL; coords.y++)
-        {
-            for (coords.x = 0; coords.x < MAXIMUM_MAP_SIZE_TECHNICAL; coords.x++)
+        // The rows are converted in parallel, each into its own list. A wall can become several elements, so where a
+        // row starts in the map is only known once the rows before it are done.
+        std::vector<std::vector<TileElement>> rows(RCT1_MAX_MAP_SIZE);
+        TaskScheduler::Get().ParallelFor(rows.size(), 1, [this, &rows, &tilePointerIndex](size_t y) {
+            auto& row = rows[y];
+            for (TileCoordsXY coords = { 0, static_cast<int32_t>(y) }; coords.x < RCT1_MAX_MAP_SIZE; coords.x++)
             {
-                if (coords.x >= RCT1_MAX_MAP_SIZE || coords.y >= RCT1_MAX_MAP_SIZE)
-                {
-                    dstElement->ClearAs(TILE_ELEMENT_TYPE_SURFACE);
-                    dstElement->SetLastForTile(true);
-                    dstElement++;
-                    continue;
-                }
-
                 // This is the equivalent of map_get_first_element_at(x, y), but on S4 data.
                 RCT12TileElement* srcElement = tilePointerIndex.GetFirstElementAt(coords);
                 do
@@ -1616,12 +1609,42 @@ private:
                     if (srcElement->base_height == RCT12_MAX_ELEMENT_HEIGHT)
                         continue;
 
-                    auto numAddedElements = ImportTileElement(dstElement, srcElement);
-                    dstElement += numAddedElements;
+                    auto rowSize = row.size();
+                    row.resize(rowSize + MaxElementsPerRCT1Element);
+                    auto numAddedElements = ImportTileElement(&row[rowSize], srcElement);
+                    row.resize(rowSize + numAddedElements);
                 } while (!(srcElement++)->IsLastForTile());
 
                 // Set last element flag in case the original last element was never added
-                (dstElement - 1)->SetLastForTile(true);
+                if (!row.empty())
+                {
+                    row.back().SetLastForTile(true);
+                }
+            }
+        });
+
+        TileElement* dstElement = gTileElements;
+        for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+        {
+            int32_t x = 0;
+            if (y < RCT1_MAX_MAP_SIZE)
+            {
+                for (const auto& element : rows[y])
+                {
+                    *dstElement = element;
+                    if (element.GetType() == TILE_ELEMENT_TYPE_BANNER)
+                    {
+                        ImportBanner(element.AsBanner()->GetIndex());
+                    }
+                    dstElement++;
+                }
+                x = RCT1_MAX_MAP_SIZE;
+            }
+            for (; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+            {
+                dstElement->ClearAs(TILE_ELEMENT_TYPE_SURFACE);
+                dstElement->SetLastForTile(true);
+                dstElement++;
             }
         }
 
@@ -1630,6 +1653,9 @@ private:
         FixEntrancePositions();
     }
 
+    // A wall is split into one element per edge
+    static constexpr size_t MaxElementsPerRCT1Element = 4;
+
     size_t ImportTileElement(TileElement* dst, const RCT12TileElement* src)
     {
         // Todo: allow for changing definition of OpenRCT2 tile element types - replace with a map
@@ -1919,13 +1945,7 @@ private:
                     dst2->SetIndex(BANNER_INDEX_NULL);
                 dst2->SetPosition(src2->GetPosition());
                 dst2->SetAllowedEdges(src2->GetAllowedEdges());
-
-                if (index < std::size(_s4.banners))
-                {
-                    auto srcBanner = &_s4.banners[index];
-                    auto dstBanner = GetBanner(index);
-                    ImportBanner(dstBanner, srcBanner);
-                }
+                // The banner itself is imported by ImportTileElements, the rows are converted on several threads.
                 return 1;
             }
             default:
@@ -2448,6 +2468,14 @@ private:
         }
     }
 
+    void ImportBanner(BannerIndex index)
+    {
+        if (index < std::size(_s4.banners))
+        {
+            ImportBanner(GetBanner(index), &_s4.banners[index]);
+        }
+    }
+
     void ImportBanner(Banner* dst, const RCT12Banner* src)
     {
         *dst = {};
@@ -10,6 +10,10 @@
 #include "SawyerChunkReader.h"
 
 #include "../core/IStream.hpp"
+#include "../core/Profiling.h"
+#include "../core/TaskScheduler.h"
+
+#include <exception>
 
 // malloc is very slow for large allocations in MSVC debug builds as it allocates
 // memory on a special debug heap and then initialises all the memory to 0xCC.
@@ -139,25 +143,90 @@ std::shared_ptr<SawyerChunk> SawyerChunkReader::ReadChunkTrack()
 
 void SawyerChunkReader::ReadChunk(void* dst, size_t length)
 {
-    auto chunk = ReadChunk();
-    auto chunkData = static_cast<const uint8_t*>(chunk->GetData());
-    auto chunkLength = chunk->GetLength();
-    if (chunkLength > length)
+    ReadChunks({ { dst, length } });
+}
+
+void SawyerChunkReader::ReadChunks(const std::vector<ChunkDestination>& destinations)
+{
+    PROFILE_SCOPE("SawyerChunkReader::ReadChunks");
+
+    struct PendingChunk
     {
-        std::memcpy(dst, chunkData, length);
+        sawyercoding_chunk_header Header;
+        std::unique_ptr<uint8_t[]> Data;
+    };
+
+    // The data of each chunk follows its header, so the stream has to be read in order
+    std::vector<PendingChunk> chunks(destinations.size());
+    uint64_t originalPosition = _stream->GetPosition();
+    try
+    {
+        for (auto& chunk : chunks)
+        {
+            chunk.Header = _stream->ReadValue<sawyercoding_chunk_header>();
+            if (chunk.Header.length >= MAX_UNCOMPRESSED_CHUNK_SIZE)
+                throw SawyerChunkException(EXCEPTION_MSG_CORRUPT_CHUNK_SIZE);
+
+            chunk.Data = std::make_unique<uint8_t[]>(chunk.Header.length);
+            if (_stream->TryRead(chunk.Data.get(), chunk.Header.length) != chunk.Header.length)
+                throw SawyerChunkException(EXCEPTION_MSG_CORRUPT_CHUNK_SIZE);
+        }
     }
-    else
+    catch (const std::exception&)
     {
-        std::memcpy(dst, chunkData, chunkLength);
-        auto remainingLength = length - chunkLength;
-        if (remainingLength > 0)
+        // Rewind stream back to original position
+        _stream->SetPosition(originalPosition);
+        throw;
+    }
+
+    std::vector<std::exception_ptr> errors(chunks.size());
+    OpenRCT2::TaskScheduler::Get().ParallelFor(chunks.size(), 1, [&](size_t i) {
+        try
+        {
+            DecodeChunkInto(destinations[i].Data, destinations[i].Length, chunks[i].Data.get(), chunks[i].Header);
+        }
+        catch (const std::exception&)
         {
-            auto offset = static_cast<uint8_t*>(dst) + chunkLength;
-            std::fill_n(offset, remainingLength, 0x00);
+            errors[i] = std::current_exception();
+        }
+    });
+    for (const auto& error : errors)
+    {
+        if (error != nullptr)
+        {
+            _stream->SetPosition(originalPosition);
+            std::rethrow_exception(error);
         }
     }
 }
 
+void SawyerChunkReader::DecodeChunkInto(void* dst, size_t length, const void* src, const sawyercoding_chunk_header& header)
+{
+    size_t chunkLength;
+    try
+    {
+        chunkLength = DecodeChunk(dst, length, src, header);
+    }
+    catch (const SawyerChunkException&)
+    {
+        // Either corrupt or larger than the destination, decode it in full and keep the part that fits
+        auto buffer = std::unique_ptr<uint8_t, decltype(&FreeLargeTempBuffer)>(
+            static_cast<uint8_t*>(AllocateLargeTempBuffer()), &FreeLargeTempBuffer);
+        chunkLength = DecodeChunk(buffer.get(), MAX_UNCOMPRESSED_CHUNK_SIZE, src, header);
+        std::memcpy(dst, buffer.get(), std::min(chunkLength, length));
+    }
+
+    if (chunkLength == 0)
+    {
+        throw SawyerChunkException(EXCEPTION_MSG_ZERO_SIZED_CHUNK);
+    }
+    if (chunkLength < length)
+    {
+        auto offset = static_cast<uint8_t*>(dst) + chunkLength;
+        std::fill_n(offset, length - chunkLength, 0x00);
+    }
+}
+
 size_t SawyerChunkReader::DecodeChunk(void* dst, size_t dstCapacity, const void* src, const sawyercoding_chunk_header& header)
 {
     size_t resultLength;
@@ -252,6 +321,14 @@ size_t SawyerChunkReader::DecodeChunkRepeat(void* dst, size_t dstCapacity, const
     {
         if (src8[i] == 0xFF)
         {
+            if (i + 1 >= srcLength)
+            {
+                throw SawyerChunkException(EXCEPTION_MSG_CORRUPT_RLE);
+            }
+            if (dst8 >= dstEnd)
+            {
+                throw SawyerChunkException(EXCEPTION_MSG_DESTINATION_TOO_SMALL);
+            }
             *dst8++ = src8[++i];
         }
         else
@@ -259,7 +336,8 @@ size_t SawyerChunkReader::DecodeChunkRepeat(void* dst, size_t dstCapacity, const
             size_t count = (src8[i] & 7) + 1;
             const uint8_t* copySrc = dst8 + static_cast<int32_t>(src8[i] >> 3) - 32;
 
-            if (dst8 + count >= dstEnd || copySrc + count >= dstEnd)
+            // Chunks are decoded straight into their destination, so they may end exactly at its end
+            if (dst8 + count > dstEnd || copySrc + count > dstEnd)
             {
                 throw SawyerChunkException(EXCEPTION_MSG_DESTINATION_TOO_SMALL);
             }
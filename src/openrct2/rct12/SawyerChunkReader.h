@@ -15,6 +15,7 @@
 #include "SawyerChunk.h"
 
 #include <memory>
+#include <vector>
 
 class SawyerChunkException : public IOException
 {
@@ -40,6 +41,13 @@ namespace OpenRCT2
  */
 class SawyerChunkReader final
 {
+public:
+    struct ChunkDestination
+    {
+        void* Data;
+        size_t Length;
+    };
+
 private:
     OpenRCT2::IStream* const _stream = nullptr;
 
@@ -72,6 +80,13 @@ public:
      */
     void ReadChunk(void* dst, size_t length);
 
+    /**
+     * Reads the next chunks from the stream, one for each destination, with the same padding and
+     * truncation as ReadChunk. The data is read in order and then decoded in parallel straight
+     * into the destinations.
+     */
+    void ReadChunks(const std::vector<ChunkDestination>& destinations);
+
     /**
      * Reads the next chunk from the stream into a buffer returned as the
      * specified type. If the chunk is smaller than the size of the type
@@ -86,6 +101,7 @@ public:
 
 private:
     static size_t DecodeChunk(void* dst, size_t dstCapacity, const void* src, const sawyercoding_chunk_header& header);
+    static void DecodeChunkInto(void* dst, size_t length, const void* src, const sawyercoding_chunk_header& header);
     static size_t DecodeChunkRLERepeat(void* dst, size_t dstCapacity, const void* src, size_t srcLength);
     static size_t DecodeChunkRLE(void* dst, size_t dstCapacity, const void* src, size_t srcLength);
     static size_t DecodeChunkRepeat(void* dst, size_t dstCapacity, const void* src, size_t srcLength);
@@ -15,8 +15,11 @@
 #include "../OpenRCT2.h"
 #include "../common.h"
 #include "../config/Config.h"
+#include "../core/File.h"
 #include "../core/FileStream.h"
 #include "../core/IStream.hpp"
+#include "../core/MemoryStream.h"
+#include "../core/Path.hpp"
 #include "../core/String.hpp"
 #include "../interface/Viewport.h"
 #include "../interface/Window.h"
@@ -45,7 +48,9 @@
 #include "../world/Climate.h"
 #include "../world/MapAnimation.h"
 #include "../world/Park.h"
+#include "../world/ParkHistory.h"
 #include "../world/Sprite.h"
+#include "S6ParkFile.h"
 
 #include <algorithm>
 #include <cstring>
@@ -81,7 +86,14 @@ void S6Exporter::SaveScenario(OpenRCT2::IStream* stream)
     Save(stream, true);
 }
 
-void S6Exporter::Save(OpenRCT2::IStream* stream, bool isScenario)
+void S6Exporter::SaveParkFile(OpenRCT2::IStream* stream, bool isScenario, OpenRCT2::ChunkFileCache* cache)
+{
+    PrepareHeader(isScenario);
+    _s6.header.num_packed_objects = 0;
+    S6ParkFile::Write(_s6, stream, cache, isScenario ? nullptr : &History);
+}
+
+void S6Exporter::PrepareHeader(bool isScenario)
 {
     _s6.header.type = isScenario ? S6_TYPE_SCENARIO : S6_TYPE_SAVEDGAME;
     _s6.header.classic_flag = 0;
@@ -89,6 +101,11 @@ void S6Exporter::Save(OpenRCT2::IStream* stream, bool isScenario)
     _s6.header.version = S6_RCT2_VERSION;
     _s6.header.magic_number = S6_MAGIC_NUMBER;
     _s6.game_version_number = 201028;
+}
+
+void S6Exporter::Save(OpenRCT2::IStream* stream, bool isScenario)
+{
+    PrepareHeader(isScenario);
 
     auto chunkWriter = SawyerChunkWriter(stream);
 
@@ -151,6 +168,7 @@ void S6Exporter::Save(OpenRCT2::IStream* stream, bool isScenario)
 void S6Exporter::Export()
 {
     _s6.info = gS6Info;
+    History = gParkHistory.Serialise();
     {
         auto temp = utf8_to_rct2(gS6Info.name);
         safe_strcpy(_s6.info.name, temp.data(), sizeof(_s6.info.name));
@@ -1183,9 +1201,10 @@ void S6Exporter::ExportEntityPeep(RCT2SpritePeep* dst, const Peep* src)
     ExportEntityCommonProperties(dst, src);
 
     auto generateName = true;
-    if (src->Name != nullptr)
+    auto name = src->GetCustomName();
+    if (name != nullptr)
     {
-        auto stringId = AllocateUserString(src->Name);
+        auto stringId = AllocateUserString(name);
         if (stringId != std::nullopt)
         {
             dst->name_string_idx = *stringId;
@@ -1195,7 +1214,7 @@ void S6Exporter::ExportEntityPeep(RCT2SpritePeep* dst, const Peep* src)
         {
             log_warning(
                 "Unable to allocate user string for peep #%d (%s) during S6 export.", static_cast<int>(src->sprite_index),
-                src->Name);
+                name);
         }
     }
     if (generateName)
@@ -1425,6 +1444,9 @@ template<> void S6Exporter::ExportEntity(RCT12SpriteLitter* dst, const Litter* s
 
 void S6Exporter::ExportEntities()
 {
+    // Entities are saved at their own index, which has to stay within the S6 sprite list
+    static_assert(MAX_ENTITIES <= RCT2_MAX_SPRITES);
+
     // Clear everything to free
     for (int32_t i = 0; i < RCT2_MAX_SPRITES; i++)
     {
@@ -1831,13 +1853,30 @@ int32_t scenario_save(const utf8* path, int32_t flags)
         window_close_construction_windows();
     }
 
+    bool result = false;
+    auto s6exporter = scenario_export(flags);
+    if (s6exporter != nullptr)
+    {
+        result = scenario_write(*s6exporter, path, flags);
+    }
+
+    gfx_invalidate_screen();
+
+    if (result && !(flags & S6_SAVE_FLAG_AUTOMATIC))
+    {
+        gScreenAge = 0;
+    }
+    return result;
+}
+
+std::unique_ptr<S6Exporter> scenario_export(int32_t flags)
+{
     map_reorganise_elements();
     viewport_set_saved_view();
 
-    bool result = false;
-    auto s6exporter = new S6Exporter();
     try
     {
+        auto s6exporter = std::make_unique<S6Exporter>();
         if (flags & S6_SAVE_FLAG_EXPORT)
         {
             auto& objManager = OpenRCT2::GetContext()->GetObjectManager();
@@ -1845,27 +1884,44 @@ int32_t scenario_save(const utf8* path, int32_t flags)
         }
         s6exporter->RemoveTracklessRides = true;
         s6exporter->Export();
-        if (flags & S6_SAVE_FLAG_SCENARIO)
+        s6exporter->Metadata = ParkMetadata::FromGameState();
+        return s6exporter;
+    }
+    catch (const std::exception& e)
+    {
+        log_error("Unable to save park: '%s'", e.what());
+    }
+    return nullptr;
+}
+
+bool scenario_write(S6Exporter& s6exporter, const utf8* path, int32_t flags, OpenRCT2::ChunkFileCache* chunkCache)
+{
+    try
+    {
+        // Encode in memory, the checksum needs all the written bytes read back
+        OpenRCT2::MemoryStream ms;
+        if (String::Equals(Path::GetExtension(path), ".park", true))
         {
-            s6exporter->SaveScenario(path);
+            s6exporter.SaveParkFile(&ms, (flags & S6_SAVE_FLAG_SCENARIO) != 0, chunkCache);
+        }
+        else if (flags & S6_SAVE_FLAG_SCENARIO)
+        {
+            s6exporter.SaveScenario(&ms);
         }
         else
         {
-            s6exporter->SaveGame(path);
+            s6exporter.SaveGame(&ms);
+        }
+        File::WriteAllBytes(path, ms.GetData(), ms.GetLength());
+        if (s6exporter.Metadata.has_value())
+        {
+            park_metadata_cache_get().Update(path, *s6exporter.Metadata);
         }
-        result = true;
+        return true;
     }
     catch (const std::exception& e)
     {
         log_error("Unable to save park: '%s'", e.what());
     }
-    delete s6exporter;
-
-    gfx_invalidate_screen();
-
-    if (result && !(flags & S6_SAVE_FLAG_AUTOMATIC))
-    {
-        gScreenAge = 0;
-    }
-    return result;
+    return false;
 }
@@ -9,10 +9,12 @@
 
 #pragma once
 
+#include "../ParkMetadata.h"
 #include "../common.h"
 #include "../object/ObjectList.h"
 #include "../scenario/Scenario.h"
 
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -20,6 +22,7 @@
 
 namespace OpenRCT2
 {
+    class ChunkFileCache;
     struct IStream;
 }
 
@@ -37,6 +40,10 @@ class S6Exporter final
 public:
     bool RemoveTracklessRides;
     std::vector<const ObjectRepositoryItem*> ExportObjectsList;
+    // Recorded in the metadata cache by scenario_write
+    std::optional<ParkMetadata> Metadata;
+    // The serialised ParkHistory, only park files of saved games store it
+    std::vector<uint8_t> History;
 
     S6Exporter();
 
@@ -44,6 +51,7 @@ public:
     void SaveGame(OpenRCT2::IStream* stream);
     void SaveScenario(const utf8* path);
     void SaveScenario(OpenRCT2::IStream* stream);
+    void SaveParkFile(OpenRCT2::IStream* stream, bool isScenario, OpenRCT2::ChunkFileCache* cache = nullptr);
     void Export();
     void ExportParkName();
     void ExportRides();
@@ -58,6 +66,7 @@ private:
     std::vector<std::string> _userStrings;
 
     void Save(OpenRCT2::IStream* stream, bool isScenario);
+    void PrepareHeader(bool isScenario);
     static uint32_t GetLoanHash(money32 initialCash, money32 bankLoan, uint32_t maxBankLoan);
     void ExportResearchedRideTypes();
     void ExportResearchedRideEntries();
@@ -79,3 +88,18 @@ private:
     void ExportUserStrings();
     void RebuildEntityLinks();
 };
+
+/**
+ * Copies the current park into a new exporter, takes the same flags as scenario_save. Nothing is
+ * encoded or written yet so this part is quick and must run on the game thread.
+ */
+std::unique_ptr<S6Exporter> scenario_export(int32_t flags);
+
+/**
+ * Encodes and writes a park captured by scenario_export. Unless objects are packed this only uses
+ * the exporter, so it can run on a background thread while the game carries on. The metadata is
+ * added to the cache for the load / save window once the file is written. Paths ending in .park
+ * are written as park files, reusing the unchanged chunks of chunkCache if given.
+ */
+bool scenario_write(
+    S6Exporter& s6exporter, const utf8* path, int32_t flags, OpenRCT2::ChunkFileCache* chunkCache = nullptr);
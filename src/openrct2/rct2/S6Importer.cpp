@@ -14,7 +14,9 @@
 #include "../OpenRCT2.h"
 #include "../ParkImporter.h"
 #include "../config/Config.h"
+#include "../core/ChunkFile.h"
 #include "../core/Console.hpp"
+#include "../core/BufferedFileStream.h"
 #include "../core/FileStream.h"
 #include "../core/IStream.hpp"
 #include "../core/Path.hpp"
@@ -52,9 +54,11 @@
 #include "../world/Entrance.h"
 #include "../world/MapAnimation.h"
 #include "../world/Park.h"
+#include "../world/ParkHistory.h"
 #include "../world/Scenery.h"
 #include "../world/Sprite.h"
 #include "../world/Surface.h"
+#include "S6ParkFile.h"
 
 #include <algorithm>
 
@@ -70,6 +74,8 @@ private:
     rct_s6_data _s6{};
     uint8_t _gameVersion = 0;
     bool _isSV7 = false;
+    // The serialised ParkHistory, only park files have one
+    std::vector<uint8_t> _history;
 
 public:
     S6Importer(IObjectRepository& objectRepository)
@@ -88,6 +94,15 @@ public:
         {
             return LoadSavedGame(path);
         }
+        else if (String::Equals(extension, ".park", true))
+        {
+            auto fs = OpenRCT2::BufferedFileStream(path, OpenRCT2::BufferedFileMode::MemoryMapped);
+            auto header = S6ParkFile::ReadHeader(&fs);
+            fs.SetPosition(0);
+            auto result = LoadFromStream(&fs, header.type == S6_TYPE_SCENARIO);
+            _s6Path = path;
+            return result;
+        }
         else
         {
             throw std::runtime_error("Invalid RCT2 park extension.");
@@ -96,7 +111,7 @@ public:
 
     ParkLoadResult LoadSavedGame(const utf8* path, bool skipObjectCheck = false) override
     {
-        auto fs = OpenRCT2::FileStream(path, OpenRCT2::FILE_MODE_OPEN);
+        auto fs = OpenRCT2::BufferedFileStream(path, OpenRCT2::BufferedFileMode::MemoryMapped);
         auto result = LoadFromStream(&fs, false, skipObjectCheck);
         _s6Path = path;
         return result;
@@ -104,7 +119,7 @@ public:
 
     ParkLoadResult LoadScenario(const utf8* path, bool skipObjectCheck = false) override
     {
-        auto fs = OpenRCT2::FileStream(path, OpenRCT2::FILE_MODE_OPEN);
+        auto fs = OpenRCT2::BufferedFileStream(path, OpenRCT2::BufferedFileMode::MemoryMapped);
         auto result = LoadFromStream(&fs, true, skipObjectCheck);
         _s6Path = path;
         return result;
@@ -114,6 +129,12 @@ public:
         OpenRCT2::IStream* stream, bool isScenario, [[maybe_unused]] bool skipObjectCheck = false,
         const utf8* path = String::Empty) override
     {
+        _history.clear();
+        if (OpenRCT2::ChunkFile::IsChunkFile(stream))
+        {
+            return LoadFromParkFile(stream, isScenario, path);
+        }
+
         if (isScenario && !gConfigGeneral.allow_loading_with_incorrect_checksum && !SawyerEncoding::ValidateChecksum(stream))
         {
             throw IOException("Invalid checksum.");
@@ -157,26 +178,31 @@ public:
             _isSV7 = _stricmp(extension, ".sv7") == 0;
         }
 
+        // The remaining chunks are decoded in parallel, straight into _s6
         if (isScenario)
         {
-            chunkReader.ReadChunk(&_s6.objects, sizeof(_s6.objects));
-            chunkReader.ReadChunk(&_s6.elapsed_months, 16);
-            chunkReader.ReadChunk(&_s6.tile_elements, sizeof(_s6.tile_elements));
-            chunkReader.ReadChunk(&_s6.next_free_tile_element_pointer_index, 2560076);
-            chunkReader.ReadChunk(&_s6.guests_in_park, 4);
-            chunkReader.ReadChunk(&_s6.last_guests_in_park, 8);
-            chunkReader.ReadChunk(&_s6.park_rating, 2);
-            chunkReader.ReadChunk(&_s6.active_research_types, 1082);
-            chunkReader.ReadChunk(&_s6.current_expenditure, 16);
-            chunkReader.ReadChunk(&_s6.park_value, 4);
-            chunkReader.ReadChunk(&_s6.completed_company_value, 483816);
+            chunkReader.ReadChunks({
+                { &_s6.objects, sizeof(_s6.objects) },
+                { &_s6.elapsed_months, 16 },
+                { &_s6.tile_elements, sizeof(_s6.tile_elements) },
+                { &_s6.next_free_tile_element_pointer_index, 2560076 },
+                { &_s6.guests_in_park, 4 },
+                { &_s6.last_guests_in_park, 8 },
+                { &_s6.park_rating, 2 },
+                { &_s6.active_research_types, 1082 },
+                { &_s6.current_expenditure, 16 },
+                { &_s6.park_value, 4 },
+                { &_s6.completed_company_value, 483816 },
+            });
         }
         else
         {
-            chunkReader.ReadChunk(&_s6.objects, sizeof(_s6.objects));
-            chunkReader.ReadChunk(&_s6.elapsed_months, 16);
-            chunkReader.ReadChunk(&_s6.tile_elements, sizeof(_s6.tile_elements));
-            chunkReader.ReadChunk(&_s6.next_free_tile_element_pointer_index, 3048816);
+            chunkReader.ReadChunks({
+                { &_s6.objects, sizeof(_s6.objects) },
+                { &_s6.elapsed_months, 16 },
+                { &_s6.tile_elements, sizeof(_s6.tile_elements) },
+                { &_s6.next_free_tile_element_pointer_index, 3048816 },
+            });
         }
 
         _s6Path = path;
@@ -184,6 +210,23 @@ public:
         return ParkLoadResult(GetRequiredObjects());
     }
 
+    ParkLoadResult LoadFromParkFile(OpenRCT2::IStream* stream, bool isScenario, const utf8* path)
+    {
+        S6ParkFile::Read(_s6, stream, &_history);
+        if (isScenario && _s6.header.type != S6_TYPE_SCENARIO)
+        {
+            throw std::runtime_error("Park is not a scenario.");
+        }
+        if (!isScenario && _s6.header.type != S6_TYPE_SAVEDGAME)
+        {
+            throw std::runtime_error("Park is not a saved game.");
+        }
+
+        _isSV7 = false;
+        _s6Path = path;
+        return ParkLoadResult(GetRequiredObjects());
+    }
+
     bool GetDetails(scenario_index_entry* dst) override
     {
         *dst = {};
@@ -193,6 +236,10 @@ public:
     void Import() override
     {
         Initialise();
+        if (!_history.empty())
+        {
+            gParkHistory.Deserialise(_history);
+        }
 
         // _s6.header
         gS6Info = _s6.info;
@@ -0,0 +1,287 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "S6ParkFile.h"
+
+#include "../core/ChunkFile.h"
+#include "../core/IStream.hpp"
+#include "../scenario/Scenario.h"
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+using namespace OpenRCT2;
+
+namespace S6ParkFile
+{
+    struct Region
+    {
+        size_t Begin;
+        size_t End;
+    };
+
+    // Everything after the tile elements is stored as SV6 chunk 6
+    constexpr size_t BLOCK_LENGTH = 0x2E8570;
+
+    // The history is dropped rather than read when it claims to be larger than this
+    constexpr uint64_t MAX_HISTORY_LENGTH = 64 * 1024 * 1024;
+
+    // Rows of tiles whose elements are stored in each tile element chunk
+    constexpr size_t REGION_ROWS = 16;
+    constexpr size_t NUM_TILE_REGIONS = RCT2_MAXIMUM_MAP_SIZE_TECHNICAL / REGION_ROWS;
+
+    /**
+     * Offsets of the parts of rct_s6_data stored in their own chunks, the struct is not standard
+     * layout so these are taken from an instance rather than with offsetof.
+     */
+    struct Layout
+    {
+        Region Block;
+        Region Entities;
+        Region Research;
+        Region Rides;
+        // The rest of the block goes in to the park chunk
+        std::array<Region, 4> ParkRegions;
+        // The parts of the block stored in SC6 chunks 6 to 13, the fields in between are ignored in scenarios
+        std::array<Region, 8> ScenarioRegions;
+    };
+
+    static size_t GetOffset(const rct_s6_data& s6, const void* field)
+    {
+        return static_cast<size_t>(static_cast<const uint8_t*>(field) - reinterpret_cast<const uint8_t*>(&s6));
+    }
+
+    static Region GetRegion(const rct_s6_data& s6, const void* field, size_t length)
+    {
+        auto offset = GetOffset(s6, field);
+        return { offset, offset + length };
+    }
+
+    static Layout GetLayout(const rct_s6_data& s6)
+    {
+        Layout layout;
+        layout.Block = GetRegion(s6, &s6.next_free_tile_element_pointer_index, BLOCK_LENGTH);
+        layout.Entities = GetRegion(s6, s6.sprites, sizeof(s6.sprites));
+        layout.Research = GetRegion(s6, s6.research_items, sizeof(s6.research_items));
+        layout.Rides = GetRegion(s6, s6.rides, sizeof(s6.rides));
+        layout.ParkRegions = { {
+            { layout.Block.Begin, layout.Entities.Begin },
+            { layout.Entities.End, layout.Research.Begin },
+            { layout.Research.End, layout.Rides.Begin },
+            { layout.Rides.End, layout.Block.End },
+        } };
+        layout.ScenarioRegions = { {
+            GetRegion(s6, &s6.next_free_tile_element_pointer_index, 0x27104C),
+            GetRegion(s6, &s6.guests_in_park, 4),
+            GetRegion(s6, &s6.last_guests_in_park, 8),
+            GetRegion(s6, &s6.park_rating, 2),
+            GetRegion(s6, &s6.active_research_types, 1082),
+            GetRegion(s6, &s6.current_expenditure, 16),
+            GetRegion(s6, &s6.park_value, 4),
+            GetRegion(s6, &s6.completed_company_value, 0x761E8),
+        } };
+        return layout;
+    }
+
+    static size_t GetLength(const Region& region)
+    {
+        return region.End - region.Begin;
+    }
+
+    static size_t GetParkChunkLength(const Layout& layout)
+    {
+        size_t length = 0;
+        for (const auto& region : layout.ParkRegions)
+        {
+            length += GetLength(region);
+        }
+        return length;
+    }
+
+    static uint8_t* GetRegionData(rct_s6_data& s6, const Region& region)
+    {
+        return reinterpret_cast<uint8_t*>(&s6) + region.Begin;
+    }
+
+    static const uint8_t* GetRegionData(const rct_s6_data& s6, const Region& region)
+    {
+        return reinterpret_cast<const uint8_t*>(&s6) + region.Begin;
+    }
+
+    /**
+     * Zeroes the fields a scenario does not store, as they would be after loading an SC6.
+     */
+    static void ClearScenarioIgnoredFields(rct_s6_data& s6, const Layout& layout)
+    {
+        std::vector<uint8_t> block(GetLength(layout.Block));
+        for (const auto& region : layout.ScenarioRegions)
+        {
+            std::memcpy(block.data() + (region.Begin - layout.Block.Begin), GetRegionData(s6, region), GetLength(region));
+        }
+        std::memcpy(GetRegionData(s6, layout.Block), block.data(), block.size());
+    }
+
+    /**
+     * Splits the tile elements after every REGION_ROWS rows of tiles, the last region holds the unused
+     * elements after the last tile.
+     */
+    static std::array<size_t, NUM_TILE_REGIONS + 2> GetTileRegionBounds(const rct_s6_data& s6)
+    {
+        std::array<size_t, NUM_TILE_REGIONS + 2> bounds{};
+        constexpr size_t tilesPerRegion = REGION_ROWS * RCT2_MAXIMUM_MAP_SIZE_TECHNICAL;
+        size_t region = 1;
+        size_t numTiles = 0;
+        for (size_t i = 0; i < RCT2_MAX_TILE_ELEMENTS && region <= NUM_TILE_REGIONS; i++)
+        {
+            if (s6.tile_elements[i].IsLastForTile())
+            {
+                numTiles++;
+                if (numTiles == region * tilesPerRegion)
+                {
+                    bounds[region++] = i + 1;
+                }
+            }
+        }
+        // Only happens for corrupt maps, the elements are still all stored
+        for (; region <= NUM_TILE_REGIONS; region++)
+        {
+            bounds[region] = RCT2_MAX_TILE_ELEMENTS;
+        }
+        bounds[NUM_TILE_REGIONS + 1] = RCT2_MAX_TILE_ELEMENTS;
+        return bounds;
+    }
+
+    void Write(const rct_s6_data& s6, IStream* stream, ChunkFileCache* cache, const std::vector<uint8_t>* history)
+    {
+        auto layout = GetLayout(s6);
+        std::vector<uint8_t> parkData;
+        parkData.reserve(GetParkChunkLength(layout));
+        for (const auto& region : layout.ParkRegions)
+        {
+            auto data = GetRegionData(s6, region);
+            parkData.insert(parkData.end(), data, data + GetLength(region));
+        }
+
+        ChunkFileWriter writer;
+        writer.AddChunk(EnumValue(ChunkId::Header), &s6.header, sizeof(s6.header));
+        writer.AddChunk(EnumValue(ChunkId::Info), &s6.info, sizeof(s6.info));
+        writer.AddChunk(EnumValue(ChunkId::Objects), s6.objects, sizeof(s6.objects));
+        writer.AddChunk(EnumValue(ChunkId::Game), &s6.elapsed_months, 16);
+        auto tileRegionBounds = GetTileRegionBounds(s6);
+        for (size_t i = 0; i + 1 < tileRegionBounds.size(); i++)
+        {
+            auto begin = tileRegionBounds[i];
+            auto length = (tileRegionBounds[i + 1] - begin) * sizeof(RCT12TileElement);
+            auto id = EnumValue(ChunkId::TileElementRegions) + static_cast<uint32_t>(i);
+            writer.AddChunk(id, &s6.tile_elements[begin], length);
+        }
+        writer.AddChunk(EnumValue(ChunkId::Entities), GetRegionData(s6, layout.Entities), GetLength(layout.Entities));
+        writer.AddChunk(EnumValue(ChunkId::Research), GetRegionData(s6, layout.Research), GetLength(layout.Research));
+        writer.AddChunk(EnumValue(ChunkId::Rides), GetRegionData(s6, layout.Rides), GetLength(layout.Rides));
+        writer.AddChunk(EnumValue(ChunkId::Park), parkData.data(), parkData.size());
+        if (history != nullptr && !history->empty())
+        {
+            writer.AddChunk(EnumValue(ChunkId::History), history->data(), history->size());
+        }
+        writer.Write(stream, cache);
+    }
+
+    static void AddTileElementRequests(
+        rct_s6_data& s6, const ChunkFileReader& reader, std::vector<ChunkFileReader::ChunkRequest>& requests)
+    {
+        if (reader.FindChunk(EnumValue(ChunkId::TileElements)) != nullptr)
+        {
+            requests.push_back({ EnumValue(ChunkId::TileElements), s6.tile_elements, sizeof(s6.tile_elements) });
+            return;
+        }
+
+        // The regions have to add up to all the tile elements
+        size_t offset = 0;
+        for (uint32_t i = 0; i < NUM_TILE_REGIONS + 1; i++)
+        {
+            auto id = EnumValue(ChunkId::TileElementRegions) + i;
+            auto entry = reader.FindChunk(id);
+            if (entry == nullptr)
+                throw IOException("Tile element chunk not found.");
+            if (entry->UncompressedLength > sizeof(s6.tile_elements) - offset)
+                throw IOException("Too many tile elements.");
+
+            auto length = static_cast<size_t>(entry->UncompressedLength);
+            requests.push_back({ id, reinterpret_cast<uint8_t*>(s6.tile_elements) + offset, length });
+            offset += length;
+        }
+        if (offset != sizeof(s6.tile_elements))
+            throw IOException("Too few tile elements.");
+    }
+
+    void Read(rct_s6_data& s6, IStream* stream, std::vector<uint8_t>* history)
+    {
+        auto layout = GetLayout(s6);
+        std::vector<uint8_t> parkData(GetParkChunkLength(layout));
+
+        ChunkFileReader reader(stream);
+        std::vector<ChunkFileReader::ChunkRequest> requests = {
+            { EnumValue(ChunkId::Header), &s6.header, sizeof(s6.header) },
+            { EnumValue(ChunkId::Info), &s6.info, sizeof(s6.info) },
+            { EnumValue(ChunkId::Objects), s6.objects, sizeof(s6.objects) },
+            { EnumValue(ChunkId::Game), &s6.elapsed_months, 16 },
+            { EnumValue(ChunkId::Entities), GetRegionData(s6, layout.Entities), GetLength(layout.Entities) },
+            { EnumValue(ChunkId::Research), GetRegionData(s6, layout.Research), GetLength(layout.Research) },
+            { EnumValue(ChunkId::Rides), GetRegionData(s6, layout.Rides), GetLength(layout.Rides) },
+            { EnumValue(ChunkId::Park), parkData.data(), parkData.size() },
+        };
+        AddTileElementRequests(s6, reader, requests);
+        if (history != nullptr)
+        {
+            history->clear();
+            auto historyEntry = reader.FindChunk(EnumValue(ChunkId::History));
+            if (historyEntry != nullptr && historyEntry->UncompressedLength <= MAX_HISTORY_LENGTH)
+            {
+                history->resize(static_cast<size_t>(historyEntry->UncompressedLength));
+                requests.push_back({ EnumValue(ChunkId::History), history->data(), history->size() });
+            }
+        }
+        reader.ReadChunks(requests);
+
+        size_t offset = 0;
+        for (const auto& region : layout.ParkRegions)
+        {
+            std::memcpy(GetRegionData(s6, region), parkData.data() + offset, GetLength(region));
+            offset += GetLength(region);
+        }
+
+        if (s6.header.num_packed_objects != 0)
+        {
+            throw IOException("Park files can not contain packed objects.");
+        }
+
+        if (s6.header.type == S6_TYPE_SCENARIO)
+        {
+            ClearScenarioIgnoredFields(s6, layout);
+        }
+    }
+
+    rct_s6_header ReadHeader(IStream* stream)
+    {
+        rct_s6_header header;
+        ChunkFileReader reader(stream);
+        reader.ReadChunk(EnumValue(ChunkId::Header), &header, sizeof(header));
+        return header;
+    }
+
+    rct_s6_info ReadInfo(IStream* stream)
+    {
+        rct_s6_info info;
+        ChunkFileReader reader(stream);
+        reader.ReadChunk(EnumValue(ChunkId::Info), &info, sizeof(info));
+        return info;
+    }
+} // namespace S6ParkFile
@@ -0,0 +1,66 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+
+#include <vector>
+
+namespace OpenRCT2
+{
+    class ChunkFileCache;
+    struct IStream;
+}
+
+struct rct_s6_data;
+struct rct_s6_header;
+struct rct_s6_info;
+
+/**
+ * OpenRCT2 park file (*.park), the same data as an SV6 / SC6 split into independently compressed
+ * chunks of a ChunkFile. Packed objects are not supported, the objects have to be installed.
+ */
+namespace S6ParkFile
+{
+    enum class ChunkId : uint32_t
+    {
+        Header,
+        Info,
+        Objects,
+        Game,
+        TileElements,
+        Entities,
+        Research,
+        Rides,
+        Park,
+        // Optional, the ParkHistory of saved games
+        History,
+
+        // The tile elements of each band of map rows, followed by the unused elements. Files written
+        // before the split store them all in the TileElements chunk.
+        TileElementRegions = 0x100,
+    };
+
+    /**
+     * Writes the park, with a cache the chunks that did not change since the previous write are not
+     * compressed again. Tile elements are split by map region so building in one part of the park does
+     * not invalidate the rest of the map.
+     */
+    void Write(
+        const rct_s6_data& s6, OpenRCT2::IStream* stream, OpenRCT2::ChunkFileCache* cache = nullptr,
+        const std::vector<uint8_t>* history = nullptr);
+    void Read(rct_s6_data& s6, OpenRCT2::IStream* stream, std::vector<uint8_t>* history = nullptr);
+
+    /**
+     * Reads just the header or the scenario info, without decoding the rest of the park.
+     */
+    rct_s6_header ReadHeader(OpenRCT2::IStream* stream);
+    rct_s6_info ReadInfo(OpenRCT2::IStream* stream);
+} // namespace S6ParkFile
@@ -26,6 +26,7 @@
 #include "../config/Config.h"
 #include "../core/FixedVector.h"
 #include "../core/Guard.hpp"
+#include "../core/Profiling.h"
 #include "../interface/Window.h"
 #include "../localisation/Date.h"
 #include "../localisation/Localisation.h"
@@ -1971,6 +1972,8 @@ int32_t ride_initialise_construction_window(Ride* ride)
  */
 void Ride::UpdateAll()
 {
+    PROFILE_SCOPE("Ride::UpdateAll");
+
     // Remove all rides if scenario editor
     if (gScreenFlags & SCREEN_FLAGS_SCENARIO_EDITOR)
     {
@@ -1995,9 +1998,13 @@ void Ride::UpdateAll()
 
     window_update_viewport_ride_music();
 
-    // Update rides
-    for (auto& ride : GetRideManager())
-        ride.Update();
+    // Rides are updated in index order every tick, breakdowns and inspections draw from the scenario random number
+    // generator so neither the order nor the cadence can change without desynchronising existing saves and replays.
+    {
+        PROFILE_SCOPE("Ride::Update");
+        for (auto& ride : GetRideManager())
+            ride.Update();
+    }
 
     OpenRCT2::RideAudio::UpdateMusicChannels();
 }
@@ -147,6 +147,17 @@ struct rct_ride_entry
     }
 };
 
+/**
+ * An element found by one of the station lookups in Station.cpp. It is reused for as long as the station asks for the
+ * same location and TileChangesGetVersion() has not moved on, i.e. no tile elements were inserted, removed or moved.
+ */
+struct RideStationCachedElement
+{
+    TileElement* Element{};
+    CoordsXYZ Location;
+    uint32_t TileVersion{};
+};
+
 struct RideStation
 {
     CoordsXY Start;
@@ -161,6 +172,9 @@ struct RideStation
     uint8_t QueueTime;
     uint16_t QueueLength;
     uint16_t LastPeepInQueue;
+    RideStationCachedElement CachedStart;
+    RideStationCachedElement CachedEntrance;
+    RideStationCachedElement CachedExit;
 
     static constexpr uint8_t NO_TRAIN = std::numeric_limits<uint8_t>::max();
 
@@ -169,6 +183,11 @@ struct RideStation
     CoordsXYZ GetStart() const;
 };
 
+/**
+ * Data logged for the ride graphs window. One sample is stored every two ticks, averaged over both ticks, and the log
+ * restarts when the logged vehicle departs from the station it started at. Only the MAX_RIDE_MEASUREMENTS most
+ * recently viewed rides are logged.
+ */
 struct RideMeasurement
 {
     static constexpr size_t MAX_ITEMS = 4800;
@@ -309,15 +309,30 @@ namespace OpenRCT2::RideAudio
     {
         if (offset < length)
         {
+            ViewportRideMusicInstance* instance = nullptr;
             if (_musicInstances.size() < MAX_RIDE_MUSIC_CHANNELS)
             {
-                auto& instance = _musicInstances.emplace_back();
-                instance.RideId = ride.id;
-                instance.TrackIndex = ride.music_tune_id;
-                instance.Offset = offset;
-                instance.Volume = volume;
-                instance.Pan = pan;
-                instance.Frequency = sampleRate;
+                instance = &_musicInstances.emplace_back();
+            }
+            else
+            {
+                // Out of channels, the ride is heard instead of the quietest one if it is louder
+                auto quietest = std::min_element(
+                    _musicInstances.begin(), _musicInstances.end(),
+                    [](const auto& a, const auto& b) { return a.Volume < b.Volume; });
+                if (quietest->Volume < volume)
+                {
+                    instance = &*quietest;
+                }
+            }
+            if (instance != nullptr)
+            {
+                instance->RideId = ride.id;
+                instance->TrackIndex = ride.music_tune_id;
+                instance->Offset = offset;
+                instance->Volume = volume;
+                instance->Pan = pan;
+                instance->Frequency = sampleRate;
             }
             ride.music_position = static_cast<uint32_t>(offset);
         }
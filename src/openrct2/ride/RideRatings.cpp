@@ -112,7 +112,9 @@ void ride_ratings_update_ride(const Ride& ride)
 }
 
 /**
- *
+ * Advances the rating state machine by one step. The pace at which rides are rated is part of the game state: the
+ * progress in gRideRatingsCalcData is saved in parks and ratings have to appear on the same tick for every client and
+ * replay, so the calculation is not moved to a worker or spread over several rides at once.
  *  rct2: 0x006B5A2A
  */
 void ride_ratings_update_all()
@@ -0,0 +1,147 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "RideSpatialIndex.h"
+
+#include "../world/Map.h"
+#include "../world/TileElementsView.h"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+using namespace OpenRCT2;
+
+static constexpr int32_t CellsPerAxis = MAXIMUM_MAP_SIZE_TECHNICAL / RIDE_SPATIAL_INDEX_CELL_SIZE;
+
+namespace
+{
+    struct RideSpatialIndexTile
+    {
+        uint8_t X;
+        uint8_t Y;
+        ride_id_t RideIndex;
+    };
+
+    struct RideSpatialIndexCell
+    {
+        bool Dirty = true;
+        std::bitset<MAX_RIDES> Rides;
+        std::vector<RideSpatialIndexTile> Tiles;
+    };
+} // namespace
+
+static std::array<RideSpatialIndexCell, CellsPerAxis * CellsPerAxis> _cells;
+static bool _anyCellDirty = true;
+
+static void RebuildCell(int32_t cellX, int32_t cellY)
+{
+    auto& cell = _cells[cellY * CellsPerAxis + cellX];
+    cell.Rides.reset();
+    cell.Tiles.clear();
+
+    for (int32_t y = cellY * RIDE_SPATIAL_INDEX_CELL_SIZE; y < (cellY + 1) * RIDE_SPATIAL_INDEX_CELL_SIZE; y++)
+    {
+        for (int32_t x = cellX * RIDE_SPATIAL_INDEX_CELL_SIZE; x < (cellX + 1) * RIDE_SPATIAL_INDEX_CELL_SIZE; x++)
+        {
+            for (auto* trackElement : TileElementsView<TrackElement>(TileCoordsXY{ x, y }.ToCoordsXY()))
+            {
+                auto rideIndex = trackElement->GetRideIndex();
+                if (rideIndex >= MAX_RIDES)
+                    continue;
+
+                cell.Rides[rideIndex] = true;
+                if (cell.Tiles.empty() || cell.Tiles.back().X != x || cell.Tiles.back().Y != y
+                    || cell.Tiles.back().RideIndex != rideIndex)
+                {
+                    cell.Tiles.push_back({ static_cast<uint8_t>(x), static_cast<uint8_t>(y), rideIndex });
+                }
+            }
+        }
+    }
+    cell.Dirty = false;
+}
+
+void RideSpatialIndexUpdate()
+{
+    if (!_anyCellDirty)
+        return;
+
+    for (int32_t cellY = 0; cellY < CellsPerAxis; cellY++)
+    {
+        for (int32_t cellX = 0; cellX < CellsPerAxis; cellX++)
+        {
+            if (_cells[cellY * CellsPerAxis + cellX].Dirty)
+            {
+                RebuildCell(cellX, cellY);
+            }
+        }
+    }
+    _anyCellDirty = false;
+}
+
+std::bitset<MAX_RIDES> RideSpatialIndexQuery(const TileCoordsXY& mins, const TileCoordsXY& maxs)
+{
+    RideSpatialIndexUpdate();
+
+    std::bitset<MAX_RIDES> result;
+    const auto minX = std::max(mins.x, 0);
+    const auto minY = std::max(mins.y, 0);
+    const auto maxX = std::min(maxs.x, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+    const auto maxY = std::min(maxs.y, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+    if (minX > maxX || minY > maxY)
+        return result;
+
+    for (int32_t cellY = minY / RIDE_SPATIAL_INDEX_CELL_SIZE; cellY <= maxY / RIDE_SPATIAL_INDEX_CELL_SIZE; cellY++)
+    {
+        for (int32_t cellX = minX / RIDE_SPATIAL_INDEX_CELL_SIZE; cellX <= maxX / RIDE_SPATIAL_INDEX_CELL_SIZE; cellX++)
+        {
+            const auto& cell = _cells[cellY * CellsPerAxis + cellX];
+            if (cell.Tiles.empty())
+                continue;
+
+            const auto cellMinX = cellX * RIDE_SPATIAL_INDEX_CELL_SIZE;
+            const auto cellMinY = cellY * RIDE_SPATIAL_INDEX_CELL_SIZE;
+            if (cellMinX >= minX && cellMinY >= minY && cellMinX + RIDE_SPATIAL_INDEX_CELL_SIZE - 1 <= maxX
+                && cellMinY + RIDE_SPATIAL_INDEX_CELL_SIZE - 1 <= maxY)
+            {
+                result |= cell.Rides;
+                continue;
+            }
+
+            for (const auto& tile : cell.Tiles)
+            {
+                if (tile.X >= minX && tile.X <= maxX && tile.Y >= minY && tile.Y <= maxY)
+                {
+                    result[tile.RideIndex] = true;
+                }
+            }
+        }
+    }
+    return result;
+}
+
+void RideSpatialIndexInvalidateTile(const CoordsXY& tilePos)
+{
+    if (!map_is_location_valid(tilePos))
+        return;
+
+    const auto tile = TileCoordsXY{ tilePos };
+    _cells[(tile.y / RIDE_SPATIAL_INDEX_CELL_SIZE) * CellsPerAxis + tile.x / RIDE_SPATIAL_INDEX_CELL_SIZE].Dirty = true;
+    _anyCellDirty = true;
+}
+
+void RideSpatialIndexInvalidateAll()
+{
+    for (auto& cell : _cells)
+    {
+        cell.Dirty = true;
+    }
+    _anyCellDirty = true;
+}
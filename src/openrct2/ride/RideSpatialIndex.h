@@ -0,0 +1,38 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "../world/Location.hpp"
+#include "Ride.h"
+
+#include <bitset>
+
+/*
+ * Coarse lookup of the rides that have track on a given area of the map. The map is split into
+ * cells of RIDE_SPATIAL_INDEX_CELL_SIZE x RIDE_SPATIAL_INDEX_CELL_SIZE tiles, each of which
+ * keeps the set of rides with track in the cell and the track tiles themselves, so queries over
+ * partly covered cells stay exact. Cells are rebuilt from the map on the next update after they
+ * have been invalidated.
+ */
+constexpr int32_t RIDE_SPATIAL_INDEX_CELL_SIZE = 8;
+
+/**
+ * Rebuilds the invalidated cells, has to be called before querying from worker threads.
+ */
+void RideSpatialIndexUpdate();
+
+/**
+ * Returns the rides that have a track element on any tile between mins and maxs, inclusive.
+ */
+std::bitset<MAX_RIDES> RideSpatialIndexQuery(const TileCoordsXY& mins, const TileCoordsXY& maxs);
+
+void RideSpatialIndexInvalidateTile(const CoordsXY& tilePos);
+void RideSpatialIndexInvalidateAll();
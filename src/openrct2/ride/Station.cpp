@@ -13,6 +13,7 @@
 #include "../scenario/Scenario.h"
 #include "../world/Location.hpp"
 #include "../world/Sprite.h"
+#include "../world/TileChanges.h"
 #include "Track.h"
 
 static void ride_update_station_blocksection(Ride* ride, StationIndex stationIndex);
@@ -327,24 +328,87 @@ static void ride_invalidate_station_start(Ride* ride, StationIndex stationIndex,
     map_invalidate_tile_zoom1({ startPos, tileElement->GetBaseZ(), tileElement->GetClearanceZ() });
 }
 
+static TileElement* ride_station_get_cached_element(const RideStationCachedElement& cached, const CoordsXYZ& location)
+{
+    if (cached.Element == nullptr || cached.TileVersion != TileChangesGetVersion() || !(cached.Location == location))
+        return nullptr;
+    return cached.Element;
+}
+
+static void ride_station_set_cached_element(
+    RideStationCachedElement& cached, const CoordsXYZ& location, TileElement* tileElement)
+{
+    cached.Element = tileElement;
+    cached.Location = location;
+    cached.TileVersion = TileChangesGetVersion();
+}
+
 TileElement* ride_get_station_start_track_element(Ride* ride, StationIndex stationIndex)
 {
-    auto stationStart = ride->stations[stationIndex].GetStart();
+    auto& station = ride->stations[stationIndex];
+    auto stationStart = station.GetStart();
+
+    // Elements can still be changed in place, so check the cached one is what the search below would find
+    TileElement* tileElement = ride_station_get_cached_element(station.CachedStart, stationStart);
+    if (tileElement != nullptr && tileElement->GetType() == TILE_ELEMENT_TYPE_TRACK
+        && stationStart.z == tileElement->GetBaseZ())
+    {
+        return tileElement;
+    }
 
     // Find the station track element
-    TileElement* tileElement = map_get_first_element_at(stationStart);
+    tileElement = map_get_first_element_at(stationStart);
     if (tileElement == nullptr)
         return nullptr;
     do
     {
         if (tileElement->GetType() == TILE_ELEMENT_TYPE_TRACK && stationStart.z == tileElement->GetBaseZ())
+        {
+            ride_station_set_cached_element(station.CachedStart, stationStart, tileElement);
             return tileElement;
+        }
 
     } while (!(tileElement++)->IsLastForTile());
 
     return nullptr;
 }
 
+static EntranceElement* ride_get_entrance_or_exit_element(
+    RideStationCachedElement& cached, const TileCoordsXYZD& location, uint8_t entranceType)
+{
+    if (location.isNull())
+        return nullptr;
+
+    auto coords = location.ToCoordsXYZ();
+    TileElement* tileElement = ride_station_get_cached_element(cached, coords);
+    if (tileElement != nullptr && tileElement->GetType() == TILE_ELEMENT_TYPE_ENTRANCE
+        && tileElement->AsEntrance()->GetEntranceType() == entranceType && tileElement->GetBaseZ() == coords.z
+        && !tileElement->IsGhost())
+    {
+        return tileElement->AsEntrance();
+    }
+
+    auto entranceElement = entranceType == ENTRANCE_TYPE_RIDE_ENTRANCE ? map_get_ride_entrance_element_at(coords, false)
+                                                                       : map_get_ride_exit_element_at(coords, false);
+    if (entranceElement != nullptr)
+    {
+        ride_station_set_cached_element(cached, coords, reinterpret_cast<TileElement*>(entranceElement));
+    }
+    return entranceElement;
+}
+
+EntranceElement* ride_get_entrance_element(Ride* ride, const StationIndex stationIndex)
+{
+    auto& station = ride->stations[stationIndex];
+    return ride_get_entrance_or_exit_element(station.CachedEntrance, station.Entrance, ENTRANCE_TYPE_RIDE_ENTRANCE);
+}
+
+EntranceElement* ride_get_exit_element(Ride* ride, const StationIndex stationIndex)
+{
+    auto& station = ride->stations[stationIndex];
+    return ride_get_entrance_or_exit_element(station.CachedExit, station.Exit, ENTRANCE_TYPE_RIDE_EXIT);
+}
+
 TileElement* ride_get_station_exit_element(const CoordsXYZ& elementPos)
 {
     // Find the station track element
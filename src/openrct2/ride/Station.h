@@ -11,6 +11,7 @@
 
 #include "../common.h"
 
+struct EntranceElement;
 struct Ride;
 struct TileCoordsXYZD;
 
@@ -23,6 +24,9 @@ StationIndex ride_get_first_valid_station_exit(Ride* ride);
 StationIndex ride_get_first_valid_station_start(const Ride* ride);
 StationIndex ride_get_first_empty_station_start(const Ride* ride);
 
+EntranceElement* ride_get_entrance_element(Ride* ride, const StationIndex stationIndex);
+EntranceElement* ride_get_exit_element(Ride* ride, const StationIndex stationIndex);
+
 TileCoordsXYZD ride_get_entrance_location(const Ride* ride, const StationIndex stationIndex);
 TileCoordsXYZD ride_get_exit_location(const Ride* ride, const StationIndex stationIndex);
 
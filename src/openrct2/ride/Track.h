@@ -542,6 +542,11 @@ enum
     GC_SET_MAZE_TRACK_FILL = 2,
 };
 
+/**
+ * Walks a ride's track circuit piece by piece. Circuits are only walked when a ride is edited, tested or opened, so the
+ * pieces are looked up in the tile element lists on every step rather than kept in a per-ride cache: inserting any tile
+ * element moves the elements after it, which would leave cached element pointers dangling.
+ */
 struct track_circuit_iterator
 {
     CoordsXYE last;
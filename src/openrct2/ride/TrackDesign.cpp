@@ -51,6 +51,7 @@
 #include "../world/Scenery.h"
 #include "../world/SmallScenery.h"
 #include "../world/Surface.h"
+#include "../world/TileChanges.h"
 #include "../world/Wall.h"
 #include "Ride.h"
 #include "RideData.h"
@@ -62,6 +63,7 @@
 #include <algorithm>
 #include <iterator>
 #include <memory>
+#include <unordered_set>
 
 using namespace OpenRCT2;
 using namespace OpenRCT2::Drawing;
@@ -83,6 +85,9 @@ static CoordsXYZ _trackPreviewMin;
 static CoordsXYZ _trackPreviewMax;
 static CoordsXYZ _trackPreviewOrigin;
 
+// Tiles already in gMapSelectionTiles while drawing outlines, large designs cover the same tiles many times.
+static std::unordered_set<uint64_t> _trackDesignSelectionTiles;
+
 bool byte_9D8150;
 static uint8_t _trackDesignPlaceOperation;
 static money32 _trackDesignPlaceCost;
@@ -849,10 +854,16 @@ void track_design_mirror(TrackDesign* td6)
     track_design_mirror_scenery(td6);
 }
 
+static void track_design_clear_selection_tiles()
+{
+    gMapSelectionTiles.clear();
+    _trackDesignSelectionTiles.clear();
+}
+
 static void track_design_add_selection_tile(const CoordsXY& coords)
 {
-    auto tileIterator = std::find(gMapSelectionTiles.begin(), gMapSelectionTiles.end(), coords);
-    if (tileIterator == gMapSelectionTiles.end())
+    auto key = (static_cast<uint64_t>(static_cast<uint32_t>(coords.x)) << 32) | static_cast<uint32_t>(coords.y);
+    if (_trackDesignSelectionTiles.insert(key).second)
     {
         gMapSelectionTiles.push_back(coords);
     }
@@ -1307,7 +1318,7 @@ static int32_t track_design_place_maze(TrackDesign* td6, const CoordsXYZ& coords
 {
     if (_trackDesignPlaceOperation == PTD_OPERATION_DRAW_OUTLINES)
     {
-        gMapSelectionTiles.clear();
+        track_design_clear_selection_tiles();
         gMapSelectArrowPosition = CoordsXYZ{ coords, tile_element_height(coords) };
         gMapSelectArrowDirection = _currentTrackPieceDirection;
     }
@@ -1510,7 +1521,7 @@ static bool track_design_place_ride(TrackDesign* td6, const CoordsXYZ& origin, R
     _trackPreviewOrigin = origin;
     if (_trackDesignPlaceOperation == PTD_OPERATION_DRAW_OUTLINES)
     {
-        gMapSelectionTiles.clear();
+        track_design_clear_selection_tiles();
         gMapSelectArrowPosition = CoordsXYZ{ origin, tile_element_height(origin) };
         gMapSelectArrowDirection = _currentTrackPieceDirection;
     }
@@ -2118,6 +2129,7 @@ static void track_design_preview_restore_map(map_backup* backup)
 {
     std::memcpy(gTileElements, backup->tile_elements, sizeof(backup->tile_elements));
     std::memcpy(gTileElementTilePointers, backup->tile_pointers, sizeof(backup->tile_pointers));
+    TileChangesInvalidateIndex();
     gNextFreeTileElement = backup->next_free_tile_element;
     gMapSizeUnits = backup->map_size_units;
     gMapSizeMinus2 = backup->map_size_units_minus_2;
@@ -140,31 +140,8 @@ public:
      */
     size_t GetCountForObjectEntry(uint8_t rideType, const std::string& entry) const override
     {
-        size_t count = 0;
-        const auto& repo = GetContext()->GetObjectRepository();
-
-        for (const auto& item : _items)
-        {
-            if (item.RideType != rideType)
-            {
-                continue;
-            }
-
-            bool entryIsNotSeparate = false;
-            if (entry.empty())
-            {
-                const ObjectRepositoryItem* ori = repo.FindObjectLegacy(item.ObjectEntry.c_str());
-
-                if (ori == nullptr || !GetRideTypeDescriptor(rideType).HasFlag(RIDE_TYPE_FLAG_LIST_VEHICLES_SEPARATELY))
-                    entryIsNotSeparate = true;
-            }
-
-            if (entryIsNotSeparate || String::Equals(item.ObjectEntry, entry, true))
-            {
-                count++;
-            }
-        }
-        return count;
+        auto [begin, end] = GetItemsForRideType(rideType);
+        return std::count_if(begin, end, [&](const TrackRepositoryItem& item) { return IsItemForObjectEntry(item, entry); });
     }
 
     /**
@@ -175,25 +152,11 @@ public:
     std::vector<track_design_file_ref> GetItemsForObjectEntry(uint8_t rideType, const std::string& entry) const override
     {
         std::vector<track_design_file_ref> refs;
-        const auto& repo = GetContext()->GetObjectRepository();
-
-        for (const auto& item : _items)
+        auto [begin, end] = GetItemsForRideType(rideType);
+        for (auto it = begin; it != end; it++)
         {
-            if (item.RideType != rideType)
-            {
-                continue;
-            }
-
-            bool entryIsNotSeparate = false;
-            if (entry.empty())
-            {
-                const ObjectRepositoryItem* ori = repo.FindObjectLegacy(item.ObjectEntry.c_str());
-
-                if (ori == nullptr || !GetRideTypeDescriptor(rideType).HasFlag(RIDE_TYPE_FLAG_LIST_VEHICLES_SEPARATELY))
-                    entryIsNotSeparate = true;
-            }
-
-            if (entryIsNotSeparate || String::Equals(item.ObjectEntry, entry, true))
+            const auto& item = *it;
+            if (IsItemForObjectEntry(item, entry))
             {
                 track_design_file_ref ref;
                 ref.name = String::Duplicate(GetNameFromTrackPath(item.Path));
@@ -280,6 +243,35 @@ public:
     }
 
 private:
+    /**
+     * Items are kept sorted by ride type, so the items of one ride type are a contiguous range.
+     */
+    std::pair<std::vector<TrackRepositoryItem>::const_iterator, std::vector<TrackRepositoryItem>::const_iterator>
+        GetItemsForRideType(uint8_t rideType) const
+    {
+        auto begin = std::lower_bound(
+            _items.begin(), _items.end(), rideType,
+            [](const TrackRepositoryItem& item, uint8_t type) { return item.RideType < type; });
+        auto end = std::upper_bound(
+            begin, _items.end(), rideType, [](uint8_t type, const TrackRepositoryItem& item) { return type < item.RideType; });
+        return { begin, end };
+    }
+
+    bool IsItemForObjectEntry(const TrackRepositoryItem& item, const std::string& entry) const
+    {
+        if (entry.empty())
+        {
+            // Only look the vehicle up if the ride type lists its vehicles separately.
+            if (!GetRideTypeDescriptor(item.RideType).HasFlag(RIDE_TYPE_FLAG_LIST_VEHICLES_SEPARATELY))
+                return true;
+
+            const auto& repo = GetContext()->GetObjectRepository();
+            if (repo.FindObjectLegacy(item.ObjectEntry.c_str()) == nullptr)
+                return true;
+        }
+        return String::Equals(item.ObjectEntry, entry, true);
+    }
+
     void SortItems()
     {
         std::sort(_items.begin(), _items.end(), [](const TrackRepositoryItem& a, const TrackRepositoryItem& b) -> bool {
@@ -27,6 +27,9 @@
 #include "TrackData.h"
 #include "TrackDesign.h"
 
+#include <array>
+#include <mutex>
+
 // clang-format off
 /* rct2: 0x007667AC */
 static constexpr TileCoordsXY EntranceOffsetEdgeNE[] = {
@@ -2131,6 +2134,29 @@ void track_paint_util_left_corkscrew_up_supports(paint_session* session, Directi
     }
 }
 
+// The paint function getters are big switches over the track types, their results are looked up once per ride type
+// instead of for every track element that is painted. Viewport columns are painted in parallel.
+static std::array<TRACK_PAINT_FUNCTION, TrackElemType::Count> _trackPaintFunctions[RIDE_TYPE_COUNT];
+static std::once_flag _trackPaintFunctionsFilled[RIDE_TYPE_COUNT];
+
+static TRACK_PAINT_FUNCTION track_paint_get_function(uint8_t rideType, track_type_t trackType)
+{
+    if (rideType >= RIDE_TYPE_COUNT || trackType >= TrackElemType::Count)
+    {
+        return nullptr;
+    }
+
+    std::call_once(_trackPaintFunctionsFilled[rideType], [rideType]() {
+        TRACK_PAINT_FUNCTION_GETTER paintFunctionGetter = GetRideTypeDescriptor(rideType).TrackPaintFunction;
+        auto& paintFunctions = _trackPaintFunctions[rideType];
+        for (track_type_t i = 0; i < TrackElemType::Count; i++)
+        {
+            paintFunctions[i] = paintFunctionGetter != nullptr ? paintFunctionGetter(i) : nullptr;
+        }
+    });
+    return _trackPaintFunctions[rideType][trackType];
+}
+
 /**
  *
  *  rct2: 0x006C4794
@@ -2190,18 +2216,10 @@ void track_paint(paint_session* session, Direction direction, int32_t height, co
             session->TrackColours[SCHEME_3] = ghost_id;
         }
 
-        if (ride->type >= RIDE_TYPE_COUNT)
+        TRACK_PAINT_FUNCTION paintFunction = track_paint_get_function(ride->type, trackType);
+        if (paintFunction != nullptr)
         {
-            return;
-        }
-        TRACK_PAINT_FUNCTION_GETTER paintFunctionGetter = ride->GetRideTypeDescriptor().TrackPaintFunction;
-        if (paintFunctionGetter != nullptr)
-        {
-            TRACK_PAINT_FUNCTION paintFunction = paintFunctionGetter(trackType);
-            if (paintFunction != nullptr)
-            {
-                paintFunction(session, rideIndex, trackSequence, direction, height, tileElement);
-            }
+            paintFunction(session, rideIndex, trackSequence, direction, height, tileElement);
         }
     }
 }
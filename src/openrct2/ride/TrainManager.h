@@ -7,8 +7,9 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 #pragma once
+#include "../world/EntityIdSet.h"
+
 #include <cstdint>
-#include <list>
 
 struct Vehicle;
 
@@ -18,17 +19,17 @@ namespace TrainManager
     class View
     {
     private:
-        const std::list<uint16_t>* vec;
+        const EntityIdSet* vec;
 
         class Iterator
         {
         private:
-            std::list<uint16_t>::const_iterator iter;
-            std::list<uint16_t>::const_iterator end;
+            EntityIdSet::const_iterator iter;
+            EntityIdSet::const_iterator end;
             Vehicle* Entity = nullptr;
 
         public:
-            Iterator(std::list<uint16_t>::const_iterator _iter, std::list<uint16_t>::const_iterator _end)
+            Iterator(EntityIdSet::const_iterator _iter, EntityIdSet::const_iterator _end)
                 : iter(_iter)
                 , end(_end)
             {
@@ -737,72 +737,59 @@ template<> bool SpriteBase::Is<Vehicle>() const
     return Type == EntityType::Vehicle;
 }
 
-static bool vehicle_move_info_valid(
-    VehicleTrackSubposition trackSubposition, track_type_t type, uint8_t direction, int32_t offset)
-{
-    uint16_t typeAndDirection = (type << 2) | (direction & 3);
+// Number of track type and direction combinations each subposition has move info for.
+static constexpr const int32_t TrackVehicleInfoListCounts[] = {
+    VehicleTrackSubpositionSizeDefault, // Default
+    692,                                // ChairliftGoingOut
+    404,                                // ChairliftGoingBack
+    404,                                // ChairliftEndBullwheel
+    404,                                // ChairliftStartBullwheel
+    208,                                // GoKartsLeftLane
+    208,                                // GoKartsRightLane
+    208,                                // GoKartsMovingToRightLane
+    208,                                // GoKartsMovingToLeftLane
+    824,                                // MiniGolfPathA9
+    824,                                // MiniGolfBallPathA10
+    824,                                // MiniGolfPathB11
+    824,                                // MiniGolfBallPathB12
+    824,                                // MiniGolfPathC13
+    824,                                // MiniGolfBallPathC14
+    868,                                // ReverserRCFrontBogie
+    868,                                // ReverserRCRearBogie
+};
+static_assert(std::size(TrackVehicleInfoListCounts) == EnumValue(VehicleTrackSubposition::Count));
 
-    if (trackSubposition >= VehicleTrackSubposition{ std::size(gTrackVehicleInfo) })
-    {
-        return false;
-    }
-    int32_t size = 0;
-    switch (trackSubposition)
-    {
-        case VehicleTrackSubposition::Default:
-            size = VehicleTrackSubpositionSizeDefault;
-            break;
-        case VehicleTrackSubposition::ChairliftGoingOut:
-            size = 692;
-            break;
-        case VehicleTrackSubposition::ChairliftGoingBack:
-        case VehicleTrackSubposition::ChairliftEndBullwheel:
-        case VehicleTrackSubposition::ChairliftStartBullwheel:
-            size = 404;
-            break;
-        case VehicleTrackSubposition::GoKartsLeftLane:
-        case VehicleTrackSubposition::GoKartsRightLane:
-        case VehicleTrackSubposition::GoKartsMovingToRightLane:
-        case VehicleTrackSubposition::GoKartsMovingToLeftLane:
-            size = 208;
-            break;
-        case VehicleTrackSubposition::MiniGolfPathA9: // VehicleTrackSubposition::MiniGolfStart9
-        case VehicleTrackSubposition::MiniGolfBallPathA10:
-        case VehicleTrackSubposition::MiniGolfPathB11:
-        case VehicleTrackSubposition::MiniGolfBallPathB12:
-        case VehicleTrackSubposition::MiniGolfPathC13:
-        case VehicleTrackSubposition::MiniGolfBallPathC14:
-            size = 824;
-            break;
-        case VehicleTrackSubposition::ReverserRCFrontBogie:
-        case VehicleTrackSubposition::ReverserRCRearBogie:
-            size = 868;
-            break;
-        default:
-            break;
-    }
-    if (typeAndDirection >= size)
+/**
+ * Returns the move info of a track piece for the given subposition, or nullptr if there is none.
+ * Called for every car on every step it moves, so the checks are done with a single table lookup.
+ */
+static const rct_vehicle_info_list* vehicle_get_move_info_list(
+    VehicleTrackSubposition trackSubposition, track_type_t type, uint8_t direction)
+{
+    const auto subposition = static_cast<uint8_t>(trackSubposition);
+    if (subposition >= std::size(TrackVehicleInfoListCounts))
     {
-        return false;
+        return nullptr;
     }
-    if (offset >= gTrackVehicleInfo[static_cast<uint8_t>(trackSubposition)][typeAndDirection]->size)
+
+    const int32_t typeAndDirection = (type << 2) | (direction & 3);
+    if (typeAndDirection >= TrackVehicleInfoListCounts[subposition])
     {
-        return false;
+        return nullptr;
     }
-    return true;
+    return gTrackVehicleInfo[subposition][typeAndDirection];
 }
 
 static const rct_vehicle_info* vehicle_get_move_info(
     VehicleTrackSubposition trackSubposition, track_type_t type, uint8_t direction, int32_t offset)
 {
-    uint16_t typeAndDirection = (type << 2) | (direction & 3);
-
-    if (!vehicle_move_info_valid(trackSubposition, type, direction, offset))
+    const auto* moveInfoList = vehicle_get_move_info_list(trackSubposition, type, direction);
+    if (moveInfoList == nullptr || offset >= moveInfoList->size)
     {
         static constexpr const rct_vehicle_info zero = {};
         return &zero;
     }
-    return &gTrackVehicleInfo[static_cast<uint8_t>(trackSubposition)][typeAndDirection]->info[offset];
+    return &moveInfoList->info[offset];
 }
 
 const rct_vehicle_info* Vehicle::GetMoveInfo() const
@@ -812,13 +799,8 @@ const rct_vehicle_info* Vehicle::GetMoveInfo() const
 
 static uint16_t vehicle_get_move_info_size(VehicleTrackSubposition trackSubposition, track_type_t type, uint8_t direction)
 {
-    uint16_t typeAndDirection = (type << 2) | (direction & 3);
-
-    if (!vehicle_move_info_valid(trackSubposition, type, direction, 0))
-    {
-        return 0;
-    }
-    return gTrackVehicleInfo[static_cast<uint8_t>(trackSubposition)][typeAndDirection]->size;
+    const auto* moveInfoList = vehicle_get_move_info_list(trackSubposition, type, direction);
+    return moveInfoList != nullptr ? moveInfoList->size : 0;
 }
 
 uint16_t Vehicle::GetTrackProgress() const
@@ -973,30 +955,87 @@ bool Vehicle::SoundCanPlay() const
     return true;
 }
 
+static uint8_t vehicle_sounds_update_get_pan_volume(const OpenRCT2::Audio::VehicleSoundParams* sound_params)
+{
+    uint8_t vol1 = 0xFF;
+    uint8_t vol2 = 0xFF;
+
+    int16_t pan_y = std::abs(sound_params->pan_y);
+    pan_y = std::min(static_cast<int16_t>(0xFFF), pan_y);
+    pan_y -= 0x800;
+    if (pan_y > 0)
+    {
+        pan_y = (0x400 - pan_y) / 4;
+        vol1 = LOBYTE(pan_y);
+        if (static_cast<int8_t>(HIBYTE(pan_y)) != 0)
+        {
+            vol1 = 0xFF;
+            if (static_cast<int8_t>(HIBYTE(pan_y)) < 0)
+            {
+                vol1 = 0;
+            }
+        }
+    }
+
+    int16_t pan_x = std::abs(sound_params->pan_x);
+    pan_x = std::min(static_cast<int16_t>(0xFFF), pan_x);
+    pan_x -= 0x800;
+
+    if (pan_x > 0)
+    {
+        pan_x = (0x400 - pan_x) / 4;
+        vol2 = LOBYTE(pan_x);
+        if (static_cast<int8_t>(HIBYTE(pan_x)) != 0)
+        {
+            vol2 = 0xFF;
+            if (static_cast<int8_t>(HIBYTE(pan_x)) < 0)
+            {
+                vol2 = 0;
+            }
+        }
+    }
+
+    vol1 = std::min(vol1, vol2);
+    return std::max(0, vol1 - OpenRCT2::Audio::gVolumeAdjustZoom);
+}
+
 /**
+ * How loud the vehicle is heard in the viewport, from its distance to the centre of the viewport and
+ * the volume of its sounds, 0 when it can not be heard at all.
  *
  *  rct2: 0x006BC2F3
  */
-uint16_t Vehicle::GetSoundPriority() const
+uint16_t Vehicle::GetSoundPriority(const OpenRCT2::Audio::VehicleSoundParams& param) const
 {
-    int32_t result = Train(this).Mass() + (std::abs(velocity) >> 13);
+    int32_t loudness = 0;
+    if (sound1_id != OpenRCT2::Audio::SoundId::Null)
+        loudness = sound1_volume;
+    if (sound2_id != OpenRCT2::Audio::SoundId::Null)
+        loudness = std::max<int32_t>(loudness, sound2_volume);
+
+    int32_t distanceVolume = std::max(0, vehicle_sounds_update_get_pan_volume(&param) - param.volume);
+    int32_t audible = distanceVolume * loudness / 255;
+    if (audible == 0)
+        return 0;
 
+    int32_t result = audible * 16;
     for (const auto& vehicleSound : OpenRCT2::Audio::gVehicleSoundList)
     {
         if (vehicleSound.id == sprite_index)
         {
-            // Vehicle sounds will get higher priority if they are already playing
-            return result + 300;
+            // Vehicle sounds will get higher priority if they are already playing, so two vehicles of about the same
+            // loudness do not keep taking the voice from each other
+            return result + 512;
         }
     }
 
     return result;
 }
 
-OpenRCT2::Audio::VehicleSoundParams Vehicle::CreateSoundParam(uint16_t priority) const
+OpenRCT2::Audio::VehicleSoundParams Vehicle::CreateSoundParam() const
 {
     OpenRCT2::Audio::VehicleSoundParams param;
-    param.priority = priority;
+    param.priority = 0;
     int32_t panX = (sprite_left / 2) + (sprite_right / 2) - g_music_tracking_viewport->viewPos.x;
     panX = panX / g_music_tracking_viewport->zoom;
     panX += g_music_tracking_viewport->pos.x;
@@ -1063,7 +1102,12 @@ void Vehicle::UpdateSoundParams(std::vector<OpenRCT2::Audio::VehicleSoundParams>
     if (!SoundCanPlay())
         return;
 
-    uint16_t soundPriority = GetSoundPriority();
+    auto soundParam = CreateSoundParam();
+    uint16_t soundPriority = GetSoundPriority(soundParam);
+    if (soundPriority == 0)
+        return;
+    soundParam.priority = soundPriority;
+
     // Find a sound param of lower priority to use
     auto soundParamIter = std::find_if(
         vehicleSoundParamsList.begin(), vehicleSoundParamsList.end(),
@@ -1073,7 +1117,7 @@ void Vehicle::UpdateSoundParams(std::vector<OpenRCT2::Audio::VehicleSoundParams>
     {
         if (vehicleSoundParamsList.size() < OpenRCT2::Audio::MaxVehicleSounds)
         {
-            vehicleSoundParamsList.push_back(CreateSoundParam(soundPriority));
+            vehicleSoundParamsList.push_back(soundParam);
         }
     }
     else
@@ -1081,11 +1125,14 @@ void Vehicle::UpdateSoundParams(std::vector<OpenRCT2::Audio::VehicleSoundParams>
         if (vehicleSoundParamsList.size() < OpenRCT2::Audio::MaxVehicleSounds)
         {
             // Shift all sound params down one if using a free space
-            vehicleSoundParamsList.insert(soundParamIter, CreateSoundParam(soundPriority));
+            vehicleSoundParamsList.insert(soundParamIter, soundParam);
         }
         else
         {
-            *soundParamIter = CreateSoundParam(soundPriority);
+            // Keep the list sorted, the quietest param drops off the end
+            auto index = std::distance(vehicleSoundParamsList.begin(), soundParamIter);
+            vehicleSoundParamsList.pop_back();
+            vehicleSoundParamsList.insert(vehicleSoundParamsList.begin() + index, soundParam);
         }
     }
 }
@@ -1116,48 +1163,44 @@ static void vehicle_sounds_update_window_setup()
         OpenRCT2::Audio::gVolumeAdjustZoom = 70;
 }
 
-static uint8_t vehicle_sounds_update_get_pan_volume(OpenRCT2::Audio::VehicleSoundParams* sound_params)
-{
-    uint8_t vol1 = 0xFF;
-    uint8_t vol2 = 0xFF;
+static constexpr int16_t VehicleSoundFadeStep = 1000;
+static constexpr int16_t VehicleSoundMinVolume = -10000;
 
-    int16_t pan_y = std::abs(sound_params->pan_y);
-    pan_y = std::min(static_cast<int16_t>(0xFFF), pan_y);
-    pan_y -= 0x800;
-    if (pan_y > 0)
+static void StopSound(OpenRCT2::Audio::Sound& sound)
+{
+    if (sound.Id != OpenRCT2::Audio::SoundId::Null)
     {
-        pan_y = (0x400 - pan_y) / 4;
-        vol1 = LOBYTE(pan_y);
-        if (static_cast<int8_t>(HIBYTE(pan_y)) != 0)
-        {
-            vol1 = 0xFF;
-            if (static_cast<int8_t>(HIBYTE(pan_y)) < 0)
-            {
-                vol1 = 0;
-            }
-        }
+        sound.Id = OpenRCT2::Audio::SoundId::Null;
+        Mixer_Stop_Channel(sound.Channel);
     }
+}
 
-    int16_t pan_x = std::abs(sound_params->pan_x);
-    pan_x = std::min(static_cast<int16_t>(0xFFF), pan_x);
-    pan_x -= 0x800;
+static int16_t GetLoudestVolume(const OpenRCT2::Audio::VehicleSound& vehicleSound)
+{
+    int16_t volume = VehicleSoundMinVolume;
+    if (vehicleSound.TrackSound.Id != OpenRCT2::Audio::SoundId::Null)
+        volume = std::max(volume, vehicleSound.TrackSound.Volume);
+    if (vehicleSound.OtherSound.Id != OpenRCT2::Audio::SoundId::Null)
+        volume = std::max(volume, vehicleSound.OtherSound.Volume);
+    return volume;
+}
 
-    if (pan_x > 0)
+/**
+ * Lowers the volume of the sound by one step, returns true once it has stopped.
+ */
+static bool FadeOutSound(OpenRCT2::Audio::Sound& sound)
+{
+    if (sound.Id == OpenRCT2::Audio::SoundId::Null)
+        return true;
+
+    sound.Volume = std::max<int16_t>(sound.Volume - VehicleSoundFadeStep, VehicleSoundMinVolume);
+    if (sound.Volume <= VehicleSoundMinVolume)
     {
-        pan_x = (0x400 - pan_x) / 4;
-        vol2 = LOBYTE(pan_x);
-        if (static_cast<int8_t>(HIBYTE(pan_x)) != 0)
-        {
-            vol2 = 0xFF;
-            if (static_cast<int8_t>(HIBYTE(pan_x)) < 0)
-            {
-                vol2 = 0;
-            }
-        }
+        StopSound(sound);
+        return true;
     }
-
-    vol1 = std::min(vol1, vol2);
-    return std::max(0, vol1 - OpenRCT2::Audio::gVolumeAdjustZoom);
+    Mixer_Channel_Volume(sound.Channel, DStoMixerVolume(sound.Volume));
+    return false;
 }
 
 /*  Returns the vehicle sound for a sound_param.
@@ -1168,28 +1211,44 @@ static uint8_t vehicle_sounds_update_get_pan_volume(OpenRCT2::Audio::VehicleSoun
  */
 static OpenRCT2::Audio::VehicleSound* vehicle_sounds_update_get_vehicle_sound(OpenRCT2::Audio::VehicleSoundParams* sound_params)
 {
-    // Search for already playing vehicle sound
+    // Search for already playing vehicle sound, a fading sound just continues where it is
     for (auto& vehicleSound : OpenRCT2::Audio::gVehicleSoundList)
     {
         if (vehicleSound.id == sound_params->id)
+        {
+            vehicleSound.Fading = false;
             return &vehicleSound;
+        }
     }
 
-    // No sound already playing
+    // No sound already playing, use a free slot or else take the one of the quietest fading sound
+    OpenRCT2::Audio::VehicleSound* slot = nullptr;
     for (auto& vehicleSound : OpenRCT2::Audio::gVehicleSoundList)
     {
-        // Use free slot
         if (vehicleSound.id == OpenRCT2::Audio::SoundIdNull)
         {
-            vehicleSound.id = sound_params->id;
-            vehicleSound.TrackSound.Id = OpenRCT2::Audio::SoundId::Null;
-            vehicleSound.OtherSound.Id = OpenRCT2::Audio::SoundId::Null;
-            vehicleSound.volume = 0x30;
-            return &vehicleSound;
+            slot = &vehicleSound;
+            break;
+        }
+        if (vehicleSound.Fading && (slot == nullptr || GetLoudestVolume(vehicleSound) < GetLoudestVolume(*slot)))
+        {
+            slot = &vehicleSound;
         }
     }
+    if (slot == nullptr)
+        return nullptr;
 
-    return nullptr;
+    if (slot->id != OpenRCT2::Audio::SoundIdNull)
+    {
+        StopSound(slot->TrackSound);
+        StopSound(slot->OtherSound);
+    }
+    slot->id = sound_params->id;
+    slot->Fading = false;
+    slot->TrackSound.Id = OpenRCT2::Audio::SoundId::Null;
+    slot->OtherSound.Id = OpenRCT2::Audio::SoundId::Null;
+    slot->volume = 0x30;
+    return slot;
 }
 
 enum class SoundType
@@ -1319,15 +1378,16 @@ void vehicle_sounds_update()
             if (keepPlaying)
                 continue;
 
-            if (vehicle_sound.TrackSound.Id != OpenRCT2::Audio::SoundId::Null)
-            {
-                Mixer_Stop_Channel(vehicle_sound.TrackSound.Channel);
-            }
-            if (vehicle_sound.OtherSound.Id != OpenRCT2::Audio::SoundId::Null)
+            // Fade out over a few ticks instead of cutting the sound off, so a vehicle that is heard again shortly after
+            // continues without restarting its sounds
+            vehicle_sound.Fading = true;
+            bool trackStopped = FadeOutSound(vehicle_sound.TrackSound);
+            bool otherStopped = FadeOutSound(vehicle_sound.OtherSound);
+            if (trackStopped && otherStopped)
             {
-                Mixer_Stop_Channel(vehicle_sound.OtherSound.Channel);
+                vehicle_sound.id = OpenRCT2::Audio::SoundIdNull;
+                vehicle_sound.Fading = false;
             }
-            vehicle_sound.id = OpenRCT2::Audio::SoundIdNull;
         }
     }
 
@@ -1370,6 +1430,10 @@ void vehicle_sounds_update()
 /**
  *
  *  rct2: 0x006D4204
+ *
+ * Trains have to be updated serially in sprite_index order. Trains on different rides still share the
+ * scenario_rand state, the entity spatial index and the ride, guest and news state they change, so any
+ * other order changes the game state and desyncs network games and replays.
  */
 void vehicle_update_all()
 {
@@ -268,10 +268,10 @@ struct Vehicle : SpriteBase
 
 private:
     bool SoundCanPlay() const;
-    uint16_t GetSoundPriority() const;
+    uint16_t GetSoundPriority(const OpenRCT2::Audio::VehicleSoundParams& param) const;
     const rct_vehicle_info* GetMoveInfo() const;
     uint16_t GetTrackProgress() const;
-    OpenRCT2::Audio::VehicleSoundParams CreateSoundParam(uint16_t priority) const;
+    OpenRCT2::Audio::VehicleSoundParams CreateSoundParam() const;
     void CableLiftUpdate();
     bool CableLiftUpdateTrackMotionForwards();
     bool CableLiftUpdateTrackMotionBackwards();
@@ -2889,6 +2889,8 @@ static void vehicle_sprite_59(
 }
 
 // 0x009A3B14:
+// Indexed by pitch, each function switches on the bank rotation. The final image also depends on the vehicle's restraint
+// position, the sprite groups the vehicle entry has and the fallbacks for the ones it lacks, so it is resolved per car.
 using vehicle_sprite_func = void (*)(
     paint_session* session, const Vehicle* vehicle, int32_t imageDirection, int32_t z,
     const rct_ride_entry_vehicle* vehicleEntry);
@@ -11,6 +11,9 @@
 
 #include "Vehicle.h"
 
+// The tables are kept as plain constexpr data so they live in read-only memory and a lookup is a single indexed load.
+// They can not be derived from the direction 0 tables by rotation: many pieces are offset by one unit or have a
+// different number of subpositions in the other directions, and those differences are part of vehicle behaviour.
 #define CREATE_VEHICLE_INFO(VAR, ...)                                                                                          \
     static constexpr const rct_vehicle_info VAR##_data[] = __VA_ARGS__;                                                        \
     static constexpr const rct_vehicle_info_list VAR = { static_cast<uint16_t>(std::size(VAR##_data)), VAR##_data };
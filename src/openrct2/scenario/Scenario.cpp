@@ -42,9 +42,11 @@
 #include "../windows/Intent.h"
 #include "../world/Climate.h"
 #include "../world/Map.h"
+#include "../world/MapScan.h"
 #include "../world/Park.h"
 #include "../world/Scenery.h"
 #include "../world/Sprite.h"
+#include "../world/TileElementsView.h"
 #include "../world/Water.h"
 #include "ScenarioRepository.h"
 #include "ScenarioSources.h"
@@ -70,6 +72,7 @@ uint32_t gLastAutoSaveUpdate = 0;
 
 uint32_t gScenarioTicks;
 random_engine_t gScenarioRand;
+static random_engine_t::state_type _scenarioRandTickState;
 
 Objective gScenarioObjective;
 
@@ -506,6 +509,30 @@ random_engine_t::result_type scenario_rand()
     return gScenarioRand();
 }
 
+void scenario_rand_begin_tick()
+{
+    _scenarioRandTickState = gScenarioRand.state();
+}
+
+// The finaliser of MurmurHash3, so that neighbouring indices give unrelated seeds
+static uint32_t scenario_rand_mix(uint32_t h)
+{
+    h ^= h >> 16;
+    h *= 0x85EBCA6B;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35;
+    h ^= h >> 16;
+    return h;
+}
+
+random_engine_t scenario_rand_stream(ScenarioRandStream stream, uint32_t index)
+{
+    auto key = scenario_rand_mix((static_cast<uint32_t>(stream) << 24) ^ scenario_rand_mix(index));
+    Random::Rct2::Seed s{ scenario_rand_mix(_scenarioRandTickState.s0 ^ key),
+                          scenario_rand_mix(_scenarioRandTickState.s1 + key + 0x9E3779B9) };
+    return random_engine_t(s);
+}
+
 uint32_t scenario_rand_max(uint32_t max)
 {
     if (max < 2)
@@ -553,18 +580,14 @@ static bool scenario_prepare_rides_for_save()
         return false;
     }
 
-    bool markTrackAsIndestructible;
-    tile_element_iterator it;
-    tile_element_iterator_begin(&it);
-    do
-    {
-        if (it.element->GetType() == TILE_ELEMENT_TYPE_TRACK)
+    ForEachTileElementParallel([isFiveCoasterObjective](TileElement& element, const TileCoordsXY&) {
+        if (element.GetType() == TILE_ELEMENT_TYPE_TRACK)
         {
-            markTrackAsIndestructible = false;
+            bool markTrackAsIndestructible = false;
 
             if (isFiveCoasterObjective)
             {
-                auto ride = get_ride(it.element->AsTrack()->GetRideIndex());
+                auto ride = get_ride(element.AsTrack()->GetRideIndex());
 
                 // In the previous step, this flag was set on the first five roller coasters.
                 if (ride != nullptr && ride->lifecycle_flags & RIDE_LIFECYCLE_INDESTRUCTIBLE_TRACK)
@@ -573,9 +596,9 @@ static bool scenario_prepare_rides_for_save()
                 }
             }
 
-            it.element->AsTrack()->SetIsIndestructible(markTrackAsIndestructible);
+            element.AsTrack()->SetIsIndestructible(markTrackAsIndestructible);
         }
-    } while (tile_element_iterator_next(&it));
+    });
 
     return true;
 }
@@ -674,25 +697,28 @@ void scenario_fix_ghosts(rct_s6_data* s6)
     }
 }
 
-static void ride_all_has_any_track_elements(std::array<bool, RCT12_MAX_RIDES_IN_PARK>& rideIndexArray)
+static std::bitset<RCT12_MAX_RIDES_IN_PARK> ride_all_has_any_track_elements()
 {
-    tile_element_iterator it;
-    tile_element_iterator_begin(&it);
-    while (tile_element_iterator_next(&it))
-    {
-        if (it.element->GetType() != TILE_ELEMENT_TYPE_TRACK)
-            continue;
-        if (it.element->IsGhost())
-            continue;
+    return ReduceTilesParallel(
+        std::bitset<RCT12_MAX_RIDES_IN_PARK>(),
+        [](std::bitset<RCT12_MAX_RIDES_IN_PARK>& value, const TileCoordsXY& coords) {
+            for (auto* trackElement : TileElementsView<TrackElement>(coords.ToCoordsXY()))
+            {
+                auto rideIndex = static_cast<size_t>(trackElement->GetRideIndex());
+                if (trackElement->IsGhost() || rideIndex >= value.size())
+                    continue;
 
-        rideIndexArray[it.element->AsTrack()->GetRideIndex()] = true;
-    }
+                value[rideIndex] = true;
+            }
+        },
+        [](std::bitset<RCT12_MAX_RIDES_IN_PARK>& result, const std::bitset<RCT12_MAX_RIDES_IN_PARK>& value) {
+            result |= value;
+        });
 }
 
 void scenario_remove_trackless_rides(rct_s6_data* s6)
 {
-    std::array<bool, RCT12_MAX_RIDES_IN_PARK> rideHasTrack{};
-    ride_all_has_any_track_elements(rideHasTrack);
+    auto rideHasTrack = ride_all_has_any_track_elements();
     for (int32_t i = 0; i < RCT12_MAX_RIDES_IN_PARK; i++)
     {
         auto ride = &s6->rides[i];
@@ -27,6 +27,16 @@
 
 using random_engine_t = Random::Rct2::Engine;
 
+/**
+ * The subsystems that can draw from their own random engines, see scenario_rand_stream.
+ */
+enum class ScenarioRandStream : uint8_t
+{
+    Peep,
+    Vehicle,
+    Ride,
+};
+
 enum class EditorStep : uint8_t;
 
 struct ParkLoadResult;
@@ -459,6 +469,21 @@ void scenario_rand_seed(random_engine_t::result_type s0, random_engine_t::result
 random_engine_t::result_type scenario_rand();
 uint32_t scenario_rand_max(uint32_t max);
 
+/**
+ * Remembers the state of the scenario engine the streams of this tick are derived from, called at the start of every
+ * tick.
+ */
+void scenario_rand_begin_tick();
+
+/**
+ * An engine for one entity or ride of a subsystem for the rest of the tick. It is seeded from the state of the
+ * scenario engine at the start of the tick, the subsystem and the index, so the numbers it gives do not depend on the
+ * order the entities are updated in or on what else draws numbers meanwhile, which allows them to be updated in
+ * parallel. Nothing about the streams is saved, they follow from the scenario engine which already is. Moving a call
+ * site over to a stream changes the simulation, so it needs a new network version and new replays.
+ */
+random_engine_t scenario_rand_stream(ScenarioRandStream stream, uint32_t index);
+
 bool scenario_prepare_for_save();
 int32_t scenario_save(const utf8* path, int32_t flags);
 void scenario_remove_trackless_rides(rct_s6_data* s6);
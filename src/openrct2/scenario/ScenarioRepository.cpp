@@ -17,6 +17,7 @@
 #include "../core/Console.hpp"
 #include "../core/File.h"
 #include "../core/FileIndex.hpp"
+#include "../core/BufferedFileStream.h"
 #include "../core/FileStream.h"
 #include "../core/MemoryStream.h"
 #include "../core/Path.hpp"
@@ -31,6 +32,8 @@
 #include "ScenarioSources.h"
 
 #include <algorithm>
+#include <chrono>
+#include <future>
 #include <memory>
 #include <vector>
 
@@ -190,7 +193,7 @@ private:
             return ms;
         }
 
-        auto fs = std::make_unique<FileStream>(path, FILE_MODE_OPEN);
+        auto fs = std::make_unique<BufferedFileStream>(path);
         return fs;
     }
 
@@ -324,6 +327,10 @@ private:
     ScenarioFileIndex const _fileIndex;
     std::vector<scenario_index_entry> _scenarios;
     std::vector<scenario_highscore_entry*> _highscores;
+    bool _scanned{};
+
+    // Index built by ScanAsync, declared last so a running scan is waited on before anything else is destroyed.
+    std::future<std::vector<scenario_index_entry>> _scanResult;
 
 public:
     explicit ScenarioRepository(const std::shared_ptr<IPlatformEnvironment>& env)
@@ -339,21 +346,40 @@ public:
 
     void Scan(int32_t language) override
     {
+        // A background scan may still be writing the index file, so let it finish first.
+        if (_scanResult.valid())
+        {
+            _scanResult.get();
+        }
+
         ImportMegaPark();
+        SetScenarios(_fileIndex.LoadOrBuild(language));
+    }
 
-        // Reload scenarios from index
-        _scenarios.clear();
-        auto scenarios = _fileIndex.LoadOrBuild(language);
-        for (const auto& scenario : scenarios)
+    void ScanAsync(int32_t language) override
+    {
+        WaitForScan();
+
+        ImportMegaPark();
+        _scanResult = std::async(std::launch::async, [this, language]() { return _fileIndex.LoadOrBuild(language); });
+    }
+
+    bool IsScanning() const override
+    {
+        return _scanResult.valid() && _scanResult.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+    }
+
+    void WaitForScan() override
+    {
+        if (_scanResult.valid())
         {
-            AddScenario(scenario);
+            SetScenarios(_scanResult.get());
+        }
+        else if (!_scanned)
+        {
+            // No scan was started during startup with --fast-start
+            Scan(LocalisationService_GetCurrentLanguage());
         }
-
-        // Sort the scenarios and load the highscores
-        Sort();
-        LoadScores();
-        LoadLegacyScores();
-        AttachHighscores();
     }
 
     size_t GetCount() const override
@@ -472,6 +498,23 @@ private:
      * Mega Park from RollerCoaster Tycoon 1 is stored in an encrypted hidden file: mp.dat.
      * Decrypt the file and save it as sc21.sc4 in the user's scenario directory.
      */
+    void SetScenarios(const std::vector<scenario_index_entry>& scenarios)
+    {
+        // Reload scenarios from index
+        _scenarios.clear();
+        for (const auto& scenario : scenarios)
+        {
+            AddScenario(scenario);
+        }
+
+        // Sort the scenarios and load the highscores
+        Sort();
+        LoadScores();
+        LoadLegacyScores();
+        AttachHighscores();
+        _scanned = true;
+    }
+
     void ImportMegaPark()
     {
         auto mpdatPath = _env->GetFilePath(PATHID::MP_DAT);
@@ -744,7 +787,9 @@ std::unique_ptr<IScenarioRepository> CreateScenarioRepository(const std::shared_
 
 IScenarioRepository* GetScenarioRepository()
 {
-    return GetContext()->GetScenarioRepository();
+    auto repo = GetContext()->GetScenarioRepository();
+    repo->WaitForScan();
+    return repo;
 }
 
 void scenario_repository_scan()
@@ -61,6 +61,15 @@ struct IScenarioRepository
      */
     virtual void Scan(int32_t language) abstract;
 
+    /**
+     * Starts scanning the scenario directories on a background thread. The scenarios are only
+     * available once WaitForScan has been called, GetScenarioRepository() does so. WaitForScan
+     * also does the first scan if none was started.
+     */
+    virtual void ScanAsync(int32_t language) abstract;
+    virtual bool IsScanning() const abstract;
+    virtual void WaitForScan() abstract;
+
     virtual size_t GetCount() const abstract;
     virtual const scenario_index_entry* GetByIndex(size_t index) const abstract;
     virtual const scenario_index_entry* GetByFilename(const utf8* filename) const abstract;
@@ -75,6 +84,9 @@ struct IScenarioRepository
 };
 
 std::unique_ptr<IScenarioRepository> CreateScenarioRepository(const std::shared_ptr<OpenRCT2::IPlatformEnvironment>& env);
+/**
+ * Returns the scenario repository of the current context, a background scan is completed first.
+ */
 IScenarioRepository* GetScenarioRepository();
 
 void scenario_repository_scan();
@@ -11,12 +11,24 @@
 
 #    include "HookEngine.h"
 
+#    include "../Game.h"
+#    include "../config/Config.h"
+#    include "../core/Profiling.h"
+#    include "../core/String.hpp"
+#    include "../network/network.h"
+#    include "Plugin.h"
 #    include "ScriptEngine.h"
 
+#    include <algorithm>
+#    include <cmath>
 #    include <unordered_map>
+#    include <unordered_set>
 
 using namespace OpenRCT2::Scripting;
 
+// Warnings about a plugin that keeps going over the budget are repeated about once a minute
+static constexpr uint32_t BudgetWarningInterval = 40 * 60;
+
 HOOK_TYPE OpenRCT2::Scripting::GetHookType(const std::string& name)
 {
     static const std::unordered_map<std::string, HOOK_TYPE> LookupTable({
@@ -31,11 +43,59 @@ HOOK_TYPE OpenRCT2::Scripting::GetHookType(const std::string& name)
         { "ride.ratings.calculate", HOOK_TYPE::RIDE_RATINGS_CALCULATE },
         { "action.location", HOOK_TYPE::ACTION_LOCATION },
         { "guest.generation", HOOK_TYPE::GUEST_GENERATION },
+        { "map.change", HOOK_TYPE::MAP_CHANGE },
     });
     auto result = LookupTable.find(name);
     return (result != LookupTable.end()) ? result->second : HOOK_TYPE::UNDEFINED;
 }
 
+const char* OpenRCT2::Scripting::GetHookTypeName(HOOK_TYPE type)
+{
+    switch (type)
+    {
+        case HOOK_TYPE::ACTION_QUERY:
+            return "action.query";
+        case HOOK_TYPE::ACTION_EXECUTE:
+            return "action.execute";
+        case HOOK_TYPE::INTERVAL_TICK:
+            return "interval.tick";
+        case HOOK_TYPE::INTERVAL_DAY:
+            return "interval.day";
+        case HOOK_TYPE::NETWORK_CHAT:
+            return "network.chat";
+        case HOOK_TYPE::NETWORK_AUTHENTICATE:
+            return "network.authenticate";
+        case HOOK_TYPE::NETWORK_JOIN:
+            return "network.join";
+        case HOOK_TYPE::NETWORK_LEAVE:
+            return "network.leave";
+        case HOOK_TYPE::RIDE_RATINGS_CALCULATE:
+            return "ride.ratings.calculate";
+        case HOOK_TYPE::ACTION_LOCATION:
+            return "action.location";
+        case HOOK_TYPE::GUEST_GENERATION:
+            return "guest.generation";
+        case HOOK_TYPE::MAP_CHANGE:
+            return "map.change";
+        default:
+            return "unknown";
+    }
+}
+
+static const char* GetZoneName(Plugin& plugin, HOOK_TYPE type)
+{
+    // Never freed, the profiler only keeps the pointers and plugins can be reloaded during a capture
+    static std::unordered_set<std::string> ZoneNames;
+
+    auto& zoneName = plugin.GetProfile().ZoneNames[static_cast<size_t>(type)];
+    if (zoneName == nullptr)
+    {
+        auto name = "Scripts/" + plugin.GetMetadata().Name + "/" + GetHookTypeName(type);
+        zoneName = ZoneNames.insert(std::move(name)).first->c_str();
+    }
+    return zoneName;
+}
+
 HookEngine::HookEngine(ScriptEngine& scriptEngine)
     : _scriptEngine(scriptEngine)
 {
@@ -46,11 +106,24 @@ HookEngine::HookEngine(ScriptEngine& scriptEngine)
     }
 }
 
-uint32_t HookEngine::Subscribe(HOOK_TYPE type, std::shared_ptr<Plugin> owner, const DukValue& function)
+bool HookFilter::Matches(const HookEvent& e) const
+{
+    if (!ActionTypes.empty() || !CustomActions.empty())
+    {
+        auto isActionType = std::find(ActionTypes.begin(), ActionTypes.end(), e.ActionType) != ActionTypes.end();
+        auto isCustomAction = !e.CustomAction.empty()
+            && std::find(CustomActions.begin(), CustomActions.end(), e.CustomAction) != CustomActions.end();
+        if (!isActionType && !isCustomAction)
+            return false;
+    }
+    return Players.empty() || std::find(Players.begin(), Players.end(), e.Player) != Players.end();
+}
+
+uint32_t HookEngine::Subscribe(HOOK_TYPE type, std::shared_ptr<Plugin> owner, const DukValue& function, HookFilter filter)
 {
     auto& hookList = GetHookList(type);
     auto cookie = _nextCookie++;
-    hookList.Hooks.emplace_back(cookie, owner, function);
+    hookList.Hooks.emplace_back(cookie, owner, function, std::move(filter));
     return cookie;
 }
 
@@ -93,30 +166,67 @@ bool HookEngine::HasSubscriptions(HOOK_TYPE type) const
     return !hookList.Hooks.empty();
 }
 
+bool HookEngine::HasSubscriptions(HOOK_TYPE type, const HookEvent& e) const
+{
+    auto& hookList = GetHookList(type);
+    return std::any_of(hookList.Hooks.begin(), hookList.Hooks.end(), [type, &e](const Hook& hook) {
+        return hook.Filter.Matches(e) && IsHookEnabled(hook, type);
+    });
+}
+
 void HookEngine::Call(HOOK_TYPE type, bool isGameStateMutable)
 {
+    PROFILE_SCOPE("HookEngine::Call");
+
     auto& hookList = GetHookList(type);
     for (auto& hook : hookList.Hooks)
     {
-        _scriptEngine.ExecutePluginCall(hook.Owner, hook.Function, {}, isGameStateMutable);
+        if (IsHookEnabled(hook, type))
+        {
+            CallHook(hook, type, {}, isGameStateMutable);
+        }
     }
 }
 
 void HookEngine::Call(HOOK_TYPE type, const DukValue& arg, bool isGameStateMutable)
 {
+    PROFILE_SCOPE("HookEngine::Call");
+
     auto& hookList = GetHookList(type);
     for (auto& hook : hookList.Hooks)
     {
-        _scriptEngine.ExecutePluginCall(hook.Owner, hook.Function, { arg }, isGameStateMutable);
+        if (IsHookEnabled(hook, type))
+        {
+            CallHook(hook, type, { arg }, isGameStateMutable);
+        }
+    }
+}
+
+void HookEngine::Call(HOOK_TYPE type, const HookEvent& e, const DukValue& arg, bool isGameStateMutable)
+{
+    PROFILE_SCOPE("HookEngine::Call");
+
+    auto& hookList = GetHookList(type);
+    for (auto& hook : hookList.Hooks)
+    {
+        if (hook.Filter.Matches(e) && IsHookEnabled(hook, type))
+        {
+            CallHook(hook, type, { arg }, isGameStateMutable);
+        }
     }
 }
 
 void HookEngine::Call(
     HOOK_TYPE type, const std::initializer_list<std::pair<std::string_view, std::any>>& args, bool isGameStateMutable)
 {
+    PROFILE_SCOPE("HookEngine::Call");
+
     auto& hookList = GetHookList(type);
     for (auto& hook : hookList.Hooks)
     {
+        if (!IsHookEnabled(hook, type))
+            continue;
+
         auto ctx = _scriptEngine.GetContext();
 
         // Convert key/value pairs into an object
@@ -142,7 +252,95 @@ void HookEngine::Call(
 
         std::vector<DukValue> dukArgs;
         dukArgs.push_back(DukValue::take_from_stack(ctx));
-        _scriptEngine.ExecutePluginCall(hook.Owner, hook.Function, dukArgs, isGameStateMutable);
+        CallHook(hook, type, dukArgs, isGameStateMutable);
+    }
+}
+
+bool HookEngine::IsHookEnabled(const Hook& hook, HOOK_TYPE type)
+{
+    const auto& profile = hook.Owner->GetProfile();
+    if (profile.Suspended)
+        return false;
+    return type != HOOK_TYPE::INTERVAL_TICK || profile.ThrottledTicks == 0;
+}
+
+void HookEngine::CallHook(const Hook& hook, HOOK_TYPE type, const std::vector<DukValue>& args, bool isGameStateMutable)
+{
+    // The hook may unsubscribe itself, which would remove it from the list
+    auto owner = hook.Owner;
+    auto zoneBegin = Profiling::IsCapturing() ? Profiling::GetTimestamp() : -1;
+    auto begin = std::chrono::high_resolution_clock::now();
+
+    _scriptEngine.ExecutePluginCall(owner, hook.Function, args, isGameStateMutable);
+
+    std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - begin;
+    if (zoneBegin >= 0)
+    {
+        Profiling::RecordZone(GetZoneName(*owner, type), zoneBegin, Profiling::GetTimestamp());
+    }
+
+    auto& profile = owner->GetProfile();
+    auto& timing = profile.Hooks[static_cast<size_t>(type)];
+    timing.Count++;
+    timing.Total += elapsed;
+    timing.Max = std::max(timing.Max, elapsed);
+    profile.TickTime += elapsed;
+}
+
+void HookEngine::UpdateBudgets()
+{
+    const std::chrono::duration<double, std::milli> budget(gConfigPlugin.tick_budget);
+    for (const auto& plugin : _scriptEngine.GetPlugins())
+    {
+        auto& profile = plugin->GetProfile();
+        auto tickTime = profile.TickTime;
+        profile.TickTime = {};
+        profile.MaxTickTime = std::max(profile.MaxTickTime, tickTime);
+
+        // Ticks the plugin was throttled for do not count as being back within the budget
+        if (profile.ThrottledTicks > 0)
+        {
+            profile.ThrottledTicks--;
+            continue;
+        }
+        if (gConfigPlugin.tick_budget <= 0 || tickTime <= budget)
+        {
+            profile.OverBudgetTicks = 0;
+            continue;
+        }
+
+        profile.OverBudgetTicks++;
+        profile.TotalOverBudgetTicks++;
+
+        // Skipping the hooks of a remote plugin on just one side of a network game would desynchronise it
+        auto canThrottle = plugin->GetMetadata().Type == PluginType::Local || network_get_mode() == NETWORK_MODE_NONE;
+        auto suspendTicks = static_cast<uint32_t>(std::max(gConfigPlugin.suspend_over_budget_ticks, 0));
+        if (canThrottle && suspendTicks != 0 && profile.OverBudgetTicks >= suspendTicks)
+        {
+            profile.Suspended = true;
+            _scriptEngine.LogPluginInfo(
+                plugin,
+                String::StdFormat(
+                    "Suspended after %u ticks over the %.2f ms budget, use 'plugin_profile resume' to resume it.",
+                    profile.OverBudgetTicks, budget.count()));
+            continue;
+        }
+
+        if (canThrottle && gConfigPlugin.throttle_over_budget)
+        {
+            // Skip enough ticks to bring the average back within the budget
+            profile.ThrottledTicks = static_cast<uint32_t>(std::ceil(tickTime / budget)) - 1;
+        }
+
+        if (profile.TotalOverBudgetTicks == 1 || gCurrentTicks - profile.LastWarningTick >= BudgetWarningInterval)
+        {
+            profile.LastWarningTick = gCurrentTicks;
+            _scriptEngine.LogPluginInfo(
+                plugin,
+                String::StdFormat(
+                    "Took %.2f ms of the %.2f ms tick budget.",
+                    std::chrono::duration<double, std::milli>(tickTime).count(), budget.count()));
+        }
     }
 }
 
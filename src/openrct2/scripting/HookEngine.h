@@ -15,6 +15,8 @@
 #    include "Duktape.hpp"
 
 #    include <any>
+#    include <array>
+#    include <chrono>
 #    include <memory>
 #    include <string>
 #    include <tuple>
@@ -39,23 +41,77 @@ namespace OpenRCT2::Scripting
         RIDE_RATINGS_CALCULATE,
         ACTION_LOCATION,
         GUEST_GENERATION,
+        MAP_CHANGE,
         COUNT,
         UNDEFINED = -1,
     };
     constexpr size_t NUM_HOOK_TYPES = static_cast<size_t>(HOOK_TYPE::COUNT);
     HOOK_TYPE GetHookType(const std::string& name);
+    const char* GetHookTypeName(HOOK_TYPE type);
+
+    struct HookTiming
+    {
+        uint64_t Count{};
+        std::chrono::duration<double> Total{};
+        std::chrono::duration<double> Max{};
+    };
+
+    /**
+     * Time a plugin has spent in each of its hooks, used to find the plugins that slow down the game
+     * logic and to keep them within gConfigPlugin.tick_budget.
+     */
+    struct PluginProfile
+    {
+        std::array<HookTiming, NUM_HOOK_TYPES> Hooks{};
+        // Names of the profiler zones, they have to outlive the plugin until the trace is written
+        std::array<const char*, NUM_HOOK_TYPES> ZoneNames{};
+        std::chrono::duration<double> TickTime{};
+        std::chrono::duration<double> MaxTickTime{};
+        uint32_t OverBudgetTicks{};
+        uint64_t TotalOverBudgetTicks{};
+        uint32_t LastWarningTick{};
+        // Number of interval.tick calls that are skipped to make up for the last tick over budget
+        uint32_t ThrottledTicks{};
+        bool Suspended{};
+    };
+
+    /**
+     * What is known about an event before its arguments are created, so the hooks with a filter that does
+     * not match it can be skipped without building the arguments or calling into the script.
+     */
+    struct HookEvent
+    {
+        int32_t ActionType = -1;
+        std::string_view CustomAction;
+        int32_t Player = -1;
+    };
+
+    /**
+     * Filter given when subscribing to a hook, an empty list matches any event.
+     */
+    struct HookFilter
+    {
+        std::vector<int32_t> ActionTypes;
+        // Custom actions are matched by their id, or all of them by the action type of custom actions
+        std::vector<std::string> CustomActions;
+        std::vector<int32_t> Players;
+
+        bool Matches(const HookEvent& e) const;
+    };
 
     struct Hook
     {
         uint32_t Cookie;
         std::shared_ptr<Plugin> Owner;
         DukValue Function;
+        HookFilter Filter;
 
         Hook() = default;
-        Hook(uint32_t cookie, std::shared_ptr<Plugin> owner, const DukValue& function)
+        Hook(uint32_t cookie, std::shared_ptr<Plugin> owner, const DukValue& function, HookFilter filter)
             : Cookie(cookie)
             , Owner(owner)
             , Function(function)
+            , Filter(std::move(filter))
         {
         }
     };
@@ -80,19 +136,30 @@ namespace OpenRCT2::Scripting
     public:
         HookEngine(ScriptEngine& scriptEngine);
         HookEngine(const HookEngine&) = delete;
-        uint32_t Subscribe(HOOK_TYPE type, std::shared_ptr<Plugin> owner, const DukValue& function);
+        uint32_t Subscribe(
+            HOOK_TYPE type, std::shared_ptr<Plugin> owner, const DukValue& function, HookFilter filter = {});
         void Unsubscribe(HOOK_TYPE type, uint32_t cookie);
         void UnsubscribeAll(std::shared_ptr<const Plugin> owner);
         void UnsubscribeAll();
         bool HasSubscriptions(HOOK_TYPE type) const;
+        bool HasSubscriptions(HOOK_TYPE type, const HookEvent& e) const;
         void Call(HOOK_TYPE type, bool isGameStateMutable);
         void Call(HOOK_TYPE type, const DukValue& arg, bool isGameStateMutable);
+        void Call(HOOK_TYPE type, const HookEvent& e, const DukValue& arg, bool isGameStateMutable);
         void Call(
             HOOK_TYPE type, const std::initializer_list<std::pair<std::string_view, std::any>>& args, bool isGameStateMutable);
 
+        /**
+         * Checks the time each plugin spent in its hooks during the tick against the budget, warning about
+         * and throttling or suspending the plugins that went over it. Called at the end of every game tick.
+         */
+        void UpdateBudgets();
+
     private:
         HookList& GetHookList(HOOK_TYPE type);
         const HookList& GetHookList(HOOK_TYPE type) const;
+        static bool IsHookEnabled(const Hook& hook, HOOK_TYPE type);
+        void CallHook(const Hook& hook, HOOK_TYPE type, const std::vector<DukValue>& args, bool isGameStateMutable);
     };
 } // namespace OpenRCT2::Scripting
 
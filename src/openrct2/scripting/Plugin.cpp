@@ -15,6 +15,7 @@
 #    include "../OpenRCT2.h"
 #    include "../core/File.h"
 #    include "Duktape.hpp"
+#    include "ScriptBytecodeCache.h"
 
 #    include <algorithm>
 #    include <fstream>
@@ -33,7 +34,7 @@ void Plugin::SetCode(std::string_view code)
     _code = code;
 }
 
-void Plugin::Load()
+void Plugin::Load(ScriptBytecodeCache* bytecodeCache)
 {
     if (!_path.empty())
     {
@@ -62,9 +63,11 @@ void Plugin::Load()
         "     })(" + projectedVariables + ");";
     // clang-format on
 
-    auto flags = DUK_COMPILE_EVAL | DUK_COMPILE_SAFE | DUK_COMPILE_NOSOURCE | DUK_COMPILE_NOFILENAME;
-    auto result = duk_eval_raw(_context, code.c_str(), code.size(), flags);
-    if (result != DUK_ERR_NONE)
+    // The wrapper is compiled as a program, which returns the value of its last statement just like eval
+    auto compiled = bytecodeCache != nullptr
+        ? bytecodeCache->Compile(_context, _path.empty() ? std::string_view(_code) : std::string_view(_path), code)
+        : duk_pcompile_lstring(_context, 0, code.c_str(), code.size()) == 0;
+    if (!compiled || duk_pcall(_context, 0) != DUK_EXEC_SUCCESS)
     {
         auto val = std::string(duk_safe_to_string(_context, -1));
         duk_pop(_context);
@@ -76,6 +79,13 @@ void Plugin::Load()
 
 void Plugin::Start()
 {
+    // The main function of a worker plugin is called by its ScriptWorker, in the worker's own heap
+    if (_metadata.Type == PluginType::Worker)
+    {
+        _hasStarted = true;
+        return;
+    }
+
     const auto& mainFunc = _metadata.Main;
     if (mainFunc.context() == nullptr)
     {
@@ -152,6 +162,8 @@ PluginType Plugin::ParsePluginType(std::string_view type)
         return PluginType::Local;
     if (type == "remote")
         return PluginType::Remote;
+    if (type == "worker")
+        return PluginType::Worker;
     throw std::invalid_argument("Unknown plugin type.");
 }
 
@@ -12,6 +12,7 @@
 #ifdef ENABLE_SCRIPTING
 
 #    include "Duktape.hpp"
+#    include "HookEngine.h"
 
 #    include <memory>
 #    include <string>
@@ -33,8 +34,16 @@ namespace OpenRCT2::Scripting
          * modify game state in certain contexts.
          */
         Remote,
+
+        /**
+         * Scripts that run on their own thread with no access to the game, they are sent snapshots of the
+         * park and can only change it by posting custom actions.
+         */
+        Worker,
     };
 
+    class ScriptBytecodeCache;
+
     struct PluginMetadata
     {
         std::string Name;
@@ -53,6 +62,7 @@ namespace OpenRCT2::Scripting
         PluginMetadata _metadata{};
         std::string _code;
         bool _hasStarted{};
+        PluginProfile _profile;
 
     public:
         std::string GetPath() const
@@ -80,13 +90,18 @@ namespace OpenRCT2::Scripting
             return _hasStarted;
         }
 
+        PluginProfile& GetProfile()
+        {
+            return _profile;
+        }
+
         Plugin() = default;
         Plugin(duk_context* context, const std::string& path);
         Plugin(const Plugin&) = delete;
         Plugin(Plugin&&) = delete;
 
         void SetCode(std::string_view code);
-        void Load();
+        void Load(ScriptBytecodeCache* bytecodeCache = nullptr);
         void Start();
         void Stop();
 
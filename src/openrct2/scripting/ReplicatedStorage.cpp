@@ -0,0 +1,139 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifdef ENABLE_SCRIPTING
+
+#    include "ReplicatedStorage.h"
+
+#    include "../core/IStream.hpp"
+
+using namespace OpenRCT2;
+using namespace OpenRCT2::Scripting;
+
+const std::string* ReplicatedStorage::Get(std::string_view key) const
+{
+    auto it = _values.find(key);
+    return it != _values.end() ? &it->second : nullptr;
+}
+
+std::vector<std::string> ReplicatedStorage::GetKeys() const
+{
+    std::vector<std::string> keys;
+    keys.reserve(_values.size());
+    for (const auto& kvp : _values)
+    {
+        keys.push_back(kvp.first);
+    }
+    return keys;
+}
+
+void ReplicatedStorage::Set(std::string_view key, std::string json)
+{
+    auto it = _values.find(key);
+    if (it == _values.end())
+    {
+        _values.emplace(std::string(key), std::move(json));
+    }
+    else if (it->second != json)
+    {
+        it->second = std::move(json);
+    }
+    else
+    {
+        return;
+    }
+    _changedKeys.emplace(key);
+}
+
+void ReplicatedStorage::Remove(std::string_view key)
+{
+    auto it = _values.find(key);
+    if (it != _values.end())
+    {
+        _values.erase(it);
+        _changedKeys.emplace(key);
+    }
+}
+
+void ReplicatedStorage::Clear()
+{
+    _values.clear();
+    _changedKeys.clear();
+    _revision = 0;
+}
+
+uint32_t ReplicatedStorage::GetRevision() const
+{
+    return _revision;
+}
+
+bool ReplicatedStorage::HasChanges() const
+{
+    return !_changedKeys.empty();
+}
+
+std::vector<ReplicatedStorage::Change> ReplicatedStorage::TakeChanges()
+{
+    std::vector<Change> changes;
+    changes.reserve(_changedKeys.size());
+    for (const auto& key : _changedKeys)
+    {
+        // A key can be changed and removed again within the same tick
+        auto value = Get(key);
+        changes.push_back({ key, value != nullptr ? std::make_optional(*value) : std::nullopt });
+    }
+    _changedKeys.clear();
+    _revision++;
+    return changes;
+}
+
+void ReplicatedStorage::ApplyChanges(uint32_t revision, const std::vector<Change>& changes)
+{
+    if (revision <= _revision)
+        return;
+
+    for (const auto& change : changes)
+    {
+        if (change.Value)
+        {
+            _values[change.Key] = *change.Value;
+        }
+        else
+        {
+            _values.erase(change.Key);
+        }
+    }
+    _revision = revision;
+}
+
+void ReplicatedStorage::Write(IStream& stream) const
+{
+    // The changes not taken yet are included, the batch that takes them applies the same values again
+    stream.WriteValue<uint32_t>(_revision);
+    stream.WriteValue<uint32_t>(static_cast<uint32_t>(_values.size()));
+    for (const auto& kvp : _values)
+    {
+        stream.WriteString(kvp.first);
+        stream.WriteString(kvp.second);
+    }
+}
+
+void ReplicatedStorage::Read(IStream& stream)
+{
+    Clear();
+    _revision = stream.ReadValue<uint32_t>();
+    auto count = stream.ReadValue<uint32_t>();
+    for (uint32_t i = 0; i < count; i++)
+    {
+        auto key = stream.ReadStdString();
+        _values[std::move(key)] = stream.ReadStdString();
+    }
+}
+
+#endif
@@ -0,0 +1,77 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#ifdef ENABLE_SCRIPTING
+
+#    include "../common.h"
+
+#    include <map>
+#    include <optional>
+#    include <set>
+#    include <string>
+#    include <string_view>
+#    include <vector>
+
+namespace OpenRCT2
+{
+    struct IStream;
+}
+
+namespace OpenRCT2::Scripting
+{
+    /**
+     * Key-value store shared by the plugins of a server with all its clients. Only the server changes it,
+     * the keys changed during a tick are sent to the clients at the end of it and clients that join get the
+     * whole store with the map. Values are stored as JSON.
+     */
+    class ReplicatedStorage
+    {
+    public:
+        struct Change
+        {
+            std::string Key;
+            // No value if the key was removed
+            std::optional<std::string> Value;
+        };
+
+    private:
+        std::map<std::string, std::string, std::less<>> _values;
+        std::set<std::string, std::less<>> _changedKeys;
+        // Number of batches of changes taken so far, the clients ignore batches the map already contains
+        uint32_t _revision{};
+
+    public:
+        const std::string* Get(std::string_view key) const;
+        std::vector<std::string> GetKeys() const;
+        void Set(std::string_view key, std::string json);
+        void Remove(std::string_view key);
+        void Clear();
+
+        uint32_t GetRevision() const;
+        bool HasChanges() const;
+
+        /**
+         * Returns the keys changed since the last call with their current values and starts a new revision.
+         */
+        std::vector<Change> TakeChanges();
+
+        /**
+         * Applies changes taken by the server, unless the store has already been read at that revision or a
+         * later one.
+         */
+        void ApplyChanges(uint32_t revision, const std::vector<Change>& changes);
+
+        void Write(IStream& stream) const;
+        void Read(IStream& stream);
+    };
+} // namespace OpenRCT2::Scripting
+
+#endif
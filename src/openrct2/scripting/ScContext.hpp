@@ -21,6 +21,7 @@
 #    include "ScConfiguration.hpp"
 #    include "ScDisposable.hpp"
 #    include "ScObject.hpp"
+#    include "ScReplicatedStorage.hpp"
 #    include "ScriptEngine.h"
 
 #    include <cstdio>
@@ -53,6 +54,11 @@ namespace OpenRCT2::Scripting
             return std::make_shared<ScConfiguration>(scriptEngine.GetSharedStorage());
         }
 
+        std::shared_ptr<ScReplicatedStorage> replicatedStorage_get()
+        {
+            return std::make_shared<ScReplicatedStorage>();
+        }
+
         void captureImage(const DukValue& options)
         {
             auto ctx = GetContext()->GetScriptEngine().GetContext();
@@ -199,7 +205,7 @@ namespace OpenRCT2::Scripting
             return 1;
         }
 
-        std::shared_ptr<ScDisposable> subscribe(const std::string& hook, const DukValue& callback)
+        std::shared_ptr<ScDisposable> subscribe(const std::string& hook, const DukValue& callback, const DukValue& filter)
         {
             auto& scriptEngine = GetContext()->GetScriptEngine();
             auto ctx = scriptEngine.GetContext();
@@ -221,7 +227,7 @@ namespace OpenRCT2::Scripting
                 duk_error(ctx, DUK_ERR_ERROR, "Not in a plugin context");
             }
 
-            auto cookie = _hookEngine.Subscribe(hookType, owner, callback);
+            auto cookie = _hookEngine.Subscribe(hookType, owner, callback, scriptEngine.CreateHookFilter(filter));
             return std::make_shared<ScDisposable>([this, hookType, cookie]() { _hookEngine.Unsubscribe(hookType, cookie); });
         }
 
@@ -375,6 +381,7 @@ namespace OpenRCT2::Scripting
         {
             dukglue_register_property(ctx, &ScContext::configuration_get, nullptr, "configuration");
             dukglue_register_property(ctx, &ScContext::sharedStorage_get, nullptr, "sharedStorage");
+            dukglue_register_property(ctx, &ScContext::replicatedStorage_get, nullptr, "replicatedStorage");
             dukglue_register_method(ctx, &ScContext::captureImage, "captureImage");
             dukglue_register_method(ctx, &ScContext::getObject, "getObject");
             dukglue_register_method(ctx, &ScContext::getAllObjects, "getAllObjects");
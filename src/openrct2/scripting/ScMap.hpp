@@ -12,15 +12,20 @@
 #ifdef ENABLE_SCRIPTING
 
 #    include "../common.h"
+#    include "../peep/Peep.h"
 #    include "../ride/Ride.h"
 #    include "../ride/TrainManager.h"
 #    include "../world/EntityList.h"
 #    include "../world/Map.h"
+#    include "../world/Sprite.h"
+#    include "../world/Surface.h"
 #    include "Duktape.hpp"
 #    include "ScEntity.hpp"
 #    include "ScRide.hpp"
 #    include "ScTile.hpp"
 
+#    include <bitset>
+
 namespace OpenRCT2::Scripting
 {
     class ScMap
@@ -105,17 +110,17 @@ namespace OpenRCT2::Scripting
             {
                 for (auto sprite : EntityList<Balloon>())
                 {
-                    result.push_back(GetObjectAsDukValue(_context, std::make_shared<ScEntity>(sprite->sprite_index)));
+                    result.push_back(GetEntityAsDukValue(sprite));
                 }
             }
-            if (type == "car")
+            else if (type == "car")
             {
                 for (auto trainHead : TrainManager::View())
                 {
                     for (auto carId = trainHead->sprite_index; carId != SPRITE_INDEX_NULL;)
                     {
                         auto car = GetEntity<Vehicle>(carId);
-                        result.push_back(GetObjectAsDukValue(_context, std::make_shared<ScVehicle>(carId)));
+                        result.push_back(GetEntityAsDukValue(car));
                         carId = car->next_vehicle_on_train;
                     }
                 }
@@ -124,25 +129,25 @@ namespace OpenRCT2::Scripting
             {
                 for (auto sprite : EntityList<Litter>())
                 {
-                    result.push_back(GetObjectAsDukValue(_context, std::make_shared<ScEntity>(sprite->sprite_index)));
+                    result.push_back(GetEntityAsDukValue(sprite));
                 }
             }
             else if (type == "duck")
             {
                 for (auto sprite : EntityList<Duck>())
                 {
-                    result.push_back(GetObjectAsDukValue(_context, std::make_shared<ScEntity>(sprite->sprite_index)));
+                    result.push_back(GetEntityAsDukValue(sprite));
                 }
             }
             else if (type == "peep")
             {
                 for (auto sprite : EntityList<Guest>())
                 {
-                    result.push_back(GetObjectAsDukValue(_context, std::make_shared<ScGuest>(sprite->sprite_index)));
+                    result.push_back(GetEntityAsDukValue(sprite));
                 }
                 for (auto sprite : EntityList<Staff>())
                 {
-                    result.push_back(GetObjectAsDukValue(_context, std::make_shared<ScStaff>(sprite->sprite_index)));
+                    result.push_back(GetEntityAsDukValue(sprite));
                 }
             }
             else
@@ -153,6 +158,122 @@ namespace OpenRCT2::Scripting
             return result;
         }
 
+        /**
+         * Removes the entities with the given ids, much faster than calling remove on each of them. The same
+         * entities as for remove are unsupported, and nothing is removed when any of the ids is one of them.
+         */
+        void removeEntities(const std::vector<int32_t>& ids) const
+        {
+            ThrowIfGameStateNotMutable();
+            std::bitset<MAX_ENTITIES> seen;
+            std::vector<Peep*> peeps;
+            std::vector<SpriteBase*> others;
+            for (auto id : ids)
+            {
+                if (id < 0 || id >= MAX_ENTITIES || seen[id])
+                    continue;
+                seen[id] = true;
+
+                auto entity = GetEntity(static_cast<uint16_t>(id));
+                if (entity == nullptr || entity->Type == EntityType::Null)
+                    continue;
+
+                if (entity->Type == EntityType::Vehicle)
+                {
+                    duk_error(_context, DUK_ERR_ERROR, "Removing a vehicle is currently unsupported.");
+                }
+                auto peep = entity->As<Peep>();
+                if (peep != nullptr)
+                {
+                    if (peep->State == PeepState::OnRide || peep->State == PeepState::EnteringRide)
+                    {
+                        duk_error(_context, DUK_ERR_ERROR, "Removing a peep that is on a ride is currently unsupported.");
+                    }
+                    peeps.push_back(peep);
+                }
+                else
+                {
+                    entity->Invalidate();
+                    others.push_back(entity);
+                }
+            }
+            peep_remove_many(peeps);
+            sprite_remove_many(others);
+        }
+
+        /**
+         * Gets the state of every guest as one typed array per field, much faster than reading the
+         * properties of each guest from getAllEntities.
+         */
+        DukValue getGuestData() const
+        {
+            auto ctx = _context;
+            auto count = static_cast<size_t>(GetEntityListCount(EntityType::Guest));
+            auto objIdx = duk_push_object(ctx);
+            duk_push_uint(ctx, static_cast<duk_uint_t>(count));
+            duk_put_prop_string(ctx, objIdx, "count");
+            auto ids = PushTypedArray<uint16_t>(objIdx, "id", count, DUK_BUFOBJ_UINT16ARRAY);
+            auto x = PushTypedArray<int32_t>(objIdx, "x", count, DUK_BUFOBJ_INT32ARRAY);
+            auto y = PushTypedArray<int32_t>(objIdx, "y", count, DUK_BUFOBJ_INT32ARRAY);
+            auto z = PushTypedArray<int32_t>(objIdx, "z", count, DUK_BUFOBJ_INT32ARRAY);
+            auto happiness = PushTypedArray<uint8_t>(objIdx, "happiness", count, DUK_BUFOBJ_UINT8ARRAY);
+            auto energy = PushTypedArray<uint8_t>(objIdx, "energy", count, DUK_BUFOBJ_UINT8ARRAY);
+            auto nausea = PushTypedArray<uint8_t>(objIdx, "nausea", count, DUK_BUFOBJ_UINT8ARRAY);
+            auto hunger = PushTypedArray<uint8_t>(objIdx, "hunger", count, DUK_BUFOBJ_UINT8ARRAY);
+            auto thirst = PushTypedArray<uint8_t>(objIdx, "thirst", count, DUK_BUFOBJ_UINT8ARRAY);
+            auto toilet = PushTypedArray<uint8_t>(objIdx, "toilet", count, DUK_BUFOBJ_UINT8ARRAY);
+            auto cash = PushTypedArray<int32_t>(objIdx, "cash", count, DUK_BUFOBJ_INT32ARRAY);
+
+            size_t i = 0;
+            for (auto guest : EntityList<Guest>())
+            {
+                if (i >= count)
+                    break;
+
+                ids[i] = guest->sprite_index;
+                x[i] = guest->x;
+                y[i] = guest->y;
+                z[i] = guest->z;
+                happiness[i] = guest->Happiness;
+                energy[i] = guest->Energy;
+                nausea[i] = guest->Nausea;
+                hunger[i] = guest->Hunger;
+                thirst[i] = guest->Thirst;
+                toilet[i] = guest->Toilet;
+                cash[i] = guest->CashInPocket;
+                i++;
+            }
+            return DukValue::take_from_stack(ctx);
+        }
+
+        /**
+         * Gets the base height of the surface of each tile in a rectangle of the map, row by row.
+         * Tiles that are outside of the map have a height of 0.
+         */
+        DukValue getSurfaceHeights(int32_t x, int32_t y, int32_t width, int32_t height) const
+        {
+            auto ctx = _context;
+            if (width < 0 || height < 0 || width > MAXIMUM_MAP_SIZE_TECHNICAL || height > MAXIMUM_MAP_SIZE_TECHNICAL)
+            {
+                duk_error(ctx, DUK_ERR_RANGE_ERROR, "Invalid size.");
+            }
+
+            auto length = static_cast<size_t>(width) * static_cast<size_t>(height);
+            auto data = static_cast<uint8_t*>(duk_push_fixed_buffer(ctx, length));
+            for (int32_t row = 0; row < height; row++)
+            {
+                for (int32_t column = 0; column < width; column++)
+                {
+                    auto coords = TileCoordsXY(x + column, y + row).ToCoordsXY();
+                    const auto* surfaceElement = map_is_location_valid(coords) ? map_get_surface_element_at(coords) : nullptr;
+                    data[row * width + column] = surfaceElement != nullptr ? surfaceElement->base_height : 0;
+                }
+            }
+            duk_push_buffer_object(ctx, -1, 0, length, DUK_BUFOBJ_UINT8ARRAY);
+            duk_remove(ctx, -2);
+            return DukValue::take_from_stack(ctx);
+        }
+
         static void Register(duk_context* ctx)
         {
             dukglue_register_property(ctx, &ScMap::size_get, nullptr, "size");
@@ -163,23 +284,29 @@ namespace OpenRCT2::Scripting
             dukglue_register_method(ctx, &ScMap::getTile, "getTile");
             dukglue_register_method(ctx, &ScMap::getEntity, "getEntity");
             dukglue_register_method(ctx, &ScMap::getAllEntities, "getAllEntities");
+            dukglue_register_method(ctx, &ScMap::removeEntities, "removeEntities");
+            dukglue_register_method(ctx, &ScMap::getGuestData, "getGuestData");
+            dukglue_register_method(ctx, &ScMap::getSurfaceHeights, "getSurfaceHeights");
         }
 
     private:
+        /**
+         * Adds a typed array of count elements to the object at objIdx, returns the data to fill it with.
+         */
+        template<typename T> T* PushTypedArray(duk_idx_t objIdx, const char* name, size_t count, duk_uint_t type) const
+        {
+            auto length = count * sizeof(T);
+            auto data = static_cast<T*>(duk_push_fixed_buffer(_context, length));
+            duk_push_buffer_object(_context, -1, 0, length, type);
+            duk_put_prop_string(_context, objIdx, name);
+            // The typed array keeps a reference to the buffer
+            duk_pop(_context);
+            return data;
+        }
+
         DukValue GetEntityAsDukValue(const SpriteBase* sprite) const
         {
-            auto spriteId = sprite->sprite_index;
-            switch (sprite->Type)
-            {
-                case EntityType::Vehicle:
-                    return GetObjectAsDukValue(_context, std::make_shared<ScVehicle>(spriteId));
-                case EntityType::Staff:
-                    return GetObjectAsDukValue(_context, std::make_shared<ScStaff>(spriteId));
-                case EntityType::Guest:
-                    return GetObjectAsDukValue(_context, std::make_shared<ScGuest>(spriteId));
-                default:
-                    return GetObjectAsDukValue(_context, std::make_shared<ScEntity>(spriteId));
-            }
+            return GetContext()->GetScriptEngine().GetEntityHandle(*sprite);
         }
     };
 } // namespace OpenRCT2::Scripting
@@ -402,6 +402,18 @@ namespace OpenRCT2::Scripting
 #    endif
         }
 
+        DukValue telemetry_get() const
+        {
+#    ifndef DISABLE_NETWORK
+            auto result = DuktapeTryParseJson(_context, network_get_telemetry_as_json().dump());
+            if (result)
+            {
+                return *result;
+            }
+#    endif
+            return ToDuk(_context, nullptr);
+        }
+
         std::shared_ptr<ScPlayerGroup> getGroup(int32_t index) const
         {
 #    ifndef DISABLE_NETWORK
@@ -524,6 +536,7 @@ namespace OpenRCT2::Scripting
             dukglue_register_property(ctx, &ScNetwork::currentPlayer_get, nullptr, "currentPlayer");
             dukglue_register_property(ctx, &ScNetwork::defaultGroup_get, &ScNetwork::defaultGroup_set, "defaultGroup");
             dukglue_register_property(ctx, &ScNetwork::stats_get, nullptr, "stats");
+            dukglue_register_property(ctx, &ScNetwork::telemetry_get, nullptr, "telemetry");
             dukglue_register_method(ctx, &ScNetwork::addGroup, "addGroup");
             dukglue_register_method(ctx, &ScNetwork::getGroup, "getGroup");
             dukglue_register_method(ctx, &ScNetwork::removeGroup, "removeGroup");
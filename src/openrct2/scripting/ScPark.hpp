@@ -20,10 +20,12 @@
 #    include "../peep/Peep.h"
 #    include "../windows/Intent.h"
 #    include "../world/Park.h"
+#    include "../world/ParkHistory.h"
 #    include "Duktape.hpp"
 #    include "ScriptEngine.h"
 
 #    include <algorithm>
+#    include <limits>
 
 namespace OpenRCT2::Scripting
 {
@@ -452,6 +454,29 @@ namespace OpenRCT2::Scripting
             gfx_invalidate_screen();
         }
 
+        std::vector<DukValue> getHistory(
+            const std::string& metric, const DukValue& firstTick, const DukValue& lastTick) const
+        {
+            auto ctx = GetContext()->GetScriptEngine().GetContext();
+            auto parsedMetric = ParkHistory::ParseMetric(metric);
+            if (!parsedMetric)
+            {
+                duk_error(ctx, DUK_ERR_ERROR, "Invalid metric.");
+            }
+            return GetSamples(ctx, gParkHistory.GetMetric(*parsedMetric), firstTick, lastTick);
+        }
+
+        std::vector<DukValue> getRideIncomeHistory(int32_t rideId, const DukValue& firstTick, const DukValue& lastTick) const
+        {
+            auto ctx = GetContext()->GetScriptEngine().GetContext();
+            auto income = gParkHistory.GetRideIncome(static_cast<ride_id_t>(rideId));
+            if (income == nullptr)
+            {
+                return {};
+            }
+            return GetSamples(ctx, *income, firstTick, lastTick);
+        }
+
         std::vector<std::shared_ptr<ScParkMessage>> messages_get() const
         {
             std::vector<std::shared_ptr<ScParkMessage>> result;
@@ -561,6 +586,33 @@ namespace OpenRCT2::Scripting
             dukglue_register_method(ctx, &ScPark::getFlag, "getFlag");
             dukglue_register_method(ctx, &ScPark::setFlag, "setFlag");
             dukglue_register_method(ctx, &ScPark::postMessage, "postMessage");
+            dukglue_register_method(ctx, &ScPark::getHistory, "getHistory");
+            dukglue_register_method(ctx, &ScPark::getRideIncomeHistory, "getRideIncomeHistory");
+        }
+
+    private:
+        static uint32_t GetTick(const DukValue& value, uint32_t defaultValue)
+        {
+            // Ticks go past the range of int32 after a long enough game
+            if (value.type() != DukValue::NUMBER)
+                return defaultValue;
+            return static_cast<uint32_t>(std::clamp<double>(value.as_double(), 0, std::numeric_limits<uint32_t>::max()));
+        }
+
+        static std::vector<DukValue> GetSamples(
+            duk_context* ctx, const OpenRCT2::TimeSeries& series, const DukValue& firstTick, const DukValue& lastTick)
+        {
+            auto first = GetTick(firstTick, 0);
+            auto last = GetTick(lastTick, std::numeric_limits<uint32_t>::max());
+            std::vector<DukValue> result;
+            for (const auto& sample : series.GetRange(first, last))
+            {
+                DukObject obj(ctx);
+                obj.Set("tick", sample.Tick);
+                obj.Set("value", static_cast<int32_t>(sample.Value));
+                result.push_back(obj.Take());
+            }
+            return result;
         }
     };
 } // namespace OpenRCT2::Scripting
@@ -0,0 +1,102 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#ifdef ENABLE_SCRIPTING
+
+#    include "../Context.h"
+#    include "../network/network.h"
+#    include "Duktape.hpp"
+#    include "ReplicatedStorage.h"
+#    include "ScriptEngine.h"
+
+namespace OpenRCT2::Scripting
+{
+    class ScReplicatedStorage
+    {
+    public:
+        static void Register(duk_context* ctx)
+        {
+            dukglue_register_method(ctx, &ScReplicatedStorage::keys, "keys");
+            dukglue_register_method(ctx, &ScReplicatedStorage::get, "get");
+            dukglue_register_method(ctx, &ScReplicatedStorage::set, "set");
+            dukglue_register_method(ctx, &ScReplicatedStorage::has, "has");
+            dukglue_register_method(ctx, &ScReplicatedStorage::remove, "remove");
+        }
+
+    private:
+        static ReplicatedStorage& GetStorage()
+        {
+            return GetContext()->GetScriptEngine().GetReplicatedStorage();
+        }
+
+        static void ThrowIfClient(duk_context* ctx)
+        {
+            if (network_get_mode() == NETWORK_MODE_CLIENT)
+            {
+                duk_error(ctx, DUK_ERR_ERROR, "Only the server can change the replicated storage.");
+            }
+        }
+
+        std::vector<std::string> keys() const
+        {
+            return GetStorage().GetKeys();
+        }
+
+        DukValue get(const std::string& key, const DukValue& defaultValue) const
+        {
+            auto ctx = GetContext()->GetScriptEngine().GetContext();
+            const auto* json = GetStorage().Get(key);
+            if (json != nullptr)
+            {
+                auto value = DuktapeTryParseJson(ctx, *json);
+                if (value)
+                {
+                    return *value;
+                }
+            }
+            return defaultValue;
+        }
+
+        void set(const std::string& key, const DukValue& value) const
+        {
+            auto ctx = GetContext()->GetScriptEngine().GetContext();
+            ThrowIfClient(ctx);
+            if (value.type() == DukValue::Type::UNDEFINED)
+            {
+                GetStorage().Remove(key);
+                return;
+            }
+
+            value.push();
+            const auto* json = duk_json_encode(ctx, -1);
+            if (json == nullptr)
+            {
+                duk_error(ctx, DUK_ERR_ERROR, "Value can not be stored as JSON.");
+            }
+            GetStorage().Set(key, json);
+            duk_pop(ctx);
+        }
+
+        bool has(const std::string& key) const
+        {
+            return GetStorage().Get(key) != nullptr;
+        }
+
+        void remove(const std::string& key) const
+        {
+            auto ctx = GetContext()->GetScriptEngine().GetContext();
+            ThrowIfClient(ctx);
+            GetStorage().Remove(key);
+        }
+    };
+} // namespace OpenRCT2::Scripting
+
+#endif
@@ -14,6 +14,8 @@
 #    include "../Context.h"
 #    include "../common.h"
 #    include "../core/Guard.hpp"
+#    include "../peep/GuestPathfinding.h"
+#    include "../ride/RideSpatialIndex.h"
 #    include "../ride/Track.h"
 #    include "../world/Footpath.h"
 #    include "../world/Scenery.h"
@@ -1476,6 +1478,8 @@ namespace OpenRCT2::Scripting
         void Invalidate()
         {
             map_invalidate_tile_full(_coords);
+            PathfindCacheInvalidate();
+            RideSpatialIndexInvalidateTile(_coords);
         }
 
     public:
@@ -1682,6 +1686,8 @@ namespace OpenRCT2::Scripting
                     }
                 }
                 map_invalidate_tile_full(_coords);
+                PathfindCacheInvalidate();
+                RideSpatialIndexInvalidateTile(_coords);
             }
         }
 
@@ -1734,6 +1740,8 @@ namespace OpenRCT2::Scripting
                     }
                     first[origNumElements].SetLastForTile(true);
                     map_invalidate_tile_full(_coords);
+                    PathfindCacheInvalidate();
+                    RideSpatialIndexInvalidateTile(_coords);
                     result = std::make_shared<ScTileElement>(_coords, &first[index]);
                 }
             }
@@ -1753,6 +1761,8 @@ namespace OpenRCT2::Scripting
             {
                 tile_element_remove(&first[index]);
                 map_invalidate_tile_full(_coords);
+                PathfindCacheInvalidate();
+                RideSpatialIndexInvalidateTile(_coords);
             }
         }
 
@@ -0,0 +1,147 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifdef ENABLE_SCRIPTING
+
+#    include "ScriptBytecodeCache.h"
+
+#    include "../Diagnostic.h"
+#    include "../core/File.h"
+#    include "../core/MemoryStream.h"
+#    include "../core/Path.hpp"
+#    include "Duktape.hpp"
+
+#    include <cstdio>
+#    include <cstring>
+
+using namespace OpenRCT2;
+using namespace OpenRCT2::Scripting;
+
+static constexpr uint32_t CACHE_MAGIC = 0x43434250; // PBCC
+static constexpr uint32_t CACHE_VERSION = 1;
+
+static uint64_t GetHash(std::string_view data)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (auto c : data)
+    {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+ScriptBytecodeCache::ScriptBytecodeCache(std::string directory)
+    : _directory(std::move(directory))
+{
+}
+
+std::string ScriptBytecodeCache::GetPath(std::string_view id) const
+{
+    char fileName[32];
+    std::snprintf(fileName, sizeof(fileName), "%016llx.bin", static_cast<unsigned long long>(GetHash(id)));
+    return Path::Combine(_directory, fileName);
+}
+
+const ScriptBytecodeCache::Entry* ScriptBytecodeCache::Find(std::string_view id, uint64_t codeHash, uint64_t codeLength)
+{
+    auto key = GetHash(id);
+    auto it = _entries.find(key);
+    if (it == _entries.end())
+    {
+        auto path = GetPath(id);
+        if (!File::Exists(path))
+            return nullptr;
+
+        try
+        {
+            auto data = File::ReadAllBytes(path);
+            MemoryStream ms(data.data(), data.size());
+            auto magic = ms.ReadValue<uint32_t>();
+            auto version = ms.ReadValue<uint32_t>();
+            auto dukVersion = ms.ReadValue<uint32_t>();
+            if (magic != CACHE_MAGIC || version != CACHE_VERSION || dukVersion != static_cast<uint32_t>(DUK_VERSION))
+                return nullptr;
+
+            Entry entry;
+            entry.CodeHash = ms.ReadValue<uint64_t>();
+            entry.CodeLength = ms.ReadValue<uint64_t>();
+            entry.Bytecode.resize(ms.ReadValue<uint32_t>());
+            ms.Read(entry.Bytecode.data(), entry.Bytecode.size());
+            it = _entries.emplace(key, std::move(entry)).first;
+        }
+        catch (const std::exception& e)
+        {
+            log_warning("Unable to read plugin bytecode cache '%s': %s", path.c_str(), e.what());
+            return nullptr;
+        }
+    }
+
+    const auto& entry = it->second;
+    if (entry.CodeHash != codeHash || entry.CodeLength != codeLength)
+        return nullptr;
+    return &entry;
+}
+
+void ScriptBytecodeCache::Store(std::string_view id, Entry&& entry)
+{
+    auto path = GetPath(id);
+    try
+    {
+        MemoryStream ms;
+        ms.WriteValue<uint32_t>(CACHE_MAGIC);
+        ms.WriteValue<uint32_t>(CACHE_VERSION);
+        ms.WriteValue<uint32_t>(static_cast<uint32_t>(DUK_VERSION));
+        ms.WriteValue<uint64_t>(entry.CodeHash);
+        ms.WriteValue<uint64_t>(entry.CodeLength);
+        ms.WriteValue<uint32_t>(static_cast<uint32_t>(entry.Bytecode.size()));
+        ms.Write(entry.Bytecode.data(), entry.Bytecode.size());
+
+        Path::CreateDirectory(_directory);
+        File::WriteAllBytes(path, ms.GetData(), ms.GetLength());
+    }
+    catch (const std::exception& e)
+    {
+        log_warning("Unable to write plugin bytecode cache '%s': %s", path.c_str(), e.what());
+    }
+    _entries[GetHash(id)] = std::move(entry);
+}
+
+bool ScriptBytecodeCache::Compile(duk_context* ctx, std::string_view id, std::string_view code)
+{
+    auto codeHash = GetHash(code);
+    auto codeLength = static_cast<uint64_t>(code.size());
+    const auto* entry = Find(id, codeHash, codeLength);
+    if (entry != nullptr)
+    {
+        auto buffer = duk_push_fixed_buffer(ctx, entry->Bytecode.size());
+        std::memcpy(buffer, entry->Bytecode.data(), entry->Bytecode.size());
+        duk_load_function(ctx);
+        return true;
+    }
+
+    if (duk_pcompile_lstring(ctx, 0, code.data(), code.size()) != 0)
+        return false;
+
+    duk_dup_top(ctx);
+    duk_dump_function(ctx);
+    duk_size_t bytecodeLength{};
+    auto bytecode = static_cast<const uint8_t*>(duk_get_buffer(ctx, -1, &bytecodeLength));
+
+    Entry newEntry;
+    newEntry.CodeHash = codeHash;
+    newEntry.CodeLength = codeLength;
+    newEntry.Bytecode.assign(bytecode, bytecode + bytecodeLength);
+    duk_pop(ctx);
+
+    Store(id, std::move(newEntry));
+    return true;
+}
+
+#endif
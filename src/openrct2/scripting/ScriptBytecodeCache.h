@@ -0,0 +1,64 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#ifdef ENABLE_SCRIPTING
+
+#    include "../common.h"
+
+#    include <string>
+#    include <string_view>
+#    include <unordered_map>
+#    include <vector>
+
+struct duk_hthread;
+typedef struct duk_hthread duk_context;
+
+namespace OpenRCT2::Scripting
+{
+    /**
+     * Keeps the Duktape bytecode of compiled plugins, in memory and in the cache directory, so unchanged
+     * plugins are not compiled again when the game starts or a client joins the same server again.
+     * Only bytecode compiled by this game is ever loaded, Duktape has no verifier so bytecode from
+     * anywhere else could crash it.
+     */
+    class ScriptBytecodeCache
+    {
+    private:
+        struct Entry
+        {
+            uint64_t CodeHash{};
+            uint64_t CodeLength{};
+            std::vector<uint8_t> Bytecode;
+        };
+
+        std::string _directory;
+        // By the hash of the id
+        std::unordered_map<uint64_t, Entry> _entries;
+
+    public:
+        explicit ScriptBytecodeCache(std::string directory);
+
+        /**
+         * Compiles code as a program and pushes the function to the stack. The cache entry is identified by
+         * id, such as the path of the plugin, which has one entry that is replaced whenever the code changes.
+         * Plugins without a path, like those sent by a server, use their code as the id.
+         * Returns false with the error message pushed instead if the code can not be compiled.
+         */
+        bool Compile(duk_context* ctx, std::string_view id, std::string_view code);
+
+    private:
+        std::string GetPath(std::string_view id) const;
+        const Entry* Find(std::string_view id, uint64_t codeHash, uint64_t codeLength);
+        void Store(std::string_view id, Entry&& entry);
+    };
+} // namespace OpenRCT2::Scripting
+
+#endif
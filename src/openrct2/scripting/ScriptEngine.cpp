@@ -11,6 +11,8 @@
 
 #    include "ScriptEngine.h"
 
+#    include "../Context.h"
+#    include "../Game.h"
 #    include "../PlatformEnvironment.h"
 #    include "../actions/CustomAction.h"
 #    include "../actions/GameAction.h"
@@ -19,6 +21,7 @@
 #    include "../config/Config.h"
 #    include "../core/File.h"
 #    include "../core/FileScanner.h"
+#    include "../core/MemoryUsage.h"
 #    include "../core/Path.hpp"
 #    include "../interface/InteractiveConsole.h"
 #    include "../platform/Platform2.h"
@@ -33,18 +36,24 @@
 #    include "ScNetwork.hpp"
 #    include "ScObject.hpp"
 #    include "ScPark.hpp"
+#    include "ScReplicatedStorage.hpp"
 #    include "ScRide.hpp"
 #    include "ScScenario.hpp"
 #    include "ScSocket.hpp"
 #    include "ScTile.hpp"
 
+#    include <cstddef>
+#    include <cstdlib>
 #    include <iostream>
 #    include <stdexcept>
 
 using namespace OpenRCT2;
 using namespace OpenRCT2::Scripting;
 
-static constexpr int32_t OPENRCT2_PLUGIN_API_VERSION = 26;
+static constexpr int32_t OPENRCT2_PLUGIN_API_VERSION = 35;
+
+// Worker plugins are sent a snapshot of the park every second
+static constexpr uint32_t WORKER_SNAPSHOT_INTERVAL = GAME_UPDATE_FPS;
 
 struct ExpressionStringifier final
 {
@@ -354,9 +363,71 @@ public:
     }
 };
 
+namespace OpenRCT2::Scripting
+{
+    struct DukHeapStats
+    {
+        uint64_t Allocations{};
+    };
+} // namespace OpenRCT2::Scripting
+
+// Same as the default allocation functions of Duktape, but counting the allocations. Every block starts with its
+// size so the bytes held by the heaps of all contexts can be tracked under MemoryUsageCategory::Scripts.
+static constexpr size_t DukBlockHeaderSize = alignof(std::max_align_t);
+
+static void* DukBlockFromBase(void* base, duk_size_t size)
+{
+    *static_cast<size_t*>(base) = size;
+    MemoryUsageTrack(MemoryUsageCategory::Scripts, static_cast<int64_t>(size));
+    return static_cast<uint8_t*>(base) + DukBlockHeaderSize;
+}
+
+static void* DukBlockGetBase(void* ptr)
+{
+    auto base = static_cast<uint8_t*>(ptr) - DukBlockHeaderSize;
+    MemoryUsageTrack(MemoryUsageCategory::Scripts, -static_cast<int64_t>(*reinterpret_cast<size_t*>(base)));
+    return base;
+}
+
+static void* DukAlloc(void* udata, duk_size_t size)
+{
+    static_cast<DukHeapStats*>(udata)->Allocations++;
+    auto base = std::malloc(DukBlockHeaderSize + size);
+    return base != nullptr ? DukBlockFromBase(base, size) : nullptr;
+}
+
+static void DukFree(void*, void* ptr)
+{
+    if (ptr != nullptr)
+    {
+        std::free(DukBlockGetBase(ptr));
+    }
+}
+
+static void* DukRealloc(void* udata, void* ptr, duk_size_t size)
+{
+    if (ptr == nullptr)
+        return DukAlloc(udata, size);
+    if (size == 0)
+    {
+        DukFree(udata, ptr);
+        return nullptr;
+    }
+
+    static_cast<DukHeapStats*>(udata)->Allocations++;
+    auto oldSize = *reinterpret_cast<size_t*>(static_cast<uint8_t*>(ptr) - DukBlockHeaderSize);
+    auto base = std::realloc(static_cast<uint8_t*>(ptr) - DukBlockHeaderSize, DukBlockHeaderSize + size);
+    if (base == nullptr)
+        return nullptr;
+
+    MemoryUsageTrack(MemoryUsageCategory::Scripts, -static_cast<int64_t>(oldSize));
+    return DukBlockFromBase(base, size);
+}
+
 DukContext::DukContext()
+    : _stats(std::make_unique<DukHeapStats>())
 {
-    _context = duk_create_heap_default();
+    _context = duk_create_heap(DukAlloc, DukRealloc, DukFree, _stats.get(), nullptr);
     if (_context == nullptr)
     {
         throw std::runtime_error("Unable to initialise duktape context.");
@@ -371,6 +442,7 @@ DukContext::~DukContext()
 ScriptEngine::ScriptEngine(InteractiveConsole& console, IPlatformEnvironment& env)
     : _console(console)
     , _env(env)
+    , _bytecodeCache(Path::Combine(env.GetDirectoryPath(DIRBASE::CACHE), "plugin"))
     , _hookEngine(*this)
 {
 }
@@ -392,6 +464,7 @@ void ScriptEngine::Initialise()
     ScParkMessage::Register(ctx);
     ScPlayer::Register(ctx);
     ScPlayerGroup::Register(ctx);
+    ScReplicatedStorage::Register(ctx);
     ScRide::Register(ctx);
     ScRideStation::Register(ctx);
     ScRideObject::Register(ctx);
@@ -471,7 +544,7 @@ void ScriptEngine::LoadPlugin(std::shared_ptr<Plugin>& plugin)
     try
     {
         ScriptExecutionInfo::PluginScope scope(_execInfo, plugin, false);
-        plugin->Load();
+        plugin->Load(&_bytecodeCache);
 
         auto metadata = plugin->GetMetadata();
         if (metadata.MinApiVersion <= OPENRCT2_PLUGIN_API_VERSION)
@@ -494,6 +567,7 @@ void ScriptEngine::StopPlugin(std::shared_ptr<Plugin> plugin)
 {
     if (plugin->HasStarted())
     {
+        StopWorker(plugin);
         RemoveCustomGameActions(plugin);
         RemoveIntervals(plugin);
         RemoveSockets(plugin);
@@ -556,9 +630,10 @@ void ScriptEngine::AutoReloadPlugins()
                     StopPlugin(plugin);
 
                     ScriptExecutionInfo::PluginScope scope(_execInfo, plugin, false);
-                    plugin->Load();
+                    plugin->Load(&_bytecodeCache);
                     LogPluginInfo(plugin, "Reloaded");
                     plugin->Start();
+                    StartWorker(plugin);
                 }
                 catch (const std::exception& e)
                 {
@@ -595,6 +670,7 @@ void ScriptEngine::StartPlugins()
             {
                 LogPluginInfo(plugin, "Started");
                 plugin->Start();
+                StartWorker(plugin);
             }
             catch (const std::exception& e)
             {
@@ -660,9 +736,67 @@ void ScriptEngine::Update()
 
     UpdateIntervals();
     UpdateSockets();
+    UpdateWorkers();
     ProcessREPL();
 }
 
+void ScriptEngine::StartWorker(const std::shared_ptr<Plugin>& plugin)
+{
+    if (plugin->GetMetadata().Type != PluginType::Worker)
+        return;
+
+    auto worker = std::make_unique<ScriptWorker>(plugin->GetCode());
+    worker->Start();
+    _workers.push_back({ plugin, std::move(worker) });
+}
+
+void ScriptEngine::StopWorker(const std::shared_ptr<Plugin>& plugin)
+{
+    auto it = std::find_if(
+        _workers.begin(), _workers.end(), [&plugin](const WorkerInfo& info) { return info.Owner == plugin; });
+    if (it != _workers.end())
+    {
+        it->Worker->Stop();
+        for (const auto& message : it->Worker->TakeMessages())
+        {
+            LogPluginInfo(plugin, message);
+        }
+        _workers.erase(it);
+    }
+}
+
+void ScriptEngine::UpdateWorkers()
+{
+    if (_workers.empty())
+        return;
+
+    std::shared_ptr<const WorkerSnapshot> snapshot;
+    if (gCurrentTicks - _lastWorkerSnapshotTick >= WORKER_SNAPSHOT_INTERVAL || gCurrentTicks < _lastWorkerSnapshotTick)
+    {
+        snapshot = std::make_shared<const WorkerSnapshot>(WorkerSnapshot::Capture());
+        _lastWorkerSnapshotTick = gCurrentTicks;
+    }
+
+    for (auto& info : _workers)
+    {
+        if (snapshot != nullptr)
+        {
+            info.Worker->PostSnapshot(snapshot);
+        }
+        for (const auto& message : info.Worker->TakeMessages())
+        {
+            LogPluginInfo(info.Owner, message);
+        }
+
+        // Workers can only change the park through the custom actions registered by other plugins
+        for (const auto& action : info.Worker->TakeActions())
+        {
+            auto customAction = CustomAction(action.Id, action.Json);
+            GameActions::Execute(&customAction);
+        }
+    }
+}
+
 void ScriptEngine::ProcessREPL()
 {
     while (_evalQueue.size() > 0)
@@ -1087,22 +1221,96 @@ static std::unique_ptr<GameAction> CreateGameActionFromActionId(const std::strin
     return nullptr;
 }
 
+DukValue ScriptEngine::GetEntityHandle(const SpriteBase& entity)
+{
+    if (_entityHandles.empty())
+    {
+        _entityHandles.resize(MAX_ENTITIES);
+    }
+
+    auto& handle = _entityHandles[entity.sprite_index];
+    if (handle.Value.type() != DukValue::Type::OBJECT || handle.Type != entity.Type)
+    {
+        auto spriteId = entity.sprite_index;
+        switch (entity.Type)
+        {
+            case EntityType::Vehicle:
+                handle.Value = GetObjectAsDukValue(_context, std::make_shared<ScVehicle>(spriteId));
+                break;
+            case EntityType::Staff:
+                handle.Value = GetObjectAsDukValue(_context, std::make_shared<ScStaff>(spriteId));
+                break;
+            case EntityType::Guest:
+                handle.Value = GetObjectAsDukValue(_context, std::make_shared<ScGuest>(spriteId));
+                break;
+            default:
+                handle.Value = GetObjectAsDukValue(_context, std::make_shared<ScEntity>(spriteId));
+                break;
+        }
+        handle.Type = entity.Type;
+
+        // The object is shared by every plugin and the next entity with the same index, so it may not hold any
+        // state of its own
+        handle.Value.push();
+        duk_seal(_context, -1);
+        duk_pop(_context);
+    }
+    return handle.Value;
+}
+
+void ScriptEngine::RunMapChangeHooks(const TileChanges& changes)
+{
+    if (!changes.IsEmpty() && _hookEngine.HasSubscriptions(HOOK_TYPE::MAP_CHANGE))
+    {
+        DukStackFrame frame(_context);
+
+        duk_push_array(_context);
+        duk_uarridx_t index = 0;
+        for (const auto& tilePos : changes.Tiles)
+        {
+            auto tile = DukObject(_context);
+            tile.Set("x", tilePos.x);
+            tile.Set("y", tilePos.y);
+            tile.Take().push();
+            duk_put_prop_index(_context, -2, index);
+            index++;
+        }
+        auto tiles = DukValue::take_from_stack(_context);
+
+        DukObject obj(_context);
+        obj.Set("all", changes.All);
+        obj.Set("tiles", tiles);
+        auto e = obj.Take();
+        _hookEngine.Call(HOOK_TYPE::MAP_CHANGE, e, true);
+    }
+
+    // Only record the changes while a plugin is interested in them, from the next tick on for new subscriptions
+    TileChangesSetConsumer(TileChangesConsumer::Scripts, _hookEngine.HasSubscriptions(HOOK_TYPE::MAP_CHANGE));
+}
+
 void ScriptEngine::RunGameActionHooks(const GameAction& action, std::unique_ptr<GameActions::Result>& result, bool isExecute)
 {
     DukStackFrame frame(_context);
 
     auto hookType = isExecute ? HOOK_TYPE::ACTION_EXECUTE : HOOK_TYPE::ACTION_QUERY;
-    if (_hookEngine.HasSubscriptions(hookType))
+    auto actionId = action.GetType();
+    const auto* customAction = actionId == GameCommand::Custom ? static_cast<const CustomAction*>(&action) : nullptr;
+    auto customActionId = customAction != nullptr ? customAction->GetId() : std::string();
+
+    HookEvent e;
+    e.ActionType = EnumValue(actionId);
+    e.CustomAction = customActionId;
+    e.Player = action.GetPlayer();
+
+    if (_hookEngine.HasSubscriptions(hookType, e))
     {
         DukObject obj(_context);
 
-        auto actionId = action.GetType();
-        if (action.GetType() == GameCommand::Custom)
+        if (customAction != nullptr)
         {
-            auto customAction = static_cast<const CustomAction&>(action);
-            obj.Set("action", customAction.GetId());
+            obj.Set("action", customActionId);
 
-            auto dukArgs = DuktapeTryParseJson(_context, customAction.GetJson());
+            auto dukArgs = DuktapeTryParseJson(_context, customAction->GetJson());
             if (dukArgs)
             {
                 obj.Set("args", *dukArgs);
@@ -1137,7 +1345,7 @@ void ScriptEngine::RunGameActionHooks(const GameAction& action, std::unique_ptr<
         obj.Set("result", GameActionResultToDuk(action, result));
         auto dukEventArgs = obj.Take();
 
-        _hookEngine.Call(hookType, dukEventArgs, false);
+        _hookEngine.Call(hookType, e, dukEventArgs, false);
 
         if (!isExecute)
         {
@@ -1156,6 +1364,56 @@ void ScriptEngine::RunGameActionHooks(const GameAction& action, std::unique_ptr<
     }
 }
 
+HookFilter ScriptEngine::CreateHookFilter(const DukValue& filter) const
+{
+    HookFilter result;
+    if (filter.type() == DukValue::Type::OBJECT)
+    {
+        auto dukActions = filter["actions"];
+        if (dukActions.is_array())
+        {
+            for (const auto& dukAction : dukActions.as_array())
+            {
+                if (dukAction.type() == DukValue::Type::NUMBER)
+                {
+                    result.ActionTypes.push_back(dukAction.as_int());
+                }
+                else if (dukAction.type() == DukValue::Type::STRING)
+                {
+                    // Names that are not game actions are custom actions, which may not be registered yet
+                    const auto& name = dukAction.as_string();
+                    auto it = ActionNameToType.find(name);
+                    if (it != ActionNameToType.end())
+                    {
+                        result.ActionTypes.push_back(EnumValue(it->second));
+                    }
+                    else
+                    {
+                        result.CustomActions.push_back(name);
+                    }
+                }
+            }
+        }
+
+        auto dukPlayers = filter["players"];
+        if (dukPlayers.is_array())
+        {
+            for (const auto& dukPlayer : dukPlayers.as_array())
+            {
+                if (dukPlayer.type() == DukValue::Type::NUMBER)
+                {
+                    result.Players.push_back(dukPlayer.as_int());
+                }
+            }
+        }
+    }
+    else if (filter.type() != DukValue::Type::UNDEFINED)
+    {
+        duk_error(_context, DUK_ERR_ERROR, "Expected object for filter");
+    }
+    return result;
+}
+
 std::unique_ptr<GameAction> ScriptEngine::CreateGameAction(const std::string& actionid, const DukValue& args)
 {
     auto action = CreateGameActionFromActionId(actionid);
@@ -1238,17 +1496,58 @@ void ScriptEngine::SaveSharedStorage()
 
 IntervalHandle ScriptEngine::AllocateHandle()
 {
-    for (size_t i = 0; i < _intervals.size(); i++)
+    if (!_freeIntervalHandles.empty())
     {
-        if (!_intervals[i].IsValid())
-        {
-            return static_cast<IntervalHandle>(i + 1);
-        }
+        auto handle = _freeIntervalHandles.back();
+        _freeIntervalHandles.pop_back();
+        return handle;
     }
     _intervals.emplace_back();
     return static_cast<IntervalHandle>(_intervals.size());
 }
 
+void ScriptEngine::ScheduleInterval(const ScriptInterval& interval)
+{
+    _intervalQueue.push({ _intervalTimestamp + interval.Delay, interval.Handle, interval.Generation });
+}
+
+void ScriptEngine::FreeInterval(ScriptInterval& interval)
+{
+    auto it = _numIntervalsByPlugin.find(interval.Owner.get());
+    if (it != _numIntervalsByPlugin.end() && --it->second == 0)
+    {
+        _numIntervalsByPlugin.erase(it);
+    }
+    _freeIntervalHandles.push_back(interval.Handle);
+    _numActiveIntervals--;
+
+    // Keep the generation so the queue entries of the old interval do not match a new one using the handle
+    auto generation = interval.Generation + 1;
+    interval = {};
+    interval.Generation = generation;
+}
+
+void ScriptEngine::CompactIntervalQueue()
+{
+    // Removed intervals leave their entries in the queue, rebuild it once they outnumber the live ones
+    if (_intervalQueue.size() < 64 || _intervalQueue.size() < _numActiveIntervals * 2)
+        return;
+
+    std::vector<ScheduledInterval> entries;
+    entries.reserve(_numActiveIntervals);
+    while (!_intervalQueue.empty())
+    {
+        auto entry = _intervalQueue.top();
+        _intervalQueue.pop();
+        const auto& interval = _intervals[static_cast<size_t>(entry.Handle) - 1];
+        if (interval.IsValid() && interval.Generation == entry.Generation)
+        {
+            entries.push_back(entry);
+        }
+    }
+    _intervalQueue = decltype(_intervalQueue)(std::greater<>(), std::move(entries));
+}
+
 IntervalHandle ScriptEngine::AddInterval(const std::shared_ptr<Plugin>& plugin, int32_t delay, bool repeat, DukValue&& callback)
 {
     auto handle = AllocateHandle();
@@ -1257,10 +1556,13 @@ IntervalHandle ScriptEngine::AddInterval(const std::shared_ptr<Plugin>& plugin,
         auto& interval = _intervals[static_cast<size_t>(handle) - 1];
         interval.Owner = plugin;
         interval.Handle = handle;
-        interval.Delay = delay;
-        interval.LastTimestamp = _lastIntervalTimestamp;
+        interval.Delay = static_cast<uint32_t>(std::max(delay, 0));
         interval.Callback = std::move(callback);
         interval.Repeat = repeat;
+        ScheduleInterval(interval);
+
+        _numActiveIntervals++;
+        _numIntervalsByPlugin[plugin.get()]++;
     }
     return handle;
 }
@@ -1272,44 +1574,61 @@ void ScriptEngine::RemoveInterval(const std::shared_ptr<Plugin>& plugin, Interva
         auto& interval = _intervals[static_cast<size_t>(handle) - 1];
 
         // Only allow owner or REPL (nullptr) to remove intervals
-        if (plugin == nullptr || interval.Owner == plugin)
+        if (interval.IsValid() && (plugin == nullptr || interval.Owner == plugin))
         {
-            interval = {};
+            FreeInterval(interval);
+            CompactIntervalQueue();
         }
     }
 }
 
+uint32_t ScriptEngine::GetNumIntervals(const std::shared_ptr<Plugin>& plugin) const
+{
+    auto it = _numIntervalsByPlugin.find(plugin.get());
+    return it != _numIntervalsByPlugin.end() ? it->second : 0;
+}
+
 void ScriptEngine::UpdateIntervals()
 {
-    uint32_t timestamp = platform_get_ticks();
-    if (timestamp < _lastIntervalTimestamp)
+    // Unsigned subtraction gives the right delta when the platform ticks wrap
+    uint32_t ticks = platform_get_ticks();
+    if (_lastIntervalTicks != 0)
     {
-        // timestamp has wrapped, subtract all intervals by the remaining amount before wrap
-        auto delta = static_cast<int64_t>(std::numeric_limits<uint32_t>::max() - _lastIntervalTimestamp);
-        for (auto& interval : _intervals)
-        {
-            if (interval.IsValid())
-            {
-                interval.LastTimestamp = -delta;
-            }
-        }
+        _intervalTimestamp += ticks - _lastIntervalTicks;
     }
-    _lastIntervalTimestamp = timestamp;
+    _lastIntervalTicks = ticks;
 
-    for (auto& interval : _intervals)
+    // Take the due intervals first, those the callbacks add or reschedule are run on a later update
+    std::vector<ScheduledInterval> due;
+    while (!_intervalQueue.empty() && _intervalQueue.top().Deadline <= _intervalTimestamp)
     {
-        if (interval.IsValid())
-        {
-            if (timestamp >= interval.LastTimestamp + interval.Delay)
-            {
-                ExecutePluginCall(interval.Owner, interval.Callback, {}, false);
+        due.push_back(_intervalQueue.top());
+        _intervalQueue.pop();
+    }
 
-                interval.LastTimestamp = timestamp;
-                if (!interval.Repeat)
-                {
-                    RemoveInterval(nullptr, interval.Handle);
-                }
-            }
+    for (const auto& entry : due)
+    {
+        auto index = static_cast<size_t>(entry.Handle) - 1;
+        if (!_intervals[index].IsValid() || _intervals[index].Generation != entry.Generation)
+            continue;
+
+        // The callback can add intervals, which can move the vector
+        auto owner = _intervals[index].Owner;
+        auto callback = _intervals[index].Callback;
+        ExecutePluginCall(owner, callback, {}, false);
+
+        auto& interval = _intervals[index];
+        if (!interval.IsValid() || interval.Generation != entry.Generation)
+            continue;
+
+        if (interval.Repeat)
+        {
+            interval.Generation++;
+            ScheduleInterval(interval);
+        }
+        else
+        {
+            FreeInterval(interval);
         }
     }
 }
@@ -1318,11 +1637,12 @@ void ScriptEngine::RemoveIntervals(const std::shared_ptr<Plugin>& plugin)
 {
     for (auto& interval : _intervals)
     {
-        if (interval.Owner == plugin)
+        if (interval.IsValid() && interval.Owner == plugin)
         {
-            interval = {};
+            FreeInterval(interval);
         }
     }
+    CompactIntervalQueue();
 }
 
 #    ifndef DISABLE_NETWORK
@@ -1373,6 +1693,13 @@ void ScriptEngine::RemoveSockets(const std::shared_ptr<Plugin>& plugin)
 #    endif
 }
 
+uint64_t OpenRCT2::Scripting::GetNumHeapAllocations(duk_context* ctx)
+{
+    duk_memory_functions functions{};
+    duk_get_memory_functions(ctx, &functions);
+    return static_cast<const DukHeapStats*>(functions.udata)->Allocations;
+}
+
 std::string OpenRCT2::Scripting::Stringify(const DukValue& val)
 {
     return ExpressionStringifier::StringifyExpression(val);
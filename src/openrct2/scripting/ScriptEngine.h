@@ -15,9 +15,15 @@
 #    include "../core/FileWatcher.h"
 #    include "../management/Finance.h"
 #    include "../world/Location.hpp"
+#    include "../world/SpriteBase.h"
+#    include "../world/TileChanges.h"
 #    include "HookEngine.h"
 #    include "Plugin.h"
+#    include "ReplicatedStorage.h"
+#    include "ScriptBytecodeCache.h"
+#    include "ScriptWorker.h"
 
+#    include <functional>
 #    include <future>
 #    include <list>
 #    include <memory>
@@ -96,16 +102,20 @@ namespace OpenRCT2::Scripting
         }
     };
 
+    struct DukHeapStats;
+
     class DukContext
     {
     private:
+        std::unique_ptr<DukHeapStats> _stats;
         duk_context* _context{};
 
     public:
         DukContext();
         DukContext(DukContext&) = delete;
         DukContext(DukContext&& src) noexcept
-            : _context(std::move(src._context))
+            : _stats(std::move(src._stats))
+            , _context(std::move(src._context))
         {
             src._context = {};
         }
@@ -123,7 +133,8 @@ namespace OpenRCT2::Scripting
         std::shared_ptr<Plugin> Owner;
         IntervalHandle Handle{};
         uint32_t Delay{};
-        int64_t LastTimestamp{};
+        // Incremented each time the interval is rescheduled or removed, so its old queue entries are ignored
+        uint32_t Generation{};
         DukValue Callback;
         bool Repeat{};
 
@@ -133,6 +144,18 @@ namespace OpenRCT2::Scripting
         }
     };
 
+    struct ScheduledInterval
+    {
+        int64_t Deadline{};
+        IntervalHandle Handle{};
+        uint32_t Generation{};
+
+        bool operator>(const ScheduledInterval& other) const
+        {
+            return Deadline != other.Deadline ? Deadline > other.Deadline : Handle > other.Handle;
+        }
+    };
+
     class ScriptEngine
     {
     private:
@@ -144,13 +167,30 @@ namespace OpenRCT2::Scripting
         bool _pluginsStarted{};
         std::queue<std::tuple<std::promise<void>, std::string>> _evalQueue;
         std::vector<std::shared_ptr<Plugin>> _plugins;
+        ScriptBytecodeCache _bytecodeCache;
         uint32_t _lastHotReloadCheckTick{};
         HookEngine _hookEngine;
         ScriptExecutionInfo _execInfo;
         DukValue _sharedStorage;
+        ReplicatedStorage _replicatedStorage;
+
+        struct EntityHandle
+        {
+            EntityType Type{};
+            DukValue Value;
+        };
+        // Indexed by sprite index, released before the heap as the handles are declared after it
+        std::vector<EntityHandle> _entityHandles;
 
-        uint32_t _lastIntervalTimestamp{};
+        // Milliseconds since the first update, unlike the platform ticks it does not wrap
+        int64_t _intervalTimestamp{};
+        uint32_t _lastIntervalTicks{};
+        // Indexed by handle - 1, the queue holds the next deadline of each interval
         std::vector<ScriptInterval> _intervals;
+        std::vector<IntervalHandle> _freeIntervalHandles;
+        std::priority_queue<ScheduledInterval, std::vector<ScheduledInterval>, std::greater<>> _intervalQueue;
+        size_t _numActiveIntervals{};
+        std::unordered_map<const Plugin*, uint32_t> _numIntervalsByPlugin;
 
         std::unique_ptr<FileWatcher> _pluginFileWatcher;
         std::unordered_set<std::string> _changedPluginFiles;
@@ -166,6 +206,15 @@ namespace OpenRCT2::Scripting
         };
 
         std::unordered_map<std::string, CustomActionInfo> _customActions;
+
+        struct WorkerInfo
+        {
+            std::shared_ptr<Plugin> Owner;
+            std::unique_ptr<ScriptWorker> Worker;
+        };
+
+        std::vector<WorkerInfo> _workers;
+        uint32_t _lastWorkerSnapshotTick{};
 #    ifndef DISABLE_NETWORK
         std::list<std::shared_ptr<ScSocketBase>> _sockets;
 #    endif
@@ -190,6 +239,10 @@ namespace OpenRCT2::Scripting
         {
             return _sharedStorage;
         }
+        ReplicatedStorage& GetReplicatedStorage()
+        {
+            return _replicatedStorage;
+        }
         std::vector<std::shared_ptr<Plugin>>& GetPlugins()
         {
             return _plugins;
@@ -220,12 +273,21 @@ namespace OpenRCT2::Scripting
         bool RegisterCustomAction(
             const std::shared_ptr<Plugin>& plugin, std::string_view action, const DukValue& query, const DukValue& execute);
         void RunGameActionHooks(const GameAction& action, std::unique_ptr<GameActions::Result>& result, bool isExecute);
+        HookFilter CreateHookFilter(const DukValue& filter) const;
+        void RunMapChangeHooks(const TileChanges& changes);
+
+        /**
+         * Returns the script object of the entity, which is created once for each sprite index and type and then reused,
+         * instead of allocating a new object on every access that the garbage collector has to free again.
+         */
+        DukValue GetEntityHandle(const SpriteBase& entity);
         std::unique_ptr<GameAction> CreateGameAction(const std::string& actionid, const DukValue& args);
 
         void SaveSharedStorage();
 
         IntervalHandle AddInterval(const std::shared_ptr<Plugin>& plugin, int32_t delay, bool repeat, DukValue&& callback);
         void RemoveInterval(const std::shared_ptr<Plugin>& plugin, IntervalHandle handle);
+        uint32_t GetNumIntervals(const std::shared_ptr<Plugin>& plugin) const;
 
 #    ifndef DISABLE_NETWORK
         void AddSocket(const std::shared_ptr<ScSocketBase>& socket);
@@ -253,17 +315,29 @@ namespace OpenRCT2::Scripting
         void LoadSharedStorage();
 
         IntervalHandle AllocateHandle();
+        void ScheduleInterval(const ScriptInterval& interval);
+        void FreeInterval(ScriptInterval& interval);
+        void CompactIntervalQueue();
         void UpdateIntervals();
         void RemoveIntervals(const std::shared_ptr<Plugin>& plugin);
 
         void UpdateSockets();
         void RemoveSockets(const std::shared_ptr<Plugin>& plugin);
+
+        void StartWorker(const std::shared_ptr<Plugin>& plugin);
+        void StopWorker(const std::shared_ptr<Plugin>& plugin);
+        void UpdateWorkers();
     };
 
     bool IsGameStateMutable();
     void ThrowIfGameStateNotMutable();
     std::string Stringify(const DukValue& value);
 
+    /**
+     * Number of allocations made by the heap of the given context since it was created.
+     */
+    uint64_t GetNumHeapAllocations(duk_context* ctx);
+
 } // namespace OpenRCT2::Scripting
 
 #endif
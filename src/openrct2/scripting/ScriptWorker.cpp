@@ -0,0 +1,354 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifdef ENABLE_SCRIPTING
+
+#    include "ScriptWorker.h"
+
+#    include "../Game.h"
+#    include "../localisation/Date.h"
+#    include "../management/Finance.h"
+#    include "../peep/Peep.h"
+#    include "../world/EntityList.h"
+#    include "../world/Park.h"
+#    include "Duktape.hpp"
+#    include "ScriptEngine.h"
+
+using namespace OpenRCT2::Scripting;
+
+namespace OpenRCT2::Scripting
+{
+    /**
+     * The worker global, the only API available to the script of a worker plugin.
+     */
+    class ScWorker
+    {
+    private:
+        ScriptWorker& _worker;
+        std::vector<DukValue> _snapshotCallbacks;
+
+    public:
+        ScWorker(ScriptWorker& worker)
+            : _worker(worker)
+        {
+        }
+
+        const std::vector<DukValue>& GetSnapshotCallbacks() const
+        {
+            return _snapshotCallbacks;
+        }
+
+        void ClearCallbacks()
+        {
+            _snapshotCallbacks.clear();
+        }
+
+        void onSnapshot(const DukValue& callback)
+        {
+            if (!callback.is_function())
+            {
+                duk_error(callback.context(), DUK_ERR_ERROR, "Expected function for callback");
+            }
+            _snapshotCallbacks.push_back(callback);
+        }
+
+        void postAction(const std::string& action, const DukValue& args)
+        {
+            // Serialised the same way as a custom action executed by a plugin on the game thread
+            auto ctx = args.context();
+            if (args.type() == DukValue::Type::OBJECT)
+            {
+                args.push();
+            }
+            else
+            {
+                duk_push_object(ctx);
+            }
+            auto json = std::string(duk_json_encode(ctx, -1));
+            duk_pop(ctx);
+            _worker.PostAction(action, std::move(json));
+        }
+
+        duk_ret_t log(duk_context* ctx)
+        {
+            std::string line;
+            auto nargs = duk_get_top(ctx);
+            for (duk_idx_t i = 0; i < nargs; i++)
+            {
+                auto arg = DukValue::copy_from_stack(ctx, i);
+                if (i != 0)
+                {
+                    line.push_back(' ');
+                }
+                line += Stringify(arg);
+            }
+            _worker.Log(std::move(line));
+            return 0;
+        }
+
+        static void Register(duk_context* ctx)
+        {
+            dukglue_register_method(ctx, &ScWorker::onSnapshot, "onSnapshot");
+            dukglue_register_method(ctx, &ScWorker::postAction, "postAction");
+            dukglue_register_method_varargs(ctx, &ScWorker::log, "log");
+        }
+    };
+} // namespace OpenRCT2::Scripting
+
+template<typename T>
+static T* PushTypedArray(duk_context* ctx, duk_idx_t objIdx, const char* name, size_t count, duk_uint_t type)
+{
+    auto length = count * sizeof(T);
+    auto data = static_cast<T*>(duk_push_fixed_buffer(ctx, length));
+    duk_push_buffer_object(ctx, -1, 0, length, type);
+    duk_put_prop_string(ctx, objIdx, name);
+    duk_pop(ctx);
+    return data;
+}
+
+static void PushGuests(duk_context* ctx, const std::vector<WorkerSnapshot::Guest>& guests)
+{
+    auto count = guests.size();
+    auto objIdx = duk_push_object(ctx);
+    duk_push_uint(ctx, static_cast<duk_uint_t>(count));
+    duk_put_prop_string(ctx, objIdx, "count");
+    auto ids = PushTypedArray<uint16_t>(ctx, objIdx, "id", count, DUK_BUFOBJ_UINT16ARRAY);
+    auto x = PushTypedArray<int32_t>(ctx, objIdx, "x", count, DUK_BUFOBJ_INT32ARRAY);
+    auto y = PushTypedArray<int32_t>(ctx, objIdx, "y", count, DUK_BUFOBJ_INT32ARRAY);
+    auto z = PushTypedArray<int32_t>(ctx, objIdx, "z", count, DUK_BUFOBJ_INT32ARRAY);
+    auto happiness = PushTypedArray<uint8_t>(ctx, objIdx, "happiness", count, DUK_BUFOBJ_UINT8ARRAY);
+    auto energy = PushTypedArray<uint8_t>(ctx, objIdx, "energy", count, DUK_BUFOBJ_UINT8ARRAY);
+    auto nausea = PushTypedArray<uint8_t>(ctx, objIdx, "nausea", count, DUK_BUFOBJ_UINT8ARRAY);
+    auto hunger = PushTypedArray<uint8_t>(ctx, objIdx, "hunger", count, DUK_BUFOBJ_UINT8ARRAY);
+    auto thirst = PushTypedArray<uint8_t>(ctx, objIdx, "thirst", count, DUK_BUFOBJ_UINT8ARRAY);
+    auto toilet = PushTypedArray<uint8_t>(ctx, objIdx, "toilet", count, DUK_BUFOBJ_UINT8ARRAY);
+    auto cash = PushTypedArray<int32_t>(ctx, objIdx, "cash", count, DUK_BUFOBJ_INT32ARRAY);
+    for (size_t i = 0; i < count; i++)
+    {
+        const auto& guest = guests[i];
+        ids[i] = guest.Id;
+        x[i] = guest.X;
+        y[i] = guest.Y;
+        z[i] = guest.Z;
+        happiness[i] = guest.Happiness;
+        energy[i] = guest.Energy;
+        nausea[i] = guest.Nausea;
+        hunger[i] = guest.Hunger;
+        thirst[i] = guest.Thirst;
+        toilet[i] = guest.Toilet;
+        cash[i] = guest.Cash;
+    }
+}
+
+static void PushSnapshot(duk_context* ctx, const WorkerSnapshot& snapshot)
+{
+    auto objIdx = duk_push_object(ctx);
+    duk_push_uint(ctx, snapshot.Tick);
+    duk_put_prop_string(ctx, objIdx, "tick");
+    duk_push_int(ctx, snapshot.MonthsElapsed);
+    duk_put_prop_string(ctx, objIdx, "monthsElapsed");
+
+    auto parkIdx = duk_push_object(ctx);
+    duk_push_int(ctx, snapshot.Cash);
+    duk_put_prop_string(ctx, parkIdx, "cash");
+    duk_push_int(ctx, snapshot.ParkValue);
+    duk_put_prop_string(ctx, parkIdx, "value");
+    duk_push_int(ctx, snapshot.CompanyValue);
+    duk_put_prop_string(ctx, parkIdx, "companyValue");
+    duk_push_uint(ctx, snapshot.ParkRating);
+    duk_put_prop_string(ctx, parkIdx, "rating");
+    duk_put_prop_string(ctx, objIdx, "park");
+
+    PushGuests(ctx, snapshot.Guests);
+    duk_put_prop_string(ctx, objIdx, "guests");
+}
+
+WorkerSnapshot WorkerSnapshot::Capture()
+{
+    WorkerSnapshot snapshot;
+    snapshot.Tick = gCurrentTicks;
+    snapshot.MonthsElapsed = gDateMonthsElapsed;
+    snapshot.Cash = gCash;
+    snapshot.ParkValue = gParkValue;
+    snapshot.CompanyValue = gCompanyValue;
+    snapshot.ParkRating = gParkRating;
+
+    snapshot.Guests.reserve(GetEntityListCount(EntityType::Guest));
+    for (auto guest : EntityList<::Guest>())
+    {
+        snapshot.Guests.push_back({ guest->sprite_index, guest->x, guest->y, guest->z, guest->Happiness, guest->Energy,
+                                    guest->Nausea, guest->Hunger, guest->Thirst, guest->Toilet, guest->CashInPocket });
+    }
+    return snapshot;
+}
+
+ScriptWorker::ScriptWorker(std::string code)
+    : _code(std::move(code))
+{
+}
+
+ScriptWorker::~ScriptWorker()
+{
+    Stop();
+}
+
+void ScriptWorker::Start()
+{
+    _thread = std::thread([this]() { Run(); });
+}
+
+void ScriptWorker::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopRequested = true;
+    }
+    _snapshotReady.notify_one();
+
+    // This waits for the script to return, a worker stuck in a loop also blocks the game from closing
+    if (_thread.joinable())
+    {
+        _thread.join();
+    }
+}
+
+void ScriptWorker::PostSnapshot(std::shared_ptr<const WorkerSnapshot> snapshot)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _snapshot = std::move(snapshot);
+    }
+    _snapshotReady.notify_one();
+}
+
+std::vector<WorkerAction> ScriptWorker::TakeActions()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return std::move(_actions);
+}
+
+std::vector<std::string> ScriptWorker::TakeMessages()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return std::move(_messages);
+}
+
+void ScriptWorker::PostAction(std::string id, std::string json)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _actions.push_back({ std::move(id), std::move(json) });
+}
+
+void ScriptWorker::Log(std::string message)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _messages.push_back(std::move(message));
+}
+
+bool ScriptWorker::WaitForSnapshot(std::shared_ptr<const WorkerSnapshot>& snapshot)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _snapshotReady.wait(lock, [this]() { return _stopRequested || _snapshot != nullptr; });
+    if (_stopRequested)
+        return false;
+
+    snapshot = std::move(_snapshot);
+    _snapshot = nullptr;
+    return true;
+}
+
+static bool RunWorkerMain(duk_context* ctx, const std::string& script, std::string& error)
+{
+    // The same wrapper as Plugin::Load, but only the worker global can be used
+    // clang-format off
+    auto code =
+        "     (function(worker) {"
+        "         var __metadata__ = null;"
+        "         var registerPlugin = function(m) { __metadata__ = m };"
+        "         (function(__metadata__) {"
+                      + script +
+        "         })();"
+        "         return __metadata__;"
+        "     })(worker);";
+    // clang-format on
+
+    auto flags = DUK_COMPILE_EVAL | DUK_COMPILE_SAFE | DUK_COMPILE_NOSOURCE | DUK_COMPILE_NOFILENAME;
+    if (duk_eval_raw(ctx, code.c_str(), code.size(), flags) != DUK_ERR_NONE)
+    {
+        error = "Failed to load worker script: " + std::string(duk_safe_to_string(ctx, -1));
+        duk_pop(ctx);
+        return false;
+    }
+
+    auto metadata = DukValue::take_from_stack(ctx);
+    if (metadata.type() != DukValue::Type::OBJECT || !metadata["main"].is_function())
+    {
+        error = "No main function specified.";
+        return false;
+    }
+
+    metadata["main"].push();
+    if (duk_pcall(ctx, 0) != DUK_EXEC_SUCCESS)
+    {
+        error = std::string(duk_safe_to_string(ctx, -1));
+        duk_pop(ctx);
+        return false;
+    }
+    duk_pop(ctx);
+    return true;
+}
+
+void ScriptWorker::Run()
+{
+    try
+    {
+        DukContext context;
+        duk_context* ctx = context;
+        ScWorker::Register(ctx);
+
+        // The callbacks have to be released before the heap is destroyed
+        auto worker = std::make_shared<ScWorker>(*this);
+        dukglue_register_global(ctx, worker, "worker");
+
+        std::string error;
+        if (RunWorkerMain(ctx, _code, error))
+        {
+            std::shared_ptr<const WorkerSnapshot> snapshot;
+            while (WaitForSnapshot(snapshot))
+            {
+                PushSnapshot(ctx, *snapshot);
+                auto dukSnapshot = DukValue::take_from_stack(ctx);
+
+                // A callback can subscribe more callbacks
+                auto callbacks = worker->GetSnapshotCallbacks();
+                for (const auto& callback : callbacks)
+                {
+                    callback.push();
+                    dukSnapshot.push();
+                    if (duk_pcall(ctx, 1) != DUK_EXEC_SUCCESS)
+                    {
+                        Log(duk_safe_to_string(ctx, -1));
+                    }
+                    duk_pop(ctx);
+                }
+            }
+        }
+        else
+        {
+            Log(std::move(error));
+        }
+        worker->ClearCallbacks();
+    }
+    catch (const std::exception& e)
+    {
+        Log(e.what());
+    }
+}
+
+#endif
@@ -0,0 +1,107 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#ifdef ENABLE_SCRIPTING
+
+#    include "../common.h"
+
+#    include <condition_variable>
+#    include <memory>
+#    include <mutex>
+#    include <string>
+#    include <thread>
+#    include <vector>
+
+namespace OpenRCT2::Scripting
+{
+    /**
+     * Copy of the park state handed to worker plugins, it is never modified once captured so it can be
+     * shared between the workers.
+     */
+    struct WorkerSnapshot
+    {
+        struct Guest
+        {
+            uint16_t Id;
+            int32_t X;
+            int32_t Y;
+            int32_t Z;
+            uint8_t Happiness;
+            uint8_t Energy;
+            uint8_t Nausea;
+            uint8_t Hunger;
+            uint8_t Thirst;
+            uint8_t Toilet;
+            money32 Cash;
+        };
+
+        uint32_t Tick{};
+        int32_t MonthsElapsed{};
+        money32 Cash{};
+        money32 ParkValue{};
+        money32 CompanyValue{};
+        uint16_t ParkRating{};
+        std::vector<Guest> Guests;
+
+        /**
+         * Copies the state of the park currently loaded, must be called on the game thread.
+         */
+        static WorkerSnapshot Capture();
+    };
+
+    struct WorkerAction
+    {
+        std::string Id;
+        std::string Json;
+    };
+
+    /**
+     * Runs the main function of a worker plugin in its own Duktape heap on a separate thread. A worker has
+     * no access to the game, it is sent snapshots of the park and can only change it by posting custom
+     * actions, which the game thread executes.
+     */
+    class ScriptWorker
+    {
+    private:
+        std::string _code;
+        std::thread _thread;
+
+        std::mutex _mutex;
+        std::condition_variable _snapshotReady;
+        // Only the latest snapshot is kept, a worker that can not keep up skips the older ones
+        std::shared_ptr<const WorkerSnapshot> _snapshot;
+        std::vector<WorkerAction> _actions;
+        std::vector<std::string> _messages;
+        bool _stopRequested{};
+
+    public:
+        explicit ScriptWorker(std::string code);
+        ScriptWorker(const ScriptWorker&) = delete;
+        ~ScriptWorker();
+
+        void Start();
+        void Stop();
+
+        void PostSnapshot(std::shared_ptr<const WorkerSnapshot> snapshot);
+        std::vector<WorkerAction> TakeActions();
+        std::vector<std::string> TakeMessages();
+
+        // Called on the thread of the worker
+        void PostAction(std::string id, std::string json);
+        void Log(std::string message);
+
+    private:
+        void Run();
+        bool WaitForSnapshot(std::shared_ptr<const WorkerSnapshot>& snapshot);
+    };
+} // namespace OpenRCT2::Scripting
+
+#endif
@@ -43,10 +43,12 @@ namespace TitleSequenceManager
     };
 
     static std::vector<TitleSequenceManagerItem> _items;
+    static bool _scanned = false;
 
     static std::string GetNewTitleSequencePath(const std::string& name, bool isZip);
     static size_t FindItemIndexByPath(const std::string& path);
     static void Scan(const std::string& directory);
+    static void EnsureScanned();
     static void AddSequence(const std::string& scanPath);
     static void SortSequences();
     static std::string GetNameFromSequencePath(const std::string& path);
@@ -56,11 +58,13 @@ namespace TitleSequenceManager
 
     size_t GetCount()
     {
+        EnsureScanned();
         return _items.size();
     }
 
     const TitleSequenceManagerItem* GetItem(size_t i)
     {
+        EnsureScanned();
         if (i >= _items.size())
         {
             return nullptr;
@@ -196,6 +200,7 @@ namespace TitleSequenceManager
     void Scan()
     {
         _items.clear();
+        _scanned = true;
 
         // Scan data path
         Scan(GetDataSequencesPath());
@@ -206,6 +211,15 @@ namespace TitleSequenceManager
         SortSequences();
     }
 
+    static void EnsureScanned()
+    {
+        // The sequences are not scanned during startup with --fast-start
+        if (!_scanned)
+        {
+            Scan();
+        }
+    }
+
     static void Scan(const std::string& directory)
     {
         auto pattern = Path::Combine(directory, "script.txt;*.parkseq");
@@ -23,7 +23,7 @@ static size_t encode_chunk_rle(const uint8_t* src_buffer, uint8_t* dst_buffer, s
 static size_t encode_chunk_repeat(const uint8_t* src_buffer, uint8_t* dst_buffer, size_t length);
 static void encode_chunk_rotate(uint8_t* buffer, size_t length);
 
-bool gUseRLE = true;
+thread_local bool gUseRLE = true;
 
 uint32_t sawyercoding_calculate_checksum(const uint8_t* buffer, size_t length)
 {
@@ -258,6 +258,79 @@ static size_t decode_chunk_rle_with_size(const uint8_t* src_buffer, uint8_t* dst
 
 #pragma region Encoding
 
+/**
+ * Returns how many bytes at the start of a and b are equal, up to maxLength. Eight bytes are
+ * compared at a time, the first byte that differs is the lowest set byte of their xor as the game
+ * only runs on little endian.
+ */
+static size_t get_match_length(const uint8_t* a, const uint8_t* b, size_t maxLength)
+{
+    size_t length = 0;
+    for (; length + sizeof(uint64_t) <= maxLength; length += sizeof(uint64_t))
+    {
+        uint64_t wordA, wordB;
+        std::memcpy(&wordA, a + length, sizeof(wordA));
+        std::memcpy(&wordB, b + length, sizeof(wordB));
+        auto diff = wordA ^ wordB;
+        if (diff != 0)
+        {
+            return length + bitscanforward(static_cast<int64_t>(diff)) / 8;
+        }
+    }
+    while (length < maxLength && a[length] == b[length])
+    {
+        length++;
+    }
+    return length;
+}
+
+/**
+ * Returns a mask of which of the 32 bytes starting at src are equal to value, bit n is set when
+ * src[n] is.
+ */
+static uint32_t get_equal_byte_mask(const uint8_t* src, uint8_t value)
+{
+    constexpr uint64_t lowBits = 0x7F7F7F7F7F7F7F7FULL;
+    const uint64_t pattern = 0x0101010101010101ULL * value;
+    uint32_t mask = 0;
+    for (size_t i = 0; i < 4; i++)
+    {
+        uint64_t word;
+        std::memcpy(&word, src + i * sizeof(word), sizeof(word));
+        auto diff = word ^ pattern;
+
+        // Set the top bit of every byte that is zero in diff, then gather those bits into the low byte
+        auto zeroBytes = ~(((diff & lowBits) + lowBits) | diff | lowBits);
+        auto byteMask = ((zeroBytes >> 7) * 0x0102040810204080ULL) >> 56;
+        mask |= static_cast<uint32_t>(byteMask) << (i * 8);
+    }
+    return mask;
+}
+
+/**
+ * Returns how many bytes starting at src are equal to the first one, up to maxLength.
+ */
+static size_t get_run_length(const uint8_t* src, size_t maxLength)
+{
+    const uint64_t pattern = 0x0101010101010101ULL * src[0];
+    size_t length = 0;
+    for (; length + sizeof(uint64_t) <= maxLength; length += sizeof(uint64_t))
+    {
+        uint64_t word;
+        std::memcpy(&word, src + length, sizeof(word));
+        auto diff = word ^ pattern;
+        if (diff != 0)
+        {
+            return length + bitscanforward(static_cast<int64_t>(diff)) / 8;
+        }
+    }
+    while (length < maxLength && src[length] == src[0])
+    {
+        length++;
+    }
+    return length;
+}
+
 /**
  * Ensure dst_buffer is bigger than src_buffer then resize afterwards
  * returns length of dst_buffer
@@ -282,11 +355,7 @@ static size_t encode_chunk_rle(const uint8_t* src_buffer, uint8_t* dst_buffer, s
         }
         if (*src == src[1])
         {
-            for (; (count < 125) && ((src + count) < end_src); count++)
-            {
-                if (*src != src[count])
-                    break;
-            }
+            count = static_cast<uint8_t>(get_run_length(src, std::min<size_t>(125, end_src - src)));
             *dst++ = 257 - count;
             *dst++ = *src;
             src += count;
@@ -330,31 +399,39 @@ static size_t encode_chunk_repeat(const uint8_t* src_buffer, uint8_t* dst_buffer
 
         size_t bestRepeatIndex = 0;
         size_t bestRepeatCount = 0;
-        for (size_t repeatIndex = searchIndex; repeatIndex <= searchEnd; repeatIndex++)
-        {
-            size_t repeatCount = 0;
+        auto tryRepeat = [&](size_t repeatIndex) {
             size_t maxRepeatCount = std::min(std::min(static_cast<size_t>(7), searchEnd - repeatIndex), length - i - 1);
             // maxRepeatCount should not exceed length
             assert(repeatIndex + maxRepeatCount < length);
             assert(i + maxRepeatCount < length);
-            for (size_t j = 0; j <= maxRepeatCount; j++)
-            {
-                if (src_buffer[repeatIndex + j] == src_buffer[i + j])
-                {
-                    repeatCount++;
-                }
-                else
-                {
-                    break;
-                }
-            }
+            size_t repeatCount = get_match_length(src_buffer + repeatIndex, src_buffer + i, maxRepeatCount + 1);
             if (repeatCount > bestRepeatCount)
             {
                 bestRepeatIndex = repeatIndex;
                 bestRepeatCount = repeatCount;
+            }
+
+            // Maximum repeat count is 8
+            return repeatCount == 8;
+        };
 
-                // Maximum repeat count is 8
-                if (repeatCount == 8)
+        if (searchEnd - searchIndex + 1 == 32)
+        {
+            // Only positions that start with the same byte can repeat, visit them in the same order
+            auto candidates = get_equal_byte_mask(src_buffer + searchIndex, src_buffer[i]);
+            while (candidates != 0)
+            {
+                auto repeatIndex = searchIndex + bitscanforward(static_cast<int64_t>(candidates));
+                candidates &= candidates - 1;
+                if (tryRepeat(repeatIndex))
+                    break;
+            }
+        }
+        else
+        {
+            for (size_t repeatIndex = searchIndex; repeatIndex <= searchEnd; repeatIndex++)
+            {
+                if (tryRepeat(repeatIndex))
                     break;
             }
         }
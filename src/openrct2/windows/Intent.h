@@ -75,6 +75,7 @@ enum
     INTENT_EXTRA_PAGE,
     INTENT_EXTRA_BANNER_INDEX,
     INTENT_EXTRA_FORMATTER,
+    INTENT_EXTRA_TILE_CHANGES,
 };
 
 enum
@@ -107,4 +108,5 @@ enum
     INTENT_ACTION_TRACK_DESIGN_REMOVE_PROVISIONAL,
     INTENT_ACTION_TRACK_DESIGN_RESTORE_PROVISIONAL,
     INTENT_ACTION_SET_MAP_TOOLTIP,
+    INTENT_ACTION_MAP_TILES_CHANGED,
 };
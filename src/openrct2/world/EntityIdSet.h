@@ -0,0 +1,156 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "../util/Util.h"
+#include "Entity.h"
+
+#include <array>
+#include <iterator>
+
+/**
+ * Set of entity ids backed by a bitmap over all entity slots. Insert and remove are O(1) and
+ * iteration always visits ids in ascending order which keeps the game state deterministic.
+ * Iterators look up the next id in the live bitmap, so removing the current id or adding ids
+ * while iterating is safe, in the same way it was for the linked lists this replaces.
+ */
+class EntityIdSet
+{
+private:
+    static constexpr size_t BlockBits = 64;
+    static constexpr size_t BlockCount = (MAX_ENTITIES + BlockBits - 1) / BlockBits;
+
+    std::array<uint64_t, BlockCount> _blocks{};
+    uint16_t _count{};
+
+public:
+    class const_iterator
+    {
+    private:
+        const EntityIdSet* _set;
+        uint16_t _id;
+
+    public:
+        const_iterator(const EntityIdSet* set, uint16_t id)
+            : _set(set)
+            , _id(id)
+        {
+        }
+        const_iterator& operator++()
+        {
+            _id = _set->FindNext(_id + 1);
+            return *this;
+        }
+        const_iterator operator++(int)
+        {
+            const_iterator retval = *this;
+            ++(*this);
+            return retval;
+        }
+        bool operator==(const const_iterator& other) const
+        {
+            return _id == other._id;
+        }
+        bool operator!=(const const_iterator& other) const
+        {
+            return !(*this == other);
+        }
+        uint16_t operator*() const
+        {
+            return _id;
+        }
+        // iterator traits
+        using difference_type = std::ptrdiff_t;
+        using value_type = uint16_t;
+        using pointer = const uint16_t*;
+        using reference = const uint16_t&;
+        using iterator_category = std::forward_iterator_tag;
+    };
+
+    bool insert(uint16_t id)
+    {
+        auto& block = _blocks[id / BlockBits];
+        const auto mask = 1ULL << (id % BlockBits);
+        if (block & mask)
+            return false;
+
+        block |= mask;
+        _count++;
+        return true;
+    }
+
+    bool erase(uint16_t id)
+    {
+        auto& block = _blocks[id / BlockBits];
+        const auto mask = 1ULL << (id % BlockBits);
+        if (!(block & mask))
+            return false;
+
+        block &= ~mask;
+        _count--;
+        return true;
+    }
+
+    bool contains(uint16_t id) const
+    {
+        return id < MAX_ENTITIES && (_blocks[id / BlockBits] & (1ULL << (id % BlockBits))) != 0;
+    }
+
+    void clear()
+    {
+        _blocks.fill(0);
+        _count = 0;
+    }
+
+    size_t size() const
+    {
+        return _count;
+    }
+
+    bool empty() const
+    {
+        return _count == 0;
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(this, FindNext(0));
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(this, SPRITE_INDEX_NULL);
+    }
+
+    /**
+     * Returns the lowest id in the set that is equal to or greater than from, or SPRITE_INDEX_NULL.
+     */
+    uint16_t FindNext(size_t from) const
+    {
+        if (_count == 0)
+            return SPRITE_INDEX_NULL;
+
+        for (auto blockIndex = from / BlockBits; blockIndex < BlockCount; blockIndex++)
+        {
+            auto block = _blocks[blockIndex];
+            if (blockIndex == from / BlockBits)
+            {
+                // Mask off the ids below from in the first block.
+                block &= ~0ULL << (from % BlockBits);
+            }
+            if (block != 0)
+            {
+                return static_cast<uint16_t>(blockIndex * BlockBits + bitscanforward(static_cast<int64_t>(block)));
+            }
+        }
+        return SPRITE_INDEX_NULL;
+    }
+};
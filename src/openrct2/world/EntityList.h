@@ -12,10 +12,13 @@
 #include "../common.h"
 #include "../rct12/RCT12.h"
 #include "Entity.h"
+#include "EntityIdSet.h"
+#include "EntitySpatialIndex.h"
 #include "Location.hpp"
 #include "SpriteBase.h"
 
-#include <list>
+#include <algorithm>
+#include <utility>
 #include <vector>
 
 enum class EntityListId : uint8_t
@@ -23,24 +26,24 @@ enum class EntityListId : uint8_t
     Count = 6,
 };
 
-const std::list<uint16_t>& GetEntityList(const EntityType id);
+const EntityIdSet& GetEntityList(const EntityType id);
 
 uint16_t GetEntityListCount(EntityType list);
 uint16_t GetMiscEntityCount();
 uint16_t GetNumFreeEntities();
-const std::vector<uint16_t>& GetEntityTileList(const CoordsXY& spritePos);
+const EntitySpatialIndex& GetEntitySpatialIndex();
 
 template<typename T> class EntityTileIterator
 {
 private:
-    std::vector<uint16_t>::const_iterator iter;
-    std::vector<uint16_t>::const_iterator end;
+    const EntitySpatialIndex* index;
+    uint16_t nextId;
     T* Entity = nullptr;
 
 public:
-    EntityTileIterator(std::vector<uint16_t>::const_iterator _iter, std::vector<uint16_t>::const_iterator _end)
-        : iter(_iter)
-        , end(_end)
+    EntityTileIterator(const EntitySpatialIndex* _index, uint16_t _first)
+        : index(_index)
+        , nextId(_first)
     {
         ++(*this);
     }
@@ -48,9 +51,11 @@ public:
     {
         Entity = nullptr;
 
-        while (iter != end && Entity == nullptr)
+        while (nextId != SPRITE_INDEX_NULL && Entity == nullptr)
         {
-            Entity = GetEntity<T>(*iter++);
+            auto id = nextId;
+            nextId = index->GetNext(id);
+            Entity = GetEntity<T>(id);
         }
         return *this;
     }
@@ -59,7 +64,7 @@ public:
     {
         EntityTileIterator retval = *this;
         ++(*this);
-        return *iter;
+        return retval;
     }
     bool operator==(EntityTileIterator other) const
     {
@@ -84,33 +89,74 @@ public:
 template<typename T = SpriteBase> class EntityTileList
 {
 private:
-    const std::vector<uint16_t>& vec;
+    const EntitySpatialIndex& index;
+    uint16_t first;
 
 public:
     EntityTileList(const CoordsXY& loc)
-        : vec(GetEntityTileList(loc))
+        : index(GetEntitySpatialIndex())
+        , first(index.GetFirst(EntitySpatialIndex::GetCellIndex(loc.x, loc.y)))
     {
     }
 
     EntityTileIterator<T> begin()
     {
-        return EntityTileIterator<T>(std::begin(vec), std::end(vec));
+        return EntityTileIterator<T>(&index, first);
     }
     EntityTileIterator<T> end()
     {
-        return EntityTileIterator<T>(std::end(vec), std::end(vec));
+        return EntityTileIterator<T>(&index, SPRITE_INDEX_NULL);
     }
 };
 
+/**
+ * Visits the entities on the tiles between mins and maxs inclusive, clamped to the map, a column of tiles at a time. Use
+ * RideSpatialIndexQuery for the rides on an area and TileElementsView for the elements of each tile.
+ */
+template<typename T = SpriteBase, typename TFunc>
+void ForEachEntityInTileRange(const TileCoordsXY& mins, const TileCoordsXY& maxs, TFunc&& func)
+{
+    const auto& index = GetEntitySpatialIndex();
+    const auto minX = std::max(mins.x, 0);
+    const auto minY = std::max(mins.y, 0);
+    const auto maxX = std::min(maxs.x, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+    const auto maxY = std::min(maxs.y, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+    for (int32_t x = minX; x <= maxX; x++)
+    {
+        for (int32_t y = minY; y <= maxY; y++)
+        {
+            const auto cell = EntitySpatialIndex::GetCellIndex(x * COORDS_XY_STEP, y * COORDS_XY_STEP);
+            for (auto id = index.GetFirst(cell); id != SPRITE_INDEX_NULL; id = index.GetNext(id))
+            {
+                auto* entity = GetEntity<T>(id);
+                if (entity != nullptr)
+                {
+                    func(entity);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Visits the entities on the tiles that have any part within range of loc on either axis.
+ */
+template<typename T = SpriteBase, typename TFunc> void ForEachEntityInRange(const CoordsXY& loc, int32_t range, TFunc&& func)
+{
+    ForEachEntityInTileRange<T>(
+        TileCoordsXY(CoordsXY{ std::max(loc.x - range, 0), std::max(loc.y - range, 0) }),
+        TileCoordsXY(CoordsXY{ loc.x + range, loc.y + range }), std::forward<TFunc>(func));
+}
+
 template<typename T> class EntityListIterator
 {
 private:
-    std::list<uint16_t>::const_iterator iter;
-    std::list<uint16_t>::const_iterator end;
+    EntityIdSet::const_iterator iter;
+    EntityIdSet::const_iterator end;
     T* Entity = nullptr;
 
 public:
-    EntityListIterator(std::list<uint16_t>::const_iterator _iter, std::list<uint16_t>::const_iterator _end)
+    EntityListIterator(EntityIdSet::const_iterator _iter, EntityIdSet::const_iterator _end)
         : iter(_iter)
         , end(_end)
     {
@@ -157,7 +203,7 @@ template<typename T = SpriteBase> class EntityList
 {
 private:
     using EntityListIterator_t = EntityListIterator<T>;
-    const std::list<uint16_t>& vec;
+    const EntityIdSet& vec;
 
 public:
     EntityList()
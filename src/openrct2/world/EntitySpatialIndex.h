@@ -0,0 +1,148 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "Entity.h"
+#include "Map.h"
+
+#include <array>
+
+constexpr const uint32_t SPATIAL_INDEX_SIZE = (MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL) + 1;
+constexpr const uint32_t SPATIAL_INDEX_LOCATION_NULL = SPATIAL_INDEX_SIZE - 1;
+
+/**
+ * Tile to entity lookup stored in a few flat arrays instead of one heap allocated vector per tile.
+ * Every tile has the head of an intrusive chain through the entity slots, chains are kept in
+ * sprite_index order so iteration order never depends on the order entities moved in. An
+ * occupancy bitmap allows tile scans to skip empty tiles without touching the chain heads.
+ */
+class EntitySpatialIndex
+{
+private:
+    static constexpr size_t BlockBits = 64;
+
+    std::array<uint16_t, SPATIAL_INDEX_SIZE> _cellHead;
+    std::array<uint32_t, MAX_ENTITIES> _entityCell;
+    std::array<uint16_t, MAX_ENTITIES> _next;
+    std::array<uint16_t, MAX_ENTITIES> _prev;
+    std::array<uint64_t, (SPATIAL_INDEX_SIZE + BlockBits - 1) / BlockBits> _occupied;
+
+public:
+    EntitySpatialIndex()
+    {
+        Clear();
+    }
+
+    static constexpr size_t GetCellIndex(int32_t x, int32_t y)
+    {
+        size_t index = SPATIAL_INDEX_LOCATION_NULL;
+        if (x != LOCATION_NULL)
+        {
+            x = std::clamp(x, 0, 0xFFFF);
+            y = std::clamp(y, 0, 0xFFFF);
+
+            int16_t flooredX = floor2(x, 32);
+            uint8_t tileY = y >> 5;
+            index = (flooredX << 3) | tileY;
+        }
+
+        if (index >= SPATIAL_INDEX_SIZE)
+        {
+            return SPATIAL_INDEX_LOCATION_NULL;
+        }
+        return index;
+    }
+
+    void Clear()
+    {
+        _cellHead.fill(SPRITE_INDEX_NULL);
+        _entityCell.fill(SPATIAL_INDEX_SIZE);
+        _next.fill(SPRITE_INDEX_NULL);
+        _prev.fill(SPRITE_INDEX_NULL);
+        _occupied.fill(0);
+    }
+
+    bool Contains(uint16_t id) const
+    {
+        return _entityCell[id] != SPATIAL_INDEX_SIZE;
+    }
+
+    size_t GetEntityCell(uint16_t id) const
+    {
+        return _entityCell[id];
+    }
+
+    void Insert(uint16_t id, size_t cell)
+    {
+        if (Contains(id))
+        {
+            Remove(id);
+        }
+
+        // Find the last entity in the chain with a lower index, chains are short for anything but the null cell.
+        uint16_t prev = SPRITE_INDEX_NULL;
+        uint16_t next = _cellHead[cell];
+        while (next != SPRITE_INDEX_NULL && next < id)
+        {
+            prev = next;
+            next = _next[next];
+        }
+
+        _prev[id] = prev;
+        _next[id] = next;
+        if (prev == SPRITE_INDEX_NULL)
+            _cellHead[cell] = id;
+        else
+            _next[prev] = id;
+        if (next != SPRITE_INDEX_NULL)
+            _prev[next] = id;
+
+        _entityCell[id] = static_cast<uint32_t>(cell);
+        _occupied[cell / BlockBits] |= 1ULL << (cell % BlockBits);
+    }
+
+    void Remove(uint16_t id)
+    {
+        const auto cell = _entityCell[id];
+        const auto prev = _prev[id];
+        const auto next = _next[id];
+        if (prev == SPRITE_INDEX_NULL)
+            _cellHead[cell] = next;
+        else
+            _next[prev] = next;
+        if (next != SPRITE_INDEX_NULL)
+            _prev[next] = prev;
+
+        if (_cellHead[cell] == SPRITE_INDEX_NULL)
+        {
+            _occupied[cell / BlockBits] &= ~(1ULL << (cell % BlockBits));
+        }
+
+        _entityCell[id] = SPATIAL_INDEX_SIZE;
+        _next[id] = SPRITE_INDEX_NULL;
+        _prev[id] = SPRITE_INDEX_NULL;
+    }
+
+    bool IsOccupied(size_t cell) const
+    {
+        return (_occupied[cell / BlockBits] & (1ULL << (cell % BlockBits))) != 0;
+    }
+
+    uint16_t GetFirst(size_t cell) const
+    {
+        return IsOccupied(cell) ? _cellHead[cell] : SPRITE_INDEX_NULL;
+    }
+
+    uint16_t GetNext(uint16_t id) const
+    {
+        return _next[id];
+    }
+};
@@ -23,6 +23,7 @@
 #include "../object/ObjectList.h"
 #include "../object/ObjectManager.h"
 #include "../paint/VirtualFloor.h"
+#include "../peep/GuestPathfinding.h"
 #include "../ride/RideData.h"
 #include "../ride/Station.h"
 #include "../ride/Track.h"
@@ -34,6 +35,7 @@
 #include "Park.h"
 #include "Sprite.h"
 #include "Surface.h"
+#include "TileElementsView.h"
 
 #include <algorithm>
 #include <iterator>
@@ -1199,6 +1201,13 @@ void footpath_queue_chain_push(ride_id_t rideIndex)
 {
     if (rideIndex != RIDE_ID_NULL)
     {
+        // The connection functions push the ride of every edge they touch. Walking the queues of a ride twice in a row
+        // gives the same result as walking them once, so only the first of these is kept.
+        if (_footpathQueueChainNext > _footpathQueueChain && *(_footpathQueueChainNext - 1) == rideIndex)
+        {
+            return;
+        }
+
         uint8_t* lastSlot = _footpathQueueChain + std::size(_footpathQueueChain) - 1;
         if (_footpathQueueChainNext <= lastSlot)
         {
@@ -1721,6 +1730,27 @@ static void footpath_clear_wide(const CoordsXY& footpathPos)
     } while (!(tileElement++)->IsLastForTile());
 }
 
+/**
+ * Returns a mask of the wide flags of the first 32 paths at location.
+ */
+static uint32_t footpath_get_wide_flags(const CoordsXY& footpathPos)
+{
+    uint32_t wideFlags = 0;
+    uint32_t index = 0;
+    TileElement* tileElement = map_get_first_element_at(footpathPos);
+    if (tileElement == nullptr)
+        return wideFlags;
+    do
+    {
+        if (tileElement->GetType() != TILE_ELEMENT_TYPE_PATH)
+            continue;
+        if (index < 32 && tileElement->AsPath()->IsWide())
+            wideFlags |= 1u << index;
+        index++;
+    } while (!(tileElement++)->IsLastForTile());
+    return wideFlags;
+}
+
 /**
  *
  *  rct2: 0x006A8ACF
@@ -1748,6 +1778,8 @@ static TileElement* footpath_can_be_wide(const CoordsXYZ& footpathPos)
     return nullptr;
 }
 
+static void footpath_update_path_wide_flags_at(const CoordsXY& footpathPos);
+
 /**
  *
  *  rct2: 0x006A87BB
@@ -1757,6 +1789,22 @@ void footpath_update_path_wide_flags(const CoordsXY& footpathPos)
     if (map_is_location_at_edge(footpathPos))
         return;
 
+    // Most tiles of the sweep have no paths, which leaves nothing to update.
+    auto pathElements = OpenRCT2::TileElementsView<PathElement>(footpathPos);
+    if (pathElements.begin() == pathElements.end())
+        return;
+
+    // Peeps treat wide paths differently, so shared pathfinding results are dropped when a flag changes.
+    const auto oldWideFlags = footpath_get_wide_flags(footpathPos);
+    footpath_update_path_wide_flags_at(footpathPos);
+    if (footpath_get_wide_flags(footpathPos) != oldWideFlags)
+    {
+        PathfindCacheInvalidate();
+    }
+}
+
+static void footpath_update_path_wide_flags_at(const CoordsXY& footpathPos)
+{
     footpath_clear_wide(footpathPos);
     /* Rather than clearing the wide flag of the following tiles and
      * checking the state of them later, leave them intact and assume
@@ -0,0 +1,215 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "FootpathGraph.h"
+
+#include "../peep/GuestPathfinding.h"
+#include "../util/Util.h"
+#include "Footpath.h"
+#include "Map.h"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+// Longer corridors than the step limit of the pathfinding are never walked to the end.
+static constexpr size_t MaxEdgeLength = 255;
+// Edges are only built on demand, drop them all once the graph gets this big.
+static constexpr size_t MaxEdges = 1 << 16;
+
+static std::unordered_map<uint64_t, FootpathGraphEdge> _edges;
+// Keys of the edges that pass through or end at each tile.
+static std::unordered_map<uint32_t, std::vector<uint64_t>> _tileEdges;
+
+static uint64_t GetEdgeKey(const TileCoordsXYZ& from, Direction direction)
+{
+    return (static_cast<uint64_t>(static_cast<uint16_t>(from.x)) << 32)
+        | (static_cast<uint64_t>(static_cast<uint16_t>(from.y)) << 16)
+        | (static_cast<uint64_t>(static_cast<uint8_t>(from.z)) << 2) | (direction & 3);
+}
+
+static uint32_t GetTileKey(const TileCoordsXY& tile)
+{
+    return (static_cast<uint32_t>(static_cast<uint16_t>(tile.x)) << 16) | static_cast<uint16_t>(tile.y);
+}
+
+/**
+ * Returns the path element of the tile if it is a corridor tile when entered at z in the given
+ * direction, otherwise nullptr.
+ */
+static TileElement* GetCorridorElement(const TileCoordsXYZ& loc, Direction entryDirection)
+{
+    TileElement* tileElement = map_get_first_element_at(loc.ToCoordsXY());
+    if (tileElement == nullptr)
+        return nullptr;
+
+    TileElement* pathElement = nullptr;
+    do
+    {
+        switch (tileElement->GetType())
+        {
+            case TILE_ELEMENT_TYPE_PATH:
+                if (pathElement != nullptr)
+                    return nullptr;
+                pathElement = tileElement;
+                break;
+            case TILE_ELEMENT_TYPE_TRACK:
+            case TILE_ELEMENT_TYPE_ENTRANCE:
+            case TILE_ELEMENT_TYPE_BANNER:
+                return nullptr;
+        }
+    } while (!(tileElement++)->IsLastForTile());
+
+    if (pathElement == nullptr || pathElement->IsGhost() || !IsValidPathZAndDirection(pathElement, loc.z, entryDirection))
+        return nullptr;
+
+    auto path = pathElement->AsPath();
+    if (path->IsWide() || path->IsQueue())
+        return nullptr;
+
+    // The path has to connect back to the tile it is entered from and lead on to exactly one other tile.
+    auto edges = path->GetEdges();
+    if (bitcount(edges) != 2 || !(edges & (1 << direction_reverse(entryDirection))))
+        return nullptr;
+
+    return pathElement;
+}
+
+static bool IsEdgeValid(const FootpathGraphEdge& edge)
+{
+    for (const auto& step : edge.Steps)
+    {
+        if (map_get_first_element_at(step.Location.ToCoordsXY()) != step.FirstElement
+            || std::memcmp(step.Element, &step.ElementCopy, sizeof(TileElement)) != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void BuildEdge(FootpathGraphEdge& edge)
+{
+    auto loc = edge.From;
+    auto direction = edge.FromDirection;
+    while (edge.Steps.size() < MaxEdgeLength)
+    {
+        loc += TileDirectionDelta[direction];
+        if (loc.x == edge.From.x && loc.y == edge.From.y)
+            break;
+
+        auto* pathElement = GetCorridorElement(loc, direction);
+        if (pathElement == nullptr)
+            break;
+
+        auto path = pathElement->AsPath();
+        auto& step = edge.Steps.emplace_back();
+        step.Location = { loc.x, loc.y, pathElement->base_height };
+        step.Exit = bitscanforward(path->GetEdges() & ~(1 << direction_reverse(direction)));
+        step.ExitZ = pathElement->base_height;
+        if (path->IsSloped() && path->GetSlopeDirection() == step.Exit)
+            step.ExitZ += 2;
+        step.FirstElement = map_get_first_element_at(loc.ToCoordsXY());
+        step.Element = pathElement;
+        step.ElementCopy = *pathElement;
+
+        loc.z = step.ExitZ;
+        direction = step.Exit;
+    }
+
+    // Register the tile after the corridor as well, a change there can make the corridor longer.
+    const auto key = GetEdgeKey(edge.From, edge.FromDirection);
+    for (const auto& step : edge.Steps)
+    {
+        _tileEdges[GetTileKey(step.Location)].push_back(key);
+    }
+    _tileEdges[GetTileKey(loc)].push_back(key);
+}
+
+static void RemoveEdge(uint64_t key)
+{
+    auto it = _edges.find(key);
+    if (it == _edges.end())
+        return;
+
+    auto removeKey = [key](const TileCoordsXY& tile) {
+        auto tileIt = _tileEdges.find(GetTileKey(tile));
+        if (tileIt != _tileEdges.end())
+        {
+            auto& keys = tileIt->second;
+            keys.erase(std::remove(keys.begin(), keys.end(), key), keys.end());
+            if (keys.empty())
+                _tileEdges.erase(tileIt);
+        }
+    };
+
+    const auto& edge = it->second;
+    auto direction = edge.FromDirection;
+    auto last = TileCoordsXY{ edge.From.x, edge.From.y };
+    for (const auto& step : edge.Steps)
+    {
+        removeKey(step.Location);
+        last = step.Location;
+        direction = step.Exit;
+    }
+    removeKey(last + TileDirectionDelta[direction]);
+    _edges.erase(it);
+}
+
+const FootpathGraphEdge& FootpathGraphGetEdge(const TileCoordsXYZ& from, Direction direction)
+{
+    const auto key = GetEdgeKey(from, direction);
+    auto it = _edges.find(key);
+    if (it != _edges.end())
+    {
+        if (IsEdgeValid(it->second))
+            return it->second;
+
+        log_verbose("Footpath graph edge from %d,%d,%d direction %d is stale", from.x, from.y, from.z, direction);
+        RemoveEdge(key);
+    }
+
+    if (_edges.size() >= MaxEdges)
+    {
+        FootpathGraphInvalidateAll();
+    }
+
+    auto& edge = _edges[key];
+    edge.From = from;
+    edge.FromDirection = direction;
+    BuildEdge(edge);
+    return edge;
+}
+
+void FootpathGraphInvalidateTile(const CoordsXY& tilePos)
+{
+    if (_edges.empty())
+        return;
+
+    const auto tile = TileCoordsXY{ tilePos };
+    for (int32_t i = -1; i < 4; i++)
+    {
+        auto tileIt = _tileEdges.find(GetTileKey(i == -1 ? tile : tile + TileDirectionDelta[i]));
+        if (tileIt == _tileEdges.end())
+            continue;
+
+        // RemoveEdge updates the list of the tile, so take a copy first.
+        auto keys = tileIt->second;
+        for (auto key : keys)
+        {
+            RemoveEdge(key);
+        }
+    }
+}
+
+void FootpathGraphInvalidateAll()
+{
+    _edges.clear();
+    _tileEdges.clear();
+}
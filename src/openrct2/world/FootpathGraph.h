@@ -0,0 +1,60 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "Location.hpp"
+#include "TileElement.h"
+
+#include <vector>
+
+/**
+ * A tile of a footpath corridor, a non ghost, non wide, non queue path with exactly two edges
+ * and no track, entrance or banner on its tile. Walking through these tiles never offers the
+ * pathfinding a choice, the only way out is the exit edge.
+ */
+struct FootpathGraphStep
+{
+    // Location of the path, z is the base height of the path element.
+    TileCoordsXYZ Location;
+    Direction Exit;
+    // Height the next tile is entered at when leaving through the exit edge.
+    uint8_t ExitZ;
+
+    // Used to detect tile changes that have not been reported to the graph.
+    const TileElement* FirstElement;
+    const TileElement* Element;
+    TileElement ElementCopy;
+};
+
+/**
+ * Edge of the footpath graph, the corridor walked when leaving From in direction FromDirection.
+ * The junction at the end of the edge is the first tile that is not a corridor tile, so the
+ * length of the edge is the number of steps.
+ */
+struct FootpathGraphEdge
+{
+    TileCoordsXYZ From;
+    Direction FromDirection;
+    std::vector<FootpathGraphStep> Steps;
+};
+
+/**
+ * Returns the corridor that is walked when leaving the tile at from in the given direction, built
+ * from the map on first use. The result can be empty but never stale.
+ */
+const FootpathGraphEdge& FootpathGraphGetEdge(const TileCoordsXYZ& from, Direction direction);
+
+/**
+ * Drops the edges through the tile and its neighbours, placing or removing a path changes the
+ * edges of the neighbouring paths as well.
+ */
+void FootpathGraphInvalidateTile(const CoordsXY& tilePos);
+void FootpathGraphInvalidateAll();
@@ -28,6 +28,7 @@
 #include "../audio/audio.h"
 #include "../config/Config.h"
 #include "../core/Guard.hpp"
+#include "../core/TaskScheduler.h"
 #include "../interface/Cursors.h"
 #include "../interface/Window.h"
 #include "../localisation/Date.h"
@@ -36,7 +37,11 @@
 #include "../network/network.h"
 #include "../object/ObjectManager.h"
 #include "../object/TerrainSurfaceObject.h"
+#include "../paint/PaintCache.h"
+#include "../paint/VirtualFloor.h"
+#include "../peep/GuestPathfinding.h"
 #include "../ride/RideData.h"
+#include "../ride/RideSpatialIndex.h"
 #include "../ride/Track.h"
 #include "../ride/TrackData.h"
 #include "../ride/TrackDesign.h"
@@ -46,12 +51,15 @@
 #include "Banner.h"
 #include "Climate.h"
 #include "Footpath.h"
+#include "FootpathGraph.h"
 #include "LargeScenery.h"
 #include "MapAnimation.h"
+#include "MapScan.h"
 #include "Park.h"
 #include "Scenery.h"
 #include "SmallScenery.h"
 #include "Surface.h"
+#include "TileChanges.h"
 #include "TileElementsView.h"
 #include "TileInspector.h"
 #include "Wall.h"
@@ -120,6 +128,9 @@ uint16_t gLandRemainingConstructionSales;
 bool gMapLandRightsUpdateSuccess;
 
 static void clear_elements_at(const CoordsXY& loc);
+
+// Scans over the whole element list are split into chunks of this many elements
+constexpr size_t TILE_ELEMENTS_PER_SCAN_CHUNK = 8192;
 static ScreenCoordsXY translate_3d_to_2d(int32_t rotation, const CoordsXY& pos);
 
 void tile_element_iterator_begin(tile_element_iterator* it)
@@ -211,7 +222,9 @@ void map_set_tile_element(const TileCoordsXY& tilePos, TileElement* elements)
         log_error("Trying to access element outside of range");
         return;
     }
-    gTileElementTilePointers[tilePos.x + tilePos.y * MAXIMUM_MAP_SIZE_TECHNICAL] = elements;
+    auto& tilePointer = gTileElementTilePointers[tilePos.x + tilePos.y * MAXIMUM_MAP_SIZE_TECHNICAL];
+    TileChangesMoveTile(tilePos, tilePointer, elements);
+    tilePointer = elements;
 }
 
 SurfaceElement* map_get_surface_element_at(const CoordsXY& coords)
@@ -248,6 +261,11 @@ BannerElement* map_get_banner_element_at(const CoordsXYZ& bannerPos, uint8_t pos
     return nullptr;
 }
 
+size_t map_get_memory_usage()
+{
+    return sizeof(gTileElements) + sizeof(gTileElementTilePointers);
+}
+
 /**
  *
  *  rct2: 0x0068AB4C
@@ -281,6 +299,9 @@ void map_init(int32_t size)
     gMapSizeMaxXY = size * 32 - 33;
     gMapBaseZ = 7;
     map_update_tile_pointers();
+    TileChangesMarkAll();
+    PaintCacheInvalidateAll();
+    virtual_floor_invalidate_all_tiles();
     map_remove_out_of_range_elements();
     AutoCreateMapAnimations();
 
@@ -295,18 +316,20 @@ void map_init(int32_t size)
  */
 void map_count_remaining_land_rights()
 {
-    gLandRemainingOwnershipSales = 0;
-    gLandRemainingConstructionSales = 0;
-
-    for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+    struct LandRightsCount
     {
-        for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
-        {
-            auto* surfaceElement = map_get_surface_element_at(TileCoordsXY{ x, y }.ToCoordsXY());
+        int32_t OwnershipSales;
+        int32_t ConstructionSales;
+    };
+
+    auto count = ReduceTilesParallel(
+        LandRightsCount{},
+        [](LandRightsCount& value, const TileCoordsXY& coords) {
+            auto* surfaceElement = map_get_surface_element_at(coords.ToCoordsXY());
             // Surface elements are sometimes hacked out to save some space for other map elements
             if (surfaceElement == nullptr)
             {
-                continue;
+                return;
             }
 
             uint8_t flags = surfaceElement->GetOwnership();
@@ -317,16 +340,22 @@ void map_count_remaining_land_rights()
             {
                 if (flags & OWNERSHIP_AVAILABLE)
                 {
-                    gLandRemainingOwnershipSales++;
+                    value.OwnershipSales++;
                 }
                 else if (
                     (flags & OWNERSHIP_CONSTRUCTION_RIGHTS_AVAILABLE) && (flags & OWNERSHIP_CONSTRUCTION_RIGHTS_OWNED) == 0)
                 {
-                    gLandRemainingConstructionSales++;
+                    value.ConstructionSales++;
                 }
             }
-        }
-    }
+        },
+        [](LandRightsCount& result, const LandRightsCount& value) {
+            result.OwnershipSales += value.OwnershipSales;
+            result.ConstructionSales += value.ConstructionSales;
+        });
+
+    gLandRemainingOwnershipSales = count.OwnershipSales;
+    gLandRemainingConstructionSales = count.ConstructionSales;
 }
 
 /**
@@ -340,10 +369,8 @@ void map_count_remaining_land_rights()
  */
 void map_strip_ghost_flag_from_elements()
 {
-    for (auto& element : gTileElements)
-    {
-        element.SetGhost(false);
-    }
+    TaskScheduler::Get().ParallelFor(
+        MAX_TILE_ELEMENTS_WITH_SPARE_ROOM, TILE_ELEMENTS_PER_SCAN_CHUNK, [](size_t i) { gTileElements[i].SetGhost(false); });
 }
 
 /**
@@ -352,25 +379,73 @@ void map_strip_ghost_flag_from_elements()
  */
 void map_update_tile_pointers()
 {
-    int32_t i, x, y;
+    // Tile n starts after the nth element that is last for its tile, but where a row starts is not known without
+    // walking the rows before it. Instead, chunks of the element list count their last elements in parallel, which
+    // tells each chunk the first tile starting in it, then each chunk fills in the pointers to its tiles.
+    constexpr size_t numChunks = (MAX_TILE_ELEMENTS_WITH_SPARE_ROOM + TILE_ELEMENTS_PER_SCAN_CHUNK - 1)
+        / TILE_ELEMENTS_PER_SCAN_CHUNK;
+    std::array<size_t, numChunks> chunkFirstTiles{};
+    auto& scheduler = TaskScheduler::Get();
+    scheduler.ParallelFor(numChunks, 1, [&chunkFirstTiles](size_t chunk) {
+        const auto begin = chunk * TILE_ELEMENTS_PER_SCAN_CHUNK;
+        const auto end = std::min<size_t>(begin + TILE_ELEMENTS_PER_SCAN_CHUNK, MAX_TILE_ELEMENTS_WITH_SPARE_ROOM);
+        size_t numLastElements = 0;
+        for (auto i = begin; i < end; i++)
+        {
+            numLastElements += gTileElements[i].IsLastForTile() ? 1 : 0;
+        }
+        chunkFirstTiles[chunk] = numLastElements;
+    });
 
-    for (i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS; i++)
+    size_t numTiles = 0;
+    for (auto& firstTile : chunkFirstTiles)
     {
-        gTileElementTilePointers[i] = TILE_UNDEFINED_TILE_ELEMENT;
+        auto numLastElements = firstTile;
+        firstTile = numTiles;
+        numTiles += numLastElements;
     }
 
-    TileElement* tileElement = gTileElements;
-    TileElement** tile = gTileElementTilePointers;
-    for (y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+    for (auto& tilePointer : gTileElementTilePointers)
     {
-        for (x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+        tilePointer = TILE_UNDEFINED_TILE_ELEMENT;
+    }
+    scheduler.ParallelFor(numChunks, 1, [&chunkFirstTiles](size_t chunk) {
+        const auto begin = chunk * TILE_ELEMENTS_PER_SCAN_CHUNK;
+        const auto end = std::min<size_t>(begin + TILE_ELEMENTS_PER_SCAN_CHUNK, MAX_TILE_ELEMENTS_WITH_SPARE_ROOM);
+        auto tile = chunkFirstTiles[chunk];
+        bool startsTile = begin == 0 || gTileElements[begin - 1].IsLastForTile();
+        for (auto i = begin; i < end && tile < MAX_TILE_TILE_ELEMENT_POINTERS; i++)
         {
-            *tile++ = tileElement;
-            while (!(tileElement++)->IsLastForTile())
-                ;
+            if (startsTile)
+            {
+                gTileElementTilePointers[tile] = &gTileElements[i];
+            }
+            startsTile = gTileElements[i].IsLastForTile();
+            if (startsTile)
+            {
+                tile++;
+            }
         }
+    });
+
+    TileElement* tileElement = gTileElementTilePointers[MAX_TILE_TILE_ELEMENT_POINTERS - 1];
+    if (tileElement == TILE_UNDEFINED_TILE_ELEMENT)
+    {
+        log_error("Tile element list ends after %zu of %d tiles", numTiles, MAX_TILE_TILE_ELEMENT_POINTERS);
+        tileElement = &gTileElements[MAX_TILE_ELEMENTS_WITH_SPARE_ROOM];
+    }
+    else
+    {
+        while (!(tileElement++)->IsLastForTile())
+            ;
     }
 
+    // Tile elements may have moved or been replaced entirely.
+    FootpathGraphInvalidateAll();
+    PathfindCacheInvalidate();
+    RideSpatialIndexInvalidateAll();
+    TileChangesInvalidateIndex();
+
     gNextFreeTileElement = tileElement;
 }
 
@@ -912,6 +987,8 @@ bool map_is_location_at_edge(const CoordsXY& loc)
  */
 void tile_element_remove(TileElement* tileElement)
 {
+    TileChangesMarkElement(tileElement);
+
     // Replace Nth element by (N+1)th element.
     // This loop will make tileElement point to the old last element position,
     // after copy it to it's new position
@@ -965,6 +1042,8 @@ void map_remove_all_rides()
                 break;
         }
     } while (tile_element_iterator_next(&it));
+
+    RideSpatialIndexInvalidateAll();
 }
 
 /**
@@ -1125,6 +1204,7 @@ TileElement* tile_element_insert(const CoordsXYZ& loc, int32_t occupiedQuadrants
 
     // Set tile index pointer to point to new element block
     gTileElementTilePointers[tileLoc.y * MAXIMUM_MAP_SIZE_TECHNICAL + tileLoc.x] = newTileElement;
+    TileChangesMoveTile(tileLoc, originalTileElement, newTileElement);
 
     if (originalTileElement == nullptr)
     {
@@ -1575,7 +1655,12 @@ void map_remove_out_of_range_elements()
     {
         for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_BIG; x += COORDS_XY_STEP)
         {
-            if (x == 0 || y == 0 || x >= mapMaxXY || y >= mapMaxXY)
+            if (!(x == 0 || y == 0 || x >= mapMaxXY || y >= mapMaxXY))
+            {
+                // Skip to the far edge, every tile up to it is inside the map
+                x = ((mapMaxXY - 1) / COORDS_XY_STEP) * COORDS_XY_STEP;
+            }
+            else
             {
                 // Note this purposely does not use LandSetRightsAction as X Y coordinates are outside of normal range.
                 auto surfaceElement = map_get_surface_element_at(CoordsXY{ x, y });
@@ -1752,6 +1837,7 @@ static void clear_element_at(const CoordsXY& loc, TileElement** elementPtr)
         }
         default:
             tile_element_remove(element);
+            RideSpatialIndexInvalidateTile(loc);
             break;
     }
 }
@@ -2002,6 +2088,9 @@ ScreenCoordsXY translate_3d_to_2d_with_z(int32_t rotation, const CoordsXYZ& pos)
 
 static void map_invalidate_tile_under_zoom(int32_t x, int32_t y, int32_t z0, int32_t z1, int32_t maxZoom)
 {
+    PaintCacheInvalidateTile({ x, y });
+    virtual_floor_invalidate_tiles({ x, y }, { x, y });
+
     if (gOpenRCT2Headless)
         return;
 
@@ -2064,6 +2153,9 @@ void map_invalidate_region(const CoordsXY& mins, const CoordsXY& maxs)
 {
     int32_t x0, y0, x1, y1, left, right, top, bottom;
 
+    PaintCacheInvalidateRegion(mins, maxs);
+    virtual_floor_invalidate_tiles(mins, maxs);
+
     x0 = mins.x + 16;
     y0 = mins.y + 16;
 
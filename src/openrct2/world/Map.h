@@ -23,6 +23,8 @@
 #define MAXIMUM_WATER_HEIGHT 58
 
 #define MINIMUM_MAP_SIZE_TECHNICAL 15
+// Entity positions are stored as int16_t and saved parks use a 256x256 tile grid, so the map can not be made larger
+// without changing both.
 #define MAXIMUM_MAP_SIZE_TECHNICAL 256
 #define MINIMUM_MAP_SIZE_PRACTICAL (MINIMUM_MAP_SIZE_TECHNICAL - 2)
 #define MAXIMUM_MAP_SIZE_PRACTICAL (MAXIMUM_MAP_SIZE_TECHNICAL - 2)
@@ -33,6 +35,7 @@ constexpr const int32_t MINIMUM_LAND_HEIGHT_BIG = MINIMUM_LAND_HEIGHT * COORDS_Z
 
 #define MAP_MINIMUM_X_Y (-MAXIMUM_MAP_SIZE_TECHNICAL)
 
+// Matches the tile element array of the SV6/SC6 formats, parks with more elements than this could not be saved.
 constexpr const uint32_t MAX_TILE_ELEMENTS_WITH_SPARE_ROOM = 0x30000;
 constexpr const uint32_t MAX_TILE_ELEMENTS = MAX_TILE_ELEMENTS_WITH_SPARE_ROOM - 512;
 #define MAX_TILE_TILE_ELEMENT_POINTERS (MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL)
@@ -175,6 +178,7 @@ public:
 };
 
 void map_init(int32_t size);
+size_t map_get_memory_usage();
 
 void map_count_remaining_land_rights();
 void map_strip_ghost_flag_from_elements();
@@ -11,6 +11,7 @@
 
 #include "../Context.h"
 #include "../Game.h"
+#include "../OpenRCT2.h"
 #include "../interface/Viewport.h"
 #include "../object/StationObject.h"
 #include "../ride/Ride.h"
@@ -22,18 +23,47 @@
 #include "Footpath.h"
 #include "LargeScenery.h"
 #include "Map.h"
+#include "MapScan.h"
 #include "Scenery.h"
 #include "SmallScenery.h"
 #include "Sprite.h"
 
+#include <algorithm>
+#include <array>
+#include <optional>
+
 using map_animation_invalidate_event_handler = bool (*)(const CoordsXYZ& loc);
 
 static std::vector<MapAnimation> _mapAnimations;
 
 constexpr size_t MAX_ANIMATED_OBJECTS = 2000;
 
+// Without presentation the animations that only redraw their tile are still visited every so many passes, to remove
+// the ones whose element is gone before they fill up the list
+constexpr uint32_t MAP_ANIMATION_NO_PRESENTATION_PASSES = 64;
+
+static uint32_t _mapAnimationPasses;
+
 static bool InvalidateMapAnimation(const MapAnimation& obj);
 
+/**
+ * Whether the animation changes the game as well as redrawing its tile: the clocks make the peeps next to them check the
+ * time, the on-ride photo sections count down their flash and the doors store their frame in the wall element.
+ */
+static bool MapAnimationChangesState(uint8_t type)
+{
+    switch (type)
+    {
+        case MAP_ANIMATION_TYPE_SMALL_SCENERY:
+        case MAP_ANIMATION_TYPE_TRACK_ONRIDEPHOTO:
+        case MAP_ANIMATION_TYPE_WALL_DOOR:
+        case MAP_ANIMATION_TYPE_REMOVE:
+            return true;
+        default:
+            return false;
+    }
+}
+
 static bool DoesAnimationExist(int32_t type, const CoordsXYZ& location)
 {
     for (const auto& a : _mapAnimations)
@@ -69,19 +99,27 @@ void map_animation_create(int32_t type, const CoordsXYZ& loc)
  */
 void map_animation_invalidate_all()
 {
-    auto it = _mapAnimations.begin();
-    while (it != _mapAnimations.end())
+    // Finished animations are removed in the same pass, rather than erasing them one at a time.
+    auto it = _mapAnimations.end();
+    if (gInTickBatch || (gOpenRCT2NoPresentation && (++_mapAnimationPasses % MAP_ANIMATION_NO_PRESENTATION_PASSES) != 0))
     {
-        if (InvalidateMapAnimation(*it))
-        {
-            // Map animation has finished, remove it
-            it = _mapAnimations.erase(it);
-        }
-        else
-        {
-            it++;
-        }
+        it = std::remove_if(_mapAnimations.begin(), _mapAnimations.end(), [](const MapAnimation& a) {
+            return MapAnimationChangesState(a.type) && InvalidateMapAnimation(a);
+        });
     }
+    else
+    {
+        it = std::remove_if(_mapAnimations.begin(), _mapAnimations.end(), InvalidateMapAnimation);
+    }
+    _mapAnimations.erase(it, _mapAnimations.end());
+}
+
+void map_animation_invalidate_presentation()
+{
+    auto it = std::remove_if(_mapAnimations.begin(), _mapAnimations.end(), [](const MapAnimation& a) {
+        return !MapAnimationChangesState(a.type) && InvalidateMapAnimation(a);
+    });
+    _mapAnimations.erase(it, _mapAnimations.end());
 }
 
 /**
@@ -614,97 +652,137 @@ static void ClearMapAnimations()
     _mapAnimations.clear();
 }
 
-void AutoCreateMapAnimations()
+/**
+ * The animation AutoCreateMapAnimations creates for the element, if any.
+ */
+static std::optional<uint8_t> GetAutoMapAnimationType(const TileElement& element)
 {
-    ClearMapAnimations();
-
-    tile_element_iterator it;
-    tile_element_iterator_begin(&it);
-    while (tile_element_iterator_next(&it))
+    switch (element.GetType())
     {
-        auto el = it.element;
-        auto loc = CoordsXYZ{ TileCoordsXY(it.x, it.y).ToCoordsXY(), el->GetBaseZ() };
-        switch (el->GetType())
+        case TILE_ELEMENT_TYPE_BANNER:
+            return MAP_ANIMATION_TYPE_BANNER;
+        case TILE_ELEMENT_TYPE_WALL:
         {
-            case TILE_ELEMENT_TYPE_BANNER:
-                map_animation_create(MAP_ANIMATION_TYPE_BANNER, loc);
-                break;
-            case TILE_ELEMENT_TYPE_WALL:
+            auto wallEl = element.AsWall();
+            auto entry = wallEl->GetEntry();
+            if (entry != nullptr
+                && ((entry->wall.flags2 & WALL_SCENERY_2_ANIMATED) || entry->wall.scrolling_mode != SCROLLING_MODE_NONE))
             {
-                auto wallEl = el->AsWall();
-                auto entry = wallEl->GetEntry();
-                if (entry != nullptr
-                    && ((entry->wall.flags2 & WALL_SCENERY_2_ANIMATED) || entry->wall.scrolling_mode != SCROLLING_MODE_NONE))
-                {
-                    map_animation_create(MAP_ANIMATION_TYPE_WALL, loc);
-                }
-                break;
+                return MAP_ANIMATION_TYPE_WALL;
             }
-            case TILE_ELEMENT_TYPE_SMALL_SCENERY:
+            break;
+        }
+        case TILE_ELEMENT_TYPE_SMALL_SCENERY:
+        {
+            auto sceneryEl = element.AsSmallScenery();
+            auto entry = sceneryEl->GetEntry();
+            if (entry != nullptr && scenery_small_entry_has_flag(entry, SMALL_SCENERY_FLAG_ANIMATED))
             {
-                auto sceneryEl = el->AsSmallScenery();
-                auto entry = sceneryEl->GetEntry();
-                if (entry != nullptr && scenery_small_entry_has_flag(entry, SMALL_SCENERY_FLAG_ANIMATED))
-                {
-                    map_animation_create(MAP_ANIMATION_TYPE_SMALL_SCENERY, loc);
-                }
-                break;
+                return MAP_ANIMATION_TYPE_SMALL_SCENERY;
+            }
+            break;
+        }
+        case TILE_ELEMENT_TYPE_LARGE_SCENERY:
+        {
+            auto sceneryEl = element.AsLargeScenery();
+            auto entry = sceneryEl->GetEntry();
+            if (entry != nullptr && (entry->large_scenery.flags & LARGE_SCENERY_FLAG_ANIMATED))
+            {
+                return MAP_ANIMATION_TYPE_LARGE_SCENERY;
             }
-            case TILE_ELEMENT_TYPE_LARGE_SCENERY:
+            break;
+        }
+        case TILE_ELEMENT_TYPE_PATH:
+        {
+            auto path = element.AsPath();
+            if (path->HasQueueBanner())
             {
-                auto sceneryEl = el->AsLargeScenery();
-                auto entry = sceneryEl->GetEntry();
-                if (entry != nullptr && (entry->large_scenery.flags & LARGE_SCENERY_FLAG_ANIMATED))
-                {
-                    map_animation_create(MAP_ANIMATION_TYPE_LARGE_SCENERY, loc);
-                }
-                break;
+                return MAP_ANIMATION_TYPE_QUEUE_BANNER;
             }
-            case TILE_ELEMENT_TYPE_PATH:
+            break;
+        }
+        case TILE_ELEMENT_TYPE_ENTRANCE:
+        {
+            auto entrance = element.AsEntrance();
+            switch (entrance->GetEntranceType())
             {
-                auto path = el->AsPath();
-                if (path->HasQueueBanner())
-                {
-                    map_animation_create(MAP_ANIMATION_TYPE_QUEUE_BANNER, loc);
-                }
-                break;
+                case ENTRANCE_TYPE_PARK_ENTRANCE:
+                    if (entrance->GetSequenceIndex() == 0)
+                    {
+                        return MAP_ANIMATION_TYPE_PARK_ENTRANCE;
+                    }
+                    break;
+                case ENTRANCE_TYPE_RIDE_ENTRANCE:
+                    return MAP_ANIMATION_TYPE_RIDE_ENTRANCE;
             }
-            case TILE_ELEMENT_TYPE_ENTRANCE:
+            break;
+        }
+        case TILE_ELEMENT_TYPE_TRACK:
+        {
+            auto track = element.AsTrack();
+            switch (track->GetTrackType())
             {
-                auto entrance = el->AsEntrance();
-                switch (entrance->GetEntranceType())
-                {
-                    case ENTRANCE_TYPE_PARK_ENTRANCE:
-                        if (entrance->GetSequenceIndex() == 0)
-                        {
-                            map_animation_create(MAP_ANIMATION_TYPE_PARK_ENTRANCE, loc);
-                        }
-                        break;
-                    case ENTRANCE_TYPE_RIDE_ENTRANCE:
-                        map_animation_create(MAP_ANIMATION_TYPE_RIDE_ENTRANCE, loc);
-                        break;
-                }
-                break;
+                case TrackElemType::Waterfall:
+                    return MAP_ANIMATION_TYPE_TRACK_WATERFALL;
+                case TrackElemType::Rapids:
+                    return MAP_ANIMATION_TYPE_TRACK_RAPIDS;
+                case TrackElemType::Whirlpool:
+                    return MAP_ANIMATION_TYPE_TRACK_WHIRLPOOL;
+                case TrackElemType::SpinningTunnel:
+                    return MAP_ANIMATION_TYPE_TRACK_SPINNINGTUNNEL;
             }
-            case TILE_ELEMENT_TYPE_TRACK:
+            break;
+        }
+    }
+    return std::nullopt;
+}
+
+void AutoCreateMapAnimations()
+{
+    ClearMapAnimations();
+
+    // The rows are scanned in parallel, each into its own list. An animation can only be repeated on its own tile, so
+    // the lists are appended in row order without looking for each animation in the ones before.
+    std::array<std::vector<MapAnimation>, MAXIMUM_MAP_SIZE_TECHNICAL> rows;
+    ForEachTileRowParallel([&rows](int32_t y) {
+        auto& row = rows[y];
+        for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+        {
+            auto loc = TileCoordsXY(x, y).ToCoordsXY();
+            auto* element = map_get_first_element_at(loc);
+            if (element == nullptr)
+                continue;
+
+            const auto tileBegin = row.size();
+            do
             {
-                auto track = el->AsTrack();
-                switch (track->GetTrackType())
+                auto type = GetAutoMapAnimationType(*element);
+                if (!type.has_value())
+                    continue;
+
+                MapAnimation animation{ *type, CoordsXYZ{ loc, element->GetBaseZ() } };
+                auto isDuplicate = std::any_of(row.begin() + tileBegin, row.end(), [&animation](const MapAnimation& a) {
+                    return a.type == animation.type && a.location == animation.location;
+                });
+                if (!isDuplicate)
                 {
-                    case TrackElemType::Waterfall:
-                        map_animation_create(MAP_ANIMATION_TYPE_TRACK_WATERFALL, loc);
-                        break;
-                    case TrackElemType::Rapids:
-                        map_animation_create(MAP_ANIMATION_TYPE_TRACK_RAPIDS, loc);
-                        break;
-                    case TrackElemType::Whirlpool:
-                        map_animation_create(MAP_ANIMATION_TYPE_TRACK_WHIRLPOOL, loc);
-                        break;
-                    case TrackElemType::SpinningTunnel:
-                        map_animation_create(MAP_ANIMATION_TYPE_TRACK_SPINNINGTUNNEL, loc);
-                        break;
+                    row.push_back(animation);
                 }
-                break;
+            } while (!(element++)->IsLastForTile());
+        }
+    });
+
+    for (const auto& row : rows)
+    {
+        for (const auto& animation : row)
+        {
+            if (_mapAnimations.size() < MAX_ANIMATED_OBJECTS)
+            {
+                _mapAnimations.push_back(animation);
+            }
+            else
+            {
+                log_error("Exceeded the maximum number of animations");
             }
         }
     }
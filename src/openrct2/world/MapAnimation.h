@@ -41,5 +41,10 @@ enum
 
 void map_animation_create(int32_t type, const CoordsXYZ& loc);
 void map_animation_invalidate_all();
+
+/**
+ * Redraws the animations that do not change the game, for after a batch of ticks that skipped them.
+ */
+void map_animation_invalidate_presentation();
 const std::vector<MapAnimation>& GetMapAnimations();
 void AutoCreateMapAnimations();
@@ -15,6 +15,7 @@
 #include "../core/Guard.hpp"
 #include "../core/Imaging.h"
 #include "../core/String.hpp"
+#include "../core/TaskScheduler.h"
 #include "../localisation/Localisation.h"
 #include "../localisation/StringIds.h"
 #include "../object/Object.h"
@@ -412,21 +413,23 @@ static void mapgen_set_water_level(int32_t waterLevel)
  */
 static void mapgen_smooth_height(int32_t iterations)
 {
-    int32_t i, x, y, xx, yy, avg;
+    int32_t i;
     int32_t arraySize = _heightSize * _heightSize * sizeof(uint8_t);
     uint8_t* copyHeight = new uint8_t[arraySize];
 
     for (i = 0; i < iterations; i++)
     {
         std::memcpy(copyHeight, _height, arraySize);
-        for (y = 1; y < _heightSize - 1; y++)
-        {
-            for (x = 1; x < _heightSize - 1; x++)
+
+        // Rows only read the copy, so they can be smoothed independently.
+        OpenRCT2::TaskScheduler::Get().ParallelFor(_heightSize - 2, [copyHeight](size_t row) {
+            int32_t y = static_cast<int32_t>(row) + 1;
+            for (int32_t x = 1; x < _heightSize - 1; x++)
             {
-                avg = 0;
-                for (yy = -1; yy <= 1; yy++)
+                int32_t avg = 0;
+                for (int32_t yy = -1; yy <= 1; yy++)
                 {
-                    for (xx = -1; xx <= 1; xx++)
+                    for (int32_t xx = -1; xx <= 1; xx++)
                     {
                         avg += copyHeight[(y + yy) * _heightSize + (x + xx)];
                     }
@@ -434,7 +437,7 @@ static void mapgen_smooth_height(int32_t iterations)
                 avg /= 9;
                 set_height(x, y, avg);
             }
-        }
+        });
     }
 
     delete[] copyHeight;
@@ -621,8 +624,6 @@ static float grad(int32_t hash, float x, float y)
 
 static void mapgen_simplex(mapgen_settings* settings)
 {
-    int32_t x, y;
-
     float freq = settings->simplex_base_freq * (1.0f / _heightSize);
     int32_t octaves = settings->simplex_octaves;
 
@@ -630,16 +631,18 @@ static void mapgen_simplex(mapgen_settings* settings)
     int32_t high = settings->simplex_high;
 
     noise_rand();
-    for (y = 0; y < _heightSize; y++)
-    {
-        for (x = 0; x < _heightSize; x++)
+
+    // The noise only depends on the permutation table, so rows are generated in parallel.
+    OpenRCT2::TaskScheduler::Get().ParallelFor(_heightSize, [freq, octaves, low, high](size_t row) {
+        int32_t y = static_cast<int32_t>(row);
+        for (int32_t x = 0; x < _heightSize; x++)
         {
             float noiseValue = std::clamp(fractal_noise(x, y, freq, octaves, 2.0f, 0.65f), -1.0f, 1.0f);
             float normalisedNoiseValue = (noiseValue + 1.0f) / 2.0f;
 
             set_height(x, y, low + static_cast<int32_t>(normalisedNoiseValue * high));
         }
-    }
+    });
 }
 
 #pragma endregion
@@ -0,0 +1,93 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../core/TaskScheduler.h"
+#include "Map.h"
+
+#include <vector>
+
+/*
+ * Whole-map scans on the task scheduler. The map is split into chunks of rows and the rows of a chunk are visited in
+ * order. The callback must only modify the elements of the tile it is given or of its own row, and must not use game
+ * actions, entities, windows or anything else that is shared between tiles.
+ */
+
+constexpr int32_t MAP_SCAN_ROWS_PER_CHUNK = 8;
+constexpr int32_t MAP_SCAN_NUM_CHUNKS = MAXIMUM_MAP_SIZE_TECHNICAL / MAP_SCAN_ROWS_PER_CHUNK;
+static_assert(MAXIMUM_MAP_SIZE_TECHNICAL % MAP_SCAN_ROWS_PER_CHUNK == 0);
+
+/**
+ * Calls func(y) for every row of the map.
+ */
+template<typename TFunc> void ForEachTileRowParallel(const TFunc& func)
+{
+    OpenRCT2::TaskScheduler::Get().ParallelFor(
+        MAXIMUM_MAP_SIZE_TECHNICAL, MAP_SCAN_ROWS_PER_CHUNK, [&func](size_t y) { func(static_cast<int32_t>(y)); });
+}
+
+/**
+ * Calls func(coords) for every tile of the map.
+ */
+template<typename TFunc> void ForEachTileParallel(const TFunc& func)
+{
+    ForEachTileRowParallel([&func](int32_t y) {
+        for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+        {
+            func(TileCoordsXY{ x, y });
+        }
+    });
+}
+
+/**
+ * Calls func(element, coords) for every element of every tile of the map.
+ */
+template<typename TFunc> void ForEachTileElementParallel(const TFunc& func)
+{
+    ForEachTileParallel([&func](const TileCoordsXY& coords) {
+        auto* element = map_get_first_element_at(coords.ToCoordsXY());
+        if (element == nullptr)
+            return;
+
+        do
+        {
+            func(*element, coords);
+        } while (!(element++)->IsLastForTile());
+    });
+}
+
+/**
+ * Folds the tiles of each chunk into a copy of init with accumulate(value, coords), then combines the chunks with
+ * combine(result, chunkValue) in row order, starting from init. init should not change a value it is combined with,
+ * such as zero for a count. The result does not depend on how the chunks were scheduled.
+ */
+template<typename T, typename TAccumulate, typename TCombine>
+T ReduceTilesParallel(const T& init, const TAccumulate& accumulate, const TCombine& combine)
+{
+    std::vector<T> chunkValues(MAP_SCAN_NUM_CHUNKS, init);
+    OpenRCT2::TaskScheduler::Get().ParallelFor(MAP_SCAN_NUM_CHUNKS, 1, [&chunkValues, &accumulate](size_t chunk) {
+        auto& value = chunkValues[chunk];
+        const auto firstRow = static_cast<int32_t>(chunk) * MAP_SCAN_ROWS_PER_CHUNK;
+        for (int32_t y = firstRow; y < firstRow + MAP_SCAN_ROWS_PER_CHUNK; y++)
+        {
+            for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+            {
+                accumulate(value, TileCoordsXY{ x, y });
+            }
+        }
+    });
+
+    T result = init;
+    for (const auto& value : chunkValues)
+    {
+        combine(result, value);
+    }
+    return result;
+}
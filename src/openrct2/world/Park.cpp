@@ -37,8 +37,11 @@
 #include "../windows/Intent.h"
 #include "Entrance.h"
 #include "Map.h"
+#include "MapScan.h"
+#include "ParkHistory.h"
 #include "Sprite.h"
 #include "Surface.h"
+#include "TileElementsView.h"
 
 #include <algorithm>
 #include <limits>
@@ -312,11 +315,12 @@ void Park::Update(const Date& date)
     // Every ~13 seconds
     if (gCurrentTicks % 512 == 0)
     {
-        gParkRating = CalculateParkRating();
-        gParkValue = CalculateParkValue();
+        auto rideStatistics = GatherRideStatistics();
+        gParkRating = CalculateParkRating(rideStatistics);
+        gParkValue = CalculateParkValue(rideStatistics);
         gCompanyValue = CalculateCompanyValue();
-        gTotalRideValueForMoney = CalculateTotalRideValueForMoney();
-        _suggestedGuestMaximum = CalculateSuggestedMaxGuests();
+        gTotalRideValueForMoney = rideStatistics.TotalValueForMoney;
+        _suggestedGuestMaximum = CalculateSuggestedMaxGuests(rideStatistics);
         _guestGenerationProbability = CalculateGuestGenerationProbability();
 
         window_invalidate_by_class(WC_FINANCES);
@@ -334,24 +338,28 @@ void Park::Update(const Date& date)
     {
         UpdateHistories();
     }
+    // Every new day
+    if (date.IsDayStart() || date.IsMonthStart())
+    {
+        gParkHistory.Update();
+    }
     GenerateGuests();
 }
 
 int32_t Park::CalculateParkSize() const
 {
-    int32_t tiles = 0;
-    tile_element_iterator it;
-    tile_element_iterator_begin(&it);
-    do
-    {
-        if (it.element->GetType() == TILE_ELEMENT_TYPE_SURFACE)
-        {
-            if (it.element->AsSurface()->GetOwnership() & (OWNERSHIP_CONSTRUCTION_RIGHTS_OWNED | OWNERSHIP_OWNED))
+    int32_t tiles = ReduceTilesParallel(
+        0,
+        [](int32_t& value, const TileCoordsXY& coords) {
+            for (auto* surfaceElement : TileElementsView<SurfaceElement>(coords.ToCoordsXY()))
             {
-                tiles++;
+                if (surfaceElement->GetOwnership() & (OWNERSHIP_CONSTRUCTION_RIGHTS_OWNED | OWNERSHIP_OWNED))
+                {
+                    value++;
+                }
             }
-        }
-    } while (tile_element_iterator_next(&it));
+        },
+        [](int32_t& result, int32_t value) { result += value; });
 
     if (tiles != gParkSize)
     {
@@ -362,7 +370,64 @@ int32_t Park::CalculateParkSize() const
     return tiles;
 }
 
+Park::RideStatistics Park::GatherRideStatistics() const
+{
+    RideStatistics result;
+    bool ridePricesUnlocked = park_ride_prices_unlocked() && !(gParkFlags & PARK_FLAGS_NO_MONEY);
+    bool difficultGuestGeneration = (gParkFlags & PARK_FLAGS_DIFFICULT_GUEST_GENERATION) != 0;
+    for (const auto& ride : GetRideManager())
+    {
+        const auto& rtd = ride.GetRideTypeDescriptor();
+        result.RideCount++;
+        result.TotalUptime += 100 - ride.downtime;
+        if (ride_has_ratings(&ride))
+        {
+            result.TotalExcitement += ride.excitement / 8;
+            result.TotalIntensity += ride.intensity / 8;
+            result.RatedRideCount++;
+        }
+        result.TotalValue += CalculateRideValue(&ride);
+
+        if (ride.lifecycle_flags & (RIDE_LIFECYCLE_BROKEN_DOWN | RIDE_LIFECYCLE_CRASHED))
+            continue;
+
+        // Extra guests are available for good rides with difficult guest generation, even when they are closed
+        if (difficultGuestGeneration && (ride.lifecycle_flags & RIDE_LIFECYCLE_TESTED)
+            && rtd.HasFlag(RIDE_TYPE_FLAG_HAS_TRACK) && rtd.HasFlag(RIDE_TYPE_FLAG_HAS_DATA_LOGGING)
+            && ride.stations[0].SegmentLength >= (600 << 16) && ride.excitement >= RIDE_RATING(6, 00))
+        {
+            result.GoodRideBonusGuests += rtd.BonusValue * 2;
+        }
+
+        if (ride.status != RIDE_STATUS_OPEN)
+            continue;
+
+        // Add guest score for ride type
+        result.SuggestedMaxGuests += rtd.BonusValue;
+
+        // Add ride value
+        if (ride.value != RIDE_VALUE_UNDEFINED)
+        {
+            money16 rideValue = static_cast<money16>(ride.value);
+            if (ridePricesUnlocked)
+            {
+                rideValue -= ride.price[0];
+            }
+            if (rideValue > 0)
+            {
+                result.TotalValueForMoney += rideValue * 2;
+            }
+        }
+    }
+    return result;
+}
+
 int32_t Park::CalculateParkRating() const
+{
+    return CalculateParkRating(GatherRideStatistics());
+}
+
+int32_t Park::CalculateParkRating(const RideStatistics& rideStatistics) const
 {
     if (_forcedParkRating >= 0)
     {
@@ -414,22 +479,11 @@ int32_t Park::CalculateParkRating() const
 
     // Rides
     {
-        int32_t rideCount = 0;
-        int32_t excitingRideCount = 0;
-        int32_t totalRideUptime = 0;
-        int32_t totalRideIntensity = 0;
-        int32_t totalRideExcitement = 0;
-        for (auto& ride : GetRideManager())
-        {
-            totalRideUptime += 100 - ride.downtime;
-            if (ride_has_ratings(&ride))
-            {
-                totalRideExcitement += ride.excitement / 8;
-                totalRideIntensity += ride.intensity / 8;
-                excitingRideCount++;
-            }
-            rideCount++;
-        }
+        int32_t rideCount = rideStatistics.RideCount;
+        int32_t excitingRideCount = rideStatistics.RatedRideCount;
+        int32_t totalRideUptime = rideStatistics.TotalUptime;
+        int32_t totalRideIntensity = rideStatistics.TotalIntensity;
+        int32_t totalRideExcitement = rideStatistics.TotalExcitement;
         result -= 200;
         if (rideCount > 0)
         {
@@ -484,12 +538,12 @@ int32_t Park::CalculateParkRating() const
 
 money32 Park::CalculateParkValue() const
 {
-    // Sum ride values
-    money32 result = 0;
-    for (const auto& ride : GetRideManager())
-    {
-        result += CalculateRideValue(&ride);
-    }
+    return CalculateParkValue(GatherRideStatistics());
+}
+
+money32 Park::CalculateParkValue(const RideStatistics& rideStatistics) const
+{
+    money32 result = rideStatistics.TotalValue;
 
     // +7.00 per guest
     result += gNumGuestsInPark * MONEY(7, 00);
@@ -518,78 +572,15 @@ money32 Park::CalculateCompanyValue() const
     return result;
 }
 
-money16 Park::CalculateTotalRideValueForMoney() const
-{
-    money16 totalRideValue = 0;
-    bool ridePricesUnlocked = park_ride_prices_unlocked() && !(gParkFlags & PARK_FLAGS_NO_MONEY);
-    for (auto& ride : GetRideManager())
-    {
-        if (ride.status != RIDE_STATUS_OPEN)
-            continue;
-        if (ride.lifecycle_flags & RIDE_LIFECYCLE_BROKEN_DOWN)
-            continue;
-        if (ride.lifecycle_flags & RIDE_LIFECYCLE_CRASHED)
-            continue;
-
-        // Add ride value
-        if (ride.value != RIDE_VALUE_UNDEFINED)
-        {
-            money16 rideValue = static_cast<money16>(ride.value);
-            if (ridePricesUnlocked)
-            {
-                rideValue -= ride.price[0];
-            }
-            if (rideValue > 0)
-            {
-                totalRideValue += rideValue * 2;
-            }
-        }
-    }
-    return totalRideValue;
-}
-
-uint32_t Park::CalculateSuggestedMaxGuests() const
+uint32_t Park::CalculateSuggestedMaxGuests(const RideStatistics& rideStatistics) const
 {
-    uint32_t suggestedMaxGuests = 0;
-
-    // TODO combine the two ride loops
-    for (auto& ride : GetRideManager())
-    {
-        if (ride.status != RIDE_STATUS_OPEN)
-            continue;
-        if (ride.lifecycle_flags & RIDE_LIFECYCLE_BROKEN_DOWN)
-            continue;
-        if (ride.lifecycle_flags & RIDE_LIFECYCLE_CRASHED)
-            continue;
-
-        // Add guest score for ride type
-        suggestedMaxGuests += ride.GetRideTypeDescriptor().BonusValue;
-    }
+    uint32_t suggestedMaxGuests = rideStatistics.SuggestedMaxGuests;
 
     // If difficult guest generation, extra guests are available for good rides
     if (gParkFlags & PARK_FLAGS_DIFFICULT_GUEST_GENERATION)
     {
         suggestedMaxGuests = std::min<uint32_t>(suggestedMaxGuests, 1000);
-        for (auto& ride : GetRideManager())
-        {
-            if (ride.lifecycle_flags & RIDE_LIFECYCLE_CRASHED)
-                continue;
-            if (ride.lifecycle_flags & RIDE_LIFECYCLE_BROKEN_DOWN)
-                continue;
-            if (!(ride.lifecycle_flags & RIDE_LIFECYCLE_TESTED))
-                continue;
-            if (!ride.GetRideTypeDescriptor().HasFlag(RIDE_TYPE_FLAG_HAS_TRACK))
-                continue;
-            if (!ride.GetRideTypeDescriptor().HasFlag(RIDE_TYPE_FLAG_HAS_DATA_LOGGING))
-                continue;
-            if (ride.stations[0].SegmentLength < (600 << 16))
-                continue;
-            if (ride.excitement < RIDE_RATING(6, 00))
-                continue;
-
-            // Bonus guests for good ride
-            suggestedMaxGuests += ride.GetRideTypeDescriptor().BonusValue * 2;
-        }
+        suggestedMaxGuests += rideStatistics.GoodRideBonusGuests;
     }
 
     suggestedMaxGuests = std::min<uint32_t>(suggestedMaxGuests, 65535);
@@ -747,6 +738,7 @@ void Park::ResetHistories()
         gParkRatingHistory[i] = 255;
         gGuestsInParkHistory[i] = 255;
     }
+    gParkHistory.Reset();
 }
 
 void Park::UpdateHistories()
@@ -79,9 +79,27 @@ namespace OpenRCT2
         void UpdateHistories();
 
     private:
+        /**
+         * What the park rating, park value and guest generation need from the rides, gathered in one pass.
+         */
+        struct RideStatistics
+        {
+            int32_t RideCount{};
+            int32_t RatedRideCount{};
+            int32_t TotalUptime{};
+            int32_t TotalExcitement{};
+            int32_t TotalIntensity{};
+            money32 TotalValue{};
+            money16 TotalValueForMoney{};
+            uint32_t SuggestedMaxGuests{};
+            uint32_t GoodRideBonusGuests{};
+        };
+
+        RideStatistics GatherRideStatistics() const;
+        int32_t CalculateParkRating(const RideStatistics& rideStatistics) const;
+        money32 CalculateParkValue(const RideStatistics& rideStatistics) const;
         money32 CalculateRideValue(const Ride* ride) const;
-        money16 CalculateTotalRideValueForMoney() const;
-        uint32_t CalculateSuggestedMaxGuests() const;
+        uint32_t CalculateSuggestedMaxGuests(const RideStatistics& rideStatistics) const;
         uint32_t CalculateGuestGenerationProbability() const;
 
         void GenerateGuests();
@@ -0,0 +1,134 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "ParkHistory.h"
+
+#include "../Game.h"
+#include "../core/MemoryStream.h"
+#include "../management/Finance.h"
+#include "../peep/Peep.h"
+#include "../ride/Ride.h"
+#include "Park.h"
+
+using namespace OpenRCT2;
+
+ParkHistory gParkHistory;
+
+void ParkHistory::Reset()
+{
+    for (auto& metric : _metrics)
+    {
+        metric.Clear();
+    }
+    _rideIncome.clear();
+}
+
+void ParkHistory::Update()
+{
+    auto tick = gCurrentTicks;
+    _metrics[EnumValue(ParkHistoryMetric::Cash)].Append(tick, finance_get_current_cash());
+    _metrics[EnumValue(ParkHistoryMetric::Guests)].Append(tick, gNumGuestsInPark);
+    _metrics[EnumValue(ParkHistoryMetric::Rating)].Append(tick, gParkRating);
+    _metrics[EnumValue(ParkHistoryMetric::ParkValue)].Append(tick, gParkValue);
+
+    // Demolished rides lose their history, so a new ride given the same id starts afresh
+    for (auto it = _rideIncome.begin(); it != _rideIncome.end();)
+    {
+        if (get_ride(it->first) == nullptr)
+            it = _rideIncome.erase(it);
+        else
+            it++;
+    }
+    for (const auto& ride : GetRideManager())
+    {
+        auto income = ride.income_per_hour == MONEY32_UNDEFINED ? 0 : ride.income_per_hour;
+        _rideIncome[ride.id].Append(tick, income);
+    }
+}
+
+const TimeSeries& ParkHistory::GetMetric(ParkHistoryMetric metric) const
+{
+    return _metrics[EnumValue(metric)];
+}
+
+const TimeSeries* ParkHistory::GetRideIncome(ride_id_t rideId) const
+{
+    auto it = _rideIncome.find(rideId);
+    return it != _rideIncome.end() ? &it->second : nullptr;
+}
+
+std::vector<uint8_t> ParkHistory::Serialise() const
+{
+    MemoryStream stream;
+    stream.WriteValue<uint32_t>(FormatVersion);
+    stream.WriteValue<uint32_t>(static_cast<uint32_t>(std::size(_metrics)));
+    for (const auto& metric : _metrics)
+    {
+        metric.Write(stream);
+    }
+    stream.WriteValue<uint32_t>(static_cast<uint32_t>(_rideIncome.size()));
+    for (const auto& [rideId, income] : _rideIncome)
+    {
+        stream.WriteValue<ride_id_t>(rideId);
+        income.Write(stream);
+    }
+
+    auto data = static_cast<const uint8_t*>(stream.GetData());
+    return std::vector<uint8_t>(data, data + stream.GetLength());
+}
+
+bool ParkHistory::Deserialise(const std::vector<uint8_t>& data)
+{
+    Reset();
+    try
+    {
+        MemoryStream stream(data.data(), data.size());
+        if (stream.ReadValue<uint32_t>() != FormatVersion)
+            throw IOException("Unknown park history version.");
+
+        // Metrics added later are left empty
+        auto numMetrics = stream.ReadValue<uint32_t>();
+        for (uint32_t i = 0; i < numMetrics; i++)
+        {
+            TimeSeries metric;
+            metric.Read(stream);
+            if (i < std::size(_metrics))
+            {
+                _metrics[i] = std::move(metric);
+            }
+        }
+
+        auto numRides = stream.ReadValue<uint32_t>();
+        for (uint32_t i = 0; i < numRides; i++)
+        {
+            auto rideId = stream.ReadValue<ride_id_t>();
+            _rideIncome[rideId].Read(stream);
+        }
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        log_warning("Unable to read the park history: %s", e.what());
+        Reset();
+        return false;
+    }
+}
+
+std::optional<ParkHistoryMetric> ParkHistory::ParseMetric(std::string_view name)
+{
+    if (name == "cash")
+        return ParkHistoryMetric::Cash;
+    if (name == "guests")
+        return ParkHistoryMetric::Guests;
+    if (name == "rating")
+        return ParkHistoryMetric::Rating;
+    if (name == "value")
+        return ParkHistoryMetric::ParkValue;
+    return std::nullopt;
+}
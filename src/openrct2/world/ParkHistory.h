@@ -0,0 +1,67 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "../core/TimeSeries.h"
+#include "../ride/RideTypes.h"
+
+#include <map>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+enum class ParkHistoryMetric : uint8_t
+{
+    Cash,
+    Guests,
+    Rating,
+    ParkValue,
+    Count,
+};
+
+/**
+ * The key statistics of the park sampled once a day for as long as the park runs, unlike the graph histories that
+ * only keep the last few months. Only park files (.park) store it, it is not part of the game state.
+ */
+class ParkHistory
+{
+private:
+    static constexpr uint32_t FormatVersion = 1;
+
+    OpenRCT2::TimeSeries _metrics[EnumValue(ParkHistoryMetric::Count)];
+    std::map<ride_id_t, OpenRCT2::TimeSeries> _rideIncome;
+
+public:
+    void Reset();
+
+    /**
+     * Appends the current values, called on the first tick of every day.
+     */
+    void Update();
+
+    const OpenRCT2::TimeSeries& GetMetric(ParkHistoryMetric metric) const;
+
+    /**
+     * The income per hour of a ride, nullptr for rides that have not been sampled yet.
+     */
+    const OpenRCT2::TimeSeries* GetRideIncome(ride_id_t rideId) const;
+
+    std::vector<uint8_t> Serialise() const;
+
+    /**
+     * Replaces the history with the serialised one, or resets it and returns false if the data is invalid.
+     */
+    bool Deserialise(const std::vector<uint8_t>& data);
+
+    static std::optional<ParkHistoryMetric> ParseMetric(std::string_view name);
+};
+
+extern ParkHistory gParkHistory;
@@ -18,22 +18,85 @@
 #include "../interface/Viewport.h"
 #include "../localisation/Date.h"
 #include "../localisation/Localisation.h"
+#include "../peep/GuestDensity.h"
 #include "../scenario/Scenario.h"
 #include "Fountain.h"
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <functional>
 #include <iterator>
+#include <memory>
 #include <numeric>
 #include <vector>
 
-static rct_sprite _spriteList[MAX_ENTITIES];
-static std::array<std::list<uint16_t>, EnumValue(EntityType::Count)> gEntityLists;
+/**
+ * Storage for the entities of one type. The slots are the size of that type rather than of rct_sprite and come in
+ * chunks which are never moved, so an entity keeps its address for as long as it exists.
+ */
+class EntityPool
+{
+private:
+    static constexpr size_t SlotsPerChunk = 256;
+
+    size_t _slotSize{};
+    std::vector<std::unique_ptr<uint8_t[]>> _chunks;
+    std::vector<uint8_t*> _freeSlots;
+
+public:
+    void* Allocate(size_t slotSize)
+    {
+        if (_freeSlots.empty())
+        {
+            _slotSize = slotSize;
+            auto& chunk = _chunks.emplace_back(std::make_unique<uint8_t[]>(SlotsPerChunk * slotSize));
+            for (size_t i = SlotsPerChunk; i > 0; i--)
+            {
+                _freeSlots.push_back(chunk.get() + (i - 1) * slotSize);
+            }
+        }
+        auto* slot = _freeSlots.back();
+        _freeSlots.pop_back();
+        return slot;
+    }
+
+    void Free(void* slot)
+    {
+        _freeSlots.push_back(static_cast<uint8_t*>(slot));
+    }
+
+    void Clear()
+    {
+        _chunks.clear();
+        _freeSlots.clear();
+    }
+
+    size_t GetMemoryUsage() const
+    {
+        return _chunks.size() * SlotsPerChunk * _slotSize + _freeSlots.capacity() * sizeof(uint8_t*);
+    }
+};
+
+// Every index points either at its entity in one of the pools or at its entry in _freeEntities while it is free
+static std::array<SpriteBase, MAX_ENTITIES> _freeEntities;
+static std::array<SpriteBase*, MAX_ENTITIES> _entities = [] {
+    std::array<SpriteBase*, MAX_ENTITIES> result{};
+    for (uint16_t i = 0; i < MAX_ENTITIES; i++)
+    {
+        _freeEntities[i].sprite_index = i;
+        _freeEntities[i].Type = EntityType::Null;
+        result[i] = &_freeEntities[i];
+    }
+    return result;
+}();
+static std::array<EntityPool, EnumValue(EntityType::Count)> _entityPools;
+static std::array<EntityIdSet, EnumValue(EntityType::Count)> gEntityLists;
 static std::vector<uint16_t> _freeIdList;
 
 static bool _spriteFlashingList[MAX_ENTITIES];
 
-static std::array<std::vector<uint16_t>, SPATIAL_INDEX_SIZE> gSpriteSpatialIndex;
+static EntitySpatialIndex gSpriteSpatialIndex;
 
 const rct_string_id litterNames[12] = { STR_LITTER_VOMIT,
                                         STR_LITTER_VOMIT,
@@ -48,26 +111,6 @@ const rct_string_id litterNames[12] = { STR_LITTER_VOMIT,
                                         STR_SHOP_ITEM_SINGULAR_EMPTY_JUICE_CUP,
                                         STR_SHOP_ITEM_SINGULAR_EMPTY_BOWL_BLUE };
 
-constexpr size_t GetSpatialIndexOffset(int32_t x, int32_t y)
-{
-    size_t index = SPATIAL_INDEX_LOCATION_NULL;
-    if (x != LOCATION_NULL)
-    {
-        x = std::clamp(x, 0, 0xFFFF);
-        y = std::clamp(y, 0, 0xFFFF);
-
-        int16_t flooredX = floor2(x, 32);
-        uint8_t tileY = y >> 5;
-        index = (flooredX << 3) | tileY;
-    }
-
-    if (index >= sizeof(gSpriteSpatialIndex))
-    {
-        return SPATIAL_INDEX_LOCATION_NULL;
-    }
-    return index;
-}
-
 // Required for GetEntity to return a default
 template<> bool SpriteBase::Is<SpriteBase>() const
 {
@@ -128,6 +171,58 @@ uint16_t GetNumFreeEntities()
     return static_cast<uint16_t>(_freeIdList.size());
 }
 
+size_t sprite_get_memory_usage()
+{
+    size_t result = sizeof(_freeEntities) + sizeof(_entities) + sizeof(_spriteFlashingList) + sizeof(gEntityLists)
+        + sizeof(gSpriteSpatialIndex) + _freeIdList.capacity() * sizeof(uint16_t);
+    for (const auto& pool : _entityPools)
+    {
+        result += pool.GetMemoryUsage();
+    }
+    return result;
+}
+
+size_t GetEntitySize(EntityType type)
+{
+    switch (type)
+    {
+        case EntityType::Vehicle:
+            return sizeof(Vehicle);
+        case EntityType::Guest:
+            return sizeof(Guest);
+        case EntityType::Staff:
+            return sizeof(Staff);
+        case EntityType::Litter:
+            return sizeof(Litter);
+        case EntityType::SteamParticle:
+            return sizeof(SteamParticle);
+        case EntityType::MoneyEffect:
+            return sizeof(MoneyEffect);
+        case EntityType::CrashedVehicleParticle:
+            return sizeof(VehicleCrashParticle);
+        case EntityType::ExplosionCloud:
+            return sizeof(ExplosionCloud);
+        case EntityType::CrashSplash:
+            return sizeof(CrashSplashParticle);
+        case EntityType::ExplosionFlare:
+            return sizeof(ExplosionFlare);
+        case EntityType::JumpingFountain:
+            return sizeof(JumpingFountain);
+        case EntityType::Balloon:
+            return sizeof(Balloon);
+        case EntityType::Duck:
+            return sizeof(Duck);
+        default:
+            return sizeof(SpriteBase);
+    }
+}
+
+void CopyEntityToSprite(const SpriteBase& entity, rct_sprite& sprite)
+{
+    std::memset(static_cast<void*>(&sprite), 0, sizeof(sprite));
+    std::memcpy(static_cast<void*>(&sprite), &entity, GetEntitySize(entity.Type));
+}
+
 std::string rct_sprite_checksum::ToString() const
 {
     std::string result;
@@ -145,7 +240,7 @@ std::string rct_sprite_checksum::ToString() const
 
 SpriteBase* try_get_sprite(size_t spriteIndex)
 {
-    return spriteIndex >= MAX_ENTITIES ? nullptr : &_spriteList[spriteIndex].misc;
+    return spriteIndex >= MAX_ENTITIES ? nullptr : _entities[spriteIndex];
 }
 
 SpriteBase* get_sprite(size_t spriteIndex)
@@ -158,14 +253,15 @@ SpriteBase* get_sprite(size_t spriteIndex)
     return try_get_sprite(spriteIndex);
 }
 
-const std::vector<uint16_t>& GetEntityTileList(const CoordsXY& spritePos)
+const EntitySpatialIndex& GetEntitySpatialIndex()
 {
-    return gSpriteSpatialIndex[GetSpatialIndexOffset(spritePos.x, spritePos.y)];
+    return gSpriteSpatialIndex;
 }
 
 void SpriteBase::Invalidate()
 {
-    if (sprite_left == LOCATION_NULL)
+    // The whole screen is redrawn after a batch of ticks
+    if (sprite_left == LOCATION_NULL || gOpenRCT2NoPresentation || gInTickBatch)
         return;
 
     int32_t maxZoom = 0;
@@ -201,6 +297,16 @@ void SpriteBase::Invalidate()
     viewports_invalidate(sprite_left, sprite_top, sprite_right, sprite_bottom, maxZoom);
 }
 
+static void ResetFreeEntity(uint16_t index)
+{
+    auto& entity = _freeEntities[index];
+    entity = {};
+    entity.sprite_index = index;
+    entity.Type = EntityType::Null;
+    _entities[index] = &entity;
+    _spriteFlashingList[index] = false;
+}
+
 static void ResetEntityLists()
 {
     for (auto& list : gEntityLists)
@@ -218,7 +324,7 @@ static void ResetFreeIds()
     std::iota(std::rbegin(_freeIdList), std::rend(_freeIdList), 0);
 }
 
-const std::list<uint16_t>& GetEntityList(const EntityType id)
+const EntityIdSet& GetEntityList(const EntityType id)
 {
     return gEntityLists[EnumValue(id)];
 }
@@ -230,19 +336,14 @@ const std::list<uint16_t>& GetEntityList(const EntityType id)
 void reset_sprite_list()
 {
     gSavedAge = 0;
-    std::memset(static_cast<void*>(_spriteList), 0, sizeof(_spriteList));
-    for (int32_t i = 0; i < MAX_ENTITIES; ++i)
+    GetPeepNamePool().Clear();
+    for (auto& pool : _entityPools)
     {
-        auto* spr = GetEntity(i);
-        if (spr == nullptr)
-        {
-            continue;
-        }
-
-        spr->Type = EntityType::Null;
-        spr->sprite_index = i;
-
-        _spriteFlashingList[i] = false;
+        pool.Clear();
+    }
+    for (uint16_t i = 0; i < MAX_ENTITIES; ++i)
+    {
+        ResetFreeEntity(i);
     }
     ResetEntityLists();
     ResetFreeIds();
@@ -259,10 +360,8 @@ static void SpriteSpatialInsert(SpriteBase* sprite, const CoordsXY& newLoc);
  */
 void reset_sprite_spatial_index()
 {
-    for (auto& vec : gSpriteSpatialIndex)
-    {
-        vec.clear();
-    }
+    gSpriteSpatialIndex.Clear();
+    GuestDensityClear();
     for (size_t i = 0; i < MAX_ENTITIES; i++)
     {
         auto* spr = GetEntity(i);
@@ -275,40 +374,136 @@ void reset_sprite_spatial_index()
 
 #ifndef DISABLE_NETWORK
 
-template<typename T> void ComputeChecksumForEntityType(Crypt::HashAlgorithm<20>* _entityHashAlg)
+/**
+ * Returns a copy of the entity without the fields that are not part of the game state.
+ */
+template<typename T> static T GetEntityForChecksum(const T* ent)
 {
-    for (auto* ent : EntityList<T>())
+    T copy = *ent;
+
+    // Only required for rendering/invalidation, has no meaning to the game state.
+    copy.sprite_left = copy.sprite_right = copy.sprite_top = copy.sprite_bottom = 0;
+    copy.sprite_width = copy.sprite_height_negative = copy.sprite_height_positive = 0;
+
+    if constexpr (std::is_base_of_v<Peep, T>)
     {
-        T copy = *ent;
+        // Name is a handle into the name pool and will not be the same across clients
+        copy.Name = {};
 
-        // Only required for rendering/invalidation, has no meaning to the game state.
-        copy.sprite_left = copy.sprite_right = copy.sprite_top = copy.sprite_bottom = 0;
-        copy.sprite_width = copy.sprite_height_negative = copy.sprite_height_positive = 0;
+        // We set this to 0 because as soon the client selects a guest the window will remove the
+        // invalidation flags causing the sprite checksum to be different than on server, the flag does not
+        // affect game state.
+        copy.WindowInvalidateFlags = 0;
+    }
+    return copy;
+}
 
-        if constexpr (std::is_base_of_v<Peep, T>)
+/**
+ * Non-cryptographic hash for EntityChecksumAlgorithm::Fast. The input is consumed in 32 byte stripes by four
+ * independent multiply and rotate lanes, which the compiler can keep in vector registers.
+ */
+class FastEntityHasher
+{
+private:
+    static constexpr uint64_t Prime1 = 0x9E3779B185EBCA87ULL;
+    static constexpr uint64_t Prime2 = 0xC2B2AE3D27D4EB4FULL;
+    static constexpr uint64_t Prime3 = 0x165667B19E3779F9ULL;
+    static constexpr size_t NumLanes = 4;
+
+    std::array<uint64_t, NumLanes> _lanes{ Prime1 + Prime2, Prime2, 0, 0 - Prime1 };
+    uint64_t _length{};
+
+    static constexpr uint64_t Rotate(uint64_t value, int32_t bits)
+    {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    static constexpr uint64_t Round(uint64_t lane, uint64_t input)
+    {
+        return Rotate(lane + input * Prime2, 31) * Prime1;
+    }
+
+    static constexpr uint64_t Avalanche(uint64_t hash)
+    {
+        hash ^= hash >> 33;
+        hash *= Prime2;
+        hash ^= hash >> 29;
+        hash *= Prime3;
+        return hash ^ (hash >> 32);
+    }
+
+    void UpdateStripe(const uint8_t* stripe)
+    {
+        for (size_t i = 0; i < NumLanes; i++)
         {
-            // Name is pointer and will not be the same across clients
-            copy.Name = {};
+            uint64_t word;
+            std::memcpy(&word, stripe + i * sizeof(word), sizeof(word));
+            _lanes[i] = Round(_lanes[i], word);
+        }
+    }
 
-            // We set this to 0 because as soon the client selects a guest the window will remove the
-            // invalidation flags causing the sprite checksum to be different than on server, the flag does not
-            // affect game state.
-            copy.WindowInvalidateFlags = 0;
+public:
+    void Update(const void* data, size_t size)
+    {
+        constexpr size_t stripeSize = NumLanes * sizeof(uint64_t);
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        size_t offset = 0;
+        for (; offset + stripeSize <= size; offset += stripeSize)
+        {
+            UpdateStripe(bytes + offset);
         }
 
-        _entityHashAlg->Update(&copy, sizeof(copy));
+        // Entities are hashed one at a time, so the tail of each is padded with zeroes to a full stripe
+        if (offset < size)
+        {
+            std::array<uint8_t, stripeSize> tail{};
+            std::memcpy(tail.data(), bytes + offset, size - offset);
+            UpdateStripe(tail.data());
+        }
+        _length += size;
+    }
+
+    rct_sprite_checksum Finish() const
+    {
+        const uint64_t a = Avalanche(
+            Rotate(_lanes[0], 1) + Rotate(_lanes[1], 7) + Rotate(_lanes[2], 12) + Rotate(_lanes[3], 18) + _length);
+        const uint64_t b = Avalanche(
+            Rotate(_lanes[0], 18) ^ Rotate(_lanes[1], 12) ^ Rotate(_lanes[2], 7) ^ Rotate(_lanes[3], 1) ^ (_length * Prime3));
+        const auto length = static_cast<uint32_t>(_length);
+
+        rct_sprite_checksum checksum{};
+        std::memcpy(checksum.raw.data(), &a, sizeof(a));
+        std::memcpy(checksum.raw.data() + sizeof(a), &b, sizeof(b));
+        std::memcpy(checksum.raw.data() + sizeof(a) + sizeof(b), &length, sizeof(length));
+        return checksum;
+    }
+};
+
+template<typename T, typename THasher> void ComputeChecksumForEntityType(THasher& hasher)
+{
+    for (auto* ent : EntityList<T>())
+    {
+        T copy = GetEntityForChecksum(ent);
+        hasher.Update(&copy, sizeof(copy));
     }
 }
 
-template<typename... T> void ComputeChecksumForEntityTypes(Crypt::HashAlgorithm<20>* _entityHashAlg)
+template<typename... T, typename THasher> void ComputeChecksumForEntityTypes(THasher& hasher)
 {
-    (ComputeChecksumForEntityType<T>(_entityHashAlg), ...);
+    (ComputeChecksumForEntityType<T>(hasher), ...);
 }
 
-rct_sprite_checksum sprite_checksum()
+rct_sprite_checksum sprite_checksum(EntityChecksumAlgorithm algorithm)
 {
     using namespace Crypt;
 
+    if (algorithm == EntityChecksumAlgorithm::Fast)
+    {
+        FastEntityHasher hasher;
+        ComputeChecksumForEntityTypes<Guest, Staff, Vehicle, Litter>(hasher);
+        return hasher.Finish();
+    }
+
     // TODO Remove statics, should be one of these per sprite manager / OpenRCT2 context.
     //      Alternatively, make a new class for this functionality.
     static std::unique_ptr<HashAlgorithm<20>> _spriteHashAlg;
@@ -324,7 +519,7 @@ rct_sprite_checksum sprite_checksum()
 
         _spriteHashAlg->Clear();
 
-        ComputeChecksumForEntityTypes<Guest, Staff, Vehicle, Litter>(_spriteHashAlg.get());
+        ComputeChecksumForEntityTypes<Guest, Staff, Vehicle, Litter>(*_spriteHashAlg);
 
         checksum.raw = _spriteHashAlg->Finish();
     }
@@ -336,22 +531,134 @@ rct_sprite_checksum sprite_checksum()
 
     return checksum;
 }
+
+/**
+ * State of the rolling checksum. Every entity contributes a hash of its game state, the contributions are summed
+ * so an entity can be replaced without touching the others. The game state of each entity as it was last hashed is
+ * kept to find the entities that changed since the previous checksum.
+ */
+struct RollingChecksumState
+{
+    std::unique_ptr<rct_sprite[]> HashedEntities = std::make_unique<rct_sprite[]>(MAX_ENTITIES);
+    std::array<uint64_t, MAX_ENTITIES> EntityHashes{};
+    EntityIdSet Hashed;
+    EntityIdSet Seen;
+    uint64_t Sum{};
+};
+
+static uint64_t HashEntityState(const void* data, size_t size)
+{
+    // Word based multiply and rotate hash, the contributions of all entities are summed so it has to mix well.
+    constexpr uint64_t Prime1 = 0x9E3779B185EBCA87ULL;
+    constexpr uint64_t Prime2 = 0xC2B2AE3D27D4EB4FULL;
+
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = Prime2 ^ size;
+    size_t offset = 0;
+    for (; offset + sizeof(uint64_t) <= size; offset += sizeof(uint64_t))
+    {
+        uint64_t word;
+        std::memcpy(&word, bytes + offset, sizeof(word));
+        hash ^= word * Prime2;
+        hash = ((hash << 31) | (hash >> 33)) * Prime1;
+    }
+    for (; offset < size; offset++)
+    {
+        hash ^= bytes[offset] * Prime1;
+        hash = ((hash << 11) | (hash >> 53)) * Prime2;
+    }
+
+    hash ^= hash >> 33;
+    hash *= Prime2;
+    hash ^= hash >> 29;
+    return hash;
+}
+
+template<typename T> static void UpdateRollingChecksumForEntityType(RollingChecksumState& state)
+{
+    for (auto* ent : EntityList<T>())
+    {
+        const auto index = ent->sprite_index;
+        state.Seen.insert(index);
+
+        T copy = GetEntityForChecksum(ent);
+        auto* hashed = &state.HashedEntities[index];
+        if (state.Hashed.contains(index))
+        {
+            // The entity type is part of the compared bytes, so a slot reused by another type is never missed.
+            if (std::memcmp(hashed, &copy, sizeof(copy)) == 0)
+                continue;
+
+            state.Sum -= state.EntityHashes[index];
+        }
+
+        std::memcpy(static_cast<void*>(hashed), &copy, sizeof(copy));
+        state.EntityHashes[index] = HashEntityState(&copy, sizeof(copy));
+        state.Sum += state.EntityHashes[index];
+        state.Hashed.insert(index);
+    }
+}
+
+template<typename... T> static void UpdateRollingChecksumForEntityTypes(RollingChecksumState& state)
+{
+    (UpdateRollingChecksumForEntityType<T>(state), ...);
+}
+
+/**
+ * Checksum of the same entities as sprite_checksum which only hashes the entities that changed since it was last
+ * requested. The result differs from sprite_checksum, which stays the reference for replays.
+ */
+rct_sprite_checksum sprite_checksum_rolling(bool fullRecompute)
+{
+    // TODO Remove statics, should be one of these per sprite manager / OpenRCT2 context.
+    static std::unique_ptr<RollingChecksumState> _state;
+    if (_state == nullptr || fullRecompute)
+    {
+        _state = std::make_unique<RollingChecksumState>();
+    }
+
+    auto& state = *_state;
+    state.Seen.clear();
+    UpdateRollingChecksumForEntityTypes<Guest, Staff, Vehicle, Litter>(state);
+
+    // Drop the entities that were removed or changed to a type that is not part of the checksum.
+    for (auto it = state.Hashed.begin(); it != state.Hashed.end();)
+    {
+        const auto index = *it++;
+        if (!state.Seen.contains(index))
+        {
+            state.Sum -= state.EntityHashes[index];
+            state.Hashed.erase(index);
+        }
+    }
+
+    rct_sprite_checksum checksum{};
+    const auto count = static_cast<uint32_t>(state.Hashed.size());
+    std::memcpy(checksum.raw.data(), &state.Sum, sizeof(state.Sum));
+    std::memcpy(checksum.raw.data() + sizeof(state.Sum), &count, sizeof(count));
+    return checksum;
+}
 #else
 
-rct_sprite_checksum sprite_checksum()
+rct_sprite_checksum sprite_checksum(EntityChecksumAlgorithm)
+{
+    return rct_sprite_checksum{};
+}
+
+rct_sprite_checksum sprite_checksum_rolling(bool)
 {
     return rct_sprite_checksum{};
 }
 
 #endif // DISABLE_NETWORK
 
-static void sprite_reset(SpriteBase* sprite)
+static void sprite_reset(SpriteBase* sprite, size_t size)
 {
     // Need to retain how the sprite is linked in lists
     uint16_t sprite_index = sprite->sprite_index;
     _spriteFlashingList[sprite_index] = false;
 
-    std::memset(sprite, 0, sizeof(rct_sprite));
+    std::memset(static_cast<void*>(sprite), 0, size);
 
     sprite->sprite_index = sprite_index;
     sprite->Type = EntityType::Null;
@@ -365,23 +672,15 @@ void sprite_clear_all_unused()
 {
     for (auto index : _freeIdList)
     {
-        auto* entity = GetEntity(index);
-        if (entity == nullptr)
-        {
-            continue;
-        }
-        sprite_reset(entity);
-
-        _spriteFlashingList[entity->sprite_index] = false;
+        ResetFreeEntity(index);
     }
 }
 
 static constexpr uint16_t MAX_MISC_SPRITES = 300;
 static void AddToEntityList(SpriteBase* entity)
 {
-    auto& list = gEntityLists[EnumValue(entity->Type)];
-    // Entity list must be in sprite_index order to prevent desync issues
-    list.insert(std::lower_bound(std::begin(list), std::end(list), entity->sprite_index), entity->sprite_index);
+    // Entity lists always iterate in sprite_index order which prevents desync issues
+    gEntityLists[EnumValue(entity->Type)].insert(entity->sprite_index);
 }
 
 static void AddToFreeList(uint16_t index)
@@ -392,12 +691,7 @@ static void AddToFreeList(uint16_t index)
 
 static void RemoveFromEntityList(SpriteBase* entity)
 {
-    auto& list = gEntityLists[EnumValue(entity->Type)];
-    auto ptr = std::lower_bound(std::begin(list), std::end(list), entity->sprite_index);
-    if (ptr != std::end(list) && *ptr == entity->sprite_index)
-    {
-        list.erase(ptr);
-    }
+    gEntityLists[EnumValue(entity->Type)].erase(entity->sprite_index);
 }
 
 uint16_t GetMiscEntityCount()
@@ -412,12 +706,24 @@ uint16_t GetMiscEntityCount()
     return count;
 }
 
-static void PrepareNewEntity(SpriteBase* base, const EntityType type)
+/**
+ * Moves the index from its free entity to a slot in the pool of the type.
+ */
+static SpriteBase* AllocateEntity(const uint16_t index, const EntityType type)
 {
+    const auto size = GetEntitySize(type);
+    auto* base = static_cast<SpriteBase*>(_entityPools[EnumValue(type)].Allocate(size));
+    base->sprite_index = index;
+    _entities[index] = base;
+
     // Need to reset all sprite data, as the uninitialised values
     // may contain garbage and cause a desync later on.
-    sprite_reset(base);
+    sprite_reset(base, size);
+    return base;
+}
 
+static void PrepareNewEntity(SpriteBase* base, const EntityType type)
+{
     base->Type = type;
     AddToEntityList(base);
 
@@ -433,7 +739,7 @@ static void PrepareNewEntity(SpriteBase* base, const EntityType type)
     SpriteSpatialInsert(base, { LOCATION_NULL, 0 });
 }
 
-rct_sprite* create_sprite(EntityType type)
+SpriteBase* create_sprite(EntityType type)
 {
     if (_freeIdList.size() == 0)
     {
@@ -453,16 +759,12 @@ rct_sprite* create_sprite(EntityType type)
         }
     }
 
-    auto* sprite = GetEntity(_freeIdList.back());
-    if (sprite == nullptr)
-    {
-        return nullptr;
-    }
+    auto* sprite = AllocateEntity(_freeIdList.back(), type);
     _freeIdList.pop_back();
 
     PrepareNewEntity(sprite, type);
 
-    return reinterpret_cast<rct_sprite*>(sprite);
+    return sprite;
 }
 
 SpriteBase* CreateEntityAt(const uint16_t index, const EntityType type)
@@ -473,14 +775,9 @@ SpriteBase* CreateEntityAt(const uint16_t index, const EntityType type)
         return nullptr;
     }
 
-    auto* entity = GetEntity(index);
-    if (entity == nullptr)
-    {
-        return nullptr;
-    }
-
     _freeIdList.erase(std::next(id).base());
 
+    auto* entity = AllocateEntity(index, type);
     PrepareNewEntity(entity, type);
     return entity;
 }
@@ -591,23 +888,32 @@ void sprite_misc_update_all()
         Balloon, Duck>();
 }
 
-// Performs a search to ensure that insert keeps next_in_quadrant in sprite_index order
+// The spatial index keeps each tile in sprite_index order, matching next_in_quadrant
 static void SpriteSpatialInsert(SpriteBase* sprite, const CoordsXY& newLoc)
 {
-    size_t newIndex = GetSpatialIndexOffset(newLoc.x, newLoc.y);
-    auto& spatialVector = gSpriteSpatialIndex[newIndex];
-    auto index = std::lower_bound(std::begin(spatialVector), std::end(spatialVector), sprite->sprite_index);
-    spatialVector.insert(index, sprite->sprite_index);
+    auto cell = EntitySpatialIndex::GetCellIndex(newLoc.x, newLoc.y);
+    if (sprite->Type == EntityType::Guest)
+    {
+        if (gSpriteSpatialIndex.Contains(sprite->sprite_index))
+        {
+            GuestDensityRemove(gSpriteSpatialIndex.GetEntityCell(sprite->sprite_index));
+        }
+        GuestDensityInsert(cell);
+    }
+    gSpriteSpatialIndex.Insert(sprite->sprite_index, cell);
 }
 
 static void SpriteSpatialRemove(SpriteBase* sprite)
 {
-    size_t currentIndex = GetSpatialIndexOffset(sprite->x, sprite->y);
-    auto& spatialVector = gSpriteSpatialIndex[currentIndex];
-    auto index = std::lower_bound(std::begin(spatialVector), std::end(spatialVector), sprite->sprite_index);
-    if (index != std::end(spatialVector) && *index == sprite->sprite_index)
+    size_t currentIndex = EntitySpatialIndex::GetCellIndex(sprite->x, sprite->y);
+    if (gSpriteSpatialIndex.Contains(sprite->sprite_index)
+        && gSpriteSpatialIndex.GetEntityCell(sprite->sprite_index) == currentIndex)
     {
-        spatialVector.erase(index, index + 1);
+        gSpriteSpatialIndex.Remove(sprite->sprite_index);
+        if (sprite->Type == EntityType::Guest)
+        {
+            GuestDensityRemove(currentIndex);
+        }
     }
     else
     {
@@ -618,8 +924,8 @@ static void SpriteSpatialRemove(SpriteBase* sprite)
 
 static void SpriteSpatialMove(SpriteBase* sprite, const CoordsXY& newLoc)
 {
-    size_t newIndex = GetSpatialIndexOffset(newLoc.x, newLoc.y);
-    size_t currentIndex = GetSpatialIndexOffset(sprite->x, sprite->y);
+    size_t newIndex = EntitySpatialIndex::GetCellIndex(newLoc.x, newLoc.y);
+    size_t currentIndex = EntitySpatialIndex::GetCellIndex(sprite->x, sprite->y);
     if (newIndex == currentIndex)
         return;
 
@@ -686,7 +992,8 @@ void sprite_set_coordinates(const CoordsXYZ& spritePos, SpriteBase* sprite)
  *
  *  rct2: 0x0069EDB6
  */
-void sprite_remove(SpriteBase* sprite)
+// Everything sprite_remove does apart from putting the id back on the free list
+static void RemoveEntity(SpriteBase* sprite)
 {
     auto peep = sprite->As<Peep>();
     if (peep != nullptr)
@@ -696,10 +1003,42 @@ void sprite_remove(SpriteBase* sprite)
 
     EntityTweener::Get().RemoveEntity(sprite);
     RemoveFromEntityList(sprite); // remove from existing list
-    AddToFreeList(sprite->sprite_index);
 
     SpriteSpatialRemove(sprite);
-    sprite_reset(sprite);
+
+    // Anything still holding the pointer finds a free entity, the same as before entities had their own pools
+    const auto index = sprite->sprite_index;
+    const auto type = sprite->Type;
+    sprite_reset(sprite, GetEntitySize(type));
+    if (type < EntityType::Count)
+    {
+        _entityPools[EnumValue(type)].Free(sprite);
+    }
+    ResetFreeEntity(index);
+}
+
+void sprite_remove(SpriteBase* sprite)
+{
+    const auto index = sprite->sprite_index;
+    RemoveEntity(sprite);
+    AddToFreeList(index);
+}
+
+void sprite_remove_many(const std::vector<SpriteBase*>& sprites)
+{
+    std::vector<uint16_t> freedIds;
+    freedIds.reserve(sprites.size());
+    for (auto* sprite : sprites)
+    {
+        freedIds.push_back(sprite->sprite_index);
+        RemoveEntity(sprite);
+    }
+
+    // Ends up in the same order as adding them one at a time, the free list is in reverse sprite_index order
+    std::sort(freedIds.begin(), freedIds.end(), std::greater<>());
+    const auto oldSize = static_cast<std::ptrdiff_t>(_freeIdList.size());
+    _freeIdList.insert(_freeIdList.end(), freedIds.begin(), freedIds.end());
+    std::inplace_merge(_freeIdList.begin(), _freeIdList.begin() + oldSize, _freeIdList.end(), std::greater<>());
 }
 
 static bool litter_can_be_at(const CoordsXYZ& mapPos)
@@ -805,44 +1144,46 @@ void litter_remove_at(const CoordsXYZ& litterPos)
  */
 uint16_t remove_floating_sprites()
 {
-    uint16_t removed = 0;
+    std::vector<SpriteBase*> removals;
     for (auto* balloon : EntityList<Balloon>())
     {
-        sprite_remove(balloon);
-        removed++;
+        removals.push_back(balloon);
     }
     for (auto* duck : EntityList<Duck>())
     {
         if (duck->IsFlying())
         {
-            sprite_remove(duck);
-            removed++;
+            removals.push_back(duck);
         }
     }
     for (auto* money : EntityList<MoneyEffect>())
     {
-        sprite_remove(money);
-        removed++;
+        removals.push_back(money);
     }
-    return removed;
+    sprite_remove_many(removals);
+    return static_cast<uint16_t>(removals.size());
+}
+
+void EntityTweener::AddEntity(SpriteBase* entity)
+{
+    Indices[entity->sprite_index] = static_cast<uint16_t>(Entities.size());
+    Entities.push_back(entity);
+    PrePos.emplace_back(entity->x, entity->y, entity->z);
 }
 
 void EntityTweener::PopulateEntities()
 {
     for (auto ent : EntityList<Guest>())
     {
-        Entities.push_back(ent);
-        PrePos.emplace_back(ent->x, ent->y, ent->z);
+        AddEntity(ent);
     }
     for (auto ent : EntityList<Staff>())
     {
-        Entities.push_back(ent);
-        PrePos.emplace_back(ent->x, ent->y, ent->z);
+        AddEntity(ent);
     }
     for (auto ent : EntityList<Vehicle>())
     {
-        Entities.push_back(ent);
-        PrePos.emplace_back(ent->x, ent->y, ent->z);
+        AddEntity(ent);
     }
 }
 
@@ -855,18 +1196,29 @@ void EntityTweener::PreTick()
 
 void EntityTweener::PostTick()
 {
-    for (auto* ent : Entities)
+    // Drop the entities that were removed or did not move, most of them on a quiet tick
+    size_t count = 0;
+    for (size_t i = 0; i < Entities.size(); i++)
     {
+        auto* ent = Entities[i];
         if (ent == nullptr)
+            continue;
+
+        CoordsXYZ postPos{ ent->x, ent->y, ent->z };
+        if (postPos == PrePos[i])
         {
-            // Sprite was removed, add a dummy position to keep the index aligned.
-            PostPos.emplace_back(0, 0, 0);
-        }
-        else
-        {
-            PostPos.emplace_back(ent->x, ent->y, ent->z);
+            Indices[ent->sprite_index] = NoIndex;
+            continue;
         }
+
+        Indices[ent->sprite_index] = static_cast<uint16_t>(count);
+        Entities[count] = ent;
+        PrePos[count] = PrePos[i];
+        PostPos.push_back(postPos);
+        count++;
     }
+    Entities.resize(count);
+    PrePos.resize(count);
 }
 
 void EntityTweener::RemoveEntity(SpriteBase* entity)
@@ -877,14 +1229,18 @@ void EntityTweener::RemoveEntity(SpriteBase* entity)
         return;
     }
 
-    auto it = std::find(Entities.begin(), Entities.end(), entity);
-    if (it != Entities.end())
-        *it = nullptr;
+    auto index = Indices[entity->sprite_index];
+    if (index != NoIndex && Entities[index] == entity)
+    {
+        Entities[index] = nullptr;
+        Indices[entity->sprite_index] = NoIndex;
+    }
 }
 
 void EntityTweener::Tween(float alpha)
 {
     const float inv = (1.0f - alpha);
+    const auto rotation = get_current_rotation();
     for (size_t i = 0; i < Entities.size(); ++i)
     {
         auto* ent = Entities[i];
@@ -893,15 +1249,23 @@ void EntityTweener::Tween(float alpha)
 
         auto& posA = PrePos[i];
         auto& posB = PostPos[i];
-
-        if (posA == posB)
+        CoordsXYZ pos{ static_cast<int32_t>(std::round(posB.x * alpha + posA.x * inv)),
+                       static_cast<int32_t>(std::round(posB.y * alpha + posA.y * inv)),
+                       static_cast<int32_t>(std::round(posB.z * alpha + posA.z * inv)) };
+
+        // Entities that cannot be seen where they are or where they are going are left until Restore
+        auto screenCoords = translate_3d_to_2d_with_z(rotation, pos);
+        bool wasVisible = ent->sprite_left != LOCATION_NULL
+            && viewports_intersect(ent->sprite_left, ent->sprite_top, ent->sprite_right, ent->sprite_bottom);
+        if (!wasVisible
+            && !viewports_intersect(
+                screenCoords.x - ent->sprite_width, screenCoords.y - ent->sprite_height_negative,
+                screenCoords.x + ent->sprite_width, screenCoords.y + ent->sprite_height_positive))
+        {
             continue;
+        }
 
-        sprite_set_coordinates(
-            { static_cast<int32_t>(std::round(posB.x * alpha + posA.x * inv)),
-              static_cast<int32_t>(std::round(posB.y * alpha + posA.y * inv)),
-              static_cast<int32_t>(std::round(posB.z * alpha + posA.z * inv)) },
-            ent);
+        sprite_set_coordinates(pos, ent);
         ent->Invalidate();
     }
 }
@@ -921,6 +1285,11 @@ void EntityTweener::Restore()
 
 void EntityTweener::Reset()
 {
+    for (auto* ent : Entities)
+    {
+        if (ent != nullptr)
+            Indices[ent->sprite_index] = NoIndex;
+    }
     Entities.clear();
     PrePos.clear();
     PostPos.clear();
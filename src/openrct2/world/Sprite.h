@@ -14,9 +14,13 @@
 #include "../peep/Peep.h"
 #include "../ride/Vehicle.h"
 #include "Entity.h"
+#include "EntitySpatialIndex.h"
 #include "Fountain.h"
 #include "SpriteBase.h"
 
+#include <limits>
+#include <vector>
+
 enum LitterType : uint8_t;
 
 struct Litter : SpriteBase
@@ -184,15 +188,12 @@ enum LitterType : uint8_t
     LITTER_TYPE_EMPTY_BOWL_BLUE,
 };
 
-constexpr const uint32_t SPATIAL_INDEX_SIZE = (MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL) + 1;
-constexpr const uint32_t SPATIAL_INDEX_LOCATION_NULL = SPATIAL_INDEX_SIZE - 1;
-
 extern const rct_string_id litterNames[12];
 
-rct_sprite* create_sprite(EntityType type);
+SpriteBase* create_sprite(EntityType type);
 template<typename T> T* CreateEntity()
 {
-    return reinterpret_cast<T*>(create_sprite(T::cEntityType));
+    return static_cast<T*>(create_sprite(T::cEntityType));
 }
 
 // Use only with imports that must happen at a specified index
@@ -205,9 +206,23 @@ template<typename T> T* CreateEntityAt(const uint16_t index)
 void reset_sprite_list();
 void reset_sprite_spatial_index();
 void sprite_clear_all_unused();
+size_t sprite_get_memory_usage();
+
+/**
+ * Entities are stored in pools of their own type, so only GetEntitySize(entity.Type) bytes of one are valid.
+ * CopyEntityToSprite gives the rct_sprite layout for code that still needs it, padded with zeroes.
+ */
+size_t GetEntitySize(EntityType type);
+void CopyEntityToSprite(const SpriteBase& entity, rct_sprite& sprite);
 void sprite_misc_update_all();
 void sprite_set_coordinates(const CoordsXYZ& spritePos, SpriteBase* sprite);
 void sprite_remove(SpriteBase* sprite);
+
+/**
+ * The same as calling sprite_remove on each entity, but the freed ids are merged into the free list in one go instead
+ * of one sorted insert each. Every entity may only be given once.
+ */
+void sprite_remove_many(const std::vector<SpriteBase*>& sprites);
 void litter_create(const CoordsXYZD& litterPos, LitterType type);
 void litter_remove_at(const CoordsXYZ& litterPos);
 uint16_t remove_floating_sprites();
@@ -233,19 +248,40 @@ void duck_remove_all();
 void crashed_vehicle_particle_create(rct_vehicle_colour colours, const CoordsXYZ& vehiclePos);
 void crash_splash_create(const CoordsXYZ& splashPos);
 
-rct_sprite_checksum sprite_checksum();
+/**
+ * How sprite_checksum hashes the entities. Replays store the checksums they were recorded with, so the
+ * SHA1 version stays for playing back old recordings.
+ */
+enum class EntityChecksumAlgorithm : uint8_t
+{
+    Sha1,
+    Fast,
+};
+
+rct_sprite_checksum sprite_checksum(EntityChecksumAlgorithm algorithm = EntityChecksumAlgorithm::Sha1);
+rct_sprite_checksum sprite_checksum_rolling(bool fullRecompute = false);
 
 void sprite_set_flashing(SpriteBase* sprite, bool flashing);
 bool sprite_get_flashing(SpriteBase* sprite);
 
+/**
+ * Moves the peeps and vehicles between their positions before and after the last tick on frames drawn between
+ * ticks. Only the entities that moved in the tick are kept, Tween only moves the ones that can be seen in a viewport
+ * and Restore puts them all back where the tick left them before the next one runs.
+ */
 class EntityTweener
 {
+    static constexpr uint16_t NoIndex = std::numeric_limits<uint16_t>::max();
+
     std::vector<SpriteBase*> Entities;
     std::vector<CoordsXYZ> PrePos;
     std::vector<CoordsXYZ> PostPos;
+    // Index into Entities for each sprite index, so entities can be removed without a search
+    std::vector<uint16_t> Indices = std::vector<uint16_t>(MAX_ENTITIES, NoIndex);
 
 private:
     void PopulateEntities();
+    void AddEntity(SpriteBase* entity);
 
 public:
     static EntityTweener& Get();
@@ -0,0 +1,163 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TileChanges.h"
+
+#include "../Diagnostic.h"
+#include "Map.h"
+
+#include <bitset>
+#include <unordered_map>
+
+static constexpr int32_t NumTiles = MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL;
+
+static uint8_t _consumers;
+static uint32_t _version;
+static TileChanges _changes;
+static std::bitset<NumTiles> _marked;
+
+// First element of each tile to the index of the tile, built on the first removal after the tile
+// pointers changed
+static std::unordered_map<const TileElement*, int32_t> _index;
+static bool _indexValid;
+
+static void ClearChanges()
+{
+    // MarkAll already cleared the marks of the tiles it replaced
+    for (const auto& tilePos : _changes.Tiles)
+    {
+        _marked[tilePos.y * MAXIMUM_MAP_SIZE_TECHNICAL + tilePos.x] = false;
+    }
+    _changes = {};
+}
+
+void TileChangesSetConsumer(TileChangesConsumer consumer, bool enabled)
+{
+    auto wasEnabled = TileChangesIsEnabled();
+    if (enabled)
+        _consumers |= static_cast<uint8_t>(consumer);
+    else
+        _consumers &= ~static_cast<uint8_t>(consumer);
+
+    if (wasEnabled != TileChangesIsEnabled())
+    {
+        ClearChanges();
+        TileChangesInvalidateIndex();
+    }
+}
+
+bool TileChangesIsConsumerEnabled(TileChangesConsumer consumer)
+{
+    return (_consumers & static_cast<uint8_t>(consumer)) != 0;
+}
+
+bool TileChangesIsEnabled()
+{
+    return _consumers != 0;
+}
+
+static void MarkIndex(int32_t index)
+{
+    if (_changes.All || _marked[index])
+        return;
+
+    _marked[index] = true;
+    _changes.Tiles.emplace_back(index % MAXIMUM_MAP_SIZE_TECHNICAL, index / MAXIMUM_MAP_SIZE_TECHNICAL);
+}
+
+uint32_t TileChangesGetVersion()
+{
+    return _version;
+}
+
+void TileChangesMarkTile(const TileCoordsXY& tilePos)
+{
+    _version++;
+    if (!TileChangesIsEnabled())
+        return;
+    if (tilePos.x < 0 || tilePos.y < 0 || tilePos.x >= MAXIMUM_MAP_SIZE_TECHNICAL || tilePos.y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+        return;
+
+    MarkIndex(tilePos.y * MAXIMUM_MAP_SIZE_TECHNICAL + tilePos.x);
+}
+
+void TileChangesMarkElement(const TileElement* tileElement)
+{
+    _version++;
+    if (!TileChangesIsEnabled() || _changes.All)
+        return;
+
+    if (!_indexValid)
+    {
+        _index.clear();
+        _index.reserve(NumTiles);
+        for (int32_t i = 0; i < NumTiles; i++)
+        {
+            _index.emplace(gTileElementTilePointers[i], i);
+        }
+        _indexValid = true;
+    }
+
+    // The element before the first element of a tile is always the last element of a tile, either a
+    // live one or the copy left behind when a tile was moved
+    auto firstElement = tileElement;
+    while (firstElement > gTileElements && !(firstElement - 1)->IsLastForTile())
+    {
+        firstElement--;
+    }
+
+    auto it = _index.find(firstElement);
+    if (it != _index.end())
+    {
+        MarkIndex(it->second);
+    }
+    else
+    {
+        log_verbose("Unable to find the tile of element %p", static_cast<const void*>(tileElement));
+        TileChangesMarkAll();
+    }
+}
+
+void TileChangesMoveTile(const TileCoordsXY& tilePos, const TileElement* oldElements, const TileElement* newElements)
+{
+    _version++;
+    if (!TileChangesIsEnabled())
+        return;
+
+    TileChangesMarkTile(tilePos);
+    if (_indexValid)
+    {
+        _index.erase(oldElements);
+        _index[newElements] = tilePos.y * MAXIMUM_MAP_SIZE_TECHNICAL + tilePos.x;
+    }
+}
+
+void TileChangesMarkAll()
+{
+    _version++;
+    if (!TileChangesIsEnabled())
+        return;
+
+    ClearChanges();
+    _changes.All = true;
+}
+
+void TileChangesInvalidateIndex()
+{
+    _version++;
+    _indexValid = false;
+    _index.clear();
+}
+
+TileChanges TileChangesTake()
+{
+    auto changes = std::move(_changes);
+    ClearChanges();
+    return changes;
+}
@@ -0,0 +1,80 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "Location.hpp"
+
+#include <vector>
+
+struct TileElement;
+
+/*
+ * Records the tiles whose elements were inserted, removed or modified by a game action, so plugins
+ * and external tools can mirror the map by only reading the tiles that changed each tick. Nothing
+ * is recorded unless a consumer is enabled.
+ */
+enum class TileChangesConsumer : uint8_t
+{
+    Scripts = 1 << 0,
+    Console = 1 << 1,
+    MapWindow = 1 << 2,
+    MapTiles = 1 << 3,
+};
+
+struct TileChanges
+{
+    // Set when the whole map was replaced, Tiles is empty in that case.
+    bool All{};
+    // Each tile only once, in the order they were first changed.
+    std::vector<TileCoordsXY> Tiles;
+
+    bool IsEmpty() const
+    {
+        return !All && Tiles.empty();
+    }
+};
+
+void TileChangesSetConsumer(TileChangesConsumer consumer, bool enabled);
+bool TileChangesIsConsumerEnabled(TileChangesConsumer consumer);
+bool TileChangesIsEnabled();
+
+/**
+ * Goes up on every change that is marked, even when nothing is recorded, so caches of what is on the map can tell
+ * when to throw away their contents.
+ */
+uint32_t TileChangesGetVersion();
+
+void TileChangesMarkTile(const TileCoordsXY& tilePos);
+
+/**
+ * Marks the tile of an element, which is looked up from the first element of its tile as elements
+ * do not know their position.
+ */
+void TileChangesMarkElement(const TileElement* tileElement);
+
+/**
+ * Marks the tile and moves it in the lookup used by TileChangesMarkElement, for when the elements
+ * of a tile are moved to another place in gTileElements.
+ */
+void TileChangesMoveTile(const TileCoordsXY& tilePos, const TileElement* oldElements, const TileElement* newElements);
+
+void TileChangesMarkAll();
+
+/**
+ * Has to be called whenever the tile pointers are rebuilt or replaced. Also bumps the version, as elements may have
+ * moved.
+ */
+void TileChangesInvalidateIndex();
+
+/**
+ * Returns the changes since the last call and clears them, called once at the end of each tick.
+ */
+TileChanges TileChangesTake();
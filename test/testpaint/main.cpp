@@ -11,11 +11,13 @@
 #include <cstdarg>
 #include <cstdio>
 #include <cstring>
+#include <fstream>
 #include <string>
 #include <vector>
 
 #if defined(__unix__)
 #    include <sys/mman.h>
+#    include <sys/wait.h>
 #    include <unistd.h>
 #endif // defined(__unix__)
 
@@ -36,6 +38,12 @@ struct TestCase
     std::vector<uint8_t> trackTypes;
 };
 
+struct TestResult
+{
+    int retVal = TEST_FAILED;
+    std::string output;
+};
+
 enum CLIColour
 {
     DEFAULT,
@@ -449,6 +457,151 @@ static void TestGeneralSupportHeightCall()
     assert(!success);
 }
 
+static std::string GetFileNameWithoutExtension(const std::string& path)
+{
+    auto start = path.find_last_of("/\\");
+    start = start == std::string::npos ? 0 : start + 1;
+    auto end = path.find_last_of('.');
+    if (end == std::string::npos || end < start)
+    {
+        end = path.size();
+    }
+    return path.substr(start, end - start);
+}
+
+/**
+ * Reads a list of changed files, one path per line as given by git diff --name-only, and marks the ride types whose
+ * paint code they touch. Files shared by several ride types, such as the supports or the track paint helpers, mark
+ * all of them.
+ * @returns false if the list could not be read.
+ */
+static bool GetChangedRideTypes(const char* listPath, std::vector<bool>& rideTypes)
+{
+    std::ifstream list(listPath);
+    if (!list.is_open())
+    {
+        fprintf(stderr, "Unable to read changed files from %s\n", listPath);
+        return false;
+    }
+
+    rideTypes.assign(RCT2_RIDE_TYPE_COUNT, false);
+    std::string path;
+    while (std::getline(list, path))
+    {
+        std::replace(path.begin(), path.end(), '\\', '/');
+        if (path.find("src/openrct2/ride/") == std::string::npos && path.find("src/openrct2/paint/") == std::string::npos
+            && path.find("test/testpaint/") == std::string::npos)
+        {
+            continue;
+        }
+
+        bool matched = false;
+        auto name = GetFileNameWithoutExtension(path);
+        for (uint8_t rideType = 0; rideType < RCT2_RIDE_TYPE_COUNT; rideType++)
+        {
+            if (path.find("src/openrct2/ride/") != std::string::npos && CStringEquals(RideNames[rideType], name.c_str()))
+            {
+                rideTypes[rideType] = true;
+                matched = true;
+            }
+        }
+        if (!matched)
+        {
+            rideTypes.assign(RCT2_RIDE_TYPE_COUNT, true);
+            break;
+        }
+    }
+    return true;
+}
+
+static TestResult RunTest(uint8_t rideType, uint8_t trackType)
+{
+    TestResult result;
+    result.retVal = TestTrack::TestPaintTrackElement(rideType, trackType, &result.output);
+    return result;
+}
+
+#if defined(__unix__)
+/**
+ * Runs the tests in forked workers which each get their own copy of the paint state. Tests are dealt out in turn so
+ * the long and short ones spread evenly, and each worker writes its results to a temporary file read back once it
+ * exits.
+ */
+static void RunTestsInWorkers(
+    const std::vector<std::pair<uint8_t, uint8_t>>& tests, std::vector<TestResult>& results, int jobs)
+{
+    std::vector<FILE*> files;
+    std::vector<pid_t> workers;
+    for (int job = 0; job < jobs; job++)
+    {
+        FILE* file = tmpfile();
+        if (file == nullptr)
+        {
+            perror("tmpfile");
+            break;
+        }
+
+        fflush(stdout);
+        pid_t pid = fork();
+        if (pid == -1)
+        {
+            perror("fork");
+            fclose(file);
+            break;
+        }
+        if (pid == 0)
+        {
+            for (size_t i = job; i < tests.size(); i += jobs)
+            {
+                auto result = RunTest(tests[i].first, tests[i].second);
+                uint32_t header[3] = { (uint32_t)i, (uint32_t)result.retVal, (uint32_t)result.output.size() };
+                fwrite(header, sizeof(header), 1, file);
+                fwrite(result.output.data(), 1, result.output.size(), file);
+            }
+            fflush(file);
+            _exit(0);
+        }
+        files.push_back(file);
+        workers.push_back(pid);
+    }
+
+    for (size_t job = 0; job < workers.size(); job++)
+    {
+        int status = 0;
+        waitpid(workers[job], &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        {
+            fprintf(stderr, "Test worker %d did not exit cleanly, its remaining tests are reported as failed.\n", (int)job);
+        }
+
+        FILE* file = files[job];
+        rewind(file);
+        uint32_t header[3];
+        while (fread(header, sizeof(header), 1, file) == 1 && header[0] < results.size())
+        {
+            auto& result = results[header[0]];
+            result.retVal = (int)header[1];
+            result.output.resize(header[2]);
+            if (header[2] != 0 && fread(&result.output[0], 1, header[2], file) != header[2])
+            {
+                result.retVal = TEST_FAILED;
+                break;
+            }
+        }
+        fclose(file);
+    }
+
+    // Workers that could not be started leave their tests to this process
+    for (size_t i = 0; i < tests.size(); i++)
+    {
+        if ((int)(i % jobs) >= (int)workers.size())
+        {
+            results[i] = RunTest(tests[i].first, tests[i].second);
+        }
+    }
+}
+#endif // defined(__unix__)
+
 int main(int argc, char* argv[])
 {
 #if !defined(__i386__)
@@ -461,6 +614,8 @@ int main(int argc, char* argv[])
 
     bool generate = false;
     uint8_t specificRideType = 0xFF;
+    int jobs = 1;
+    std::vector<bool> changedRideTypes;
     for (int i = 0; i < argc; ++i)
     {
         char* arg = argv[i];
@@ -489,6 +644,19 @@ int main(int argc, char* argv[])
         {
             generate = true;
         }
+        else if (strcmp(arg, "--jobs") == 0 && i + 1 < argc)
+        {
+            i++;
+            jobs = std::max(1, atoi(argv[i]));
+        }
+        else if (strcmp(arg, "--changed-files") == 0 && i + 1 < argc)
+        {
+            i++;
+            if (!GetChangedRideTypes(argv[i], changedRideTypes))
+            {
+                return 1;
+            }
+        }
     }
 
     if (generate)
@@ -517,6 +685,11 @@ int main(int argc, char* argv[])
             continue;
         }
 
+        if (!changedRideTypes.empty() && !changedRideTypes[rideType])
+        {
+            continue;
+        }
+
         TestCase testCase = {};
         testCase.rideType = rideType;
 
@@ -553,7 +726,32 @@ int main(int argc, char* argv[])
     openrct2_setup_rct2_segment();
     PaintIntercept::InitHooks();
 
+    std::vector<std::pair<uint8_t, uint8_t>> tests;
+    for (auto&& tc : testCases)
+    {
+        for (auto&& trackType : tc.trackTypes)
+        {
+            tests.emplace_back(tc.rideType, trackType);
+        }
+    }
+
+    std::vector<TestResult> results(tests.size());
+#if defined(__unix__)
+    if (jobs > 1)
+    {
+        RunTestsInWorkers(tests, results, jobs);
+    }
+    else
+#endif // defined(__unix__)
+    {
+        for (size_t i = 0; i < tests.size(); i++)
+        {
+            results[i] = RunTest(tests[i].first, tests[i].second);
+        }
+    }
+
     int successCount = 0;
+    size_t resultIndex = 0;
     std::vector<utf8string> failures;
     for (auto&& tc : testCases)
     {
@@ -576,10 +774,9 @@ int main(int argc, char* argv[])
             Write(CLIColour::GREEN, "[ RUN      ] ");
             Write("%s.%s\n", rideTypeName, trackTypeName);
 
-            std::string out;
-            int retVal = TestTrack::TestPaintTrackElement(tc.rideType, trackType, &out);
-            Write("%s", out.c_str());
-            switch (retVal)
+            const auto& result = results[resultIndex++];
+            Write("%s", result.output.c_str());
+            switch (result.retVal)
             {
                 case TEST_SUCCESS:
                     Write(CLIColour::GREEN, "[       OK ] ");
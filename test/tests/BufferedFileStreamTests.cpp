@@ -0,0 +1,64 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TestData.h"
+
+#include <gtest/gtest.h>
+#include <openrct2/core/BufferedFileStream.h>
+#include <openrct2/core/File.h>
+#include <cstring>
+#include <vector>
+
+using namespace OpenRCT2;
+
+static void ReadAndCompare(const std::string& path, BufferedFileMode mode, size_t blockSize)
+{
+    auto expected = File::ReadAllBytes(path);
+    ASSERT_GT(expected.size(), 1024u);
+
+    BufferedFileStream stream(path, mode, blockSize);
+    ASSERT_EQ(stream.GetLength(), expected.size());
+
+    // Small reads of different sizes, then one across many blocks
+    std::vector<uint8_t> actual(expected.size());
+    size_t position = 0;
+    for (size_t i = 0; position + 16 <= 512; i++)
+    {
+        if (i % 3 == 0)
+            stream.Read4(actual.data() + position), position += 4;
+        else if (i % 3 == 1)
+            stream.Read1(actual.data() + position), position += 1;
+        else
+            stream.Read16(actual.data() + position), position += 16;
+    }
+    stream.Read(actual.data() + position, expected.size() - position);
+    ASSERT_EQ(actual, expected);
+    ASSERT_EQ(stream.GetPosition(), expected.size());
+
+    uint8_t byte;
+    ASSERT_THROW(stream.Read1(&byte), IOException);
+
+    // Going back reads the same data again
+    stream.SetPosition(100);
+    uint32_t value;
+    stream.Read4(&value);
+    ASSERT_EQ(std::memcmp(&value, expected.data() + 100, sizeof(value)), 0);
+}
+
+TEST(BufferedFileStreamTest, Buffered)
+{
+    auto path = TestData::GetParkPath("bpb.sv6");
+    ReadAndCompare(path, BufferedFileMode::Buffered, BufferedFileStream::DefaultBlockSize);
+    ReadAndCompare(path, BufferedFileMode::Buffered, 7);
+}
+
+TEST(BufferedFileStreamTest, MemoryMapped)
+{
+    ReadAndCompare(TestData::GetParkPath("bpb.sv6"), BufferedFileMode::MemoryMapped, 0);
+}
@@ -0,0 +1,116 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <openrct2/core/ChunkFile.h>
+#include <openrct2/core/IStream.hpp>
+#include <openrct2/core/MemoryStream.h>
+#include <vector>
+
+using namespace OpenRCT2;
+
+static std::vector<uint8_t> CreatePattern(size_t length, uint8_t seed)
+{
+    std::vector<uint8_t> data(length);
+    for (size_t i = 0; i < length; i++)
+    {
+        data[i] = static_cast<uint8_t>((i / 7) * seed);
+    }
+    return data;
+}
+
+TEST(ChunkFileTests, WriteAndRead)
+{
+    auto chunkA = CreatePattern(100000, 3);
+    auto chunkB = CreatePattern(17, 5);
+    std::vector<uint8_t> chunkC(4);
+    std::iota(chunkC.begin(), chunkC.end(), 0);
+
+    MemoryStream ms;
+    ChunkFileWriter writer;
+    writer.AddChunk(10, chunkA.data(), chunkA.size());
+    writer.AddChunk(20, chunkB.data(), chunkB.size());
+    writer.AddChunk(30, chunkC.data(), chunkC.size());
+    writer.Write(&ms);
+    ASSERT_LT(ms.GetLength(), chunkA.size());
+
+    ms.SetPosition(0);
+    ASSERT_TRUE(ChunkFile::IsChunkFile(&ms));
+    ChunkFileReader reader(&ms);
+    ASSERT_EQ(reader.GetEntries().size(), 3U);
+    ASSERT_EQ(reader.FindChunk(10)->Method, ChunkFile::Compression::Zlib);
+    ASSERT_EQ(reader.FindChunk(30)->Method, ChunkFile::Compression::None);
+    ASSERT_EQ(reader.FindChunk(40), nullptr);
+
+    // Single chunks can be read in any order
+    ASSERT_EQ(reader.ReadChunk(30), chunkC);
+    ASSERT_EQ(reader.ReadChunk(20), chunkB);
+
+    std::vector<uint8_t> readA(chunkA.size());
+    std::vector<uint8_t> readB(chunkB.size());
+    reader.ReadChunks({ { 20, readB.data(), readB.size() }, { 10, readA.data(), readA.size() } });
+    ASSERT_EQ(readA, chunkA);
+    ASSERT_EQ(readB, chunkB);
+}
+
+TEST(ChunkFileTests, RejectsInvalidFiles)
+{
+    auto chunk = CreatePattern(1000, 9);
+
+    MemoryStream ms;
+    ChunkFileWriter writer;
+    writer.AddChunk(1, chunk.data(), chunk.size());
+    writer.Write(&ms);
+
+    ms.SetPosition(0);
+    ChunkFileReader reader(&ms);
+    std::vector<uint8_t> tooShort(chunk.size() - 1);
+    ASSERT_THROW(reader.ReadChunk(1, tooShort.data(), tooShort.size()), IOException);
+    ASSERT_THROW(reader.ReadChunk(2), IOException);
+
+    // Truncate the data of the chunk
+    MemoryStream truncated(ms.GetData(), static_cast<size_t>(ms.GetLength() - 10));
+    ASSERT_THROW(ChunkFileReader{ &truncated }, IOException);
+
+    MemoryStream notChunkFile(chunk.data(), chunk.size());
+    ASSERT_FALSE(ChunkFile::IsChunkFile(&notChunkFile));
+    ASSERT_THROW(ChunkFileReader{ &notChunkFile }, IOException);
+}
+
+TEST(ChunkFileTests, CacheReusesUnchangedChunks)
+{
+    auto chunkA = CreatePattern(50000, 3);
+    auto chunkB = CreatePattern(50000, 7);
+
+    ChunkFileCache cache;
+    MemoryStream first;
+    ChunkFileWriter writer;
+    writer.AddChunk(1, chunkA.data(), chunkA.size());
+    writer.AddChunk(2, chunkB.data(), chunkB.size());
+    writer.Write(&first, &cache);
+    ASSERT_EQ(cache.GetNumReused(), 0U);
+
+    chunkB[100]++;
+    MemoryStream second;
+    writer.Write(&second, &cache);
+    ASSERT_EQ(cache.GetNumReused(), 1U);
+
+    second.SetPosition(0);
+    ChunkFileReader reader(&second);
+    ASSERT_EQ(reader.ReadChunk(1), chunkA);
+    ASSERT_EQ(reader.ReadChunk(2), chunkB);
+
+    // The same data written without a cache gives the same file
+    MemoryStream uncached;
+    writer.Write(&uncached);
+    ASSERT_EQ(uncached.GetLength(), second.GetLength());
+    ASSERT_EQ(std::memcmp(uncached.GetData(), second.GetData(), static_cast<size_t>(second.GetLength())), 0);
+}
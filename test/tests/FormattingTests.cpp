@@ -339,6 +339,28 @@ TEST_F(FormattingTests, using_legacy_buffer_args)
     ASSERT_STREQ("Queuing for Boat Hire 2", buffer);
 }
 
+TEST_F(FormattingTests, using_legacy_buffer_args_cached)
+{
+    char name[16] = "Guest 1";
+    auto ft = Formatter();
+    ft.Add<const char*>(name);
+
+    char buffer[32]{};
+    FormatStringLegacy(buffer, sizeof(buffer), STR_STRING, ft.Data());
+    ASSERT_STREQ("Guest 1", buffer);
+
+    // Cached results must still be truncated to the buffer they are copied into
+    char smallBuffer[4]{};
+    auto len = FormatStringLegacy(smallBuffer, sizeof(smallBuffer), STR_STRING, ft.Data());
+    ASSERT_EQ(len, 7U);
+    ASSERT_STREQ("Gue", smallBuffer);
+
+    // Strings passed by pointer are looked up by content, not by address
+    String::Set(name, sizeof(name), "Guest 2");
+    FormatStringLegacy(buffer, sizeof(buffer), STR_STRING, ft.Data());
+    ASSERT_STREQ("Guest 2", buffer);
+}
+
 TEST_F(FormattingTests, format_number_basic)
 {
     FormatBuffer ss;
@@ -11,6 +11,7 @@
 
 #include <gtest/gtest.h>
 #include <openrct2/core/Path.hpp>
+#include <limits>
 #include <openrct2/drawing/ImageImporter.h>
 #include <string_view>
 
@@ -56,3 +57,61 @@ TEST_F(ImageImporterTests, Import_Logo)
     auto hash = GetHash(result.Buffer.data(), result.Buffer.size());
     ASSERT_EQ(0xCEF27C7D, hash);
 }
+
+TEST_F(ImageImporterTests, Import_Closest_MatchesExhaustiveSearch)
+{
+    // Remap colours and index 0 are never picked as the closest colour.
+    auto isChangable = [](int32_t i) {
+        return i != 0 && !(i >= 203 && i < 214) && i != 226 && !(i >= 227 && i < 229) && i < 243;
+    };
+
+    Image image;
+    image.Width = 256;
+    image.Height = 256;
+    image.Depth = 32;
+    image.Stride = image.Width * 4;
+    image.Pixels.resize(image.Width * image.Height * 4);
+    for (uint32_t i = 0; i < image.Width * image.Height; i++)
+    {
+        image.Pixels[i * 4 + 0] = static_cast<uint8_t>(i * 7);
+        image.Pixels[i * 4 + 1] = static_cast<uint8_t>(i / 256);
+        image.Pixels[i * 4 + 2] = static_cast<uint8_t>((i * 13) >> 3);
+        image.Pixels[i * 4 + 3] = 255;
+    }
+
+    ImageImporter importer;
+    auto result = importer.Import(image, 0, 0, ImageImporter::IMPORT_FLAGS::NONE, ImageImporter::IMPORT_MODE::CLOSEST);
+    ASSERT_EQ(image.Width * image.Height, result.Buffer.size());
+
+    for (uint32_t i = 0; i < image.Width * image.Height; i++)
+    {
+        const auto* pixel = &image.Pixels[i * 4];
+        int32_t expected = -1;
+        for (int32_t j = 0; j < PALETTE_SIZE && expected == -1; j++)
+        {
+            const auto& entry = StandardPalette[j];
+            if (entry.Red == pixel[0] && entry.Green == pixel[1] && entry.Blue == pixel[2])
+            {
+                expected = j;
+            }
+        }
+        if (expected == -1)
+        {
+            int32_t smallestError = std::numeric_limits<int32_t>::max();
+            for (int32_t j = 0; j < PALETTE_SIZE; j++)
+            {
+                const auto& entry = StandardPalette[j];
+                auto dr = entry.Red - pixel[0];
+                auto dg = entry.Green - pixel[1];
+                auto db = entry.Blue - pixel[2];
+                auto error = dr * dr + dg * dg + db * db;
+                if (isChangable(j) && error < smallestError)
+                {
+                    smallestError = error;
+                    expected = j;
+                }
+            }
+        }
+        ASSERT_EQ(expected, result.Buffer[i]) << "pixel " << i;
+    }
+}
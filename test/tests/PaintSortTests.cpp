@@ -0,0 +1,131 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <limits>
+#include <memory>
+#include <openrct2/paint/Paint.h>
+#include <random>
+#include <vector>
+
+// Fills the session with paint structs placed at random, seeded so both sessions get the same ones.
+static void CreateRandomSession(paint_session* session, uint8_t rotation, size_t count, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> pos(0, 16 * 32);
+    std::uniform_int_distribution<int> size(0, 48);
+    std::uniform_int_distribution<int> height(0, 255);
+
+    session->CurrentRotation = rotation;
+    session->QuadrantBackIndex = std::numeric_limits<uint32_t>::max();
+    session->QuadrantFrontIndex = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        auto* ps = &session->PaintStructs.emplace_back().basic;
+        *ps = {};
+        ps->bounds.x = pos(rng);
+        ps->bounds.y = pos(rng);
+        ps->bounds.z = height(rng);
+        ps->bounds.x_end = ps->bounds.x + size(rng);
+        ps->bounds.y_end = ps->bounds.y + size(rng);
+        ps->bounds.z_end = ps->bounds.z + size(rng);
+        PaintSessionAddPSToQuadrant(session, ps);
+    }
+}
+
+static std::vector<size_t> GetDrawOrder(const paint_session* session)
+{
+    std::vector<size_t> order;
+    for (auto* ps = session->PaintHead.next_quadrant_ps; ps != nullptr; ps = ps->next_quadrant_ps)
+    {
+        order.push_back(session->PaintStructs.IndexOf(ps));
+    }
+    return order;
+}
+
+TEST(PaintSortTest, SortKeysMatchLinkedOrder)
+{
+    for (uint8_t rotation = 0; rotation < 4; rotation++)
+    {
+        for (uint32_t seed = 0; seed < 8; seed++)
+        {
+            auto linked = std::make_unique<paint_session>();
+            auto keyed = std::make_unique<paint_session>();
+            CreateRandomSession(linked.get(), rotation, 3000, seed);
+            CreateRandomSession(keyed.get(), rotation, 3000, seed);
+
+            PaintSessionArrangeLinked(linked.get());
+            PaintSessionArrange(keyed.get());
+
+            auto order = GetDrawOrder(keyed.get());
+            ASSERT_EQ(order.size(), 3000u);
+            ASSERT_EQ(order, GetDrawOrder(linked.get()));
+        }
+    }
+}
+
+TEST(PaintSortTest, EmptySession)
+{
+    auto session = std::make_unique<paint_session>();
+    CreateRandomSession(session.get(), 0, 0, 0);
+    PaintSessionArrange(session.get());
+    ASSERT_EQ(session->PaintHead.next_quadrant_ps, nullptr);
+}
+
+TEST(PaintSortTest, MoreStructsThanSortKeys)
+{
+    auto linked = std::make_unique<paint_session>();
+    auto keyed = std::make_unique<paint_session>();
+    CreateRandomSession(linked.get(), 0, 70000, 0);
+    CreateRandomSession(keyed.get(), 0, 70000, 0);
+
+    PaintSessionArrangeLinked(linked.get());
+    PaintSessionArrange(keyed.get());
+
+    auto order = GetDrawOrder(keyed.get());
+    ASSERT_EQ(order.size(), 70000u);
+    ASSERT_EQ(order, GetDrawOrder(linked.get()));
+}
+
+TEST(PaintEntryListTest, EntriesStayInPlace)
+{
+    PaintEntryList list;
+    std::vector<const paint_entry*> addresses;
+    for (size_t i = 0; i < PAINT_ENTRY_CHUNK_SIZE * 3 + 1; i++)
+    {
+        addresses.push_back(&list.emplace_back());
+    }
+
+    ASSERT_EQ(list.size(), addresses.size());
+    for (size_t i = 0; i < addresses.size(); i++)
+    {
+        ASSERT_EQ(&list[i], addresses[i]);
+        ASSERT_EQ(list.IndexOf(addresses[i]), i);
+    }
+    ASSERT_EQ(list.IndexOf(nullptr), list.size());
+    ASSERT_TRUE(list.IsContiguous(PAINT_ENTRY_CHUNK_SIZE * 3));
+    ASSERT_FALSE(list.IsContiguous(PAINT_ENTRY_CHUNK_SIZE * 3 - 1));
+
+    PaintEntryList copy = list;
+    ASSERT_TRUE(copy.empty());
+
+    list.clear();
+    ASSERT_TRUE(list.empty());
+}
+
+TEST(PaintEntryListTest, ReserveContiguous)
+{
+    PaintEntryList list;
+    ASSERT_TRUE(list.ReserveContiguous(PAINT_ENTRY_CHUNK_SIZE));
+    ASSERT_FALSE(list.ReserveContiguous(PAINT_ENTRY_CHUNK_SIZE + 1));
+
+    list.emplace_back();
+    ASSERT_TRUE(list.ReserveContiguous(PAINT_ENTRY_CHUNK_SIZE - 1));
+    ASSERT_FALSE(list.ReserveContiguous(PAINT_ENTRY_CHUNK_SIZE));
+}
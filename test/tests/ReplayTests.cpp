@@ -9,6 +9,8 @@
 
 #include "TestData.h"
 
+#include <chrono>
+#include <cstdio>
 #include <gtest/gtest.h>
 #include <openrct2/Context.h>
 #include <openrct2/Game.h>
@@ -77,6 +79,7 @@ TEST_P(ReplayTests, RunReplay)
 #else
     gOpenRCT2Headless = true;
     gOpenRCT2NoGraphics = true;
+    gOpenRCT2NoPresentation = true;
     core_init();
 
     auto testData = GetParam();
@@ -95,17 +98,93 @@ TEST_P(ReplayTests, RunReplay)
     bool startedReplay = replayManager->StartPlayback(replayFile);
     ASSERT_TRUE(startedReplay);
 
+    uint32_t ticks = 0;
+    auto startTime = std::chrono::high_resolution_clock::now();
     while (replayManager->IsReplaying())
     {
         gs->UpdateLogic();
+        ticks++;
         if (replayManager->IsPlaybackStateMismatching())
             break;
     }
+    std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - startTime;
+    std::printf(
+        "%s: %u ticks in %.2f s, %.0f ticks/s\n", testData.name.c_str(), ticks, duration.count(), ticks / duration.count());
+
     ASSERT_FALSE(replayManager->IsReplaying());
     ASSERT_FALSE(replayManager->IsPlaybackStateMismatching());
 #endif
 }
 
+TEST(ReplayKeyframeTests, SegmentsAndSeeking)
+{
+#ifdef PLATFORM_32BIT
+    log_warning("Replay Tests have not been performed. OpenRCT2/OpenRCT2#11279.");
+    return;
+#else
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+    core_init();
+
+    auto context = CreateContext();
+    bool initialised = context->Initialise();
+    ASSERT_TRUE(initialised);
+
+    load_from_sv6(TestData::GetParkPath("small_park_with_ferris_wheel.sv6").c_str());
+    game_load_init();
+
+    auto gs = context->GetGameState();
+    ASSERT_NE(gs, nullptr);
+
+    IReplayManager* replayManager = context->GetReplayManager();
+    ASSERT_NE(replayManager, nullptr);
+
+    // Record 300 ticks with a keyframe every 100 ticks
+    const std::string replayFile = "replay_keyframes_test.sv6r";
+    const uint32_t startTick = gCurrentTicks;
+    ASSERT_TRUE(replayManager->StartRecording(replayFile, 300, IReplayManager::RecordType::NORMAL, 100));
+    while (replayManager->IsRecording())
+    {
+        gs->UpdateLogic();
+    }
+
+    // Every segment plays back on its own up to the next keyframe
+    for (uint32_t segment = 0; segment < 3; segment++)
+    {
+        ASSERT_TRUE(replayManager->StartPlaybackSegment(replayFile, segment));
+
+        ReplayRecordInfo info;
+        ASSERT_TRUE(replayManager->GetCurrentReplayInfo(info));
+        ASSERT_EQ(info.NumKeyframes, 2U);
+
+        while (replayManager->IsReplaying() && !replayManager->IsPlaybackStateMismatching())
+        {
+            gs->UpdateLogic();
+        }
+        ASSERT_FALSE(replayManager->IsPlaybackStateMismatching());
+
+        // Playback stops at the start of the last tick, which still runs
+        ASSERT_EQ(gCurrentTicks, startTick + 100 * (segment + 1) + 1);
+    }
+    ASSERT_FALSE(replayManager->StartPlaybackSegment(replayFile, 3));
+
+    // Seek forwards past a keyframe and back again
+    ASSERT_TRUE(replayManager->StartPlayback(replayFile));
+    ASSERT_TRUE(replayManager->SeekToTick(startTick + 250));
+    ASSERT_FALSE(replayManager->IsPlaybackStateMismatching());
+    ASSERT_TRUE(replayManager->SeekToTick(startTick + 50));
+    ASSERT_FALSE(replayManager->IsPlaybackStateMismatching());
+    while (replayManager->IsReplaying() && !replayManager->IsPlaybackStateMismatching())
+    {
+        gs->UpdateLogic();
+    }
+    ASSERT_FALSE(replayManager->IsPlaybackStateMismatching());
+    ASSERT_EQ(gCurrentTicks, startTick + 301);
+
+    File::Delete(replayFile);
+#endif
+}
+
 static void PrintTo(const ReplayTestData& testData, std::ostream* os)
 {
     *os << testData.filePath;
@@ -0,0 +1,72 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifdef ENABLE_SCRIPTING
+
+#    include <gtest/gtest.h>
+#    include <openrct2/core/MemoryStream.h>
+#    include <openrct2/scripting/ReplicatedStorage.h>
+
+using namespace OpenRCT2;
+using namespace OpenRCT2::Scripting;
+
+TEST(ReplicatedStorageTests, OnlyChangedKeysAreTaken)
+{
+    ReplicatedStorage server;
+    server.Set("a", "1");
+    server.Set("b", "2");
+    ASSERT_EQ(server.TakeChanges().size(), 2U);
+    ASSERT_FALSE(server.HasChanges());
+
+    // Setting the same value again is not a change
+    server.Set("a", "1");
+    ASSERT_FALSE(server.HasChanges());
+
+    server.Set("a", "3");
+    server.Remove("b");
+    server.Set("c", "4");
+    server.Remove("c");
+    auto changes = server.TakeChanges();
+    ASSERT_EQ(changes.size(), 3U);
+    ASSERT_EQ(changes[0].Key, "a");
+    ASSERT_EQ(*changes[0].Value, "3");
+    ASSERT_FALSE(changes[1].Value.has_value());
+    ASSERT_FALSE(changes[2].Value.has_value());
+    ASSERT_EQ(server.GetRevision(), 2U);
+}
+
+TEST(ReplicatedStorageTests, ClientSkipsChangesInTheMap)
+{
+    ReplicatedStorage server;
+    server.Set("a", "1");
+    auto first = server.TakeChanges();
+    server.Set("a", "2");
+    server.Set("b", "3");
+
+    // The map is written with changes that have not been taken yet
+    MemoryStream ms;
+    server.Write(ms);
+    auto second = server.TakeChanges();
+    server.Set("b", "4");
+    auto third = server.TakeChanges();
+
+    ReplicatedStorage client;
+    ms.SetPosition(0);
+    client.Read(ms);
+    ASSERT_EQ(*client.Get("a"), "2");
+
+    client.ApplyChanges(1, first);
+    ASSERT_EQ(*client.Get("a"), "2");
+    client.ApplyChanges(2, second);
+    client.ApplyChanges(3, third);
+    ASSERT_EQ(*client.Get("b"), "4");
+    ASSERT_EQ(client.GetKeys(), server.GetKeys());
+}
+
+#endif
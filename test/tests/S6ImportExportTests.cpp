@@ -108,11 +108,11 @@ static std::unique_ptr<GameState_t> GetGameState(std::unique_ptr<IContext>& cont
     std::unique_ptr<GameState_t> res = std::make_unique<GameState_t>();
     for (size_t spriteIdx = 0; spriteIdx < MAX_ENTITIES; spriteIdx++)
     {
-        rct_sprite* sprite = reinterpret_cast<rct_sprite*>(GetEntity(spriteIdx));
-        if (sprite == nullptr)
+        const auto* entity = GetEntity(spriteIdx);
+        if (entity == nullptr)
             res->sprites[spriteIdx].misc.Type = EntityType::Null;
         else
-            res->sprites[spriteIdx] = *sprite;
+            CopyEntityToSprite(*entity, res->sprites[spriteIdx]);
     }
     return res;
 }
@@ -0,0 +1,52 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/scenario/Scenario.h>
+#include <vector>
+
+static std::vector<uint32_t> DrawFromStream(ScenarioRandStream stream, uint32_t index)
+{
+    auto engine = scenario_rand_stream(stream, index);
+    std::vector<uint32_t> numbers;
+    for (int i = 0; i < 8; i++)
+    {
+        numbers.push_back(engine());
+    }
+    return numbers;
+}
+
+TEST(ScenarioRandTest, StreamsDoNotDependOnOtherDraws)
+{
+    scenario_rand_seed(0x12345678, 0x9ABCDEF0);
+    scenario_rand_begin_tick();
+    auto first = DrawFromStream(ScenarioRandStream::Peep, 1);
+    auto second = DrawFromStream(ScenarioRandStream::Peep, 2);
+
+    // The other way around, with the scenario engine drawn from in between
+    scenario_rand_seed(0x12345678, 0x9ABCDEF0);
+    scenario_rand_begin_tick();
+    ASSERT_EQ(DrawFromStream(ScenarioRandStream::Peep, 2), second);
+    scenario_rand();
+    ASSERT_EQ(DrawFromStream(ScenarioRandStream::Peep, 1), first);
+}
+
+TEST(ScenarioRandTest, StreamsDiffer)
+{
+    scenario_rand_seed(0x12345678, 0x9ABCDEF0);
+    scenario_rand_begin_tick();
+    auto peep = DrawFromStream(ScenarioRandStream::Peep, 1);
+    ASSERT_NE(DrawFromStream(ScenarioRandStream::Peep, 0), peep);
+    ASSERT_NE(DrawFromStream(ScenarioRandStream::Vehicle, 1), peep);
+
+    // A new tick starts from the state the scenario engine is in by then
+    scenario_rand();
+    scenario_rand_begin_tick();
+    ASSERT_NE(DrawFromStream(ScenarioRandStream::Peep, 1), peep);
+}
@@ -0,0 +1,69 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/core/StringPool.h>
+#include <string>
+
+using namespace OpenRCT2;
+
+TEST(StringPoolTest, EqualStringsShareAHandle)
+{
+    StringPool pool;
+    auto a = pool.Add("Mr Bean");
+    auto b = pool.Add(std::string("Mr ") + "Bean");
+    auto c = pool.Add("Mrs Bean");
+    ASSERT_EQ(a, b);
+    ASSERT_NE(a, c);
+    ASSERT_EQ(pool.GetCount(), 2u);
+    ASSERT_STREQ(pool.Get(a), "Mr Bean");
+    ASSERT_EQ(pool.GetView(c), "Mrs Bean");
+    ASSERT_EQ(pool.Add(""), StringPool::Null);
+    ASSERT_EQ(pool.Get(StringPool::Null), nullptr);
+}
+
+TEST(StringPoolTest, StringsLiveUntilTheLastRelease)
+{
+    StringPool pool;
+    auto a = pool.Add("Tom");
+    const char* text = pool.Get(a);
+    pool.AddReference(a);
+    pool.Release(a);
+    ASSERT_EQ(pool.Get(a), text);
+    ASSERT_STREQ(text, "Tom");
+
+    pool.Release(a);
+    ASSERT_EQ(pool.GetCount(), 0u);
+
+    // The handle and space are reused
+    auto b = pool.Add("Tim");
+    ASSERT_EQ(b, a);
+    ASSERT_EQ(pool.Get(b), text);
+    ASSERT_STREQ(pool.Get(b), "Tim");
+}
+
+TEST(StringPoolTest, ManyAndLongStrings)
+{
+    StringPool pool;
+    std::vector<StringPool::Handle> handles;
+    for (int i = 0; i < 10000; i++)
+    {
+        handles.push_back(pool.Add("Guest " + std::to_string(i)));
+    }
+    auto longText = std::string(100000, 'x');
+    auto longHandle = pool.Add(longText);
+    for (int i = 0; i < 10000; i++)
+    {
+        ASSERT_EQ(pool.GetView(handles[i]), "Guest " + std::to_string(i));
+    }
+    ASSERT_EQ(pool.GetView(longHandle), longText);
+
+    pool.Clear();
+    ASSERT_EQ(pool.GetCount(), 0u);
+}
@@ -0,0 +1,78 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <openrct2/core/JobPool.h>
+#include <openrct2/core/TaskScheduler.h>
+#include <vector>
+
+using namespace OpenRCT2;
+
+TEST(TaskSchedulerTest, ParallelForVisitsEveryIndexOnce)
+{
+    std::vector<std::atomic<int>> visits(10000);
+    TaskScheduler::Get().ParallelFor(visits.size(), [&visits](size_t i) { visits[i]++; });
+    for (const auto& v : visits)
+    {
+        ASSERT_EQ(v.load(), 1);
+    }
+}
+
+TEST(TaskSchedulerTest, NestedParallelFor)
+{
+    std::atomic<size_t> total = { 0 };
+    TaskScheduler::Get().ParallelFor(64, 1, [&total](size_t) {
+        TaskScheduler::Get().ParallelFor(64, 1, [&total](size_t) { total++; });
+    });
+    ASSERT_EQ(total.load(), 64u * 64u);
+}
+
+TEST(TaskSchedulerTest, TaskGroup)
+{
+    std::vector<int> results(4);
+    auto fnA = [&results]() { results[0] = 1; };
+    auto fnB = [&results]() { results[1] = 2; };
+    auto fnC = [&results]() { results[2] = 3; };
+    auto fnD = [&results]() { results[3] = 4; };
+
+    TaskGroup group;
+    group.Run(fnA);
+    group.Run(fnB);
+    group.Run(fnC);
+    group.Run(fnD);
+    group.Wait();
+
+    ASSERT_EQ(group.CountPending(), 0u);
+    ASSERT_EQ(std::accumulate(results.begin(), results.end(), 0), 10);
+}
+
+TEST(TaskSchedulerTest, JobPoolCompletionRunsOnJoiningThread)
+{
+    const auto joiningThread = std::this_thread::get_id();
+    std::atomic<int> work = { 0 };
+    int completions = 0;
+    bool allOnJoiningThread = true;
+
+    JobPool pool;
+    for (int i = 0; i < 500; i++)
+    {
+        pool.AddTask([&work]() { work++; }, [&]() {
+            completions++;
+            allOnJoiningThread &= std::this_thread::get_id() == joiningThread;
+        });
+    }
+    pool.Join();
+
+    ASSERT_EQ(work.load(), 500);
+    ASSERT_EQ(completions, 500);
+    ASSERT_TRUE(allOnJoiningThread);
+    ASSERT_EQ(pool.CountPending(), 0u);
+}
@@ -171,3 +171,18 @@ TEST_F(TileElementWantsFootpathConnection, MapEdge)
     // The tile in the -X direction is a normal tile and should not be marked as an edge
     EXPECT_FALSE(edges & (1 << 2));
 }
+
+TEST_F(TileElementWantsFootpathConnection, TilePointersMatchElementList)
+{
+    // The tile pointers are rebuilt in parallel chunks, they must match walking the element list from the start
+    map_update_tile_pointers();
+
+    const TileElement* tileElement = gTileElements;
+    for (int32_t i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS; i++)
+    {
+        ASSERT_EQ(gTileElementTilePointers[i], tileElement);
+        while (!(tileElement++)->IsLastForTile())
+            ;
+    }
+    EXPECT_EQ(gNextFreeTileElement, tileElement);
+}
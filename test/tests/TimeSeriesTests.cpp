@@ -0,0 +1,92 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2021 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/core/IStream.hpp>
+#include <openrct2/core/MemoryStream.h>
+#include <openrct2/core/TimeSeries.h>
+
+using namespace OpenRCT2;
+
+static TimeSeries CreateSeries(uint32_t count)
+{
+    TimeSeries series;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        // Swings both ways so the deltas are negative as well as positive
+        series.Append(i * 40, static_cast<int64_t>(i % 7) * 1000 - 3000 + (i == 300 ? INT32_MAX : 0));
+    }
+    return series;
+}
+
+TEST(TimeSeriesTest, GetRange)
+{
+    auto series = CreateSeries(1000);
+    ASSERT_EQ(series.GetCount(), 1000u);
+
+    auto all = series.GetRange(0, UINT32_MAX);
+    ASSERT_EQ(all.size(), 1000u);
+    for (uint32_t i = 0; i < all.size(); i++)
+    {
+        ASSERT_EQ(all[i].Tick, i * 40);
+        ASSERT_EQ(all[i].Value, static_cast<int64_t>(i % 7) * 1000 - 3000 + (i == 300 ? INT32_MAX : 0));
+    }
+
+    // Crosses a block boundary and starts and ends between samples
+    auto range = series.GetRange(250 * 40 + 1, 520 * 40 - 1);
+    ASSERT_EQ(range.size(), 269u);
+    ASSERT_EQ(range.front().Tick, 251u * 40);
+    ASSERT_EQ(range.back().Tick, 519u * 40);
+
+    ASSERT_TRUE(series.GetRange(1000 * 40, UINT32_MAX).empty());
+}
+
+TEST(TimeSeriesTest, OlderSamplesAreIgnored)
+{
+    TimeSeries series;
+    series.Append(100, 1);
+    series.Append(50, 2);
+    series.Append(100, 3);
+    auto all = series.GetRange(0, UINT32_MAX);
+    ASSERT_EQ(all.size(), 2u);
+    ASSERT_EQ(all[1].Value, 3);
+}
+
+TEST(TimeSeriesTest, WriteAndRead)
+{
+    auto series = CreateSeries(600);
+    MemoryStream ms;
+    series.Write(ms);
+
+    ms.SetPosition(0);
+    TimeSeries read;
+    read.Read(ms);
+    ASSERT_EQ(read.GetCount(), series.GetCount());
+    ASSERT_EQ(read.GetDataSize(), series.GetDataSize());
+
+    auto expected = series.GetRange(0, UINT32_MAX);
+    auto actual = read.GetRange(0, UINT32_MAX);
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); i++)
+    {
+        ASSERT_EQ(actual[i].Tick, expected[i].Tick);
+        ASSERT_EQ(actual[i].Value, expected[i].Value);
+    }
+}
+
+TEST(TimeSeriesTest, ReadRejectsTruncatedData)
+{
+    auto series = CreateSeries(600);
+    MemoryStream ms;
+    series.Write(ms);
+
+    MemoryStream truncated(ms.GetData(), ms.GetLength() - 3);
+    TimeSeries read;
+    ASSERT_THROW(read.Read(truncated), std::exception);
+}
@@ -7,10 +7,16 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include "TestData.h"
+
+#include <chrono>
+#include <cstdio>
 #include <gtest/gtest.h>
+#include <openrct2/core/File.h>
 #include <openrct2/core/MemoryStream.h>
 #include <openrct2/rct12/SawyerChunkReader.h>
 #include <openrct2/util/SawyerCoding.h>
+#include <vector>
 
 constexpr size_t BUFFER_SIZE = 0x600000;
 
@@ -89,6 +95,69 @@ TEST_F(SawyerCodingTest, write_read_chunk_rotate)
     test_encode_decode(CHUNK_ENCODING_ROTATE);
 }
 
+TEST_F(SawyerCodingTest, read_chunks_into_destinations)
+{
+    sawyercoding_chunk_header chdr_in;
+    chdr_in.encoding = CHUNK_ENCODING_RLECOMPRESSED;
+    chdr_in.length = sizeof(randomdata);
+    std::vector<uint8_t> encodedDataBuffer(BUFFER_SIZE);
+    auto encodedDataSize = sawyercoding_write_chunk_buffer(encodedDataBuffer.data(), randomdata, chdr_in);
+    std::vector<uint8_t> twoChunks(encodedDataBuffer.begin(), encodedDataBuffer.begin() + encodedDataSize);
+    twoChunks.insert(twoChunks.end(), twoChunks.begin(), twoChunks.end());
+
+    // The first destination is too small and the second too large
+    std::vector<uint8_t> truncated(sizeof(randomdata) / 2);
+    std::vector<uint8_t> padded(sizeof(randomdata) + 16, 0xFF);
+    OpenRCT2::MemoryStream ms(twoChunks.data(), twoChunks.size());
+    SawyerChunkReader reader(&ms);
+    reader.ReadChunks({ { truncated.data(), truncated.size() }, { padded.data(), padded.size() } });
+    ASSERT_EQ(ms.GetPosition(), ms.GetLength());
+    ASSERT_EQ(memcmp(truncated.data(), randomdata, truncated.size()), 0);
+    ASSERT_EQ(memcmp(padded.data(), randomdata, sizeof(randomdata)), 0);
+    for (size_t i = sizeof(randomdata); i < padded.size(); i++)
+    {
+        ASSERT_EQ(padded[i], 0);
+    }
+}
+
+// The parks in the test data were saved with the scalar encoder, every chunk has to encode back to exactly the
+// same bytes. This also reports how long decoding and encoding took.
+TEST_F(SawyerCodingTest, reencode_parks)
+{
+    for (const auto& name : { "bpb.sv6", "small_park_with_ferris_wheel.sv6", "tile-element-tests.sv6" })
+    {
+        auto data = File::ReadAllBytes(TestData::GetParkPath(name));
+        OpenRCT2::MemoryStream ms(data.data(), data.size());
+        SawyerChunkReader reader(&ms);
+        std::vector<uint8_t> encodedDataBuffer(BUFFER_SIZE);
+        std::chrono::duration<double> decodeTime{};
+        std::chrono::duration<double> encodeTime{};
+
+        // Last 4 bytes are the checksum
+        while (ms.GetPosition() + 4 < ms.GetLength())
+        {
+            auto chunkStart = static_cast<size_t>(ms.GetPosition());
+            auto decodeStart = std::chrono::high_resolution_clock::now();
+            auto chunk = reader.ReadChunk();
+            auto decodeEnd = std::chrono::high_resolution_clock::now();
+            auto chunkLength = static_cast<size_t>(ms.GetPosition()) - chunkStart;
+
+            sawyercoding_chunk_header chdr_in;
+            chdr_in.encoding = static_cast<uint8_t>(chunk->GetEncoding());
+            chdr_in.length = static_cast<uint32_t>(chunk->GetLength());
+            auto encodedDataSize = sawyercoding_write_chunk_buffer(
+                encodedDataBuffer.data(), static_cast<const uint8_t*>(chunk->GetData()), chdr_in);
+            auto encodeEnd = std::chrono::high_resolution_clock::now();
+            decodeTime += decodeEnd - decodeStart;
+            encodeTime += encodeEnd - decodeEnd;
+
+            ASSERT_EQ(encodedDataSize, chunkLength) << name;
+            ASSERT_EQ(memcmp(encodedDataBuffer.data(), data.data() + chunkStart, chunkLength), 0) << name;
+        }
+        std::printf("%s: decode %.3f ms, encode %.3f ms\n", name, decodeTime.count() * 1000, encodeTime.count() * 1000);
+    }
+}
+
 // Note we only check if provided data decompresses to the same data, not if it compresses the same.
 // The reason for that is we may improve encoding at some point, but the test won't be affected,
 // as we already do a decode test and roundtrip (encode + decode), which validates all uses.